@@ -23,6 +23,45 @@
 extern "C" {
 #endif
 
+/* Processing pipeline declaration */
+#define CONFIG_PIPELINE_MODES       3       /**< One chain per scan mode */
+#define CONFIG_MAX_PIPELINE_STAGES  8
+#define CONFIG_STAGE_NAME_LEN       16      /**< Including terminator */
+#define CONFIG_PIPELINE_INVALID     0xFF    /**< pipeline_stages marker for a bad chain */
+
+/* Panel readout map */
+#define CONFIG_MAX_READOUT_BLOCKS   32      /**< ROIC blocks per line */
+#define CONFIG_READOUT_INVALID      0xFF    /**< readout_block_count marker for a bad list */
+
+/* Additional frame consumers (network.outputs) */
+#define CONFIG_MAX_OUTPUTS          4
+#define CONFIG_OUTPUT_RAW16         0       /**< Full 16-bit frames */
+#define CONFIG_OUTPUT_DISPLAY8      1       /**< 8-bit window/level for viewers */
+#define CONFIG_OUTPUT_INVALID       0xFF    /**< output_count marker for a bad list */
+
+/* Per-frame image QA regions (qa.rois) */
+#define CONFIG_MAX_QA_ROIS          5
+#define CONFIG_QA_INVALID           0xFF    /**< qa_roi_count / qa_row_step marker for a bad value */
+
+/**
+ * @brief Rectangular region of interest in panel pixels
+ */
+typedef struct {
+    uint16_t x;                 /**< Left column */
+    uint16_t y;                 /**< Top row */
+    uint16_t width;             /**< Columns */
+    uint16_t height;            /**< Rows */
+} config_roi_t;
+
+/**
+ * @brief One additional frame consumer
+ */
+typedef struct {
+    char host_ip[16];           /**< Consumer IP address */
+    uint16_t port;              /**< Consumer data port */
+    uint8_t format;             /**< CONFIG_OUTPUT_RAW16 or CONFIG_OUTPUT_DISPLAY8 */
+} config_output_t;
+
 /**
  * @brief Detector configuration structure
  *
@@ -59,6 +98,82 @@ typedef struct {
 
     /* Logging */
     uint8_t log_level;          /**< 0=DEBUG, 1=INFO, 2=WARN, 3=ERROR */
+
+    /* Protection */
+    uint16_t overexposure_threshold; /**< Saturation level in counts (0 = default) */
+    uint8_t overflow_action;    /**< 0=Stop, 1=Backoff, 2=None */
+
+    /* Processing pipeline per scan mode (0 stages = built-in default) */
+    char pipeline[CONFIG_PIPELINE_MODES][CONFIG_MAX_PIPELINE_STAGES][CONFIG_STAGE_NAME_LEN];
+    uint8_t pipeline_stages[CONFIG_PIPELINE_MODES]; /**< Stage count per scan mode */
+    bool pipeline_fused;        /**< Run band stages fused band by band */
+    uint16_t pipeline_band_rows; /**< Rows per fused band (0 = default) */
+
+    /* Panel readout map (all zero = lines and columns arrive in image order) */
+    uint16_t readout_block_cols; /**< Columns per ROIC block (0 = one block per line) */
+    uint8_t readout_block_count; /**< Entries in readout_block_order (0 = blocks in order) */
+    uint8_t readout_block_order[CONFIG_MAX_READOUT_BLOCKS]; /**< Image block of each raw block */
+    uint32_t readout_mirrored_blocks; /**< Bit b: raw block b read right to left */
+    bool readout_dual_side;     /**< Raw lines alternate top and bottom halves */
+    bool readout_bottom_flipped; /**< Bottom half read from the last row upwards */
+    bool readout_bottom_mirrored; /**< Bottom lines arrive reversed */
+
+    /* Panel mounting orientation, applied before packetizing */
+    uint8_t orientation;        /**< orient_t value (0 = none), panel.orientation */
+
+    /* Additional consumers; the network.host_ip stream always stays RAW16 */
+    config_output_t outputs[CONFIG_MAX_OUTPUTS]; /**< network.outputs */
+    uint8_t output_count;       /**< Entries in outputs */
+
+    /* 8-bit conversion for display8 outputs (display: section) */
+    bool display_auto_window;   /**< Window from histogram percentiles */
+    uint16_t display_window_low; /**< Manual black point */
+    uint16_t display_window_high; /**< Manual white point (0 = full range) */
+    float display_low_percentile; /**< Auto black point in percent (0 = default) */
+    float display_high_percentile; /**< Auto white point in percent (0 = default) */
+    float display_gamma;        /**< Display gamma (0 = linear) */
+    uint8_t display_method;     /**< 0=auto, 1=lut, 2=arith */
+
+    /* Background defect drift tracking (drift: section) */
+    bool drift_enabled;         /**< Track per-pixel dark statistics */
+    uint32_t drift_pixels_per_frame; /**< Pixels updated per frame (0 = default) */
+    uint8_t drift_weight_shift; /**< Statistics memory 2^n frames (0 = default) */
+    uint16_t drift_offset_threshold; /**< Offset drift limit in counts (0 = default) */
+    uint16_t drift_noise_threshold; /**< RMS noise limit in counts (0 = default) */
+    uint16_t drift_dark_level;  /**< Idle frames: block mean ceiling (0 = calibration darks only) */
+
+    /* Per-frame image quality metrics (qa: section) */
+    bool qa_enabled;            /**< Compute QA metrics in the stats stage */
+    uint8_t qa_row_step;        /**< Sample every Nth row (0 = default) */
+    uint8_t qa_roi_count;       /**< Entries in qa_rois (0 = five-point layout) */
+    config_roi_t qa_rois[CONFIG_MAX_QA_ROIS]; /**< Noise/SNR/uniformity regions */
+
+    /* Dual-gain HDR fusion (hdr: section) */
+    bool hdr_enabled;           /**< Alternate gains and fuse each pair */
+    uint16_t hdr_low_gain;      /**< FPGA_REG_GAIN of even frames (0 = default) */
+    uint16_t hdr_high_gain;     /**< FPGA_REG_GAIN of odd frames */
+    uint16_t hdr_threshold;     /**< High-gain count where low gain takes over (0 = 90% of full scale) */
+    uint16_t hdr_blend;         /**< Cross-fade width below threshold (0 = hard selection) */
+    uint8_t hdr_output_shift;   /**< Right shift of the fused value */
+
+    /* Exposure-gated transmission (gate: section) */
+    uint8_t gate_action;        /**< 0=off, 1=tag, 2=decimate, 3=drop */
+    uint16_t gate_dark_level;   /**< Frame mean without exposure in counts */
+    uint16_t gate_mean_margin;  /**< Mean above dark counted as signal (0 = default) */
+    uint16_t gate_max_margin;   /**< Max above dark counted as signal (0 = mean only) */
+    uint8_t gate_row_step;      /**< Sample every Nth row (0 = default) */
+    uint16_t gate_hold_frames;  /**< Empty frames still sent after signal */
+    uint8_t gate_decimate;      /**< Bin factor for decimate (0 = default) */
+
+    /* OpenMetrics HTTP endpoint (metrics: section) */
+    uint16_t metrics_port;      /**< TCP port (0 = endpoint off) */
+    char metrics_listen[16];    /**< IPv4 address to bind ("" = 127.0.0.1) */
+    uint16_t metrics_page_ms;   /**< Shared-memory stats page period (0 = default) */
+
+    /* GET_STATUS collector refresh periods (status: section, 0 = default) */
+    uint16_t status_state_ms;   /**< Sequence engine state */
+    uint16_t status_battery_ms; /**< Battery gauge (I2C) */
+    uint16_t status_temp_ms;    /**< FPGA temperature (SPI) */
 } detector_config_t;
 
 /**
@@ -100,6 +215,27 @@ typedef enum {
 #define CONFIG_MAX_CSI2_LANES    4
 #define CONFIG_VALID_CSI2_SPEED_400  400
 #define CONFIG_VALID_CSI2_SPEED_800  800
+#define CONFIG_MAX_OVERFLOW_ACTION   2
+#define CONFIG_MAX_ORIENTATION       7      /**< transverse */
+#define CONFIG_ORIENTATION_INVALID   0xFF   /**< Unknown orientation name */
+#define CONFIG_MIN_DISPLAY_GAMMA     0.1f
+#define CONFIG_MAX_DISPLAY_GAMMA     10.0f
+#define CONFIG_MAX_DISPLAY_METHOD    2
+#define CONFIG_MAX_DRIFT_WEIGHT_SHIFT 12
+#define CONFIG_MAX_DRIFT_NOISE       2047
+#define CONFIG_DRIFT_INVALID         0xFF   /**< drift_weight_shift marker for a bad value */
+#define CONFIG_MAX_QA_ROW_STEP       64
+#define CONFIG_DEFAULT_HDR_LOW_GAIN  0x0080 /**< 1.0x */
+#define CONFIG_MAX_HDR_RATIO         64
+#define CONFIG_MAX_HDR_SHIFT         8
+#define CONFIG_HDR_INVALID           0xFF   /**< hdr_output_shift marker for a bad value */
+#define CONFIG_MAX_GATE_ACTION       3      /**< drop */
+#define CONFIG_MAX_GATE_ROW_STEP     64
+#define CONFIG_MAX_GATE_DECIMATE     16
+#define CONFIG_GATE_INVALID          0xFF   /**< gate_action/row_step/decimate marker for a bad value */
+#define CONFIG_METRICS_PORT_INVALID  1      /**< metrics_port marker for a bad value */
+#define CONFIG_MAX_METRICS_PAGE_MS   1000
+#define CONFIG_MAX_STATUS_PERIOD_MS  60000
 
 /**
  * @brief Load configuration from YAML file
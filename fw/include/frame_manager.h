@@ -100,7 +100,8 @@ void frame_mgr_deinit(void);
 /**
  * @brief Acquire buffer for CSI-2 RX (Producer)
  *
- * @param frame_number Frame sequence number
+ * @param frame_number CSI-2 (V4L2 buffer) sequence number of the frame; HDR
+ *        pairing and the start-of-frame header template rely on it
  * @param buf Pointer to store buffer address
  * @param size Pointer to store buffer size
  * @return 0 on success, -EINVAL on invalid frame number, -EBUSY if all buffers busy
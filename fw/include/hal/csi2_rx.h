@@ -39,8 +39,38 @@ typedef struct {
     uint32_t width;           /**< Frame width */
     uint32_t height;          /**< Frame height */
     uint32_t pixel_format;    /**< Pixel format (fourcc) */
+    uint64_t sof_timestamp;   /**< Start-of-frame time in ns (CLOCK_MONOTONIC), 0 if unknown */
 } csi2_frame_buffer_t;
 
+/**
+ * @brief V4L2 events the receiver can subscribe to
+ */
+typedef enum {
+    CSI2_EVENT_FRAME_SYNC    = (1U << 0), /**< V4L2_EVENT_FRAME_SYNC (start of frame) */
+    CSI2_EVENT_SOURCE_CHANGE = (1U << 1), /**< V4L2_EVENT_SOURCE_CHANGE (format/link change) */
+    CSI2_EVENT_EOS           = (1U << 2), /**< V4L2_EVENT_EOS (end of stream) */
+} csi2_event_type_t;
+
+/**
+ * @brief Dequeued V4L2 event
+ *
+ * For CSI2_EVENT_FRAME_SYNC, sequence is the frame sequence number that
+ * the matching DQBUF will report and timestamp is the start-of-frame time.
+ */
+typedef struct {
+    csi2_event_type_t type;   /**< Event type */
+    uint32_t sequence;        /**< Frame sequence number (FRAME_SYNC only) */
+    uint64_t timestamp;       /**< Event timestamp in ns (CLOCK_MONOTONIC) */
+} csi2_event_t;
+
+/**
+ * @brief Start-of-frame callback
+ *
+ * Invoked from csi2_rx_wait_event() in the caller's thread for every
+ * FRAME_SYNC event, before the frame's buffer can be dequeued.
+ */
+typedef void (*csi2_sof_callback_t)(const csi2_event_t *event, void *user_data);
+
 /**
  * @brief CSI-2 RX configuration
  */
@@ -51,6 +81,7 @@ typedef struct {
     csi2_pixel_format_t format; /**< Pixel format */
     uint32_t buffer_count;    /**< Number of DMA buffers (recommended: 4) */
     uint32_t fps;             /**< Frames per second (for timing validation) */
+    bool enable_events;       /**< Subscribe to frame-sync events on create */
 } csi2_config_t;
 
 /**
@@ -82,6 +113,7 @@ typedef struct csi2_rx csi2_rx_t;
 #define CSI2_DEFAULT_BUFFERS    4
 #define CSI2_DEFAULT_FPS        15
 #define CSI2_FRAME_TIMEOUT_MS   1000  /**< Max wait time for one frame */
+#define CSI2_SOF_HISTORY        8     /**< Start-of-frame timestamps kept for DQBUF matching (power of 2) */
 
 /**
  * @brief Create and initialize CSI-2 RX
@@ -161,6 +193,64 @@ csi2_status_t csi2_rx_release(csi2_rx_t *csi2, const csi2_frame_buffer_t *frame)
  */
 csi2_status_t csi2_rx_restart(csi2_rx_t *csi2);
 
+/**
+ * @brief Subscribe to V4L2 frame-sync and related events
+ *
+ * @param csi2 CSI-2 RX handle
+ * @param events Bitmask of csi2_event_type_t to subscribe
+ * @return CSI2_OK if at least FRAME_SYNC (or any requested event) was
+ *         accepted, CSI2_ERROR_IOCTL if the driver supports none of them
+ *
+ * Events the driver does not support are skipped silently; query the
+ * accepted set with csi2_rx_get_subscribed_events(). Without FRAME_SYNC,
+ * sof_timestamp in captured frames stays 0 and callers fall back to the
+ * DQBUF timestamp.
+ */
+csi2_status_t csi2_rx_subscribe_events(csi2_rx_t *csi2, uint32_t events);
+
+/**
+ * @brief Unsubscribe from all V4L2 events
+ *
+ * @param csi2 CSI-2 RX handle
+ * @return CSI2_OK on success, error code on failure
+ */
+csi2_status_t csi2_rx_unsubscribe_events(csi2_rx_t *csi2);
+
+/**
+ * @brief Get the set of events accepted by the driver
+ *
+ * @param csi2 CSI-2 RX handle
+ * @return Bitmask of csi2_event_type_t, 0 if none or csi2 is NULL
+ */
+uint32_t csi2_rx_get_subscribed_events(csi2_rx_t *csi2);
+
+/**
+ * @brief Register start-of-frame callback
+ *
+ * @param csi2 CSI-2 RX handle
+ * @param callback Callback (NULL to disable)
+ * @param user_data Opaque pointer passed to callback
+ * @return CSI2_OK on success, error code on failure
+ */
+csi2_status_t csi2_rx_set_sof_callback(csi2_rx_t *csi2,
+                                      csi2_sof_callback_t callback,
+                                      void *user_data);
+
+/**
+ * @brief Wait for and dequeue one V4L2 event
+ *
+ * @param csi2 CSI-2 RX handle
+ * @param event Pointer to store event (may be NULL)
+ * @param timeout_ms Timeout in milliseconds (0 = blocking, -1 = non-blocking try)
+ * @return CSI2_OK on success, CSI2_ERROR_TIMEOUT if no event is pending,
+ *         error code on failure
+ *
+ * Waits with poll(POLLPRI) and dequeues with VIDIOC_DQEVENT. FRAME_SYNC
+ * timestamps are recorded so the matching csi2_rx_capture() can report
+ * sof_timestamp, then the start-of-frame callback is invoked.
+ */
+csi2_status_t csi2_rx_wait_event(csi2_rx_t *csi2, csi2_event_t *event, int timeout_ms);
+
 /**
  * @brief Get last error message
  *
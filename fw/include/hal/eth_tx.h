@@ -18,9 +18,10 @@ extern "C" {
 #endif
 
 /**
- * @brief Frame header format (32 bytes)
+ * @brief Frame header format (40 bytes)
  *
- * Per REQ-FW-040: Frame header format for UDP packet fragmentation.
+ * Per REQ-FW-040: Frame header format for UDP packet fragmentation. Sent
+ * whole in front of every packet's payload.
  */
 typedef struct __attribute__((packed)) {
     uint32_t magic;           /**< Magic number: 0xD7E01234 */
@@ -32,7 +33,7 @@ typedef struct __attribute__((packed)) {
     uint32_t packet_index;    /**< Packet index in frame (0-based) */
     uint32_t total_packets;   /**< Total packets in frame */
     uint32_t payload_len;     /**< Payload length in this packet */
-    uint32_t timestamp;       /**< Timestamp in nanoseconds */
+    uint32_t timestamp;       /**< CLOCK_MONOTONIC ns, low 32 bits */
     uint16_t header_crc;      /**< CRC-16 of header (excluding this field) */
     uint16_t reserved;        /**< Reserved for future use */
 } eth_frame_header_t;
@@ -40,8 +41,13 @@ typedef struct __attribute__((packed)) {
 /* Frame header magic number */
 #define ETH_FRAME_MAGIC         0xD7E01234
 
-/* Frame header size */
-#define ETH_FRAME_HEADER_SIZE   32
+/* Frame header size (sizeof(eth_frame_header_t)) */
+#define ETH_FRAME_HEADER_SIZE   40
+
+/* Frame header flags */
+#define ETH_FRAME_FLAG_NO_SIGNAL    0x0001  /**< Exposure gate found no X-ray signal */
+#define ETH_FRAME_FLAG_DECIMATED    0x0002  /**< Binned; width/height give the sent size */
+#define ETH_FRAME_FLAG_SUPPRESSED   0x0004  /**< Header-only marker, frame not sent */
 
 /* Maximum UDP payload size (MTU 1500 - IP header 20 - UDP header 8) */
 #define ETH_MAX_UDP_PAYLOAD     1472
@@ -154,6 +160,89 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
                                  uint16_t bit_depth,
                                  uint32_t frame_number);
 
+/**
+ * @brief Send a frame with header flags set
+ *
+ * Same as eth_tx_send_frame() with @p flags (ETH_FRAME_FLAG_*) in every
+ * packet header of the frame.
+ *
+ * @param flags Frame flags
+ * @return ETH_TX_OK on success, error code on failure
+ */
+eth_tx_status_t eth_tx_send_frame_flags(eth_tx_t *eth,
+                                       const void *frame_data,
+                                       size_t frame_size,
+                                       uint32_t width,
+                                       uint32_t height,
+                                       uint16_t bit_depth,
+                                       uint32_t frame_number,
+                                       uint16_t flags);
+
+/**
+ * @brief Send a header-only marker in place of a frame
+ *
+ * One packet with packet_index 0, total_packets 1 and payload_len 0, so
+ * the host sees the frame number without its data.
+ *
+ * @param eth Ethernet TX handle
+ * @param frame_number Frame sequence number
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param bit_depth Bits per pixel
+ * @param flags Frame flags (normally includes ETH_FRAME_FLAG_SUPPRESSED)
+ * @return ETH_TX_OK on success, error code on failure
+ */
+eth_tx_status_t eth_tx_send_marker(eth_tx_t *eth,
+                                  uint32_t frame_number,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  uint16_t bit_depth,
+                                  uint16_t flags);
+
+/**
+ * @brief Specialise packetization for the stream geometry
+ *
+ * @param eth Ethernet TX handle
+ * @param width Frame width in pixels (0 clears the plan)
+ * @param height Frame height in pixels
+ * @param bit_depth Bits per pixel (1..16; above 8 takes two bytes)
+ * @return ETH_TX_OK on success, ETH_TX_ERROR_PARAM for an invalid geometry
+ *
+ * Called once at startup from the detector configuration. Packet count,
+ * payload split and the header CRC patch table are fixed for that frame
+ * size, so eth_tx_send_frame() sends matching frames without per-packet
+ * division, allocation, payload copy or full header CRC. Frames of any
+ * other size take the generic path.
+ */
+eth_tx_status_t eth_tx_set_geometry(eth_tx_t *eth,
+                                   uint32_t width,
+                                   uint32_t height,
+                                   uint16_t bit_depth);
+
+/**
+ * @brief Pre-build the header template for an upcoming frame
+ *
+ * @param eth Ethernet TX handle
+ * @param frame_number Frame number the frame will be sent with (the daemon
+ *        uses the CSI-2 sequence number on both sides)
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param bit_depth Bits per pixel (14 or 16)
+ * @param sof_timestamp_ns Start-of-frame time in ns (0 = stamp at send time)
+ * @return ETH_TX_OK on success, error code on failure
+ *
+ * Called on CSI-2 start-of-frame so per-frame header fields are ready
+ * before the frame is committed. The header timestamp is then the
+ * exposure-aligned start-of-frame time instead of the transmit time.
+ * Safe to call from another thread than the one sending frames.
+ */
+eth_tx_status_t eth_tx_prepare_frame(eth_tx_t *eth,
+                                    uint32_t frame_number,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    uint16_t bit_depth,
+                                    uint64_t sof_timestamp_ns);
+
 /**
  * @brief Send a command packet
  *
@@ -182,6 +271,8 @@ const char *eth_get_error(eth_tx_t *eth);
  * @param eth Ethernet TX handle
  * @param stats Pointer to store statistics
  * @return ETH_TX_OK on success, error code on failure
+ *
+ * Lock-free; safe to call from any thread while frames are being sent.
  */
 eth_tx_status_t eth_tx_get_stats(eth_tx_t *eth, eth_tx_stats_t *stats);
 
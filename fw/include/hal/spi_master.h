@@ -185,6 +185,8 @@ const char *spi_get_error(spi_master_t *spi);
  * @param write_errors Pointer to store write error count
  * @param read_errors Pointer to store read error count
  * @return SPI_OK on success, error code on failure
+ *
+ * Lock-free: does not wait for a transaction in progress.
  */
 spi_status_t spi_get_stats(spi_master_t *spi,
                           uint32_t *total_writes,
@@ -8,6 +8,22 @@
  * REQ-FW-111: Runtime statistics aggregation
  * REQ-FW-112: GET_STATUS response < 50ms
  *
+ * Per-frame metrics (image QA) are kept as time series of fixed
+ * intervals: every interval stores the mean, min and max of the samples
+ * recorded in it, so HEALTH_SERIES_LEN points cover ten minutes whatever
+ * the frame rate.
+ *
+ * Runtime counters are indexed by health_stat_t. Each updating thread owns
+ * a cacheline-aligned block of counters that only it writes, so an update
+ * is a relaxed load and store without locks or shared cache lines; readers
+ * sum the blocks on demand. health_monitor_update_stat() maps the old
+ * counter names onto the same counters.
+ *
+ * GET_STATUS never touches SPI or I2C: a collector thread reads the
+ * sequence state, battery gauge and FPGA temperature at their own rates
+ * into a seqlock snapshot, and health_monitor_get_status() copies it,
+ * reporting how old each field is.
+ *
  * Copyright (c) 2026 ABYZ Lab
  */
 
@@ -17,6 +33,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <time.h>
+
+#include "hal/spi_master.h"
+#include "hal/bq40z50_driver.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,6 +49,13 @@ extern "C" {
 #define WATCHDOG_PET_INTERVAL_MS  1000    /* 1 second */
 #define WATCHDOG_TIMEOUT_MS       5000    /* 5 seconds */
 #define STATUS_RESPONSE_MAX_MS    50      /* GET_STATUS max response time */
+#define HEALTH_SERIES_INTERVAL_MS 1000    /* One time series point per second */
+#define HEALTH_SERIES_LEN         600     /* Points kept per metric (10 minutes) */
+#define HEALTH_STAT_THREADS       16      /* Threads with their own counter block */
+#define HEALTH_STATUS_STATE_MS    10      /* Default sequence state refresh */
+#define HEALTH_STATUS_BATTERY_MS  1000    /* Default battery gauge refresh (I2C) */
+#define HEALTH_STATUS_TEMP_MS     500     /* Default FPGA temperature refresh (SPI) */
+#define HEALTH_STATUS_AGE_NONE    UINT32_MAX /* Field not collected yet */
 
 /* ==========================================================================
  * Types
@@ -45,6 +72,22 @@ typedef enum {
     LOG_CRITICAL,
 } log_level_t;
 
+/**
+ * @brief Runtime statistics counter IDs (order of runtime_stats_t)
+ */
+typedef enum {
+    HEALTH_STAT_FRAMES_RECEIVED = 0,
+    HEALTH_STAT_FRAMES_SENT,
+    HEALTH_STAT_FRAMES_DROPPED,
+    HEALTH_STAT_SPI_ERRORS,
+    HEALTH_STAT_CSI2_ERRORS,
+    HEALTH_STAT_PACKETS_SENT,
+    HEALTH_STAT_BYTES_SENT,
+    HEALTH_STAT_AUTH_FAILURES,
+    HEALTH_STAT_WATCHDOG_RESETS,
+    HEALTH_STAT_COUNT
+} health_stat_t;
+
 /**
  * @brief Runtime statistics counters
  */
@@ -60,6 +103,40 @@ typedef struct {
     uint64_t watchdog_resets;
 } runtime_stats_t;
 
+/**
+ * @brief Metrics kept as time series
+ */
+typedef enum {
+    HEALTH_METRIC_QA_MEAN = 0,          /* Frame mean (counts) */
+    HEALTH_METRIC_QA_NOISE,             /* Mean ROI noise (counts) */
+    HEALTH_METRIC_QA_SNR,               /* ROI SNR */
+    HEALTH_METRIC_QA_ROW_BANDING,       /* Row banding index (counts) */
+    HEALTH_METRIC_QA_COL_BANDING,       /* Column banding index (counts) */
+    HEALTH_METRIC_QA_NONUNIFORMITY,     /* ROI non-uniformity (fraction) */
+    HEALTH_METRIC_COUNT
+} health_metric_t;
+
+/**
+ * @brief One time series point (one HEALTH_SERIES_INTERVAL_MS interval)
+ */
+typedef struct {
+    uint64_t time_ms;        /* Start of the interval */
+    float mean;              /* Mean of the samples */
+    float min;               /* Smallest sample */
+    float max;               /* Largest sample */
+    uint32_t samples;        /* Samples recorded in the interval */
+} health_point_t;
+
+/**
+ * @brief Collected fields of system_status_t
+ */
+typedef enum {
+    HEALTH_STATUS_STATE = 0,            /* state */
+    HEALTH_STATUS_BATTERY,              /* battery_soc, battery_mv */
+    HEALTH_STATUS_FPGA_TEMP,            /* fpga_temp */
+    HEALTH_STATUS_FIELD_COUNT
+} health_status_field_t;
+
 /**
  * @brief System status for GET_STATUS command
  */
@@ -70,8 +147,21 @@ typedef struct {
     uint16_t battery_mv;     /* Battery voltage (mV) */
     uint32_t uptime_sec;     /* Daemon uptime (seconds) */
     uint16_t fpga_temp;      /* FPGA temperature (0.1 C) */
+    uint32_t age_ms[HEALTH_STATUS_FIELD_COUNT]; /* Since each field was read (HEALTH_STATUS_AGE_NONE = never) */
 } system_status_t;
 
+/**
+ * @brief Status collector configuration
+ */
+typedef struct {
+    spi_master_t *spi;              /* FPGA registers (NULL = no temperature) */
+    bq40z50_context_t *battery;     /* Initialized battery gauge (NULL = none) */
+    uint32_t state_ms;              /* Refresh periods (0 = HEALTH_STATUS_*_MS) */
+    uint32_t battery_ms;
+    uint32_t temp_ms;
+    int nice;                       /* Collector thread nice value (0 = inherit) */
+} health_status_config_t;
+
 /**
  * @brief Health monitor context
  */
@@ -81,7 +171,6 @@ typedef struct {
     uint64_t last_pet_ms;
     bool is_alive;
     uint64_t watchdog_reset_count;
-    runtime_stats_t stats;
     log_level_t log_level;
     /* External references (set by main daemon) */
     void *seq_engine;
@@ -121,12 +210,88 @@ bool health_monitor_is_alive(void);
 void health_monitor_get_stats(runtime_stats_t *stats);
 
 /**
- * @brief Update a specific statistic counter
+ * @brief Add to a runtime counter
+ *
+ * Lock-free and safe from any thread. The first update of a thread claims
+ * a free counter block, handed back when the thread exits; a thread that
+ * finds all HEALTH_STAT_THREADS blocks owned uses a shared block updated
+ * with atomic adds. A counter whose total would go negative reads as 0.
+ *
+ * @param stat Counter
+ * @param delta Value to add (can be negative)
+ */
+void health_monitor_add_stat(health_stat_t stat, int64_t delta);
+
+/**
+ * @brief Current total of one runtime counter
+ * @param stat Counter
+ * @return Sum over all counter blocks (0 for an invalid counter)
+ */
+uint64_t health_monitor_read_stat(health_stat_t stat);
+
+/**
+ * @brief Update a specific statistic counter by name
+ *
+ * Compatibility wrapper of health_monitor_add_stat() for callers that
+ * still pass counter names (e.g. "frames_sent"); unknown names are
+ * ignored.
+ *
  * @param name Name of the statistic to update
  * @param delta Value to add (can be negative)
  */
 void health_monitor_update_stat(const char *name, int64_t delta);
 
+/**
+ * @brief Get the name of a runtime counter (e.g. "frames_sent")
+ * @param stat Counter
+ * @return Name, or "unknown"
+ */
+const char *health_monitor_stat_name(health_stat_t stat);
+
+/**
+ * @brief Record a sample of a time series metric
+ *
+ * Thread-safe; samples in the same interval are folded into one point.
+ *
+ * @param metric Metric
+ * @param value Sample
+ * @return 0 on success, negative error code on failure
+ */
+int health_monitor_record_metric(health_metric_t metric, float value);
+
+/**
+ * @brief Copy the most recent points of a metric, oldest first
+ *
+ * The last point may still be collecting samples.
+ *
+ * @param metric Metric
+ * @param points Output points
+ * @param max Capacity of points
+ * @return Points written, or negative error code on failure
+ */
+int health_monitor_get_series(health_metric_t metric, health_point_t *points, uint32_t max);
+
+/**
+ * @brief Get the name of a metric (e.g. "qa_noise")
+ * @param metric Metric
+ * @return Name, or "unknown"
+ */
+const char *health_monitor_metric_name(health_metric_t metric);
+
+/**
+ * @brief Move log formatting and syslog writes to a background thread
+ *
+ * Afterwards health_monitor_log() only queues the call; module and format
+ * must be string literals. Stopped by health_monitor_deinit().
+ * @return 0 on success, negative error code on failure
+ */
+int health_monitor_start_async_log(void);
+
+/**
+ * @brief Drain queued log lines and return to synchronous logging
+ */
+void health_monitor_stop_async_log(void);
+
 /**
  * @brief Log a structured message
  * @param level Log level
@@ -138,11 +303,34 @@ void health_monitor_log(log_level_t level, const char *module, const char *forma
 
 /**
  * @brief Get complete system status for GET_STATUS command
+ *
+ * Lock-free copy of the collector's snapshot plus the runtime counters; no
+ * device access. Until the collector has read a field it holds a default
+ * (IDLE, 100 %, 3700 mV, 35.0 C) with age HEALTH_STATUS_AGE_NONE; a field
+ * whose device read fails keeps its last value and ages.
+ *
  * @param status Pointer to status structure to fill
- * @return 0 on success, negative error code on failure
+ * @return 0 on success, -EAGAIN if the collector kept the snapshot
+ *         changing, negative error code on failure
  */
 int health_monitor_get_status(system_status_t *status);
 
+/**
+ * @brief Start the status collector thread
+ *
+ * Reads every field once before returning, then refreshes each at its
+ * period on a SCHED_OTHER thread. Stopped by health_monitor_deinit().
+ *
+ * @param config Devices and periods
+ * @return 0 on success, negative error code on failure
+ */
+int health_monitor_start_status(const health_status_config_t *config);
+
+/**
+ * @brief Stop the status collector (the snapshot keeps its last values)
+ */
+void health_monitor_stop_status(void);
+
 /**
  * @brief Set minimum log level
  * @param level New log level
@@ -172,6 +360,11 @@ uint64_t health_get_time_ms(void);
  * @param time_ms Time in milliseconds
  */
 void health_set_time_ms(uint64_t time_ms);
+
+/**
+ * @brief Counter blocks currently owned by a live thread
+ */
+uint32_t health_stat_blocks_owned(void);
 #endif
 
 #ifdef __cplusplus
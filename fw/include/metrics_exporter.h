@@ -0,0 +1,203 @@
+/**
+ * @file metrics_exporter.h
+ * @brief OpenMetrics (Prometheus) HTTP endpoint for daemon statistics
+ *
+ * A plain HTTP/1.0 server on one SCHED_OTHER thread answers
+ * GET /metrics with the OpenMetrics text format. Every scrape calls the
+ * owner's collect callback, which writes counters, gauges and histograms
+ * with the metrics_write_*() functions; the callback must only read
+ * statistics that are safe to read from another thread without a lock
+ * (atomics, or plain aligned words updated by a single writer), so a
+ * scrape never blocks the capture or TX path.
+ *
+ * Histograms (metrics_histogram_t) are fixed-bucket, updated with relaxed
+ * atomic adds by the thread that measures, and read by the scrape.
+ */
+
+#ifndef DETECTOR_METRICS_EXPORTER_H
+#define DETECTOR_METRICS_EXPORTER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Exporter result codes
+ */
+typedef enum {
+    METRICS_OK = 0,                 /**< Success */
+    METRICS_ERROR_NULL = -1,        /**< NULL pointer argument */
+    METRICS_ERROR_PARAM = -2,       /**< Invalid parameter */
+    METRICS_ERROR_SOCKET = -3,      /**< Listen socket could not be set up */
+    METRICS_ERROR_THREAD = -4,      /**< Server thread creation failed */
+    METRICS_ERROR_STATE = -5,       /**< Already running */
+    METRICS_ERROR_MEMORY = -6       /**< Scrape buffer allocation failed */
+} metrics_status_t;
+
+#define METRICS_DEFAULT_PORT        9464
+#define METRICS_HIST_MAX_BUCKETS    16      /* Finite buckets; +Inf is implicit */
+#define METRICS_MAX_BODY            (256U * 1024U)
+
+/**
+ * @brief Fixed-bucket histogram of durations
+ */
+typedef struct {
+    uint32_t buckets;                                   /**< Finite buckets in use */
+    uint64_t bounds_ns[METRICS_HIST_MAX_BUCKETS];       /**< Upper bounds, ascending */
+    atomic_uint_least64_t counts[METRICS_HIST_MAX_BUCKETS + 1]; /**< Per bucket, last = +Inf */
+    atomic_uint_least64_t sum_ns;                       /**< Sum of observations */
+} metrics_histogram_t;
+
+/**
+ * @brief Scrape output being built (passed to the collect callback)
+ */
+typedef struct metrics_writer metrics_writer_t;
+
+/**
+ * @brief Collect callback, run on the exporter thread for every scrape
+ *
+ * @param writer Output
+ * @param user_data metrics_config_t.user_data
+ */
+typedef void (*metrics_collect_fn_t)(metrics_writer_t *writer, void *user_data);
+
+/**
+ * @brief Exporter configuration
+ */
+typedef struct {
+    const char *listen_addr;        /**< IPv4 address to bind (NULL = 127.0.0.1) */
+    uint16_t port;                  /**< TCP port (0 = any free port, see metrics_server_port()) */
+    metrics_collect_fn_t collect;   /**< Writes the metrics */
+    void *user_data;                /**< Passed to collect */
+    int nice;                       /**< Server thread nice value (0 = inherit) */
+} metrics_config_t;
+
+/**
+ * @brief Exporter counters
+ */
+typedef struct {
+    uint64_t scrapes;               /**< GET /metrics answered */
+    uint64_t bad_requests;          /**< Other requests, malformed or timed out */
+    uint32_t last_bytes;            /**< Size of the last scrape body */
+    uint32_t last_us;               /**< Time to collect and send the last scrape */
+} metrics_server_stats_t;
+
+/* ==========================================================================
+ * Histogram
+ * ========================================================================== */
+
+/**
+ * @brief Set bucket bounds and clear the histogram
+ *
+ * @param hist Histogram
+ * @param bounds_ns Upper bounds in nanoseconds, strictly ascending
+ * @param count Bounds (1..METRICS_HIST_MAX_BUCKETS)
+ * @return METRICS_OK on success, error code on failure
+ */
+metrics_status_t metrics_histogram_init(metrics_histogram_t *hist,
+                                        const uint64_t *bounds_ns, uint32_t count);
+
+/**
+ * @brief Record one duration (any thread, lock-free)
+ *
+ * @param hist Histogram
+ * @param value_ns Duration in nanoseconds
+ */
+void metrics_histogram_observe(metrics_histogram_t *hist, uint64_t value_ns);
+
+/* ==========================================================================
+ * Writer (collect callback only)
+ * ========================================================================== */
+
+/**
+ * @brief Write a metric family header (# TYPE, # HELP)
+ *
+ * @param writer Output
+ * @param name Family name (no _total suffix)
+ * @param type "counter", "gauge" or "histogram"
+ * @param help Help text
+ */
+void metrics_write_family(metrics_writer_t *writer, const char *name,
+                          const char *type, const char *help);
+
+/**
+ * @brief Write one sample of the current family
+ *
+ * @param writer Output
+ * @param name Sample name (e.g. family name plus "_total" for counters)
+ * @param label Label name (NULL = no label)
+ * @param label_value Label value
+ * @param value Value
+ */
+void metrics_write_sample(metrics_writer_t *writer, const char *name,
+                          const char *label, const char *label_value, double value);
+
+/**
+ * @brief Write an unlabelled counter family with its one sample
+ */
+void metrics_write_counter(metrics_writer_t *writer, const char *name,
+                           const char *help, uint64_t value);
+
+/**
+ * @brief Write an unlabelled gauge family with its one sample
+ */
+void metrics_write_gauge(metrics_writer_t *writer, const char *name,
+                         const char *help, double value);
+
+/**
+ * @brief Write a histogram family in seconds (buckets, _count, _sum)
+ */
+void metrics_write_histogram(metrics_writer_t *writer, const char *name,
+                             const char *help, const metrics_histogram_t *hist);
+
+/* ==========================================================================
+ * Server
+ * ========================================================================== */
+
+/**
+ * @brief Bind the listen socket and start the server thread
+ *
+ * @param config Configuration
+ * @return METRICS_OK on success, error code on failure
+ */
+metrics_status_t metrics_server_start(const metrics_config_t *config);
+
+/**
+ * @brief Stop the server thread and close the socket
+ */
+void metrics_server_stop(void);
+
+/**
+ * @brief Bound TCP port (0 if not running)
+ */
+uint16_t metrics_server_port(void);
+
+/**
+ * @brief Get exporter counters
+ *
+ * @param stats Output counters
+ * @return METRICS_OK on success, error code on failure
+ */
+metrics_status_t metrics_server_get_stats(metrics_server_stats_t *stats);
+
+/**
+ * @brief Render one scrape body without a server (tools and tests)
+ *
+ * @param collect Collect callback
+ * @param user_data Passed to collect
+ * @param buf Output buffer (NUL-terminated)
+ * @param cap Capacity of buf
+ * @return Body length, or negative error code (METRICS_ERROR_PARAM if cap is too small)
+ */
+int metrics_render(metrics_collect_fn_t collect, void *user_data, char *buf, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_METRICS_EXPORTER_H */
@@ -0,0 +1,174 @@
+/**
+ * @file auto_exposure.h
+ * @brief Closed-loop auto-exposure controller
+ *
+ * Drives FPGA_REG_TIMING (integration time) and FPGA_REG_GAIN from the
+ * per-frame statistics of frame_stats.h during continuous scans:
+ *
+ *     ratio   = (target / measured) ^ damping, clamped to [1/max_step, max_step]
+ *     product = timing * gain * ratio
+ *
+ * The product is realised with unity gain where possible; gain is only
+ * raised once timing is at its maximum (and lowered below unity once
+ * timing is at its minimum). Errors inside the deadband leave the
+ * registers untouched. After a change the controller waits settle_frames
+ * frames so frames exposed with the old settings do not feed back.
+ *
+ * The controller is pure arithmetic; the caller writes the returned
+ * register values and reports the write latency via ae_record_write().
+ */
+
+#ifndef DETECTOR_PROC_AUTO_EXPOSURE_H
+#define DETECTOR_PROC_AUTO_EXPOSURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "proc/frame_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* FPGA_REG_GAIN is linear with 0x0080 = 1.0x */
+#define AE_GAIN_UNITY               0x0080U
+
+/* Defaults */
+#define AE_DEFAULT_TARGET           20000U  /**< Target level in counts */
+#define AE_DEFAULT_PERCENTILE       0.99f
+#define AE_DEFAULT_DEADBAND         0.05f   /**< +/-5% */
+#define AE_DEFAULT_DAMPING          0.7f
+#define AE_DEFAULT_MAX_STEP         2.0f
+#define AE_DEFAULT_SETTLE_FRAMES    1U
+
+/* SPI write budget between frames (two 32-bit transactions at 50 MHz) */
+#define AE_WRITE_BUDGET_US          200U
+
+/**
+ * @brief Brightness metric driven to the target
+ */
+typedef enum {
+    AE_METRIC_ROI_MEAN = 0,     /**< Mean of the statistics ROI */
+    AE_METRIC_PERCENTILE        /**< Histogram percentile (highlight-based) */
+} ae_metric_t;
+
+/**
+ * @brief Exposure register pair
+ */
+typedef struct {
+    uint16_t timing;            /**< FPGA_REG_TIMING value */
+    uint16_t gain;              /**< FPGA_REG_GAIN value */
+} ae_exposure_t;
+
+/**
+ * @brief Controller configuration
+ */
+typedef struct {
+    ae_metric_t metric;         /**< Brightness metric */
+    float percentile;           /**< Fraction for AE_METRIC_PERCENTILE */
+    uint16_t target;            /**< Target metric value in counts */
+    float deadband;             /**< Relative error ignored (e.g. 0.05) */
+    float damping;              /**< Exponent applied to the correction (0, 1] */
+    float max_step;             /**< Max exposure ratio change per update (> 1) */
+    uint32_t settle_frames;     /**< Frames skipped after a change */
+    uint16_t timing_min;        /**< Minimum timing register value (>= 1) */
+    uint16_t timing_max;        /**< Maximum timing register value */
+    uint16_t gain_min;          /**< Minimum gain register value (>= 1) */
+    uint16_t gain_max;          /**< Maximum gain register value */
+} ae_config_t;
+
+/**
+ * @brief Controller statistics
+ */
+typedef struct {
+    uint64_t frames;            /**< Frames evaluated */
+    uint64_t adjustments;       /**< Register updates requested */
+    uint64_t settle_skips;      /**< Frames skipped while settling */
+    uint64_t at_limit;          /**< Updates clamped by timing and gain limits */
+    float last_metric;          /**< Last measured metric */
+    uint64_t writes;            /**< Register writes reported */
+    uint64_t write_errors;      /**< Failed register writes */
+    uint64_t late_writes;       /**< Writes over AE_WRITE_BUDGET_US */
+    uint32_t last_write_us;     /**< Last write latency */
+    uint32_t max_write_us;      /**< Worst write latency */
+} ae_stats_t;
+
+/**
+ * @brief Opaque controller handle
+ */
+typedef struct ae_controller ae_controller_t;
+
+/**
+ * @brief Fill configuration with defaults
+ *
+ * @param config Configuration to initialise
+ */
+void ae_config_defaults(ae_config_t *config);
+
+/**
+ * @brief Create controller
+ *
+ * @param config Controller configuration
+ * @param initial Register values currently programmed
+ * @return Handle on success, NULL on invalid config or allocation failure
+ */
+ae_controller_t *ae_create(const ae_config_t *config, const ae_exposure_t *initial);
+
+/**
+ * @brief Destroy controller
+ *
+ * @param ae Handle (NULL is ignored)
+ */
+void ae_destroy(ae_controller_t *ae);
+
+/**
+ * @brief Resynchronise with the programmed registers (e.g. at scan start)
+ *
+ * @param ae Controller handle
+ * @param current Register values currently programmed
+ */
+void ae_reset(ae_controller_t *ae, const ae_exposure_t *current);
+
+/**
+ * @brief Evaluate one frame
+ *
+ * @param ae Controller handle
+ * @param stats Frame statistics
+ * @param next Register values to program (valid when true is returned)
+ * @return true if the registers should be written before the next frame
+ */
+bool ae_update(ae_controller_t *ae, const fstats_t *stats, ae_exposure_t *next);
+
+/**
+ * @brief Report the outcome of a register write requested by ae_update
+ *
+ * @param ae Controller handle
+ * @param latency_us Time spent writing
+ * @param ok true if all writes succeeded
+ *
+ * A failed write reverts the controller to its previous register values.
+ */
+void ae_record_write(ae_controller_t *ae, uint32_t latency_us, bool ok);
+
+/**
+ * @brief Get current register values
+ *
+ * @param ae Controller handle
+ * @param exposure Pointer to store register values
+ */
+void ae_get_exposure(const ae_controller_t *ae, ae_exposure_t *exposure);
+
+/**
+ * @brief Get controller statistics
+ *
+ * @param ae Controller handle
+ * @param stats Pointer to store statistics
+ */
+void ae_get_stats(const ae_controller_t *ae, ae_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_AUTO_EXPOSURE_H */
@@ -0,0 +1,230 @@
+/**
+ * @file calibration.h
+ * @brief On-device dark/flood calibration accumulator
+ *
+ * In SCAN_MODE_CALIBRATION the daemon averages N dark frames and N flood
+ * frames on the SoC instead of streaming them, derives offset and gain
+ * maps for the correction stage and persists them atomically:
+ *
+ *     offset[i] = round(mean_dark[i])
+ *     gain[i]   = mean(flood - offset) / (mean_flood[i] - offset[i])
+ *
+ * Frames are summed into 32-bit accumulators (NEON/AVX2/scalar), which
+ * cannot overflow for up to CALIB_MAX_FRAMES 16-bit frames.
+ */
+
+#ifndef DETECTOR_PROC_CALIBRATION_H
+#define DETECTOR_PROC_CALIBRATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calibration result codes
+ */
+typedef enum {
+    CALIB_OK = 0,               /**< Frame accumulated, phase still running */
+    CALIB_PHASE_COMPLETE = 1,   /**< Frame accumulated, phase finished */
+    CALIB_ERROR_NULL = -1,      /**< NULL pointer argument */
+    CALIB_ERROR_PARAM = -2,     /**< Invalid parameter */
+    CALIB_ERROR_MEMORY = -3,    /**< Memory allocation failed */
+    CALIB_ERROR_STATE = -4,     /**< Operation not valid in current phase */
+    CALIB_ERROR_FILE = -5,      /**< Map file I/O failed */
+    CALIB_ERROR_FORMAT = -6     /**< Map file corrupt or mismatched */
+} calib_status_t;
+
+/**
+ * @brief Calibration phase
+ */
+typedef enum {
+    CALIB_PHASE_IDLE = 0,       /**< Not accumulating */
+    CALIB_PHASE_DARK,           /**< Accumulating dark (no X-ray) frames */
+    CALIB_PHASE_FLOOD           /**< Accumulating flood (uniform X-ray) frames */
+} calib_phase_t;
+
+/**
+ * @brief Calibration configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+} calib_config_t;
+
+/**
+ * @brief Calibration statistics
+ */
+typedef struct {
+    calib_phase_t phase;        /**< Current phase */
+    uint32_t frames_target;     /**< Frames requested for current phase */
+    uint32_t frames_accumulated;/**< Frames accumulated in current phase */
+    uint32_t dark_frames;       /**< Frames behind current offset map (0 = none) */
+    uint32_t flood_frames;      /**< Frames behind current gain map (0 = none) */
+    float dark_mean;            /**< Mean of offset map (counts) */
+    float flood_mean;           /**< Mean flood signal above offset (counts) */
+    uint32_t dead_pixels;       /**< Pixels with no flood response (gain = 0) */
+} calib_stats_t;
+
+/**
+ * @brief Opaque calibration handle
+ */
+typedef struct calibration calib_t;
+
+/* 65536 x 65535 fits in uint32 */
+#define CALIB_MAX_FRAMES        65536U
+#define CALIB_DEFAULT_FRAMES    64U
+
+/* Flood signal below this (counts above dark) marks a dead pixel */
+#define CALIB_MIN_SIGNAL        16.0f
+
+/* Persisted map location and format */
+#define CALIB_MAP_PATH          "/var/lib/detector/calibration.bin"
+#define CALIB_FILE_MAGIC        0x4C414344U  /* "DCAL" */
+#define CALIB_FILE_VERSION      1
+
+/**
+ * @brief Persisted map file header
+ *
+ * Followed by width * height uint16 offsets and width * height float32
+ * gains (little-endian). crc covers the map payload (CRC-16/CCITT).
+ */
+typedef struct {
+    uint32_t magic;             /**< CALIB_FILE_MAGIC */
+    uint16_t version;           /**< CALIB_FILE_VERSION */
+    uint16_t crc;               /**< CRC-16/CCITT of payload */
+    uint32_t width;             /**< Map width */
+    uint32_t height;            /**< Map height */
+    uint32_t dark_frames;       /**< Dark frames averaged */
+    uint32_t flood_frames;      /**< Flood frames averaged */
+    uint64_t timestamp;         /**< Creation time (seconds since epoch) */
+} __attribute__((packed)) calib_file_header_t;
+
+/**
+ * @brief Create calibration accumulator
+ *
+ * @param config Frame geometry
+ * @return Handle on success, NULL on invalid config or allocation failure
+ */
+calib_t *calib_create(const calib_config_t *config);
+
+/**
+ * @brief Destroy calibration accumulator
+ *
+ * @param calib Handle (NULL is ignored)
+ */
+void calib_destroy(calib_t *calib);
+
+/**
+ * @brief Start accumulating a phase
+ *
+ * @param calib Calibration handle
+ * @param phase CALIB_PHASE_DARK or CALIB_PHASE_FLOOD
+ * @param frames Frames to average (1..CALIB_MAX_FRAMES)
+ * @return CALIB_OK on success, CALIB_ERROR_STATE if a flood phase is
+ *         requested before a dark phase has completed
+ *
+ * Restarting a phase discards any partial accumulation.
+ */
+calib_status_t calib_begin(calib_t *calib, calib_phase_t phase, uint32_t frames);
+
+/**
+ * @brief Abort current phase
+ *
+ * @param calib Calibration handle
+ */
+void calib_abort(calib_t *calib);
+
+/**
+ * @brief Accumulate one frame
+ *
+ * @param calib Calibration handle
+ * @param frame Frame data (width * height pixels)
+ * @return CALIB_OK while accumulating, CALIB_PHASE_COMPLETE when the last
+ *         frame of the phase has been added and its map derived,
+ *         CALIB_ERROR_STATE when idle
+ */
+calib_status_t calib_accumulate(calib_t *calib, const uint16_t *frame);
+
+/**
+ * @brief Get current calibration phase
+ *
+ * @param calib Calibration handle
+ * @return Current phase (CALIB_PHASE_IDLE for NULL)
+ */
+calib_phase_t calib_get_phase(const calib_t *calib);
+
+/**
+ * @brief Check if both offset and gain maps are available
+ *
+ * @param calib Calibration handle
+ * @return true after a dark and a subsequent flood phase completed
+ */
+bool calib_maps_ready(const calib_t *calib);
+
+/**
+ * @brief Get derived offset map
+ *
+ * @param calib Calibration handle
+ * @return Offset map (width * height), NULL until a dark phase completed
+ */
+const uint16_t *calib_get_offset_map(const calib_t *calib);
+
+/**
+ * @brief Get derived gain map
+ *
+ * @param calib Calibration handle
+ * @return Gain map (width * height), NULL until a flood phase completed
+ */
+const float *calib_get_gain_map(const calib_t *calib);
+
+/**
+ * @brief Get calibration statistics
+ *
+ * @param calib Calibration handle
+ * @param stats Pointer to store statistics
+ */
+void calib_get_stats(const calib_t *calib, calib_stats_t *stats);
+
+/**
+ * @brief Persist offset and gain maps atomically
+ *
+ * @param calib Calibration handle with both maps ready
+ * @param path Destination file
+ * @return CALIB_OK on success, CALIB_ERROR_STATE without maps,
+ *         CALIB_ERROR_FILE on I/O failure
+ *
+ * Writes <path>.tmp, fsyncs it, renames over path and fsyncs the
+ * directory, so readers see either the old or the new maps, never a mix.
+ */
+calib_status_t calib_save_maps(const calib_t *calib, const char *path);
+
+/**
+ * @brief Load persisted maps
+ *
+ * @param path Map file
+ * @param width Expected width
+ * @param height Expected height
+ * @param offset Output offset map (width * height)
+ * @param gain Output gain map (width * height)
+ * @return CALIB_OK on success, CALIB_ERROR_FILE if unreadable,
+ *         CALIB_ERROR_FORMAT on bad magic, geometry or CRC
+ */
+calib_status_t calib_load_maps(const char *path, uint32_t width, uint32_t height,
+                               uint16_t *offset, float *gain);
+
+/**
+ * @brief Accumulation kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t calib_kernel_accumulate;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_CALIBRATION_H */
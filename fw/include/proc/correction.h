@@ -0,0 +1,281 @@
+/**
+ * @file correction.h
+ * @brief Offset/gain correction stage
+ *
+ * Applies per-pixel flat-field correction on the SoC between frame commit
+ * and Ethernet TX:
+ *
+ *     out = clamp((raw - offset) * gain, 0, 65535)
+ *
+ * Offset maps are stored as uint16 and gain maps as 16-bit Q2.14 fixed
+ * point or IEEE half-float, so each pixel streams 6 bytes (raw + offset +
+ * gain) instead of 10 with a float gain map. Kernels are NEON (AArch64),
+ * AVX2 / SSE4.2 (x86 dev hosts) or portable scalar, selected at runtime
+ * by util/cpu_dispatch, and produce bit-identical output.
+ *
+ * Frames are processed in row bands so the offset/gain slices of a band
+ * stay cache-resident and callers can correct a band as soon as it lands.
+ * With a thread pool attached, the bands of a frame run on all cores.
+ */
+
+#ifndef DETECTOR_PROC_CORRECTION_H
+#define DETECTOR_PROC_CORRECTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/thread_pool.h"
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Correction result codes
+ */
+typedef enum {
+    CORR_OK = 0,                /**< Success */
+    CORR_ERROR_NULL = -1,       /**< NULL pointer argument */
+    CORR_ERROR_PARAM = -2,      /**< Invalid parameter */
+    CORR_ERROR_MEMORY = -3,     /**< Memory allocation failed */
+    CORR_ERROR_NOT_READY = -4   /**< Offset or gain map not loaded */
+} corr_status_t;
+
+/**
+ * @brief Gain map storage format
+ */
+typedef enum {
+    CORR_GAIN_Q2_14 = 0,        /**< Unsigned Q2.14 fixed point, range [0, 4) */
+    CORR_GAIN_FP16              /**< IEEE 754 binary16 (half-float) */
+} corr_gain_format_t;
+
+/**
+ * @brief Correction stage configuration
+ */
+typedef struct {
+    uint32_t width;                 /**< Frame width in pixels */
+    uint32_t height;                /**< Frame height in pixels */
+    corr_gain_format_t gain_format; /**< Gain map storage format */
+    uint32_t band_rows;             /**< Rows per band (0 = default) */
+} corr_config_t;
+
+/**
+ * @brief Correction stage statistics
+ */
+typedef struct {
+    uint64_t frames_corrected;  /**< Frames fully corrected */
+    uint64_t bands_corrected;   /**< Row bands corrected */
+    uint32_t last_frame_us;     /**< Duration of last full-frame correction */
+    uint32_t max_frame_us;      /**< Worst full-frame correction duration */
+} corr_stats_t;
+
+/**
+ * @brief Opaque correction stage handle
+ */
+typedef struct correction correction_t;
+
+/**
+ * @brief Per-band hook run right after a band is corrected
+ *
+ * Lets a following stage (e.g. defect correction) process the band while
+ * it is still cache-resident.
+ */
+typedef void (*corr_band_hook_t)(uint16_t *frame, uint32_t row_start,
+                                 uint32_t row_count, void *user_data);
+
+/**
+ * @brief Per-tile count hook run as rows are corrected
+ *
+ * counts[tx] is the number of corrected pixels at or above the threshold
+ * in tile column tx of rows [row_start, row_start + row_count), which
+ * always lie within one tile row. Counted in the correction kernel from
+ * the clamped output, so no second pass reads the band.
+ */
+typedef void (*corr_count_hook_t)(uint32_t row_start, uint32_t row_count,
+                                  const uint32_t *counts, void *user_data);
+
+/* Q2.14 gain: 1.0 == 1 << 14 */
+#define CORR_GAIN_Q_FRAC_BITS   14
+#define CORR_GAIN_Q_ONE         (1U << CORR_GAIN_Q_FRAC_BITS)
+
+/* Default band height: 64 rows x 2048 px x 6 B = 768 KiB per band */
+#define CORR_DEFAULT_BAND_ROWS  64
+
+/* Count tile edge bound: keeps 16-bit SIMD lane counters from overflowing */
+#define CORR_COUNT_MAX_TILE     4096
+
+/**
+ * @brief Create correction stage
+ *
+ * @param config Stage configuration
+ * @return Handle on success, NULL on invalid config or allocation failure
+ *
+ * Allocates cacheline-aligned offset and gain maps for width x height
+ * pixels. The stage is not ready until both maps are loaded.
+ */
+correction_t *correction_create(const corr_config_t *config);
+
+/**
+ * @brief Destroy correction stage
+ *
+ * @param corr Handle (NULL is ignored)
+ */
+void correction_destroy(correction_t *corr);
+
+/**
+ * @brief Load offset (dark) map
+ *
+ * @param corr Correction handle
+ * @param offset Per-pixel offset values in raw counts
+ * @param count Number of entries (must equal width * height)
+ * @return CORR_OK on success, error code on failure
+ */
+corr_status_t correction_set_offset_map(correction_t *corr, const uint16_t *offset, size_t count);
+
+/**
+ * @brief Load gain map from floating-point values
+ *
+ * @param corr Correction handle
+ * @param gain Per-pixel gain factors
+ * @param count Number of entries (must equal width * height)
+ * @return CORR_OK on success, error code on failure
+ *
+ * Values are converted to the configured storage format. Q2.14 gains are
+ * saturated to [0, 4); negative or NaN gains are stored as 0.
+ */
+corr_status_t correction_set_gain_map(correction_t *corr, const float *gain, size_t count);
+
+/**
+ * @brief Load gain map already encoded in the configured format
+ *
+ * @param corr Correction handle
+ * @param gain Per-pixel gain in Q2.14 or half-float bit pattern
+ * @param count Number of entries (must equal width * height)
+ * @return CORR_OK on success, error code on failure
+ */
+corr_status_t correction_set_gain_map_raw(correction_t *corr, const uint16_t *gain, size_t count);
+
+/**
+ * @brief Check if both maps are loaded
+ *
+ * @param corr Correction handle
+ * @return true if correction can be applied
+ */
+bool correction_is_ready(const correction_t *corr);
+
+/**
+ * @brief Correct a band of rows in place
+ *
+ * @param corr Correction handle
+ * @param frame Frame base pointer (row 0)
+ * @param row_start First row of the band
+ * @param row_count Number of rows in the band
+ * @return CORR_OK on success, CORR_ERROR_NOT_READY without maps,
+ *         CORR_ERROR_PARAM if the band exceeds the frame
+ */
+corr_status_t correction_apply_rows(correction_t *corr, uint16_t *frame,
+                                    uint32_t row_start, uint32_t row_count);
+
+/**
+ * @brief Correct a full frame in place, band by band
+ *
+ * @param corr Correction handle
+ * @param frame Frame data (width * height pixels)
+ * @return CORR_OK on success, error code on failure
+ *
+ * Updates frame timing statistics.
+ */
+corr_status_t correction_apply_frame(correction_t *corr, uint16_t *frame);
+
+/**
+ * @brief Set per-band hook for correction_apply_frame
+ *
+ * @param corr Correction handle
+ * @param hook Hook function (NULL to remove)
+ * @param user_data Passed to hook
+ */
+void correction_set_band_hook(correction_t *corr, corr_band_hook_t hook, void *user_data);
+
+/**
+ * @brief Count output pixels at or above a threshold per tile while correcting
+ *
+ * @param corr Correction handle
+ * @param threshold Counted if the corrected pixel is >= threshold
+ * @param tile_size Square tile edge in pixels (1..CORR_COUNT_MAX_TILE)
+ * @param hook Hook receiving the counts (NULL to stop counting)
+ * @param user_data Passed to hook
+ * @return CORR_OK on success, CORR_ERROR_PARAM on invalid tile size,
+ *         CORR_ERROR_MEMORY on allocation failure
+ *
+ * Applies to correction_apply_frame and correction_apply_rows. Like the
+ * band hook, the count hook runs on the thread that corrected the rows.
+ */
+corr_status_t correction_set_count_hook(correction_t *corr, uint16_t threshold, uint32_t tile_size,
+                                       corr_count_hook_t hook, void *user_data);
+
+/**
+ * @brief Spread correction_apply_frame bands over a thread pool
+ *
+ * @param corr Correction handle
+ * @param pool Pool (NULL to correct on the calling thread)
+ *
+ * With a pool, bands are corrected concurrently and the band and count
+ * hooks run on whichever pool thread corrected the band, so they must
+ * tolerate concurrent calls for disjoint bands. The pool must outlive its use.
+ */
+void correction_set_thread_pool(correction_t *corr, tp_pool_t *pool);
+
+/**
+ * @brief Get correction statistics
+ *
+ * @param corr Correction handle
+ * @param stats Pointer to store statistics
+ */
+void correction_get_stats(const correction_t *corr, corr_stats_t *stats);
+
+/**
+ * @brief Get name of the Q2.14 kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *correction_get_kernel_name(void);
+
+/**
+ * @brief Row kernels for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t correction_kernel_q14;
+extern const cpu_kernel_t correction_kernel_fp16;
+extern const cpu_kernel_t correction_kernel_q14_count;
+extern const cpu_kernel_t correction_kernel_fp16_count;
+
+/**
+ * @brief Convert float gain to Q2.14
+ *
+ * @param gain Gain factor
+ * @return Saturated Q2.14 value
+ */
+uint16_t correction_gain_to_q14(float gain);
+
+/**
+ * @brief Convert float to IEEE half-float (round to nearest even)
+ *
+ * @param value Input value
+ * @return binary16 bit pattern
+ */
+uint16_t correction_float_to_fp16(float value);
+
+/**
+ * @brief Convert IEEE half-float to float
+ *
+ * @param half binary16 bit pattern
+ * @return Float value
+ */
+float correction_fp16_to_float(uint16_t half);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_CORRECTION_H */
@@ -0,0 +1,169 @@
+/**
+ * @file defect_map.h
+ * @brief Defect pixel correction with a sparse row-indexed defect list
+ *
+ * Defects (single pixels, row lines, column lines, rectangular clusters)
+ * are staged as records and compiled into a sorted sparse index:
+ *
+ * - one entry per defective pixel with up to 4 precomputed good
+ *   neighbours (vertical for row lines, horizontal for column lines,
+ *   both for pixels and clusters)
+ * - entries grouped by the last row they touch, with a per-row start
+ *   table, so a band [r0, r1) is corrected by walking one contiguous run
+ *   of entries as soon as rows up to r1 are final
+ *
+ * Cost is proportional to the number of defective pixels; rows without
+ * defects are never touched. Applied after the offset/gain stage on each
+ * band while it is still cache-resident.
+ */
+
+#ifndef DETECTOR_PROC_DEFECT_MAP_H
+#define DETECTOR_PROC_DEFECT_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Defect map result codes
+ */
+typedef enum {
+    DEFECT_OK = 0,              /**< Success */
+    DEFECT_ERROR_NULL = -1,     /**< NULL pointer argument */
+    DEFECT_ERROR_PARAM = -2,    /**< Record outside frame or invalid type */
+    DEFECT_ERROR_MEMORY = -3,   /**< Memory allocation failed */
+    DEFECT_ERROR_FULL = -4      /**< Staging list full */
+} defect_status_t;
+
+/**
+ * @brief Defect record type
+ */
+typedef enum {
+    DEFECT_TYPE_PIXEL = 0,      /**< Single pixel at (x, y) */
+    DEFECT_TYPE_ROW,            /**< Entire row y */
+    DEFECT_TYPE_COLUMN,         /**< Entire column x */
+    DEFECT_TYPE_CLUSTER,        /**< Rectangle (x, y, w, h) */
+    DEFECT_TYPE_MAX
+} defect_type_t;
+
+/**
+ * @brief Defect record (wire format for CMD_SET_CONFIG, little-endian)
+ */
+typedef struct {
+    uint8_t type;               /**< defect_type_t */
+    uint8_t reserved;           /**< Must be 0 */
+    uint16_t x;                 /**< Column (PIXEL, COLUMN, CLUSTER) */
+    uint16_t y;                 /**< Row (PIXEL, ROW, CLUSTER) */
+    uint16_t w;                 /**< Cluster width */
+    uint16_t h;                 /**< Cluster height */
+} __attribute__((packed)) defect_record_t;
+
+/**
+ * @brief Defect map configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint32_t max_records;       /**< Staging capacity (0 = default) */
+} defect_config_t;
+
+/**
+ * @brief Opaque defect map handle
+ */
+typedef struct defect_map defect_map_t;
+
+#define DEFECT_DEFAULT_MAX_RECORDS  65536U
+
+/* Nearest good neighbour search distance in each direction */
+#define DEFECT_MAX_SEARCH           8
+
+/* After defect_map_apply_rows() up to row r, rows from r - this value on
+ * may still be written (defects awaiting lower neighbours) or read (as
+ * neighbours of those defects) by the next band */
+#define DEFECT_BAND_LAG_ROWS        (2 * DEFECT_MAX_SEARCH)
+
+/**
+ * @brief Create defect map
+ *
+ * @param config Frame geometry
+ * @return Handle on success, NULL on invalid config or allocation failure
+ */
+defect_map_t *defect_map_create(const defect_config_t *config);
+
+/**
+ * @brief Destroy defect map
+ *
+ * @param dm Handle (NULL is ignored)
+ */
+void defect_map_destroy(defect_map_t *dm);
+
+/**
+ * @brief Clear staged records (active index is kept until commit)
+ *
+ * @param dm Defect map handle
+ */
+void defect_map_clear(defect_map_t *dm);
+
+/**
+ * @brief Stage a defect record
+ *
+ * @param dm Defect map handle
+ * @param record Record to add
+ * @return DEFECT_OK on success, DEFECT_ERROR_PARAM if outside the frame,
+ *         DEFECT_ERROR_FULL if staging is full
+ */
+defect_status_t defect_map_add(defect_map_t *dm, const defect_record_t *record);
+
+/**
+ * @brief Compile staged records into the active index
+ *
+ * @param dm Defect map handle
+ * @return DEFECT_OK on success, DEFECT_ERROR_MEMORY on allocation failure
+ *
+ * Safe to call while another thread applies the map; the new index
+ * replaces the old one between bands.
+ */
+defect_status_t defect_map_commit(defect_map_t *dm);
+
+/**
+ * @brief Number of defective pixels in the active index
+ *
+ * @param dm Defect map handle
+ * @return Defective pixel count
+ */
+size_t defect_map_count(const defect_map_t *dm);
+
+/**
+ * @brief Correct defects whose neighbourhood ends within a row band
+ *
+ * @param dm Defect map handle
+ * @param frame Frame base pointer (row 0)
+ * @param row_start First row of the band
+ * @param row_count Rows in the band
+ * @return DEFECT_OK on success, DEFECT_ERROR_PARAM if band exceeds frame
+ *
+ * Rows [0, row_start + row_count) must hold final (corrected) values.
+ * Calling this for consecutive bands covering the frame corrects every
+ * defect exactly once.
+ */
+defect_status_t defect_map_apply_rows(defect_map_t *dm, uint16_t *frame,
+                                      uint32_t row_start, uint32_t row_count);
+
+/**
+ * @brief Correct all defects in a frame
+ *
+ * @param dm Defect map handle
+ * @param frame Frame data (width * height pixels)
+ * @return DEFECT_OK on success, error code on failure
+ */
+defect_status_t defect_map_apply_frame(defect_map_t *dm, uint16_t *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_DEFECT_MAP_H */
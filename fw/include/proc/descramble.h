@@ -0,0 +1,165 @@
+/**
+ * @file descramble.h
+ * @brief Panel readout descrambling
+ *
+ * Multi-ROIC and dual-side panels do not deliver pixels in image order:
+ * each ROIC drives a block of columns, blocks may arrive in any order and
+ * some are read right to left, and dual-side panels alternate lines from
+ * the top and bottom halves, the bottom half usually read from the far
+ * edge inward.
+ *
+ * The readout map from the "readout:" YAML section is compiled once at
+ * startup into a copy plan: per line class (top / bottom) a short list of
+ * block moves, with adjacent moves merged, plus a raw-line to image-row
+ * table. Forward moves are memcpy; reversed moves use a dispatched SIMD
+ * block-reverse kernel. Lines whose plan is a single forward full-width
+ * move and that land in consecutive image rows are copied together, so an
+ * identity map is a single memcpy of the frame.
+ *
+ * Descrambling is out of place and replaces the copy from the CSI-2
+ * capture buffer into the frame buffer, so it costs one read and one write
+ * of each pixel per frame.
+ */
+
+#ifndef DETECTOR_PROC_DESCRAMBLE_H
+#define DETECTOR_PROC_DESCRAMBLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DESCRAMBLE_MAX_BLOCKS   32      /**< ROIC blocks per line */
+
+/**
+ * @brief Descramble result codes
+ */
+typedef enum {
+    DESC_OK = 0,                /**< Success */
+    DESC_ERROR_NULL = -1,       /**< NULL pointer argument */
+    DESC_ERROR_PARAM = -2       /**< Row range outside the frame */
+} desc_status_t;
+
+/**
+ * @brief Readout map
+ *
+ * Raw line r carries image row r unless dual_side is set, in which case
+ * even raw lines carry the top half (rows 0, 1, ...) and odd raw lines the
+ * bottom half (rows height/2, ... or, with bottom_flipped, height-1, ...).
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint32_t block_cols;        /**< Columns per ROIC block (0 = one block per line) */
+    uint8_t block_count;        /**< Entries in block_order (0 = blocks in order) */
+    uint8_t block_order[DESCRAMBLE_MAX_BLOCKS]; /**< Image block of each raw block */
+    uint32_t mirrored_blocks;   /**< Bit b: raw block b is read right to left */
+    bool dual_side;             /**< Raw lines alternate top and bottom halves */
+    bool bottom_flipped;        /**< Bottom half read from the last row upwards */
+    bool bottom_mirrored;       /**< Bottom lines arrive with the whole line reversed */
+} desc_config_t;
+
+/**
+ * @brief Opaque compiled copy plan
+ */
+typedef struct descramble descramble_t;
+
+/**
+ * @brief Compile a readout map into a copy plan
+ *
+ * @param config Readout map
+ * @return Handle, or NULL if the map is inconsistent (block_cols does not
+ *         divide width, block_order not a permutation, odd height with
+ *         dual_side, ...) or allocation fails
+ */
+descramble_t *descramble_create(const desc_config_t *config);
+
+/**
+ * @brief Destroy a copy plan
+ *
+ * @param d Handle (NULL is ignored)
+ */
+void descramble_destroy(descramble_t *d);
+
+/**
+ * @brief Check whether the plan leaves pixels where they are
+ *
+ * @param d Handle
+ * @return true for an identity map (the plan is one memcpy)
+ */
+bool descramble_is_identity(const descramble_t *d);
+
+/**
+ * @brief Block moves per line
+ *
+ * @param d Handle
+ * @param bottom false for top (or all) lines, true for bottom-side lines
+ * @return Moves after merging, 0 if d is NULL
+ */
+uint32_t descramble_op_count(const descramble_t *d, bool bottom);
+
+/**
+ * @brief Image row that a raw line is written to
+ *
+ * @param d Handle
+ * @param raw_row Raw line number
+ * @return Image row, or UINT32_MAX if out of range
+ */
+uint32_t descramble_image_row(const descramble_t *d, uint32_t raw_row);
+
+/**
+ * @brief Descramble a range of raw lines
+ *
+ * Lets lines be placed as they arrive. Each raw line is written to its
+ * image row in dst; src and dst must not overlap.
+ *
+ * @param d Handle
+ * @param dst Image frame (width * height pixels)
+ * @param src Raw frame base pointer (width * height pixels)
+ * @param raw_start First raw line
+ * @param raw_count Raw lines
+ * @return DESC_OK on success, error code on failure
+ */
+desc_status_t descramble_apply_rows(const descramble_t *d, uint16_t *dst, const uint16_t *src,
+                                    uint32_t raw_start, uint32_t raw_count);
+
+/**
+ * @brief Descramble a whole frame
+ *
+ * @param d Handle
+ * @param dst Image frame (width * height pixels)
+ * @param src Raw frame (width * height pixels), must not overlap dst
+ * @return DESC_OK on success, error code on failure
+ */
+desc_status_t descramble_apply_frame(const descramble_t *d, uint16_t *dst, const uint16_t *src);
+
+/**
+ * @brief Get name of the block-reverse kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *descramble_get_kernel_name(void);
+
+/**
+ * @brief Block-reverse kernel: dst[i] = src[n - 1 - i], no overlap
+ *
+ * Signature of the descramble_kernel_reverse variants, which the
+ * orientation flips also use.
+ */
+typedef void (*desc_reverse_fn_t)(uint16_t *dst, const uint16_t *src, size_t n);
+
+/**
+ * @brief Block-reverse kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t descramble_kernel_reverse;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_DESCRAMBLE_H */
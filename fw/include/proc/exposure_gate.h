@@ -0,0 +1,185 @@
+/**
+ * @file exposure_gate.h
+ * @brief Exposure gate: detect frames without X-ray signal before sending
+ *
+ * In continuous and triggered scans many frames are taken before and
+ * after the exposure and carry only the dark level. The gate samples
+ * every row_step-th row of the outgoing frame and calls it empty when
+ *
+ *   mean <= dark_level + mean_margin  and  max <= dark_level + max_margin
+ *
+ * (the max test is skipped when max_margin is 0). The first hold_frames
+ * empty frames after a frame with signal still pass, so the tail of an
+ * exposure is never cut. Later empty frames get the configured action:
+ * - tag: sent whole, flagged ETH_FRAME_FLAG_NO_SIGNAL
+ * - decimate: binned decimate x decimate in place and sent flagged
+ * - drop: replaced by a header-only marker, so the host still sees every
+ *   frame number
+ *
+ * The sampled rows go through one sum/max kernel (NEON/AVX2/SSE4.2/scalar).
+ */
+
+#ifndef DETECTOR_PROC_EXPOSURE_GATE_H
+#define DETECTOR_PROC_EXPOSURE_GATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Exposure gate result codes
+ */
+typedef enum {
+    EGATE_OK = 0,               /**< Success */
+    EGATE_ERROR_NULL = -1,      /**< NULL pointer argument */
+    EGATE_ERROR_PARAM = -2      /**< Invalid step, factor, action or geometry */
+} egate_status_t;
+
+#define EGATE_DEFAULT_ROW_STEP      16
+#define EGATE_MAX_ROW_STEP          64
+#define EGATE_DEFAULT_MEAN_MARGIN   32      /* Counts above the dark level */
+#define EGATE_DEFAULT_DECIMATE      8
+#define EGATE_MAX_DECIMATE          16
+
+/**
+ * @brief What happens to empty frames
+ */
+typedef enum {
+    EGATE_ACTION_TAG = 0,       /**< Send whole, flagged */
+    EGATE_ACTION_DECIMATE,      /**< Send binned, flagged */
+    EGATE_ACTION_DROP           /**< Send a header-only marker */
+} egate_action_t;
+
+/**
+ * @brief Gate configuration
+ */
+typedef struct {
+    uint16_t dark_level;        /**< Mean of a frame without exposure in counts */
+    uint16_t mean_margin;       /**< Signal if the mean exceeds dark + margin (0 = default) */
+    uint16_t max_margin;        /**< Signal if the max exceeds dark + margin (0 = mean only) */
+    uint32_t row_step;          /**< Sample every Nth row (0 = default) */
+    uint32_t hold_frames;       /**< Empty frames still passed after signal */
+    egate_action_t action;      /**< Handling of empty frames */
+    uint32_t decimate;          /**< Bin factor for EGATE_ACTION_DECIMATE (0 = default) */
+} egate_config_t;
+
+/**
+ * @brief Decision for one frame
+ */
+typedef enum {
+    EGATE_VERDICT_PASS = 0,     /**< Signal or within hold: send unchanged */
+    EGATE_VERDICT_TAG,          /**< Empty: send whole, flagged */
+    EGATE_VERDICT_DECIMATE,     /**< Empty: exposure_gate_decimate(), then send flagged */
+    EGATE_VERDICT_DROP          /**< Empty: send a marker instead */
+} egate_verdict_t;
+
+/**
+ * @brief Result of one check
+ */
+typedef struct {
+    egate_verdict_t verdict;    /**< What to do with the frame */
+    bool signal;                /**< Frame itself carries signal */
+    uint16_t mean;              /**< Sampled mean in counts (rounded down) */
+    uint16_t max;               /**< Sampled maximum in counts */
+} egate_result_t;
+
+/**
+ * @brief Counters since create
+ */
+typedef struct {
+    uint64_t frames;            /**< Frames checked */
+    uint64_t signal;            /**< Frames with signal */
+    uint64_t held;              /**< Empty frames passed within hold_frames */
+    uint64_t tagged;            /**< Empty frames tagged */
+    uint64_t decimated;         /**< Empty frames decimated */
+    uint64_t dropped;           /**< Empty frames replaced by a marker */
+} egate_stats_t;
+
+/**
+ * @brief Opaque gate context
+ */
+typedef struct exposure_gate exposure_gate_t;
+
+/**
+ * @brief Create a gate
+ *
+ * @param config Configuration
+ * @return Handle, or NULL on invalid parameters or allocation failure
+ */
+exposure_gate_t *exposure_gate_create(const egate_config_t *config);
+
+/**
+ * @brief Free a gate
+ *
+ * @param gate Handle (NULL is ignored)
+ */
+void exposure_gate_destroy(exposure_gate_t *gate);
+
+/**
+ * @brief Check one frame and decide what to send
+ *
+ * @param gate Handle
+ * @param frame Frame data (width * height pixels)
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param result Output decision and sampled levels
+ * @return EGATE_OK on success, error code on failure
+ */
+egate_status_t exposure_gate_check(exposure_gate_t *gate, const uint16_t *frame,
+                                   uint32_t width, uint32_t height, egate_result_t *result);
+
+/**
+ * @brief Bin a frame in place by the configured factor
+ *
+ * Each output pixel is the rounded mean of a decimate x decimate block;
+ * rows and columns beyond the last whole block are dropped.
+ *
+ * @param gate Handle
+ * @param frame Frame data, overwritten from the start with the binned frame
+ * @param width Frame width in pixels, updated to the binned width
+ * @param height Frame height in pixels, updated to the binned height
+ * @return EGATE_OK on success, EGATE_ERROR_PARAM if the frame is smaller
+ *         than one block or the row accumulator cannot be allocated
+ */
+egate_status_t exposure_gate_decimate(exposure_gate_t *gate, uint16_t *frame,
+                                      uint32_t *width, uint32_t *height);
+
+/**
+ * @brief Forget the last signal frame at scan start
+ *
+ * @param gate Handle (NULL is ignored)
+ */
+void exposure_gate_reset(exposure_gate_t *gate);
+
+/**
+ * @brief Get counters
+ *
+ * @param gate Handle
+ * @param stats Output counters
+ * @return EGATE_OK on success, error code on failure
+ */
+egate_status_t exposure_gate_get_stats(const exposure_gate_t *gate, egate_stats_t *stats);
+
+/**
+ * @brief Get name of the row kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *exposure_gate_get_kernel_name(void);
+
+/**
+ * @brief Row sum/max kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t exposure_gate_kernel_row;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_EXPOSURE_GATE_H */
@@ -0,0 +1,178 @@
+/**
+ * @file frame_qa.h
+ * @brief Per-frame image quality metrics
+ *
+ * Cheap QA figures computed from every row_step-th row while the frame
+ * streams through the statistics stage, so detector health can be
+ * trended from clinical frames instead of offline phantom runs:
+ * - noise (spatial standard deviation) and SNR in up to FQA_MAX_ROIS
+ *   rectangular regions of interest
+ * - row and column banding: RMS of the row-mean and column-mean profiles
+ *   after removing their 3-tap local mean, so smooth gradients (heel
+ *   effect, gain roll-off) do not count and only line-to-line structure
+ *   remains
+ * - non-uniformity of the ROI means, (max - min) / (max + min)
+ *
+ * Every sampled row goes through one span kernel (NEON/AVX2/SSE4.2/scalar)
+ * that accumulates sum, sum of squares and the per-column sums in a single
+ * read. Each sampled row is read once whatever the ROI layout.
+ */
+
+#ifndef DETECTOR_PROC_FRAME_QA_H
+#define DETECTOR_PROC_FRAME_QA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Frame QA result codes
+ */
+typedef enum {
+    FQA_OK = 0,                 /**< Success */
+    FQA_ERROR_NULL = -1,        /**< NULL pointer argument */
+    FQA_ERROR_PARAM = -2        /**< Invalid geometry, step, ROI or band */
+} fqa_status_t;
+
+#define FQA_MAX_ROIS            5
+#define FQA_DEFAULT_ROW_STEP    4
+#define FQA_MAX_ROW_STEP        64
+
+/**
+ * @brief Rectangular region of interest
+ */
+typedef struct {
+    uint32_t x;                 /**< Left column */
+    uint32_t y;                 /**< Top row */
+    uint32_t width;             /**< Columns */
+    uint32_t height;            /**< Rows */
+} fqa_roi_t;
+
+/**
+ * @brief QA configuration
+ *
+ * With roi_count 0 the five-point layout is used: squares of a tenth of
+ * the shorter panel side at the centre and at the centres of the four
+ * quadrants.
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint32_t row_step;          /**< Sample every Nth row (0 = default) */
+    uint32_t roi_count;         /**< Entries in rois (0 = five-point layout) */
+    fqa_roi_t rois[FQA_MAX_ROIS]; /**< Regions of interest */
+} fqa_config_t;
+
+/**
+ * @brief Metrics of one ROI
+ */
+typedef struct {
+    float mean;                 /**< Mean in counts */
+    float noise;                /**< Standard deviation in counts */
+    float snr;                  /**< mean / noise (0 if noise is 0) */
+} fqa_roi_result_t;
+
+/**
+ * @brief Metrics of one frame
+ */
+typedef struct {
+    fqa_roi_result_t roi[FQA_MAX_ROIS]; /**< Per-ROI metrics */
+    uint32_t roi_count;         /**< Valid entries in roi */
+    float mean;                 /**< Mean of the sampled rows */
+    float noise;                /**< Mean ROI noise */
+    float snr;                  /**< Mean ROI mean / noise */
+    float row_banding;          /**< Row profile RMS residual in counts */
+    float col_banding;          /**< Column profile RMS residual in counts */
+    float nonuniformity;        /**< (max - min) / (max + min) of the ROI means */
+} fqa_result_t;
+
+/**
+ * @brief Opaque QA accumulator
+ */
+typedef struct frame_qa frame_qa_t;
+
+/**
+ * @brief Create a QA accumulator
+ *
+ * @param config Configuration (ROIs must lie inside the frame)
+ * @return Handle, or NULL on invalid parameters or allocation failure
+ */
+frame_qa_t *frame_qa_create(const fqa_config_t *config);
+
+/**
+ * @brief Free a QA accumulator
+ *
+ * @param qa Handle (NULL is ignored)
+ */
+void frame_qa_destroy(frame_qa_t *qa);
+
+/**
+ * @brief Compute the metrics of one frame
+ *
+ * @param qa Handle
+ * @param frame Frame data (width * height pixels)
+ * @param result Output metrics
+ * @return FQA_OK on success, error code on failure
+ */
+fqa_status_t frame_qa_compute(frame_qa_t *qa, const uint16_t *frame, fqa_result_t *result);
+
+/**
+ * @brief Start band-wise metrics of a frame
+ *
+ * Band-wise results equal frame_qa_compute() once every row was added.
+ * One frame at a time per handle.
+ *
+ * @param qa Handle
+ * @return FQA_OK on success, error code on failure
+ */
+fqa_status_t frame_qa_begin(frame_qa_t *qa);
+
+/**
+ * @brief Add the sampled rows of a band
+ *
+ * Bands may arrive in any order but each row must be added at most once.
+ *
+ * @param qa Handle
+ * @param frame Frame base pointer (width * height pixels)
+ * @param row_start First row of the band
+ * @param row_count Rows in the band
+ * @return FQA_OK on success, FQA_ERROR_PARAM if the band exceeds the frame
+ */
+fqa_status_t frame_qa_accumulate_rows(frame_qa_t *qa, const uint16_t *frame,
+                                      uint32_t row_start, uint32_t row_count);
+
+/**
+ * @brief Finish band-wise metrics
+ *
+ * Banding needs the whole profile: if some sampled rows were never added
+ * both banding figures are 0.
+ *
+ * @param qa Handle
+ * @param result Output metrics
+ * @return FQA_OK on success, error code on failure
+ */
+fqa_status_t frame_qa_finish(frame_qa_t *qa, fqa_result_t *result);
+
+/**
+ * @brief Get name of the span kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *frame_qa_get_kernel_name(void);
+
+/**
+ * @brief Span kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t frame_qa_kernel_span;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_FRAME_QA_H */
@@ -0,0 +1,159 @@
+/**
+ * @file hdr_fusion.h
+ * @brief Dual-gain HDR fusion of alternating low/high-gain frames
+ *
+ * With seq_set_hdr() enabled the sequence engine alternates FPGA_REG_GAIN
+ * frame by frame: even CSI-2 sequence numbers are exposed at the low gain,
+ * odd ones at the high gain. Each pair (2k, 2k+1) is merged into one
+ * extended-range frame in high-gain units, so only half the frames (and
+ * half the bandwidth) leave the detector:
+ *
+ *   w   = 0 below threshold - blend, rising linearly to 1 at threshold
+ *         (a hard switch at threshold when blend is 0), taken from the
+ *         high-gain sample
+ *   out = ((1 - w) * high + w * low * high_gain / low_gain) >> output_shift
+ *
+ * The low-gain frame is held (copied) until its partner arrives. Pairing
+ * follows the frame numbers only: a low-gain frame replaced before its
+ * partner arrived, or a high-gain frame whose partner was dropped, is
+ * counted and discarded, never fused with the wrong frame.
+ *
+ * The fusion runs in one pass over both frames, 32-bit fixed point, in a
+ * NEON/AVX2/SSE4.2/scalar kernel.
+ */
+
+#ifndef DETECTOR_PROC_HDR_FUSION_H
+#define DETECTOR_PROC_HDR_FUSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief HDR fusion result codes
+ */
+typedef enum {
+    HDR_OK = 0,                 /**< Success */
+    HDR_ERROR_NULL = -1,        /**< NULL pointer argument */
+    HDR_ERROR_PARAM = -2        /**< Invalid geometry or gains */
+} hdr_status_t;
+
+#define HDR_MAX_RATIO           64      /* high_gain / low_gain */
+#define HDR_MAX_OUTPUT_SHIFT    8
+#define HDR_DEFAULT_THRESHOLD   14745   /* 90% of 14-bit full scale */
+
+/**
+ * @brief Fusion configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint16_t low_gain;          /**< FPGA_REG_GAIN of even frames */
+    uint16_t high_gain;         /**< FPGA_REG_GAIN of odd frames (> low_gain) */
+    uint16_t threshold;         /**< High-gain count from which only low gain is used (0 = default) */
+    uint16_t blend;             /**< Cross-fade width below threshold (0 = hard selection) */
+    uint8_t output_shift;       /**< Right shift of the fused high-gain-unit value */
+} hdr_config_t;
+
+/**
+ * @brief Outcome of one submitted frame
+ */
+typedef enum {
+    HDR_PAIR_HELD = 0,          /**< Low-gain frame stored; release the buffer */
+    HDR_PAIR_FUSED,             /**< Frame now holds the fused pair; pass it on */
+    HDR_PAIR_DROPPED            /**< High-gain frame without its partner; drop it */
+} hdr_pair_t;
+
+/**
+ * @brief Pairing counters since create
+ */
+typedef struct {
+    uint64_t fused;             /**< Pairs merged */
+    uint64_t dropped_low;       /**< Low-gain frames whose partner never arrived */
+    uint64_t dropped_high;      /**< High-gain frames without their partner */
+} hdr_stats_t;
+
+/**
+ * @brief Opaque fusion context
+ */
+typedef struct hdr_fusion hdr_fusion_t;
+
+/**
+ * @brief Create a fusion context (allocates one frame for the held low-gain frame)
+ *
+ * @param config Configuration
+ * @return Handle, or NULL on invalid parameters or allocation failure
+ */
+hdr_fusion_t *hdr_fusion_create(const hdr_config_t *config);
+
+/**
+ * @brief Free a fusion context
+ *
+ * @param hdr Handle (NULL is ignored)
+ */
+void hdr_fusion_destroy(hdr_fusion_t *hdr);
+
+/**
+ * @brief Submit the next frame of the alternating stream
+ *
+ * Even frame numbers are held, odd ones are fused in place with the held
+ * frame if it is their partner (frame_number - 1).
+ *
+ * @param hdr Handle
+ * @param frame Frame data (width * height pixels), overwritten when fused
+ * @param frame_number CSI-2 sequence number of the frame
+ * @param pair Outcome
+ * @return HDR_OK on success, error code on failure
+ */
+hdr_status_t hdr_fusion_submit(hdr_fusion_t *hdr, uint16_t *frame, uint32_t frame_number,
+                               hdr_pair_t *pair);
+
+/**
+ * @brief Fuse one pair directly
+ *
+ * @param hdr Handle
+ * @param high High-gain frame, overwritten with the fused frame
+ * @param low Low-gain frame
+ * @return HDR_OK on success, error code on failure
+ */
+hdr_status_t hdr_fusion_fuse(const hdr_fusion_t *hdr, uint16_t *high, const uint16_t *low);
+
+/**
+ * @brief Forget the held frame at scan end (counters keep running)
+ *
+ * @param hdr Handle (NULL is ignored)
+ */
+void hdr_fusion_reset(hdr_fusion_t *hdr);
+
+/**
+ * @brief Get pairing counters
+ *
+ * @param hdr Handle
+ * @param stats Output counters
+ * @return HDR_OK on success, error code on failure
+ */
+hdr_status_t hdr_fusion_get_stats(const hdr_fusion_t *hdr, hdr_stats_t *stats);
+
+/**
+ * @brief Get name of the fusion kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *hdr_fusion_get_kernel_name(void);
+
+/**
+ * @brief Fusion kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t hdr_fusion_kernel_fuse;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_HDR_FUSION_H */
@@ -0,0 +1,165 @@
+/**
+ * @file orientation.h
+ * @brief Frame orientation transforms (flip, rotate, transpose)
+ *
+ * Panels are mounted in different orientations per room; the transform
+ * from panel.orientation is applied on the device so the host receives
+ * upright images.
+ *
+ * Axis-swapping transforms (rot90, rot270, transpose, transverse) work on
+ * 8x8 pixel tiles with a SIMD tile-transpose kernel. Tiles are visited in
+ * 64x64 pixel blocks so the source and destination lines of a block stay
+ * in L1 while it is moved. Square frames whose side is a multiple of 8 are
+ * transformed in place by following tile cycles (one pass over the frame);
+ * other sizes go through a scratch frame and are copied back. Flips and
+ * rot180 are always in place, one row pair at a time.
+ */
+
+#ifndef DETECTOR_PROC_ORIENTATION_H
+#define DETECTOR_PROC_ORIENTATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Orientation result codes
+ */
+typedef enum {
+    ORIENT_OK = 0,              /**< Success */
+    ORIENT_ERROR_NULL = -1,     /**< NULL pointer argument */
+    ORIENT_ERROR_PARAM = -2     /**< Invalid transform or geometry */
+} orient_status_t;
+
+/**
+ * @brief Transform from panel to image coordinates
+ *
+ * Values match detector_config_t.orientation.
+ */
+typedef enum {
+    ORIENT_NONE = 0,            /**< Unchanged */
+    ORIENT_FLIP_H,              /**< Mirror left-right */
+    ORIENT_FLIP_V,              /**< Mirror top-bottom */
+    ORIENT_ROT90,               /**< Rotate 90 degrees clockwise */
+    ORIENT_ROT180,              /**< Rotate 180 degrees */
+    ORIENT_ROT270,              /**< Rotate 90 degrees counter-clockwise */
+    ORIENT_TRANSPOSE,           /**< Mirror about the main diagonal */
+    ORIENT_TRANSVERSE,          /**< Mirror about the anti-diagonal */
+    ORIENT_COUNT
+} orient_t;
+
+/**
+ * @brief Orientation stage configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Input width in pixels */
+    uint32_t height;            /**< Input height in pixels */
+    orient_t transform;         /**< Transform to apply */
+} orient_config_t;
+
+/**
+ * @brief Opaque orientation handle
+ */
+typedef struct orientation orientation_t;
+
+/**
+ * @brief Name of a transform ("none", "flip_h", "rot90", ...)
+ *
+ * @return Name, or "unknown"
+ */
+const char *orientation_name(orient_t transform);
+
+/**
+ * @brief Check whether a transform exchanges width and height
+ */
+bool orientation_swaps_axes(orient_t transform);
+
+/**
+ * @brief Create an orientation stage
+ *
+ * Allocates a scratch frame only for axis-swapping transforms that cannot
+ * run in place.
+ *
+ * @param config Geometry and transform
+ * @return Handle, or NULL on invalid configuration / allocation failure
+ */
+orientation_t *orientation_create(const orient_config_t *config);
+
+/**
+ * @brief Destroy an orientation stage
+ *
+ * @param o Handle (NULL is ignored)
+ */
+void orientation_destroy(orientation_t *o);
+
+/**
+ * @brief Output geometry
+ *
+ * @param o Handle
+ * @param width Output width (may be NULL)
+ * @param height Output height (may be NULL)
+ */
+void orientation_get_output_size(const orientation_t *o, uint32_t *width, uint32_t *height);
+
+/**
+ * @brief Check whether the transform runs without the scratch frame
+ */
+bool orientation_in_place(const orientation_t *o);
+
+/**
+ * @brief Transform a frame in place
+ *
+ * Not reentrant per handle (shared scratch and row buffers).
+ *
+ * @param o Handle
+ * @param frame Frame data (width * height pixels), output geometry from
+ *              orientation_get_output_size()
+ * @return ORIENT_OK on success, error code on failure
+ */
+orient_status_t orientation_apply_frame(orientation_t *o, uint16_t *frame);
+
+/**
+ * @brief Transform out of place, cache-blocked
+ *
+ * @param transform Transform
+ * @param dst Output (width * height pixels), must not overlap src
+ * @param src Input, width x height
+ * @param width Input width
+ * @param height Input height
+ * @return ORIENT_OK on success, error code on failure
+ */
+orient_status_t orientation_transform(orient_t transform, uint16_t *dst, const uint16_t *src,
+                                      uint32_t width, uint32_t height);
+
+/**
+ * @brief Pixel-by-pixel reference transform (tests and benchmarks)
+ *
+ * Same contract as orientation_transform().
+ */
+orient_status_t orientation_transform_naive(orient_t transform, uint16_t *dst,
+                                            const uint16_t *src, uint32_t width,
+                                            uint32_t height);
+
+/**
+ * @brief Get name of the tile-transpose kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *orientation_get_kernel_name(void);
+
+/**
+ * @brief Tile-transpose kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t orientation_kernel_tile;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_ORIENTATION_H */
@@ -0,0 +1,315 @@
+/**
+ * @file pipeline.h
+ * @brief Configurable frame processing pipeline
+ *
+ * Processing stages (correction, defect fix, stats, packetize, ...) are
+ * registered by name with a pipe_registry_t. A pipeline is then built
+ * from an ordered list of stage names, typically the chain configured
+ * for the current scan mode in detector_config.yaml:
+ *
+ *   pipeline:
+ *     continuous: [correction, defects, saturation, temporal, stats, packetize]
+ *
+ * Every stage runs on its own thread; adjacent stages are connected by
+ * bounded lock-free SPSC queues that carry frame descriptors, so stage
+ * N can work on frame k+1 while stage N+1 handles frame k. Descriptors
+ * come from a fixed pool sized to the queues, so nothing is allocated
+ * per frame. When a frame leaves the last stage (or a stage consumes or
+ * rejects it) the release callback hands the buffer back.
+ *
+ * Each stage records frames, errors, per-frame latency (last / average
+ * / max) and throughput; the pipeline records end-to-end latency and
+ * drops. Rebuilding for another scan mode is pipeline_destroy(), which
+ * drains in-flight frames, followed by pipeline_create().
+ *
+ * Stages that can work on a band of rows also register band operations.
+ * In PIPE_EXEC_FUSED mode consecutive band stages are merged into one
+ * stage thread that walks the frame in bands of band_rows and runs every
+ * merged stage on a band before moving to the next one. A band small
+ * enough to stay in L2 then crosses the DRAM bus once for the whole
+ * group instead of once per stage.
+ */
+
+#ifndef DETECTOR_PROC_PIPELINE_H
+#define DETECTOR_PROC_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pipeline result codes
+ */
+typedef enum {
+    PIPE_OK = 0,                /**< Success */
+    PIPE_ERROR_NULL = -1,       /**< NULL pointer argument */
+    PIPE_ERROR_PARAM = -2,      /**< Invalid parameter or unknown stage */
+    PIPE_ERROR_MEMORY = -3,     /**< Allocation failed */
+    PIPE_ERROR_FULL = -4,       /**< Registry or pipeline input full */
+    PIPE_ERROR_EXISTS = -5,     /**< Stage name already registered */
+    PIPE_ERROR_THREAD = -6      /**< Stage thread creation failed */
+} pipe_status_t;
+
+#define PIPE_MAX_STAGE_TYPES    16      /* Registered stage types */
+#define PIPE_MAX_STAGES         8       /* Stages in one pipeline */
+#define PIPE_STAGE_NAME_LEN     16      /* Including terminator */
+#define PIPE_DEFAULT_QUEUE_DEPTH 4      /* Frames between two stages */
+#define PIPE_STATS_NAME_LEN     64      /* Fused group name "a+b+c" */
+
+/* Default fused band: 32 rows x 2048 px x 2 B = 128 KiB of pixels, which
+ * leaves room in the A53's 512 KiB L2 for the per-pixel maps and history
+ * the stages stream alongside */
+#define PIPE_DEFAULT_BAND_ROWS  32
+
+/**
+ * @brief Stage return values (negative values are errors)
+ */
+#define PIPE_CONTINUE           0       /* Pass the frame to the next stage */
+#define PIPE_CONSUMED           1       /* Frame fully handled, release it */
+
+/**
+ * @brief Frame descriptor passed along the pipeline
+ */
+typedef struct {
+    uint16_t *data;             /**< Pixel data (processed in place) */
+    size_t size;                /**< Buffer size in bytes */
+    uint32_t frame_number;      /**< Frame number from the frame manager */
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint32_t flags;             /**< Stage-to-stage signals (owner defined) */
+    int status;                 /**< Last stage result (negative = rejected) */
+    uint64_t submit_ns;         /**< CLOCK_MONOTONIC at submit */
+    void *meta;                 /**< Per-frame metadata (owner defined, NULL if meta_size is 0) */
+} pipe_frame_t;
+
+/**
+ * @brief Stage function
+ *
+ * @param frame Frame to process
+ * @param user_data Registered with the stage
+ * @return PIPE_CONTINUE, PIPE_CONSUMED or a negative error (frame released)
+ */
+typedef int (*pipe_stage_fn_t)(pipe_frame_t *frame, void *user_data);
+
+/**
+ * @brief Band operations of a stage that can process a frame in row bands
+ *
+ * For each frame: begin once, rows for consecutive bands covering the
+ * frame top to bottom, then end once. In a fused group every member sees
+ * every row; the group result is the first end() result that is not
+ * PIPE_CONTINUE.
+ *
+ * lag_rows is how far above the end of the last band rows() may still
+ * write or read, e.g. a filter that reads 8 rows either side and fixes a
+ * row only once its lower neighbours are in. Later members of a fused
+ * group are run that many rows behind, so they see the same rows staged
+ * execution would hand them.
+ */
+typedef struct {
+    void (*begin)(pipe_frame_t *frame, void *user_data);    /**< Optional */
+    void (*rows)(pipe_frame_t *frame, uint32_t row_start,
+                 uint32_t row_count, void *user_data);      /**< Required */
+    int (*end)(pipe_frame_t *frame, void *user_data);       /**< Optional, PIPE_CONTINUE if NULL */
+    uint32_t lag_rows;                                      /**< Rows not yet final after rows() */
+} pipe_band_ops_t;
+
+/**
+ * @brief Pipeline execution mode
+ */
+typedef enum {
+    PIPE_EXEC_STAGED = 0,       /**< One thread per stage, whole frame per stage */
+    PIPE_EXEC_FUSED             /**< Consecutive band stages share a thread, band by band */
+} pipe_exec_t;
+
+/**
+ * @brief Called once per frame after it leaves the pipeline
+ *
+ * Runs on the thread of the last stage that handled the frame.
+ */
+typedef void (*pipe_release_fn_t)(const pipe_frame_t *frame, void *user_data);
+
+/**
+ * @brief Opaque stage registry
+ */
+typedef struct pipe_registry pipe_registry_t;
+
+/**
+ * @brief Opaque pipeline handle
+ */
+typedef struct pipeline pipeline_t;
+
+/**
+ * @brief Pipeline configuration
+ */
+typedef struct {
+    const pipe_registry_t *registry;    /**< Stage types */
+    const char *const *stages;          /**< Stage names in order */
+    uint32_t stage_count;               /**< 1..PIPE_MAX_STAGES */
+    uint32_t queue_depth;               /**< Frames per queue (0 = default) */
+    int priority;                       /**< Stage thread SCHED_FIFO priority (0 = inherit) */
+    pipe_exec_t exec;                   /**< Staged or fused band execution */
+    uint32_t band_rows;                 /**< Rows per band (0 = default) */
+    pipe_release_fn_t release;          /**< Frame release callback */
+    void *release_data;                 /**< Passed to release */
+    size_t meta_size;                   /**< Bytes of frame->meta per frame (0 = none) */
+} pipe_config_t;
+
+/**
+ * @brief Per-stage metrics
+ */
+typedef struct {
+    char name[PIPE_STATS_NAME_LEN];     /**< Stage name, "a+b" for a fused group */
+    uint64_t frames;                    /**< Frames processed */
+    uint64_t errors;                    /**< Frames rejected by this stage */
+    uint64_t consumed;                  /**< Frames ended here with PIPE_CONSUMED */
+    uint32_t last_us;                   /**< Last frame processing time */
+    uint32_t avg_us;                    /**< Mean processing time */
+    uint32_t max_us;                    /**< Worst processing time */
+    uint32_t queue_depth;               /**< Frames waiting in front of the stage */
+    uint32_t queue_max;                 /**< Highest queue depth seen */
+    float fps;                          /**< Frames per second since build */
+    float busy;                         /**< Fraction of wall time spent processing */
+} pipe_stage_stats_t;
+
+/**
+ * @brief Pipeline metrics
+ */
+typedef struct {
+    uint32_t stages;                    /**< Stage count */
+    uint64_t submitted;                 /**< Frames accepted */
+    uint64_t dropped;                   /**< Frames refused at submit (pipeline full) */
+    uint64_t completed;                 /**< Frames released */
+    uint32_t in_flight;                 /**< Frames inside the pipeline */
+    uint32_t last_latency_us;           /**< Submit to release, last frame */
+    uint32_t max_latency_us;            /**< Submit to release, worst frame */
+} pipe_stats_t;
+
+/* ==========================================================================
+ * Stage Registry
+ * ========================================================================== */
+
+/**
+ * @brief Create an empty stage registry
+ *
+ * @return Handle, or NULL on allocation failure
+ */
+pipe_registry_t *pipeline_registry_create(void);
+
+/**
+ * @brief Destroy a stage registry (pipelines built from it must be gone)
+ *
+ * @param reg Handle (NULL is ignored)
+ */
+void pipeline_registry_destroy(pipe_registry_t *reg);
+
+/**
+ * @brief Register a stage type
+ *
+ * @param reg Registry
+ * @param name Stage name (1..PIPE_STAGE_NAME_LEN-1 characters)
+ * @param fn Stage function
+ * @param user_data Passed to fn
+ * @return PIPE_OK, PIPE_ERROR_EXISTS, PIPE_ERROR_FULL or PIPE_ERROR_PARAM
+ */
+pipe_status_t pipeline_register_stage(pipe_registry_t *reg, const char *name,
+                                      pipe_stage_fn_t fn, void *user_data);
+
+/**
+ * @brief Check whether a stage name is registered
+ *
+ * @param reg Registry
+ * @param name Stage name
+ * @return true if registered
+ */
+bool pipeline_registry_has(const pipe_registry_t *reg, const char *name);
+
+/**
+ * @brief Register a stage type that can also run band by band
+ *
+ * Staged execution calls fn with the whole frame, or runs the band
+ * operations over the frame when fn is NULL. Fused execution always
+ * uses the band operations.
+ *
+ * @param reg Registry
+ * @param name Stage name (1..PIPE_STAGE_NAME_LEN-1 characters)
+ * @param fn Whole-frame function (may be NULL)
+ * @param ops Band operations (copied; rows required)
+ * @param user_data Passed to fn and the band operations
+ * @return PIPE_OK, PIPE_ERROR_EXISTS, PIPE_ERROR_FULL or PIPE_ERROR_PARAM
+ */
+pipe_status_t pipeline_register_band_stage(pipe_registry_t *reg, const char *name,
+                                           pipe_stage_fn_t fn, const pipe_band_ops_t *ops,
+                                           void *user_data);
+
+/* ==========================================================================
+ * Pipeline
+ * ========================================================================== */
+
+/**
+ * @brief Build a pipeline and start its stage threads
+ *
+ * In PIPE_EXEC_FUSED mode every run of consecutive band stages becomes
+ * one pipeline stage, so stage indices refer to the merged stages.
+ *
+ * @param config Pipeline configuration
+ * @return Handle, or NULL on unknown stage, invalid config or failure
+ */
+pipeline_t *pipeline_create(const pipe_config_t *config);
+
+/**
+ * @brief Drain in-flight frames, stop stage threads and free the pipeline
+ *
+ * @param pipe Handle (NULL is ignored)
+ */
+void pipeline_destroy(pipeline_t *pipe);
+
+/**
+ * @brief Feed a frame into the first stage (single producer thread)
+ *
+ * The descriptor is copied; submit_ns, flags and status are set here,
+ * and meta points at zeroed storage owned by the pipeline until release.
+ *
+ * @param pipe Handle
+ * @param frame Frame descriptor
+ * @return PIPE_OK, or PIPE_ERROR_FULL if the pipeline cannot take it now
+ *         (the caller still owns the buffer)
+ */
+pipe_status_t pipeline_submit(pipeline_t *pipe, const pipe_frame_t *frame);
+
+/**
+ * @brief Wait until every submitted frame has been released
+ *
+ * @param pipe Handle
+ * @param timeout_ms Maximum wait
+ * @return true if the pipeline is empty, false on timeout
+ */
+bool pipeline_drain(pipeline_t *pipe, uint32_t timeout_ms);
+
+/**
+ * @brief Get pipeline metrics
+ *
+ * @param pipe Handle
+ * @param stats Output metrics
+ */
+void pipeline_get_stats(const pipeline_t *pipe, pipe_stats_t *stats);
+
+/**
+ * @brief Get metrics of one stage
+ *
+ * @param pipe Handle
+ * @param index Stage index (0 = first)
+ * @param stats Output metrics
+ * @return PIPE_OK, or PIPE_ERROR_PARAM if index is out of range
+ */
+pipe_status_t pipeline_get_stage_stats(const pipeline_t *pipe, uint32_t index,
+                                       pipe_stage_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_PIPELINE_H */
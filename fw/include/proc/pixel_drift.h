@@ -0,0 +1,192 @@
+/**
+ * @file pixel_drift.h
+ * @brief Per-pixel dark statistics for defect drift tracking
+ *
+ * Keeps a running mean and variance of every pixel over dark or idle
+ * frames and flags pixels whose offset moved away from the baseline, or
+ * whose noise exceeds a limit, as candidate defects for the host to
+ * review (and, if it agrees, send back as a CMD_CONFIG_DEFECT_MAP).
+ *
+ * Statistics are Welford's update in fixed point (mean Q4, variance Q8
+ * in 32-bit lanes), with the 1/n weight rounded down to a power of two:
+ * the first two samples are exact, and once n reaches 2^weight_shift the
+ * update becomes an exponentially weighted mean and variance with that
+ * memory, so slow drift keeps showing up instead of being averaged away.
+ * The baseline is each pixel's mean at that point.
+ *
+ * The frame is split into fixed blocks of pixels_per_frame pixels and
+ * each submitted frame feeds one block, so a full sweep takes
+ * ceil(pixels / pixels_per_frame) frames. With a background worker the
+ * caller only copies the block into a free staging slot; if the worker
+ * is still busy with earlier blocks the frame is skipped, so submitting
+ * never waits. The worker runs at SCHED_IDLE.
+ *
+ * State is 11 bytes per pixel (about 100 MiB for a 3072x3072 panel).
+ */
+
+#ifndef DETECTOR_PROC_PIXEL_DRIFT_H
+#define DETECTOR_PROC_PIXEL_DRIFT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Drift tracker result codes
+ */
+typedef enum {
+    DRIFT_OK = 0,               /**< Success */
+    DRIFT_ERROR_NULL = -1,      /**< NULL pointer argument */
+    DRIFT_ERROR_PARAM = -2,     /**< Invalid parameter */
+    DRIFT_BUSY = -3             /**< Worker busy, frame skipped */
+} drift_status_t;
+
+/* Defaults */
+#define DRIFT_DEFAULT_PIXELS_PER_FRAME  262144U /**< 0.5 ms of copying per frame */
+#define DRIFT_DEFAULT_WEIGHT_SHIFT      6       /**< 64-frame memory */
+#define DRIFT_DEFAULT_OFFSET_THRESHOLD  200     /**< Counts from the baseline */
+#define DRIFT_DEFAULT_NOISE_THRESHOLD   50      /**< Counts RMS */
+
+/* Limits */
+#define DRIFT_MAX_WEIGHT_SHIFT          12
+#define DRIFT_MAX_NOISE_THRESHOLD       2047    /**< Deviations clamp at 2047 counts */
+#define DRIFT_STAGING_SLOTS             2       /**< Blocks in flight to the worker */
+
+/* Candidate flags */
+#define DRIFT_FLAG_OFFSET       (1U << 0)   /**< Mean left the baseline */
+#define DRIFT_FLAG_NOISE        (1U << 1)   /**< Noise above threshold */
+
+/**
+ * @brief Drift tracker configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint32_t pixels_per_frame;  /**< Block size (0 = default) */
+    uint8_t weight_shift;       /**< Statistics memory 2^n frames (0 = default) */
+    uint16_t offset_threshold;  /**< Flag |mean - baseline| above this (0 = default) */
+    uint16_t noise_threshold;   /**< Flag RMS noise above this (0 = default) */
+    uint16_t dark_level;        /**< Skip blocks with a mean above this (0 = accept all) */
+    bool background;            /**< Update on a SCHED_IDLE worker thread */
+} drift_config_t;
+
+/**
+ * @brief Candidate defect (12 bytes, command channel wire format)
+ */
+typedef struct {
+    uint16_t x;                 /**< Column */
+    uint16_t y;                 /**< Row */
+    uint16_t mean;              /**< Current mean (counts) */
+    uint16_t baseline;          /**< Mean when the baseline was taken */
+    uint16_t noise;             /**< Current RMS noise (counts) */
+    uint8_t flags;              /**< DRIFT_FLAG_* */
+    uint8_t reserved;
+} __attribute__((packed)) drift_candidate_t;
+
+/**
+ * @brief Drift tracker statistics
+ */
+typedef struct {
+    uint64_t submitted;         /**< Frames passed to pixel_drift_submit() */
+    uint64_t processed;         /**< Blocks folded into the statistics */
+    uint64_t skipped_busy;      /**< Frames skipped: worker busy */
+    uint64_t skipped_bright;    /**< Blocks skipped: mean above dark_level */
+    uint32_t sweeps;            /**< Complete passes over every block */
+    uint32_t blocks;            /**< Blocks per frame */
+    uint32_t candidates;        /**< Pixels currently flagged */
+} drift_stats_t;
+
+/**
+ * @brief Opaque drift tracker
+ */
+typedef struct pixel_drift pixel_drift_t;
+
+/**
+ * @brief Create a tracker (and its worker if config->background)
+ *
+ * @param config Configuration
+ * @return Handle, or NULL on invalid parameters or allocation failure
+ */
+pixel_drift_t *pixel_drift_create(const drift_config_t *config);
+
+/**
+ * @brief Stop the worker and free the tracker
+ *
+ * @param drift Handle (NULL is ignored)
+ */
+void pixel_drift_destroy(pixel_drift_t *drift);
+
+/**
+ * @brief Feed the next block of a dark frame
+ *
+ * Without a worker the block is folded in before returning. With one,
+ * the block is copied and queued; DRIFT_BUSY means every staging slot
+ * was still in use and the frame was skipped. Call from one thread.
+ *
+ * @param drift Handle
+ * @param frame Full frame (width * height pixels)
+ * @return DRIFT_OK, DRIFT_BUSY, or an error code
+ */
+drift_status_t pixel_drift_submit(pixel_drift_t *drift, const uint16_t *frame);
+
+/**
+ * @brief Wait until the worker has processed every queued block
+ *
+ * @param drift Handle
+ */
+void pixel_drift_flush(pixel_drift_t *drift);
+
+/**
+ * @brief Forget statistics and baselines (e.g. after recalibration)
+ *
+ * Queued blocks are processed first.
+ *
+ * @param drift Handle
+ */
+void pixel_drift_reset(pixel_drift_t *drift);
+
+/**
+ * @brief Copy candidate defects in pixel order
+ *
+ * @param drift Handle
+ * @param start First pixel index (row * width + column) to scan
+ * @param out Output records
+ * @param max Capacity of out
+ * @param next Index to pass as start for the following page; width *
+ *             height once the list is exhausted (may be NULL)
+ * @return Records written
+ */
+size_t pixel_drift_get_candidates(pixel_drift_t *drift, uint32_t start,
+                                  drift_candidate_t *out, size_t max, uint32_t *next);
+
+/**
+ * @brief Get statistics
+ *
+ * @param drift Handle
+ * @param stats Output statistics
+ */
+void pixel_drift_get_stats(pixel_drift_t *drift, drift_stats_t *stats);
+
+/**
+ * @brief Get name of the update kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *pixel_drift_get_kernel_name(void);
+
+/**
+ * @brief Welford update kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t pixel_drift_kernel_update;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_PIXEL_DRIFT_H */
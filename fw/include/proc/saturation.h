@@ -0,0 +1,202 @@
+/**
+ * @file saturation.h
+ * @brief Per-tile saturation counter for overexposure protection
+ *
+ * Counts pixels at or above the overexposure threshold in square tiles
+ * while a frame is processed band by band, so the count rides along with
+ * the correction pass instead of re-reading the frame from DRAM.
+ *
+ * A tile is marked once its saturated fraction reaches tile_fraction; the
+ * frame trips when trip_tiles tiles are marked. The trip is visible as
+ * soon as the band that causes it has been counted, which lets the daemon
+ * back off or stop exposure before the frame has finished processing.
+ *
+ * Not thread-safe: begin/count/end for one frame must run on one thread.
+ */
+
+#ifndef DETECTOR_PROC_SATURATION_H
+#define DETECTOR_PROC_SATURATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Saturation counter result codes
+ */
+typedef enum {
+    SAT_OK = 0,                 /**< Success */
+    SAT_ERROR_NULL = -1,        /**< NULL pointer argument */
+    SAT_ERROR_PARAM = -2        /**< Invalid geometry or row range */
+} sat_status_t;
+
+/* Defaults (detector_config.yaml protection.overexposure_threshold) */
+#define SAT_DEFAULT_THRESHOLD       60000
+#define SAT_DEFAULT_TILE_SIZE       128
+#define SAT_DEFAULT_TILE_FRACTION   0.05f
+#define SAT_DEFAULT_TRIP_TILES      1
+
+/* Tile edge bound: keeps 16-bit SIMD lane counters from overflowing */
+#define SAT_MAX_TILE_SIZE           4096
+
+/**
+ * @brief Saturation counter configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    uint16_t threshold;         /**< Saturated if pixel >= threshold (0 = default) */
+    uint32_t tile_size;         /**< Square tile edge in pixels (0 = default) */
+    float tile_fraction;        /**< Saturated fraction that marks a tile (0 = default) */
+    uint32_t trip_tiles;        /**< Marked tiles that trip the frame (0 = default) */
+} sat_config_t;
+
+/**
+ * @brief Saturation result of one frame (or the part counted so far)
+ */
+typedef struct {
+    uint32_t saturated;         /**< Pixels >= threshold */
+    uint32_t tiles_over;        /**< Tiles at or above tile_fraction */
+    uint32_t worst_tile;        /**< Index (ty * tiles_x + tx) of fullest tile */
+    uint32_t worst_count;       /**< Saturated pixels in worst_tile */
+    bool tripped;               /**< tiles_over >= trip_tiles */
+} sat_frame_t;
+
+/**
+ * @brief Cumulative saturation counters
+ */
+typedef struct {
+    uint64_t frames;            /**< Frames ended */
+    uint64_t frames_saturated;  /**< Frames with at least one saturated pixel */
+    uint64_t frames_tripped;    /**< Frames that tripped */
+    uint64_t saturated_pixels;  /**< Total saturated pixels */
+    uint32_t max_tiles_over;    /**< Largest tiles_over of any frame */
+    uint32_t last_tiles_over;   /**< tiles_over of the last ended frame */
+} sat_stats_t;
+
+/**
+ * @brief Opaque saturation counter handle
+ */
+typedef struct sat_counter sat_counter_t;
+
+/**
+ * @brief Create a saturation counter
+ *
+ * @param config Geometry, threshold and trip policy
+ * @return Handle, or NULL on invalid configuration / allocation failure
+ */
+sat_counter_t *saturation_create(const sat_config_t *config);
+
+/**
+ * @brief Destroy a saturation counter
+ *
+ * @param sat Handle (NULL is ignored)
+ */
+void saturation_destroy(sat_counter_t *sat);
+
+/**
+ * @brief Clear per-tile counts for a new frame
+ *
+ * @param sat Handle (NULL is ignored)
+ */
+void saturation_begin_frame(sat_counter_t *sat);
+
+/**
+ * @brief Count saturated pixels of a band of rows
+ *
+ * Bands may arrive in any order but each row must be counted at most
+ * once per frame.
+ *
+ * @param sat Handle
+ * @param frame Frame base pointer (width * height pixels)
+ * @param row_start First row of the band
+ * @param row_count Rows in the band
+ * @return SAT_OK on success, error code on failure
+ */
+sat_status_t saturation_count_rows(sat_counter_t *sat, const uint16_t *frame,
+                                   uint32_t row_start, uint32_t row_count);
+
+/**
+ * @brief Add per-tile counts computed elsewhere (e.g. correction_set_count_hook)
+ *
+ * The counts must come from the same threshold and tile size, and like
+ * saturation_count_rows each row may be counted at most once per frame.
+ *
+ * @param sat Handle
+ * @param row_start First row the counts cover
+ * @param row_count Rows covered, all within one tile row
+ * @param counts Saturated pixels per tile column (tiles_x entries)
+ * @return SAT_OK on success, SAT_ERROR_PARAM if the rows are out of range
+ *         or span more than one tile row
+ */
+sat_status_t saturation_add_counts(sat_counter_t *sat, uint32_t row_start, uint32_t row_count,
+                                   const uint32_t *counts);
+
+/**
+ * @brief Check whether the current frame has tripped so far
+ *
+ * @param sat Handle
+ * @return true once trip_tiles tiles are marked, false otherwise or if NULL
+ */
+bool saturation_tripped(const sat_counter_t *sat);
+
+/**
+ * @brief Get the current frame result without ending the frame
+ *
+ * @param sat Handle
+ * @param result Output result for the rows counted so far
+ * @return SAT_OK on success, error code on failure
+ */
+sat_status_t saturation_get_frame(const sat_counter_t *sat, sat_frame_t *result);
+
+/**
+ * @brief End the frame and fold it into the cumulative counters
+ *
+ * @param sat Handle
+ * @param result Output frame result (may be NULL)
+ * @return SAT_OK on success, error code on failure
+ */
+sat_status_t saturation_end_frame(sat_counter_t *sat, sat_frame_t *result);
+
+/**
+ * @brief Get per-tile saturated pixel counts of the current frame
+ *
+ * @param sat Handle
+ * @param tiles_x Output tile columns (may be NULL)
+ * @param tiles_y Output tile rows (may be NULL)
+ * @return Row-major tile counts, or NULL if sat is NULL
+ */
+const uint32_t *saturation_get_tiles(const sat_counter_t *sat,
+                                     uint32_t *tiles_x, uint32_t *tiles_y);
+
+/**
+ * @brief Get cumulative counters
+ *
+ * @param sat Handle
+ * @param stats Output counters
+ */
+void saturation_get_stats(const sat_counter_t *sat, sat_stats_t *stats);
+
+/**
+ * @brief Get name of the count kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *saturation_get_kernel_name(void);
+
+/**
+ * @brief Count kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t saturation_kernel_count;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_SATURATION_H */
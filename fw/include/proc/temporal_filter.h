@@ -0,0 +1,198 @@
+/**
+ * @file temporal_filter.h
+ * @brief Motion-adaptive recursive temporal noise filter
+ *
+ * First-order recursive filter for continuous (fluoroscopy) scans:
+ *
+ *   state = state + alpha * (new - state)
+ *
+ * with alpha chosen per pixel: pixels whose new value differs from the
+ * filtered value by more than motion_threshold use motion_alpha (1.0 by
+ * default, i.e. no lag), all others use alpha. The state is a persistent
+ * 32-bit fixed-point buffer (TF_STATE_FRAC_BITS fractional bits) and the
+ * filtered result is written back over the frame.
+ *
+ * Applied band by band from the correction hook, so each pixel is read
+ * and written once per frame together with one state read and write.
+ *
+ * Parameters are staged with temporal_filter_set_params() and take effect
+ * at the next temporal_filter_reset(), which the daemon issues at the start
+ * of every continuous scan, so a running scan is never reconfigured.
+ */
+
+#ifndef DETECTOR_PROC_TEMPORAL_FILTER_H
+#define DETECTOR_PROC_TEMPORAL_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Temporal filter result codes
+ */
+typedef enum {
+    TF_OK = 0,                  /**< Success */
+    TF_ERROR_NULL = -1,         /**< NULL pointer argument */
+    TF_ERROR_PARAM = -2,        /**< Invalid geometry, parameters or row range */
+    TF_ERROR_MEMORY = -3        /**< Memory allocation failed */
+} tf_status_t;
+
+/* Weights are Q8: TF_ALPHA_ONE = 1.0 */
+#define TF_ALPHA_ONE                256
+#define TF_STATE_FRAC_BITS          6
+
+#define TF_DEFAULT_ALPHA            64      /* 0.25: ~7 frame noise averaging */
+#define TF_DEFAULT_MOTION_ALPHA     TF_ALPHA_ONE
+#define TF_DEFAULT_MOTION_THRESHOLD 512
+
+/**
+ * @brief Filter parameters (wire format for CMD_SET_CONFIG, little-endian)
+ */
+typedef struct {
+    uint8_t enabled;            /**< 0 = pass frames through */
+    uint8_t reserved;           /**< Must be 0 */
+    uint16_t alpha;             /**< Static pixel weight, Q8 in [1, 256] */
+    uint16_t motion_alpha;      /**< Moving pixel weight, Q8 in [alpha, 256] */
+    uint16_t motion_threshold;  /**< |new - filtered| above this is motion */
+} __attribute__((packed)) tf_params_t;
+
+/**
+ * @brief Temporal filter configuration
+ */
+typedef struct {
+    uint32_t width;             /**< Frame width in pixels */
+    uint32_t height;            /**< Frame height in pixels */
+    tf_params_t params;         /**< Initial parameters */
+} tf_config_t;
+
+/**
+ * @brief Temporal filter statistics
+ */
+typedef struct {
+    uint64_t frames;            /**< Frames filtered (excludes seed frames) */
+    uint32_t resets;            /**< temporal_filter_reset() calls */
+    uint32_t last_motion;       /**< Motion pixels in the last frame */
+    uint64_t motion_pixels;     /**< Motion pixels over all frames */
+} tf_stats_t;
+
+/**
+ * @brief Opaque temporal filter handle
+ */
+typedef struct tf_filter tf_filter_t;
+
+/**
+ * @brief Fill parameters with defaults (enabled)
+ *
+ * @param params Parameters to fill
+ */
+void temporal_filter_params_defaults(tf_params_t *params);
+
+/**
+ * @brief Create a temporal filter and its state buffer
+ *
+ * @param config Geometry and initial parameters
+ * @return Handle, or NULL on invalid configuration / allocation failure
+ */
+tf_filter_t *temporal_filter_create(const tf_config_t *config);
+
+/**
+ * @brief Destroy a temporal filter
+ *
+ * @param tf Handle (NULL is ignored)
+ */
+void temporal_filter_destroy(tf_filter_t *tf);
+
+/**
+ * @brief Stage parameters for the next reset
+ *
+ * Thread-safe with respect to the frame path.
+ *
+ * @param tf Handle
+ * @param params New parameters
+ * @return TF_OK on success, TF_ERROR_PARAM if out of range
+ */
+tf_status_t temporal_filter_set_params(tf_filter_t *tf, const tf_params_t *params);
+
+/**
+ * @brief Drop the filter history and apply staged parameters
+ *
+ * The next frame seeds the state and passes through unfiltered.
+ *
+ * @param tf Handle (NULL is ignored)
+ */
+void temporal_filter_reset(tf_filter_t *tf);
+
+/**
+ * @brief Check whether the active parameters enable filtering
+ *
+ * @param tf Handle
+ * @return true if enabled, false otherwise or if NULL
+ */
+bool temporal_filter_enabled(const tf_filter_t *tf);
+
+/**
+ * @brief Start a frame
+ *
+ * @param tf Handle (NULL is ignored)
+ */
+void temporal_filter_begin_frame(tf_filter_t *tf);
+
+/**
+ * @brief Filter a band of rows in place
+ *
+ * @param tf Handle
+ * @param frame Frame base pointer (width * height pixels)
+ * @param row_start First row of the band
+ * @param row_count Rows in the band
+ * @return TF_OK on success, error code on failure
+ */
+tf_status_t temporal_filter_apply_rows(tf_filter_t *tf, uint16_t *frame,
+                                       uint32_t row_start, uint32_t row_count);
+
+/**
+ * @brief Filter a whole frame in place (begin + all rows + end)
+ *
+ * @param tf Handle
+ * @param frame Frame data (width * height pixels)
+ * @return TF_OK on success, error code on failure
+ */
+tf_status_t temporal_filter_apply_frame(tf_filter_t *tf, uint16_t *frame);
+
+/**
+ * @brief End a frame and update statistics
+ *
+ * @param tf Handle (NULL is ignored)
+ */
+void temporal_filter_end_frame(tf_filter_t *tf);
+
+/**
+ * @brief Get statistics
+ *
+ * @param tf Handle
+ * @param stats Output statistics
+ */
+void temporal_filter_get_stats(const tf_filter_t *tf, tf_stats_t *stats);
+
+/**
+ * @brief Get name of the row kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *temporal_filter_get_kernel_name(void);
+
+/**
+ * @brief Row kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t temporal_filter_kernel_row;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_TEMPORAL_FILTER_H */
@@ -0,0 +1,184 @@
+/**
+ * @file window_level.h
+ * @brief 16-bit to 8-bit window/level and gamma conversion for display
+ *
+ * Preview and remote-viewer outputs only need an 8-bit image. Pixels in
+ * [low, high] are mapped linearly onto 0..255 (values outside clamp),
+ * optionally through a display gamma: out = 255 * t^(1/gamma), with
+ * t = (v - low) / (high - low).
+ *
+ * Two equivalent methods, bit-identical by construction:
+ * - WL_METHOD_ARITH: per-pixel fixed-point arithmetic. Without gamma the
+ *   whole mapping is a dispatched SIMD kernel (subtract, clamp, shift,
+ *   multiply-high, narrow); with gamma each pixel is reduced to a 12-bit
+ *   curve index and looked up in a 4 KiB gamma curve.
+ * - WL_METHOD_LUT: a 64 KiB table indexed by the raw pixel, rebuilt from
+ *   the arithmetic mapping whenever the window changes.
+ *
+ * WL_METHOD_AUTO picks whichever bench_window_level measured faster for
+ * the configured gamma (see window_level.c).
+ *
+ * The window is fixed or follows histogram percentiles of each frame
+ * (window_level_auto_window() with frame_stats output).
+ *
+ * Setting the window is not thread-safe. Once it is set, several threads
+ * may window_level_convert() disjoint ranges of a frame.
+ */
+
+#ifndef DETECTOR_PROC_WINDOW_LEVEL_H
+#define DETECTOR_PROC_WINDOW_LEVEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "proc/frame_stats.h"
+#include "util/cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Window/level result codes
+ */
+typedef enum {
+    WL_OK = 0,                  /**< Success */
+    WL_ERROR_NULL = -1,         /**< NULL pointer argument */
+    WL_ERROR_PARAM = -2         /**< Invalid window, gamma or percentiles */
+} wl_status_t;
+
+/**
+ * @brief Conversion method (detector_config.yaml display.method)
+ */
+typedef enum {
+    WL_METHOD_AUTO = 0,         /**< Faster method for the configured gamma */
+    WL_METHOD_LUT,              /**< 64 KiB lookup table */
+    WL_METHOD_ARITH             /**< SIMD fixed-point arithmetic */
+} wl_method_t;
+
+/* Defaults */
+#define WL_DEFAULT_LOW_PERCENTILE   0.005f  /**< Auto window black point */
+#define WL_DEFAULT_HIGH_PERCENTILE  0.995f  /**< Auto window white point */
+#define WL_DEFAULT_GAMMA            1.0f
+
+/* Gamma curve resolution */
+#define WL_CURVE_BITS           12
+#define WL_CURVE_SIZE           (1U << WL_CURVE_BITS)
+
+/**
+ * @brief Window/level configuration
+ */
+typedef struct {
+    uint16_t window_low;        /**< Black point (manual window) */
+    uint16_t window_high;       /**< White point, > window_low (manual window) */
+    float gamma;                /**< Display gamma, 0.1-10 (0 = 1.0, linear) */
+    float low_percentile;       /**< Auto window black fraction (0 = default) */
+    float high_percentile;      /**< Auto window white fraction (0 = default) */
+    wl_method_t method;         /**< Conversion method */
+} wl_config_t;
+
+/**
+ * @brief Opaque window/level converter
+ */
+typedef struct window_level window_level_t;
+
+/**
+ * @brief Create a converter
+ *
+ * @param config Configuration (window, gamma, percentiles)
+ * @return Handle, or NULL on invalid parameters or allocation failure
+ */
+window_level_t *window_level_create(const wl_config_t *config);
+
+/**
+ * @brief Destroy a converter
+ *
+ * @param wl Handle (NULL is ignored)
+ */
+void window_level_destroy(window_level_t *wl);
+
+/**
+ * @brief Set the window
+ *
+ * @param wl Handle
+ * @param low Black point
+ * @param high White point, must be greater than low
+ * @return WL_OK on success, error code on failure
+ */
+wl_status_t window_level_set_window(window_level_t *wl, uint16_t low, uint16_t high);
+
+/**
+ * @brief Set the window from histogram percentiles
+ *
+ * Black and white points are the configured percentiles of the frame
+ * histogram; a degenerate window is widened to one count.
+ *
+ * @param wl Handle
+ * @param stats Statistics of the frame to display
+ * @return WL_OK on success, error code on failure
+ */
+wl_status_t window_level_auto_window(window_level_t *wl, const fstats_t *stats);
+
+/**
+ * @brief Get the current window
+ *
+ * @param wl Handle
+ * @param low Black point (may be NULL)
+ * @param high White point (may be NULL)
+ */
+void window_level_get_window(const window_level_t *wl, uint16_t *low, uint16_t *high);
+
+/**
+ * @brief Method used by window_level_convert() (WL_METHOD_AUTO resolved)
+ *
+ * @param wl Handle
+ * @return WL_METHOD_LUT or WL_METHOD_ARITH
+ */
+wl_method_t window_level_method(const window_level_t *wl);
+
+/**
+ * @brief Convert pixels to 8 bits
+ *
+ * @param wl Handle
+ * @param dst Output pixels (n bytes)
+ * @param src Input pixels (n)
+ * @param n Pixel count
+ * @return WL_OK on success, error code on failure
+ */
+wl_status_t window_level_convert(window_level_t *wl, uint8_t *dst, const uint16_t *src,
+                                 size_t n);
+
+/**
+ * @brief Convert pixels with an explicit method
+ *
+ * Same output as window_level_convert(); lets the benchmark and tests
+ * compare the methods on one handle.
+ *
+ * @param wl Handle
+ * @param method WL_METHOD_LUT or WL_METHOD_ARITH
+ * @param dst Output pixels (n bytes)
+ * @param src Input pixels (n)
+ * @param n Pixel count
+ * @return WL_OK on success, error code on failure
+ */
+wl_status_t window_level_convert_method(window_level_t *wl, wl_method_t method, uint8_t *dst,
+                                        const uint16_t *src, size_t n);
+
+/**
+ * @brief Get name of the linear kernel variant in use
+ *
+ * @return cpu_dispatch_isa_name() of the selected variant
+ */
+const char *window_level_get_kernel_name(void);
+
+/**
+ * @brief Linear window kernel for cpu_dispatch_selftest()
+ */
+extern const cpu_kernel_t window_level_kernel_linear;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_PROC_WINDOW_LEVEL_H */
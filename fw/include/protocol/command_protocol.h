@@ -31,6 +31,7 @@ extern "C" {
 #define CMD_START_SCAN  0x01
 #define CMD_STOP_SCAN   0x02
 #define CMD_GET_STATUS  0x10
+#define CMD_GET_DATA    0x11
 #define CMD_SET_CONFIG  0x20
 #define CMD_RESET       0x30
 
@@ -48,6 +49,52 @@ extern "C" {
 /* Maximum number of tracked clients */
 #define MAX_CLIENTS     16
 
+/*
+ * Extended CMD_SET_CONFIG payloads start with CMD_CONFIG_EXT_MAGIC ("CEXT")
+ * instead of the legacy exposure field. The legacy format caps exposure at
+ * 10000 ms, so the two cannot be confused.
+ */
+#define CMD_CONFIG_EXT_MAGIC    0x54584543u
+
+/* Extended config IDs */
+#define CMD_CONFIG_DEFECT_MAP   0x01    /* Payload: defect_record_t[] */
+#define CMD_CONFIG_TEMPORAL     0x02    /* Payload: tf_params_t (next scan) */
+#define CMD_CONFIG_TRACE        0x03    /* Payload: uint8 1 = start tracing, 0 = stop and dump */
+
+/* Extended config flags (multi-packet transfers) */
+#define CMD_CONFIG_FLAG_BEGIN   (1U << 0)   /* Discard previously staged data */
+#define CMD_CONFIG_FLAG_COMMIT  (1U << 1)   /* Apply staged data */
+
+/* Maximum number of registered config handlers */
+#define CMD_CONFIG_MAX_HANDLERS 16
+
+/*
+ * CMD_GET_DATA payload: data ID byte followed by handler arguments. The
+ * response payload is whatever the handler writes, up to
+ * CMD_MAX_RESPONSE_PAYLOAD bytes; larger data sets are paged by the
+ * handler's arguments.
+ */
+#define CMD_DATA_DRIFT_CANDIDATES   0x01    /* Args: uint32 start pixel. Reply: uint32
+                                               total, uint32 next start, uint16 count,
+                                               uint16 reserved, drift_candidate_t[count] */
+
+/*
+ * CMD_GET_STATUS response payload (little-endian), copied from the health
+ * monitor's status snapshot so it never waits on the sequence engine or
+ * a device: uint8 state, uint8 battery SOC (%), uint16 battery mV,
+ * uint16 FPGA temperature (0.1 C), uint32 uptime (s), uint32 age (ms) of
+ * the state, battery and temperature fields (UINT32_MAX = never read),
+ * then uint32 frames received, frames sent, frames dropped, SPI errors
+ * and CSI-2 errors.
+ */
+#define CMD_STATUS_PAYLOAD_LEN      42
+
+/* Maximum number of registered data handlers */
+#define CMD_DATA_MAX_HANDLERS   16
+
+/* Largest response payload the command handler builds */
+#define CMD_MAX_RESPONSE_PAYLOAD    1024
+
 /**
  * @brief Command frame format
  */
@@ -72,6 +119,42 @@ typedef struct {
     uint8_t payload[];  /* Variable length */
 } __attribute__((packed)) response_frame_t;
 
+/**
+ * @brief Extended CMD_SET_CONFIG payload header
+ */
+typedef struct {
+    uint32_t magic;         /* CMD_CONFIG_EXT_MAGIC */
+    uint8_t config_id;      /* CMD_CONFIG_* */
+    uint8_t flags;          /* CMD_CONFIG_FLAG_* */
+    uint16_t data_len;      /* Bytes following this header */
+    uint8_t data[];
+} __attribute__((packed)) cmd_config_ext_t;
+
+/**
+ * @brief Extended config handler
+ *
+ * @param flags CMD_CONFIG_FLAG_* bits
+ * @param data Config data
+ * @param len Config data length
+ * @param user_data Registration user data
+ * @return 0 on success, -errno on failure
+ */
+typedef int (*cmd_config_handler_t)(uint8_t flags, const uint8_t *data,
+                                    size_t len, void *user_data);
+
+/**
+ * @brief CMD_GET_DATA handler
+ *
+ * @param args Arguments following the data ID
+ * @param len Arguments length
+ * @param out Response payload buffer
+ * @param cap Response payload capacity (CMD_MAX_RESPONSE_PAYLOAD)
+ * @param user_data Registration user data
+ * @return Bytes written to out, or -errno on failure
+ */
+typedef int (*cmd_data_handler_t)(const uint8_t *args, size_t len, uint8_t *out,
+                                  size_t cap, void *user_data);
+
 /**
  * @brief Command Protocol context
  */
@@ -156,6 +239,28 @@ int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *re
  */
 void cmd_update_replay_state(uint32_t sequence, const char *source_ip);
 
+/**
+ * @brief Register handler for an extended CMD_SET_CONFIG ID
+ *
+ * @param config_id CMD_CONFIG_* identifier
+ * @param handler Handler (NULL to unregister)
+ * @param user_data Passed to handler
+ * @return 0 on success, -ENOSPC if the registry is full
+ */
+int cmd_register_config_handler(uint8_t config_id, cmd_config_handler_t handler,
+                                void *user_data);
+
+/**
+ * @brief Register handler for a CMD_GET_DATA ID
+ *
+ * @param data_id CMD_DATA_* identifier
+ * @param handler Handler (NULL to unregister)
+ * @param user_data Passed to handler
+ * @return 0 on success, -ENOSPC if the registry is full
+ */
+int cmd_register_data_handler(uint8_t data_id, cmd_data_handler_t handler,
+                              void *user_data);
+
 /**
  * @brief Get auth failure count
  *
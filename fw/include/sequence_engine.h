@@ -58,9 +58,84 @@ typedef enum {
     EVT_ERROR,
     EVT_ERROR_CLEARED,
     EVT_COMPLETE,
+    EVT_FRAME_START,
+    EVT_OVEREXPOSURE,
     EVT_MAX
 } seq_event_t;
 
+/**
+ * @brief EVT_FRAME_START payload (start-of-frame from CSI-2 frame-sync)
+ */
+typedef struct {
+    uint32_t sequence;       /**< CSI-2 frame sequence number */
+    uint64_t timestamp_ns;   /**< Start-of-frame time (CLOCK_MONOTONIC) */
+} seq_frame_start_t;
+
+/**
+ * @brief Protection response to EVT_OVEREXPOSURE (protection.overflow_action)
+ */
+typedef enum {
+    SEQ_OVEREXPOSURE_STOP = 0,      /**< Stop the scan via FPGA_CTRL_STOP */
+    SEQ_OVEREXPOSURE_BACKOFF,       /**< Divide FPGA_REG_TIMING by SEQ_BACKOFF_DIVISOR */
+    SEQ_OVEREXPOSURE_NONE,          /**< Count only */
+    SEQ_OVEREXPOSURE_MAX
+} seq_overexposure_action_t;
+
+#define SEQ_BACKOFF_DIVISOR  2
+
+/**
+ * @brief EVT_OVEREXPOSURE payload (saturation trip from the frame path)
+ */
+typedef struct {
+    uint32_t saturated;                 /**< Saturated pixels counted so far */
+    uint32_t tiles_over;                /**< Tiles over the saturation limit */
+    seq_overexposure_action_t action;   /**< Response to apply */
+} seq_overexposure_t;
+
+/**
+ * @brief Exposure registers programmed in CONFIGURE (and by auto-exposure)
+ */
+typedef struct {
+    uint16_t timing;         /**< FPGA_REG_TIMING value */
+    uint16_t gain;           /**< FPGA_REG_GAIN value (0x0080 = 1.0x) */
+} seq_exposure_t;
+
+#define SEQ_DEFAULT_TIMING   0x0010
+#define SEQ_DEFAULT_GAIN     0x0080
+
+/**
+ * @brief Dual-gain HDR: FPGA_REG_GAIN alternated frame by frame
+ *
+ * Even CSI-2 sequence numbers are exposed at low_gain, odd ones at
+ * high_gain. The gain of the next frame is written at each start-of-frame
+ * (the FPGA latches it at the following frame start); the first frame of
+ * a scan is always low gain, so an odd first frame is not a valid high-
+ * gain frame and is dropped by the fusion stage for lack of a partner.
+ * Calibration scans keep exposure.gain.
+ */
+typedef struct {
+    bool enabled;            /**< Alternate gains instead of exposure.gain */
+    uint16_t low_gain;       /**< FPGA_REG_GAIN of even frames */
+    uint16_t high_gain;      /**< FPGA_REG_GAIN of odd frames */
+} seq_hdr_t;
+
+/**
+ * @brief Calibration phase requested for SCAN_MODE_CALIBRATION
+ */
+typedef enum {
+    SEQ_CALIB_DARK = 0,      /**< Dark frames (X-ray off) -> offset map */
+    SEQ_CALIB_FLOOD,         /**< Flood frames (uniform X-ray) -> gain map */
+    SEQ_CALIB_MAX
+} seq_calib_phase_t;
+
+/**
+ * @brief Calibration scan parameters
+ */
+typedef struct {
+    seq_calib_phase_t phase; /**< Phase to accumulate */
+    uint16_t frames;         /**< Frames to average (0 = default) */
+} seq_calib_params_t;
+
 /**
  * @brief FPGA Status Register bits
  */
@@ -86,6 +161,7 @@ typedef struct {
     uint32_t frames_sent;
     uint32_t errors;
     uint32_t retries;
+    uint32_t overexposures;  /**< EVT_OVEREXPOSURE events while scanning */
 } seq_stats_t;
 
 /**
@@ -132,6 +208,80 @@ const char *seq_state_to_string(seq_state_t state);
  */
 int seq_start_scan(scan_mode_t mode);
 
+/**
+ * @brief Get current scan mode
+ *
+ * @return Mode of the current or last scan
+ */
+scan_mode_t seq_get_mode(void);
+
+/**
+ * @brief Set calibration parameters for the next calibration scan
+ *
+ * @param params Phase and frame count
+ * @return 0 on success, -EINVAL on invalid params, -EBUSY while scanning
+ */
+int seq_set_calibration(const seq_calib_params_t *params);
+
+/**
+ * @brief Get calibration parameters
+ *
+ * @param params Pointer to store parameters
+ * @return 0 on success, -EINVAL on NULL
+ */
+int seq_get_calibration(seq_calib_params_t *params);
+
+/**
+ * @brief Set exposure registers
+ *
+ * @param exposure Timing and gain register values
+ * @return 0 on success, -EINVAL on NULL or zero values
+ *
+ * Written to the FPGA on the next CONFIGURE.
+ */
+int seq_set_exposure(const seq_exposure_t *exposure);
+
+/**
+ * @brief Program exposure registers mid-scan
+ *
+ * @param expected Register values the new ones were derived from
+ * @param exposure New timing and gain register values
+ * @return 0 on success, -EAGAIN if the programmed exposure no longer
+ *         matches expected (an overexposure response moved it) or the scan
+ *         is no longer exposing, -EIO on SPI failure, -EINVAL on NULL or
+ *         zero values
+ *
+ * Changed registers are written without read-back and kept for a restart.
+ * Serialised with seq_handle_event(), so a step computed from an older
+ * frame cannot undo an overexposure backoff or stop.
+ */
+int seq_program_exposure(const seq_exposure_t *expected, const seq_exposure_t *exposure);
+
+/**
+ * @brief Get exposure registers
+ *
+ * @param exposure Pointer to store register values
+ * @return 0 on success, -EINVAL on NULL
+ */
+int seq_get_exposure(seq_exposure_t *exposure);
+
+/**
+ * @brief Set dual-gain HDR mode for the next scan
+ *
+ * @param hdr Enable flag and gain pair
+ * @return 0 on success, -EINVAL on NULL, zero gains or low_gain >= high_gain
+ *         when enabled, -EBUSY while scanning
+ */
+int seq_set_hdr(const seq_hdr_t *hdr);
+
+/**
+ * @brief Get dual-gain HDR mode
+ *
+ * @param hdr Pointer to store settings
+ * @return 0 on success, -EINVAL on NULL
+ */
+int seq_get_hdr(seq_hdr_t *hdr);
+
 /**
  * @brief Stop scan
  *
@@ -156,6 +306,22 @@ int seq_handle_event(seq_event_t event, void *data);
  */
 int seq_get_stats(seq_stats_t *stats);
 
+/**
+ * @brief Get the most recent start-of-frame
+ *
+ * @param frame_start Pointer to store last EVT_FRAME_START payload
+ * @return 0 on success, -ENOENT if no frame has started since scan start
+ */
+int seq_get_frame_start(seq_frame_start_t *frame_start);
+
+/**
+ * @brief Get the most recent overexposure event
+ *
+ * @param event Pointer to store last EVT_OVEREXPOSURE payload
+ * @return 0 on success, -ENOENT if none since scan start
+ */
+int seq_get_overexposure(seq_overexposure_t *event);
+
 /**
  * @brief Get retry count
  *
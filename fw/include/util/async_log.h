@@ -0,0 +1,148 @@
+/**
+ * @file async_log.h
+ * @brief Asynchronous logger: capture on the caller, format on a drain thread
+ *
+ * A log call stores a timestamp, the format string pointer (its ID) and
+ * the raw arguments into a ring owned by the calling thread, and returns.
+ * Formatting, the wall-clock conversion and the blocking write to the
+ * sink happen on one low-priority drain thread, so SCHED_FIFO threads
+ * never format, take a lock or enter the kernel to log.
+ *
+ * Each thread claims a ring on its first call and hands it back when it
+ * exits. A full ring drops the record and counts it; the drain reports
+ * drops, applies a per-format rate limit and folds repeats of the same
+ * message into one "repeated N times" line. The drain merges the rings
+ * by timestamp, so lines of different threads come out in call order
+ * (except a record still being written while a pass runs).
+ *
+ * Format and module strings must outlive the drain (string literals);
+ * %s arguments are copied. Formats the capture cannot handle (more than
+ * ALOG_MAX_ARGS arguments, %n) are formatted on the caller instead.
+ *
+ * The logger is process-wide: alog_start() once, alog_stop() after the
+ * logging threads have stopped.
+ */
+
+#ifndef DETECTOR_UTIL_ASYNC_LOG_H
+#define DETECTOR_UTIL_ASYNC_LOG_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Async logger result codes
+ */
+typedef enum {
+    ALOG_OK = 0,                /**< Success */
+    ALOG_ERROR_NULL = -1,       /**< NULL pointer argument */
+    ALOG_ERROR_PARAM = -2,      /**< Invalid parameter */
+    ALOG_ERROR_MEMORY = -3,     /**< Ring allocation failed */
+    ALOG_ERROR_THREAD = -4,     /**< Drain thread creation failed */
+    ALOG_ERROR_STATE = -5       /**< Already started */
+} alog_status_t;
+
+#define ALOG_MAX_THREADS            16      /* Rings; further threads log synchronously */
+#define ALOG_MAX_ARGS               8       /* Captured arguments per record */
+#define ALOG_MAX_MESSAGE            1024    /* Formatted message incl. NUL */
+#define ALOG_DEFAULT_RING_RECORDS   256
+#define ALOG_DEFAULT_DRAIN_MS       10
+#define ALOG_DEFAULT_RATE_LIMIT     100     /* Messages per format per second */
+
+/**
+ * @brief Sink for formatted messages (called on the drain thread)
+ *
+ * @param level Level passed to the log call
+ * @param module Module passed to the log call
+ * @param time_ns CLOCK_REALTIME of the log call in nanoseconds
+ * @param message Formatted message
+ * @param user_data alog_config_t.sink_data
+ */
+typedef void (*alog_sink_fn_t)(int level, const char *module, uint64_t time_ns,
+                               const char *message, void *user_data);
+
+/**
+ * @brief Logger configuration
+ */
+typedef struct {
+    alog_sink_fn_t sink;        /**< Output of the drain thread */
+    void *sink_data;            /**< Passed to sink */
+    uint32_t ring_records;      /**< Records per thread ring (0 = default, rounded up to 2^n) */
+    uint32_t drain_ms;          /**< Drain poll interval (0 = default) */
+    uint32_t rate_limit;        /**< Messages per format per second (0 = default, UINT32_MAX = off) */
+    bool keep_duplicates;       /**< Emit repeats instead of folding them */
+    int notice_level;           /**< Level of the logger's own drop reports */
+    int nice;                   /**< Drain thread nice value (0 = inherit) */
+} alog_config_t;
+
+/**
+ * @brief Logger counters since alog_start()
+ */
+typedef struct {
+    uint64_t captured;          /**< Records put in a ring */
+    uint64_t dropped;           /**< Records lost to a full ring */
+    uint64_t fallback;          /**< Calls left to the caller (no ring free) */
+    uint64_t emitted;           /**< Messages passed to the sink */
+    uint64_t rate_limited;      /**< Messages held back by the rate limit */
+    uint64_t duplicates;        /**< Repeats folded into "repeated" lines */
+    uint64_t truncated;         /**< Records whose strings were cut to fit */
+    uint32_t rings;             /**< Rings owned by a live thread */
+} alog_stats_t;
+
+/**
+ * @brief Allocate the rings and start the drain thread
+ *
+ * @param config Configuration
+ * @return ALOG_OK on success, error code on failure
+ */
+alog_status_t alog_start(const alog_config_t *config);
+
+/**
+ * @brief Drain everything, stop the drain thread and free the rings
+ *
+ * No thread may log concurrently (calls after the stop log synchronously).
+ */
+void alog_stop(void);
+
+/**
+ * @brief Whether alog_start() is in effect
+ */
+bool alog_active(void);
+
+/**
+ * @brief Capture a log call
+ *
+ * @param level Level (passed through to the sink)
+ * @param module Module name (string literal)
+ * @param format printf format (string literal)
+ * @param args Arguments
+ * @return true if queued (or dropped on a full ring); false if the caller
+ *         must log synchronously (logger stopped, no ring free)
+ */
+bool alog_vlog(int level, const char *module, const char *format, va_list args);
+
+/**
+ * @brief Wait until everything queued so far has reached the sink
+ *
+ * @param timeout_ms Maximum wait
+ * @return ALOG_OK when drained, ALOG_ERROR_STATE if stopped or timed out
+ */
+alog_status_t alog_flush(uint32_t timeout_ms);
+
+/**
+ * @brief Get counters
+ *
+ * @param stats Output counters
+ * @return ALOG_OK on success, error code on failure
+ */
+alog_status_t alog_get_stats(alog_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_ASYNC_LOG_H */
@@ -0,0 +1,159 @@
+/**
+ * @file cpu_dispatch.h
+ * @brief Runtime CPU-feature dispatch for pixel kernels
+ *
+ * One binary runs on the i.MX8M Plus (NEON) and on x86-64 development
+ * and CI hosts. Every hot kernel is compiled in all variants the target
+ * architecture can execute (x86 variants through function target
+ * attributes, so no -mavx2 is needed) and described by a cpu_kernel_t.
+ * Modules pick a variant with cpu_dispatch_select() when they are created,
+ * so the per-pixel path is a plain indirect call.
+ *
+ * The usable ISA level is detected once (HWCAP on AArch64, cpuid on x86)
+ * and may be capped by cpu_dispatch_init() (daemon --isa flag) or the
+ * DETECTOR_ISA environment variable, e.g. to run CI on the scalar path.
+ * cpu_dispatch_selftest() checks every supported variant against scalar
+ * on random data.
+ */
+
+#ifndef DETECTOR_UTIL_CPU_DISPATCH_H
+#define DETECTOR_UTIL_CPU_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Kernel variants that can be compiled for the target architecture */
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_DISPATCH_X86        1
+#define CPU_TARGET_SSE42        __attribute__((target("sse4.2")))
+#define CPU_TARGET_AVX2         __attribute__((target("avx2")))
+#define CPU_TARGET_AVX2_F16C    __attribute__((target("avx2,f16c")))
+#elif defined(__aarch64__)
+#define CPU_DISPATCH_NEON       1
+#endif
+
+#define CPU_DISPATCH_ENV        "DETECTOR_ISA"
+
+/**
+ * @brief Instruction set levels, in order of preference
+ */
+typedef enum {
+    CPU_ISA_SCALAR = 0,         /**< Portable C (reference) */
+    CPU_ISA_NEON,               /**< AArch64 Advanced SIMD */
+    CPU_ISA_SSE42,              /**< x86 SSE4.2 */
+    CPU_ISA_AVX2,               /**< x86 AVX2 (with F16C) */
+    CPU_ISA_COUNT
+} cpu_isa_t;
+
+/**
+ * @brief Generic kernel pointer; cast to the kernel's own type
+ */
+typedef void (*cpu_fn_t)(void);
+
+/**
+ * @brief One implementation of a kernel
+ */
+typedef struct {
+    cpu_isa_t isa;              /**< Required instruction set */
+    cpu_fn_t fn;                /**< Implementation */
+} cpu_variant_t;
+
+/**
+ * @brief Compare a variant against the reference on random data
+ *
+ * @param candidate Variant under test
+ * @param reference Scalar variant
+ * @param seed Seed for the test data
+ * @return true if outputs are identical
+ */
+typedef bool (*cpu_check_fn_t)(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed);
+
+/**
+ * @brief Kernel descriptor
+ */
+typedef struct {
+    const char *name;               /**< e.g. "correction.q14" */
+    const cpu_variant_t *variants;  /**< Scalar first */
+    uint32_t variant_count;         /**< Entries in variants */
+    cpu_check_fn_t check;           /**< Self-test against scalar */
+} cpu_kernel_t;
+
+/**
+ * @brief Self-test result callback
+ */
+typedef void (*cpu_report_fn_t)(const cpu_kernel_t *kernel, cpu_isa_t isa, bool passed,
+                                void *user_data);
+
+/**
+ * @brief Fix the ISA level before the first kernel is selected
+ *
+ * @param name NULL or "auto" for the highest supported level, otherwise
+ *             "scalar", "neon", "sse4.2" or "avx2" as an upper bound
+ * @return 0 on success, -EINVAL for an unknown name, -ENOTSUP if this CPU
+ *         or build cannot run that level (level unchanged)
+ */
+int cpu_dispatch_init(const char *name);
+
+/**
+ * @brief Bitmask of ISA levels this CPU and build can run (1U << cpu_isa_t)
+ */
+uint32_t cpu_dispatch_supported(void);
+
+/**
+ * @brief Active ISA level (detected on first use if not initialised)
+ */
+cpu_isa_t cpu_dispatch_level(void);
+
+/**
+ * @brief Name of an ISA level
+ *
+ * @return "scalar", "neon", "sse4.2", "avx2" or "unknown"
+ */
+const char *cpu_dispatch_isa_name(cpu_isa_t isa);
+
+/**
+ * @brief Select the best variant of a kernel for the active level
+ *
+ * @param kernel Kernel descriptor
+ * @param isa Selected level (may be NULL)
+ * @return Variant, never NULL for a kernel with a scalar entry
+ */
+cpu_fn_t cpu_dispatch_select(const cpu_kernel_t *kernel, cpu_isa_t *isa);
+
+/**
+ * @brief Check every supported non-scalar variant against scalar
+ *
+ * Runs regardless of the active level, so a capped daemon can still
+ * verify the faster variants.
+ *
+ * @param kernels Kernel descriptors
+ * @param count Number of kernels
+ * @param rounds Random data sets per variant
+ * @param report Called once per variant tested (may be NULL)
+ * @param user_data Passed to report
+ * @return Number of failing variants
+ */
+uint32_t cpu_dispatch_selftest(const cpu_kernel_t *const *kernels, size_t count,
+                               uint32_t rounds, cpu_report_fn_t report, void *user_data);
+
+/**
+ * @brief Deterministic pseudo-random generator for kernel self-tests
+ *
+ * @param state Generator state, updated
+ * @return Next 32-bit value
+ */
+static inline uint32_t cpu_dispatch_random(uint32_t *state) {
+    *state = *state * 1664525U + 1013904223U;
+    return *state ^ (*state >> 16);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_CPU_DISPATCH_H */
@@ -63,6 +63,39 @@ uint16_t crc16_compute_with_init(const uint8_t *data, size_t len, uint16_t initi
  */
 int crc16_verify(const uint8_t *data, size_t len, uint16_t expected_crc);
 
+/**
+ * @brief Zero-run shift table
+ *
+ * The CRC is linear: for two messages of equal length that differ only in
+ * a few bytes, crc(b) = crc(a) ^ shift(crc0(a ^ b)), where crc0 runs the
+ * differing bytes from a zero register and shift() carries the result past
+ * the bytes that follow them. The table does that carry in two lookups, so
+ * a fixed-layout header can be patched instead of recomputed.
+ */
+typedef struct {
+    uint16_t hi[256];   /**< Shifted contribution of the register high byte */
+    uint16_t lo[256];   /**< Shifted contribution of the register low byte */
+} crc16_shift_t;
+
+/**
+ * @brief Build a shift table for a run of zero bytes
+ *
+ * @param shift Table to fill
+ * @param zeros Number of bytes following the patched bytes
+ */
+void crc16_shift_init(crc16_shift_t *shift, size_t zeros);
+
+/**
+ * @brief Carry a zero-initialised CRC past the table's zero run
+ *
+ * @param shift Table from crc16_shift_init()
+ * @param crc CRC of the differing bytes, computed with initial value 0
+ * @return Contribution to XOR into the base message CRC
+ */
+static inline uint16_t crc16_shift_apply(const crc16_shift_t *shift, uint16_t crc) {
+    return (uint16_t)(shift->hi[crc >> 8] ^ shift->lo[crc & 0xFFU]);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,86 @@
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free single-producer / single-consumer queue
+ *
+ * Fixed-capacity ring of pointers for handing frames between two threads
+ * (e.g. adjacent pipeline stages). Push and pop never block or allocate;
+ * head and tail live on separate cache lines and each side caches the
+ * other's index, so the shared lines are only touched when the cached
+ * view says the ring is full or empty.
+ *
+ * Exactly one thread may push and one thread may pop. NULL is a valid
+ * item (pipelines use it as an end-of-stream marker).
+ */
+
+#ifndef DETECTOR_UTIL_SPSC_QUEUE_H
+#define DETECTOR_UTIL_SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPSC_MAX_CAPACITY   (1U << 20)
+
+/**
+ * @brief Opaque queue handle
+ */
+typedef struct spsc_queue spsc_queue_t;
+
+/**
+ * @brief Create a queue
+ *
+ * @param capacity Items the queue holds (rounded up to a power of two)
+ * @return Handle, or NULL if capacity is 0 / too large or allocation failed
+ */
+spsc_queue_t *spsc_queue_create(uint32_t capacity);
+
+/**
+ * @brief Destroy a queue (items still queued are not freed)
+ *
+ * @param q Handle (NULL is ignored)
+ */
+void spsc_queue_destroy(spsc_queue_t *q);
+
+/**
+ * @brief Append an item (producer thread only)
+ *
+ * @param q Handle
+ * @param item Item to append
+ * @return true on success, false if the queue is full
+ */
+bool spsc_queue_push(spsc_queue_t *q, void *item);
+
+/**
+ * @brief Remove the oldest item (consumer thread only)
+ *
+ * @param q Handle
+ * @param item Output item
+ * @return true on success, false if the queue is empty
+ */
+bool spsc_queue_pop(spsc_queue_t *q, void **item);
+
+/**
+ * @brief Approximate number of queued items (any thread)
+ *
+ * @param q Handle
+ * @return Items queued, 0 if NULL
+ */
+uint32_t spsc_queue_depth(const spsc_queue_t *q);
+
+/**
+ * @brief Queue capacity
+ *
+ * @param q Handle
+ * @return Capacity, 0 if NULL
+ */
+uint32_t spsc_queue_capacity(const spsc_queue_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_SPSC_QUEUE_H */
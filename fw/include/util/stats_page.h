@@ -0,0 +1,212 @@
+/**
+ * @file stats_page.h
+ * @brief Shared-memory statistics page with a seqlock
+ *
+ * The daemon publishes its counters and gauges into a POSIX shared memory
+ * object (/dev/shm/detector_stats). Readers map it read-only and copy a
+ * consistent set of values with no system call and no involvement of the
+ * daemon, so they can poll at any rate.
+ *
+ * Layout (version 1, native byte order, all offsets from the start):
+ *
+ *   0    stats_page_header_t   64 bytes
+ *   64   stats_page_entry_t    entry_count x 64 bytes (name, type)
+ *   values_offset              entry_count x uint64_t, 64-byte aligned
+ *
+ * The header and entry table are written once before `live` is set and
+ * never change. Values, update_ns and updates change under the seqlock
+ * `seq`: the writer makes it odd, stores, then makes it even. A reader
+ * loads seq, copies, loads seq again and retries if it was odd or moved.
+ * Counter values are uint64_t; gauge values are the bits of an IEEE
+ * double. When the daemon stops it clears `live` and unlinks the object,
+ * so a reader holding an old mapping should reopen.
+ */
+
+#ifndef DETECTOR_UTIL_STATS_PAGE_H
+#define DETECTOR_UTIL_STATS_PAGE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Stats page result codes
+ */
+typedef enum {
+    STATS_PAGE_OK = 0,              /**< Success */
+    STATS_PAGE_ERROR_NULL = -1,     /**< NULL pointer argument */
+    STATS_PAGE_ERROR_PARAM = -2,    /**< Invalid parameter */
+    STATS_PAGE_ERROR_SHM = -3,      /**< Shared memory object unavailable */
+    STATS_PAGE_ERROR_FORMAT = -4,   /**< Not a stats page, or another version */
+    STATS_PAGE_ERROR_BUSY = -5,     /**< Writer kept the page changing */
+    STATS_PAGE_ERROR_CLOSED = -6,   /**< Writer has stopped */
+    STATS_PAGE_ERROR_THREAD = -7    /**< Publisher thread creation failed */
+} stats_page_status_t;
+
+/**
+ * @brief Value type of an entry
+ */
+typedef enum {
+    STATS_PAGE_COUNTER = 0,         /**< Monotonic uint64_t */
+    STATS_PAGE_GAUGE = 1            /**< double, stored as its bits */
+} stats_page_type_t;
+
+#define STATS_PAGE_DEFAULT_NAME     "/detector_stats"
+#define STATS_PAGE_MAGIC            0x50545344U     /* "DSTP" */
+#define STATS_PAGE_VERSION          1
+#define STATS_PAGE_NAME_LEN         56
+#define STATS_PAGE_MAX_ENTRIES      1024
+#define STATS_PAGE_DEFAULT_PERIOD_MS 10
+
+/**
+ * @brief Page header (offset 0)
+ */
+typedef struct {
+    uint32_t magic;                 /**< STATS_PAGE_MAGIC */
+    uint16_t version;               /**< STATS_PAGE_VERSION */
+    uint16_t header_size;           /**< sizeof(stats_page_header_t) */
+    uint32_t entry_count;           /**< Entries and values */
+    uint32_t entry_size;            /**< sizeof(stats_page_entry_t) */
+    uint32_t values_offset;         /**< Offset of the value array */
+    uint32_t pid;                   /**< Writer process */
+    atomic_uint_least32_t live;     /**< 1 while the writer publishes */
+    atomic_uint_least32_t seq;      /**< Seqlock: odd while values change */
+    atomic_uint_least64_t update_ns; /**< CLOCK_MONOTONIC of the last publish */
+    atomic_uint_least64_t updates;  /**< Publishes since creation */
+    uint8_t reserved[16];
+} stats_page_header_t;
+
+/**
+ * @brief Entry descriptor (offset 64 + index * 64)
+ */
+typedef struct {
+    char name[STATS_PAGE_NAME_LEN]; /**< NUL-terminated, e.g. "eth_tx_frames_sent" */
+    uint32_t type;                  /**< stats_page_type_t */
+    uint32_t reserved;
+} stats_page_entry_t;
+
+_Static_assert(sizeof(stats_page_header_t) == 64, "stats page header is one cache line");
+_Static_assert(offsetof(stats_page_header_t, seq) == 28, "stats page layout v1");
+_Static_assert(offsetof(stats_page_header_t, update_ns) == 32, "stats page layout v1");
+_Static_assert(sizeof(stats_page_entry_t) == 64, "stats page entries are 64 bytes");
+
+/**
+ * @brief Writer handle (opaque)
+ */
+typedef struct stats_page stats_page_t;
+
+/**
+ * @brief Fill callback of the publisher thread
+ *
+ * @param values Value array to fill, one per entry (counters as is,
+ *               gauges through stats_page_gauge())
+ * @param user_data stats_page_config_t.user_data
+ */
+typedef void (*stats_page_fill_fn_t)(uint64_t *values, void *user_data);
+
+/**
+ * @brief Writer configuration
+ */
+typedef struct {
+    const char *name;               /**< shm_open name (NULL = STATS_PAGE_DEFAULT_NAME) */
+    const stats_page_entry_t *entries; /**< Entry table (copied) */
+    uint32_t entry_count;           /**< Entries (1..STATS_PAGE_MAX_ENTRIES) */
+    stats_page_fill_fn_t fill;      /**< Publisher thread callback (NULL = publish by hand) */
+    void *user_data;                /**< Passed to fill */
+    uint32_t period_ms;             /**< Publish period (0 = STATS_PAGE_DEFAULT_PERIOD_MS) */
+    int nice;                       /**< Publisher thread nice value (0 = inherit) */
+} stats_page_config_t;
+
+/**
+ * @brief Read-only mapping of a page
+ */
+typedef struct {
+    const stats_page_header_t *header;
+    const stats_page_entry_t *entries;
+    const atomic_uint_least64_t *values;
+    size_t size;                    /**< Mapped bytes */
+} stats_page_view_t;
+
+/* ==========================================================================
+ * Writer
+ * ========================================================================== */
+
+/**
+ * @brief Create the shared memory object and start publishing
+ *
+ * Replaces an object of the same name left by an earlier run. With a
+ * fill callback, a SCHED_OTHER thread publishes every period_ms.
+ *
+ * @param config Configuration
+ * @return Page handle, or NULL on failure
+ */
+stats_page_t *stats_page_create(const stats_page_config_t *config);
+
+/**
+ * @brief Stop publishing, mark the page closed and unlink it
+ *
+ * @param page Page handle (NULL is ignored)
+ */
+void stats_page_destroy(stats_page_t *page);
+
+/**
+ * @brief Publish a full set of values (single writer)
+ *
+ * @param page Page handle
+ * @param values One value per entry
+ * @return STATS_PAGE_OK on success, error code on failure
+ */
+stats_page_status_t stats_page_publish(stats_page_t *page, const uint64_t *values);
+
+/**
+ * @brief Encode a gauge value
+ */
+uint64_t stats_page_gauge(double value);
+
+/* ==========================================================================
+ * Reader
+ * ========================================================================== */
+
+/**
+ * @brief Map a page read-only and check its layout
+ *
+ * @param name shm_open name (NULL = STATS_PAGE_DEFAULT_NAME)
+ * @param view Output mapping
+ * @return STATS_PAGE_OK on success, error code on failure
+ */
+stats_page_status_t stats_page_open(const char *name, stats_page_view_t *view);
+
+/**
+ * @brief Unmap a page
+ *
+ * @param view Mapping from stats_page_open()
+ */
+void stats_page_close(stats_page_view_t *view);
+
+/**
+ * @brief Copy a consistent set of values
+ *
+ * @param view Mapping
+ * @param values Output, header->entry_count values
+ * @param update_ns Output CLOCK_MONOTONIC of that publish (may be NULL)
+ * @return STATS_PAGE_OK, STATS_PAGE_ERROR_CLOSED if the writer stopped
+ *         (values still copied), or STATS_PAGE_ERROR_BUSY
+ */
+stats_page_status_t stats_page_read(const stats_page_view_t *view, uint64_t *values,
+                                    uint64_t *update_ns);
+
+/**
+ * @brief Decode a value as a double (counters converted, gauges unpacked)
+ */
+double stats_page_value(const stats_page_entry_t *entry, uint64_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_STATS_PAGE_H */
@@ -0,0 +1,133 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool for per-frame image processing
+ *
+ * Fork/join pool that spreads a frame's row bands over the A53 cores.
+ * thread_pool_parallel_for() splits [0, count) into tasks of `grain`
+ * items, deals them out to one deque per participant and returns once all
+ * tasks have run. The calling thread takes part as participant 0, so a
+ * pool of N threads starts N - 1 workers.
+ *
+ * Each participant runs tasks from the bottom of its own deque and, once
+ * empty, steals from the top of the others (Chase-Lev). A task is only an
+ * index into the job range, so deques are two counters per participant
+ * and no memory is allocated per job or per task.
+ *
+ * Workers can be pinned to cores and given a SCHED_FIFO priority; both
+ * are best-effort (failures are counted, not fatal) so the pool also runs
+ * unprivileged on a dev host.
+ *
+ * One job runs at a time: concurrent callers are serialised, and a task
+ * must not call thread_pool_parallel_for() on the same pool.
+ */
+
+#ifndef DETECTOR_UTIL_THREAD_POOL_H
+#define DETECTOR_UTIL_THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Thread pool result codes
+ */
+typedef enum {
+    TP_OK = 0,                  /**< Success */
+    TP_ERROR_NULL = -1,         /**< NULL pointer argument */
+    TP_ERROR_PARAM = -2,        /**< Invalid parameter */
+    TP_ERROR_MEMORY = -3,       /**< Memory allocation failed */
+    TP_ERROR_THREAD = -4        /**< Worker thread creation failed */
+} tp_status_t;
+
+#define TP_MAX_THREADS          8       /* Participants including the caller */
+#define TP_DEFAULT_SPIN         4000    /* Idle polls before a worker sleeps */
+#define TP_TASKS_PER_THREAD     4       /* Default batching when grain is 0 */
+
+/**
+ * @brief Thread pool configuration
+ */
+typedef struct {
+    uint32_t threads;           /**< Participants incl. caller (0 = online CPUs) */
+    uint32_t cpu_mask;          /**< Worker w runs on the w-th set bit, cycled (0 = unpinned) */
+    int priority;               /**< Worker SCHED_FIFO priority (0 = inherit) */
+    uint32_t spin;              /**< Idle polls before sleeping (0 = default) */
+} tp_config_t;
+
+/**
+ * @brief Thread pool statistics
+ */
+typedef struct {
+    uint32_t threads;           /**< Participants incl. caller */
+    uint32_t pin_failures;      /**< Workers left unpinned or at default priority */
+    uint64_t jobs;              /**< parallel_for calls */
+    uint64_t tasks;             /**< Tasks run */
+    uint64_t steals;            /**< Tasks run by a participant other than their owner */
+} tp_stats_t;
+
+/**
+ * @brief Task function
+ *
+ * @param begin First item of the task
+ * @param end One past the last item
+ * @param worker Participant running the task (0 = caller), for per-worker scratch
+ * @param user_data Passed through from thread_pool_parallel_for()
+ */
+typedef void (*tp_task_fn_t)(uint32_t begin, uint32_t end, uint32_t worker, void *user_data);
+
+/**
+ * @brief Opaque thread pool handle
+ */
+typedef struct tp_pool tp_pool_t;
+
+/**
+ * @brief Create a pool and start its workers
+ *
+ * @param config Pool configuration
+ * @return Handle, or NULL on invalid configuration or thread/allocation failure
+ */
+tp_pool_t *thread_pool_create(const tp_config_t *config);
+
+/**
+ * @brief Stop workers and destroy the pool
+ *
+ * @param pool Handle (NULL is ignored)
+ */
+void thread_pool_destroy(tp_pool_t *pool);
+
+/**
+ * @brief Number of participants including the caller
+ *
+ * @param pool Handle
+ * @return Thread count, 0 if NULL
+ */
+uint32_t thread_pool_threads(const tp_pool_t *pool);
+
+/**
+ * @brief Run fn over [0, count) in tasks of grain items and wait for all
+ *
+ * @param pool Handle
+ * @param count Items (e.g. row bands)
+ * @param grain Items per task (0 = count / (threads * TP_TASKS_PER_THREAD))
+ * @param fn Task function
+ * @param user_data Passed to fn
+ * @return TP_OK when every task has run, error code otherwise
+ */
+tp_status_t thread_pool_parallel_for(tp_pool_t *pool, uint32_t count, uint32_t grain,
+                                     tp_task_fn_t fn, void *user_data);
+
+/**
+ * @brief Get statistics
+ *
+ * @param pool Handle
+ * @param stats Output statistics
+ */
+void thread_pool_get_stats(tp_pool_t *pool, tp_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_THREAD_POOL_H */
@@ -0,0 +1,216 @@
+/**
+ * @file trace.h
+ * @brief Binary tracepoints in per-CPU flight-recorder rings
+ *
+ * A tracepoint writes one fixed 32-byte record (monotonic timestamp,
+ * event ID, phase, thread ID, two arguments) into the ring of the CPU it
+ * runs on. Span end records carry the result code in arg1. Rings
+ * overwrite their oldest records, so a dump holds the last
+ * trace_init(records_per_cpu) events of every CPU.
+ *
+ * While recording is off, a tracepoint is one relaxed load and a branch
+ * (TRACE_BEGIN / TRACE_END / TRACE_INSTANT). trace_dump() writes the rings
+ * with the event and thread name tables in the TRACE_FILE_* format below;
+ * tools/trace_export converts a dump to Chrome trace JSON, which Perfetto
+ * and chrome://tracing open directly.
+ */
+
+#ifndef DETECTOR_UTIL_TRACE_H
+#define DETECTOR_UTIL_TRACE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Trace result codes
+ */
+typedef enum {
+    TRACE_OK = 0,               /**< Success */
+    TRACE_ERROR_NULL = -1,      /**< NULL pointer argument */
+    TRACE_ERROR_PARAM = -2,     /**< Invalid parameter */
+    TRACE_ERROR_MEMORY = -3,    /**< Ring allocation failed */
+    TRACE_ERROR_STATE = -4,     /**< Not initialized / already initialized */
+    TRACE_ERROR_IO = -5         /**< Dump file could not be written */
+} trace_status_t;
+
+/**
+ * @brief Tracepoints (IDs are stored in dumps; append only)
+ */
+typedef enum {
+    TRACE_FRAME_GET = 0,        /**< frame_mgr_get_buffer: frame, buffer */
+    TRACE_FRAME_COMMIT,         /**< frame_mgr_commit_buffer: frame, buffer */
+    TRACE_FRAME_READY,          /**< frame_mgr_get_ready_buffer: frame, buffer */
+    TRACE_FRAME_RELEASE,        /**< frame_mgr_release_buffer: frame, buffer */
+    TRACE_ETH_SEND,             /**< Span of one frame's packets: frame, flags */
+    TRACE_SPI_XFER,             /**< Span of one SPI transfer: register, write */
+    TRACE_SEQ_STATE,            /**< Sequence engine transition: from, to */
+    TRACE_CMD,                  /**< Span of one host command: command, sequence */
+    TRACE_EVENT_COUNT
+} trace_event_t;
+
+/**
+ * @brief Record phase (Chrome trace "ph" letters)
+ */
+typedef enum {
+    TRACE_PHASE_BEGIN = 'B',
+    TRACE_PHASE_END = 'E',
+    TRACE_PHASE_INSTANT = 'i'
+} trace_phase_t;
+
+#define TRACE_MAX_CPUS              64
+#define TRACE_MAX_THREADS           64      /* Named in a dump; later threads by ID only */
+#define TRACE_MAX_RECORDS           (1U << 20)
+#define TRACE_DEFAULT_RECORDS       8192    /* Per CPU */
+
+/* ==========================================================================
+ * Dump File Format
+ * ========================================================================== */
+
+#define TRACE_FILE_MAGIC            0x43525444u     /* "DTRC" */
+#define TRACE_FILE_VERSION          1
+
+/**
+ * @brief Dump file header, followed by event_count trace_file_event_t,
+ *        thread_count trace_file_thread_t and record_count trace_record_t
+ */
+typedef struct {
+    uint32_t magic;             /**< TRACE_FILE_MAGIC */
+    uint16_t version;           /**< TRACE_FILE_VERSION */
+    uint16_t record_size;       /**< sizeof(trace_record_t) */
+    uint32_t event_count;
+    uint32_t thread_count;
+    uint64_t record_count;
+    uint64_t overwritten;       /**< Records lost to ring wrap before the dump */
+} trace_file_header_t;
+
+/**
+ * @brief Event name and argument labels
+ */
+typedef struct {
+    char name[24];
+    char arg0[20];
+    char arg1[20];
+} trace_file_event_t;
+
+/**
+ * @brief Thread name
+ */
+typedef struct {
+    uint32_t tid;
+    char name[28];
+} trace_file_thread_t;
+
+/**
+ * @brief One tracepoint hit
+ */
+typedef struct {
+    uint64_t time_ns;           /**< CLOCK_MONOTONIC */
+    uint64_t arg0;
+    uint32_t seq;               /**< Ring slot sequence (torn-write check) */
+    uint32_t arg1;
+    uint32_t tid;
+    uint16_t event;             /**< trace_event_t */
+    uint8_t phase;              /**< trace_phase_t */
+    uint8_t cpu;
+} trace_record_t;
+
+/**
+ * @brief Trace counters
+ */
+typedef struct {
+    uint64_t recorded;          /**< Records written since trace_start() */
+    uint64_t overwritten;       /**< Records already overwritten by newer ones */
+    uint32_t cpus;              /**< Rings */
+    uint32_t threads;           /**< Threads named so far */
+} trace_stats_t;
+
+/* ==========================================================================
+ * API
+ * ========================================================================== */
+
+/* Recording switch, read by every tracepoint */
+extern atomic_bool g_trace_enabled;
+
+#define TRACE_RECORD(event, phase, arg0, arg1)                                  \
+    do {                                                                        \
+        if (atomic_load_explicit(&g_trace_enabled, memory_order_relaxed)) {     \
+            trace_record((event), (phase), (uint64_t)(arg0), (uint32_t)(arg1)); \
+        }                                                                       \
+    } while (0)
+
+#define TRACE_BEGIN(event, arg0, arg1)      TRACE_RECORD((event), TRACE_PHASE_BEGIN, (arg0), (arg1))
+#define TRACE_END(event, arg0, arg1)        TRACE_RECORD((event), TRACE_PHASE_END, (arg0), (arg1))
+#define TRACE_INSTANT(event, arg0, arg1)    TRACE_RECORD((event), TRACE_PHASE_INSTANT, (arg0), (arg1))
+
+/**
+ * @brief Allocate one ring per configured CPU (recording stays off)
+ *
+ * @param records_per_cpu Ring size (0 = default, rounded up to 2^n)
+ * @return TRACE_OK on success, error code on failure
+ */
+trace_status_t trace_init(uint32_t records_per_cpu);
+
+/**
+ * @brief Stop recording and free the rings
+ */
+void trace_deinit(void);
+
+/**
+ * @brief Empty the rings and start recording
+ *
+ * @return TRACE_OK on success, TRACE_ERROR_STATE if not initialized
+ */
+trace_status_t trace_start(void);
+
+/**
+ * @brief Stop recording (the rings keep their contents for trace_dump())
+ */
+void trace_stop(void);
+
+/**
+ * @brief Whether tracepoints are recording
+ */
+bool trace_active(void);
+
+/**
+ * @brief Write one record (use the TRACE_* macros)
+ */
+void trace_record(trace_event_t event, trace_phase_t phase, uint64_t arg0, uint32_t arg1);
+
+/**
+ * @brief Write the rings to a dump file
+ *
+ * Records still being written, or overwritten while the dump reads, are
+ * left out. Best done after trace_stop().
+ *
+ * @param path Output file
+ * @return TRACE_OK on success, error code on failure
+ */
+trace_status_t trace_dump(const char *path);
+
+/**
+ * @brief Get counters
+ *
+ * @param stats Output counters
+ * @return TRACE_OK on success, error code on failure
+ */
+trace_status_t trace_get_stats(trace_stats_t *stats);
+
+/**
+ * @brief Name of a tracepoint (e.g. "frame_get")
+ *
+ * @param event Tracepoint
+ * @return Name, or "unknown"
+ */
+const char *trace_event_name(trace_event_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DETECTOR_UTIL_TRACE_H */
@@ -10,12 +10,17 @@
  * - REFACTOR: Code improvements while maintaining tests
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "config/config_loader.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <stdarg.h>
+#include <arpa/inet.h>
 #include <yaml.h>
 
 /* External mock YAML support for testing */
@@ -69,6 +74,46 @@ static config_status_t parse_int(yaml_node_t *node, int *value) {
     return CONFIG_OK;
 }
 
+/**
+ * @brief Parse floating-point value from YAML node
+ */
+static config_status_t parse_float(yaml_node_t *node, float *value) {
+    const char *str;
+    if (parse_scalar(node, &str) != CONFIG_OK) {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    char *endptr;
+    float val = strtof(str, &endptr);
+    if (endptr == str || *endptr != '\0') {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    *value = val;
+    return CONFIG_OK;
+}
+
+/**
+ * @brief Parse boolean value from YAML node (true/false, yes/no, on/off, 1/0)
+ */
+static config_status_t parse_bool(yaml_node_t *node, bool *value) {
+    const char *str;
+    if (parse_scalar(node, &str) != CONFIG_OK) {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    if (strcmp(str, "true") == 0 || strcmp(str, "yes") == 0 ||
+        strcmp(str, "on") == 0 || strcmp(str, "1") == 0) {
+        *value = true;
+    } else if (strcmp(str, "false") == 0 || strcmp(str, "no") == 0 ||
+               strcmp(str, "off") == 0 || strcmp(str, "0") == 0) {
+        *value = false;
+    } else {
+        return CONFIG_ERROR_PARSE;
+    }
+    return CONFIG_OK;
+}
+
 /**
  * @brief Parse string value into config field
  */
@@ -118,6 +163,263 @@ static config_status_t parse_log_level(const char *str, uint8_t *level) {
     return CONFIG_OK;
 }
 
+/**
+ * @brief Parse overflow action string
+ */
+static config_status_t parse_overflow_action(const char *str, uint8_t *action) {
+    if (strcmp(str, "stop") == 0 || strcmp(str, "Stop") == 0) {
+        *action = 0;
+    } else if (strcmp(str, "backoff") == 0 || strcmp(str, "Backoff") == 0) {
+        *action = 1;
+    } else if (strcmp(str, "none") == 0 || strcmp(str, "None") == 0) {
+        *action = 2;
+    } else {
+        return CONFIG_ERROR_PARSE;
+    }
+    return CONFIG_OK;
+}
+
+/**
+ * @brief Parse panel orientation string (index matches orient_t)
+ */
+static config_status_t parse_orientation(const char *str, uint8_t *orientation) {
+    static const char *const names[] = {
+        "none", "flip_h", "flip_v", "rot90", "rot180", "rot270", "transpose", "transverse"
+    };
+
+    for (uint8_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(str, names[i]) == 0) {
+            *orientation = i;
+            return CONFIG_OK;
+        }
+    }
+    return CONFIG_ERROR_PARSE;
+}
+
+/**
+ * @brief Parse display conversion method string
+ */
+static config_status_t parse_display_method(const char *str, uint8_t *method) {
+    if (strcmp(str, "auto") == 0) {
+        *method = 0;
+    } else if (strcmp(str, "lut") == 0) {
+        *method = 1;
+    } else if (strcmp(str, "arith") == 0) {
+        *method = 2;
+    } else {
+        return CONFIG_ERROR_PARSE;
+    }
+    return CONFIG_OK;
+}
+
+/**
+ * @brief Parse exposure gate action string
+ */
+static config_status_t parse_gate_action(const char *str, uint8_t *action) {
+    static const char *const names[] = { "off", "tag", "decimate", "drop" };
+
+    for (uint8_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(str, names[i]) == 0) {
+            *action = i;
+            return CONFIG_OK;
+        }
+    }
+    return CONFIG_ERROR_PARSE;
+}
+
+/**
+ * @brief Parse the network.outputs list of { host_ip, port, format } maps
+ *
+ * @return CONFIG_OK, or CONFIG_ERROR_PARSE if the node is not a sequence of
+ *         at most CONFIG_MAX_OUTPUTS mappings with a known format
+ */
+static config_status_t parse_output_list(yaml_document_t *document, yaml_node_t *node,
+                                         detector_config_t *config) {
+    if (node->type != YAML_SEQUENCE_NODE) {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    yaml_node_item_t *item = node->data.sequence.items.start;
+    yaml_node_item_t *item_end = node->data.sequence.items.top;
+    uint8_t n = 0;
+
+    for (; item < item_end; item++) {
+        yaml_node_t *entry = yaml_document_get_node(document, *item);
+        if (entry == NULL || entry->type != YAML_MAPPING_NODE || n >= CONFIG_MAX_OUTPUTS) {
+            return CONFIG_ERROR_PARSE;
+        }
+
+        config_output_t *out = &config->outputs[n++];
+        memset(out, 0, sizeof(*out));
+
+        yaml_node_pair_t *pair = entry->data.mapping.pairs.start;
+        yaml_node_pair_t *pair_end = entry->data.mapping.pairs.top;
+
+        for (; pair < pair_end; pair++) {
+            const char *field;
+            const char *value_str;
+            int value;
+
+            if (parse_scalar(yaml_document_get_node(document, pair->key), &field) != CONFIG_OK) {
+                continue;
+            }
+            yaml_node_t *value_node = yaml_document_get_node(document, pair->value);
+
+            if (strcmp(field, "host_ip") == 0) {
+                if (parse_string(value_node, out->host_ip, sizeof(out->host_ip)) != CONFIG_OK) {
+                    return CONFIG_ERROR_PARSE;
+                }
+            } else if (strcmp(field, "port") == 0) {
+                if (parse_int(value_node, &value) != CONFIG_OK ||
+                    value < CONFIG_MIN_PORT || value > CONFIG_MAX_PORT) {
+                    return CONFIG_ERROR_PARSE;
+                }
+                out->port = (uint16_t)value;
+            } else if (strcmp(field, "format") == 0) {
+                if (parse_scalar(value_node, &value_str) != CONFIG_OK) {
+                    return CONFIG_ERROR_PARSE;
+                }
+                if (strcmp(value_str, "raw16") == 0) {
+                    out->format = CONFIG_OUTPUT_RAW16;
+                } else if (strcmp(value_str, "display8") == 0) {
+                    out->format = CONFIG_OUTPUT_DISPLAY8;
+                } else {
+                    return CONFIG_ERROR_PARSE;
+                }
+            }
+        }
+
+        if (out->host_ip[0] == '\0' || out->port == 0) {
+            return CONFIG_ERROR_PARSE;
+        }
+    }
+
+    config->output_count = n;
+    return CONFIG_OK;
+}
+
+/**
+ * @brief Parse the qa.rois list of { x, y, width, height } maps
+ *
+ * Bounds against the panel are checked by config_validate().
+ *
+ * @return CONFIG_OK, or CONFIG_ERROR_PARSE if the node is not a sequence of
+ *         at most CONFIG_MAX_QA_ROIS mappings with four non-negative fields
+ */
+static config_status_t parse_roi_list(yaml_document_t *document, yaml_node_t *node,
+                                      detector_config_t *config) {
+    if (node->type != YAML_SEQUENCE_NODE) {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    yaml_node_item_t *item = node->data.sequence.items.start;
+    yaml_node_item_t *item_end = node->data.sequence.items.top;
+    uint8_t n = 0;
+
+    for (; item < item_end; item++) {
+        yaml_node_t *entry = yaml_document_get_node(document, *item);
+        if (entry == NULL || entry->type != YAML_MAPPING_NODE || n >= CONFIG_MAX_QA_ROIS) {
+            return CONFIG_ERROR_PARSE;
+        }
+
+        config_roi_t *roi = &config->qa_rois[n++];
+        uint16_t *const fields[4] = { &roi->x, &roi->y, &roi->width, &roi->height };
+        static const char *const names[4] = { "x", "y", "width", "height" };
+        uint8_t seen = 0;
+
+        yaml_node_pair_t *pair = entry->data.mapping.pairs.start;
+        yaml_node_pair_t *pair_end = entry->data.mapping.pairs.top;
+
+        for (; pair < pair_end; pair++) {
+            const char *field;
+            int value;
+
+            if (parse_scalar(yaml_document_get_node(document, pair->key), &field) != CONFIG_OK) {
+                continue;
+            }
+
+            for (int f = 0; f < 4; f++) {
+                if (strcmp(field, names[f]) != 0) {
+                    continue;
+                }
+                if (parse_int(yaml_document_get_node(document, pair->value), &value) != CONFIG_OK ||
+                    value < 0 || value > 0xFFFF) {
+                    return CONFIG_ERROR_PARSE;
+                }
+                *fields[f] = (uint16_t)value;
+                seen |= (uint8_t)(1U << f);
+            }
+        }
+
+        if (seen != 0x0F) {
+            return CONFIG_ERROR_PARSE;
+        }
+    }
+
+    config->qa_roi_count = n;
+    return CONFIG_OK;
+}
+
+/**
+ * @brief Parse one scan mode's stage list
+ *
+ * A chain that is not a sequence of names, has too many stages or a name
+ * that does not fit is marked CONFIG_PIPELINE_INVALID for config_validate().
+ */
+static void parse_pipeline_chain(yaml_document_t *document, yaml_node_t *node,
+                                 detector_config_t *config, uint8_t mode) {
+    config->pipeline_stages[mode] = CONFIG_PIPELINE_INVALID;
+
+    if (node->type != YAML_SEQUENCE_NODE) {
+        return;
+    }
+
+    yaml_node_item_t *item = node->data.sequence.items.start;
+    yaml_node_item_t *item_end = node->data.sequence.items.top;
+    uint8_t count = 0;
+
+    for (; item < item_end; item++) {
+        const char *name;
+        if (parse_scalar(yaml_document_get_node(document, *item), &name) != CONFIG_OK ||
+            count >= CONFIG_MAX_PIPELINE_STAGES ||
+            name[0] == '\0' || strlen(name) >= CONFIG_STAGE_NAME_LEN) {
+            return;
+        }
+        strcpy(config->pipeline[mode][count++], name);
+    }
+
+    config->pipeline_stages[mode] = count;
+}
+
+/**
+ * @brief Parse a list of ROIC block indices
+ *
+ * @return CONFIG_OK, or CONFIG_ERROR_PARSE if the node is not a sequence of
+ *         at most CONFIG_MAX_READOUT_BLOCKS indices below that limit
+ */
+static config_status_t parse_block_list(yaml_document_t *document, yaml_node_t *node,
+                                        uint8_t *blocks, uint8_t *count) {
+    if (node->type != YAML_SEQUENCE_NODE) {
+        return CONFIG_ERROR_PARSE;
+    }
+
+    yaml_node_item_t *item = node->data.sequence.items.start;
+    yaml_node_item_t *item_end = node->data.sequence.items.top;
+    uint8_t n = 0;
+
+    for (; item < item_end; item++) {
+        int value;
+        if (parse_int(yaml_document_get_node(document, *item), &value) != CONFIG_OK ||
+            value < 0 || value >= CONFIG_MAX_READOUT_BLOCKS || n >= CONFIG_MAX_READOUT_BLOCKS) {
+            return CONFIG_ERROR_PARSE;
+        }
+        blocks[n++] = (uint8_t)value;
+    }
+
+    *count = n;
+    return CONFIG_OK;
+}
+
 /* ==========================================================================
  * Public API Implementation
  * ========================================================================== */
@@ -222,6 +524,11 @@ config_status_t config_load(const char *filename, detector_config_t *config) {
                     parse_int(field_value, (int *)&config->cols);
                 } else if (strcmp(field, "bit_depth") == 0) {
                     parse_int(field_value, (int *)&config->bit_depth);
+                } else if (strcmp(field, "orientation") == 0) {
+                    if (parse_orientation((const char *)field_value->data.scalar.value,
+                                          &config->orientation) != CONFIG_OK) {
+                        config->orientation = CONFIG_ORIENTATION_INVALID;
+                    }
                 }
             }
         }
@@ -307,13 +614,22 @@ config_status_t config_load(const char *filename, detector_config_t *config) {
                 yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
 
                 if (field_key == NULL || field_value == NULL ||
-                    field_key->type != YAML_SCALAR_NODE ||
-                    field_value->type != YAML_SCALAR_NODE) {
+                    field_key->type != YAML_SCALAR_NODE) {
                     continue;
                 }
 
                 const char *field = (const char *)field_key->data.scalar.value;
 
+                if (strcmp(field, "outputs") == 0) {
+                    if (parse_output_list(&document, field_value, config) != CONFIG_OK) {
+                        config->output_count = CONFIG_OUTPUT_INVALID;
+                    }
+                    continue;
+                }
+                if (field_value->type != YAML_SCALAR_NODE) {
+                    continue;
+                }
+
                 if (strcmp(field, "host_ip") == 0) {
                     parse_string(field_value, config->host_ip, sizeof(config->host_ip));
                 } else if (strcmp(field, "data_port") == 0) {
@@ -375,6 +691,429 @@ config_status_t config_load(const char *filename, detector_config_t *config) {
                 }
             }
         }
+        /* Parse protection section */
+        else if (strcmp(section, "protection") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+
+                if (field_key == NULL || field_value == NULL ||
+                    field_key->type != YAML_SCALAR_NODE ||
+                    field_value->type != YAML_SCALAR_NODE) {
+                    continue;
+                }
+
+                const char *field = (const char *)field_key->data.scalar.value;
+                int value;
+
+                if (strcmp(field, "overexposure_threshold") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->overexposure_threshold = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "overflow_action") == 0) {
+                    const char *action_str;
+                    if (parse_scalar(field_value, &action_str) == CONFIG_OK) {
+                        parse_overflow_action(action_str, &config->overflow_action);
+                    }
+                }
+            }
+        }
+        /* Parse pipeline section: scan mode -> list of stage names */
+        else if (strcmp(section, "pipeline") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *mode_str;
+                uint8_t mode;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &mode_str) != CONFIG_OK) {
+                    continue;
+                }
+
+                const char *value_str;
+                int value;
+
+                if (strcmp(mode_str, "execution") == 0) {
+                    if (parse_scalar(field_value, &value_str) == CONFIG_OK) {
+                        config->pipeline_fused = (strcmp(value_str, "fused") == 0);
+                    }
+                } else if (strcmp(mode_str, "band_rows") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->pipeline_band_rows = (uint16_t)value;
+                    }
+                } else if (parse_scan_mode(mode_str, &mode) == CONFIG_OK) {
+                    parse_pipeline_chain(&document, field_value, config, mode);
+                }
+            }
+        }
+        /* Parse display section: 8-bit conversion for display8 outputs */
+        else if (strcmp(section, "display") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                const char *value_str;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "window") == 0) {
+                    if (parse_scalar(field_value, &value_str) == CONFIG_OK) {
+                        config->display_auto_window = (strcmp(value_str, "auto") == 0);
+                    }
+                } else if (strcmp(field, "window_low") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->display_window_low = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "window_high") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->display_window_high = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "low_percentile") == 0) {
+                    parse_float(field_value, &config->display_low_percentile);
+                } else if (strcmp(field, "high_percentile") == 0) {
+                    parse_float(field_value, &config->display_high_percentile);
+                } else if (strcmp(field, "gamma") == 0) {
+                    if (parse_float(field_value, &config->display_gamma) != CONFIG_OK) {
+                        config->display_gamma = -1.0f;
+                    }
+                } else if (strcmp(field, "method") == 0) {
+                    if (parse_scalar(field_value, &value_str) != CONFIG_OK ||
+                        parse_display_method(value_str, &config->display_method) != CONFIG_OK) {
+                        config->display_method = 0xFF;
+                    }
+                }
+            }
+        }
+        /* Parse drift section: background per-pixel dark statistics */
+        else if (strcmp(section, "drift") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "enabled") == 0) {
+                    parse_bool(field_value, &config->drift_enabled);
+                } else if (strcmp(field, "pixels_per_frame") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK && value >= 0) {
+                        config->drift_pixels_per_frame = (uint32_t)value;
+                    }
+                } else if (strcmp(field, "weight_shift") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_DRIFT_WEIGHT_SHIFT) {
+                        config->drift_weight_shift = (uint8_t)value;
+                    } else {
+                        config->drift_weight_shift = CONFIG_DRIFT_INVALID;
+                    }
+                } else if (strcmp(field, "offset_threshold") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->drift_offset_threshold = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "noise_threshold") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->drift_noise_threshold = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "dark_level") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->drift_dark_level = (uint16_t)value;
+                    }
+                }
+            }
+        }
+        /* Parse qa section: per-frame image quality metrics */
+        else if (strcmp(section, "qa") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "enabled") == 0) {
+                    parse_bool(field_value, &config->qa_enabled);
+                } else if (strcmp(field, "row_step") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_QA_ROW_STEP) {
+                        config->qa_row_step = (uint8_t)value;
+                    } else {
+                        config->qa_row_step = CONFIG_QA_INVALID;
+                    }
+                } else if (strcmp(field, "rois") == 0) {
+                    if (parse_roi_list(&document, field_value, config) != CONFIG_OK) {
+                        config->qa_roi_count = CONFIG_QA_INVALID;
+                    }
+                }
+            }
+        }
+        /* Parse hdr section: alternating gains fused pair by pair */
+        else if (strcmp(section, "hdr") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "enabled") == 0) {
+                    parse_bool(field_value, &config->hdr_enabled);
+                } else if (strcmp(field, "low_gain") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->hdr_low_gain = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "high_gain") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->hdr_high_gain = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "threshold") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->hdr_threshold = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "blend") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->hdr_blend = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "output_shift") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_HDR_SHIFT) {
+                        config->hdr_output_shift = (uint8_t)value;
+                    } else {
+                        config->hdr_output_shift = CONFIG_HDR_INVALID;
+                    }
+                }
+            }
+        }
+        /* Parse gate section: handling of frames without X-ray signal */
+        else if (strcmp(section, "gate") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                const char *value_str;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "action") == 0) {
+                    if (parse_scalar(field_value, &value_str) != CONFIG_OK ||
+                        parse_gate_action(value_str, &config->gate_action) != CONFIG_OK) {
+                        config->gate_action = CONFIG_GATE_INVALID;
+                    }
+                } else if (strcmp(field, "dark_level") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->gate_dark_level = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "mean_margin") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->gate_mean_margin = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "max_margin") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->gate_max_margin = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "row_step") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_GATE_ROW_STEP) {
+                        config->gate_row_step = (uint8_t)value;
+                    } else {
+                        config->gate_row_step = CONFIG_GATE_INVALID;
+                    }
+                } else if (strcmp(field, "hold_frames") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->gate_hold_frames = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "decimate") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_GATE_DECIMATE && value != 1) {
+                        config->gate_decimate = (uint8_t)value;
+                    } else {
+                        config->gate_decimate = CONFIG_GATE_INVALID;
+                    }
+                }
+            }
+        }
+        /* Parse readout section: ROIC block layout and dual-side lines */
+        else if (strcmp(section, "readout") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                uint8_t blocks[CONFIG_MAX_READOUT_BLOCKS];
+                uint8_t count;
+                int value;
+
+                if (strcmp(field, "block_cols") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_COLS) {
+                        config->readout_block_cols = (uint16_t)value;
+                    }
+                } else if (strcmp(field, "block_order") == 0) {
+                    if (parse_block_list(&document, field_value,
+                                         config->readout_block_order, &count) == CONFIG_OK) {
+                        config->readout_block_count = count;
+                    } else {
+                        config->readout_block_count = CONFIG_READOUT_INVALID;
+                    }
+                } else if (strcmp(field, "mirrored_blocks") == 0) {
+                    if (parse_block_list(&document, field_value, blocks, &count) == CONFIG_OK) {
+                        config->readout_mirrored_blocks = 0;
+                        for (uint8_t i = 0; i < count; i++) {
+                            config->readout_mirrored_blocks |= 1U << blocks[i];
+                        }
+                    } else {
+                        config->readout_block_count = CONFIG_READOUT_INVALID;
+                    }
+                } else if (strcmp(field, "dual_side") == 0) {
+                    parse_bool(field_value, &config->readout_dual_side);
+                } else if (strcmp(field, "bottom_flipped") == 0) {
+                    parse_bool(field_value, &config->readout_bottom_flipped);
+                } else if (strcmp(field, "bottom_mirrored") == 0) {
+                    parse_bool(field_value, &config->readout_bottom_mirrored);
+                }
+            }
+        }
+        /* Parse metrics section: OpenMetrics HTTP endpoint */
+        else if (strcmp(section, "metrics") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                const char *value_str;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "port") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= CONFIG_MAX_PORT) {
+                        config->metrics_port = (uint16_t)value;
+                    } else {
+                        config->metrics_port = CONFIG_METRICS_PORT_INVALID;
+                    }
+                } else if (strcmp(field, "listen") == 0) {
+                    /* Too long for an IPv4 address: keep it invalid, not truncated */
+                    if (parse_scalar(field_value, &value_str) == CONFIG_OK &&
+                        strlen(value_str) < sizeof(config->metrics_listen)) {
+                        strcpy(config->metrics_listen, value_str);
+                    } else {
+                        strcpy(config->metrics_listen, "?");
+                    }
+                } else if (strcmp(field, "page_ms") == 0) {
+                    if (parse_int(field_value, &value) == CONFIG_OK &&
+                        value >= 0 && value <= 0xFFFF) {
+                        config->metrics_page_ms = (uint16_t)value;
+                    } else {
+                        config->metrics_page_ms = CONFIG_MAX_METRICS_PAGE_MS + 1;
+                    }
+                }
+            }
+        }
+        /* Parse status section: GET_STATUS collector refresh periods */
+        else if (strcmp(section, "status") == 0) {
+            yaml_node_pair_t *item = value_node->data.mapping.pairs.start;
+            yaml_node_pair_t *item_end = value_node->data.mapping.pairs.top;
+
+            for (; item < item_end; item++) {
+                yaml_node_t *field_key = yaml_document_get_node(&document, item->key);
+                yaml_node_t *field_value = yaml_document_get_node(&document, item->value);
+                const char *field;
+                uint16_t *period;
+                int value;
+
+                if (field_key == NULL || field_value == NULL ||
+                    parse_scalar(field_key, &field) != CONFIG_OK) {
+                    continue;
+                }
+
+                if (strcmp(field, "state_ms") == 0) {
+                    period = &config->status_state_ms;
+                } else if (strcmp(field, "battery_ms") == 0) {
+                    period = &config->status_battery_ms;
+                } else if (strcmp(field, "temp_ms") == 0) {
+                    period = &config->status_temp_ms;
+                } else {
+                    continue;
+                }
+
+                if (parse_int(field_value, &value) == CONFIG_OK &&
+                    value >= 0 && value <= CONFIG_MAX_STATUS_PERIOD_MS) {
+                    *period = (uint16_t)value;
+                } else {
+                    *period = CONFIG_MAX_STATUS_PERIOD_MS + 1;
+                }
+            }
+        }
     }
 
     /* Cleanup */
@@ -412,6 +1151,12 @@ config_status_t config_validate(const detector_config_t *config) {
         return CONFIG_ERROR_VALIDATE;
     }
 
+    if (config->orientation > CONFIG_MAX_ORIENTATION) {
+        config_set_error("panel orientation invalid (none, flip_h, flip_v, rot90, rot180, "
+                        "rot270, transpose or transverse)");
+        return CONFIG_ERROR_VALIDATE;
+    }
+
     /* Validate frame rate (REQ-FW-130) */
     if (config->frame_rate < CONFIG_MIN_FRAME_RATE ||
         config->frame_rate > CONFIG_MAX_FRAME_RATE) {
@@ -457,6 +1202,223 @@ config_status_t config_validate(const detector_config_t *config) {
         return CONFIG_ERROR_VALIDATE;
     }
 
+    /* Validate protection action */
+    if (config->overflow_action > CONFIG_MAX_OVERFLOW_ACTION) {
+        config_set_error("overflow_action invalid: %u (valid: 0-%d)",
+                        config->overflow_action, CONFIG_MAX_OVERFLOW_ACTION);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->pipeline_band_rows > CONFIG_MAX_ROWS) {
+        config_set_error("pipeline band_rows out of range: %u (valid: 0-%d)",
+                        config->pipeline_band_rows, CONFIG_MAX_ROWS);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    /* Validate pipeline chains */
+    for (int mode = 0; mode < CONFIG_PIPELINE_MODES; mode++) {
+        if (config->pipeline_stages[mode] > CONFIG_MAX_PIPELINE_STAGES) {
+            config_set_error("pipeline for scan mode %d invalid (1-%d stage names, "
+                            "each up to %d characters)",
+                            mode, CONFIG_MAX_PIPELINE_STAGES, CONFIG_STAGE_NAME_LEN - 1);
+            return CONFIG_ERROR_VALIDATE;
+        }
+    }
+
+    /* Validate additional outputs and their display conversion */
+    if (config->output_count == CONFIG_OUTPUT_INVALID) {
+        config_set_error("network outputs invalid (up to %d entries of host_ip, port %d-%d "
+                        "and format raw16 or display8)",
+                        CONFIG_MAX_OUTPUTS, CONFIG_MIN_PORT, CONFIG_MAX_PORT);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->display_gamma != 0.0f &&
+        (config->display_gamma < CONFIG_MIN_DISPLAY_GAMMA ||
+         config->display_gamma > CONFIG_MAX_DISPLAY_GAMMA)) {
+        config_set_error("display gamma out of range (valid: %.1f-%.1f)",
+                        CONFIG_MIN_DISPLAY_GAMMA, CONFIG_MAX_DISPLAY_GAMMA);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->display_method > CONFIG_MAX_DISPLAY_METHOD) {
+        config_set_error("display method invalid (valid: auto, lut or arith)");
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->display_window_high != 0 &&
+        config->display_window_high <= config->display_window_low) {
+        config_set_error("display window_high %u must exceed window_low %u",
+                        config->display_window_high, config->display_window_low);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    float low_pct = config->display_low_percentile;
+    float high_pct = (config->display_high_percentile != 0.0f) ?
+                     config->display_high_percentile : 100.0f;
+    if (low_pct < 0.0f || high_pct > 100.0f || low_pct >= high_pct) {
+        config_set_error("display percentiles invalid (0 <= low < high <= 100)");
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    /* Validate drift tracking */
+    if (config->drift_weight_shift > CONFIG_MAX_DRIFT_WEIGHT_SHIFT) {
+        config_set_error("drift weight_shift invalid (valid: 0-%d)",
+                        CONFIG_MAX_DRIFT_WEIGHT_SHIFT);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->drift_noise_threshold > CONFIG_MAX_DRIFT_NOISE) {
+        config_set_error("drift noise_threshold %u out of range (valid: 0-%d)",
+                        config->drift_noise_threshold, CONFIG_MAX_DRIFT_NOISE);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    /* Validate QA sampling and regions against the panel geometry */
+    if (config->qa_row_step > CONFIG_MAX_QA_ROW_STEP) {
+        config_set_error("qa row_step invalid (valid: 0-%d)", CONFIG_MAX_QA_ROW_STEP);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->qa_roi_count == CONFIG_QA_INVALID) {
+        config_set_error("qa rois invalid (up to %d entries of x, y, width, height)",
+                        CONFIG_MAX_QA_ROIS);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    for (uint8_t i = 0; i < config->qa_roi_count; i++) {
+        const config_roi_t *roi = &config->qa_rois[i];
+        if (roi->width == 0 || roi->height == 0 ||
+            (uint32_t)roi->x + roi->width > config->cols ||
+            (uint32_t)roi->y + roi->height > config->rows) {
+            config_set_error("qa roi %u (%u,%u %ux%u) outside the %ux%u panel",
+                            i, roi->x, roi->y, roi->width, roi->height,
+                            config->cols, config->rows);
+            return CONFIG_ERROR_VALIDATE;
+        }
+    }
+
+    /* Validate HDR gains and blend (threshold defaults to 90% of full scale) */
+    if (config->hdr_output_shift > CONFIG_MAX_HDR_SHIFT) {
+        config_set_error("hdr output_shift invalid (valid: 0-%d)", CONFIG_MAX_HDR_SHIFT);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->hdr_enabled) {
+        uint32_t low_gain = (config->hdr_low_gain != 0) ? config->hdr_low_gain
+                                                        : CONFIG_DEFAULT_HDR_LOW_GAIN;
+        uint32_t threshold = (config->hdr_threshold != 0) ? config->hdr_threshold
+                             : ((1U << config->bit_depth) - 1U) * 9U / 10U;
+
+        if (config->hdr_high_gain <= low_gain ||
+            config->hdr_high_gain > low_gain * CONFIG_MAX_HDR_RATIO) {
+            config_set_error("hdr high_gain %u must exceed low_gain %u by at most %dx",
+                            config->hdr_high_gain, low_gain, CONFIG_MAX_HDR_RATIO);
+            return CONFIG_ERROR_VALIDATE;
+        }
+
+        if (config->hdr_blend >= threshold) {
+            config_set_error("hdr blend %u must be below the threshold %u",
+                            config->hdr_blend, threshold);
+            return CONFIG_ERROR_VALIDATE;
+        }
+    }
+
+    /* Validate exposure gate (limits must stay below full scale) */
+    if (config->gate_action > CONFIG_MAX_GATE_ACTION) {
+        config_set_error("gate action invalid (valid: off, tag, decimate, drop)");
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->gate_row_step > CONFIG_MAX_GATE_ROW_STEP ||
+        config->gate_decimate > CONFIG_MAX_GATE_DECIMATE) {
+        config_set_error("gate row_step (0-%d) or decimate (0, 2-%d) invalid",
+                        CONFIG_MAX_GATE_ROW_STEP, CONFIG_MAX_GATE_DECIMATE);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->gate_action != 0) {
+        uint32_t full_scale = (1U << config->bit_depth) - 1U;
+        uint32_t margin = (config->gate_mean_margin > config->gate_max_margin) ?
+                          config->gate_mean_margin : config->gate_max_margin;
+
+        if ((uint32_t)config->gate_dark_level + margin >= full_scale) {
+            config_set_error("gate dark_level %u plus margin %u must be below %u",
+                            config->gate_dark_level, margin, full_scale);
+            return CONFIG_ERROR_VALIDATE;
+        }
+    }
+
+    /* Validate readout map against the panel geometry */
+    if (config->readout_block_count == CONFIG_READOUT_INVALID) {
+        config_set_error("readout block lists invalid (up to %d indices, each 0-%d)",
+                        CONFIG_MAX_READOUT_BLOCKS, CONFIG_MAX_READOUT_BLOCKS - 1);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    uint32_t block_cols = (config->readout_block_cols != 0) ? config->readout_block_cols
+                                                            : config->cols;
+    uint32_t blocks = config->cols / block_cols;
+    if (config->cols % block_cols != 0 || blocks > CONFIG_MAX_READOUT_BLOCKS) {
+        config_set_error("readout block_cols %u does not split %u columns into 1-%d blocks",
+                        config->readout_block_cols, config->cols, CONFIG_MAX_READOUT_BLOCKS);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->readout_block_count != 0) {
+        uint32_t seen = 0;
+        for (uint32_t b = 0; b < config->readout_block_count; b++) {
+            seen |= 1U << config->readout_block_order[b];
+        }
+        if (config->readout_block_count != blocks ||
+            seen != ((blocks < 32) ? (1U << blocks) - 1 : UINT32_MAX)) {
+            config_set_error("readout block_order must list each of the %u blocks once",
+                            blocks);
+            return CONFIG_ERROR_VALIDATE;
+        }
+    }
+
+    if (blocks < 32 && (config->readout_mirrored_blocks >> blocks) != 0) {
+        config_set_error("readout mirrored_blocks names a block beyond %u", blocks - 1);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->readout_dual_side ? (config->rows % 2) != 0 :
+        (config->readout_bottom_flipped || config->readout_bottom_mirrored)) {
+        config_set_error("readout bottom options need dual_side and an even row count");
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    /* Validate metrics endpoint */
+    if (config->metrics_port != 0 && config->metrics_port < CONFIG_MIN_PORT) {
+        config_set_error("metrics port out of range: %u (valid: 0 or %d-%d)",
+                        config->metrics_port, CONFIG_MIN_PORT, CONFIG_MAX_PORT);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    if (config->metrics_page_ms > CONFIG_MAX_METRICS_PAGE_MS) {
+        config_set_error("metrics page_ms out of range: %u (valid: 0-%d)",
+                        config->metrics_page_ms, CONFIG_MAX_METRICS_PAGE_MS);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    struct in_addr listen_addr;
+    if (config->metrics_listen[0] != '\0' &&
+        inet_pton(AF_INET, config->metrics_listen, &listen_addr) != 1) {
+        config_set_error("metrics listen is not an IPv4 address: %s", config->metrics_listen);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
+    /* Validate status collector periods */
+    if (config->status_state_ms > CONFIG_MAX_STATUS_PERIOD_MS ||
+        config->status_battery_ms > CONFIG_MAX_STATUS_PERIOD_MS ||
+        config->status_temp_ms > CONFIG_MAX_STATUS_PERIOD_MS) {
+        config_set_error("status period out of range: state_ms %u, battery_ms %u, temp_ms %u "
+                        "(valid: 0-%d)", config->status_state_ms, config->status_battery_ms,
+                        config->status_temp_ms, CONFIG_MAX_STATUS_PERIOD_MS);
+        return CONFIG_ERROR_VALIDATE;
+    }
+
     return CONFIG_OK;
 }
 
@@ -574,6 +1536,10 @@ config_status_t config_get_defaults(detector_config_t *config) {
     /* Logging defaults */
     config->log_level = 1;  /* INFO */
 
+    /* Protection defaults */
+    config->overexposure_threshold = 60000;
+    config->overflow_action = 0;  /* Stop */
+
     return CONFIG_OK;
 }
 
@@ -3,7 +3,8 @@
  * @brief Frame Manager implementation
  *
  * REQ-FW-050~052: 4-buffer ring with oldest-drop policy.
- * REQ-FW-111: Runtime statistics.
+ * REQ-FW-111: Runtime statistics, kept as atomic counters so readers on
+ * other threads (metrics, stats page) see them without a lock.
  *
  * Implementation (TDD):
  * - RED: Tests already written (test_frame_manager.c)
@@ -14,18 +15,13 @@
  */
 
 #include "frame_manager.h"
+#include "util/trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include <limits.h>  /* For UINT32_MAX */
 
-/**
- * @brief Frame Manager context type for main.c compatibility
- */
-typedef struct {
-    bool initialized;  /**< Initialization flag */
-} frame_manager_t;
-
 /**
  * @brief Frame Manager instance
  */
@@ -33,13 +29,31 @@ typedef struct {
     frame_buffer_t *buffers;  /**< Array of buffer descriptors */
     uint32_t num_buffers;     /**< Number of buffers */
     uint32_t oldest_index;    /**< Index of oldest buffer for drop policy */
-    frame_stats_t stats;      /**< Statistics */
+    struct {
+        atomic_uint_fast64_t frames_received;
+        atomic_uint_fast64_t frames_sent;
+        atomic_uint_fast64_t frames_dropped;
+        atomic_uint_fast64_t overruns;
+    } stats;                  /**< Statistics */
     bool initialized;         /**< Initialization flag */
 } frame_mgr_t;
 
+#define FRAME_MGR_COUNT(counter) \
+    atomic_fetch_add_explicit(&g_frame_mgr.stats.counter, 1, memory_order_relaxed)
+
 /* Global instance (singleton pattern) */
 static frame_mgr_t g_frame_mgr = {0};
 
+/**
+ * @brief Zero the statistics counters
+ */
+static void frame_mgr_reset_stats(void) {
+    atomic_store_explicit(&g_frame_mgr.stats.frames_received, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_frame_mgr.stats.frames_sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_frame_mgr.stats.frames_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_frame_mgr.stats.overruns, 0, memory_order_relaxed);
+}
+
 /**
  * @brief Find buffer index by frame number
  *
@@ -104,7 +118,7 @@ int frame_mgr_init(const frame_mgr_config_t *config) {
     g_frame_mgr.initialized = true;
 
     /* Initialize statistics */
-    memset(&g_frame_mgr.stats, 0, sizeof(frame_stats_t));
+    frame_mgr_reset_stats();
 
     return 0;
 }
@@ -129,7 +143,7 @@ void frame_mgr_deinit(void) {
     g_frame_mgr.num_buffers = 0;
     g_frame_mgr.oldest_index = 0;
     g_frame_mgr.initialized = false;
-    memset(&g_frame_mgr.stats, 0, sizeof(frame_stats_t));
+    frame_mgr_reset_stats();
 }
 
 int frame_mgr_get_buffer(uint32_t frame_number, uint8_t **buf, size_t *size) {
@@ -173,8 +187,8 @@ int frame_mgr_get_buffer(uint32_t frame_number, uint8_t **buf, size_t *size) {
 
         /* Drop the buffer */
         g_frame_mgr.buffers[drop_index].state = BUF_STATE_FREE;
-        g_frame_mgr.stats.frames_dropped++;
-        g_frame_mgr.stats.overruns++;
+        FRAME_MGR_COUNT(frames_dropped);
+        FRAME_MGR_COUNT(overruns);
 
         /* Update oldest index */
         g_frame_mgr.oldest_index = (drop_index + 1) % g_frame_mgr.num_buffers;
@@ -187,6 +201,7 @@ int frame_mgr_get_buffer(uint32_t frame_number, uint8_t **buf, size_t *size) {
     /* Transition to FILLING */
     buffer->state = BUF_STATE_FILLING;
     buffer->frame_number = frame_number;
+    TRACE_INSTANT(TRACE_FRAME_GET, frame_number, index);
 
     *buf = buffer->data;
     *size = buffer->size;
@@ -209,7 +224,8 @@ int frame_mgr_commit_buffer(uint32_t frame_number) {
 
     /* Transition to READY */
     buffer->state = BUF_STATE_READY;
-    g_frame_mgr.stats.frames_received++;
+    FRAME_MGR_COUNT(frames_received);
+    TRACE_INSTANT(TRACE_FRAME_COMMIT, frame_number, index);
 
     return 0;
 }
@@ -245,6 +261,7 @@ int frame_mgr_get_ready_buffer(uint8_t **buf, size_t *size, uint32_t *frame_numb
 
     /* Transition to SENDING */
     buffer->state = BUF_STATE_SENDING;
+    TRACE_INSTANT(TRACE_FRAME_READY, buffer->frame_number, ready_index);
 
     *buf = buffer->data;
     *size = buffer->size;
@@ -268,7 +285,8 @@ int frame_mgr_release_buffer(uint32_t frame_number) {
 
     /* Transition to FREE */
     buffer->state = BUF_STATE_FREE;
-    g_frame_mgr.stats.frames_sent++;
+    FRAME_MGR_COUNT(frames_sent);
+    TRACE_INSTANT(TRACE_FRAME_RELEASE, frame_number, index);
 
     /* Update oldest index if this was the oldest */
     if (index == g_frame_mgr.oldest_index) {
@@ -283,11 +301,14 @@ void frame_mgr_get_stats(frame_stats_t *stats) {
         return;
     }
 
-    if (g_frame_mgr.initialized) {
-        *stats = g_frame_mgr.stats;
-    } else {
-        memset(stats, 0, sizeof(frame_stats_t));
-    }
+    /* Counters read zero when not initialized (reset by deinit) */
+    memset(stats, 0, sizeof(frame_stats_t));
+    stats->frames_received = atomic_load_explicit(&g_frame_mgr.stats.frames_received,
+                                                  memory_order_relaxed);
+    stats->frames_sent = atomic_load_explicit(&g_frame_mgr.stats.frames_sent, memory_order_relaxed);
+    stats->frames_dropped = atomic_load_explicit(&g_frame_mgr.stats.frames_dropped,
+                                                 memory_order_relaxed);
+    stats->overruns = atomic_load_explicit(&g_frame_mgr.stats.overruns, memory_order_relaxed);
 }
 
 buf_state_t frame_mgr_get_buffer_state(uint32_t frame_number) {
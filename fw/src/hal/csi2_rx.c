@@ -9,6 +9,7 @@
  * - Uses MMAP DMA buffers for zero-copy transfer
  * - Implements ISP bypass for raw pixel pass-through
  * - Pipeline restart for error recovery (within 5 seconds)
+ * - Frame-sync event subscription for start-of-frame timestamps
  *
  * DDD Methodology:
  * - ANALYZE: V4L2 kernel 6.6 API documentation
@@ -16,6 +17,10 @@
  * - IMPROVE: Error handling and recovery mechanisms
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "hal/csi2_rx.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +31,7 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/time.h>
+#include <poll.h>
 #include <linux/videodev2.h>
 
 /**
@@ -51,12 +57,33 @@ struct csi2_rx {
     /* State */
     bool is_streaming;          /**< Streaming state flag */
 
+    /* V4L2 events */
+    uint32_t subscribed_events;          /**< Bitmask of csi2_event_type_t */
+    csi2_sof_callback_t sof_callback;    /**< Start-of-frame callback */
+    void *sof_user_data;                 /**< Callback user data */
+    uint32_t sof_sequence[CSI2_SOF_HISTORY];  /**< Sequence of recorded SOF */
+    uint64_t sof_timestamp[CSI2_SOF_HISTORY]; /**< SOF time (ns), 0 = empty */
+
     /* Statistics */
     uint32_t frames_received;
     uint32_t frames_dropped;
     uint32_t errors;
 };
 
+/**
+ * @brief Event bit to V4L2 event type mapping
+ */
+static const struct {
+    csi2_event_type_t event;
+    uint32_t v4l2_type;
+} csi2_event_map[] = {
+    { CSI2_EVENT_FRAME_SYNC,    V4L2_EVENT_FRAME_SYNC },
+    { CSI2_EVENT_SOURCE_CHANGE, V4L2_EVENT_SOURCE_CHANGE },
+    { CSI2_EVENT_EOS,           V4L2_EVENT_EOS },
+};
+
+#define CSI2_EVENT_MAP_SIZE (sizeof(csi2_event_map) / sizeof(csi2_event_map[0]))
+
 /**
  * @brief Convert pixel format to V4L2 fourcc
  */
@@ -261,6 +288,11 @@ csi2_rx_t *csi2_rx_create(const csi2_config_t *config) {
     csi2->frames_dropped = 0;
     csi2->errors = 0;
 
+    /* Frame-sync events are optional: drivers without them fall back to DQBUF time */
+    if (config->enable_events) {
+        csi2_rx_subscribe_events(csi2, CSI2_EVENT_FRAME_SYNC | CSI2_EVENT_SOURCE_CHANGE);
+    }
+
     return csi2;
 }
 
@@ -382,6 +414,11 @@ csi2_status_t csi2_rx_capture(csi2_rx_t *csi2, csi2_frame_buffer_t *frame, int t
     frame->height = csi2->config.height;
     frame->pixel_format = pixel_format_to_fourcc(csi2->config.format);
 
+    /* Match start-of-frame recorded by csi2_rx_wait_event() */
+    uint32_t sof_slot = buf.sequence & (CSI2_SOF_HISTORY - 1);
+    frame->sof_timestamp = (csi2->sof_sequence[sof_slot] == buf.sequence) ?
+                           csi2->sof_timestamp[sof_slot] : 0;
+
     /* Store buffer index for release */
     frame->data = (void *)(uintptr_t)buf.index;
 
@@ -422,7 +459,7 @@ csi2_status_t csi2_rx_restart(csi2_rx_t *csi2) {
     /* Per REQ-FW-061: Restart pipeline within 5 seconds */
     /* Close device */
     int was_streaming = csi2->is_streaming;
-    int fd = csi2->fd;
+    uint32_t events = csi2->subscribed_events;
     const char *device = csi2->config.device;
 
     if (csi2->is_streaming) {
@@ -454,6 +491,12 @@ csi2_status_t csi2_rx_restart(csi2_rx_t *csi2) {
         return status;
     }
 
+    /* Subscriptions belong to the closed file handle */
+    csi2->subscribed_events = 0;
+    if (events != 0) {
+        csi2_rx_subscribe_events(csi2, events);
+    }
+
     /* Resume streaming if it was active */
     if (was_streaming) {
         status = csi2_rx_start(csi2);
@@ -468,6 +511,132 @@ csi2_status_t csi2_rx_restart(csi2_rx_t *csi2) {
     return CSI2_OK;
 }
 
+csi2_status_t csi2_rx_subscribe_events(csi2_rx_t *csi2, uint32_t events) {
+    if (csi2 == NULL) return CSI2_ERROR_NULL;
+    if (csi2->fd < 0) return CSI2_ERROR_CLOSED;
+
+    for (size_t i = 0; i < CSI2_EVENT_MAP_SIZE; i++) {
+        if (!(events & csi2_event_map[i].event) ||
+            (csi2->subscribed_events & csi2_event_map[i].event)) {
+            continue;
+        }
+
+        struct v4l2_event_subscription sub = {0};
+        sub.type = csi2_event_map[i].v4l2_type;
+        sub.id = 0;
+
+        /* Unsupported events are skipped; the caller checks the accepted set */
+        if (ioctl(csi2->fd, VIDIOC_SUBSCRIBE_EVENT, &sub) == 0) {
+            csi2->subscribed_events |= csi2_event_map[i].event;
+        }
+    }
+
+    if ((csi2->subscribed_events & events) == 0) {
+        csi2_set_error(csi2, CSI2_ERROR_IOCTL, "No requested event supported by driver");
+        return CSI2_ERROR_IOCTL;
+    }
+
+    return CSI2_OK;
+}
+
+csi2_status_t csi2_rx_unsubscribe_events(csi2_rx_t *csi2) {
+    if (csi2 == NULL) return CSI2_ERROR_NULL;
+    if (csi2->fd < 0) return CSI2_ERROR_CLOSED;
+    if (csi2->subscribed_events == 0) return CSI2_OK;
+
+    struct v4l2_event_subscription sub = {0};
+    sub.type = V4L2_EVENT_ALL;
+
+    if (ioctl(csi2->fd, VIDIOC_UNSUBSCRIBE_EVENT, &sub) < 0) {
+        csi2_set_error(csi2, CSI2_ERROR_IOCTL, "Failed to unsubscribe events");
+        return CSI2_ERROR_IOCTL;
+    }
+
+    csi2->subscribed_events = 0;
+    return CSI2_OK;
+}
+
+uint32_t csi2_rx_get_subscribed_events(csi2_rx_t *csi2) {
+    return (csi2 != NULL) ? csi2->subscribed_events : 0;
+}
+
+csi2_status_t csi2_rx_set_sof_callback(csi2_rx_t *csi2,
+                                      csi2_sof_callback_t callback,
+                                      void *user_data) {
+    if (csi2 == NULL) return CSI2_ERROR_NULL;
+
+    csi2->sof_callback = callback;
+    csi2->sof_user_data = user_data;
+    return CSI2_OK;
+}
+
+csi2_status_t csi2_rx_wait_event(csi2_rx_t *csi2, csi2_event_t *event, int timeout_ms) {
+    if (csi2 == NULL) return CSI2_ERROR_NULL;
+    if (csi2->fd < 0) return CSI2_ERROR_CLOSED;
+    if (csi2->subscribed_events == 0) return CSI2_ERROR_CLOSED;
+
+    /* Pending events are signalled as POLLPRI */
+    if (timeout_ms >= 0) {
+        struct pollfd pfd = { .fd = csi2->fd, .events = POLLPRI, .revents = 0 };
+        int ret = poll(&pfd, 1, (timeout_ms == 0) ? -1 : timeout_ms);
+
+        if (ret == 0) {
+            return CSI2_ERROR_TIMEOUT;
+        }
+        if (ret < 0) {
+            csi2_set_error(csi2, CSI2_ERROR_IOCTL, strerror(errno));
+            return CSI2_ERROR_IOCTL;
+        }
+    }
+
+    struct v4l2_event ev = {0};
+
+    if (ioctl(csi2->fd, VIDIOC_DQEVENT, &ev) < 0) {
+        if (errno == ENOENT || errno == EAGAIN) {
+            return CSI2_ERROR_TIMEOUT;
+        }
+        csi2_set_error(csi2, CSI2_ERROR_IOCTL, strerror(errno));
+        csi2->errors++;
+        return CSI2_ERROR_IOCTL;
+    }
+
+    csi2_event_t out = {0};
+    out.timestamp = (uint64_t)ev.timestamp.tv_sec * 1000000000ULL +
+                    (uint64_t)ev.timestamp.tv_nsec;
+
+    switch (ev.type) {
+        case V4L2_EVENT_FRAME_SYNC: {
+            out.type = CSI2_EVENT_FRAME_SYNC;
+            out.sequence = ev.u.frame_sync.frame_sequence;
+
+            /* Record for the DQBUF that will report this sequence */
+            uint32_t slot = out.sequence & (CSI2_SOF_HISTORY - 1);
+            csi2->sof_sequence[slot] = out.sequence;
+            csi2->sof_timestamp[slot] = out.timestamp;
+
+            if (csi2->sof_callback != NULL) {
+                csi2->sof_callback(&out, csi2->sof_user_data);
+            }
+            break;
+        }
+        case V4L2_EVENT_SOURCE_CHANGE:
+            out.type = CSI2_EVENT_SOURCE_CHANGE;
+            break;
+        case V4L2_EVENT_EOS:
+            out.type = CSI2_EVENT_EOS;
+            break;
+        default:
+            /* Not subscribed by us; report as timeout so callers keep waiting */
+            return CSI2_ERROR_TIMEOUT;
+    }
+
+    if (event != NULL) {
+        *event = out;
+    }
+
+    return CSI2_OK;
+}
+
 const char *csi2_get_error(csi2_rx_t *csi2) {
     if (csi2 == NULL) return "NULL CSI-2 handle";
     return csi2->error_msg;
@@ -11,25 +11,35 @@
  * - REFACTOR: Code improvements while maintaining tests
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "hal/eth_tx.h"
 #include "util/crc16.h"
+#include "util/trace.h"
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <time.h>
 
-/**
- * @brief Ethernet TX context type for main.c compatibility
- */
-typedef struct {
-    eth_tx_t *handle;  /**< Pointer to actual eth_tx_t instance */
-    bool initialized;  /**< Initialization flag */
-} eth_tx_context_t;
+_Static_assert(sizeof(eth_frame_header_t) == ETH_FRAME_HEADER_SIZE, "whole header on the wire");
+
+/* The header CRC covers everything before the CRC field */
+#define ETH_HEADER_CRC_LEN      offsetof(eth_frame_header_t, header_crc)
+
+/* Header bytes after packet_index, the only field that changes per packet */
+#define ETH_HEADER_CRC_TAIL     (ETH_HEADER_CRC_LEN - offsetof(eth_frame_header_t, packet_index) - \
+                                 sizeof(uint32_t))
 
 /**
  * @brief Ethernet TX internal state
@@ -43,10 +53,37 @@ struct eth_tx {
     /* Destination address */
     struct sockaddr_in dest_addr;
 
-    /* Statistics */
-    eth_tx_stats_t stats;
+    /* Per-frame header template (see eth_tx_prepare_frame). Written on the
+     * CSI-2 RX thread at start-of-frame, taken on the TX thread. */
+    pthread_mutex_t template_lock;
+    eth_frame_header_t header_template;
+    bool template_valid;
+
+    /* Packet plan for the configured geometry (see eth_tx_set_geometry) */
+    struct {
+        bool valid;
+        size_t frame_size;         /**< Frame size the plan applies to */
+        size_t payload;            /**< Payload of every packet but the last */
+        size_t last_payload;       /**< Payload of the last packet */
+        uint32_t total_packets;    /**< Packets per frame */
+    } plan;
+    crc16_shift_t crc_shift;       /**< Carries packet_index past the header tail */
+
+    /* Statistics: atomic, as frames and commands go out on different
+     * threads and metrics readers must not wait for either */
+    struct {
+        atomic_uint_fast64_t frames_sent;
+        atomic_uint_fast64_t packets_sent;
+        atomic_uint_fast64_t bytes_sent;
+        atomic_uint_fast64_t send_errors;
+        atomic_uint_fast64_t frames_dropped;
+        _Atomic double avg_latency_ms;     /**< Written by the frame sender only */
+    } stats;
 };
 
+#define ETH_STAT_ADD(eth, counter, n) \
+    atomic_fetch_add_explicit(&(eth)->stats.counter, (uint_fast64_t)(n), memory_order_relaxed)
+
 /**
  * @brief Convert error code to string
  */
@@ -149,7 +186,8 @@ eth_tx_t *eth_tx_create(const eth_tx_config_t *config) {
     }
 
     /* Initialize statistics */
-    memset(&eth->stats, 0, sizeof(eth->stats));
+    eth_tx_reset_stats(eth);
+    pthread_mutex_init(&eth->template_lock, NULL);
 
     return eth;
 }
@@ -165,20 +203,181 @@ void eth_tx_destroy(eth_tx_t *eth) {
         close(eth->cmd_fd);
     }
 
+    pthread_mutex_destroy(&eth->template_lock);
     free(eth);
 }
 
-eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
-                                 const void *frame_data,
-                                 size_t frame_size,
-                                 uint32_t width,
-                                 uint32_t height,
-                                 uint16_t bit_depth,
-                                 uint32_t frame_number) {
-    if (eth == NULL || frame_data == NULL) return ETH_TX_ERROR_NULL;
-    if (eth->data_fd < 0) return ETH_TX_ERROR_CLOSED;
-    if (frame_size == 0) return ETH_TX_ERROR_PARAM;
+/**
+ * @brief CLOCK_MONOTONIC in ns, the clock start-of-frame timestamps use
+ */
+static uint64_t eth_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Fill per-frame header fields (constant across all packets)
+ *
+ * The timestamp is the low 32 bits of CLOCK_MONOTONIC ns either way:
+ * start-of-frame when known, otherwise the time the header is built.
+ */
+static void eth_build_template(eth_frame_header_t *tmpl,
+                               uint32_t frame_number,
+                               uint32_t width,
+                               uint32_t height,
+                               uint16_t bit_depth,
+                               uint64_t timestamp_ns) {
+    memset(tmpl, 0, sizeof(*tmpl));
+    tmpl->magic = ETH_FRAME_MAGIC;
+    tmpl->frame_number = frame_number;
+    tmpl->width = width;
+    tmpl->height = height;
+    tmpl->bit_depth = bit_depth;
+    tmpl->flags = 0;
+    tmpl->timestamp = (uint32_t)((timestamp_ns != 0) ? timestamp_ns : eth_now_ns());
+    tmpl->reserved = 0;
+}
+
+eth_tx_status_t eth_tx_prepare_frame(eth_tx_t *eth,
+                                    uint32_t frame_number,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    uint16_t bit_depth,
+                                    uint64_t sof_timestamp_ns) {
+    if (eth == NULL) return ETH_TX_ERROR_NULL;
+
+    eth_frame_header_t tmpl;
+    eth_build_template(&tmpl, frame_number, width, height, bit_depth, sof_timestamp_ns);
+
+    pthread_mutex_lock(&eth->template_lock);
+    eth->header_template = tmpl;
+    eth->template_valid = true;
+    pthread_mutex_unlock(&eth->template_lock);
+
+    return ETH_TX_OK;
+}
+
+eth_tx_status_t eth_tx_set_geometry(eth_tx_t *eth,
+                                   uint32_t width,
+                                   uint32_t height,
+                                   uint16_t bit_depth) {
+    if (eth == NULL) return ETH_TX_ERROR_NULL;
+
+    eth->plan.valid = false;
+    if (width == 0) {
+        return ETH_TX_OK;
+    }
+    if (height == 0 || bit_depth == 0 || bit_depth > 16) {
+        eth_set_error(eth, ETH_TX_ERROR_PARAM, "Invalid frame geometry");
+        return ETH_TX_ERROR_PARAM;
+    }
+
+    size_t max_payload = eth->config.max_payload;
+    if (max_payload == 0) {
+        max_payload = ETH_DEFAULT_MAX_PAYLOAD;
+    }
+    if (max_payload <= ETH_FRAME_HEADER_SIZE) {
+        eth_set_error(eth, ETH_TX_ERROR_PARAM, "Payload smaller than header");
+        return ETH_TX_ERROR_PARAM;
+    }
+
+    size_t frame_size = (size_t)width * height * ((bit_depth > 8) ? 2 : 1);
+    size_t payload = max_payload - ETH_FRAME_HEADER_SIZE;
+    size_t total_packets = (frame_size + payload - 1) / payload;
+
+    eth->plan.frame_size = frame_size;
+    eth->plan.payload = payload;
+    eth->plan.last_payload = frame_size - (total_packets - 1) * payload;
+    eth->plan.total_packets = (uint32_t)total_packets;
+    crc16_shift_init(&eth->crc_shift, ETH_HEADER_CRC_TAIL);
+    eth->plan.valid = true;
+
+    return ETH_TX_OK;
+}
+
+/**
+ * @brief Send one frame with the packet plan
+ *
+ * Every header differs from the first (or, for the last packet, from a
+ * last-packet header) only in packet_index, so two CRCs per frame plus a
+ * four-byte CRC and a table patch per packet give the full header CRC. The
+ * payload is sent in place behind the header.
+ */
+static eth_tx_status_t eth_send_planned(eth_tx_t *eth,
+                                        const uint8_t *frame_data,
+                                        const eth_frame_header_t *tmpl) {
+    uint32_t total_packets = eth->plan.total_packets;
+    eth_frame_header_t header = *tmpl;
+    uint16_t crc_base = 0;
+    uint16_t crc_last = 0;
+
+    header.packet_index = 0;
+    header.total_packets = total_packets;
+    header.header_crc = 0;
+    if (eth->config.enable_crc) {
+        header.payload_len = (uint32_t)eth->plan.payload;
+        crc_base = crc16_compute((const uint8_t *)&header, ETH_HEADER_CRC_LEN);
+        header.payload_len = (uint32_t)eth->plan.last_payload;
+        crc_last = crc16_compute((const uint8_t *)&header, ETH_HEADER_CRC_LEN);
+    }
+
+    struct iovec iov[2] = {
+        { .iov_base = &header, .iov_len = ETH_FRAME_HEADER_SIZE },
+        { .iov_base = NULL, .iov_len = eth->plan.payload }
+    };
+    struct msghdr msg = {
+        .msg_name = &eth->dest_addr,
+        .msg_namelen = sizeof(eth->dest_addr),
+        .msg_iov = iov,
+        .msg_iovlen = 2
+    };
+
+    for (uint32_t i = 0; i < total_packets; i++) {
+        bool last = (i + 1 == total_packets);
+
+        header.packet_index = i;
+        header.payload_len = (uint32_t)(last ? eth->plan.last_payload : eth->plan.payload);
+        if (eth->config.enable_crc) {
+            uint8_t index[sizeof(uint32_t)];
+            memcpy(index, &header.packet_index, sizeof(index));
+            header.header_crc = (uint16_t)((last ? crc_last : crc_base) ^
+                crc16_shift_apply(&eth->crc_shift,
+                                  crc16_compute_with_init(index, sizeof(index), 0)));
+        }
+
+        iov[1].iov_base = (void *)(frame_data + (size_t)i * eth->plan.payload);
+        iov[1].iov_len = header.payload_len;
+
+        size_t packet_size = ETH_FRAME_HEADER_SIZE + header.payload_len;
+        ssize_t sent = sendmsg(eth->data_fd, &msg, 0);
+
+        if (sent < 0) {
+            eth_set_error(eth, ETH_TX_ERROR_SEND, strerror(errno));
+            ETH_STAT_ADD(eth, send_errors, 1);
+            return ETH_TX_ERROR_SEND;
+        }
 
+        if ((size_t)sent != packet_size) {
+            eth_set_error(eth, ETH_TX_ERROR_SEND, "Partial send");
+            ETH_STAT_ADD(eth, send_errors, 1);
+            return ETH_TX_ERROR_SEND;
+        }
+
+        ETH_STAT_ADD(eth, packets_sent, 1);
+        ETH_STAT_ADD(eth, bytes_sent, sent);
+    }
+
+    return ETH_TX_OK;
+}
+
+/**
+ * @brief Send one frame of arbitrary size (no plan)
+ */
+static eth_tx_status_t eth_send_generic(eth_tx_t *eth,
+                                        const void *frame_data,
+                                        size_t frame_size,
+                                        const eth_frame_header_t *tmpl) {
     /* Calculate packet parameters */
     size_t max_payload = eth->config.max_payload;
     if (max_payload == 0) {
@@ -191,10 +390,6 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
     /* Calculate total packets needed */
     size_t total_packets = (frame_size + payload_per_packet - 1) / payload_per_packet;
 
-    /* Track timing */
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     /* Send each packet */
     for (size_t i = 0; i < total_packets; i++) {
         /* Calculate payload offset and length */
@@ -204,23 +399,14 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
 
         /* Build frame header */
         /* Per REQ-FW-040: Frame header format */
-        eth_frame_header_t header = {0};
-        header.magic = ETH_FRAME_MAGIC;
-        header.frame_number = frame_number;
-        header.width = width;
-        header.height = height;
-        header.bit_depth = bit_depth;
-        header.flags = 0;
+        eth_frame_header_t header = *tmpl;
         header.packet_index = (uint32_t)i;
         header.total_packets = (uint32_t)total_packets;
         header.payload_len = (uint32_t)payload_len;
-        header.timestamp = (uint32_t)time(NULL);
-        header.reserved = 0;
 
         /* Per REQ-FW-042: Compute CRC-16 of header */
         if (eth->config.enable_crc) {
-            header.header_crc = crc16_compute((const uint8_t *)&header,
-                                             sizeof(header) - sizeof(uint16_t) - sizeof(uint16_t));
+            header.header_crc = crc16_compute((const uint8_t *)&header, ETH_HEADER_CRC_LEN);
         } else {
             header.header_crc = 0;
         }
@@ -246,18 +432,96 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
 
         if (sent < 0) {
             eth_set_error(eth, ETH_TX_ERROR_SEND, strerror(errno));
-            eth->stats.send_errors++;
+            ETH_STAT_ADD(eth, send_errors, 1);
             return ETH_TX_ERROR_SEND;
         }
 
         if ((size_t)sent != packet_size) {
             eth_set_error(eth, ETH_TX_ERROR_SEND, "Partial send");
-            eth->stats.send_errors++;
+            ETH_STAT_ADD(eth, send_errors, 1);
             return ETH_TX_ERROR_SEND;
         }
 
-        eth->stats.packets_sent++;
-        eth->stats.bytes_sent += sent;
+        ETH_STAT_ADD(eth, packets_sent, 1);
+        ETH_STAT_ADD(eth, bytes_sent, sent);
+    }
+
+    return ETH_TX_OK;
+}
+
+/**
+ * @brief Header template for a frame, from eth_tx_prepare_frame() if it matches
+ *
+ * A template for another frame is left in place: with the pipeline full,
+ * the next frame's start-of-frame can arrive before this frame is sent.
+ */
+static void eth_take_template(eth_tx_t *eth,
+                              eth_frame_header_t *tmpl,
+                              uint32_t frame_number,
+                              uint32_t width,
+                              uint32_t height,
+                              uint16_t bit_depth,
+                              uint16_t flags) {
+    bool taken = false;
+
+    pthread_mutex_lock(&eth->template_lock);
+    if (eth->template_valid &&
+        eth->header_template.frame_number == frame_number &&
+        eth->header_template.width == width &&
+        eth->header_template.height == height &&
+        eth->header_template.bit_depth == bit_depth) {
+        *tmpl = eth->header_template;
+        eth->template_valid = false;
+        taken = true;
+    }
+    pthread_mutex_unlock(&eth->template_lock);
+
+    if (!taken) {
+        eth_build_template(tmpl, frame_number, width, height, bit_depth, 0);
+    }
+    tmpl->flags = flags;
+}
+
+eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
+                                 const void *frame_data,
+                                 size_t frame_size,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 uint16_t bit_depth,
+                                 uint32_t frame_number) {
+    return eth_tx_send_frame_flags(eth, frame_data, frame_size, width, height,
+                                   bit_depth, frame_number, 0);
+}
+
+eth_tx_status_t eth_tx_send_frame_flags(eth_tx_t *eth,
+                                       const void *frame_data,
+                                       size_t frame_size,
+                                       uint32_t width,
+                                       uint32_t height,
+                                       uint16_t bit_depth,
+                                       uint32_t frame_number,
+                                       uint16_t flags) {
+    if (eth == NULL || frame_data == NULL) return ETH_TX_ERROR_NULL;
+    if (eth->data_fd < 0) return ETH_TX_ERROR_CLOSED;
+    if (frame_size == 0) return ETH_TX_ERROR_PARAM;
+
+    /* Track timing */
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TRACE_BEGIN(TRACE_ETH_SEND, frame_number, flags);
+
+    eth_frame_header_t tmpl;
+    eth_take_template(eth, &tmpl, frame_number, width, height, bit_depth, flags);
+
+    eth_tx_status_t status;
+    if (eth->plan.valid && eth->plan.frame_size == frame_size) {
+        status = eth_send_planned(eth, (const uint8_t *)frame_data, &tmpl);
+    } else {
+        status = eth_send_generic(eth, frame_data, frame_size, &tmpl);
+    }
+    TRACE_END(TRACE_ETH_SEND, frame_number, status);
+    if (status != ETH_TX_OK) {
+        return status;
     }
 
     /* Update timing statistics */
@@ -267,13 +531,14 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
     double elapsed_ms = elapsed_ns / 1000000.0;
 
     /* Update average latency (exponential moving average) */
-    if (eth->stats.frames_sent == 0) {
-        eth->stats.avg_latency_ms = elapsed_ms;
-    } else {
-        eth->stats.avg_latency_ms = 0.9 * eth->stats.avg_latency_ms + 0.1 * elapsed_ms;
+    double avg_ms = elapsed_ms;
+    if (atomic_load_explicit(&eth->stats.frames_sent, memory_order_relaxed) != 0) {
+        avg_ms = 0.9 * atomic_load_explicit(&eth->stats.avg_latency_ms, memory_order_relaxed) +
+                 0.1 * elapsed_ms;
     }
+    atomic_store_explicit(&eth->stats.avg_latency_ms, avg_ms, memory_order_relaxed);
 
-    eth->stats.frames_sent++;
+    ETH_STAT_ADD(eth, frames_sent, 1);
 
     /* Per REQ-FW-041: TX within 1 frame period */
     /* At 15 fps, 1 frame period = 66.7 ms */
@@ -286,6 +551,44 @@ eth_tx_status_t eth_tx_send_frame(eth_tx_t *eth,
     return ETH_TX_OK;
 }
 
+eth_tx_status_t eth_tx_send_marker(eth_tx_t *eth,
+                                  uint32_t frame_number,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  uint16_t bit_depth,
+                                  uint16_t flags) {
+    if (eth == NULL) return ETH_TX_ERROR_NULL;
+    if (eth->data_fd < 0) return ETH_TX_ERROR_CLOSED;
+
+    eth_frame_header_t header;
+    eth_take_template(eth, &header, frame_number, width, height, bit_depth, flags);
+    header.packet_index = 0;
+    header.total_packets = 1;
+    header.payload_len = 0;
+    header.header_crc = eth->config.enable_crc ?
+        crc16_compute((const uint8_t *)&header, ETH_HEADER_CRC_LEN) : 0;
+
+    struct sockaddr_in dest_addr = eth->dest_addr;
+    ssize_t sent = sendto(eth->data_fd, &header, sizeof(header), 0,
+                         (struct sockaddr *)&dest_addr, sizeof(dest_addr));
+    if (sent < 0) {
+        eth_set_error(eth, ETH_TX_ERROR_SEND, strerror(errno));
+        ETH_STAT_ADD(eth, send_errors, 1);
+        return ETH_TX_ERROR_SEND;
+    }
+    if ((size_t)sent != sizeof(header)) {
+        eth_set_error(eth, ETH_TX_ERROR_SEND, "Partial send");
+        ETH_STAT_ADD(eth, send_errors, 1);
+        return ETH_TX_ERROR_SEND;
+    }
+
+    ETH_STAT_ADD(eth, packets_sent, 1);
+    ETH_STAT_ADD(eth, bytes_sent, sent);
+    ETH_STAT_ADD(eth, frames_sent, 1);
+
+    return ETH_TX_OK;
+}
+
 eth_tx_status_t eth_tx_send_command(eth_tx_t *eth,
                                    const void *cmd_data,
                                    size_t cmd_size) {
@@ -311,8 +614,8 @@ eth_tx_status_t eth_tx_send_command(eth_tx_t *eth,
         return ETH_TX_ERROR_SEND;
     }
 
-    eth->stats.packets_sent++;
-    eth->stats.bytes_sent += sent;
+    ETH_STAT_ADD(eth, packets_sent, 1);
+    ETH_STAT_ADD(eth, bytes_sent, sent);
 
     return ETH_TX_OK;
 }
@@ -325,14 +628,24 @@ const char *eth_get_error(eth_tx_t *eth) {
 eth_tx_status_t eth_tx_get_stats(eth_tx_t *eth, eth_tx_stats_t *stats) {
     if (eth == NULL || stats == NULL) return ETH_TX_ERROR_NULL;
 
-    memcpy(stats, &eth->stats, sizeof(eth_tx_stats_t));
+    stats->frames_sent = atomic_load_explicit(&eth->stats.frames_sent, memory_order_relaxed);
+    stats->packets_sent = atomic_load_explicit(&eth->stats.packets_sent, memory_order_relaxed);
+    stats->bytes_sent = atomic_load_explicit(&eth->stats.bytes_sent, memory_order_relaxed);
+    stats->send_errors = atomic_load_explicit(&eth->stats.send_errors, memory_order_relaxed);
+    stats->frames_dropped = atomic_load_explicit(&eth->stats.frames_dropped, memory_order_relaxed);
+    stats->avg_latency_ms = atomic_load_explicit(&eth->stats.avg_latency_ms, memory_order_relaxed);
     return ETH_TX_OK;
 }
 
 eth_tx_status_t eth_tx_reset_stats(eth_tx_t *eth) {
     if (eth == NULL) return ETH_TX_ERROR_NULL;
 
-    memset(&eth->stats, 0, sizeof(eth_tx_stats_t));
+    atomic_store_explicit(&eth->stats.frames_sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&eth->stats.packets_sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&eth->stats.bytes_sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&eth->stats.send_errors, 0, memory_order_relaxed);
+    atomic_store_explicit(&eth->stats.frames_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&eth->stats.avg_latency_ms, 0.0, memory_order_relaxed);
     return ETH_TX_OK;
 }
 
@@ -18,13 +18,21 @@
  * Example: Read from register 0x20
  *   TX: [0x20, 0x80, 0x00, 0x00]  (addr=0x20, READ=0x80, dummy data)
  *   RX: [0x20, 0x80, 0x12, 0x34]  (FPGA echoes address + returns data)
+ *
+ * One master is shared by the frame path (exposure writes) and the status
+ * collector (temperature reads), so each call holds the master's lock.
+ * Statistics are atomic counters, so spi_get_stats() never waits for a
+ * transaction.
  */
 
 #include "hal/spi_master.h"
+#include "util/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -37,14 +45,18 @@ struct spi_master {
     int fd;                     /**< File descriptor */
     spi_config_t config;        /**< Configuration */
     char error_msg[256];        /**< Last error message */
+    pthread_mutex_t lock;       /**< One transaction (or write + read-back) at a time */
 
-    /* Statistics */
-    uint32_t total_writes;
-    uint32_t total_reads;
-    uint32_t write_errors;
-    uint32_t read_errors;
+    /* Statistics (added to under the lock, read without it) */
+    atomic_uint total_writes;
+    atomic_uint total_reads;
+    atomic_uint write_errors;
+    atomic_uint read_errors;
 };
 
+#define SPI_COUNT(spi, counter) \
+    atomic_fetch_add_explicit(&(spi)->counter, 1, memory_order_relaxed)
+
 /* Forward declarations for legacy test compatibility */
 static spi_master_t *g_spi = NULL;
 
@@ -129,10 +141,11 @@ spi_master_t *spi_master_create(const spi_config_t *config) {
     }
 
     /* Initialize statistics */
-    spi->total_writes = 0;
-    spi->total_reads = 0;
-    spi->write_errors = 0;
-    spi->read_errors = 0;
+    atomic_init(&spi->total_writes, 0);
+    atomic_init(&spi->total_reads, 0);
+    atomic_init(&spi->write_errors, 0);
+    atomic_init(&spi->read_errors, 0);
+    pthread_mutex_init(&spi->lock, NULL);
 
     return spi;
 }
@@ -144,59 +157,14 @@ void spi_master_destroy(spi_master_t *spi) {
         close(spi->fd);
     }
 
+    pthread_mutex_destroy(&spi->lock);
     free(spi);
 }
 
-spi_status_t spi_write_register(spi_master_t *spi, uint8_t addr, uint16_t data) {
-    if (spi == NULL) return SPI_ERROR_NULL;
-    if (spi->fd < 0) return SPI_ERROR_CLOSED;
-
-    /* Validate address (7-bit address space) */
-    if (addr > 0x7F) {
-        spi_set_error(spi, SPI_ERROR_NULL, "Invalid address");
-        return SPI_ERROR_NULL;
-    }
-
-    spi_status_t status;
-    int retry_count = 0;
-
-    /* Write with verification retry loop */
-    do {
-        /* Write the register */
-        status = spi_write_register_no_verify(spi, addr, data);
-        if (status != SPI_OK) {
-            spi->write_errors++;
-            return status;
-        }
-
-        /* Verify by reading back */
-        uint16_t read_back;
-        status = spi_read_register(spi, addr, &read_back);
-        if (status != SPI_OK) {
-            spi->read_errors++;
-            retry_count++;
-            continue;
-        }
-
-        /* Check if verification succeeded */
-        if (read_back == data) {
-            spi->total_writes++;
-            return SPI_OK;
-        }
-
-        retry_count++;
-
-    } while (retry_count < SPI_MAX_RETRY_COUNT);
-
-    /* All retries failed */
-    spi_set_error(spi, SPI_ERROR_VERIFY, "Max retries exceeded");
-    return SPI_ERROR_VERIFY;
-}
-
-spi_status_t spi_read_register(spi_master_t *spi, uint8_t addr, uint16_t *data) {
-    if (spi == NULL || data == NULL) return SPI_ERROR_NULL;
-    if (spi->fd < 0) return SPI_ERROR_CLOSED;
-
+/**
+ * @brief One read transaction (lock held)
+ */
+static spi_status_t read_register(spi_master_t *spi, uint8_t addr, uint16_t *data) {
     /* Validate address (7-bit address space) */
     if (addr > 0x7F) {
         spi_set_error(spi, SPI_ERROR_NULL, "Invalid address");
@@ -225,10 +193,12 @@ spi_status_t spi_read_register(spi_master_t *spi, uint8_t addr, uint16_t *data)
     };
 
     /* Execute SPI transfer */
+    TRACE_BEGIN(TRACE_SPI_XFER, addr, 0);
     int ret = ioctl(spi->fd, SPI_IOC_MESSAGE(1), &tr);
+    TRACE_END(TRACE_SPI_XFER, addr, (ret < 0) ? SPI_ERROR_TRANSFER : SPI_OK);
     if (ret < 0) {
         spi_set_error(spi, SPI_ERROR_TRANSFER, strerror(errno));
-        spi->read_errors++;
+        SPI_COUNT(spi, read_errors);
         return SPI_ERROR_TRANSFER;
     }
 
@@ -236,14 +206,14 @@ spi_status_t spi_read_register(spi_master_t *spi, uint8_t addr, uint16_t *data)
     /* Response format: [addr, 0x80, data_hi, data_lo] */
     *data = ((uint16_t)rx_buf[2] << 8) | rx_buf[3];
 
-    spi->total_reads++;
+    SPI_COUNT(spi, total_reads);
     return SPI_OK;
 }
 
-spi_status_t spi_write_register_no_verify(spi_master_t *spi, uint8_t addr, uint16_t data) {
-    if (spi == NULL) return SPI_ERROR_NULL;
-    if (spi->fd < 0) return SPI_ERROR_CLOSED;
-
+/**
+ * @brief One write transaction (lock held)
+ */
+static spi_status_t write_register(spi_master_t *spi, uint8_t addr, uint16_t data) {
     /* Validate address (7-bit address space) */
     if (addr > 0x7F) {
         spi_set_error(spi, SPI_ERROR_NULL, "Invalid address");
@@ -272,7 +242,9 @@ spi_status_t spi_write_register_no_verify(spi_master_t *spi, uint8_t addr, uint1
     };
 
     /* Execute SPI transfer */
+    TRACE_BEGIN(TRACE_SPI_XFER, addr, 1);
     int ret = ioctl(spi->fd, SPI_IOC_MESSAGE(1), &tr);
+    TRACE_END(TRACE_SPI_XFER, addr, (ret < 0) ? SPI_ERROR_TRANSFER : SPI_OK);
     if (ret < 0) {
         spi_set_error(spi, SPI_ERROR_TRANSFER, strerror(errno));
         return SPI_ERROR_TRANSFER;
@@ -281,6 +253,82 @@ spi_status_t spi_write_register_no_verify(spi_master_t *spi, uint8_t addr, uint1
     return SPI_OK;
 }
 
+/**
+ * @brief Write with read-back verification (lock held)
+ */
+static spi_status_t write_verified(spi_master_t *spi, uint8_t addr, uint16_t data) {
+    /* Validate address (7-bit address space) */
+    if (addr > 0x7F) {
+        spi_set_error(spi, SPI_ERROR_NULL, "Invalid address");
+        return SPI_ERROR_NULL;
+    }
+
+    spi_status_t status;
+    int retry_count = 0;
+
+    /* Write with verification retry loop */
+    do {
+        /* Write the register */
+        status = write_register(spi, addr, data);
+        if (status != SPI_OK) {
+            SPI_COUNT(spi, write_errors);
+            return status;
+        }
+
+        /* Verify by reading back */
+        uint16_t read_back;
+        status = read_register(spi, addr, &read_back);
+        if (status != SPI_OK) {
+            SPI_COUNT(spi, read_errors);
+            retry_count++;
+            continue;
+        }
+
+        /* Check if verification succeeded */
+        if (read_back == data) {
+            SPI_COUNT(spi, total_writes);
+            return SPI_OK;
+        }
+
+        retry_count++;
+
+    } while (retry_count < SPI_MAX_RETRY_COUNT);
+
+    /* All retries failed */
+    spi_set_error(spi, SPI_ERROR_VERIFY, "Max retries exceeded");
+    return SPI_ERROR_VERIFY;
+}
+
+spi_status_t spi_write_register(spi_master_t *spi, uint8_t addr, uint16_t data) {
+    if (spi == NULL) return SPI_ERROR_NULL;
+    if (spi->fd < 0) return SPI_ERROR_CLOSED;
+
+    pthread_mutex_lock(&spi->lock);
+    spi_status_t status = write_verified(spi, addr, data);
+    pthread_mutex_unlock(&spi->lock);
+    return status;
+}
+
+spi_status_t spi_read_register(spi_master_t *spi, uint8_t addr, uint16_t *data) {
+    if (spi == NULL || data == NULL) return SPI_ERROR_NULL;
+    if (spi->fd < 0) return SPI_ERROR_CLOSED;
+
+    pthread_mutex_lock(&spi->lock);
+    spi_status_t status = read_register(spi, addr, data);
+    pthread_mutex_unlock(&spi->lock);
+    return status;
+}
+
+spi_status_t spi_write_register_no_verify(spi_master_t *spi, uint8_t addr, uint16_t data) {
+    if (spi == NULL) return SPI_ERROR_NULL;
+    if (spi->fd < 0) return SPI_ERROR_CLOSED;
+
+    pthread_mutex_lock(&spi->lock);
+    spi_status_t status = write_register(spi, addr, data);
+    pthread_mutex_unlock(&spi->lock);
+    return status;
+}
+
 spi_status_t spi_read_bulk(spi_master_t *spi, uint8_t start_addr,
                           uint16_t *buffer, size_t count) {
     if (spi == NULL || buffer == NULL) return SPI_ERROR_NULL;
@@ -351,10 +399,10 @@ spi_status_t spi_get_stats(spi_master_t *spi,
                           uint32_t *read_errors) {
     if (spi == NULL) return SPI_ERROR_NULL;
 
-    if (total_writes) *total_writes = spi->total_writes;
-    if (total_reads) *total_reads = spi->total_reads;
-    if (write_errors) *write_errors = spi->write_errors;
-    if (read_errors) *read_errors = spi->read_errors;
+    if (total_writes) *total_writes = atomic_load_explicit(&spi->total_writes, memory_order_relaxed);
+    if (total_reads) *total_reads = atomic_load_explicit(&spi->total_reads, memory_order_relaxed);
+    if (write_errors) *write_errors = atomic_load_explicit(&spi->write_errors, memory_order_relaxed);
+    if (read_errors) *read_errors = atomic_load_explicit(&spi->read_errors, memory_order_relaxed);
 
     return SPI_OK;
 }
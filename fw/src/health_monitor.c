@@ -8,11 +8,37 @@
  * REQ-FW-111: Runtime statistics aggregation
  * REQ-FW-112: GET_STATUS response < 50ms
  *
+ * Counter blocks: FREE -> OWNED (CAS by the first update of a thread) ->
+ * FREE (thread exit, via a pthread key destructor). Pipeline stage
+ * threads are re-created on every mode change, so blocks must come back;
+ * a released block keeps its counts and the next owner adds to them. An
+ * owned block has a single writer, so its counters are updated with a
+ * relaxed load and store (no locked instruction); readers may see a total
+ * that is a few updates old but never lose one. Threads finding no free
+ * block share one updated with atomic adds for the rest of their life.
+ *
+ * Once health_monitor_start_async_log() has run, health_monitor_log()
+ * only captures the call (util/async_log.h) and the syslog line is
+ * formatted and written by the drain thread, so the real-time threads
+ * can log. Module and format arguments are string literals everywhere.
+ *
+ * The status snapshot has a single writer, the collector thread (or the
+ * caller of health_monitor_start_status() before the thread exists). It
+ * makes the sequence number odd, stores the fields with relaxed atomics
+ * and makes it even again; health_monitor_get_status() retries a copy
+ * that overlapped a write, yielding while the number is odd. Ages come
+ * from the same clock as the watchdog, so tests can set them.
+ *
  * Copyright (c) 2026 ABYZ Lab
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "health_monitor.h"
 #include "sequence_engine.h"
+#include "util/async_log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,6 +47,23 @@
 #include <syslog.h>
 #include <stdarg.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+
+/* syslog.h defines LOG_DEBUG, LOG_INFO and LOG_WARNING as priorities,
+ * hiding the log_level_t constants of the same names. Keep the priorities
+ * under other names and let the enum through again. */
+enum {
+    HM_SYSLOG_DEBUG = LOG_DEBUG,
+    HM_SYSLOG_INFO = LOG_INFO,
+    HM_SYSLOG_WARNING = LOG_WARNING,
+};
+#undef LOG_DEBUG
+#undef LOG_INFO
+#undef LOG_WARNING
 
 /* ==========================================================================
  * Internal State
@@ -28,6 +71,99 @@
 
 static health_monitor_context_t g_health_ctx = {0};
 
+#define HM_CACHELINE 64
+
+/**
+ * @brief Counters of one thread, on cache lines of their own
+ */
+typedef struct {
+    _Alignas(HM_CACHELINE) atomic_uint_least64_t counters[HEALTH_STAT_COUNT];
+    atomic_bool owned;          /* A thread holds it (unused for the shared block) */
+} health_stat_block_t;
+
+/* Blocks owned by one thread each, plus a shared block for the rest */
+static health_stat_block_t g_stat_blocks[HEALTH_STAT_THREADS + 1];
+static _Thread_local health_stat_block_t *t_stat_block;
+static pthread_key_t g_stat_key;
+static pthread_once_t g_stat_key_once = PTHREAD_ONCE_INIT;
+
+#define HM_SHARED_BLOCK (&g_stat_blocks[HEALTH_STAT_THREADS])
+
+static const char *const g_stat_names[HEALTH_STAT_COUNT] = {
+    "frames_received",
+    "frames_sent",
+    "frames_dropped",
+    "spi_errors",
+    "csi2_errors",
+    "packets_sent",
+    "bytes_sent",
+    "auth_failures",
+    "watchdog_resets",
+};
+
+/**
+ * @brief Ring of time series points for one metric
+ */
+typedef struct {
+    health_point_t points[HEALTH_SERIES_LEN];
+    uint32_t head;           /* Index of the newest point */
+    uint32_t count;          /* Valid points */
+} health_series_t;
+
+static health_series_t g_series[HEALTH_METRIC_COUNT];
+static pthread_mutex_t g_series_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Snapshot copies GET_STATUS tries before giving up */
+#define HM_STATUS_READ_TRIES 1000
+
+/* Values before the first collection (and when a device is missing) */
+#define HM_DEFAULT_BATTERY_SOC  100
+#define HM_DEFAULT_BATTERY_MV   3700
+#define HM_DEFAULT_FPGA_TEMP    350     /* 35.0 C */
+
+/**
+ * @brief Collected status fields under a seqlock
+ */
+typedef struct {
+    atomic_uint seq;                    /* Odd while the collector writes */
+    atomic_uint state;
+    atomic_uint battery_soc;
+    atomic_uint battery_mv;
+    atomic_uint fpga_temp;
+    atomic_uint_least64_t read_ms[HEALTH_STATUS_FIELD_COUNT]; /* 0 = never */
+} health_status_snapshot_t;
+
+static health_status_snapshot_t g_status;
+
+/**
+ * @brief Status collector thread state
+ */
+typedef struct {
+    health_status_config_t config;
+    uint32_t period_ms[HEALTH_STATUS_FIELD_COUNT];
+    bool temp_failing;                  /* Log a failing read once */
+    bool battery_failing;
+    bool running;
+    bool stop;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} health_status_collector_t;
+
+static health_status_collector_t g_collector = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+
+static const char *const g_metric_names[HEALTH_METRIC_COUNT] = {
+    "qa_mean",
+    "qa_noise",
+    "qa_snr",
+    "qa_row_banding",
+    "qa_col_banding",
+    "qa_nonuniformity",
+};
+
 /* ==========================================================================
  * Internal Helper Functions
  * ========================================================================== */
@@ -53,12 +189,12 @@ static uint64_t get_time_ms_impl(void) {
  */
 static int log_level_to_syslog(log_level_t level) {
     switch (level) {
-        case LOG_DEBUG:    return LOG_DEBUG;
-        case LOG_INFO:     return LOG_INFO;
-        case LOG_WARNING:  return LOG_WARNING;
+        case LOG_DEBUG:    return HM_SYSLOG_DEBUG;
+        case LOG_INFO:     return HM_SYSLOG_INFO;
+        case LOG_WARNING:  return HM_SYSLOG_WARNING;
         case LOG_ERROR:    return LOG_ERR;
         case LOG_CRITICAL: return LOG_CRIT;
-        default:           return LOG_INFO;
+        default:           return HM_SYSLOG_INFO;
     }
 }
 
@@ -77,18 +213,225 @@ static const char* log_level_to_string(log_level_t level) {
 }
 
 /**
- * @brief Find statistic by name
+ * @brief Hand an exiting thread's counter block back (pthread key destructor)
  */
-static uint64_t* find_stat(const char *name) {
-    if (strcmp(name, "frames_received") == 0) return &g_health_ctx.stats.frames_received;
-    if (strcmp(name, "frames_sent") == 0) return &g_health_ctx.stats.frames_sent;
-    if (strcmp(name, "frames_dropped") == 0) return &g_health_ctx.stats.frames_dropped;
-    if (strcmp(name, "spi_errors") == 0) return &g_health_ctx.stats.spi_errors;
-    if (strcmp(name, "csi2_errors") == 0) return &g_health_ctx.stats.csi2_errors;
-    if (strcmp(name, "packets_sent") == 0) return &g_health_ctx.stats.packets_sent;
-    if (strcmp(name, "bytes_sent") == 0) return &g_health_ctx.stats.bytes_sent;
-    if (strcmp(name, "auth_failures") == 0) return &g_health_ctx.stats.auth_failures;
-    if (strcmp(name, "watchdog_resets") == 0) return &g_health_ctx.stats.watchdog_resets;
+static void release_stat_block(void *block) {
+    /* Release: the next owner continues from this thread's last stores */
+    atomic_store_explicit(&((health_stat_block_t *)block)->owned, false,
+                          memory_order_release);
+    t_stat_block = NULL;
+}
+
+static void make_stat_key(void) {
+    pthread_key_create(&g_stat_key, release_stat_block);
+}
+
+/**
+ * @brief Claim a free counter block for the calling thread on its first update
+ */
+static health_stat_block_t *claim_stat_block(void) {
+    pthread_once(&g_stat_key_once, make_stat_key);
+
+    for (uint32_t b = 0; b < HEALTH_STAT_THREADS; b++) {
+        bool expected = false;
+        if (!atomic_load_explicit(&g_stat_blocks[b].owned, memory_order_relaxed) &&
+            atomic_compare_exchange_strong_explicit(&g_stat_blocks[b].owned, &expected, true,
+                                                    memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            t_stat_block = &g_stat_blocks[b];
+            pthread_setspecific(g_stat_key, t_stat_block);
+            return t_stat_block;
+        }
+    }
+
+    /* All taken: this thread stays on the shared block until it exits */
+    t_stat_block = HM_SHARED_BLOCK;
+    return t_stat_block;
+}
+
+/**
+ * @brief Zero every counter block (claims are kept)
+ */
+static void reset_stat_blocks(void) {
+    for (uint32_t b = 0; b <= HEALTH_STAT_THREADS; b++) {
+        for (uint32_t i = 0; i < HEALTH_STAT_COUNT; i++) {
+            atomic_store_explicit(&g_stat_blocks[b].counters[i], 0, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Snapshot all counters into the runtime_stats_t layout
+ */
+static void collect_stats(runtime_stats_t *stats) {
+    uint64_t *out = (uint64_t *)stats;
+
+    for (uint32_t i = 0; i < HEALTH_STAT_COUNT; i++) {
+        out[i] = health_monitor_read_stat((health_stat_t)i);
+    }
+}
+
+_Static_assert(sizeof(runtime_stats_t) == HEALTH_STAT_COUNT * sizeof(uint64_t),
+               "runtime_stats_t must hold one uint64_t per health_stat_t");
+
+/**
+ * @brief Begin a snapshot write (single writer)
+ */
+static void status_write_begin(void) {
+    unsigned int seq = atomic_load_explicit(&g_status.seq, memory_order_relaxed);
+    atomic_store_explicit(&g_status.seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/**
+ * @brief End a snapshot write
+ */
+static void status_write_end(void) {
+    unsigned int seq = atomic_load_explicit(&g_status.seq, memory_order_relaxed);
+    atomic_store_explicit(&g_status.seq, seq + 1, memory_order_release);
+}
+
+/**
+ * @brief Put the snapshot back to defaults, nothing collected
+ */
+static void reset_status_snapshot(void) {
+    status_write_begin();
+    atomic_store_explicit(&g_status.state, SEQ_STATE_IDLE, memory_order_relaxed);
+    atomic_store_explicit(&g_status.battery_soc, HM_DEFAULT_BATTERY_SOC, memory_order_relaxed);
+    atomic_store_explicit(&g_status.battery_mv, HM_DEFAULT_BATTERY_MV, memory_order_relaxed);
+    atomic_store_explicit(&g_status.fpga_temp, HM_DEFAULT_FPGA_TEMP, memory_order_relaxed);
+    for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+        atomic_store_explicit(&g_status.read_ms[i], 0, memory_order_relaxed);
+    }
+    status_write_end();
+}
+
+/**
+ * @brief Read one field from its device into the snapshot
+ *
+ * Runs on the collector only. A failed read leaves the field and its
+ * read time alone, so its age shows how stale it is.
+ */
+static void collect_status_field(health_status_collector_t *collector,
+                                 health_status_field_t field) {
+    uint64_t now = get_time_ms_impl();
+
+    switch (field) {
+        case HEALTH_STATUS_STATE: {
+            unsigned int state = (unsigned int)seq_get_state();
+            status_write_begin();
+            atomic_store_explicit(&g_status.state, state, memory_order_relaxed);
+            atomic_store_explicit(&g_status.read_ms[field], now, memory_order_relaxed);
+            status_write_end();
+            break;
+        }
+
+        case HEALTH_STATUS_BATTERY: {
+            battery_metrics_t metrics;
+            if (collector->config.battery == NULL) {
+                break;
+            }
+            if (bq40z50_read_metrics(collector->config.battery, &metrics) != 0) {
+                if (!collector->battery_failing) {
+                    health_monitor_log(LOG_WARNING, "health", "Battery gauge read failed");
+                    collector->battery_failing = true;
+                }
+                break;
+            }
+            collector->battery_failing = false;
+            status_write_begin();
+            atomic_store_explicit(&g_status.battery_soc, metrics.state_of_charge, memory_order_relaxed);
+            atomic_store_explicit(&g_status.battery_mv, metrics.voltage, memory_order_relaxed);
+            atomic_store_explicit(&g_status.read_ms[field], now, memory_order_relaxed);
+            status_write_end();
+            break;
+        }
+
+        case HEALTH_STATUS_FPGA_TEMP: {
+            /* REQ-FW-070: FPGA thermal monitoring, 0.1 C units (350 = 35.0 C) */
+            uint16_t temp_raw = 0;
+            if (collector->config.spi == NULL) {
+                break;
+            }
+            if (spi_read_register(collector->config.spi, FPGA_REG_TEMP, &temp_raw) != SPI_OK) {
+                if (!collector->temp_failing) {
+                    health_monitor_log(LOG_WARNING, "health", "Failed to read FPGA temperature");
+                    collector->temp_failing = true;
+                }
+                break;
+            }
+            collector->temp_failing = false;
+            status_write_begin();
+            atomic_store_explicit(&g_status.fpga_temp, temp_raw, memory_order_relaxed);
+            atomic_store_explicit(&g_status.read_ms[field], now, memory_order_relaxed);
+            status_write_end();
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Collector schedule clock (not mocked, unlike get_time_ms_impl)
+ */
+static uint64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static void *status_collector_thread(void *arg) {
+    health_status_collector_t *collector = (health_status_collector_t *)arg;
+    uint64_t due_ms[HEALTH_STATUS_FIELD_COUNT];
+
+    prctl(PR_SET_NAME, "health_status", 0, 0, 0);
+    if (collector->config.nice != 0) {
+        /* Linux: who = 0 is the calling thread */
+        setpriority(PRIO_PROCESS, 0, collector->config.nice);
+    }
+
+    /* Every field was read by health_monitor_start_status() */
+    uint64_t start = monotonic_ms();
+    for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+        due_ms[i] = start + collector->period_ms[i];
+    }
+
+    pthread_mutex_lock(&collector->lock);
+    while (!collector->stop) {
+        pthread_mutex_unlock(&collector->lock);
+
+        uint64_t now = monotonic_ms();
+        uint64_t next = UINT64_MAX;
+        for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+            if (now >= due_ms[i]) {
+                collect_status_field(collector, (health_status_field_t)i);
+                /* Skip missed periods rather than reading back to back */
+                due_ms[i] += collector->period_ms[i];
+                if (due_ms[i] <= now) {
+                    due_ms[i] = now + collector->period_ms[i];
+                }
+            }
+            next = (due_ms[i] < next) ? due_ms[i] : next;
+        }
+
+        now = monotonic_ms();
+        uint64_t wait_ms = (next > now) ? next - now : 0;
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += (time_t)(wait_ms / 1000U);
+        deadline.tv_nsec += (long)(wait_ms % 1000U) * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+
+        pthread_mutex_lock(&collector->lock);
+        if (!collector->stop && wait_ms > 0) {
+            pthread_cond_timedwait(&collector->cond, &collector->lock, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&collector->lock);
+
     return NULL;
 }
 
@@ -102,6 +445,13 @@ int health_monitor_init(void) {
     }
 
     memset(&g_health_ctx, 0, sizeof(g_health_ctx));
+    reset_stat_blocks();
+
+    pthread_mutex_lock(&g_series_lock);
+    memset(g_series, 0, sizeof(g_series));
+    pthread_mutex_unlock(&g_series_lock);
+
+    reset_status_snapshot();
 
     g_health_ctx.start_time = time(NULL);
     g_health_ctx.last_pet_ms = get_time_ms_impl();
@@ -124,6 +474,8 @@ void health_monitor_deinit(void) {
     }
 
     health_monitor_log(LOG_INFO, "health_monitor", "Health monitor shutting down");
+    health_monitor_stop_status();
+    health_monitor_stop_async_log();
 
     g_health_ctx.initialized = false;
 
@@ -144,7 +496,7 @@ void health_monitor_pet_watchdog(void) {
         if (elapsed > WATCHDOG_TIMEOUT_MS) {
             /* Watchdog timeout detected */
             g_health_ctx.is_alive = false;
-            g_health_ctx.stats.watchdog_resets++;
+            health_monitor_add_stat(HEALTH_STAT_WATCHDOG_RESETS, 1);
             health_monitor_log(LOG_WARNING, "health_monitor",
                              "Watchdog timeout detected (%llu ms)", elapsed);
         }
@@ -185,31 +537,170 @@ void health_monitor_get_stats(runtime_stats_t *stats) {
         return;
     }
 
-    memcpy(stats, &g_health_ctx.stats, sizeof(*stats));
+    collect_stats(stats);
 }
 
-void health_monitor_update_stat(const char *name, int64_t delta) {
-    if (name == NULL || !g_health_ctx.initialized) {
+void health_monitor_add_stat(health_stat_t stat, int64_t delta) {
+    if ((unsigned int)stat >= HEALTH_STAT_COUNT || !g_health_ctx.initialized) {
         return;
     }
 
-    uint64_t *stat = find_stat(name);
-    if (stat == NULL) {
-        /* Unknown statistic - ignore */
+    health_stat_block_t *block = t_stat_block;
+    if (block == NULL) {
+        block = claim_stat_block();
+    }
+
+    /* Negative deltas wrap; the total is summed and clamped on read */
+    atomic_uint_least64_t *counter = &block->counters[stat];
+    if (block == HM_SHARED_BLOCK) {
+        atomic_fetch_add_explicit(counter, (uint64_t)delta, memory_order_relaxed);
+    } else {
+        uint64_t value = atomic_load_explicit(counter, memory_order_relaxed);
+        atomic_store_explicit(counter, value + (uint64_t)delta, memory_order_relaxed);
+    }
+}
+
+uint64_t health_monitor_read_stat(health_stat_t stat) {
+    if ((unsigned int)stat >= HEALTH_STAT_COUNT) {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    for (uint32_t b = 0; b <= HEALTH_STAT_THREADS; b++) {
+        total += atomic_load_explicit(&g_stat_blocks[b].counters[stat], memory_order_relaxed);
+    }
+
+    return ((int64_t)total < 0) ? 0 : total;
+}
+
+void health_monitor_update_stat(const char *name, int64_t delta) {
+    if (name == NULL) {
         return;
     }
 
-    /* Handle negative deltas */
-    if (delta < 0) {
-        uint64_t abs_delta = (uint64_t)(-delta);
-        if (*stat >= abs_delta) {
-            *stat -= abs_delta;
-        } else {
-            *stat = 0;
+    for (uint32_t i = 0; i < HEALTH_STAT_COUNT; i++) {
+        if (strcmp(name, g_stat_names[i]) == 0) {
+            health_monitor_add_stat((health_stat_t)i, delta);
+            return;
+        }
+    }
+
+    /* Unknown statistic - ignore */
+}
+
+int health_monitor_record_metric(health_metric_t metric, float value) {
+    if (metric < 0 || metric >= HEALTH_METRIC_COUNT) {
+        return -EINVAL;
+    }
+
+    if (!g_health_ctx.initialized) {
+        return -EINVAL;
+    }
+
+    uint64_t now = get_time_ms_impl();
+    uint64_t interval = now - now % HEALTH_SERIES_INTERVAL_MS;
+
+    pthread_mutex_lock(&g_series_lock);
+
+    health_series_t *series = &g_series[metric];
+    health_point_t *point = &series->points[series->head];
+
+    if (series->count == 0 || point->time_ms != interval) {
+        /* New interval: advance (overwriting the oldest point when full) */
+        if (series->count > 0) {
+            series->head = (series->head + 1) % HEALTH_SERIES_LEN;
+            point = &series->points[series->head];
+        }
+        if (series->count < HEALTH_SERIES_LEN) {
+            series->count++;
         }
+        *point = (health_point_t){
+            .time_ms = interval, .mean = value, .min = value, .max = value, .samples = 1
+        };
     } else {
-        *stat += (uint64_t)delta;
+        point->samples++;
+        point->mean += (value - point->mean) / (float)point->samples;
+        point->min = (value < point->min) ? value : point->min;
+        point->max = (value > point->max) ? value : point->max;
+    }
+
+    pthread_mutex_unlock(&g_series_lock);
+    return 0;
+}
+
+int health_monitor_get_series(health_metric_t metric, health_point_t *points, uint32_t max) {
+    if (metric < 0 || metric >= HEALTH_METRIC_COUNT || points == NULL) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&g_series_lock);
+
+    const health_series_t *series = &g_series[metric];
+    uint32_t n = (series->count < max) ? series->count : max;
+    /* Oldest of the n newest points */
+    uint32_t index = (series->head + HEALTH_SERIES_LEN - (n - 1)) % HEALTH_SERIES_LEN;
+
+    for (uint32_t i = 0; i < n; i++) {
+        points[i] = series->points[index];
+        index = (index + 1) % HEALTH_SERIES_LEN;
+    }
+
+    pthread_mutex_unlock(&g_series_lock);
+    return (int)n;
+}
+
+const char *health_monitor_stat_name(health_stat_t stat) {
+    if (stat < 0 || stat >= HEALTH_STAT_COUNT) {
+        return "unknown";
+    }
+    return g_stat_names[stat];
+}
+
+const char *health_monitor_metric_name(health_metric_t metric) {
+    if (metric < 0 || metric >= HEALTH_METRIC_COUNT) {
+        return "unknown";
+    }
+    return g_metric_names[metric];
+}
+
+/**
+ * @brief Write one structured line to syslog
+ *
+ * Also the async logger's sink, so both paths produce the same line.
+ */
+static void write_log_line(int level, const char *module, uint64_t time_ns,
+                           const char *message, void *user_data) {
+    (void)user_data;
+
+    time_t seconds = (time_t)(time_ns / 1000000000ULL);
+    struct tm tm_info;
+    localtime_r(&seconds, &tm_info);
+
+    char timestamp[64];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm_info);
+
+    /* Structured log format: [timestamp] [module] [LEVEL] message */
+    syslog(log_level_to_syslog((log_level_t)level),
+           "[%s.%03u] [%s] [%s] %s",
+           timestamp, (unsigned int)((time_ns / 1000000ULL) % 1000ULL),
+           module, log_level_to_string((log_level_t)level), message);
+}
+
+int health_monitor_start_async_log(void) {
+    if (!g_health_ctx.initialized) {
+        return -1;
     }
+
+    alog_config_t config = {
+        .sink = write_log_line,
+        .notice_level = LOG_WARNING,
+        .nice = 10
+    };
+    return (alog_start(&config) == ALOG_OK) ? 0 : -1;
+}
+
+void health_monitor_stop_async_log(void) {
+    alog_stop();
 }
 
 void health_monitor_log(log_level_t level, const char *module, const char *format, ...) {
@@ -226,27 +717,26 @@ void health_monitor_log(log_level_t level, const char *module, const char *forma
         return;
     }
 
-    /* Get timestamp */
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    struct tm *tm_info = localtime(&tv.tv_sec);
+    va_list args;
+    va_start(args, format);
+    bool queued = alog_vlog((int)level, module, format, args);
+    va_end(args);
+    if (queued) {
+        return;
+    }
 
-    char timestamp[64];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm_info);
-    char timestamp_ms[128];
-    snprintf(timestamp_ms, sizeof(timestamp_ms), "%s.%03ld", timestamp, tv.tv_usec / 1000);
+    /* Synchronous path: async logger stopped or no ring free */
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
 
-    /* Format the message */
-    char message[1024];
-    va_list args;
+    char message[ALOG_MAX_MESSAGE];
     va_start(args, format);
     vsnprintf(message, sizeof(message), format, args);
     va_end(args);
 
-    /* Structured log format: [timestamp] [module] [LEVEL] message */
-    syslog(log_level_to_syslog(level),
-           "[%s] [%s] [%s] %s",
-           timestamp_ms, module, log_level_to_string(level), message);
+    write_log_line((int)level, module,
+                   (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec,
+                   message, NULL);
 }
 
 int health_monitor_get_status(system_status_t *status) {
@@ -258,72 +748,119 @@ int health_monitor_get_status(system_status_t *status) {
         return -EINVAL;
     }
 
-    /* Get current time for uptime calculation */
-    time_t now = time(NULL);
-    uint32_t uptime = (uint32_t)(now - g_health_ctx.start_time);
+    /* Collected fields: memory only, REQ-FW-112 */
+    uint64_t read_ms[HEALTH_STATUS_FIELD_COUNT];
+    uint32_t tries = 0;
+    for (;;) {
+        unsigned int seq = atomic_load_explicit(&g_status.seq, memory_order_acquire);
+        if ((seq & 1U) == 0) {
+            status->state = (uint8_t)atomic_load_explicit(&g_status.state, memory_order_relaxed);
+            status->battery_soc = (uint8_t)atomic_load_explicit(&g_status.battery_soc,
+                                                                memory_order_relaxed);
+            status->battery_mv = (uint16_t)atomic_load_explicit(&g_status.battery_mv,
+                                                                memory_order_relaxed);
+            status->fpga_temp = (uint16_t)atomic_load_explicit(&g_status.fpga_temp,
+                                                               memory_order_relaxed);
+            for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+                read_ms[i] = atomic_load_explicit(&g_status.read_ms[i], memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&g_status.seq, memory_order_relaxed) == seq) {
+                break;
+            }
+        } else {
+            /* Collector is mid-write; let it finish */
+            sched_yield();
+        }
+        if (++tries >= HM_STATUS_READ_TRIES) {
+            return -EAGAIN;
+        }
+    }
 
-    /* Fill status structure */
-    status->state = (uint8_t)seq_get_state();  /* Get current FSM state from sequence engine */
-    memcpy(&status->stats, &g_health_ctx.stats, sizeof(status->stats));
+    uint64_t now = get_time_ms_impl();
+    for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+        if (read_ms[i] == 0) {
+            status->age_ms[i] = HEALTH_STATUS_AGE_NONE;
+        } else {
+            uint64_t age = (now > read_ms[i]) ? now - read_ms[i] : 0;
+            status->age_ms[i] = (age < HEALTH_STATUS_AGE_NONE) ? (uint32_t)age
+                                                               : HEALTH_STATUS_AGE_NONE - 1;
+        }
+    }
 
-    /* Get battery metrics from BQ40z50 driver if available */
-    extern bq40z50_context_t *get_battery_context(void);
-    bq40z50_context_t *battery_ctx = get_battery_context();
+    collect_stats(&status->stats);
+    status->uptime_sec = (uint32_t)(time(NULL) - g_health_ctx.start_time);
 
-    if (battery_ctx != NULL && battery_ctx->initialized) {
-        /* Real implementation would read actual values:
-        bq40z50_get_soc(battery_ctx, &status->battery_soc);
-        bq40z50_get_voltage(battery_ctx, &status->battery_mv);
-        */
+    return 0;
+}
 
-        /* Mock implementation for testing */
-        static uint8_t mock_soc = 85;
-        static uint16_t mock_voltage = 3650;
+int health_monitor_start_status(const health_status_config_t *config) {
+    if (config == NULL || !g_health_ctx.initialized) {
+        return -EINVAL;
+    }
 
-        /* Simulate battery drain during operation */
-        mock_soc = (mock_soc > 5) ? mock_soc - 1 : 5;
-        mock_voltage = (mock_voltage > 3300) ? mock_voltage - 2 : 3300;
+    health_status_collector_t *collector = &g_collector;
+    pthread_mutex_lock(&collector->lock);
+    bool running = collector->running;
+    pthread_mutex_unlock(&collector->lock);
+    if (running) {
+        return -EBUSY;
+    }
 
-        status->battery_soc = mock_soc;
-        status->battery_mv = mock_voltage;
+    collector->config = *config;
+    collector->period_ms[HEALTH_STATUS_STATE] =
+        (config->state_ms != 0) ? config->state_ms : HEALTH_STATUS_STATE_MS;
+    collector->period_ms[HEALTH_STATUS_BATTERY] =
+        (config->battery_ms != 0) ? config->battery_ms : HEALTH_STATUS_BATTERY_MS;
+    collector->period_ms[HEALTH_STATUS_FPGA_TEMP] =
+        (config->temp_ms != 0) ? config->temp_ms : HEALTH_STATUS_TEMP_MS;
+    collector->temp_failing = false;
+    collector->battery_failing = false;
+    collector->stop = false;
+
+    /* GET_STATUS has real values from the first request on */
+    for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+        collect_status_field(collector, (health_status_field_t)i);
+    }
 
-        health_monitor_log(LOG_DEBUG, "health",
-                         "Battery: %u%%, %umV", status->battery_soc, status->battery_mv);
-    } else {
-        /* Default values when battery monitoring unavailable */
-        status->battery_soc = 100;
-        status->battery_mv = 3700;
-    }
-
-    status->uptime_sec = uptime;
-
-    /* Get FPGA temperature from SPI registers */
-    /* REQ-FW-070: FPGA thermal monitoring */
-    extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
-
-    if (g_spi_master != NULL) {
-        uint16_t temp_raw = 0;
-        spi_status_t spi_result = spi_read_register(g_spi_master, FPGA_REG_TEMP, &temp_raw);
-        if (spi_result == SPI_OK) {
-            /* Temperature is in 0.1 C units (e.g., 350 = 35.0 C) */
-            status->fpga_temp = temp_raw;
-            health_monitor_log(LOG_DEBUG, "health",
-                             "FPGA temperature: %u.%u C",
-                             temp_raw / 10, temp_raw % 10);
-        } else {
-            /* Use default temperature on SPI read failure */
-            status->fpga_temp = 350;  /* Default: 35.0 C */
-            health_monitor_log(LOG_WARNING, "health",
-                             "Failed to read FPGA temperature, using default");
-        }
-    } else {
-        /* SPI not available, use default */
-        status->fpga_temp = 350;  /* Default: 35.0 C */
+    /* Explicit SCHED_OTHER: never inherit an RT policy from the caller */
+    pthread_attr_t attr;
+    struct sched_param param = { .sched_priority = 0 };
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    pthread_attr_setschedparam(&attr, &param);
+    int rc = pthread_create(&collector->thread, &attr, status_collector_thread, collector);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        return -rc;
     }
 
+    pthread_mutex_lock(&collector->lock);
+    collector->running = true;
+    pthread_mutex_unlock(&collector->lock);
     return 0;
 }
 
+void health_monitor_stop_status(void) {
+    health_status_collector_t *collector = &g_collector;
+
+    pthread_mutex_lock(&collector->lock);
+    if (!collector->running) {
+        pthread_mutex_unlock(&collector->lock);
+        return;
+    }
+    collector->stop = true;
+    pthread_cond_signal(&collector->cond);
+    pthread_mutex_unlock(&collector->lock);
+
+    pthread_join(collector->thread, NULL);
+
+    pthread_mutex_lock(&collector->lock);
+    collector->running = false;
+    pthread_mutex_unlock(&collector->lock);
+}
+
 int health_monitor_set_log_level(log_level_t level) {
     if (level < LOG_DEBUG || level > LOG_CRITICAL) {
         return -EINVAL;
@@ -369,4 +906,12 @@ void mock_set_time_ms(uint64_t time_ms) {
 uint64_t mock_get_time_ms(void) {
     return health_get_time_ms();
 }
+
+uint32_t health_stat_blocks_owned(void) {
+    uint32_t owned = 0;
+    for (uint32_t b = 0; b < HEALTH_STAT_THREADS; b++) {
+        owned += atomic_load_explicit(&g_stat_blocks[b].owned, memory_order_relaxed) ? 1 : 0;
+    }
+    return owned;
+}
 #endif
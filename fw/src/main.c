@@ -10,7 +10,8 @@
  *
  * Architecture:
  * - 5 threads: SPI control, CSI-2 RX, Ethernet TX, Command, Health Monitor
- * - Signal handling: SIGTERM, SIGINT (graceful shutdown), SIGHUP (reload config)
+ * - Signal handling: SIGTERM, SIGINT (graceful shutdown), SIGHUP (reload config),
+ *   SIGUSR2 (start / stop-and-dump tracing)
  * - Privilege drop: root → detector user
  * - Capability retention: CAP_NET_BIND_SERVICE, CAP_SYS_NICE
  *
@@ -47,6 +48,26 @@
 #include "sequence_engine.h"
 #include "frame_manager.h"
 #include "protocol/command_protocol.h"
+#include "proc/correction.h"
+#include "proc/descramble.h"
+#include "proc/orientation.h"
+#include "proc/pixel_drift.h"
+#include "proc/window_level.h"
+#include "proc/calibration.h"
+#include "proc/defect_map.h"
+#include "proc/frame_stats.h"
+#include "proc/frame_qa.h"
+#include "proc/hdr_fusion.h"
+#include "proc/exposure_gate.h"
+#include "util/trace.h"
+#include "metrics_exporter.h"
+#include "util/stats_page.h"
+#include "proc/auto_exposure.h"
+#include "proc/saturation.h"
+#include "proc/temporal_filter.h"
+#include "proc/pipeline.h"
+#include "util/thread_pool.h"
+#include "util/cpu_dispatch.h"
 
 /* ==========================================================================
  * Constants
@@ -57,6 +78,7 @@
 #define CONFIG_PATH "/etc/detector/detector_config.yaml"
 #define LOG_FILE "/var/log/detector/daemon.log"
 #define PID_FILE "/var/run/detector_daemon.pid"
+#define TRACE_DUMP_FILE "/var/log/detector/trace.dtrc"
 
 /* User and group */
 #define DETECTOR_USER "detector"
@@ -69,6 +91,24 @@
 #define THREAD_PRIORITY_CMD        50    /* Normal: Command processing */
 #define THREAD_PRIORITY_HEALTH     40    /* Low: Health monitoring */
 
+/* Image processing pool: TX thread plus workers pinned to cores 1-3 */
+#define PROC_POOL_THREADS          4
+#define PROC_POOL_CPU_MASK         0x0F
+
+/* Processing pipeline (stage threads run at TX priority) */
+#define PIPE_DRAIN_TIMEOUT_MS      1000
+#define PIPE_FLAG_EXPOSURE_MOVED   (1U << 0)  /* Protection changed exposure */
+
+/* Random data sets per kernel variant for --kernel-selftest */
+#define KERNEL_SELFTEST_ROUNDS     256
+
+/* Metrics endpoint (metrics: section) */
+#define METRICS_THREAD_NICE        10
+#define STATS_PAGE_THREAD_NICE     10
+
+/* GET_STATUS collector (status: section) */
+#define STATUS_THREAD_NICE         10
+
 /* ==========================================================================
  * Types
  * ========================================================================== */
@@ -96,6 +136,14 @@ typedef enum {
     DAEMON_STATE_ERROR,
 } daemon_state_t;
 
+/**
+ * @brief Per-frame metadata carried in pipe_frame_t.meta
+ */
+typedef struct {
+    fqa_result_t qa;        /* Image QA metrics */
+    bool qa_valid;          /* qa was computed for this frame */
+} frame_meta_t;
+
 /**
  * @brief Main daemon context
  */
@@ -112,6 +160,8 @@ typedef struct {
     /* Threads */
     pthread_t threads[THREAD_COUNT];
     pthread_mutex_t state_mutex;
+    pthread_mutex_t tx_wake_mutex;  /* Guards tx_wake_cond */
+    pthread_cond_t tx_wake_cond;    /* Signalled on start-of-frame */
 
     /* Module contexts */
     spi_master_t *spi_ctx;
@@ -120,12 +170,40 @@ typedef struct {
     bq40z50_context_t battery_ctx;
     sequence_engine_t seq_eng;
     frame_manager_t frame_mgr;
+    descramble_t *descramble;              /* Readout copy plan (NULL = image order) */
+    orientation_t *orientation;            /* Mounting transform (NULL = none) */
+    eth_tx_t *outputs[CONFIG_MAX_OUTPUTS]; /* network.outputs consumer streams */
+    window_level_t *display;               /* 8-bit conversion (NULL = no display8 output) */
+    uint8_t *display_buf;                  /* 8-bit frame shared by display8 outputs */
+    fstats_t display_stats;                /* Auto-window histogram of the output frame */
     command_context_t cmd_ctx;
     health_monitor_context_t *health_ctx;  /* Singleton */
+    correction_t *correction;              /* Offset/gain stage (NULL if disabled) */
+    calib_t *calib;                        /* Calibration accumulator */
+    defect_map_t *defects;                 /* Defect pixel map (NULL if disabled) */
+    ae_controller_t *ae;                   /* Auto-exposure (NULL if disabled) */
+    bool ae_active;                        /* AE synced to current continuous scan */
+    fstats_config_t stats_config;          /* Per-frame statistics geometry/ROI */
+    fstats_t frame_stats;                  /* Last frame statistics */
+    bool stats_band;                       /* frame_stats accumulating band by band */
+    frame_qa_t *frame_qa;                  /* Image QA metrics (NULL if disabled) */
+    bool qa_band;                          /* frame_qa accumulating band by band */
+    hdr_fusion_t *hdr;                     /* Dual-gain HDR fusion (NULL if disabled) */
+    exposure_gate_t *gate;                 /* Empty-frame gate (NULL if disabled) */
+    sat_counter_t *saturation;             /* Overexposure detector (NULL if disabled) */
+    bool overexposure_raised;              /* EVT_OVEREXPOSURE sent for current frame */
+    tf_filter_t *tfilter;                  /* Temporal filter (NULL if unavailable) */
+    pixel_drift_t *drift;                  /* Dark drift tracker (NULL if disabled) */
+    bool tf_scan;                          /* Filter reset for current continuous scan */
+    bool tf_active;                        /* Filter enabled for current scan */
+    tp_pool_t *pool;                       /* Processing pool (NULL = stage thread only) */
+    pipe_registry_t *stages;               /* Processing stages by name */
+    pipeline_t *pipe;                      /* Pipeline for pipe_mode (NULL if build failed) */
+    int pipe_mode;                         /* Scan mode pipe was built for (-1 = none) */
+    stats_page_t *stats_page;              /* Shared-memory statistics (NULL if unavailable) */
 
     /* Statistics */
-    uint64_t start_time_ms;
-    uint32_t uptime_sec;
+    uint64_t start_time_ms;                /* Set before any thread starts */
 } daemon_context_t;
 
 /* ==========================================================================
@@ -135,6 +213,10 @@ typedef struct {
 static daemon_context_t g_daemon_ctx = {0};
 static volatile sig_atomic_t g_signal_received = 0;
 
+/* Latency histograms served by the metrics endpoint */
+static metrics_histogram_t g_frame_latency_hist;   /* Pipeline submit to buffer release */
+static metrics_histogram_t g_tx_send_hist;         /* Primary stream send */
+
 /* Global SPI master context for FPGA register access */
 spi_master_t *g_spi_master = NULL;
 
@@ -170,6 +252,11 @@ static void signal_handler(int signo) {
             g_signal_received = signo;
             break;
 
+        case SIGUSR2:
+            /* Toggle tracing */
+            g_signal_received = signo;
+            break;
+
         default:
             break;
     }
@@ -207,6 +294,11 @@ static int setup_signal_handlers(void) {
         return -1;
     }
 
+    if (sigaction(SIGUSR2, &sa, NULL) < 0) {
+        perror("sigaction SIGUSR2");
+        return -1;
+    }
+
     /* Ignore SIGPIPE (write to broken socket) */
     signal(SIGPIPE, SIG_IGN);
 
@@ -278,129 +370,1439 @@ static int drop_privileges(void) {
         return -1;
     }
 
-    /* Set GID to detector group */
-    if (setgid(gr->gr_gid) < 0) {
-        syslog(LOG_ERR, "setgid failed: %m");
-        return -1;
+    /* Set GID to detector group */
+    if (setgid(gr->gr_gid) < 0) {
+        syslog(LOG_ERR, "setgid failed: %m");
+        return -1;
+    }
+
+    /* Set UID to detector user */
+    if (setuid(pw->pw_uid) < 0) {
+        syslog(LOG_ERR, "setuid failed: %m");
+        return -1;
+    }
+
+    /* Verify privilege drop succeeded */
+    if (setuid(0) == 0) {
+        syslog(LOG_ERR, "Privilege drop failed - still have root access");
+        return -1;
+    }
+
+    syslog(LOG_INFO, "Privileges dropped to user '%s' (UID %d, GID %d)",
+           DETECTOR_USER, pw->pw_uid, gr->gr_gid);
+
+    return 0;
+}
+
+/* ==========================================================================
+ * Thread Entry Points (DDD)
+ * ========================================================================== */
+
+/**
+ * @brief Set thread realtime priority
+ */
+static int set_thread_priority(pthread_t thread, int priority) {
+    struct sched_param param;
+
+    param.sched_priority = priority;
+
+    if (pthread_setschedparam(thread, SCHED_FIFO, &param) != 0) {
+        perror("pthread_setschedparam");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief SPI control thread
+ *
+ * Polls FPGA STATUS register at 100us interval (SCHED_FIFO priority 80)
+ * REQ-FW-030: SPI communication with FPGA
+ */
+static void *spi_control_thread(void *arg) {
+    daemon_context_t *ctx = (daemon_context_t *)arg;
+
+    prctl(PR_SET_NAME, "spi_ctrl", 0, 0, 0);
+
+    while (ctx->running && !ctx->shutdown_requested) {
+        /* Poll FPGA STATUS register */
+        uint8_t fpga_status = 0x04; /* Default: READY (mock implementation) */
+        uint32_t error_count = 0;
+
+        /* Real implementation would read SPI:
+        spi_status_t spi_result = spi_master_read_status(&ctx->spi_ctx);
+        if (spi_result.status == SPI_OK) {
+            fpga_status = spi_result.reg_value;
+        } else {
+            error_count++;
+            health_monitor_add_stat(HEALTH_STAT_SPI_ERRORS, 1);
+        }
+        */
+
+        /* Check FPGA status bits */
+        if (fpga_status & FPGA_STATUS_ERROR) {
+            health_monitor_log(LOG_WARNING, "spi", "FPGA error detected (status=0x%02X)", fpga_status);
+            error_count++;
+            health_monitor_add_stat(HEALTH_STAT_SPI_ERRORS, 1);
+        }
+
+        if (fpga_status & FPGA_STATUS_BUSY) {
+            /* FPGA is busy processing */
+            health_monitor_add_stat(HEALTH_STAT_FRAMES_RECEIVED, 1);
+        } else {
+            /* FPGA is idle and ready for next command */
+            health_monitor_log(LOG_DEBUG, "spi", "FPGA ready (status=0x%02X)", fpga_status);
+        }
+
+        /* Update SPI error statistics */
+        if (error_count > 0) {
+            health_monitor_add_stat(HEALTH_STAT_SPI_ERRORS, error_count);
+        }
+
+        usleep(100);  /* 100us */
+    }
+
+    health_monitor_log(LOG_INFO, "spi_thread", "SPI control thread exiting");
+    return NULL;
+}
+
+/**
+ * @brief Start-of-frame handler (CSI-2 frame-sync event)
+ *
+ * Runs in the CSI-2 RX thread as soon as the FPGA starts a frame, a full
+ * frame period before DQBUF. Lets the sequence engine record the
+ * exposure-aligned timestamp and the TX path build its header template
+ * and wake up before the frame is committed.
+ */
+static void csi2_sof_handler(const csi2_event_t *event, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    seq_frame_start_t frame_start = {
+        .sequence = event->sequence,
+        .timestamp_ns = event->timestamp
+    };
+    seq_handle_event(EVT_FRAME_START, &frame_start);
+
+    /* frame_mgr numbers frames by CSI-2 sequence, so the TX path looks
+     * this template up under the same number */
+    eth_tx_prepare_frame(ctx->eth_ctx.handle,
+                         event->sequence,
+                         ctx->config.detector.cols,
+                         ctx->config.detector.rows,
+                         ctx->config.detector.bit_depth,
+                         event->timestamp);
+
+    pthread_mutex_lock(&ctx->tx_wake_mutex);
+    pthread_cond_signal(&ctx->tx_wake_cond);
+    pthread_mutex_unlock(&ctx->tx_wake_mutex);
+}
+
+/**
+ * @brief CSI-2 RX thread
+ *
+ * Receives frames via V4L2 DQBUF
+ * REQ-FW-020: MIPI CSI-2 reception
+ */
+static void *csi2_rx_thread(void *arg) {
+    daemon_context_t *ctx = (daemon_context_t *)arg;
+
+    prctl(PR_SET_NAME, "csi2_rx", 0, 0, 0);
+
+    bool frame_sync = (csi2_rx_get_subscribed_events(ctx->csi2_ctx) & CSI2_EVENT_FRAME_SYNC) != 0;
+    if (frame_sync) {
+        csi2_rx_set_sof_callback(ctx->csi2_ctx, csi2_sof_handler, ctx);
+    } else {
+        health_monitor_log(LOG_WARNING, "csi2_thread",
+                         "Frame-sync events not supported, using DQBUF timestamps");
+    }
+
+    while (ctx->running && !ctx->shutdown_requested) {
+        /* Drain start-of-frame events ahead of the buffer */
+        if (frame_sync) {
+            csi2_event_t event;
+            while (csi2_rx_wait_event(ctx->csi2_ctx, &event, -1) == CSI2_OK) {
+                /* Dispatched via csi2_sof_handler */
+            }
+        }
+
+        /* Dequeue frame from V4L2 */
+        /* TODO: Implement V4L2 DQBUF */
+
+        usleep(1000);  /* 1ms */
+    }
+
+    health_monitor_log(LOG_INFO, "csi2_thread", "CSI-2 RX thread exiting");
+    return NULL;
+}
+
+/**
+ * @brief Load calibration maps into the correction stage
+ *
+ * @return 0 on success, -errno on failure
+ */
+static int load_correction_maps(daemon_context_t *ctx, const uint16_t *offset, const float *gain) {
+    size_t pixels = (size_t)ctx->config.detector.rows * ctx->config.detector.cols;
+
+    if (correction_set_offset_map(ctx->correction, offset, pixels) != CORR_OK ||
+        correction_set_gain_map(ctx->correction, gain, pixels) != CORR_OK) {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Raise EVT_OVEREXPOSURE once per frame when the saturation counter trips
+ *
+ * Continuous scans only: a single exposure has no following frame to
+ * protect. Called between bands so the response goes out before the rest
+ * of the frame has been processed.
+ */
+static void overexposure_check(daemon_context_t *ctx) {
+    if (ctx->overexposure_raised || !saturation_tripped(ctx->saturation) ||
+        seq_get_mode() != SCAN_MODE_CONTINUOUS) {
+        return;
+    }
+
+    sat_frame_t partial;
+    saturation_get_frame(ctx->saturation, &partial);
+
+    seq_overexposure_t event = {
+        .saturated = partial.saturated,
+        .tiles_over = partial.tiles_over,
+        .action = (seq_overexposure_action_t)ctx->config.overflow_action
+    };
+
+    ctx->overexposure_raised = true;
+    if (seq_handle_event(EVT_OVEREXPOSURE, &event) != 0) {
+        health_monitor_log(LOG_ERROR, "protect", "Overexposure response failed");
+    }
+}
+
+/**
+ * @brief Sync the temporal filter with the current scan
+ *
+ * Continuous scans only. The filter history is dropped (and parameters
+ * staged via CMD_CONFIG_TEMPORAL applied) on the first frame of every
+ * continuous scan, so lag never carries over a mode change or a restart.
+ *
+ * @return true if the frame should be filtered
+ */
+static bool tfilter_scan_check(daemon_context_t *ctx) {
+    if (ctx->tfilter == NULL || seq_get_mode() != SCAN_MODE_CONTINUOUS) {
+        ctx->tf_scan = false;
+        ctx->tf_active = false;
+        return false;
+    }
+
+    if (!ctx->tf_scan) {
+        temporal_filter_reset(ctx->tfilter);
+        ctx->tf_scan = true;
+        ctx->tf_active = temporal_filter_enabled(ctx->tfilter);
+    }
+
+    return ctx->tf_active;
+}
+
+/**
+ * @brief CMD_SET_CONFIG handler for CMD_CONFIG_TEMPORAL
+ *
+ * Data is one tf_params_t. Takes effect at the start of the next
+ * continuous scan.
+ */
+static int temporal_config_handler(uint8_t flags, const uint8_t *data,
+                                   size_t len, void *user_data) {
+    (void)flags;
+
+    if (len != sizeof(tf_params_t)) {
+        return -EINVAL;
+    }
+
+    tf_params_t params;
+    memcpy(&params, data, sizeof(params));
+
+    if (temporal_filter_set_params((tf_filter_t *)user_data, &params) != TF_OK) {
+        return -EINVAL;
+    }
+
+    health_monitor_log(LOG_INFO, "tfilter", "Temporal filter %s (alpha %u/256, motion %u) from next scan",
+                     params.enabled ? "enabled" : "disabled", params.alpha, params.motion_threshold);
+    return 0;
+}
+
+/**
+ * @brief Start tracing, or stop it and write the rings to TRACE_DUMP_FILE
+ *
+ * @return 0 on success, negative error code on failure
+ */
+static int trace_toggle(bool enable) {
+    if (enable) {
+        if (trace_start() != TRACE_OK) {
+            health_monitor_log(LOG_WARNING, "trace", "Tracing unavailable");
+            return -ENODEV;
+        }
+        health_monitor_log(LOG_INFO, "trace", "Tracing started");
+        return 0;
+    }
+
+    trace_stop();
+    trace_stats_t stats;
+    trace_get_stats(&stats);
+    if (trace_dump(TRACE_DUMP_FILE) != TRACE_OK) {
+        health_monitor_log(LOG_WARNING, "trace", "Failed to write " TRACE_DUMP_FILE);
+        return -EIO;
+    }
+    health_monitor_log(LOG_INFO, "trace", "Tracing stopped: %llu events (%llu overwritten) in " TRACE_DUMP_FILE,
+                     (unsigned long long)stats.recorded, (unsigned long long)stats.overwritten);
+    return 0;
+}
+
+/**
+ * @brief CMD_SET_CONFIG handler for CMD_CONFIG_TRACE
+ *
+ * Data is one byte: 1 starts tracing, 0 stops it and writes the dump.
+ */
+static int trace_config_handler(uint8_t flags, const uint8_t *data,
+                                size_t len, void *user_data) {
+    (void)flags;
+    (void)user_data;
+
+    if (len != 1 || data[0] > 1) {
+        return -EINVAL;
+    }
+    return trace_toggle(data[0] == 1);
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Seconds since the daemon started
+ */
+static uint32_t daemon_uptime_sec(const daemon_context_t *ctx) {
+    return (uint32_t)((uint64_t)time(NULL) - ctx->start_time_ms / 1000);
+}
+
+/**
+ * @brief Metrics endpoint collect callback (exporter thread)
+ *
+ * Every source is an atomic counter or histogram (health counter blocks,
+ * frame manager, Ethernet TX, SPI and sequence engine statistics), so a
+ * scrape never takes a lock the RT threads use or touches SPI or I2C.
+ */
+static void collect_metrics(metrics_writer_t *writer, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+    char name[64];
+
+    for (int i = 0; i < HEALTH_STAT_COUNT; i++) {
+        snprintf(name, sizeof(name), "detector_%s", health_monitor_stat_name((health_stat_t)i));
+        metrics_write_counter(writer, name, NULL, health_monitor_read_stat((health_stat_t)i));
+    }
+
+    frame_stats_t frames;
+    frame_mgr_get_stats(&frames);
+    metrics_write_counter(writer, "detector_frame_mgr_frames_received", "Frames into the frame buffers",
+                          frames.frames_received);
+    metrics_write_counter(writer, "detector_frame_mgr_frames_sent", NULL, frames.frames_sent);
+    metrics_write_counter(writer, "detector_frame_mgr_frames_dropped", "Oldest-drop evictions",
+                          frames.frames_dropped);
+    metrics_write_counter(writer, "detector_frame_mgr_overruns", NULL, frames.overruns);
+
+    eth_tx_stats_t tx;
+    if (ctx->eth_ctx.handle != NULL && eth_tx_get_stats(ctx->eth_ctx.handle, &tx) == ETH_TX_OK) {
+        metrics_write_counter(writer, "detector_eth_tx_frames_sent", NULL, tx.frames_sent);
+        metrics_write_counter(writer, "detector_eth_tx_packets_sent", NULL, tx.packets_sent);
+        metrics_write_counter(writer, "detector_eth_tx_bytes_sent", NULL, tx.bytes_sent);
+        metrics_write_counter(writer, "detector_eth_tx_send_errors", NULL, tx.send_errors);
+        metrics_write_counter(writer, "detector_eth_tx_frames_dropped", NULL, tx.frames_dropped);
+    }
+    metrics_write_histogram(writer, "detector_eth_tx_send_seconds",
+                            "Primary stream send time per frame", &g_tx_send_hist);
+
+    uint32_t spi_writes, spi_reads, spi_write_errors, spi_read_errors;
+    if (ctx->spi_ctx != NULL &&
+        spi_get_stats(ctx->spi_ctx, &spi_writes, &spi_reads,
+                      &spi_write_errors, &spi_read_errors) == SPI_OK) {
+        metrics_write_counter(writer, "detector_spi_writes", NULL, spi_writes);
+        metrics_write_counter(writer, "detector_spi_reads", NULL, spi_reads);
+        metrics_write_counter(writer, "detector_spi_write_errors", NULL, spi_write_errors);
+        metrics_write_counter(writer, "detector_spi_read_errors", NULL, spi_read_errors);
+    }
+
+    seq_stats_t seq;
+    if (seq_get_stats(&seq) == 0) {
+        metrics_write_counter(writer, "detector_seq_frames_received", NULL, seq.frames_received);
+        metrics_write_counter(writer, "detector_seq_frames_sent", NULL, seq.frames_sent);
+        metrics_write_counter(writer, "detector_seq_errors", NULL, seq.errors);
+        metrics_write_counter(writer, "detector_seq_retries", NULL, seq.retries);
+        metrics_write_counter(writer, "detector_seq_overexposures", NULL, seq.overexposures);
+    }
+
+    seq_state_t state = seq_get_state();
+    metrics_write_family(writer, "detector_seq_state", "gauge", "1 for the current sequence state");
+    for (int s = 0; s < SEQ_STATE_MAX; s++) {
+        metrics_write_sample(writer, "detector_seq_state", "state",
+                             seq_state_to_string((seq_state_t)s), (s == (int)state) ? 1 : 0);
+    }
+
+    metrics_write_histogram(writer, "detector_frame_latency_seconds",
+                            "Pipeline submit to buffer release", &g_frame_latency_hist);
+    metrics_write_gauge(writer, "detector_uptime_seconds", NULL, daemon_uptime_sec(ctx));
+}
+
+/**
+ * @brief Stats page entries after the HEALTH_STAT_COUNT runtime counters
+ */
+enum {
+    PAGE_FRAME_MGR_RECEIVED = HEALTH_STAT_COUNT,
+    PAGE_FRAME_MGR_SENT,
+    PAGE_FRAME_MGR_DROPPED,
+    PAGE_FRAME_MGR_OVERRUNS,
+    PAGE_ETH_FRAMES_SENT,
+    PAGE_ETH_PACKETS_SENT,
+    PAGE_ETH_BYTES_SENT,
+    PAGE_ETH_SEND_ERRORS,
+    PAGE_ETH_FRAMES_DROPPED,
+    PAGE_ETH_SEND_COUNT,
+    PAGE_ETH_SEND_SUM_NS,
+    PAGE_SPI_WRITES,
+    PAGE_SPI_READS,
+    PAGE_SPI_WRITE_ERRORS,
+    PAGE_SPI_READ_ERRORS,
+    PAGE_SEQ_FRAMES_RECEIVED,
+    PAGE_SEQ_FRAMES_SENT,
+    PAGE_SEQ_ERRORS,
+    PAGE_SEQ_RETRIES,
+    PAGE_SEQ_OVEREXPOSURES,
+    PAGE_SEQ_STATE,
+    PAGE_FRAME_LATENCY_COUNT,
+    PAGE_FRAME_LATENCY_SUM_NS,
+    PAGE_UPTIME_SEC,
+    PAGE_ENTRY_COUNT
+};
+
+static const stats_page_entry_t k_page_entries[PAGE_ENTRY_COUNT] = {
+    [PAGE_FRAME_MGR_RECEIVED]   = { "frame_mgr_frames_received", STATS_PAGE_COUNTER, 0 },
+    [PAGE_FRAME_MGR_SENT]       = { "frame_mgr_frames_sent", STATS_PAGE_COUNTER, 0 },
+    [PAGE_FRAME_MGR_DROPPED]    = { "frame_mgr_frames_dropped", STATS_PAGE_COUNTER, 0 },
+    [PAGE_FRAME_MGR_OVERRUNS]   = { "frame_mgr_overruns", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_FRAMES_SENT]      = { "eth_tx_frames_sent", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_PACKETS_SENT]     = { "eth_tx_packets_sent", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_BYTES_SENT]       = { "eth_tx_bytes_sent", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_SEND_ERRORS]      = { "eth_tx_send_errors", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_FRAMES_DROPPED]   = { "eth_tx_frames_dropped", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_SEND_COUNT]       = { "eth_tx_send_count", STATS_PAGE_COUNTER, 0 },
+    [PAGE_ETH_SEND_SUM_NS]      = { "eth_tx_send_sum_ns", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SPI_WRITES]           = { "spi_writes", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SPI_READS]            = { "spi_reads", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SPI_WRITE_ERRORS]     = { "spi_write_errors", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SPI_READ_ERRORS]      = { "spi_read_errors", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_FRAMES_RECEIVED]  = { "seq_frames_received", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_FRAMES_SENT]      = { "seq_frames_sent", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_ERRORS]           = { "seq_errors", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_RETRIES]          = { "seq_retries", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_OVEREXPOSURES]    = { "seq_overexposures", STATS_PAGE_COUNTER, 0 },
+    [PAGE_SEQ_STATE]            = { "seq_state", STATS_PAGE_GAUGE, 0 },
+    [PAGE_FRAME_LATENCY_COUNT]  = { "frame_latency_count", STATS_PAGE_COUNTER, 0 },
+    [PAGE_FRAME_LATENCY_SUM_NS] = { "frame_latency_sum_ns", STATS_PAGE_COUNTER, 0 },
+    [PAGE_UPTIME_SEC]           = { "uptime_sec", STATS_PAGE_GAUGE, 0 },
+};
+
+/**
+ * @brief Observations and their sum in a latency histogram
+ */
+static void histogram_totals(const metrics_histogram_t *hist, uint64_t *count, uint64_t *sum_ns) {
+    *count = 0;
+    for (uint32_t i = 0; i <= hist->buckets; i++) {
+        *count += atomic_load_explicit(&hist->counts[i], memory_order_relaxed);
+    }
+    *sum_ns = atomic_load_explicit(&hist->sum_ns, memory_order_relaxed);
+}
+
+/**
+ * @brief Stats page fill callback (publisher thread, every metrics_page_ms)
+ *
+ * Same sources as collect_metrics(): atomic counters and histograms only,
+ * so the 10 ms publish never waits on the SPI lock, the sequence engine
+ * or a frame being sent, and never reads a half-updated stats struct.
+ */
+static void fill_stats_page(uint64_t *values, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    for (int i = 0; i < HEALTH_STAT_COUNT; i++) {
+        values[i] = health_monitor_read_stat((health_stat_t)i);
+    }
+
+    frame_stats_t frames;
+    frame_mgr_get_stats(&frames);
+    values[PAGE_FRAME_MGR_RECEIVED] = frames.frames_received;
+    values[PAGE_FRAME_MGR_SENT] = frames.frames_sent;
+    values[PAGE_FRAME_MGR_DROPPED] = frames.frames_dropped;
+    values[PAGE_FRAME_MGR_OVERRUNS] = frames.overruns;
+
+    eth_tx_stats_t tx = { 0 };
+    if (ctx->eth_ctx.handle != NULL) {
+        eth_tx_get_stats(ctx->eth_ctx.handle, &tx);
+    }
+    values[PAGE_ETH_FRAMES_SENT] = tx.frames_sent;
+    values[PAGE_ETH_PACKETS_SENT] = tx.packets_sent;
+    values[PAGE_ETH_BYTES_SENT] = tx.bytes_sent;
+    values[PAGE_ETH_SEND_ERRORS] = tx.send_errors;
+    values[PAGE_ETH_FRAMES_DROPPED] = tx.frames_dropped;
+    histogram_totals(&g_tx_send_hist, &values[PAGE_ETH_SEND_COUNT], &values[PAGE_ETH_SEND_SUM_NS]);
+
+    uint32_t spi[4] = { 0 };
+    if (ctx->spi_ctx != NULL) {
+        spi_get_stats(ctx->spi_ctx, &spi[0], &spi[1], &spi[2], &spi[3]);
+    }
+    values[PAGE_SPI_WRITES] = spi[0];
+    values[PAGE_SPI_READS] = spi[1];
+    values[PAGE_SPI_WRITE_ERRORS] = spi[2];
+    values[PAGE_SPI_READ_ERRORS] = spi[3];
+
+    seq_stats_t seq = { 0 };
+    seq_get_stats(&seq);
+    values[PAGE_SEQ_FRAMES_RECEIVED] = seq.frames_received;
+    values[PAGE_SEQ_FRAMES_SENT] = seq.frames_sent;
+    values[PAGE_SEQ_ERRORS] = seq.errors;
+    values[PAGE_SEQ_RETRIES] = seq.retries;
+    values[PAGE_SEQ_OVEREXPOSURES] = seq.overexposures;
+    values[PAGE_SEQ_STATE] = stats_page_gauge((double)seq_get_state());
+
+    histogram_totals(&g_frame_latency_hist, &values[PAGE_FRAME_LATENCY_COUNT],
+                     &values[PAGE_FRAME_LATENCY_SUM_NS]);
+    values[PAGE_UPTIME_SEC] = stats_page_gauge((double)daemon_uptime_sec(ctx));
+}
+
+/**
+ * @brief Publish statistics to shared memory for detector-stat and other readers
+ */
+static void start_stats_page(daemon_context_t *ctx) {
+    stats_page_entry_t entries[PAGE_ENTRY_COUNT];
+
+    memcpy(entries, k_page_entries, sizeof(entries));
+    for (int i = 0; i < HEALTH_STAT_COUNT; i++) {
+        snprintf(entries[i].name, sizeof(entries[i].name), "%s",
+                 health_monitor_stat_name((health_stat_t)i));
+        entries[i].type = STATS_PAGE_COUNTER;
+    }
+
+    stats_page_config_t config = {
+        .name = STATS_PAGE_DEFAULT_NAME,
+        .entries = entries,
+        .entry_count = PAGE_ENTRY_COUNT,
+        .fill = fill_stats_page,
+        .user_data = ctx,
+        .period_ms = ctx->config.metrics_page_ms,
+        .nice = STATS_PAGE_THREAD_NICE
+    };
+
+    ctx->stats_page = stats_page_create(&config);
+    if (ctx->stats_page == NULL) {
+        health_monitor_log(LOG_WARNING, "metrics", "Shared-memory stats page unavailable");
+    }
+}
+
+/**
+ * @brief Start the metrics endpoint if metrics.port is set
+ */
+static void start_metrics(daemon_context_t *ctx) {
+    static const uint64_t latency_bounds_ns[] = {
+        1000000, 2000000, 5000000, 10000000, 20000000, 50000000,
+        100000000, 200000000, 500000000, 1000000000
+    };
+    static const uint64_t send_bounds_ns[] = {
+        100000, 200000, 500000, 1000000, 2000000, 5000000,
+        10000000, 20000000, 50000000, 100000000
+    };
+
+    metrics_histogram_init(&g_frame_latency_hist, latency_bounds_ns,
+                           sizeof(latency_bounds_ns) / sizeof(latency_bounds_ns[0]));
+    metrics_histogram_init(&g_tx_send_hist, send_bounds_ns,
+                           sizeof(send_bounds_ns) / sizeof(send_bounds_ns[0]));
+
+    if (ctx->config.metrics_port == 0) {
+        return;
+    }
+
+    metrics_config_t config = {
+        .listen_addr = (ctx->config.metrics_listen[0] != '\0') ? ctx->config.metrics_listen : NULL,
+        .port = ctx->config.metrics_port,
+        .collect = collect_metrics,
+        .user_data = ctx,
+        .nice = METRICS_THREAD_NICE
+    };
+
+    metrics_status_t status = metrics_server_start(&config);
+    if (status != METRICS_OK) {
+        health_monitor_log(LOG_WARNING, "metrics", "Metrics endpoint unavailable on port %u: %d",
+                         ctx->config.metrics_port, status);
+        return;
+    }
+    health_monitor_log(LOG_INFO, "metrics", "Serving /metrics on %s:%u",
+                     (config.listen_addr != NULL) ? config.listen_addr : "127.0.0.1",
+                     ctx->config.metrics_port);
+}
+
+/**
+ * @brief Close the frame's saturation count
+ *
+ * @return true if EVT_OVEREXPOSURE was raised during this frame
+ */
+static bool overexposure_frame_end(daemon_context_t *ctx) {
+    if (ctx->saturation == NULL) {
+        return false;
+    }
+
+    saturation_end_frame(ctx->saturation, NULL);
+
+    bool raised = ctx->overexposure_raised;
+    ctx->overexposure_raised = false;
+    return raised;
+}
+
+/**
+ * @brief CMD_SET_CONFIG handler for CMD_CONFIG_DEFECT_MAP
+ *
+ * Data is a packed defect_record_t array. Large maps span several packets:
+ * the first carries CMD_CONFIG_FLAG_BEGIN, the last CMD_CONFIG_FLAG_COMMIT.
+ */
+static int defect_config_handler(uint8_t flags, const uint8_t *data,
+                                 size_t len, void *user_data) {
+    defect_map_t *dm = (defect_map_t *)user_data;
+
+    if (len % sizeof(defect_record_t) != 0) {
+        return -EINVAL;
+    }
+
+    if (flags & CMD_CONFIG_FLAG_BEGIN) {
+        defect_map_clear(dm);
+    }
+
+    for (size_t off = 0; off < len; off += sizeof(defect_record_t)) {
+        defect_record_t record;
+        memcpy(&record, data + off, sizeof(record));
+
+        defect_status_t rc = defect_map_add(dm, &record);
+        if (rc != DEFECT_OK) {
+            health_monitor_log(LOG_WARNING, "defect", "Rejected defect record %zu: %d",
+                             off / sizeof(defect_record_t), rc);
+            return (rc == DEFECT_ERROR_FULL) ? -ENOSPC : -EINVAL;
+        }
+    }
+
+    if (flags & CMD_CONFIG_FLAG_COMMIT) {
+        if (defect_map_commit(dm) != DEFECT_OK) {
+            return -ENOMEM;
+        }
+        health_monitor_log(LOG_INFO, "defect", "Defect map active: %zu pixels",
+                         defect_map_count(dm));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief CMD_GET_DATA handler for CMD_DATA_DRIFT_CANDIDATES
+ *
+ * Args are the uint32 pixel index to resume from (0 or absent for the
+ * first page). Reply: uint32 total candidates, uint32 index for the next
+ * page (width * height when done), uint16 record count, uint16 reserved,
+ * then the drift_candidate_t records.
+ */
+static int drift_data_handler(const uint8_t *args, size_t len, uint8_t *out,
+                              size_t cap, void *user_data) {
+    pixel_drift_t *drift = (pixel_drift_t *)user_data;
+    const size_t header = 12;
+    uint32_t start = 0;
+
+    if (len >= sizeof(start)) {
+        memcpy(&start, args, sizeof(start));
+    }
+    if (cap < header) {
+        return -EMSGSIZE;
+    }
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(drift, &stats);
+
+    uint32_t next;
+    uint16_t count = (uint16_t)pixel_drift_get_candidates(
+        drift, start, (drift_candidate_t *)(out + header),
+        (cap - header) / sizeof(drift_candidate_t), &next);
+    uint16_t reserved = 0;
+
+    memcpy(out, &stats.candidates, sizeof(uint32_t));
+    memcpy(out + 4, &next, sizeof(uint32_t));
+    memcpy(out + 8, &count, sizeof(uint16_t));
+    memcpy(out + 10, &reserved, sizeof(uint16_t));
+    return (int)(header + count * sizeof(drift_candidate_t));
+}
+
+/**
+ * @brief Sync auto-exposure with the current scan
+ *
+ * Continuous scans only. AE restarts from the programmed exposure on the
+ * first frame of every continuous scan.
+ *
+ * @return true if this frame feeds the control loop
+ */
+static bool auto_exposure_sync(daemon_context_t *ctx) {
+    /* HDR owns FPGA_REG_GAIN and its frames are fused pairs */
+    if (ctx->ae == NULL || ctx->hdr != NULL || seq_get_mode() != SCAN_MODE_CONTINUOUS) {
+        ctx->ae_active = false;
+        return false;
+    }
+
+    if (!ctx->ae_active) {
+        seq_exposure_t programmed;
+        seq_get_exposure(&programmed);
+        ae_reset(ctx->ae, &(ae_exposure_t){ programmed.timing, programmed.gain });
+        ctx->ae_active = true;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Closed-loop auto-exposure step from ctx->frame_stats
+ *
+ * Runs before transmission; changed registers are written without
+ * read-back verification so the update costs two SPI transactions and
+ * lands before the next frame's integration. The stats stage runs on its
+ * own thread in staged mode, so an overexposure response for a later
+ * frame can land between ae_update() and the write: the sequence engine
+ * then rejects the step and AE resyncs on the next frame.
+ */
+static void auto_exposure_step(daemon_context_t *ctx) {
+    ae_exposure_t prev, next;
+    ae_get_exposure(ctx->ae, &prev);
+    if (!ae_update(ctx->ae, &ctx->frame_stats, &next)) {
+        return;
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    int ret = seq_program_exposure(&(seq_exposure_t){ prev.timing, prev.gain },
+                                   &(seq_exposure_t){ next.timing, next.gain });
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    uint32_t latency_us = (uint32_t)((t1.tv_sec - t0.tv_sec) * 1000000LL +
+                                     (t1.tv_nsec - t0.tv_nsec) / 1000);
+
+    if (ret == -EAGAIN) {
+        /* Protection moved or stopped the exposure; nothing was written */
+        ctx->ae_active = false;
+        return;
+    }
+
+    ae_record_write(ctx->ae, latency_us, ret == 0);
+    if (ret != 0) {
+        health_monitor_log(LOG_WARNING, "ae", "Exposure register write failed");
+    }
+
+    if (latency_us > AE_WRITE_BUDGET_US) {
+        health_monitor_log(LOG_WARNING, "ae", "Exposure write took %u us (budget %u us)",
+                         latency_us, AE_WRITE_BUDGET_US);
+    }
+}
+
+/**
+ * @brief Feed one frame to the calibration accumulator
+ *
+ * Frames of a calibration scan are averaged on the SoC instead of being
+ * streamed. When the requested phase completes the scan is stopped; after
+ * the flood phase the maps are persisted and loaded into the correction
+ * stage.
+ */
+static void calibration_frame(daemon_context_t *ctx, const uint16_t *frame) {
+    if (calib_get_phase(ctx->calib) == CALIB_PHASE_IDLE) {
+        seq_calib_params_t params;
+        seq_get_calibration(&params);
+
+        calib_phase_t phase = (params.phase == SEQ_CALIB_FLOOD) ? CALIB_PHASE_FLOOD : CALIB_PHASE_DARK;
+        uint32_t frames = (params.frames > 0) ? params.frames : CALIB_DEFAULT_FRAMES;
+
+        calib_status_t rc = calib_begin(ctx->calib, phase, frames);
+        if (rc != CALIB_OK) {
+            health_monitor_log(LOG_ERROR, "calib", "Cannot start %s phase: %d",
+                             (phase == CALIB_PHASE_DARK) ? "dark" : "flood", rc);
+            seq_stop_scan();
+            return;
+        }
+
+        health_monitor_log(LOG_INFO, "calib", "Accumulating %u %s frames", frames,
+                         (phase == CALIB_PHASE_DARK) ? "dark" : "flood");
+    }
+
+    calib_phase_t phase = calib_get_phase(ctx->calib);
+    calib_status_t rc = calib_accumulate(ctx->calib, frame);
+
+    /* Frame consumed: lets the sequence engine re-arm for the next one */
+    seq_handle_event(EVT_COMPLETE, NULL);
+
+    if (rc != CALIB_PHASE_COMPLETE) {
+        return;
+    }
+
+    calib_stats_t stats;
+    calib_get_stats(ctx->calib, &stats);
+
+    if (phase == CALIB_PHASE_FLOOD) {
+        health_monitor_log(LOG_INFO, "calib",
+                         "Calibration complete: dark=%.1f flood=%.1f dead=%u",
+                         stats.dark_mean, stats.flood_mean, stats.dead_pixels);
+
+        if (calib_save_maps(ctx->calib, CALIB_MAP_PATH) != CALIB_OK) {
+            health_monitor_log(LOG_ERROR, "calib", "Failed to persist maps to %s", CALIB_MAP_PATH);
+        }
+
+        if (ctx->correction != NULL &&
+            load_correction_maps(ctx, calib_get_offset_map(ctx->calib),
+                                 calib_get_gain_map(ctx->calib)) != 0) {
+            health_monitor_log(LOG_ERROR, "calib", "Failed to load maps into correction stage");
+        }
+
+        /* New offset map: drift is measured from here on */
+        pixel_drift_reset(ctx->drift);
+    } else {
+        health_monitor_log(LOG_INFO, "calib", "Dark phase complete: mean offset %.1f",
+                         stats.dark_mean);
+    }
+
+    seq_stop_scan();
+}
+
+/* ==========================================================================
+ * Processing Pipeline Stages
+ * ========================================================================== */
+
+/**
+ * @brief Feed the drift tracker with dark or idle frames (raw data)
+ *
+ * Dark calibration frames always qualify. Other frames are offered when
+ * drift.dark_level is set; the tracker drops blocks above it. Only one
+ * block is copied per frame and the statistics update on a SCHED_IDLE
+ * worker, so this never holds up the frame.
+ */
+static int stage_drift(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->drift == NULL) {
+        return PIPE_CONTINUE;
+    }
+
+    bool dark = ctx->config.drift_dark_level != 0;
+    if (seq_get_mode() == SCAN_MODE_CALIBRATION) {
+        seq_calib_params_t params;
+        seq_get_calibration(&params);
+        dark = (params.phase == SEQ_CALIB_DARK);
+    }
+
+    if (dark) {
+        pixel_drift_submit(ctx->drift, frame->data);
+    }
+    return PIPE_CONTINUE;
+}
+
+/**
+ * @brief Merge each low/high-gain pair into one frame (dual-gain HDR)
+ *
+ * The low-gain frame is copied and its buffer released at once; the
+ * high-gain partner carries the fused frame on. Frames whose partner was
+ * dropped go no further. Calibration scans run at a single gain.
+ */
+static int stage_hdr(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->hdr == NULL || seq_get_mode() == SCAN_MODE_CALIBRATION) {
+        return PIPE_CONTINUE;
+    }
+
+    hdr_pair_t pair;
+    if (hdr_fusion_submit(ctx->hdr, frame->data, frame->frame_number, &pair) != HDR_OK) {
+        return -EINVAL;
+    }
+    if (pair == HDR_PAIR_FUSED) {
+        return PIPE_CONTINUE;
+    }
+
+    if (pair == HDR_PAIR_DROPPED) {
+        health_monitor_add_stat(HEALTH_STAT_FRAMES_DROPPED, 1);
+    }
+
+    /* Frame consumed: lets the sequence engine re-arm for the next one */
+    seq_handle_event(EVT_COMPLETE, NULL);
+    return PIPE_CONSUMED;
+}
+
+/**
+ * @brief Offset/gain correction once maps are loaded (bands over the pool)
+ */
+static int stage_correction(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (correction_is_ready(ctx->correction)) {
+        correction_apply_frame(ctx->correction, frame->data);
+    }
+    return PIPE_CONTINUE;
+}
+
+/**
+ * @brief Defect pixel replacement
+ */
+static int stage_defects(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->defects != NULL) {
+        defect_map_apply_frame(ctx->defects, frame->data);
+    }
+    return PIPE_CONTINUE;
+}
+
+static void corr_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                      void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (correction_is_ready(ctx->correction)) {
+        correction_apply_rows(ctx->correction, frame->data, row_start, row_count);
+    }
+}
+
+static void defect_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                        void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->defects != NULL) {
+        defect_map_apply_rows(ctx->defects, frame->data, row_start, row_count);
+    }
+}
+
+/*
+ * Overexposure protection, band by band so EVT_OVEREXPOSURE goes out as
+ * soon as the counter trips rather than after the whole frame.
+ */
+static void sat_begin(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    saturation_begin_frame(((daemon_context_t *)user_data)->saturation);
+}
+
+static void sat_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                     void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->saturation != NULL) {
+        saturation_count_rows(ctx->saturation, frame->data, row_start, row_count);
+        overexposure_check(ctx);
+    }
+}
+
+static int sat_end(pipe_frame_t *frame, void *user_data) {
+    if (overexposure_frame_end((daemon_context_t *)user_data)) {
+        frame->flags |= PIPE_FLAG_EXPOSURE_MOVED;
+    }
+    return PIPE_CONTINUE;
+}
+
+/*
+ * Motion-adaptive temporal filter (continuous scans). Runs after
+ * saturation so protection sees unfiltered data.
+ */
+static void tf_begin(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    (void)frame;
+    if (tfilter_scan_check(ctx)) {
+        temporal_filter_begin_frame(ctx->tfilter);
+    }
+}
+
+static void tf_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                    void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->tf_active) {
+        temporal_filter_apply_rows(ctx->tfilter, frame->data, row_start, row_count);
+    }
+}
+
+static int tf_end(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    (void)frame;
+    if (ctx->tf_active) {
+        temporal_filter_end_frame(ctx->tfilter);
+    }
+    return PIPE_CONTINUE;
+}
+
+static void stats_begin(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    ctx->stats_band = auto_exposure_sync(ctx) &&
+                      frame_stats_begin(&ctx->stats_config, &ctx->frame_stats) == FSTATS_OK;
+    ctx->qa_band = ctx->frame_qa != NULL && frame->meta != NULL &&
+                   frame_qa_begin(ctx->frame_qa) == FQA_OK;
+}
+
+/**
+ * @brief Statistics and QA share each band while it is in cache
+ */
+static void stats_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                       void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->stats_band) {
+        frame_stats_accumulate_rows(&ctx->stats_config, frame->data, row_start, row_count,
+                                    &ctx->frame_stats);
+    }
+    if (ctx->qa_band) {
+        frame_qa_accumulate_rows(ctx->frame_qa, frame->data, row_start, row_count);
+    }
+}
+
+static int stats_end(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->qa_band) {
+        frame_meta_t *meta = (frame_meta_t *)frame->meta;
+        meta->qa_valid = frame_qa_finish(ctx->frame_qa, &meta->qa) == FQA_OK;
+    }
+
+    if (frame->flags & PIPE_FLAG_EXPOSURE_MOVED) {
+        ctx->ae_active = false;
+    } else if (ctx->stats_band) {
+        frame_stats_finish(&ctx->frame_stats);
+        auto_exposure_step(ctx);
+    }
+    return PIPE_CONTINUE;
+}
+
+/**
+ * @brief Frame statistics, image QA and auto-exposure (continuous scans)
+ *
+ * Staged execution walks the frame in bands itself so the statistics
+ * and QA passes still read each row from DRAM once.
+ */
+static int stage_stats(pipe_frame_t *frame, void *user_data) {
+    stats_begin(frame, user_data);
+    for (uint32_t row = 0; row < frame->height; row += PIPE_DEFAULT_BAND_ROWS) {
+        uint32_t rows = frame->height - row;
+        stats_rows(frame, row, (rows < PIPE_DEFAULT_BAND_ROWS) ? rows : PIPE_DEFAULT_BAND_ROWS,
+                   user_data);
+    }
+    return stats_end(frame, user_data);
+}
+
+/**
+ * @brief Apply the panel mounting transform in place
+ *
+ * Rotations by 90/270 degrees and transposes swap the frame axes; the
+ * new geometry travels with the frame to packetize.
+ */
+static int stage_orient(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->orientation == NULL) {
+        return PIPE_CONTINUE;
+    }
+
+    if (orientation_apply_frame(ctx->orientation, frame->data) != ORIENT_OK) {
+        return -EINVAL;
+    }
+    orientation_get_output_size(ctx->orientation, &frame->width, &frame->height);
+    return PIPE_CONTINUE;
+}
+
+/**
+ * @brief Window/level the frame into ctx->display_buf
+ */
+static void display_convert(daemon_context_t *ctx, const pipe_frame_t *frame) {
+    if (ctx->config.display_auto_window) {
+        /* Output geometry: orientation may have swapped the axes */
+        fstats_config_t stats_config = { .width = frame->width, .height = frame->height };
+
+        if (frame_stats_compute(&stats_config, frame->data, &ctx->display_stats) == FSTATS_OK) {
+            window_level_auto_window(ctx->display, &ctx->display_stats);
+        }
+    }
+
+    window_level_convert(ctx->display, ctx->display_buf, frame->data,
+                         (size_t)frame->width * frame->height);
+}
+
+/**
+ * @brief Send the frame to the network.outputs consumers
+ *
+ * All display8 consumers share one conversion per frame. A failing
+ * consumer is skipped (its eth_tx stats count the error) and never holds
+ * up the archive stream. Frames suppressed by the exposure gate go out as
+ * header-only markers.
+ */
+static void send_outputs(daemon_context_t *ctx, const pipe_frame_t *frame, uint16_t flags) {
+    bool converted = false;
+
+    for (uint8_t i = 0; i < ctx->config.output_count; i++) {
+        const void *data = frame->data;
+        size_t size = frame->size;
+        uint16_t bit_depth = ctx->config.detector.bit_depth;
+
+        if (ctx->outputs[i] == NULL) {
+            continue;
+        }
+
+        if (ctx->config.outputs[i].format == CONFIG_OUTPUT_DISPLAY8) {
+            if (ctx->display == NULL) {
+                continue;
+            }
+            bit_depth = 8;
+        }
+
+        if (flags & ETH_FRAME_FLAG_SUPPRESSED) {
+            eth_tx_send_marker(ctx->outputs[i], frame->frame_number, frame->width,
+                               frame->height, bit_depth, flags);
+            continue;
+        }
+
+        if (ctx->config.outputs[i].format == CONFIG_OUTPUT_DISPLAY8) {
+            if (!converted) {
+                display_convert(ctx, frame);
+                converted = true;
+            }
+            data = ctx->display_buf;
+            size = (size_t)frame->width * frame->height;
+        }
+
+        eth_tx_send_frame_flags(ctx->outputs[i], data, size, frame->width, frame->height,
+                                bit_depth, frame->frame_number, flags);
+    }
+}
+
+/**
+ * @brief Exposure gate: decide how a frame without X-ray signal is sent
+ *
+ * Decimated frames are binned in place; frame width, height and size are
+ * updated to the binned frame.
+ *
+ * @return ETH_FRAME_FLAG_* for the frame (0 = send unchanged)
+ */
+static uint16_t exposure_gate_frame(daemon_context_t *ctx, pipe_frame_t *frame) {
+    egate_result_t result;
+
+    if (ctx->gate == NULL ||
+        exposure_gate_check(ctx->gate, frame->data, frame->width, frame->height,
+                            &result) != EGATE_OK) {
+        return 0;
     }
 
-    /* Set UID to detector user */
-    if (setuid(pw->pw_uid) < 0) {
-        syslog(LOG_ERR, "setuid failed: %m");
-        return -1;
+    switch (result.verdict) {
+        case EGATE_VERDICT_TAG:
+            return ETH_FRAME_FLAG_NO_SIGNAL;
+        case EGATE_VERDICT_DECIMATE:
+            if (exposure_gate_decimate(ctx->gate, frame->data, &frame->width,
+                                       &frame->height) != EGATE_OK) {
+                return ETH_FRAME_FLAG_NO_SIGNAL;
+            }
+            frame->size = (size_t)frame->width * frame->height * sizeof(uint16_t);
+            return ETH_FRAME_FLAG_NO_SIGNAL | ETH_FRAME_FLAG_DECIMATED;
+        case EGATE_VERDICT_DROP:
+            return ETH_FRAME_FLAG_NO_SIGNAL | ETH_FRAME_FLAG_SUPPRESSED;
+        default:
+            return 0;
     }
+}
 
-    /* Verify privilege drop succeeded */
-    if (setuid(0) == 0) {
-        syslog(LOG_ERR, "Privilege drop failed - still have root access");
-        return -1;
+/**
+ * @brief Fragment and transmit the frame via UDP
+ *
+ * REQ-FW-040: Frame fragmentation and transmission
+ */
+static int stage_packetize(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+    uint16_t flags = exposure_gate_frame(ctx, frame);
+    eth_tx_status_t tx_result;
+
+    uint64_t send_start_ns = monotonic_ns();
+    if (flags & ETH_FRAME_FLAG_SUPPRESSED) {
+        tx_result = eth_tx_send_marker(ctx->eth_ctx.handle, frame->frame_number,
+                                       frame->width, frame->height,
+                                       ctx->config.detector.bit_depth, flags);
+    } else {
+        tx_result = eth_tx_send_frame_flags(
+            ctx->eth_ctx.handle,
+            (const uint8_t *)frame->data,
+            frame->size,
+            frame->width,                   /* Width */
+            frame->height,                  /* Height */
+            ctx->config.detector.bit_depth, /* Bit depth */
+            frame->frame_number,            /* Frame number */
+            flags                           /* Exposure gate flags */
+        );
+    }
+    metrics_histogram_observe(&g_tx_send_hist, monotonic_ns() - send_start_ns);
+
+    if (tx_result != ETH_TX_OK) {
+        health_monitor_log(LOG_ERROR, "tx_thread",
+                         "Failed to send frame %u: %d",
+                         frame->frame_number, tx_result);
+        health_monitor_add_stat(HEALTH_STAT_FRAMES_DROPPED, 1);
+        return -EIO;
     }
 
-    syslog(LOG_INFO, "Privileges dropped to user '%s' (UID %d, GID %d)",
-           DETECTOR_USER, pw->pw_uid, gr->gr_gid);
+    health_monitor_add_stat(HEALTH_STAT_FRAMES_SENT, 1);
+    send_outputs(ctx, frame, flags);
 
-    return 0;
+    /* Notify sequence engine of transmission complete */
+    seq_handle_event(EVT_COMPLETE, NULL);
+    return PIPE_CONTINUE;
 }
 
-/* ==========================================================================
- * Thread Entry Points (DDD)
- * ========================================================================== */
+/**
+ * @brief Calibration accumulation: frames are averaged, not streamed
+ */
+static int stage_calibrate(pipe_frame_t *frame, void *user_data) {
+    daemon_context_t *ctx = (daemon_context_t *)user_data;
+
+    if (ctx->calib == NULL) {
+        return PIPE_CONTINUE;
+    }
+
+    calibration_frame(ctx, frame->data);
+    return PIPE_CONSUMED;
+}
 
 /**
- * @brief Set thread realtime priority
+ * @brief Add a frame's QA metrics to the health monitor time series
  */
-static int set_thread_priority(pthread_t thread, int priority) {
-    struct sched_param param;
+static void record_frame_qa(const fqa_result_t *qa) {
+    health_monitor_record_metric(HEALTH_METRIC_QA_MEAN, qa->mean);
+    health_monitor_record_metric(HEALTH_METRIC_QA_NOISE, qa->noise);
+    health_monitor_record_metric(HEALTH_METRIC_QA_SNR, qa->snr);
+    health_monitor_record_metric(HEALTH_METRIC_QA_ROW_BANDING, qa->row_banding);
+    health_monitor_record_metric(HEALTH_METRIC_QA_COL_BANDING, qa->col_banding);
+    health_monitor_record_metric(HEALTH_METRIC_QA_NONUNIFORMITY, qa->nonuniformity);
+}
 
-    param.sched_priority = priority;
+/**
+ * @brief Hand a frame's buffer back to the frame manager
+ */
+static void pipeline_release_frame(const pipe_frame_t *frame, void *user_data) {
+    const frame_meta_t *meta = (const frame_meta_t *)frame->meta;
 
-    if (pthread_setschedparam(thread, SCHED_FIFO, &param) != 0) {
-        perror("pthread_setschedparam");
-        return -1;
+    (void)user_data;
+    if (meta != NULL && meta->qa_valid) {
+        record_frame_qa(&meta->qa);
     }
-
-    return 0;
+    frame_mgr_release_buffer(frame->frame_number);
+    metrics_histogram_observe(&g_frame_latency_hist, monotonic_ns() - frame->submit_ns);
 }
 
 /**
- * @brief SPI control thread
+ * @brief Built-in stage chains, used when detector_config.yaml has none
+ */
+static const char *const k_default_pipeline[CONFIG_PIPELINE_MODES][CONFIG_MAX_PIPELINE_STAGES] = {
+    [SCAN_MODE_SINGLE] = { "drift", "correction", "defects", "saturation", "orient",
+                            "packetize" },
+    [SCAN_MODE_CONTINUOUS] = { "drift", "correction", "defects", "saturation", "temporal",
+                               "stats", "orient", "packetize" },
+    [SCAN_MODE_CALIBRATION] = { "drift", "calibrate", "packetize" }
+};
+
+/**
+ * @brief Built-in chains with HDR enabled
  *
- * Polls FPGA STATUS register at 100us interval (SCHED_FIFO priority 80)
- * REQ-FW-030: SPI communication with FPGA
+ * Fusion comes first so every later stage sees one frame per pair. Drift
+ * tracking is left out: its statistics assume a single gain.
  */
-static void *spi_control_thread(void *arg) {
-    daemon_context_t *ctx = (daemon_context_t *)arg;
+static const char *const k_hdr_pipeline[CONFIG_PIPELINE_MODES][CONFIG_MAX_PIPELINE_STAGES] = {
+    [SCAN_MODE_SINGLE] = { "hdr", "correction", "defects", "saturation", "orient",
+                            "packetize" },
+    [SCAN_MODE_CONTINUOUS] = { "hdr", "correction", "defects", "saturation", "temporal",
+                               "stats", "orient", "packetize" },
+    [SCAN_MODE_CALIBRATION] = { "drift", "calibrate", "packetize" }
+};
 
-    prctl(PR_SET_NAME, "spi_ctrl", 0, 0, 0);
+/**
+ * @brief Register every processing stage the daemon provides
+ *
+ * Stages with band operations can be fused band by band; correction
+ * keeps its whole-frame function so staged execution spreads it over
+ * the processing pool.
+ *
+ * @return 0 on success, -errno on failure
+ */
+static int register_pipeline_stages(daemon_context_t *ctx) {
+    static const struct {
+        const char *name;
+        pipe_stage_fn_t fn;
+        pipe_band_ops_t ops;
+    } stages[] = {
+        { "drift", stage_drift, { .rows = NULL } },
+        { "hdr", stage_hdr, { .rows = NULL } },
+        { "correction", stage_correction, { .rows = corr_rows } },
+        { "defects", stage_defects, { .rows = defect_rows, .lag_rows = DEFECT_BAND_LAG_ROWS } },
+        { "saturation", NULL, { .begin = sat_begin, .rows = sat_rows, .end = sat_end } },
+        { "temporal", NULL, { .begin = tf_begin, .rows = tf_rows, .end = tf_end } },
+        { "stats", stage_stats, { .begin = stats_begin, .rows = stats_rows, .end = stats_end } },
+        { "orient", stage_orient, { .rows = NULL } },
+        { "packetize", stage_packetize, { .rows = NULL } },
+        { "calibrate", stage_calibrate, { .rows = NULL } }
+    };
 
-    while (ctx->running && !ctx->shutdown_requested) {
-        /* Poll FPGA STATUS register */
-        uint8_t fpga_status = 0x04; /* Default: READY (mock implementation) */
-        uint32_t error_count = 0;
+    ctx->stages = pipeline_registry_create();
+    if (ctx->stages == NULL) {
+        return -ENOMEM;
+    }
 
-        /* Real implementation would read SPI:
-        spi_status_t spi_result = spi_master_read_status(&ctx->spi_ctx);
-        if (spi_result.status == SPI_OK) {
-            fpga_status = spi_result.reg_value;
-        } else {
-            error_count++;
-            health_monitor_update_stat("spi_errors", 1);
+    for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+        pipe_status_t rc = (stages[i].ops.rows != NULL) ?
+            pipeline_register_band_stage(ctx->stages, stages[i].name, stages[i].fn,
+                                         &stages[i].ops, ctx) :
+            pipeline_register_stage(ctx->stages, stages[i].name, stages[i].fn, ctx);
+        if (rc != PIPE_OK) {
+            return -EINVAL;
         }
-        */
+    }
 
-        /* Check FPGA status bits */
-        if (fpga_status & FPGA_STATUS_ERROR) {
-            health_monitor_log(LOG_WARNING, "spi", "FPGA error detected (status=0x%02X)", fpga_status);
-            error_count++;
-            health_monitor_update_stat("spi_errors", 1);
-        }
+    return 0;
+}
 
-        if (fpga_status & FPGA_STATUS_BUSY) {
-            /* FPGA is busy processing */
-            health_monitor_update_stat("frames_received", 1);
-        } else {
-            /* FPGA is idle and ready for next command */
-            health_monitor_log(LOG_DEBUG, "spi", "FPGA ready (status=0x%02X)", fpga_status);
-        }
+/**
+ * @brief Log per-stage metrics of the current pipeline
+ */
+static void log_pipeline_stats(daemon_context_t *ctx) {
+    pipe_stats_t stats;
+    pipeline_get_stats(ctx->pipe, &stats);
+
+    health_monitor_log(LOG_INFO, "pipeline", "Mode %d: %lu frames, %lu dropped, latency max %u us",
+                     ctx->pipe_mode, (unsigned long)stats.completed,
+                     (unsigned long)stats.dropped, stats.max_latency_us);
+
+    for (uint32_t i = 0; i < stats.stages; i++) {
+        pipe_stage_stats_t st;
+        pipeline_get_stage_stats(ctx->pipe, i, &st);
+        health_monitor_log(LOG_INFO, "pipeline",
+                         "  %-12s %lu frames, %lu errors, avg %u us, max %u us, %.1f fps, busy %.0f%%, queue max %u",
+                         st.name, (unsigned long)st.frames, (unsigned long)st.errors,
+                         st.avg_us, st.max_us, st.fps, st.busy * 100.0f, st.queue_max);
+    }
 
-        /* Update SPI error statistics */
-        if (error_count > 0) {
-            health_monitor_update_stat("spi_errors", error_count);
-        }
+    if (ctx->drift != NULL) {
+        drift_stats_t drift_stats;
+        pixel_drift_get_stats(ctx->drift, &drift_stats);
+        health_monitor_log(LOG_INFO, "pipeline",
+                         "  drift: %lu blocks, skipped %lu busy %lu bright, %u sweeps, %u candidates",
+                         (unsigned long)drift_stats.processed, (unsigned long)drift_stats.skipped_busy,
+                         (unsigned long)drift_stats.skipped_bright, drift_stats.sweeps,
+                         drift_stats.candidates);
+    }
 
-        usleep(100);  /* 100us */
+    if (ctx->hdr != NULL) {
+        hdr_stats_t hdr_stats;
+        hdr_fusion_get_stats(ctx->hdr, &hdr_stats);
+        health_monitor_log(LOG_INFO, "pipeline", "  hdr: %lu pairs fused, dropped %lu low %lu high",
+                         (unsigned long)hdr_stats.fused, (unsigned long)hdr_stats.dropped_low,
+                         (unsigned long)hdr_stats.dropped_high);
     }
 
-    health_monitor_log(LOG_INFO, "spi_thread", "SPI control thread exiting");
-    return NULL;
+    if (ctx->gate != NULL) {
+        egate_stats_t gate_stats;
+        exposure_gate_get_stats(ctx->gate, &gate_stats);
+        health_monitor_log(LOG_INFO, "pipeline",
+                         "  gate: %lu frames, %lu signal, %lu held, %lu tagged, %lu decimated, %lu dropped",
+                         (unsigned long)gate_stats.frames, (unsigned long)gate_stats.signal,
+                         (unsigned long)gate_stats.held, (unsigned long)gate_stats.tagged,
+                         (unsigned long)gate_stats.decimated, (unsigned long)gate_stats.dropped);
+    }
+
+    if (ctx->frame_qa != NULL) {
+        health_point_t noise, snr, row_band, col_band, nonuni;
+        if (health_monitor_get_series(HEALTH_METRIC_QA_NOISE, &noise, 1) == 1 &&
+            health_monitor_get_series(HEALTH_METRIC_QA_SNR, &snr, 1) == 1 &&
+            health_monitor_get_series(HEALTH_METRIC_QA_ROW_BANDING, &row_band, 1) == 1 &&
+            health_monitor_get_series(HEALTH_METRIC_QA_COL_BANDING, &col_band, 1) == 1 &&
+            health_monitor_get_series(HEALTH_METRIC_QA_NONUNIFORMITY, &nonuni, 1) == 1) {
+            health_monitor_log(LOG_INFO, "pipeline",
+                             "  qa: noise %.1f, snr %.1f, banding row %.2f col %.2f, non-uniformity %.2f%%",
+                             noise.mean, snr.mean, row_band.mean, col_band.mean,
+                             nonuni.mean * 100.0f);
+        }
+    }
 }
 
 /**
- * @brief CSI-2 RX thread
+ * @brief Rebuild the pipeline for a scan mode
  *
- * Receives frames via V4L2 DQBUF
- * REQ-FW-020: MIPI CSI-2 reception
+ * The old pipeline is drained and stopped first. The chain comes from the
+ * pipeline section of the configuration, or the built-in default when the
+ * mode has none or it names an unknown stage.
  */
-static void *csi2_rx_thread(void *arg) {
-    daemon_context_t *ctx = (daemon_context_t *)arg;
+static void rebuild_pipeline(daemon_context_t *ctx, int mode) {
+    if (ctx->pipe != NULL) {
+        log_pipeline_stats(ctx);
+        pipeline_destroy(ctx->pipe);
+        ctx->pipe = NULL;
+    }
 
-    prctl(PR_SET_NAME, "csi2_rx", 0, 0, 0);
+    ctx->pipe_mode = mode;
+    if (mode < 0 || mode >= CONFIG_PIPELINE_MODES) {
+        return;
+    }
 
-    while (ctx->running && !ctx->shutdown_requested) {
-        /* Dequeue frame from V4L2 */
-        /* TODO: Implement V4L2 DQBUF */
+    const char *chain[CONFIG_MAX_PIPELINE_STAGES];
+    uint32_t count = ctx->config.pipeline_stages[mode];
 
-        usleep(1000);  /* 1ms */
+    for (uint32_t i = 0; i < count; i++) {
+        chain[i] = ctx->config.pipeline[mode][i];
+        if (!pipeline_registry_has(ctx->stages, chain[i])) {
+            health_monitor_log(LOG_WARNING, "pipeline", "Unknown stage '%s' for mode %d, using default",
+                             chain[i], mode);
+            count = 0;
+            break;
+        }
     }
 
-    health_monitor_log(LOG_INFO, "csi2_thread", "CSI-2 RX thread exiting");
-    return NULL;
+    if (count == 0) {
+        const char *const *defaults = (ctx->hdr != NULL) ? k_hdr_pipeline[mode]
+                                                         : k_default_pipeline[mode];
+        while (count < CONFIG_MAX_PIPELINE_STAGES && defaults[count] != NULL) {
+            chain[count] = defaults[count];
+            count++;
+        }
+    }
+
+    pipe_config_t pipe_config = {
+        .registry = ctx->stages,
+        .stages = chain,
+        .stage_count = count,
+        .priority = THREAD_PRIORITY_TX,
+        .exec = ctx->config.pipeline_fused ? PIPE_EXEC_FUSED : PIPE_EXEC_STAGED,
+        .band_rows = ctx->config.pipeline_band_rows,
+        .release = pipeline_release_frame,
+        .meta_size = sizeof(frame_meta_t)
+    };
+
+    ctx->pipe = pipeline_create(&pipe_config);
+    if (ctx->pipe == NULL) {
+        health_monitor_log(LOG_ERROR, "pipeline", "Failed to build pipeline for mode %d", mode);
+        return;
+    }
+
+    health_monitor_log(LOG_INFO, "pipeline", "Mode %d pipeline: %u stages (%s), first '%s', last '%s'",
+                     mode, count, ctx->config.pipeline_fused ? "fused" : "staged",
+                     chain[0], chain[count - 1]);
 }
 
 /**
  * @brief Ethernet TX thread
  *
- * Transmits frames via UDP
+ * Feeds ready frames into the processing pipeline of the current scan
+ * mode; the last stage transmits them via UDP.
  * REQ-FW-040: Ethernet transmission
  */
 static void *eth_tx_thread(void *arg) {
@@ -408,48 +1810,65 @@ static void *eth_tx_thread(void *arg) {
 
     prctl(PR_SET_NAME, "eth_tx", 0, 0, 0);
 
-    uint32_t frame_number = 0;
-
     while (ctx->running && !ctx->shutdown_requested) {
         /* Get ready buffer from frame manager */
         uint8_t *frame_data = NULL;
         size_t frame_size = 0;
         uint32_t ready_frame_number = 0;
 
-        int ret = frame_mgr_get_ready_buffer(&frame_data, &frame_size, &ready_frame_number);
-        if (ret == 0) {
-            /* Frame available, transmit via UDP */
-            /* REQ-FW-040: Frame fragmentation and transmission */
-            eth_tx_status_t tx_result = eth_tx_send_frame(
-                ctx->eth_ctx.handle,
-                frame_data,
-                frame_size,
-                ctx->config.detector.rows,      /* Width */
-                ctx->config.detector.cols,      /* Height */
-                ctx->config.detector.bit_depth, /* Bit depth */
-                ready_frame_number              /* Frame number */
-            );
-
-            if (tx_result == ETH_TX_OK) {
-                /* Transmission successful, release buffer */
-                frame_mgr_release_buffer(ready_frame_number);
-                health_monitor_update_stat("frames_sent", 1);
+        /* Scan mode changed: rebuild the stage chain without restarting */
+        int mode = (int)seq_get_mode();
+        if (mode != ctx->pipe_mode) {
+            rebuild_pipeline(ctx, mode);
+        }
 
-                /* Notify sequence engine of transmission complete */
-                seq_handle_event(EVT_COMPLETE, NULL);
-            } else {
-                /* Transmission failed */
-                health_monitor_log(LOG_ERROR, "tx_thread",
-                                 "Failed to send frame %u: %d",
-                                 ready_frame_number, tx_result);
-                health_monitor_update_stat("frames_dropped", 1);
+        /* Scan ended: once the stages are idle their state can be reset */
+        bool idle = seq_get_state() == SEQ_STATE_IDLE &&
+                    (ctx->pipe == NULL || pipeline_drain(ctx->pipe, PIPE_DRAIN_TIMEOUT_MS));
+
+        /* Drop a partial calibration if its scan was stopped or replaced */
+        if ((idle || mode != SCAN_MODE_CALIBRATION) &&
+            calib_get_phase(ctx->calib) != CALIB_PHASE_IDLE) {
+            health_monitor_log(LOG_WARNING, "calib", "Calibration scan aborted");
+            calib_abort(ctx->calib);
+        }
 
-                /* Still release buffer on error */
+        /* The next continuous scan starts with a fresh filter */
+        if (idle) {
+            ctx->tf_scan = false;
+            ctx->tf_active = false;
+            hdr_fusion_reset(ctx->hdr);
+            exposure_gate_reset(ctx->gate);
+        }
+
+        int ret = frame_mgr_get_ready_buffer(&frame_data, &frame_size, &ready_frame_number);
+        if (ret == 0) {
+            pipe_frame_t frame = {
+                .data = (uint16_t *)frame_data,
+                .size = frame_size,
+                .frame_number = ready_frame_number,
+                .width = ctx->config.detector.cols,
+                .height = ctx->config.detector.rows
+            };
+
+            if (ctx->pipe == NULL || pipeline_submit(ctx->pipe, &frame) != PIPE_OK) {
+                /* No pipeline or all stages backed up: drop the frame */
+                health_monitor_add_stat(HEALTH_STAT_FRAMES_DROPPED, 1);
                 frame_mgr_release_buffer(ready_frame_number);
             }
         } else if (ret == -ENOENT) {
-            /* No ready buffers, wait */
-            usleep(100);  /* 100us */
+            /* No ready buffers, wait 100us or until start-of-frame wakes us */
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += 100000;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+
+            pthread_mutex_lock(&ctx->tx_wake_mutex);
+            pthread_cond_timedwait(&ctx->tx_wake_cond, &ctx->tx_wake_mutex, &deadline);
+            pthread_mutex_unlock(&ctx->tx_wake_mutex);
         } else {
             /* Error getting buffer */
             health_monitor_log(LOG_ERROR, "tx_thread",
@@ -534,6 +1953,13 @@ static void *command_thread(void *arg) {
             continue;
         }
 
+        /* HMAC and handlers read the payload, which only cmd_buf holds */
+        if (sizeof(command_frame_t) + cmd.payload_len > (size_t)recv_len) {
+            health_monitor_log(LOG_WARNING, "cmd_thread", "Truncated command payload");
+            continue;
+        }
+        const command_frame_t *frame = (const command_frame_t *)cmd_buf;
+
         /* Get client IP for replay protection */
         char client_ip[INET_ADDRSTRLEN];
         inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, sizeof(client_ip));
@@ -544,13 +1970,13 @@ static void *command_thread(void *arg) {
             health_monitor_log(LOG_WARNING, "cmd_thread",
                              "Replay attack detected from %s (seq=%u)",
                              client_ip, cmd.sequence);
-            health_monitor_update_stat("auth_failures", 1);
+            health_monitor_add_stat(HEALTH_STAT_AUTH_FAILURES, 1);
             continue;
         }
 
         /* Handle command */
         size_t resp_len = sizeof(resp_buf);
-        int handle_result = cmd_handle_command(&cmd, resp_buf, &resp_len);
+        int handle_result = cmd_handle_command(frame, resp_buf, &resp_len);
         if (handle_result != 0) {
             health_monitor_log(LOG_ERROR, "cmd_thread", "Failed to handle command");
             continue;
@@ -597,20 +2023,21 @@ static void *health_monitor_thread(void *arg) {
         /* Collect statistics from sequence engine */
         seq_stats_t seq_stats;
         if (seq_get_stats(&seq_stats) == 0) {
-            health_monitor_update_stat("frames_received", (int64_t)seq_stats.frames_received);
-            health_monitor_update_stat("frames_sent", (int64_t)seq_stats.frames_sent);
-            health_monitor_update_stat("retries", (int64_t)seq_stats.retries);
+            health_monitor_add_stat(HEALTH_STAT_FRAMES_RECEIVED, (int64_t)seq_stats.frames_received);
+            health_monitor_add_stat(HEALTH_STAT_FRAMES_SENT, (int64_t)seq_stats.frames_sent);
         }
 
         /* Calculate derived metrics */
-        uint64_t frames_total = g_health_ctx.stats.frames_received;
-        uint64_t frames_dropped = g_health_ctx.stats.frames_dropped;
+        runtime_stats_t stats;
+        health_monitor_get_stats(&stats);
+        uint64_t frames_total = stats.frames_received;
+        uint64_t frames_dropped = stats.frames_dropped;
 
         if (frames_total > 0) {
             uint32_t drop_rate = (uint32_t)((frames_dropped * 100) / frames_total);
             health_monitor_log(LOG_DEBUG, "health",
                              "Frame stats: received=%lu, sent=%lu, dropped=%lu, drop_rate=%u%%",
-                             frames_total, g_health_ctx.stats.frames_sent,
+                             frames_total, stats.frames_sent,
                              frames_dropped, drop_rate);
         }
 
@@ -653,6 +2080,16 @@ static int init_modules(daemon_context_t *ctx) {
     }
     ctx->health_ctx = (health_monitor_context_t *)&g_health_ctx;
 
+    /* Real-time threads log through per-thread rings from here on */
+    if (health_monitor_start_async_log() != 0) {
+        health_monitor_log(LOG_WARNING, "main", "Async logging unavailable, logging synchronously");
+    }
+
+    /* Tracepoint rings; recording starts on SIGUSR2 or CMD_CONFIG_TRACE */
+    if (trace_init(TRACE_DEFAULT_RECORDS) != TRACE_OK) {
+        health_monitor_log(LOG_WARNING, "main", "Trace buffers unavailable");
+    }
+
     /* Initialize SPI master */
     spi_config_t spi_config = {
         .device = "/dev/spidev0.0",
@@ -677,7 +2114,8 @@ static int init_modules(daemon_context_t *ctx) {
         .height = ctx->config.detector.rows,
         .format = CSI2_PIX_FMT_RAW16,
         .buffer_count = 4,
-        .fps = 15
+        .fps = 15,
+        .enable_events = true
     };
 
     ctx->csi2_ctx = csi2_rx_create(&csi2_config);
@@ -693,6 +2131,14 @@ static int init_modules(daemon_context_t *ctx) {
         return -1;
     }
 
+    /* Fixed packet plan for the panel geometry; other frame sizes stay generic */
+    if (eth_tx_set_geometry(ctx->eth_ctx.handle, ctx->config.detector.cols,
+                            ctx->config.detector.rows,
+                            ctx->config.detector.bit_depth) != ETH_TX_OK) {
+        health_monitor_log(LOG_WARNING, "main", "No packet plan: %s",
+                         eth_get_error(ctx->eth_ctx.handle));
+    }
+
     /* Initialize battery driver */
     ret = bq40z50_init(&ctx->battery_ctx, "/dev/i2c-1", BQ40Z50_I2C_ADDR);
     if (ret != 0) {
@@ -713,6 +2159,326 @@ static int init_modules(daemon_context_t *ctx) {
         return -1;
     }
 
+    /* Compile the panel readout map (readout: section) */
+    desc_config_t desc_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows,
+        .block_cols = ctx->config.readout_block_cols,
+        .block_count = ctx->config.readout_block_count,
+        .mirrored_blocks = ctx->config.readout_mirrored_blocks,
+        .dual_side = ctx->config.readout_dual_side,
+        .bottom_flipped = ctx->config.readout_bottom_flipped,
+        .bottom_mirrored = ctx->config.readout_bottom_mirrored
+    };
+    memcpy(desc_config.block_order, ctx->config.readout_block_order,
+           sizeof(desc_config.block_order));
+
+    ctx->descramble = descramble_create(&desc_config);
+    if (ctx->descramble == NULL) {
+        health_monitor_log(LOG_ERROR, "main", "Invalid panel readout map");
+        return -1;
+    }
+    if (descramble_is_identity(ctx->descramble)) {
+        descramble_destroy(ctx->descramble);
+        ctx->descramble = NULL;
+    } else {
+        health_monitor_log(LOG_INFO, "main", "Readout descramble: %u/%u moves per line (kernel=%s)",
+                         descramble_op_count(ctx->descramble, false),
+                         descramble_op_count(ctx->descramble, true),
+                         descramble_get_kernel_name());
+    }
+
+    /* Panel mounting transform (panel.orientation) */
+    if (ctx->config.orientation != ORIENT_NONE) {
+        orient_config_t orient_config = {
+            .width = ctx->config.detector.cols,
+            .height = ctx->config.detector.rows,
+            .transform = (orient_t)ctx->config.orientation
+        };
+
+        ctx->orientation = orientation_create(&orient_config);
+        if (ctx->orientation == NULL) {
+            health_monitor_log(LOG_ERROR, "main", "Failed to initialize orientation");
+            return -1;
+        }
+        health_monitor_log(LOG_INFO, "main", "Orientation: %s, %s (kernel=%s)",
+                         orientation_name(orient_config.transform),
+                         orientation_in_place(ctx->orientation) ? "in place" : "via scratch",
+                         orientation_get_kernel_name());
+    }
+
+    /* Additional consumers (network.outputs); display8 ones share one converter */
+    for (uint8_t i = 0; i < ctx->config.output_count; i++) {
+        const config_output_t *out = &ctx->config.outputs[i];
+        eth_tx_config_t out_config = {
+            .dest_ip = out->host_ip,
+            .data_port = out->port,
+            .cmd_port = 0,              /* Data only: any local port */
+            .mtu = ETH_DEFAULT_MTU,
+            .max_payload = ETH_DEFAULT_MAX_PAYLOAD,
+            .enable_crc = true,
+            .fps = ctx->config.frame_rate
+        };
+
+        ctx->outputs[i] = eth_tx_create(&out_config);
+        if (ctx->outputs[i] == NULL) {
+            health_monitor_log(LOG_WARNING, "main", "Output %s:%u unavailable",
+                             out->host_ip, out->port);
+            continue;
+        }
+        eth_tx_set_geometry(ctx->outputs[i], ctx->config.detector.cols, ctx->config.detector.rows,
+                            (out->format == CONFIG_OUTPUT_DISPLAY8) ? 8 : ctx->config.detector.bit_depth);
+
+        if (out->format == CONFIG_OUTPUT_DISPLAY8 && ctx->display == NULL) {
+            wl_config_t wl_config = {
+                .window_low = ctx->config.display_window_low,
+                .window_high = ctx->config.display_window_high,
+                .gamma = ctx->config.display_gamma,
+                .low_percentile = ctx->config.display_low_percentile / 100.0f,
+                .high_percentile = ctx->config.display_high_percentile / 100.0f,
+                .method = (wl_method_t)ctx->config.display_method
+            };
+
+            ctx->display = window_level_create(&wl_config);
+            ctx->display_buf = malloc((size_t)ctx->config.detector.rows *
+                                      ctx->config.detector.cols);
+            if (ctx->display == NULL || ctx->display_buf == NULL) {
+                health_monitor_log(LOG_ERROR, "main", "Failed to initialize display conversion");
+                return -1;
+            }
+            health_monitor_log(LOG_INFO, "main", "Display output: %s window, %s (kernel=%s)",
+                             ctx->config.display_auto_window ? "auto" : "manual",
+                             window_level_method(ctx->display) == WL_METHOD_LUT ? "lut" : "arith",
+                             window_level_get_kernel_name());
+        }
+    }
+
+    /* Initialize offset/gain correction (idle until maps are loaded) */
+    corr_config_t corr_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows,
+        .gain_format = CORR_GAIN_Q2_14,
+        .band_rows = CORR_DEFAULT_BAND_ROWS
+    };
+
+    ctx->correction = correction_create(&corr_config);
+    if (ctx->correction == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to initialize correction stage (continuing uncorrected)");
+    } else {
+        health_monitor_log(LOG_INFO, "main", "Correction stage ready (kernel=%s)",
+                         correction_get_kernel_name());
+    }
+
+    /* Restore persisted calibration maps */
+    if (ctx->correction != NULL) {
+        size_t pixels = (size_t)corr_config.width * corr_config.height;
+        uint16_t *offset = malloc(pixels * sizeof(uint16_t));
+        float *gain = malloc(pixels * sizeof(float));
+
+        if (offset != NULL && gain != NULL &&
+            calib_load_maps(CALIB_MAP_PATH, corr_config.width, corr_config.height,
+                            offset, gain) == CALIB_OK &&
+            load_correction_maps(ctx, offset, gain) == 0) {
+            health_monitor_log(LOG_INFO, "main", "Calibration maps loaded from %s", CALIB_MAP_PATH);
+        } else {
+            health_monitor_log(LOG_INFO, "main", "No valid calibration maps, correction disabled");
+        }
+
+        free(offset);
+        free(gain);
+    }
+
+    /* Initialize defect map (empty until loaded via CMD_SET_CONFIG) */
+    defect_config_t defect_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows,
+        .max_records = DEFECT_DEFAULT_MAX_RECORDS
+    };
+
+    ctx->defects = defect_map_create(&defect_config);
+    if (ctx->defects == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to initialize defect map");
+    }
+
+    /* Initialize overexposure protection (protection.overexposure_threshold) */
+    sat_config_t sat_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows,
+        .threshold = ctx->config.overexposure_threshold
+    };
+
+    ctx->saturation = saturation_create(&sat_config);
+    if (ctx->saturation == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to initialize saturation counter");
+    } else {
+        health_monitor_log(LOG_INFO, "main", "Overexposure protection ready (kernel=%s, action=%u)",
+                         saturation_get_kernel_name(), ctx->config.overflow_action);
+    }
+
+    /* Initialize temporal filter (disabled until CMD_CONFIG_TEMPORAL) */
+    tf_config_t tf_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows
+    };
+    temporal_filter_params_defaults(&tf_config.params);
+    tf_config.params.enabled = 0;
+
+    ctx->tfilter = temporal_filter_create(&tf_config);
+    if (ctx->tfilter == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to initialize temporal filter");
+    }
+
+    /* Correction bands on all cores */
+    tp_config_t pool_config = {
+        .threads = PROC_POOL_THREADS,
+        .cpu_mask = PROC_POOL_CPU_MASK,
+        .priority = THREAD_PRIORITY_TX
+    };
+
+    ctx->pool = thread_pool_create(&pool_config);
+    if (ctx->pool == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to start processing pool (single-threaded)");
+    } else if (ctx->correction != NULL) {
+        correction_set_thread_pool(ctx->correction, ctx->pool);
+        health_monitor_log(LOG_INFO, "main", "Processing pool ready (%u threads)",
+                         thread_pool_threads(ctx->pool));
+    }
+
+    /* Initialize auto-exposure (continuous scans, needs FPGA register access) */
+    ctx->stats_config = (fstats_config_t){
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows,
+        .row_step = FSTATS_DEFAULT_STEP,
+        .col_step = FSTATS_DEFAULT_STEP,
+        /* Central quarter of the panel */
+        .roi_x = ctx->config.detector.cols / 4,
+        .roi_y = ctx->config.detector.rows / 4,
+        .roi_width = ctx->config.detector.cols / 2,
+        .roi_height = ctx->config.detector.rows / 2
+    };
+
+    if (ctx->spi_ctx != NULL) {
+        ae_config_t ae_config;
+        ae_config_defaults(&ae_config);
+        seq_exposure_t programmed;
+        seq_get_exposure(&programmed);
+
+        ctx->ae = ae_create(&ae_config, &(ae_exposure_t){ programmed.timing, programmed.gain });
+        if (ctx->ae == NULL) {
+            health_monitor_log(LOG_WARNING, "main", "Failed to initialize auto-exposure");
+        } else {
+            health_monitor_log(LOG_INFO, "main", "Auto-exposure ready (stats kernel=%s)",
+                             frame_stats_get_kernel_name());
+        }
+    }
+
+    /* Initialize calibration accumulator */
+    calib_config_t calib_config = {
+        .width = ctx->config.detector.cols,
+        .height = ctx->config.detector.rows
+    };
+
+    ctx->calib = calib_create(&calib_config);
+    if (ctx->calib == NULL) {
+        health_monitor_log(LOG_WARNING, "main", "Failed to initialize calibration accumulator");
+    }
+
+    /* Background defect drift tracking (drift: section) */
+    if (ctx->config.drift_enabled) {
+        drift_config_t drift_config = {
+            .width = ctx->config.detector.cols,
+            .height = ctx->config.detector.rows,
+            .pixels_per_frame = ctx->config.drift_pixels_per_frame,
+            .weight_shift = ctx->config.drift_weight_shift,
+            .offset_threshold = ctx->config.drift_offset_threshold,
+            .noise_threshold = ctx->config.drift_noise_threshold,
+            .dark_level = ctx->config.drift_dark_level,
+            .background = true
+        };
+
+        ctx->drift = pixel_drift_create(&drift_config);
+        if (ctx->drift == NULL) {
+            health_monitor_log(LOG_WARNING, "main", "Failed to initialize drift tracking");
+        } else {
+            drift_stats_t drift_stats;
+            pixel_drift_get_stats(ctx->drift, &drift_stats);
+            health_monitor_log(LOG_INFO, "main", "Drift tracking: sweep of %u frames (kernel=%s)",
+                             drift_stats.blocks, pixel_drift_get_kernel_name());
+        }
+    }
+
+    /* Per-frame image QA in the stats stage (qa: section) */
+    if (ctx->config.qa_enabled) {
+        fqa_config_t qa_config = {
+            .width = ctx->config.detector.cols,
+            .height = ctx->config.detector.rows,
+            .row_step = ctx->config.qa_row_step,
+            .roi_count = ctx->config.qa_roi_count
+        };
+        for (uint8_t i = 0; i < ctx->config.qa_roi_count; i++) {
+            const config_roi_t *roi = &ctx->config.qa_rois[i];
+            qa_config.rois[i] = (fqa_roi_t){ roi->x, roi->y, roi->width, roi->height };
+        }
+
+        ctx->frame_qa = frame_qa_create(&qa_config);
+        if (ctx->frame_qa == NULL) {
+            health_monitor_log(LOG_WARNING, "main", "Failed to initialize image QA");
+        } else {
+            health_monitor_log(LOG_INFO, "main", "Image QA ready (kernel=%s)",
+                             frame_qa_get_kernel_name());
+        }
+    }
+
+    /* Dual-gain HDR: alternate FPGA_REG_GAIN and fuse pairs (hdr: section) */
+    if (ctx->config.hdr_enabled) {
+        uint16_t full_scale = (uint16_t)((1U << ctx->config.detector.bit_depth) - 1U);
+        hdr_config_t hdr_config = {
+            .width = ctx->config.detector.cols,
+            .height = ctx->config.detector.rows,
+            .low_gain = (ctx->config.hdr_low_gain != 0) ? ctx->config.hdr_low_gain
+                                                        : SEQ_DEFAULT_GAIN,
+            .high_gain = ctx->config.hdr_high_gain,
+            .threshold = (ctx->config.hdr_threshold != 0) ? ctx->config.hdr_threshold
+                                                          : (uint16_t)(full_scale * 9U / 10U),
+            .blend = ctx->config.hdr_blend,
+            .output_shift = ctx->config.hdr_output_shift
+        };
+        seq_hdr_t seq_hdr = { true, hdr_config.low_gain, hdr_config.high_gain };
+
+        ctx->hdr = hdr_fusion_create(&hdr_config);
+        if (ctx->hdr == NULL || seq_set_hdr(&seq_hdr) != 0) {
+            health_monitor_log(LOG_WARNING, "main", "Failed to initialize HDR fusion");
+            hdr_fusion_destroy(ctx->hdr);
+            ctx->hdr = NULL;
+        } else {
+            health_monitor_log(LOG_INFO, "main", "HDR fusion: gain 0x%04X/0x%04X (kernel=%s)",
+                             hdr_config.low_gain, hdr_config.high_gain,
+                             hdr_fusion_get_kernel_name());
+        }
+    }
+
+    /* Exposure gate: tag, decimate or drop frames without signal (gate: section) */
+    if (ctx->config.gate_action != 0) {
+        egate_config_t gate_config = {
+            .dark_level = ctx->config.gate_dark_level,
+            .mean_margin = ctx->config.gate_mean_margin,
+            .max_margin = ctx->config.gate_max_margin,
+            .row_step = ctx->config.gate_row_step,
+            .hold_frames = ctx->config.gate_hold_frames,
+            .action = (egate_action_t)(ctx->config.gate_action - 1),
+            .decimate = ctx->config.gate_decimate
+        };
+
+        ctx->gate = exposure_gate_create(&gate_config);
+        if (ctx->gate == NULL) {
+            health_monitor_log(LOG_WARNING, "main", "Failed to initialize exposure gate");
+        } else {
+            health_monitor_log(LOG_INFO, "main", "Exposure gate: dark %u, action %u (kernel=%s)",
+                             gate_config.dark_level, ctx->config.gate_action,
+                             exposure_gate_get_kernel_name());
+        }
+    }
+
     /* Initialize command protocol */
     ret = command_protocol_init(&ctx->cmd_ctx, 8001);
     if (ret != 0) {
@@ -720,6 +2486,42 @@ static int init_modules(daemon_context_t *ctx) {
         return -1;
     }
 
+    if (ctx->defects != NULL) {
+        cmd_register_config_handler(CMD_CONFIG_DEFECT_MAP, defect_config_handler, ctx->defects);
+    }
+    if (ctx->tfilter != NULL) {
+        cmd_register_config_handler(CMD_CONFIG_TEMPORAL, temporal_config_handler, ctx->tfilter);
+    }
+    if (ctx->drift != NULL) {
+        cmd_register_data_handler(CMD_DATA_DRIFT_CANDIDATES, drift_data_handler, ctx->drift);
+    }
+    cmd_register_config_handler(CMD_CONFIG_TRACE, trace_config_handler, NULL);
+
+    /* Processing stages; the TX thread builds the chain per scan mode */
+    ctx->pipe_mode = -1;
+    ret = register_pipeline_stages(ctx);
+    if (ret != 0) {
+        health_monitor_log(LOG_ERROR, "main", "Failed to register pipeline stages: %d", ret);
+        return -1;
+    }
+
+    /* Statistics for Prometheus and detector-stat; both threads run SCHED_OTHER */
+    start_metrics(ctx);
+    start_stats_page(ctx);
+
+    /* GET_STATUS reads a snapshot; only this thread touches the devices for it */
+    health_status_config_t status_config = {
+        .spi = ctx->spi_ctx,
+        .battery = ctx->battery_ctx.initialized ? &ctx->battery_ctx : NULL,
+        .state_ms = ctx->config.status_state_ms,
+        .battery_ms = ctx->config.status_battery_ms,
+        .temp_ms = ctx->config.status_temp_ms,
+        .nice = STATUS_THREAD_NICE
+    };
+    if (health_monitor_start_status(&status_config) != 0) {
+        health_monitor_log(LOG_WARNING, "main", "Status collector unavailable, GET_STATUS reports defaults");
+    }
+
     return 0;
 }
 
@@ -802,7 +2604,60 @@ static void stop_threads(daemon_context_t *ctx) {
 static void cleanup_modules(daemon_context_t *ctx) {
     health_monitor_log(LOG_INFO, "main", "Cleaning up modules");
 
+    /* Scrapes, the stats page and the status collector read the modules below */
+    health_monitor_stop_status();
+    metrics_server_stop();
+    stats_page_destroy(ctx->stats_page);
+    ctx->stats_page = NULL;
+
+    /* Stages use the modules below: drain and stop them first */
+    if (ctx->pipe != NULL) {
+        log_pipeline_stats(ctx);
+        pipeline_destroy(ctx->pipe);
+        ctx->pipe = NULL;
+    }
+    pipeline_registry_destroy(ctx->stages);
+    ctx->stages = NULL;
+
     command_protocol_cleanup(&ctx->cmd_ctx);
+    cmd_register_config_handler(CMD_CONFIG_DEFECT_MAP, NULL, NULL);
+    cmd_register_config_handler(CMD_CONFIG_TEMPORAL, NULL, NULL);
+    cmd_register_config_handler(CMD_CONFIG_TRACE, NULL, NULL);
+    cmd_register_data_handler(CMD_DATA_DRIFT_CANDIDATES, NULL, NULL);
+    pixel_drift_destroy(ctx->drift);
+    ctx->drift = NULL;
+    frame_qa_destroy(ctx->frame_qa);
+    ctx->frame_qa = NULL;
+    hdr_fusion_destroy(ctx->hdr);
+    ctx->hdr = NULL;
+    exposure_gate_destroy(ctx->gate);
+    ctx->gate = NULL;
+    calib_destroy(ctx->calib);
+    ctx->calib = NULL;
+    correction_destroy(ctx->correction);
+    ctx->correction = NULL;
+    defect_map_destroy(ctx->defects);
+    ctx->defects = NULL;
+    ae_destroy(ctx->ae);
+    ctx->ae = NULL;
+    saturation_destroy(ctx->saturation);
+    ctx->saturation = NULL;
+    temporal_filter_destroy(ctx->tfilter);
+    ctx->tfilter = NULL;
+    thread_pool_destroy(ctx->pool);
+    ctx->pool = NULL;
+    orientation_destroy(ctx->orientation);
+    ctx->orientation = NULL;
+    for (uint8_t i = 0; i < CONFIG_MAX_OUTPUTS; i++) {
+        eth_tx_destroy(ctx->outputs[i]);
+        ctx->outputs[i] = NULL;
+    }
+    window_level_destroy(ctx->display);
+    ctx->display = NULL;
+    free(ctx->display_buf);
+    ctx->display_buf = NULL;
+    descramble_destroy(ctx->descramble);
+    ctx->descramble = NULL;
     frame_manager_cleanup(&ctx->frame_mgr);
     sequence_engine_cleanup(&ctx->seq_eng);
     bq40z50_cleanup(&ctx->battery_ctx);
@@ -810,6 +2665,7 @@ static void cleanup_modules(daemon_context_t *ctx) {
     csi2_rx_destroy(ctx->csi2_ctx);
     spi_master_destroy(ctx->spi_ctx);
     g_spi_master = NULL;
+    trace_deinit();
     health_monitor_deinit();
 
     config_loader_cleanup(&ctx->config);
@@ -819,6 +2675,44 @@ static void cleanup_modules(daemon_context_t *ctx) {
  * Main Entry Point
  * ========================================================================== */
 
+static void report_kernel_selftest(const cpu_kernel_t *kernel, cpu_isa_t isa, bool passed,
+                                   void *user_data) {
+    (void)user_data;
+    printf("  %-24s %-8s %s\n", kernel->name, cpu_dispatch_isa_name(isa),
+           passed ? "OK" : "MISMATCH");
+}
+
+/**
+ * @brief Check every SIMD kernel variant against scalar (--kernel-selftest)
+ *
+ * @return Process exit status: 0 if all variants match
+ */
+static int run_kernel_selftest(void) {
+    static const cpu_kernel_t *const kernels[] = {
+        &correction_kernel_q14,
+        &correction_kernel_fp16,
+        &correction_kernel_q14_count,
+        &correction_kernel_fp16_count,
+        &descramble_kernel_reverse,
+        &frame_stats_kernel_span,
+        &frame_qa_kernel_span,
+        &hdr_fusion_kernel_fuse,
+        &exposure_gate_kernel_row,
+        &orientation_kernel_tile,
+        &saturation_kernel_count,
+        &temporal_filter_kernel_row,
+        &window_level_kernel_linear,
+        &pixel_drift_kernel_update,
+        &calib_kernel_accumulate
+    };
+
+    uint32_t failures = cpu_dispatch_selftest(kernels, sizeof(kernels) / sizeof(kernels[0]),
+                                              KERNEL_SELFTEST_ROUNDS, report_kernel_selftest,
+                                              NULL);
+    printf("Kernel self-test: %u failure(s)\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
+
 int main(int argc, char *argv[]) {
     int ret;
     FILE *pid_file = NULL;
@@ -826,10 +2720,30 @@ int main(int argc, char *argv[]) {
     printf("%s v%s - X-ray Detector Panel SoC Controller\n", DAEMON_NAME, DAEMON_VERSION);
     printf("Copyright (c) 2026 ABYZ Lab\n");
 
-    /* Parse command line arguments */
+    /* Parse command line arguments: [--isa=LEVEL] [--kernel-selftest] [config] */
     const char *config_path = CONFIG_PATH;
-    if (argc > 1) {
-        config_path = argv[1];
+    const char *isa = NULL;
+    bool kernel_selftest = false;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--isa=", 6) == 0) {
+            isa = argv[i] + 6;
+        } else if (strcmp(argv[i], "--kernel-selftest") == 0) {
+            kernel_selftest = true;
+        } else {
+            config_path = argv[i];
+        }
+    }
+
+    /* Kernel variants are chosen when modules are created */
+    ret = cpu_dispatch_init(isa);
+    if (ret != 0) {
+        fprintf(stderr, "Unsupported --isa=%s (%s)\n", isa, strerror(-ret));
+        return 1;
+    }
+    printf("Pixel kernels: %s\n", cpu_dispatch_isa_name(cpu_dispatch_level()));
+
+    if (kernel_selftest) {
+        return run_kernel_selftest();
     }
 
     /* Initialize daemon context */
@@ -847,6 +2761,8 @@ int main(int argc, char *argv[]) {
 
     /* Initialize mutex */
     pthread_mutex_init(&g_daemon_ctx.state_mutex, NULL);
+    pthread_mutex_init(&g_daemon_ctx.tx_wake_mutex, NULL);
+    pthread_cond_init(&g_daemon_ctx.tx_wake_cond, NULL);
 
     /* Initialize modules */
     ret = init_modules(&g_daemon_ctx);
@@ -913,7 +2829,7 @@ int main(int argc, char *argv[]) {
             seq_get_stats(&seq_stats);
 
             health_monitor_log(LOG_INFO, "main", "=== Debug Info ===");
-            health_monitor_log(LOG_INFO, "main", "Uptime: %u sec", g_daemon_ctx.uptime_sec);
+            health_monitor_log(LOG_INFO, "main", "Uptime: %u sec", daemon_uptime_sec(&g_daemon_ctx));
             health_monitor_log(LOG_INFO, "main", "Seq State: %s", seq_state_to_string(seq_get_state()));
             health_monitor_log(LOG_INFO, "main", "Frames: rcvd=%lu, sent=%lu, dropped=%lu",
                              stats.frames_received, stats.frames_sent, stats.frames_dropped);
@@ -921,6 +2837,9 @@ int main(int argc, char *argv[]) {
                              stats.spi_errors, stats.csi2_errors, stats.auth_failures);
             health_monitor_log(LOG_INFO, "main", "================");
             g_signal_received = 0;
+        } else if (g_signal_received == SIGUSR2) {
+            trace_toggle(!trace_active());
+            g_signal_received = 0;
         }
     }
 
@@ -935,6 +2854,8 @@ int main(int argc, char *argv[]) {
 
     health_monitor_log(LOG_INFO, "main", "Daemon shutdown complete");
 
+    pthread_cond_destroy(&g_daemon_ctx.tx_wake_cond);
+    pthread_mutex_destroy(&g_daemon_ctx.tx_wake_mutex);
     pthread_mutex_destroy(&g_daemon_ctx.state_mutex);
 
     return 0;
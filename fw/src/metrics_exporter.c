@@ -0,0 +1,463 @@
+/**
+ * @file metrics_exporter.c
+ * @brief OpenMetrics (Prometheus) HTTP endpoint for daemon statistics
+ *
+ * One SCHED_OTHER thread polls the listen socket and answers one request
+ * per connection (Connection: close). A scrape renders into a buffer
+ * allocated at start, so the collect callback runs without allocation or
+ * locks; statistics are read as they are, and a counter that moves during
+ * the scrape is simply reported at whichever value was loaded.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "metrics_exporter.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#define METRICS_POLL_MS         100     /* Stop flag check interval */
+#define METRICS_IO_TIMEOUT_S    2       /* Per-connection read/write timeout */
+#define METRICS_REQUEST_MAX     1024    /* Request bytes kept (line and headers) */
+#define METRICS_HEADER_MAX      256
+#define METRICS_NS_PER_SEC      1.0e9
+
+#define METRICS_CONTENT_TYPE    "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+/**
+ * @brief Scrape output being built
+ */
+struct metrics_writer {
+    char *buf;
+    size_t cap;
+    size_t len;
+    bool overflow;              /**< Output did not fit; len stays at the last fit */
+};
+
+static struct {
+    metrics_config_t config;
+    int listen_fd;
+    uint16_t port;
+    pthread_t thread;
+    char *body;                 /**< METRICS_MAX_BODY bytes */
+    atomic_bool running;
+    atomic_bool stop;
+
+    atomic_uint_least64_t scrapes;
+    atomic_uint_least64_t bad_requests;
+    atomic_uint_least32_t last_bytes;
+    atomic_uint_least32_t last_us;
+} g_metrics = {
+    .listen_fd = -1
+};
+
+/* ==========================================================================
+ * Histogram
+ * ========================================================================== */
+
+metrics_status_t metrics_histogram_init(metrics_histogram_t *hist,
+                                        const uint64_t *bounds_ns, uint32_t count) {
+    if (hist == NULL || bounds_ns == NULL) {
+        return METRICS_ERROR_NULL;
+    }
+
+    if (count == 0 || count > METRICS_HIST_MAX_BUCKETS) {
+        return METRICS_ERROR_PARAM;
+    }
+
+    for (uint32_t i = 1; i < count; i++) {
+        if (bounds_ns[i] <= bounds_ns[i - 1]) {
+            return METRICS_ERROR_PARAM;
+        }
+    }
+
+    hist->buckets = count;
+    memcpy(hist->bounds_ns, bounds_ns, count * sizeof(bounds_ns[0]));
+    for (uint32_t i = 0; i <= METRICS_HIST_MAX_BUCKETS; i++) {
+        atomic_store_explicit(&hist->counts[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&hist->sum_ns, 0, memory_order_relaxed);
+    return METRICS_OK;
+}
+
+void metrics_histogram_observe(metrics_histogram_t *hist, uint64_t value_ns) {
+    uint32_t i = 0;
+    while (i < hist->buckets && value_ns > hist->bounds_ns[i]) {
+        i++;
+    }
+    atomic_fetch_add_explicit(&hist->counts[i], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&hist->sum_ns, value_ns, memory_order_relaxed);
+}
+
+/* ==========================================================================
+ * Writer
+ * ========================================================================== */
+
+static void metrics_printf(metrics_writer_t *writer, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void metrics_printf(metrics_writer_t *writer, const char *format, ...) {
+    if (writer->overflow) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(writer->buf + writer->len, writer->cap - writer->len, format, args);
+    va_end(args);
+
+    if (n < 0 || (size_t)n >= writer->cap - writer->len) {
+        writer->overflow = true;
+        writer->buf[writer->len] = '\0';
+        return;
+    }
+    writer->len += (size_t)n;
+}
+
+void metrics_write_family(metrics_writer_t *writer, const char *name,
+                          const char *type, const char *help) {
+    if (writer == NULL || name == NULL || type == NULL) {
+        return;
+    }
+
+    metrics_printf(writer, "# TYPE %s %s\n", name, type);
+    if (help != NULL) {
+        metrics_printf(writer, "# HELP %s %s\n", name, help);
+    }
+}
+
+void metrics_write_sample(metrics_writer_t *writer, const char *name,
+                          const char *label, const char *label_value, double value) {
+    if (writer == NULL || name == NULL) {
+        return;
+    }
+
+    if (label != NULL && label_value != NULL) {
+        metrics_printf(writer, "%s{%s=\"%s\"} %.15g\n", name, label, label_value, value);
+    } else {
+        metrics_printf(writer, "%s %.15g\n", name, value);
+    }
+}
+
+void metrics_write_counter(metrics_writer_t *writer, const char *name,
+                           const char *help, uint64_t value) {
+    if (writer == NULL || name == NULL) {
+        return;
+    }
+
+    /* Integer text: a double would round counters past 2^53 */
+    metrics_write_family(writer, name, "counter", help);
+    metrics_printf(writer, "%s_total %llu\n", name, (unsigned long long)value);
+}
+
+void metrics_write_gauge(metrics_writer_t *writer, const char *name,
+                         const char *help, double value) {
+    metrics_write_family(writer, name, "gauge", help);
+    metrics_write_sample(writer, name, NULL, NULL, value);
+}
+
+void metrics_write_histogram(metrics_writer_t *writer, const char *name,
+                             const char *help, const metrics_histogram_t *hist) {
+    if (writer == NULL || name == NULL || hist == NULL) {
+        return;
+    }
+
+    /* One load per bucket, so _count always equals the +Inf bucket */
+    uint64_t counts[METRICS_HIST_MAX_BUCKETS + 1];
+    for (uint32_t i = 0; i <= hist->buckets; i++) {
+        counts[i] = atomic_load_explicit(&hist->counts[i], memory_order_relaxed);
+    }
+    uint64_t sum_ns = atomic_load_explicit(&hist->sum_ns, memory_order_relaxed);
+
+    metrics_write_family(writer, name, "histogram", help);
+
+    uint64_t cumulative = 0;
+    for (uint32_t i = 0; i < hist->buckets; i++) {
+        cumulative += counts[i];
+        metrics_printf(writer, "%s_bucket{le=\"%.9g\"} %llu\n", name,
+                       (double)hist->bounds_ns[i] / METRICS_NS_PER_SEC,
+                       (unsigned long long)cumulative);
+    }
+    cumulative += counts[hist->buckets];
+    metrics_printf(writer, "%s_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long)cumulative);
+    metrics_printf(writer, "%s_count %llu\n", name, (unsigned long long)cumulative);
+    metrics_printf(writer, "%s_sum %.9g\n", name, (double)sum_ns / METRICS_NS_PER_SEC);
+}
+
+int metrics_render(metrics_collect_fn_t collect, void *user_data, char *buf, size_t cap) {
+    if (collect == NULL || buf == NULL) {
+        return METRICS_ERROR_NULL;
+    }
+
+    if (cap == 0) {
+        return METRICS_ERROR_PARAM;
+    }
+
+    metrics_writer_t writer = { .buf = buf, .cap = cap, .len = 0, .overflow = false };
+    buf[0] = '\0';
+    collect(&writer, user_data);
+    metrics_printf(&writer, "# EOF\n");
+
+    return writer.overflow ? METRICS_ERROR_PARAM : (int)writer.len;
+}
+
+/* ==========================================================================
+ * Server
+ * ========================================================================== */
+
+static uint64_t metrics_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+static bool metrics_send_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void metrics_reply(int fd, const char *status, const char *type,
+                          const char *body, size_t body_len) {
+    char header[METRICS_HEADER_MAX];
+    int n = snprintf(header, sizeof(header),
+                     "HTTP/1.1 %s\r\n"
+                     "Content-Type: %s\r\n"
+                     "Content-Length: %zu\r\n"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     status, type, body_len);
+
+    if (metrics_send_all(fd, header, (size_t)n) && body_len > 0) {
+        metrics_send_all(fd, body, body_len);
+    }
+}
+
+/**
+ * @brief Read the request line and headers (up to the blank line)
+ *
+ * @return true if a complete request head arrived before the timeout
+ */
+static bool metrics_read_request(int fd, char *buf, size_t cap) {
+    size_t used = 0;
+
+    while (used < cap - 1) {
+        ssize_t n = recv(fd, buf + used, cap - 1 - used, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        used += (size_t)n;
+        buf[used] = '\0';
+        if (strstr(buf, "\r\n\r\n") != NULL || strstr(buf, "\n\n") != NULL) {
+            return true;
+        }
+    }
+
+    /* Oversized headers: the request line is all we need */
+    return strchr(buf, '\n') != NULL;
+}
+
+static void metrics_serve(int fd) {
+    char request[METRICS_REQUEST_MAX];
+    struct timeval timeout = { .tv_sec = METRICS_IO_TIMEOUT_S, .tv_usec = 0 };
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    if (!metrics_read_request(fd, request, sizeof(request))) {
+        atomic_fetch_add_explicit(&g_metrics.bad_requests, 1, memory_order_relaxed);
+        return;
+    }
+
+    const char *path = strchr(request, ' ');
+    if (path == NULL) {
+        atomic_fetch_add_explicit(&g_metrics.bad_requests, 1, memory_order_relaxed);
+        metrics_reply(fd, "400 Bad Request", "text/plain", NULL, 0);
+        return;
+    }
+    path++;
+
+    if ((size_t)(path - request) != 4 || strncmp(request, "GET ", 4) != 0) {
+        atomic_fetch_add_explicit(&g_metrics.bad_requests, 1, memory_order_relaxed);
+        metrics_reply(fd, "405 Method Not Allowed", "text/plain", NULL, 0);
+        return;
+    }
+
+    size_t path_len = strcspn(path, " ?\r\n");
+    if (path_len != strlen("/metrics") || strncmp(path, "/metrics", path_len) != 0) {
+        atomic_fetch_add_explicit(&g_metrics.bad_requests, 1, memory_order_relaxed);
+        metrics_reply(fd, "404 Not Found", "text/plain", NULL, 0);
+        return;
+    }
+
+    uint64_t start_us = metrics_now_us();
+    int len = metrics_render(g_metrics.config.collect, g_metrics.config.user_data,
+                             g_metrics.body, METRICS_MAX_BODY);
+    if (len < 0) {
+        atomic_fetch_add_explicit(&g_metrics.bad_requests, 1, memory_order_relaxed);
+        metrics_reply(fd, "500 Internal Server Error", "text/plain", NULL, 0);
+        return;
+    }
+
+    metrics_reply(fd, "200 OK", METRICS_CONTENT_TYPE, g_metrics.body, (size_t)len);
+
+    atomic_fetch_add_explicit(&g_metrics.scrapes, 1, memory_order_relaxed);
+    atomic_store_explicit(&g_metrics.last_bytes, (uint32_t)len, memory_order_relaxed);
+    atomic_store_explicit(&g_metrics.last_us, (uint32_t)(metrics_now_us() - start_us),
+                          memory_order_relaxed);
+}
+
+static void *metrics_thread(void *arg) {
+    (void)arg;
+
+    prctl(PR_SET_NAME, "metrics_http", 0, 0, 0);
+    if (g_metrics.config.nice != 0) {
+        /* Linux: who = 0 is the calling thread */
+        setpriority(PRIO_PROCESS, 0, g_metrics.config.nice);
+    }
+
+    struct pollfd pfd = { .fd = g_metrics.listen_fd, .events = POLLIN };
+
+    while (!atomic_load_explicit(&g_metrics.stop, memory_order_acquire)) {
+        if (poll(&pfd, 1, METRICS_POLL_MS) <= 0) {
+            continue;
+        }
+
+        int fd = accept4(g_metrics.listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        metrics_serve(fd);
+        close(fd);
+    }
+
+    return NULL;
+}
+
+metrics_status_t metrics_server_start(const metrics_config_t *config) {
+    if (config == NULL || config->collect == NULL) {
+        return METRICS_ERROR_NULL;
+    }
+
+    if (atomic_load(&g_metrics.running)) {
+        return METRICS_ERROR_STATE;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config->port);
+    if (inet_pton(AF_INET, (config->listen_addr != NULL) ? config->listen_addr : "127.0.0.1",
+                  &addr.sin_addr) != 1) {
+        return METRICS_ERROR_PARAM;
+    }
+
+    g_metrics.body = malloc(METRICS_MAX_BODY);
+    if (g_metrics.body == NULL) {
+        return METRICS_ERROR_MEMORY;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    socklen_t addr_len = sizeof(addr);
+    if (fd < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, 4) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        free(g_metrics.body);
+        g_metrics.body = NULL;
+        return METRICS_ERROR_SOCKET;
+    }
+
+    g_metrics.config = *config;
+    g_metrics.listen_fd = fd;
+    g_metrics.port = ntohs(addr.sin_port);
+    atomic_store(&g_metrics.stop, false);
+    atomic_store(&g_metrics.scrapes, 0);
+    atomic_store(&g_metrics.bad_requests, 0);
+    atomic_store(&g_metrics.last_bytes, 0);
+    atomic_store(&g_metrics.last_us, 0);
+
+    /* Explicit SCHED_OTHER: never inherit an RT policy from the caller */
+    pthread_attr_t attr;
+    struct sched_param param = { .sched_priority = 0 };
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    pthread_attr_setschedparam(&attr, &param);
+    int rc = pthread_create(&g_metrics.thread, &attr, metrics_thread, NULL);
+    pthread_attr_destroy(&attr);
+
+    if (rc != 0) {
+        close(fd);
+        g_metrics.listen_fd = -1;
+        g_metrics.port = 0;
+        free(g_metrics.body);
+        g_metrics.body = NULL;
+        return METRICS_ERROR_THREAD;
+    }
+
+    atomic_store_explicit(&g_metrics.running, true, memory_order_release);
+    return METRICS_OK;
+}
+
+void metrics_server_stop(void) {
+    if (!atomic_exchange(&g_metrics.running, false)) {
+        return;
+    }
+
+    atomic_store_explicit(&g_metrics.stop, true, memory_order_release);
+    pthread_join(g_metrics.thread, NULL);
+
+    close(g_metrics.listen_fd);
+    g_metrics.listen_fd = -1;
+    g_metrics.port = 0;
+    free(g_metrics.body);
+    g_metrics.body = NULL;
+}
+
+uint16_t metrics_server_port(void) {
+    return atomic_load(&g_metrics.running) ? g_metrics.port : 0;
+}
+
+metrics_status_t metrics_server_get_stats(metrics_server_stats_t *stats) {
+    if (stats == NULL) {
+        return METRICS_ERROR_NULL;
+    }
+
+    stats->scrapes = atomic_load_explicit(&g_metrics.scrapes, memory_order_relaxed);
+    stats->bad_requests = atomic_load_explicit(&g_metrics.bad_requests, memory_order_relaxed);
+    stats->last_bytes = atomic_load_explicit(&g_metrics.last_bytes, memory_order_relaxed);
+    stats->last_us = atomic_load_explicit(&g_metrics.last_us, memory_order_relaxed);
+    return METRICS_OK;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file auto_exposure.c
+ * @brief Closed-loop auto-exposure controller
+ */
+
+#include "proc/auto_exposure.h"
+#include <stdlib.h>
+#include <math.h>
+
+/**
+ * @brief Controller internal state
+ */
+struct ae_controller {
+    ae_config_t config;         /**< Configuration */
+    ae_exposure_t current;      /**< Registers as programmed */
+    ae_exposure_t previous;     /**< Registers before the last update */
+    uint32_t settle;            /**< Frames left to skip */
+    ae_stats_t stats;           /**< Statistics */
+};
+
+static uint16_t ae_clamp_u16(double v, uint16_t lo, uint16_t hi) {
+    if (!(v >= lo)) {
+        return lo;              /* Also catches NaN */
+    }
+    if (v >= hi) {
+        return hi;
+    }
+    return (uint16_t)(v + 0.5);
+}
+
+/**
+ * @brief Split an exposure product into timing and gain registers
+ *
+ * @return true if the product could not be reached within the limits
+ */
+static bool ae_split(const ae_config_t *cfg, double product, ae_exposure_t *out) {
+    uint16_t gain_ref = (AE_GAIN_UNITY < cfg->gain_min) ? cfg->gain_min :
+                        (AE_GAIN_UNITY > cfg->gain_max) ? cfg->gain_max : AE_GAIN_UNITY;
+
+    /* Prefer integration time at reference gain, then gain */
+    double timing = product / gain_ref;
+    out->timing = ae_clamp_u16(timing, cfg->timing_min, cfg->timing_max);
+
+    if (timing > cfg->timing_max || timing < cfg->timing_min) {
+        double gain = product / out->timing;
+        out->gain = ae_clamp_u16(gain, cfg->gain_min, cfg->gain_max);
+        return gain > cfg->gain_max || gain < cfg->gain_min;
+    }
+
+    out->gain = gain_ref;
+    return false;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+void ae_config_defaults(ae_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+
+    config->metric = AE_METRIC_ROI_MEAN;
+    config->percentile = AE_DEFAULT_PERCENTILE;
+    config->target = AE_DEFAULT_TARGET;
+    config->deadband = AE_DEFAULT_DEADBAND;
+    config->damping = AE_DEFAULT_DAMPING;
+    config->max_step = AE_DEFAULT_MAX_STEP;
+    config->settle_frames = AE_DEFAULT_SETTLE_FRAMES;
+    config->timing_min = 1;
+    config->timing_max = 0xFFFF;
+    config->gain_min = AE_GAIN_UNITY;
+    config->gain_max = 8 * AE_GAIN_UNITY;
+}
+
+ae_controller_t *ae_create(const ae_config_t *config, const ae_exposure_t *initial) {
+    if (config == NULL || initial == NULL ||
+        config->target == 0 ||
+        !(config->damping > 0.0f && config->damping <= 1.0f) ||
+        !(config->max_step > 1.0f) ||
+        !(config->deadband >= 0.0f && config->deadband < 1.0f) ||
+        !(config->percentile >= 0.0f && config->percentile <= 1.0f) ||
+        config->timing_min == 0 || config->timing_min > config->timing_max ||
+        config->gain_min == 0 || config->gain_min > config->gain_max) {
+        return NULL;
+    }
+
+    ae_controller_t *ae = (ae_controller_t *)calloc(1, sizeof(ae_controller_t));
+    if (ae == NULL) {
+        return NULL;
+    }
+
+    ae->config = *config;
+    ae_reset(ae, initial);
+
+    return ae;
+}
+
+void ae_destroy(ae_controller_t *ae) {
+    free(ae);
+}
+
+void ae_reset(ae_controller_t *ae, const ae_exposure_t *current) {
+    if (ae == NULL || current == NULL) {
+        return;
+    }
+
+    ae->current = *current;
+    ae->previous = *current;
+    ae->settle = 0;
+}
+
+bool ae_update(ae_controller_t *ae, const fstats_t *stats, ae_exposure_t *next) {
+    if (ae == NULL || stats == NULL || next == NULL) {
+        return false;
+    }
+
+    const ae_config_t *cfg = &ae->config;
+    ae->stats.frames++;
+
+    if (ae->settle > 0) {
+        ae->settle--;
+        ae->stats.settle_skips++;
+        return false;
+    }
+
+    float metric = (cfg->metric == AE_METRIC_PERCENTILE)
+                   ? (float)frame_stats_percentile(stats, cfg->percentile)
+                   : stats->roi_mean;
+    ae->stats.last_metric = metric;
+
+    /* A black frame still has to drive the loop upwards */
+    if (metric < 1.0f) {
+        metric = 1.0f;
+    }
+
+    double ratio = (double)cfg->target / metric;
+    if (fabs(ratio - 1.0) <= cfg->deadband) {
+        return false;
+    }
+
+    ratio = pow(ratio, cfg->damping);
+    if (ratio > cfg->max_step) {
+        ratio = cfg->max_step;
+    } else if (ratio < 1.0 / cfg->max_step) {
+        ratio = 1.0 / cfg->max_step;
+    }
+
+    double product = (double)ae->current.timing * ae->current.gain * ratio;
+    ae_exposure_t out;
+    if (ae_split(cfg, product, &out)) {
+        ae->stats.at_limit++;
+    }
+
+    if (out.timing == ae->current.timing && out.gain == ae->current.gain) {
+        return false;
+    }
+
+    ae->previous = ae->current;
+    ae->current = out;
+    ae->settle = cfg->settle_frames;
+    ae->stats.adjustments++;
+    *next = out;
+
+    return true;
+}
+
+void ae_record_write(ae_controller_t *ae, uint32_t latency_us, bool ok) {
+    if (ae == NULL) {
+        return;
+    }
+
+    ae->stats.writes++;
+    ae->stats.last_write_us = latency_us;
+    if (latency_us > ae->stats.max_write_us) {
+        ae->stats.max_write_us = latency_us;
+    }
+    if (latency_us > AE_WRITE_BUDGET_US) {
+        ae->stats.late_writes++;
+    }
+
+    if (!ok) {
+        /* Registers unchanged (or unknown): fall back and re-evaluate next frame */
+        ae->stats.write_errors++;
+        ae->current = ae->previous;
+        ae->settle = 0;
+    }
+}
+
+void ae_get_exposure(const ae_controller_t *ae, ae_exposure_t *exposure) {
+    if (ae == NULL || exposure == NULL) {
+        return;
+    }
+
+    *exposure = ae->current;
+}
+
+void ae_get_stats(const ae_controller_t *ae, ae_stats_t *stats) {
+    if (ae == NULL || stats == NULL) {
+        return;
+    }
+
+    *stats = ae->stats;
+}
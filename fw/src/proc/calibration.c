@@ -0,0 +1,503 @@
+/**
+ * @file calibration.c
+ * @brief On-device dark/flood calibration accumulator
+ *
+ * Accumulation kernels (selected at create time, see util/cpu_dispatch.h):
+ * - AArch64 NEON: vaddw_u16, 8 pixels per step
+ * - x86 AVX2: cvtepu16_epi32 + add_epi32, 8 pixels per step
+ * - x86 SSE4.2: cvtepu16_epi32 + add_epi32, 4 pixels per step
+ * - Scalar
+ *
+ * Maps are derived once per phase; only the per-frame accumulate is on the
+ * frame-rate path.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "proc/calibration.h"
+#include "util/crc16.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <libgen.h>
+#include <limits.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+typedef void (*calib_row_fn_t)(uint32_t *sum, const uint16_t *px, size_t n);
+
+/**
+ * @brief Calibration internal state
+ */
+struct calibration {
+    calib_config_t config;      /**< Geometry */
+    size_t pixel_count;         /**< width * height */
+
+    calib_phase_t phase;        /**< Current phase */
+    uint32_t frames_target;     /**< Frames to average */
+    uint32_t frames_accumulated;/**< Frames summed so far */
+    uint32_t *sum;              /**< Per-pixel 32-bit accumulator */
+    calib_row_fn_t accumulate;  /**< Accumulation kernel variant */
+
+    uint16_t *offset;           /**< Derived offset map */
+    float *gain;                /**< Derived gain map */
+    uint32_t dark_frames;       /**< Frames behind offset (0 = no map) */
+    uint32_t flood_frames;      /**< Frames behind gain (0 = no map) */
+
+    float dark_mean;            /**< Mean of offset map */
+    float flood_mean;           /**< Mean flood signal above offset */
+    uint32_t dead_pixels;       /**< Pixels with gain forced to 0 */
+};
+
+/* ==========================================================================
+ * Accumulation Kernels
+ * ========================================================================== */
+
+static void calib_accumulate_scalar(uint32_t *sum, const uint16_t *px, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        sum[i] += px[i];
+    }
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static void calib_accumulate_neon(uint32_t *sum, const uint16_t *px, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t p = vld1q_u16(px + i);
+        vst1q_u32(sum + i, vaddw_u16(vld1q_u32(sum + i), vget_low_u16(p)));
+        vst1q_u32(sum + i + 4, vaddw_high_u16(vld1q_u32(sum + i + 4), p));
+    }
+
+    calib_accumulate_scalar(sum + i, px + i, n - i);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static void calib_accumulate_sse42(uint32_t *sum, const uint16_t *px, size_t n) {
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(px + i)));
+        __m128i s = _mm_loadu_si128((const __m128i *)(sum + i));
+        _mm_storeu_si128((__m128i *)(sum + i), _mm_add_epi32(s, p));
+    }
+
+    calib_accumulate_scalar(sum + i, px + i, n - i);
+}
+
+CPU_TARGET_AVX2
+static void calib_accumulate_avx2(uint32_t *sum, const uint16_t *px, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(px + i)));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(sum + i));
+        _mm256_storeu_si256((__m256i *)(sum + i), _mm256_add_epi32(s, p));
+    }
+
+    calib_accumulate_scalar(sum + i, px + i, n - i);
+}
+
+#endif
+
+#define CALIB_CHECK_PIXELS  1031    /* Odd length exercises the tail */
+
+static bool calib_check_accumulate(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t px[CALIB_CHECK_PIXELS];
+    uint32_t sum_a[CALIB_CHECK_PIXELS], sum_b[CALIB_CHECK_PIXELS];
+    size_t n = CALIB_CHECK_PIXELS - (seed % 16);
+
+    for (size_t i = 0; i < n; i++) {
+        px[i] = (uint16_t)cpu_dispatch_random(&seed);
+        sum_a[i] = sum_b[i] = cpu_dispatch_random(&seed) >> 4;
+    }
+
+    ((calib_row_fn_t)candidate)(sum_a, px, n);
+    ((calib_row_fn_t)reference)(sum_b, px, n);
+
+    return memcmp(sum_a, sum_b, n * sizeof(uint32_t)) == 0;
+}
+
+static const cpu_variant_t calib_accumulate_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)calib_accumulate_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)calib_accumulate_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)calib_accumulate_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)calib_accumulate_avx2 },
+#endif
+};
+
+const cpu_kernel_t calib_kernel_accumulate = {
+    .name = "calibration.accumulate",
+    .variants = calib_accumulate_variants,
+    .variant_count = sizeof(calib_accumulate_variants) / sizeof(calib_accumulate_variants[0]),
+    .check = calib_check_accumulate
+};
+
+/* ==========================================================================
+ * Map Derivation
+ * ========================================================================== */
+
+/**
+ * @brief Derive offset map from dark accumulation
+ */
+static void calib_finish_dark(calib_t *calib) {
+    uint32_t n = calib->frames_accumulated;
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < calib->pixel_count; i++) {
+        uint32_t v = (uint32_t)(((uint64_t)calib->sum[i] + n / 2) / n);
+        calib->offset[i] = (uint16_t)v;
+        total += v;
+    }
+
+    calib->dark_frames = n;
+    calib->dark_mean = (float)((double)total / (double)calib->pixel_count);
+
+    /* A new offset invalidates any gain derived against the old one */
+    calib->flood_frames = 0;
+}
+
+/**
+ * @brief Derive gain map from flood accumulation
+ *
+ * Gains normalise each pixel to the mean flood response; pixels with
+ * (almost) no response get gain 0 and are counted as dead.
+ */
+static void calib_finish_flood(calib_t *calib) {
+    double n = (double)calib->frames_accumulated;
+    double total = 0.0;
+    size_t live = 0;
+
+    /* First pass: per-pixel signal into gain[], global mean over live pixels */
+    for (size_t i = 0; i < calib->pixel_count; i++) {
+        float signal = (float)((double)calib->sum[i] / n) - (float)calib->offset[i];
+        calib->gain[i] = signal;
+        if (signal >= CALIB_MIN_SIGNAL) {
+            total += signal;
+            live++;
+        }
+    }
+
+    float mean = (live > 0) ? (float)(total / (double)live) : 0.0f;
+    uint32_t dead = 0;
+
+    /* Second pass: signal -> gain */
+    for (size_t i = 0; i < calib->pixel_count; i++) {
+        float signal = calib->gain[i];
+        if (signal >= CALIB_MIN_SIGNAL) {
+            calib->gain[i] = mean / signal;
+        } else {
+            calib->gain[i] = 0.0f;
+            dead++;
+        }
+    }
+
+    calib->flood_frames = calib->frames_accumulated;
+    calib->flood_mean = mean;
+    calib->dead_pixels = dead;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+calib_t *calib_create(const calib_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0) {
+        return NULL;
+    }
+
+    calib_t *calib = (calib_t *)calloc(1, sizeof(calib_t));
+    if (calib == NULL) {
+        return NULL;
+    }
+
+    calib->config = *config;
+    calib->pixel_count = (size_t)config->width * config->height;
+    calib->phase = CALIB_PHASE_IDLE;
+    calib->accumulate = (calib_row_fn_t)cpu_dispatch_select(&calib_kernel_accumulate, NULL);
+
+    calib->sum = (uint32_t *)calloc(calib->pixel_count, sizeof(uint32_t));
+    calib->offset = (uint16_t *)calloc(calib->pixel_count, sizeof(uint16_t));
+    calib->gain = (float *)calloc(calib->pixel_count, sizeof(float));
+    if (calib->sum == NULL || calib->offset == NULL || calib->gain == NULL) {
+        calib_destroy(calib);
+        return NULL;
+    }
+
+    return calib;
+}
+
+void calib_destroy(calib_t *calib) {
+    if (calib == NULL) {
+        return;
+    }
+
+    free(calib->sum);
+    free(calib->offset);
+    free(calib->gain);
+    free(calib);
+}
+
+calib_status_t calib_begin(calib_t *calib, calib_phase_t phase, uint32_t frames) {
+    if (calib == NULL) {
+        return CALIB_ERROR_NULL;
+    }
+
+    if ((phase != CALIB_PHASE_DARK && phase != CALIB_PHASE_FLOOD) ||
+        frames == 0 || frames > CALIB_MAX_FRAMES) {
+        return CALIB_ERROR_PARAM;
+    }
+
+    if (phase == CALIB_PHASE_FLOOD && calib->dark_frames == 0) {
+        return CALIB_ERROR_STATE;
+    }
+
+    memset(calib->sum, 0, calib->pixel_count * sizeof(uint32_t));
+    calib->phase = phase;
+    calib->frames_target = frames;
+    calib->frames_accumulated = 0;
+
+    return CALIB_OK;
+}
+
+void calib_abort(calib_t *calib) {
+    if (calib == NULL) {
+        return;
+    }
+
+    calib->phase = CALIB_PHASE_IDLE;
+    calib->frames_target = 0;
+    calib->frames_accumulated = 0;
+}
+
+calib_status_t calib_accumulate(calib_t *calib, const uint16_t *frame) {
+    if (calib == NULL || frame == NULL) {
+        return CALIB_ERROR_NULL;
+    }
+
+    if (calib->phase == CALIB_PHASE_IDLE) {
+        return CALIB_ERROR_STATE;
+    }
+
+    calib->accumulate(calib->sum, frame, calib->pixel_count);
+    calib->frames_accumulated++;
+
+    if (calib->frames_accumulated < calib->frames_target) {
+        return CALIB_OK;
+    }
+
+    if (calib->phase == CALIB_PHASE_DARK) {
+        calib_finish_dark(calib);
+    } else {
+        calib_finish_flood(calib);
+    }
+    calib->phase = CALIB_PHASE_IDLE;
+
+    return CALIB_PHASE_COMPLETE;
+}
+
+calib_phase_t calib_get_phase(const calib_t *calib) {
+    return (calib != NULL) ? calib->phase : CALIB_PHASE_IDLE;
+}
+
+bool calib_maps_ready(const calib_t *calib) {
+    return calib != NULL && calib->dark_frames > 0 && calib->flood_frames > 0;
+}
+
+const uint16_t *calib_get_offset_map(const calib_t *calib) {
+    return (calib != NULL && calib->dark_frames > 0) ? calib->offset : NULL;
+}
+
+const float *calib_get_gain_map(const calib_t *calib) {
+    return (calib != NULL && calib->flood_frames > 0) ? calib->gain : NULL;
+}
+
+void calib_get_stats(const calib_t *calib, calib_stats_t *stats) {
+    if (calib == NULL || stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->phase = calib->phase;
+    stats->frames_target = calib->frames_target;
+    stats->frames_accumulated = calib->frames_accumulated;
+    stats->dark_frames = calib->dark_frames;
+    stats->flood_frames = calib->flood_frames;
+    stats->dark_mean = calib->dark_mean;
+    stats->flood_mean = calib->flood_mean;
+    stats->dead_pixels = calib->dead_pixels;
+}
+
+/* ==========================================================================
+ * Persistence
+ * ========================================================================== */
+
+static int calib_write_all(int fd, const void *buf, size_t len) {
+    const uint8_t *p = (const uint8_t *)buf;
+
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+
+    return 0;
+}
+
+static int calib_read_all(int fd, void *buf, size_t len) {
+    uint8_t *p = (uint8_t *)buf;
+
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            return -1;  /* Truncated */
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief fsync the directory containing path so the rename is durable
+ */
+static int calib_sync_dir(const char *path) {
+    char dir[PATH_MAX];
+
+    strncpy(dir, path, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+
+    int dfd = open(dirname(dir), O_RDONLY | O_DIRECTORY);
+    if (dfd < 0) {
+        return -1;
+    }
+
+    int ret = fsync(dfd);
+    close(dfd);
+    return ret;
+}
+
+calib_status_t calib_save_maps(const calib_t *calib, const char *path) {
+    if (calib == NULL || path == NULL) {
+        return CALIB_ERROR_NULL;
+    }
+
+    if (!calib_maps_ready(calib)) {
+        return CALIB_ERROR_STATE;
+    }
+
+    char tmp_path[PATH_MAX];
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        return CALIB_ERROR_PARAM;
+    }
+
+    size_t offset_bytes = calib->pixel_count * sizeof(uint16_t);
+    size_t gain_bytes = calib->pixel_count * sizeof(float);
+
+    calib_file_header_t header = {
+        .magic = CALIB_FILE_MAGIC,
+        .version = CALIB_FILE_VERSION,
+        .width = calib->config.width,
+        .height = calib->config.height,
+        .dark_frames = calib->dark_frames,
+        .flood_frames = calib->flood_frames,
+        .timestamp = (uint64_t)time(NULL)
+    };
+    header.crc = crc16_compute((const uint8_t *)calib->offset, offset_bytes);
+    header.crc = crc16_compute_with_init((const uint8_t *)calib->gain, gain_bytes, header.crc);
+
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return CALIB_ERROR_FILE;
+    }
+
+    if (calib_write_all(fd, &header, sizeof(header)) != 0 ||
+        calib_write_all(fd, calib->offset, offset_bytes) != 0 ||
+        calib_write_all(fd, calib->gain, gain_bytes) != 0 ||
+        fsync(fd) != 0) {
+        close(fd);
+        unlink(tmp_path);
+        return CALIB_ERROR_FILE;
+    }
+
+    if (close(fd) != 0 || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return CALIB_ERROR_FILE;
+    }
+
+    /* Rename already happened; a failed directory sync only risks durability */
+    calib_sync_dir(path);
+
+    return CALIB_OK;
+}
+
+calib_status_t calib_load_maps(const char *path, uint32_t width, uint32_t height,
+                               uint16_t *offset, float *gain) {
+    if (path == NULL || offset == NULL || gain == NULL) {
+        return CALIB_ERROR_NULL;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return CALIB_ERROR_FILE;
+    }
+
+    calib_file_header_t header;
+    if (calib_read_all(fd, &header, sizeof(header)) != 0) {
+        close(fd);
+        return CALIB_ERROR_FORMAT;
+    }
+
+    if (header.magic != CALIB_FILE_MAGIC || header.version != CALIB_FILE_VERSION ||
+        header.width != width || header.height != height) {
+        close(fd);
+        return CALIB_ERROR_FORMAT;
+    }
+
+    size_t pixel_count = (size_t)width * height;
+    size_t offset_bytes = pixel_count * sizeof(uint16_t);
+    size_t gain_bytes = pixel_count * sizeof(float);
+
+    if (calib_read_all(fd, offset, offset_bytes) != 0 ||
+        calib_read_all(fd, gain, gain_bytes) != 0) {
+        close(fd);
+        return CALIB_ERROR_FORMAT;
+    }
+    close(fd);
+
+    uint16_t crc = crc16_compute((const uint8_t *)offset, offset_bytes);
+    crc = crc16_compute_with_init((const uint8_t *)gain, gain_bytes, crc);
+    if (crc != header.crc) {
+        return CALIB_ERROR_FORMAT;
+    }
+
+    return CALIB_OK;
+}
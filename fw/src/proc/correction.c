@@ -0,0 +1,966 @@
+/**
+ * @file correction.c
+ * @brief Offset/gain correction stage
+ *
+ * Per-pixel (raw - offset) * gain with 16-bit gain maps.
+ *
+ * Kernel variants (selected at create time, see util/cpu_dispatch.h):
+ * - AArch64 NEON: 8 pixels per step, vqrshrn for Q2.14, vcvt_f32_f16 for half
+ * - x86 AVX2 + F16C: 16 pixels per step
+ * - x86 SSE4.2: 8 pixels per step, Q2.14 only
+ * - Scalar for other targets and row tails
+ *
+ * All kernels use the same arithmetic (saturating subtract, round half up,
+ * saturate to uint16), so output is bit-identical across targets and the
+ * scalar kernel serves as the test reference.
+ *
+ * With a count hook set, bands go through counting variants of the same
+ * kernels, called once per tile-wide span of each row: the clamped output
+ * vector is compared against the threshold before it is stored, so the
+ * count costs a compare and a subtract per vector, not a second sweep.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "proc/correction.h"
+#include "util/thread_pool.h"
+#include "util/cpu_dispatch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define CORR_ALIGNMENT 64
+
+/**
+ * @brief Row kernel signature
+ */
+typedef void (*corr_row_fn_t)(uint16_t *px, const uint16_t *offset,
+                              const uint16_t *gain, size_t n);
+
+/**
+ * @brief Counting row kernel: corrects and returns output pixels >= threshold
+ *
+ * n is at most CORR_COUNT_MAX_TILE, which keeps 16-bit lane counters safe.
+ */
+typedef uint32_t (*corr_count_fn_t)(uint16_t *px, const uint16_t *offset,
+                                    const uint16_t *gain, size_t n, uint16_t threshold);
+
+/**
+ * @brief Correction stage internal state
+ */
+struct correction {
+    corr_config_t config;       /**< Configuration */
+    size_t pixel_count;         /**< width * height */
+
+    uint16_t *offset;           /**< Offset map (aligned) */
+    uint16_t *gain;             /**< Gain map in configured format (aligned) */
+    bool offset_loaded;         /**< Offset map valid */
+    bool gain_loaded;           /**< Gain map valid */
+
+    corr_row_fn_t row_fn;       /**< Row kernel for gain format */
+    corr_count_fn_t count_fn;   /**< Counting row kernel for gain format */
+    corr_band_hook_t band_hook; /**< Called after each band in apply_frame */
+    void *band_hook_data;       /**< Hook user data */
+    corr_count_hook_t count_hook;   /**< Gets per-tile counts of each band */
+    void *count_hook_data;      /**< Count hook user data */
+    uint16_t count_threshold;   /**< Counted if output >= threshold */
+    uint32_t count_tile;        /**< Tile edge of the counts */
+    uint32_t count_tiles_x;     /**< Tile columns */
+    uint32_t *count_scratch;    /**< count_tiles_x per pool participant */
+    tp_pool_t *pool;            /**< Spreads apply_frame bands (NULL = serial) */
+    pthread_mutex_t lock;       /**< Serialises map updates against apply */
+
+    corr_stats_t stats;         /**< Statistics */
+};
+
+/* ==========================================================================
+ * Scalar Kernels (reference)
+ * ========================================================================== */
+
+static inline uint16_t corr_sat_sub(uint16_t a, uint16_t b) {
+    return (a > b) ? (uint16_t)(a - b) : 0;
+}
+
+static inline uint16_t corr_q14_px(uint16_t raw, uint16_t offset, uint16_t gain) {
+    uint32_t v = (uint32_t)corr_sat_sub(raw, offset) * gain;
+    v = (v + (1U << (CORR_GAIN_Q_FRAC_BITS - 1))) >> CORR_GAIN_Q_FRAC_BITS;
+    return (v > 0xFFFFU) ? 0xFFFFU : (uint16_t)v;
+}
+
+static inline uint16_t corr_fp16_px(uint16_t raw, uint16_t offset, uint16_t gain) {
+    float v = (float)corr_sat_sub(raw, offset) * correction_fp16_to_float(gain);
+    v = v + 0.5f;
+    if (!(v > 0.0f)) {
+        return 0;                   /* Negative or NaN gain */
+    }
+    if (v >= 65535.0f) {
+        return 0xFFFFU;
+    }
+    return (uint16_t)v;             /* Truncate after +0.5 = round half up */
+}
+
+static void corr_row_q14_scalar(uint16_t *px, const uint16_t *offset,
+                                const uint16_t *gain, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        px[i] = corr_q14_px(px[i], offset[i], gain[i]);
+    }
+}
+
+static void corr_row_fp16_scalar(uint16_t *px, const uint16_t *offset,
+                                 const uint16_t *gain, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        px[i] = corr_fp16_px(px[i], offset[i], gain[i]);
+    }
+}
+
+static uint32_t corr_count_q14_scalar(uint16_t *px, const uint16_t *offset,
+                                      const uint16_t *gain, size_t n, uint16_t threshold) {
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        px[i] = corr_q14_px(px[i], offset[i], gain[i]);
+        count += (px[i] >= threshold);
+    }
+
+    return count;
+}
+
+static uint32_t corr_count_fp16_scalar(uint16_t *px, const uint16_t *offset,
+                                       const uint16_t *gain, size_t n, uint16_t threshold) {
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        px[i] = corr_fp16_px(px[i], offset[i], gain[i]);
+        count += (px[i] >= threshold);
+    }
+
+    return count;
+}
+
+/* ==========================================================================
+ * NEON Kernels (AArch64)
+ * ========================================================================== */
+
+#if defined(CPU_DISPATCH_NEON)
+
+static inline uint16x8_t corr_q14_neon_step(const uint16_t *px, const uint16_t *offset,
+                                            const uint16_t *gain) {
+    uint16x8_t d = vqsubq_u16(vld1q_u16(px), vld1q_u16(offset));
+    uint16x8_t g = vld1q_u16(gain);
+    uint32x4_t lo = vmull_u16(vget_low_u16(d), vget_low_u16(g));
+    uint32x4_t hi = vmull_high_u16(d, g);
+    return vcombine_u16(vqrshrn_n_u32(lo, CORR_GAIN_Q_FRAC_BITS),
+                        vqrshrn_n_u32(hi, CORR_GAIN_Q_FRAC_BITS));
+}
+
+static inline uint16x8_t corr_fp16_neon_step(const uint16_t *px, const uint16_t *offset,
+                                             const uint16_t *gain) {
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t max = vdupq_n_f32(65535.0f);
+
+    uint16x8_t d = vqsubq_u16(vld1q_u16(px), vld1q_u16(offset));
+    uint16x8_t g = vld1q_u16(gain);
+
+    float32x4_t dlo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(d)));
+    float32x4_t dhi = vcvtq_f32_u32(vmovl_high_u16(d));
+    float32x4_t glo = vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(g)));
+    float32x4_t ghi = vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(g)));
+
+    float32x4_t vlo = vminq_f32(vaddq_f32(vmulq_f32(dlo, glo), half), max);
+    float32x4_t vhi = vminq_f32(vaddq_f32(vmulq_f32(dhi, ghi), half), max);
+
+    /* vcvtq_u32_f32 truncates and saturates negatives/NaN to 0 */
+    return vcombine_u16(vmovn_u32(vcvtq_u32_f32(vlo)), vmovn_u32(vcvtq_u32_f32(vhi)));
+}
+
+static void corr_row_q14_neon(uint16_t *px, const uint16_t *offset,
+                              const uint16_t *gain, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        vst1q_u16(px + i, corr_q14_neon_step(px + i, offset + i, gain + i));
+    }
+
+    corr_row_q14_scalar(px + i, offset + i, gain + i, n - i);
+}
+
+static void corr_row_fp16_neon(uint16_t *px, const uint16_t *offset,
+                               const uint16_t *gain, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        vst1q_u16(px + i, corr_fp16_neon_step(px + i, offset + i, gain + i));
+    }
+
+    corr_row_fp16_scalar(px + i, offset + i, gain + i, n - i);
+}
+
+static uint32_t corr_count_q14_neon(uint16_t *px, const uint16_t *offset,
+                                    const uint16_t *gain, size_t n, uint16_t threshold) {
+    uint16x8_t thr = vdupq_n_u16(threshold);
+    uint16x8_t acc = vdupq_n_u16(0);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t out = corr_q14_neon_step(px + i, offset + i, gain + i);
+        vst1q_u16(px + i, out);
+        acc = vsubq_u16(acc, vcgeq_u16(out, thr));  /* Mask lanes are -1 */
+    }
+
+    return vaddlvq_u16(acc) + corr_count_q14_scalar(px + i, offset + i, gain + i, n - i, threshold);
+}
+
+static uint32_t corr_count_fp16_neon(uint16_t *px, const uint16_t *offset,
+                                     const uint16_t *gain, size_t n, uint16_t threshold) {
+    uint16x8_t thr = vdupq_n_u16(threshold);
+    uint16x8_t acc = vdupq_n_u16(0);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t out = corr_fp16_neon_step(px + i, offset + i, gain + i);
+        vst1q_u16(px + i, out);
+        acc = vsubq_u16(acc, vcgeq_u16(out, thr));
+    }
+
+    return vaddlvq_u16(acc) + corr_count_fp16_scalar(px + i, offset + i, gain + i, n - i, threshold);
+}
+
+#endif /* CPU_DISPATCH_NEON */
+
+/* ==========================================================================
+ * x86 Kernels (development and CI hosts)
+ * ========================================================================== */
+
+#if defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static inline __m128i corr_q14_sse42_step(const uint16_t *px, const uint16_t *offset,
+                                          const uint16_t *gain) {
+    const __m128i round = _mm_set1_epi32(1 << (CORR_GAIN_Q_FRAC_BITS - 1));
+
+    __m128i d = _mm_subs_epu16(_mm_loadu_si128((const __m128i *)px),
+                               _mm_loadu_si128((const __m128i *)offset));
+    __m128i g = _mm_loadu_si128((const __m128i *)gain);
+
+    __m128i plo = _mm_mullo_epi16(d, g);
+    __m128i phi = _mm_mulhi_epu16(d, g);
+    __m128i lo = _mm_unpacklo_epi16(plo, phi);
+    __m128i hi = _mm_unpackhi_epi16(plo, phi);
+
+    lo = _mm_srli_epi32(_mm_add_epi32(lo, round), CORR_GAIN_Q_FRAC_BITS);
+    hi = _mm_srli_epi32(_mm_add_epi32(hi, round), CORR_GAIN_Q_FRAC_BITS);
+
+    return _mm_packus_epi32(lo, hi);
+}
+
+CPU_TARGET_AVX2
+static inline __m256i corr_q14_avx2_step(const uint16_t *px, const uint16_t *offset,
+                                         const uint16_t *gain) {
+    const __m256i round = _mm256_set1_epi32(1 << (CORR_GAIN_Q_FRAC_BITS - 1));
+
+    __m256i d = _mm256_subs_epu16(_mm256_loadu_si256((const __m256i *)px),
+                                  _mm256_loadu_si256((const __m256i *)offset));
+    __m256i g = _mm256_loadu_si256((const __m256i *)gain);
+
+    /* 16x16 -> 32-bit products, interleaved per 128-bit lane */
+    __m256i plo = _mm256_mullo_epi16(d, g);
+    __m256i phi = _mm256_mulhi_epu16(d, g);
+    __m256i lo = _mm256_unpacklo_epi16(plo, phi);
+    __m256i hi = _mm256_unpackhi_epi16(plo, phi);
+
+    lo = _mm256_srli_epi32(_mm256_add_epi32(lo, round), CORR_GAIN_Q_FRAC_BITS);
+    hi = _mm256_srli_epi32(_mm256_add_epi32(hi, round), CORR_GAIN_Q_FRAC_BITS);
+
+    /* packus is per-lane too, which restores the original pixel order */
+    return _mm256_packus_epi32(lo, hi);
+}
+
+CPU_TARGET_AVX2_F16C
+static inline __m256i corr_fp16_avx2_step(const uint16_t *px, const uint16_t *offset,
+                                          const uint16_t *gain) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 max = _mm256_set1_ps(65535.0f);
+
+    __m256i d = _mm256_subs_epu16(_mm256_loadu_si256((const __m256i *)px),
+                                  _mm256_loadu_si256((const __m256i *)offset));
+    __m128i glo16 = _mm_loadu_si128((const __m128i *)gain);
+    __m128i ghi16 = _mm_loadu_si128((const __m128i *)(gain + 8));
+
+    __m256 dlo = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(d)));
+    __m256 dhi = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(d, 1)));
+
+    /* min(max, v) propagates NaN, which cvtt turns into a negative value */
+    __m256 vlo = _mm256_min_ps(max, _mm256_add_ps(_mm256_mul_ps(dlo, _mm256_cvtph_ps(glo16)), half));
+    __m256 vhi = _mm256_min_ps(max, _mm256_add_ps(_mm256_mul_ps(dhi, _mm256_cvtph_ps(ghi16)), half));
+
+    __m256i ilo = _mm256_cvttps_epi32(vlo);
+    __m256i ihi = _mm256_cvttps_epi32(vhi);
+
+    /* packus saturates negatives to 0; permute undoes the lane interleave */
+    return _mm256_permute4x64_epi64(_mm256_packus_epi32(ilo, ihi), 0xD8);
+}
+
+/* Lane counts are <= CORR_COUNT_MAX_TILE / 8, safe as signed for madd */
+CPU_TARGET_SSE42
+static inline uint32_t corr_count_sum_sse42(__m128i acc) {
+    __m128i sum = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+CPU_TARGET_AVX2
+static inline uint32_t corr_count_sum_avx2(__m256i acc) {
+    __m256i sum32 = _mm256_madd_epi16(acc, _mm256_set1_epi16(1));
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sum32),
+                                _mm256_extracti128_si256(sum32, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+CPU_TARGET_SSE42
+static void corr_row_q14_sse42(uint16_t *px, const uint16_t *offset,
+                               const uint16_t *gain, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128((__m128i *)(px + i), corr_q14_sse42_step(px + i, offset + i, gain + i));
+    }
+
+    corr_row_q14_scalar(px + i, offset + i, gain + i, n - i);
+}
+
+CPU_TARGET_AVX2
+static void corr_row_q14_avx2(uint16_t *px, const uint16_t *offset,
+                              const uint16_t *gain, size_t n) {
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256((__m256i *)(px + i), corr_q14_avx2_step(px + i, offset + i, gain + i));
+    }
+
+    corr_row_q14_scalar(px + i, offset + i, gain + i, n - i);
+}
+
+CPU_TARGET_AVX2_F16C
+static void corr_row_fp16_avx2(uint16_t *px, const uint16_t *offset,
+                               const uint16_t *gain, size_t n) {
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256((__m256i *)(px + i), corr_fp16_avx2_step(px + i, offset + i, gain + i));
+    }
+
+    corr_row_fp16_scalar(px + i, offset + i, gain + i, n - i);
+}
+
+CPU_TARGET_SSE42
+static uint32_t corr_count_q14_sse42(uint16_t *px, const uint16_t *offset,
+                                     const uint16_t *gain, size_t n, uint16_t threshold) {
+    __m128i thr = _mm_set1_epi16((short)threshold);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i out = corr_q14_sse42_step(px + i, offset + i, gain + i);
+        _mm_storeu_si128((__m128i *)(px + i), out);
+        acc = _mm_sub_epi16(acc, _mm_cmpeq_epi16(_mm_max_epu16(out, thr), out));
+    }
+
+    uint32_t count = corr_count_q14_scalar(px + i, offset + i, gain + i, n - i, threshold);
+    return _mm_testz_si128(acc, acc) ? count : count + corr_count_sum_sse42(acc);
+}
+
+CPU_TARGET_AVX2
+static uint32_t corr_count_q14_avx2(uint16_t *px, const uint16_t *offset,
+                                    const uint16_t *gain, size_t n, uint16_t threshold) {
+    __m256i thr = _mm256_set1_epi16((short)threshold);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i out = corr_q14_avx2_step(px + i, offset + i, gain + i);
+        _mm256_storeu_si256((__m256i *)(px + i), out);
+        /* Unsigned out >= thr  <=>  max(out, thr) == out; mask lanes are -1 */
+        acc = _mm256_sub_epi16(acc, _mm256_cmpeq_epi16(_mm256_max_epu16(out, thr), out));
+    }
+
+    /* Saturation is rare: skip the horizontal reduction for clean spans */
+    uint32_t count = corr_count_q14_scalar(px + i, offset + i, gain + i, n - i, threshold);
+    return _mm256_testz_si256(acc, acc) ? count : count + corr_count_sum_avx2(acc);
+}
+
+CPU_TARGET_AVX2_F16C
+static uint32_t corr_count_fp16_avx2(uint16_t *px, const uint16_t *offset,
+                                     const uint16_t *gain, size_t n, uint16_t threshold) {
+    __m256i thr = _mm256_set1_epi16((short)threshold);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i out = corr_fp16_avx2_step(px + i, offset + i, gain + i);
+        _mm256_storeu_si256((__m256i *)(px + i), out);
+        acc = _mm256_sub_epi16(acc, _mm256_cmpeq_epi16(_mm256_max_epu16(out, thr), out));
+    }
+
+    uint32_t count = corr_count_fp16_scalar(px + i, offset + i, gain + i, n - i, threshold);
+    return _mm256_testz_si256(acc, acc) ? count : count + corr_count_sum_avx2(acc);
+}
+
+#endif /* CPU_DISPATCH_X86 */
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define CORR_CHECK_PIXELS   1031    /* Odd length exercises the row tail */
+
+/**
+ * @brief Run candidate and reference on the same random row
+ *
+ * @param fp16 Random half-float bit patterns (incl. NaN/Inf) instead of Q2.14
+ */
+static bool corr_check(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed, bool fp16,
+                       bool count) {
+    uint16_t px_a[CORR_CHECK_PIXELS], px_b[CORR_CHECK_PIXELS];
+    uint16_t offset[CORR_CHECK_PIXELS], gain[CORR_CHECK_PIXELS];
+    size_t n = CORR_CHECK_PIXELS - (seed % 16);
+
+    for (size_t i = 0; i < n; i++) {
+        px_a[i] = px_b[i] = (uint16_t)cpu_dispatch_random(&seed);
+        offset[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 20);
+        gain[i] = (uint16_t)cpu_dispatch_random(&seed);
+        if (!fp16 && (i & 1)) {
+            gain[i] = (uint16_t)(CORR_GAIN_Q_ONE + (gain[i] >> 6) - 512);
+        }
+    }
+
+    if (!count) {
+        ((corr_row_fn_t)candidate)(px_a, offset, gain, n);
+        ((corr_row_fn_t)reference)(px_b, offset, gain, n);
+        return memcmp(px_a, px_b, n * sizeof(uint16_t)) == 0;
+    }
+
+    uint16_t threshold = (uint16_t)cpu_dispatch_random(&seed);
+    uint32_t count_a = ((corr_count_fn_t)candidate)(px_a, offset, gain, n, threshold);
+    uint32_t count_b = ((corr_count_fn_t)reference)(px_b, offset, gain, n, threshold);
+    return count_a == count_b && memcmp(px_a, px_b, n * sizeof(uint16_t)) == 0;
+}
+
+static bool corr_check_q14(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    return corr_check(candidate, reference, seed, false, false);
+}
+
+static bool corr_check_fp16(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    return corr_check(candidate, reference, seed, true, false);
+}
+
+static bool corr_check_q14_count(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    return corr_check(candidate, reference, seed, false, true);
+}
+
+static bool corr_check_fp16_count(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    return corr_check(candidate, reference, seed, true, true);
+}
+
+static const cpu_variant_t corr_q14_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)corr_row_q14_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)corr_row_q14_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)corr_row_q14_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)corr_row_q14_avx2 },
+#endif
+};
+
+static const cpu_variant_t corr_fp16_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)corr_row_fp16_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)corr_row_fp16_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_AVX2, (cpu_fn_t)corr_row_fp16_avx2 },
+#endif
+};
+
+const cpu_kernel_t correction_kernel_q14 = {
+    .name = "correction.q14",
+    .variants = corr_q14_variants,
+    .variant_count = sizeof(corr_q14_variants) / sizeof(corr_q14_variants[0]),
+    .check = corr_check_q14
+};
+
+const cpu_kernel_t correction_kernel_fp16 = {
+    .name = "correction.fp16",
+    .variants = corr_fp16_variants,
+    .variant_count = sizeof(corr_fp16_variants) / sizeof(corr_fp16_variants[0]),
+    .check = corr_check_fp16
+};
+
+static const cpu_variant_t corr_q14_count_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)corr_count_q14_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)corr_count_q14_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)corr_count_q14_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)corr_count_q14_avx2 },
+#endif
+};
+
+static const cpu_variant_t corr_fp16_count_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)corr_count_fp16_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)corr_count_fp16_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_AVX2, (cpu_fn_t)corr_count_fp16_avx2 },
+#endif
+};
+
+const cpu_kernel_t correction_kernel_q14_count = {
+    .name = "correction.q14_count",
+    .variants = corr_q14_count_variants,
+    .variant_count = sizeof(corr_q14_count_variants) / sizeof(corr_q14_count_variants[0]),
+    .check = corr_check_q14_count
+};
+
+const cpu_kernel_t correction_kernel_fp16_count = {
+    .name = "correction.fp16_count",
+    .variants = corr_fp16_count_variants,
+    .variant_count = sizeof(corr_fp16_count_variants) / sizeof(corr_fp16_count_variants[0]),
+    .check = corr_check_fp16_count
+};
+
+static uint64_t corr_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+correction_t *correction_create(const corr_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0) {
+        return NULL;
+    }
+
+    if (config->gain_format != CORR_GAIN_Q2_14 && config->gain_format != CORR_GAIN_FP16) {
+        return NULL;
+    }
+
+    correction_t *corr = (correction_t *)calloc(1, sizeof(correction_t));
+    if (corr == NULL) {
+        return NULL;
+    }
+
+    corr->config = *config;
+    if (corr->config.band_rows == 0 || corr->config.band_rows > config->height) {
+        corr->config.band_rows = (config->height < CORR_DEFAULT_BAND_ROWS) ?
+                                 config->height : CORR_DEFAULT_BAND_ROWS;
+    }
+    corr->pixel_count = (size_t)config->width * config->height;
+
+    /* aligned_alloc requires size to be a multiple of the alignment */
+    size_t map_bytes = corr->pixel_count * sizeof(uint16_t);
+    map_bytes = (map_bytes + CORR_ALIGNMENT - 1) & ~(size_t)(CORR_ALIGNMENT - 1);
+
+    corr->offset = (uint16_t *)aligned_alloc(CORR_ALIGNMENT, map_bytes);
+    corr->gain = (uint16_t *)aligned_alloc(CORR_ALIGNMENT, map_bytes);
+    if (corr->offset == NULL || corr->gain == NULL) {
+        free(corr->offset);
+        free(corr->gain);
+        free(corr);
+        return NULL;
+    }
+
+    bool fp16 = (config->gain_format == CORR_GAIN_FP16);
+    corr->row_fn = (corr_row_fn_t)cpu_dispatch_select(
+        fp16 ? &correction_kernel_fp16 : &correction_kernel_q14, NULL);
+    corr->count_fn = (corr_count_fn_t)cpu_dispatch_select(
+        fp16 ? &correction_kernel_fp16_count : &correction_kernel_q14_count, NULL);
+    pthread_mutex_init(&corr->lock, NULL);
+
+    return corr;
+}
+
+void correction_destroy(correction_t *corr) {
+    if (corr == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&corr->lock);
+    free(corr->count_scratch);
+    free(corr->offset);
+    free(corr->gain);
+    free(corr);
+}
+
+corr_status_t correction_set_offset_map(correction_t *corr, const uint16_t *offset, size_t count) {
+    if (corr == NULL || offset == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    if (count != corr->pixel_count) {
+        return CORR_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    memcpy(corr->offset, offset, count * sizeof(uint16_t));
+    corr->offset_loaded = true;
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+corr_status_t correction_set_gain_map(correction_t *corr, const float *gain, size_t count) {
+    if (corr == NULL || gain == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    if (count != corr->pixel_count) {
+        return CORR_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    if (corr->config.gain_format == CORR_GAIN_FP16) {
+        for (size_t i = 0; i < count; i++) {
+            corr->gain[i] = (gain[i] > 0.0f) ? correction_float_to_fp16(gain[i]) : 0;
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            corr->gain[i] = correction_gain_to_q14(gain[i]);
+        }
+    }
+    corr->gain_loaded = true;
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+corr_status_t correction_set_gain_map_raw(correction_t *corr, const uint16_t *gain, size_t count) {
+    if (corr == NULL || gain == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    if (count != corr->pixel_count) {
+        return CORR_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    memcpy(corr->gain, gain, count * sizeof(uint16_t));
+    corr->gain_loaded = true;
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+bool correction_is_ready(const correction_t *corr) {
+    return corr != NULL && corr->offset_loaded && corr->gain_loaded;
+}
+
+/**
+ * @brief Apply counting kernel to a band and report its tile counts (lock held)
+ *
+ * Counts are gathered in the participant's scratch row and handed to the
+ * count hook once for each tile row the band touches.
+ */
+static void corr_count_band_locked(correction_t *corr, uint16_t *frame, uint32_t row_start,
+                                   uint32_t row_count, uint32_t worker) {
+    uint32_t width = corr->config.width;
+    uint32_t tile = corr->count_tile;
+    uint32_t tiles_x = corr->count_tiles_x;
+    uint32_t *counts = corr->count_scratch + (size_t)worker * tiles_x;
+    uint32_t end = row_start + row_count;
+
+    for (uint32_t y = row_start; y < end;) {
+        uint32_t first = y;
+        uint32_t last = (y / tile + 1) * tile;
+        last = (last < end) ? last : end;
+
+        memset(counts, 0, tiles_x * sizeof(uint32_t));
+        for (; y < last; y++) {
+            size_t base = (size_t)y * width;
+            for (uint32_t tx = 0, x = 0; tx < tiles_x; tx++, x += tile) {
+                uint32_t n = (width - x < tile) ? width - x : tile;
+                counts[tx] += corr->count_fn(frame + base + x, corr->offset + base + x,
+                                             corr->gain + base + x, n, corr->count_threshold);
+            }
+        }
+
+        corr->count_hook(first, last - first, counts, corr->count_hook_data);
+    }
+}
+
+/**
+ * @brief Apply row kernel to a band (lock held)
+ *
+ * @param worker Pool participant running the band (0 = caller)
+ */
+static void corr_apply_band_locked(correction_t *corr, uint16_t *frame,
+                                   uint32_t row_start, uint32_t row_count, uint32_t worker) {
+    if (corr->count_hook != NULL) {
+        corr_count_band_locked(corr, frame, row_start, row_count, worker);
+        return;
+    }
+
+    size_t first = (size_t)row_start * corr->config.width;
+    size_t n = (size_t)row_count * corr->config.width;
+
+    /* Rows of a band are contiguous, so one kernel call covers the band */
+    corr->row_fn(frame + first, corr->offset + first, corr->gain + first, n);
+}
+
+/**
+ * @brief One frame handed to the pool, one task per band
+ */
+typedef struct {
+    correction_t *corr;
+    uint16_t *frame;
+} corr_job_t;
+
+static void corr_band_task(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+    corr_job_t *job = (corr_job_t *)user_data;
+    correction_t *corr = job->corr;
+    uint32_t band = corr->config.band_rows;
+
+    for (uint32_t b = begin; b < end; b++) {
+        uint32_t row = b * band;
+        uint32_t rows = (corr->config.height - row < band) ? corr->config.height - row : band;
+        corr_apply_band_locked(corr, job->frame, row, rows, worker);
+        if (corr->band_hook != NULL) {
+            corr->band_hook(job->frame, row, rows, corr->band_hook_data);
+        }
+    }
+}
+
+corr_status_t correction_apply_rows(correction_t *corr, uint16_t *frame,
+                                    uint32_t row_start, uint32_t row_count) {
+    if (corr == NULL || frame == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    if (row_start >= corr->config.height || row_count > corr->config.height - row_start) {
+        return CORR_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    if (!corr->offset_loaded || !corr->gain_loaded) {
+        pthread_mutex_unlock(&corr->lock);
+        return CORR_ERROR_NOT_READY;
+    }
+
+    corr_apply_band_locked(corr, frame, row_start, row_count, 0);
+    corr->stats.bands_corrected++;
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+corr_status_t correction_apply_frame(correction_t *corr, uint16_t *frame) {
+    if (corr == NULL || frame == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    if (!corr->offset_loaded || !corr->gain_loaded) {
+        pthread_mutex_unlock(&corr->lock);
+        return CORR_ERROR_NOT_READY;
+    }
+
+    uint64_t start_us = corr_now_us();
+
+    uint32_t band = corr->config.band_rows;
+    uint32_t bands = (corr->config.height + band - 1) / band;
+    corr_job_t job = { .corr = corr, .frame = frame };
+
+    /* The lock stays with this thread; workers only run under it */
+    if (corr->pool != NULL) {
+        thread_pool_parallel_for(corr->pool, bands, 1, corr_band_task, &job);
+    } else {
+        corr_band_task(0, bands, 0, &job);
+    }
+
+    uint32_t elapsed_us = (uint32_t)(corr_now_us() - start_us);
+    corr->stats.frames_corrected++;
+    corr->stats.bands_corrected += bands;
+    corr->stats.last_frame_us = elapsed_us;
+    if (elapsed_us > corr->stats.max_frame_us) {
+        corr->stats.max_frame_us = elapsed_us;
+    }
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+void correction_set_band_hook(correction_t *corr, corr_band_hook_t hook, void *user_data) {
+    if (corr == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    corr->band_hook = hook;
+    corr->band_hook_data = user_data;
+    pthread_mutex_unlock(&corr->lock);
+}
+
+corr_status_t correction_set_count_hook(correction_t *corr, uint16_t threshold, uint32_t tile_size,
+                                       corr_count_hook_t hook, void *user_data) {
+    if (corr == NULL) {
+        return CORR_ERROR_NULL;
+    }
+
+    if (hook != NULL && (tile_size == 0 || tile_size > CORR_COUNT_MAX_TILE)) {
+        return CORR_ERROR_PARAM;
+    }
+
+    uint32_t *scratch = NULL;
+    uint32_t tiles_x = 0;
+    if (hook != NULL) {
+        /* One scratch row per possible pool participant */
+        tiles_x = (corr->config.width + tile_size - 1) / tile_size;
+        scratch = (uint32_t *)calloc((size_t)TP_MAX_THREADS * tiles_x, sizeof(uint32_t));
+        if (scratch == NULL) {
+            return CORR_ERROR_MEMORY;
+        }
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    free(corr->count_scratch);
+    corr->count_scratch = scratch;
+    corr->count_hook = hook;
+    corr->count_hook_data = user_data;
+    corr->count_threshold = threshold;
+    corr->count_tile = tile_size;
+    corr->count_tiles_x = tiles_x;
+    pthread_mutex_unlock(&corr->lock);
+
+    return CORR_OK;
+}
+
+void correction_set_thread_pool(correction_t *corr, tp_pool_t *pool) {
+    if (corr == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&corr->lock);
+    corr->pool = pool;
+    pthread_mutex_unlock(&corr->lock);
+}
+
+void correction_get_stats(const correction_t *corr, corr_stats_t *stats) {
+    if (corr == NULL || stats == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock((pthread_mutex_t *)&corr->lock);
+    *stats = corr->stats;
+    pthread_mutex_unlock((pthread_mutex_t *)&corr->lock);
+}
+
+const char *correction_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&correction_kernel_q14, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
+
+/* ==========================================================================
+ * Gain Format Conversion
+ * ========================================================================== */
+
+uint16_t correction_gain_to_q14(float gain) {
+    if (!(gain > 0.0f)) {
+        return 0;
+    }
+
+    float scaled = gain * (float)CORR_GAIN_Q_ONE + 0.5f;
+    if (scaled >= 65535.0f) {
+        return 0xFFFFU;
+    }
+
+    return (uint16_t)scaled;
+}
+
+uint16_t correction_float_to_fp16(float value) {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+
+    uint16_t sign = (uint16_t)((x >> 16) & 0x8000U);
+    uint32_t exp = (x >> 23) & 0xFFU;
+    uint32_t mant = x & 0x7FFFFFU;
+
+    if (exp == 0xFFU) {
+        /* Inf or NaN (quiet) */
+        return (uint16_t)(sign | 0x7C00U | (mant != 0 ? 0x0200U : 0));
+    }
+
+    int32_t e = (int32_t)exp - 127 + 15;
+    if (e >= 31) {
+        return (uint16_t)(sign | 0x7C00U);     /* Overflow to Inf */
+    }
+
+    uint32_t half;
+    uint32_t rem;
+    uint32_t mid;
+
+    if (e <= 0) {
+        /* Subnormal half */
+        if (e < -10) {
+            return sign;
+        }
+        mant |= 0x800000U;
+        uint32_t shift = (uint32_t)(14 - e);
+        half = mant >> shift;
+        rem = mant & ((1U << shift) - 1U);
+        mid = 1U << (shift - 1U);
+    } else {
+        half = ((uint32_t)e << 10) | (mant >> 13);
+        rem = mant & 0x1FFFU;
+        mid = 0x1000U;
+    }
+
+    /* Round to nearest even; a carry into the exponent is still correct */
+    if (rem > mid || (rem == mid && (half & 1U))) {
+        half++;
+    }
+
+    return (uint16_t)(sign | half);
+}
+
+float correction_fp16_to_float(uint16_t half) {
+    uint32_t sign = ((uint32_t)half & 0x8000U) << 16;
+    uint32_t exp = ((uint32_t)half >> 10) & 0x1FU;
+    uint32_t mant = (uint32_t)half & 0x3FFU;
+    uint32_t bits;
+
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {
+            /* Normalise subnormal */
+            uint32_t e = 113;
+            while ((mant & 0x400U) == 0) {
+                mant <<= 1;
+                e--;
+            }
+            bits = sign | (e << 23) | ((mant & 0x3FFU) << 13);
+        }
+    } else if (exp == 0x1FU) {
+        bits = sign | 0x7F800000U | (mant << 13);
+    } else {
+        bits = sign | ((exp + 112U) << 23) | (mant << 13);
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,410 @@
+/**
+ * @file defect_map.c
+ * @brief Defect pixel correction with a sparse row-indexed defect list
+ *
+ * Compile step (defect_map_commit, off the frame path):
+ * 1. Rasterise staged records into a per-pixel kind mask
+ * 2. For each defective pixel find the nearest good neighbours
+ * 3. Counting-sort entries by the last row they read or write
+ *
+ * Apply step (per band): average precomputed neighbours for the run of
+ * entries whose last row falls in the band.
+ */
+
+#include "proc/defect_map.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* Per-pixel defect kind bits used while compiling */
+#define DEFECT_KIND_POINT   (1U << 0)   /* Pixel or cluster: interpolate both axes */
+#define DEFECT_KIND_ROW     (1U << 1)   /* Row line: interpolate vertically */
+#define DEFECT_KIND_COLUMN  (1U << 2)   /* Column line: interpolate horizontally */
+
+/**
+ * @brief Compiled defect entry
+ */
+typedef struct {
+    uint32_t pos;               /**< Pixel index (y * width + x) */
+    uint32_t nbr[4];            /**< Good neighbour pixel indices */
+    uint32_t count;             /**< Valid neighbours (0 = leave as is) */
+} defect_entry_t;
+
+/**
+ * @brief Compiled defect index
+ */
+typedef struct {
+    defect_entry_t *entries;    /**< Entries sorted by last touched row */
+    size_t count;               /**< Number of entries */
+    uint32_t *row_start;        /**< height + 1 offsets into entries */
+} defect_index_t;
+
+/**
+ * @brief Defect map internal state
+ */
+struct defect_map {
+    defect_config_t config;     /**< Geometry and capacity */
+
+    defect_record_t *records;   /**< Staged records */
+    uint32_t record_count;      /**< Staged record count */
+
+    defect_index_t *active;     /**< Active compiled index (NULL = none) */
+    pthread_mutex_t lock;       /**< Guards active against commit */
+};
+
+static void defect_index_free(defect_index_t *idx) {
+    if (idx == NULL) {
+        return;
+    }
+
+    free(idx->entries);
+    free(idx->row_start);
+    free(idx);
+}
+
+/* ==========================================================================
+ * Index Compilation
+ * ========================================================================== */
+
+/**
+ * @brief Rasterise staged records into kind mask
+ */
+static void defect_rasterise(const defect_map_t *dm, uint8_t *kind) {
+    uint32_t width = dm->config.width;
+    uint32_t height = dm->config.height;
+
+    for (uint32_t i = 0; i < dm->record_count; i++) {
+        const defect_record_t *r = &dm->records[i];
+
+        switch (r->type) {
+            case DEFECT_TYPE_PIXEL:
+                kind[(size_t)r->y * width + r->x] |= DEFECT_KIND_POINT;
+                break;
+
+            case DEFECT_TYPE_ROW:
+                for (uint32_t x = 0; x < width; x++) {
+                    kind[(size_t)r->y * width + x] |= DEFECT_KIND_ROW;
+                }
+                break;
+
+            case DEFECT_TYPE_COLUMN:
+                for (uint32_t y = 0; y < height; y++) {
+                    kind[(size_t)y * width + r->x] |= DEFECT_KIND_COLUMN;
+                }
+                break;
+
+            case DEFECT_TYPE_CLUSTER:
+                for (uint32_t y = r->y; y < (uint32_t)r->y + r->h; y++) {
+                    for (uint32_t x = r->x; x < (uint32_t)r->x + r->w; x++) {
+                        kind[(size_t)y * width + x] |= DEFECT_KIND_POINT;
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Find nearest good neighbours of defective pixel (x, y)
+ *
+ * @return Last row touched by the entry (own row or a neighbour row)
+ */
+static uint32_t defect_find_neighbours(const defect_map_t *dm, const uint8_t *kind,
+                                       uint32_t x, uint32_t y, defect_entry_t *e) {
+    uint32_t width = dm->config.width;
+    uint32_t height = dm->config.height;
+    uint8_t k = kind[e->pos];
+    uint32_t last_row = y;
+
+    e->count = 0;
+
+    if (k & (DEFECT_KIND_POINT | DEFECT_KIND_COLUMN)) {
+        for (uint32_t d = 1; d <= DEFECT_MAX_SEARCH && d <= x; d++) {
+            if (kind[e->pos - d] == 0) {
+                e->nbr[e->count++] = e->pos - d;
+                break;
+            }
+        }
+        for (uint32_t d = 1; d <= DEFECT_MAX_SEARCH && x + d < width; d++) {
+            if (kind[e->pos + d] == 0) {
+                e->nbr[e->count++] = e->pos + d;
+                break;
+            }
+        }
+    }
+
+    if (k & (DEFECT_KIND_POINT | DEFECT_KIND_ROW)) {
+        for (uint32_t d = 1; d <= DEFECT_MAX_SEARCH && d <= y; d++) {
+            size_t p = e->pos - (size_t)d * width;
+            if (kind[p] == 0) {
+                e->nbr[e->count++] = (uint32_t)p;
+                break;
+            }
+        }
+        for (uint32_t d = 1; d <= DEFECT_MAX_SEARCH && y + d < height; d++) {
+            size_t p = e->pos + (size_t)d * width;
+            if (kind[p] == 0) {
+                e->nbr[e->count++] = (uint32_t)p;
+                last_row = y + d;
+                break;
+            }
+        }
+    }
+
+    return last_row;
+}
+
+/**
+ * @brief Compile staged records into a new index
+ */
+static defect_index_t *defect_compile(const defect_map_t *dm) {
+    uint32_t width = dm->config.width;
+    uint32_t height = dm->config.height;
+    size_t pixels = (size_t)width * height;
+
+    defect_index_t *idx = (defect_index_t *)calloc(1, sizeof(defect_index_t));
+    uint8_t *kind = (uint8_t *)calloc(pixels, 1);
+    if (idx == NULL || kind == NULL) {
+        free(idx);
+        free(kind);
+        return NULL;
+    }
+
+    idx->row_start = (uint32_t *)calloc((size_t)height + 1, sizeof(uint32_t));
+    if (idx->row_start == NULL) {
+        free(kind);
+        defect_index_free(idx);
+        return NULL;
+    }
+
+    defect_rasterise(dm, kind);
+
+    size_t count = 0;
+    for (size_t i = 0; i < pixels; i++) {
+        count += (kind[i] != 0);
+    }
+
+    defect_entry_t *raster = NULL;
+    uint32_t *last_row = NULL;
+    if (count > 0) {
+        raster = (defect_entry_t *)malloc(count * sizeof(defect_entry_t));
+        last_row = (uint32_t *)malloc(count * sizeof(uint32_t));
+        idx->entries = (defect_entry_t *)malloc(count * sizeof(defect_entry_t));
+        if (raster == NULL || last_row == NULL || idx->entries == NULL) {
+            free(raster);
+            free(last_row);
+            free(kind);
+            defect_index_free(idx);
+            return NULL;
+        }
+    }
+
+    /* Entries in raster order, histogram of last touched row */
+    size_t n = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            size_t pos = (size_t)y * width + x;
+            if (kind[pos] == 0) {
+                continue;
+            }
+            raster[n].pos = (uint32_t)pos;
+            last_row[n] = defect_find_neighbours(dm, kind, x, y, &raster[n]);
+            idx->row_start[last_row[n] + 1]++;
+            n++;
+        }
+    }
+
+    /* Counting sort by last row; stable, so raster order within a row */
+    for (uint32_t r = 0; r < height; r++) {
+        idx->row_start[r + 1] += idx->row_start[r];
+    }
+
+    uint32_t *fill = (uint32_t *)malloc((size_t)height * sizeof(uint32_t));
+    if (fill == NULL) {
+        free(raster);
+        free(last_row);
+        free(kind);
+        defect_index_free(idx);
+        return NULL;
+    }
+    memcpy(fill, idx->row_start, (size_t)height * sizeof(uint32_t));
+    for (size_t i = 0; i < count; i++) {
+        idx->entries[fill[last_row[i]]++] = raster[i];
+    }
+    idx->count = count;
+
+    free(fill);
+    free(raster);
+    free(last_row);
+    free(kind);
+
+    return idx;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+defect_map_t *defect_map_create(const defect_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0 ||
+        config->width > 0xFFFF || config->height > 0xFFFF) {
+        return NULL;
+    }
+
+    defect_map_t *dm = (defect_map_t *)calloc(1, sizeof(defect_map_t));
+    if (dm == NULL) {
+        return NULL;
+    }
+
+    dm->config = *config;
+    if (dm->config.max_records == 0) {
+        dm->config.max_records = DEFECT_DEFAULT_MAX_RECORDS;
+    }
+
+    dm->records = (defect_record_t *)calloc(dm->config.max_records, sizeof(defect_record_t));
+    if (dm->records == NULL) {
+        free(dm);
+        return NULL;
+    }
+
+    pthread_mutex_init(&dm->lock, NULL);
+
+    return dm;
+}
+
+void defect_map_destroy(defect_map_t *dm) {
+    if (dm == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&dm->lock);
+    defect_index_free(dm->active);
+    free(dm->records);
+    free(dm);
+}
+
+void defect_map_clear(defect_map_t *dm) {
+    if (dm == NULL) {
+        return;
+    }
+
+    dm->record_count = 0;
+}
+
+defect_status_t defect_map_add(defect_map_t *dm, const defect_record_t *record) {
+    if (dm == NULL || record == NULL) {
+        return DEFECT_ERROR_NULL;
+    }
+
+    uint32_t width = dm->config.width;
+    uint32_t height = dm->config.height;
+    bool valid;
+
+    switch (record->type) {
+        case DEFECT_TYPE_PIXEL:
+            valid = record->x < width && record->y < height;
+            break;
+        case DEFECT_TYPE_ROW:
+            valid = record->y < height;
+            break;
+        case DEFECT_TYPE_COLUMN:
+            valid = record->x < width;
+            break;
+        case DEFECT_TYPE_CLUSTER:
+            valid = record->w > 0 && record->h > 0 &&
+                    (uint32_t)record->x + record->w <= width &&
+                    (uint32_t)record->y + record->h <= height;
+            break;
+        default:
+            valid = false;
+            break;
+    }
+
+    if (!valid) {
+        return DEFECT_ERROR_PARAM;
+    }
+
+    if (dm->record_count >= dm->config.max_records) {
+        return DEFECT_ERROR_FULL;
+    }
+
+    dm->records[dm->record_count++] = *record;
+    return DEFECT_OK;
+}
+
+defect_status_t defect_map_commit(defect_map_t *dm) {
+    if (dm == NULL) {
+        return DEFECT_ERROR_NULL;
+    }
+
+    defect_index_t *idx = defect_compile(dm);
+    if (idx == NULL) {
+        return DEFECT_ERROR_MEMORY;
+    }
+
+    pthread_mutex_lock(&dm->lock);
+    defect_index_t *old = dm->active;
+    dm->active = idx;
+    pthread_mutex_unlock(&dm->lock);
+
+    defect_index_free(old);
+    return DEFECT_OK;
+}
+
+size_t defect_map_count(const defect_map_t *dm) {
+    if (dm == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock((pthread_mutex_t *)&dm->lock);
+    size_t count = (dm->active != NULL) ? dm->active->count : 0;
+    pthread_mutex_unlock((pthread_mutex_t *)&dm->lock);
+
+    return count;
+}
+
+defect_status_t defect_map_apply_rows(defect_map_t *dm, uint16_t *frame,
+                                      uint32_t row_start, uint32_t row_count) {
+    if (dm == NULL || frame == NULL) {
+        return DEFECT_ERROR_NULL;
+    }
+
+    if (row_start >= dm->config.height || row_count > dm->config.height - row_start) {
+        return DEFECT_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&dm->lock);
+
+    const defect_index_t *idx = dm->active;
+    if (idx != NULL) {
+        uint32_t first = idx->row_start[row_start];
+        uint32_t last = idx->row_start[row_start + row_count];
+
+        for (uint32_t i = first; i < last; i++) {
+            const defect_entry_t *e = &idx->entries[i];
+            uint32_t sum = 0;
+
+            for (uint32_t k = 0; k < e->count; k++) {
+                sum += frame[e->nbr[k]];
+            }
+            if (e->count > 0) {
+                frame[e->pos] = (uint16_t)((sum + e->count / 2) / e->count);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&dm->lock);
+
+    return DEFECT_OK;
+}
+
+defect_status_t defect_map_apply_frame(defect_map_t *dm, uint16_t *frame) {
+    if (dm == NULL) {
+        return DEFECT_ERROR_NULL;
+    }
+
+    return defect_map_apply_rows(dm, frame, 0, dm->config.height);
+}
@@ -0,0 +1,370 @@
+/**
+ * @file descramble.c
+ * @brief Panel readout descrambling
+ *
+ * Plan compilation:
+ * - Raw block b (block_cols pixels) moves to image block block_order[b],
+ *   reversed if bit b of mirrored_blocks is set.
+ * - Bottom-side lines with bottom_mirrored additionally mirror the whole
+ *   line: a move to [dst, dst + len) becomes a move to
+ *   [width - dst - len, width - dst) with the direction flipped.
+ * - Moves adjacent in both raw and image order are merged (forward moves
+ *   that continue each other, reversed moves that precede each other).
+ *
+ * Block-reverse kernel variants (selected at create time):
+ * - AArch64 NEON: 8 pixels per step (vrev64q + half swap)
+ * - x86 AVX2: 16 pixels per step (vpshufb + lane swap)
+ * - x86 SSE4.2: 8 pixels per step (pshufb)
+ * - Scalar for other targets and block tails
+ */
+
+#include "proc/descramble.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define DESC_LINE_TOP       0
+#define DESC_LINE_BOTTOM    1
+#define DESC_LINE_CLASSES   2
+
+/**
+ * @brief One block move within a line (pixel offsets)
+ */
+typedef struct {
+    uint32_t src;
+    uint32_t dst;
+    uint32_t len;
+    bool reverse;
+} desc_op_t;
+
+struct descramble {
+    desc_config_t config;
+    desc_op_t ops[DESC_LINE_CLASSES][DESCRAMBLE_MAX_BLOCKS];
+    uint32_t op_count[DESC_LINE_CLASSES];
+    bool whole_line[DESC_LINE_CLASSES];     /* Single forward full-width move */
+    uint32_t *row_map;                      /* Raw line -> image row */
+    desc_reverse_fn_t reverse_fn;
+};
+
+/* ==========================================================================
+ * Block-Reverse Kernels: dst[i] = src[n - 1 - i]
+ * ========================================================================== */
+
+static void desc_reverse_scalar(uint16_t *dst, const uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = src[n - 1 - i];
+    }
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static void desc_reverse_neon(uint16_t *dst, const uint16_t *src, size_t n) {
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vrev64q_u16(vld1q_u16(src + n - 8 - i));
+        vst1q_u16(dst + i, vcombine_u16(vget_high_u16(v), vget_low_u16(v)));
+    }
+
+    desc_reverse_scalar(dst + i, src, n - i);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static void desc_reverse_sse42(uint16_t *dst, const uint16_t *src, size_t n) {
+    const __m128i rev = _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + n - 8 - i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(v, rev));
+    }
+
+    desc_reverse_scalar(dst + i, src, n - i);
+}
+
+CPU_TARGET_AVX2
+static void desc_reverse_avx2(uint16_t *dst, const uint16_t *src, size_t n) {
+    const __m256i rev = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                         14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + n - 16 - i));
+        /* pshufb reverses within each 128-bit lane, then swap the lanes */
+        v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, rev), 0x4E);
+        _mm256_storeu_si256((__m256i *)(dst + i), v);
+    }
+
+    desc_reverse_scalar(dst + i, src, n - i);
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define DESC_CHECK_PIXELS 1031      /* Odd length exercises the block tail */
+
+static bool desc_check_reverse(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t src[DESC_CHECK_PIXELS];
+    uint16_t dst_a[DESC_CHECK_PIXELS], dst_b[DESC_CHECK_PIXELS];
+    size_t n = DESC_CHECK_PIXELS - (seed % 64);
+
+    for (size_t i = 0; i < n; i++) {
+        src[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+
+    ((desc_reverse_fn_t)candidate)(dst_a, src, n);
+    ((desc_reverse_fn_t)reference)(dst_b, src, n);
+
+    return memcmp(dst_a, dst_b, n * sizeof(uint16_t)) == 0;
+}
+
+static const cpu_variant_t desc_reverse_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)desc_reverse_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)desc_reverse_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)desc_reverse_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)desc_reverse_avx2 },
+#endif
+};
+
+const cpu_kernel_t descramble_kernel_reverse = {
+    .name = "descramble.reverse",
+    .variants = desc_reverse_variants,
+    .variant_count = sizeof(desc_reverse_variants) / sizeof(desc_reverse_variants[0]),
+    .check = desc_check_reverse
+};
+
+/* ==========================================================================
+ * Plan Compilation
+ * ========================================================================== */
+
+static bool desc_config_valid(const desc_config_t *c) {
+    if (c->width == 0 || c->height == 0) {
+        return false;
+    }
+
+    uint32_t block_cols = (c->block_cols != 0) ? c->block_cols : c->width;
+    if (c->width % block_cols != 0 || c->width / block_cols > DESCRAMBLE_MAX_BLOCKS) {
+        return false;
+    }
+
+    uint32_t blocks = c->width / block_cols;
+    if (c->block_count != 0) {
+        uint32_t seen = 0;
+        if (c->block_count != blocks) {
+            return false;
+        }
+        for (uint32_t b = 0; b < blocks; b++) {
+            if (c->block_order[b] >= blocks || (seen & (1U << c->block_order[b]))) {
+                return false;
+            }
+            seen |= 1U << c->block_order[b];
+        }
+    }
+
+    if (blocks < 32 && (c->mirrored_blocks >> blocks) != 0) {
+        return false;
+    }
+
+    if (c->dual_side) {
+        return (c->height % 2) == 0;
+    }
+    return !c->bottom_flipped && !c->bottom_mirrored;
+}
+
+/**
+ * @brief Append a move, merging it into the previous one when contiguous
+ */
+static void desc_add_op(desc_op_t *ops, uint32_t *count, desc_op_t op) {
+    if (*count > 0) {
+        desc_op_t *last = &ops[*count - 1];
+        bool raw_next = (op.src == last->src + last->len);
+
+        if (raw_next && !op.reverse && !last->reverse && op.dst == last->dst + last->len) {
+            last->len += op.len;
+            return;
+        }
+        if (raw_next && op.reverse && last->reverse && op.dst + op.len == last->dst) {
+            last->dst = op.dst;
+            last->len += op.len;
+            return;
+        }
+    }
+
+    ops[(*count)++] = op;
+}
+
+static void desc_compile_line(descramble_t *d, int line_class) {
+    const desc_config_t *c = &d->config;
+    uint32_t block_cols = (c->block_cols != 0) ? c->block_cols : c->width;
+    uint32_t blocks = c->width / block_cols;
+    bool mirror_line = (line_class == DESC_LINE_BOTTOM) && c->bottom_mirrored;
+
+    d->op_count[line_class] = 0;
+    for (uint32_t b = 0; b < blocks; b++) {
+        uint32_t image_block = (c->block_count != 0) ? c->block_order[b] : b;
+        desc_op_t op = {
+            .src = b * block_cols,
+            .dst = image_block * block_cols,
+            .len = block_cols,
+            .reverse = (c->mirrored_blocks & (1U << b)) != 0
+        };
+
+        if (mirror_line) {
+            op.dst = c->width - op.dst - op.len;
+            op.reverse = !op.reverse;
+        }
+
+        desc_add_op(d->ops[line_class], &d->op_count[line_class], op);
+    }
+
+    const desc_op_t *first = &d->ops[line_class][0];
+    d->whole_line[line_class] = d->op_count[line_class] == 1 && !first->reverse &&
+                                first->src == 0 && first->dst == 0;
+}
+
+static void desc_compile_rows(descramble_t *d) {
+    const desc_config_t *c = &d->config;
+    uint32_t half = c->height / 2;
+
+    for (uint32_t r = 0; r < c->height; r++) {
+        uint32_t k = r / 2;
+
+        if (!c->dual_side) {
+            d->row_map[r] = r;
+        } else if ((r & 1) == 0) {
+            d->row_map[r] = k;
+        } else {
+            d->row_map[r] = c->bottom_flipped ? c->height - 1 - k : half + k;
+        }
+    }
+}
+
+static inline int desc_line_class(const descramble_t *d, uint32_t raw_row) {
+    return (d->config.dual_side && (raw_row & 1)) ? DESC_LINE_BOTTOM : DESC_LINE_TOP;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+descramble_t *descramble_create(const desc_config_t *config) {
+    if (config == NULL || !desc_config_valid(config)) {
+        return NULL;
+    }
+
+    descramble_t *d = (descramble_t *)calloc(1, sizeof(descramble_t));
+    if (d == NULL) {
+        return NULL;
+    }
+
+    d->config = *config;
+    d->row_map = (uint32_t *)malloc((size_t)config->height * sizeof(uint32_t));
+    if (d->row_map == NULL) {
+        free(d);
+        return NULL;
+    }
+
+    desc_compile_line(d, DESC_LINE_TOP);
+    desc_compile_line(d, DESC_LINE_BOTTOM);
+    desc_compile_rows(d);
+    d->reverse_fn = (desc_reverse_fn_t)cpu_dispatch_select(&descramble_kernel_reverse, NULL);
+
+    return d;
+}
+
+void descramble_destroy(descramble_t *d) {
+    if (d == NULL) {
+        return;
+    }
+
+    free(d->row_map);
+    free(d);
+}
+
+bool descramble_is_identity(const descramble_t *d) {
+    return d != NULL && !d->config.dual_side && d->whole_line[DESC_LINE_TOP];
+}
+
+uint32_t descramble_op_count(const descramble_t *d, bool bottom) {
+    if (d == NULL) {
+        return 0;
+    }
+    return d->op_count[bottom && d->config.dual_side ? DESC_LINE_BOTTOM : DESC_LINE_TOP];
+}
+
+uint32_t descramble_image_row(const descramble_t *d, uint32_t raw_row) {
+    if (d == NULL || raw_row >= d->config.height) {
+        return UINT32_MAX;
+    }
+    return d->row_map[raw_row];
+}
+
+desc_status_t descramble_apply_rows(const descramble_t *d, uint16_t *dst, const uint16_t *src,
+                                    uint32_t raw_start, uint32_t raw_count) {
+    if (d == NULL || dst == NULL || src == NULL) {
+        return DESC_ERROR_NULL;
+    }
+
+    const size_t width = d->config.width;
+    if (raw_start > d->config.height || raw_count > d->config.height - raw_start) {
+        return DESC_ERROR_PARAM;
+    }
+
+    uint32_t end = raw_start + raw_count;
+    for (uint32_t r = raw_start; r < end;) {
+        int line_class = desc_line_class(d, r);
+        uint32_t row = d->row_map[r];
+        const uint16_t *src_line = src + (size_t)r * width;
+        uint16_t *dst_line = dst + (size_t)row * width;
+
+        if (d->whole_line[line_class]) {
+            /* Coalesce lines that stay consecutive into one copy */
+            uint32_t n = 1;
+            while (r + n < end && desc_line_class(d, r + n) == line_class &&
+                   d->row_map[r + n] == row + n) {
+                n++;
+            }
+            memcpy(dst_line, src_line, n * width * sizeof(uint16_t));
+            r += n;
+            continue;
+        }
+
+        const desc_op_t *op = d->ops[line_class];
+        const desc_op_t *op_end = op + d->op_count[line_class];
+        for (; op < op_end; op++) {
+            if (op->reverse) {
+                d->reverse_fn(dst_line + op->dst, src_line + op->src, op->len);
+            } else {
+                memcpy(dst_line + op->dst, src_line + op->src, op->len * sizeof(uint16_t));
+            }
+        }
+        r++;
+    }
+
+    return DESC_OK;
+}
+
+desc_status_t descramble_apply_frame(const descramble_t *d, uint16_t *dst, const uint16_t *src) {
+    if (d == NULL) {
+        return DESC_ERROR_NULL;
+    }
+    return descramble_apply_rows(d, dst, src, 0, d->config.height);
+}
+
+const char *descramble_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&descramble_kernel_reverse, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
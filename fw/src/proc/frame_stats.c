@@ -0,0 +1,420 @@
+/**
+ * @file frame_stats.c
+ * @brief Fused per-frame statistics kernel
+ *
+ * Per sampled row:
+ * 1. Span kernel (NEON/AVX2/SSE4.2/scalar, chosen by util/cpu_dispatch)
+ *    over the whole row: min, max and the sum of the ROI columns
+ * 2. Strided histogram update from the now L1-resident row, spread over
+ *    four sub-histograms so runs of equal bins do not serialise on one
+ *    counter
+ *
+ * Sub-histograms live on the stack (16 KiB) and are merged once per frame.
+ * The band API (begin / accumulate_rows / finish) runs the same row pass
+ * into a single histogram so it can ride along with other band stages.
+ */
+
+#include "proc/frame_stats.h"
+#include <string.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define FSTATS_SUB_HISTS    4
+
+/* Span length bound: keeps 32-bit SIMD sum lanes from overflowing */
+#define FSTATS_MAX_WIDTH    65535U
+
+/**
+ * @brief Span min/max/sum accumulator
+ */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint64_t sum;
+} fstats_span_t;
+
+typedef void (*fstats_span_fn_t)(const uint16_t *px, size_t n, fstats_span_t *s);
+
+/* ==========================================================================
+ * Span Kernels
+ * ========================================================================== */
+
+static void fstats_span_scalar(const uint16_t *px, size_t n, fstats_span_t *s) {
+    uint16_t mn = s->min;
+    uint16_t mx = s->max;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        mn = (px[i] < mn) ? px[i] : mn;
+        mx = (px[i] > mx) ? px[i] : mx;
+        sum += px[i];
+    }
+
+    s->min = mn;
+    s->max = mx;
+    s->sum += sum;
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static void fstats_span_neon(const uint16_t *px, size_t n, fstats_span_t *s) {
+    uint16x8_t vmin = vdupq_n_u16(0xFFFF);
+    uint16x8_t vmax = vdupq_n_u16(0);
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vld1q_u16(px + i);
+        vmin = vminq_u16(vmin, v);
+        vmax = vmaxq_u16(vmax, v);
+        acc = vpadalq_u16(acc, v);
+    }
+
+    if (i > 0) {
+        uint16_t mn = vminvq_u16(vmin);
+        uint16_t mx = vmaxvq_u16(vmax);
+        s->min = (mn < s->min) ? mn : s->min;
+        s->max = (mx > s->max) ? mx : s->max;
+        s->sum += vaddlvq_u32(acc);
+    }
+
+    fstats_span_scalar(px + i, n - i, s);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static void fstats_span_sse42(const uint16_t *px, size_t n, fstats_span_t *s) {
+    __m128i vmin = _mm_set1_epi16((short)0xFFFF);
+    __m128i vmax = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(px + i));
+        vmin = _mm_min_epu16(vmin, v);
+        vmax = _mm_max_epu16(vmax, v);
+        acc = _mm_add_epi32(acc, _mm_cvtepu16_epi32(v));
+        acc = _mm_add_epi32(acc, _mm_cvtepu16_epi32(_mm_srli_si128(v, 8)));
+    }
+
+    if (i > 0) {
+        /* minpos finds the unsigned minimum; max is the minimum of ~v */
+        uint16_t mn = (uint16_t)_mm_cvtsi128_si32(_mm_minpos_epu16(vmin));
+        uint16_t mx = (uint16_t)~_mm_cvtsi128_si32(
+            _mm_minpos_epu16(_mm_xor_si128(vmax, _mm_set1_epi16((short)0xFFFF))));
+        uint32_t lsum[4];
+        _mm_storeu_si128((__m128i *)lsum, acc);
+
+        s->min = (mn < s->min) ? mn : s->min;
+        s->max = (mx > s->max) ? mx : s->max;
+        s->sum += (uint64_t)lsum[0] + lsum[1] + lsum[2] + lsum[3];
+    }
+
+    fstats_span_scalar(px + i, n - i, s);
+}
+
+CPU_TARGET_AVX2
+static void fstats_span_avx2(const uint16_t *px, size_t n, fstats_span_t *s) {
+    __m256i vmin = _mm256_set1_epi16((short)0xFFFF);
+    __m256i vmax = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(px + i));
+        vmin = _mm256_min_epu16(vmin, v);
+        vmax = _mm256_max_epu16(vmax, v);
+        acc = _mm256_add_epi32(acc, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi32(acc, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+    }
+
+    if (i > 0) {
+        uint16_t lmin[16], lmax[16];
+        uint32_t lsum[8];
+        _mm256_storeu_si256((__m256i *)lmin, vmin);
+        _mm256_storeu_si256((__m256i *)lmax, vmax);
+        _mm256_storeu_si256((__m256i *)lsum, acc);
+
+        for (int k = 0; k < 16; k++) {
+            s->min = (lmin[k] < s->min) ? lmin[k] : s->min;
+            s->max = (lmax[k] > s->max) ? lmax[k] : s->max;
+        }
+        for (int k = 0; k < 8; k++) {
+            s->sum += lsum[k];
+        }
+    }
+
+    fstats_span_scalar(px + i, n - i, s);
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define FSTATS_CHECK_PIXELS 1031    /* Odd length exercises the tail */
+
+static bool fstats_check_span(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t px[FSTATS_CHECK_PIXELS];
+    size_t n = FSTATS_CHECK_PIXELS - (seed % 16);
+    uint16_t base = (uint16_t)cpu_dispatch_random(&seed);
+
+    /* Narrow range around a random base, with random extremes */
+    for (size_t i = 0; i < n; i++) {
+        px[i] = (uint16_t)(base + (cpu_dispatch_random(&seed) >> 24));
+    }
+    px[cpu_dispatch_random(&seed) % n] = (uint16_t)cpu_dispatch_random(&seed);
+
+    fstats_span_t a = { 0xFFFF, 0, 0 };
+    fstats_span_t b = { 0xFFFF, 0, 0 };
+    ((fstats_span_fn_t)candidate)(px, n, &a);
+    ((fstats_span_fn_t)reference)(px, n, &b);
+
+    return a.min == b.min && a.max == b.max && a.sum == b.sum;
+}
+
+static const cpu_variant_t fstats_span_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)fstats_span_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)fstats_span_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)fstats_span_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)fstats_span_avx2 },
+#endif
+};
+
+const cpu_kernel_t frame_stats_kernel_span = {
+    .name = "frame_stats.span",
+    .variants = fstats_span_variants,
+    .variant_count = sizeof(fstats_span_variants) / sizeof(fstats_span_variants[0]),
+    .check = fstats_check_span
+};
+
+/* ==========================================================================
+ * Row Pass
+ * ========================================================================== */
+
+/**
+ * @brief Resolved sampling geometry
+ */
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t row_step;
+    uint32_t col_step;
+    uint32_t roi_x0, roi_x1;
+    uint32_t roi_y0, roi_y1;
+    fstats_span_fn_t span;
+} fstats_geom_t;
+
+/**
+ * @brief Per-frame accumulators shared by the whole-frame and band paths
+ */
+typedef struct {
+    fstats_span_t span;
+    uint64_t roi_sum;
+    uint32_t roi_count;
+    uint32_t samples;
+} fstats_acc_t;
+
+static fstats_status_t fstats_resolve(const fstats_config_t *config, fstats_geom_t *g) {
+    uint32_t width = config->width;
+    uint32_t height = config->height;
+    uint32_t roi_w = (config->roi_width != 0) ? config->roi_width : width;
+    uint32_t roi_h = (config->roi_height != 0) ? config->roi_height : height;
+
+    if (width == 0 || height == 0 || width > FSTATS_MAX_WIDTH ||
+        config->roi_x >= width || roi_w > width - config->roi_x ||
+        config->roi_y >= height || roi_h > height - config->roi_y) {
+        return FSTATS_ERROR_PARAM;
+    }
+
+    g->width = width;
+    g->height = height;
+    g->row_step = (config->row_step != 0) ? config->row_step : FSTATS_DEFAULT_STEP;
+    g->col_step = (config->col_step != 0) ? config->col_step : FSTATS_DEFAULT_STEP;
+    g->roi_x0 = config->roi_x;
+    g->roi_x1 = config->roi_x + roi_w;
+    g->roi_y0 = config->roi_y;
+    g->roi_y1 = config->roi_y + roi_h;
+    g->span = (fstats_span_fn_t)cpu_dispatch_select(&frame_stats_kernel_span, NULL);
+
+    return FSTATS_OK;
+}
+
+/**
+ * @brief Sampled rows of [row_start, row_end)
+ *
+ * hist[0..3] may all point at the same histogram.
+ */
+static void fstats_rows(const fstats_geom_t *g, const uint16_t *frame,
+                        uint32_t row_start, uint32_t row_end,
+                        uint32_t *const hist[FSTATS_SUB_HISTS], fstats_acc_t *acc) {
+    uint32_t width = g->width;
+    uint32_t col_step = g->col_step;
+    uint32_t roi_w = g->roi_x1 - g->roi_x0;
+
+    /* First sampled row at or after row_start */
+    uint32_t first = row_start + (g->row_step - row_start % g->row_step) % g->row_step;
+
+    for (uint32_t y = first; y < row_end; y += g->row_step) {
+        const uint16_t *row = frame + (size_t)y * width;
+
+        if (y >= g->roi_y0 && y < g->roi_y1) {
+            g->span(row, g->roi_x0, &acc->span);
+            uint64_t outside = acc->span.sum;
+            g->span(row + g->roi_x0, roi_w, &acc->span);
+            acc->roi_sum += acc->span.sum - outside;
+            acc->roi_count += roi_w;
+            g->span(row + g->roi_x1, width - g->roi_x1, &acc->span);
+        } else {
+            g->span(row, width, &acc->span);
+        }
+
+        uint32_t x = 0;
+        for (; x + 3 * col_step < width; x += 4 * col_step) {
+            hist[0][row[x] >> FSTATS_HIST_SHIFT]++;
+            hist[1][row[x + col_step] >> FSTATS_HIST_SHIFT]++;
+            hist[2][row[x + 2 * col_step] >> FSTATS_HIST_SHIFT]++;
+            hist[3][row[x + 3 * col_step] >> FSTATS_HIST_SHIFT]++;
+            acc->samples += 4;
+        }
+        for (; x < width; x += col_step) {
+            hist[0][row[x] >> FSTATS_HIST_SHIFT]++;
+            acc->samples++;
+        }
+    }
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+fstats_status_t frame_stats_compute(const fstats_config_t *config, const uint16_t *frame,
+                                    fstats_t *stats) {
+    if (config == NULL || frame == NULL || stats == NULL) {
+        return FSTATS_ERROR_NULL;
+    }
+
+    fstats_geom_t geom;
+    if (fstats_resolve(config, &geom) != FSTATS_OK) {
+        return FSTATS_ERROR_PARAM;
+    }
+
+    uint32_t sub[FSTATS_SUB_HISTS][FSTATS_HIST_BINS];
+    memset(sub, 0, sizeof(sub));
+
+    uint32_t *const hist[FSTATS_SUB_HISTS] = { sub[0], sub[1], sub[2], sub[3] };
+    fstats_acc_t acc = { .span = { 0xFFFF, 0, 0 } };
+    fstats_rows(&geom, frame, 0, geom.height, hist, &acc);
+
+    for (uint32_t b = 0; b < FSTATS_HIST_BINS; b++) {
+        stats->hist[b] = sub[0][b] + sub[1][b] + sub[2][b] + sub[3][b];
+    }
+    stats->samples = acc.samples;
+    stats->min = acc.span.min;
+    stats->max = acc.span.max;
+    stats->roi_sum = acc.roi_sum;
+    stats->roi_count = acc.roi_count;
+    frame_stats_finish(stats);
+
+    return FSTATS_OK;
+}
+
+fstats_status_t frame_stats_begin(const fstats_config_t *config, fstats_t *stats) {
+    if (config == NULL || stats == NULL) {
+        return FSTATS_ERROR_NULL;
+    }
+
+    fstats_geom_t geom;
+    if (fstats_resolve(config, &geom) != FSTATS_OK) {
+        return FSTATS_ERROR_PARAM;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->min = 0xFFFF;
+
+    return FSTATS_OK;
+}
+
+fstats_status_t frame_stats_accumulate_rows(const fstats_config_t *config, const uint16_t *frame,
+                                            uint32_t row_start, uint32_t row_count,
+                                            fstats_t *stats) {
+    if (config == NULL || frame == NULL || stats == NULL) {
+        return FSTATS_ERROR_NULL;
+    }
+
+    fstats_geom_t geom;
+    if (fstats_resolve(config, &geom) != FSTATS_OK ||
+        row_start >= geom.height || row_count > geom.height - row_start) {
+        return FSTATS_ERROR_PARAM;
+    }
+
+    /* Band path: one histogram, merged per frame would cost more than it saves */
+    uint32_t *const hist[FSTATS_SUB_HISTS] = { stats->hist, stats->hist, stats->hist, stats->hist };
+    fstats_acc_t acc = {
+        .span = { stats->min, stats->max, 0 },
+        .roi_sum = stats->roi_sum,
+        .roi_count = stats->roi_count,
+        .samples = stats->samples
+    };
+    fstats_rows(&geom, frame, row_start, row_start + row_count, hist, &acc);
+
+    stats->samples = acc.samples;
+    stats->min = acc.span.min;
+    stats->max = acc.span.max;
+    stats->roi_sum = acc.roi_sum;
+    stats->roi_count = acc.roi_count;
+
+    return FSTATS_OK;
+}
+
+void frame_stats_finish(fstats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->roi_mean = (stats->roi_count > 0) ?
+                      (float)((double)stats->roi_sum / stats->roi_count) : 0.0f;
+}
+
+uint16_t frame_stats_percentile(const fstats_t *stats, float fraction) {
+    if (stats == NULL || stats->samples == 0) {
+        return 0;
+    }
+
+    if (fraction < 0.0f) {
+        fraction = 0.0f;
+    } else if (fraction > 1.0f) {
+        fraction = 1.0f;
+    }
+
+    /* First bin whose cumulative count reaches the rank */
+    uint64_t rank = (uint64_t)((double)fraction * stats->samples + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t cumulative = 0;
+    uint32_t bin = 0;
+    for (; bin < FSTATS_HIST_BINS - 1; bin++) {
+        cumulative += stats->hist[bin];
+        if (cumulative >= rank) {
+            break;
+        }
+    }
+
+    return (uint16_t)((bin << FSTATS_HIST_SHIFT) + (1U << (FSTATS_HIST_SHIFT - 1)));
+}
+
+const char *frame_stats_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&frame_stats_kernel_span, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
@@ -0,0 +1,573 @@
+/**
+ * @file orientation.c
+ * @brief Frame orientation transforms (flip, rotate, transpose)
+ *
+ * Pixel (x, y) of a width x height input goes to output column dx, row dy:
+ *
+ *   flip_h      (W-1-x, y)          rot90       (H-1-y, x)
+ *   flip_v      (x, H-1-y)          rot270      (y, W-1-x)
+ *   rot180      (W-1-x, H-1-y)      transpose   (y, x)
+ *                                   transverse  (H-1-y, W-1-x)
+ *
+ * The axis-swapping transforms are a tile transpose with the source rows
+ * read bottom-up (rot90, transverse) and/or the output rows written
+ * bottom-up (rot270, transverse), so one kernel with signed strides,
+ * dst[i * ds + j] = src[j * ss + i] over an 8x8 tile, covers all four.
+ *
+ * Tile-transpose kernel variants (selected at create time):
+ * - AArch64 NEON: vtrn on 16- and 32-bit lanes
+ * - x86 SSE4.2: unpack on 16-, 32- and 64-bit lanes
+ * - Scalar for other targets (AVX2 would only help two tiles at a time,
+ *   the SSE4.2 variant is used on AVX2 hosts)
+ *
+ * Flips and rot180 reuse the descramble block-reverse kernel per row.
+ */
+
+#include "proc/orientation.h"
+#include "proc/descramble.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define ORIENT_TILE         8
+#define ORIENT_BLOCK_TILES  8       /* 64x64 pixel blocks: 8 KiB in, 8 KiB out */
+
+typedef void (*orient_tile_fn_t)(uint16_t *dst, ptrdiff_t dst_stride,
+                                 const uint16_t *src, ptrdiff_t src_stride);
+
+struct orientation {
+    orient_config_t config;
+    uint32_t out_width;
+    uint32_t out_height;
+    bool in_place;                  /* No scratch frame needed */
+    uint16_t *scratch;              /* Out-of-place target (NULL if in_place) */
+    uint16_t *row_a;                /* Row buffers for flips */
+    uint16_t *row_b;
+    uint8_t *visited;               /* Tile bitmap for in-place cycles */
+    orient_tile_fn_t tile_fn;
+    desc_reverse_fn_t reverse_fn;
+};
+
+static const char *const orient_names[ORIENT_COUNT] = {
+    [ORIENT_NONE] = "none",
+    [ORIENT_FLIP_H] = "flip_h",
+    [ORIENT_FLIP_V] = "flip_v",
+    [ORIENT_ROT90] = "rot90",
+    [ORIENT_ROT180] = "rot180",
+    [ORIENT_ROT270] = "rot270",
+    [ORIENT_TRANSPOSE] = "transpose",
+    [ORIENT_TRANSVERSE] = "transverse"
+};
+
+/* ==========================================================================
+ * Tile-Transpose Kernels: dst[i * ds + j] = src[j * ss + i], 0 <= i, j < 8
+ * ========================================================================== */
+
+static void orient_tile_scalar(uint16_t *dst, ptrdiff_t dst_stride,
+                               const uint16_t *src, ptrdiff_t src_stride) {
+    for (int i = 0; i < ORIENT_TILE; i++) {
+        for (int j = 0; j < ORIENT_TILE; j++) {
+            dst[i * dst_stride + j] = src[j * src_stride + i];
+        }
+    }
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static void orient_tile_neon(uint16_t *dst, ptrdiff_t dst_stride,
+                             const uint16_t *src, ptrdiff_t src_stride) {
+    uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(src), vld1q_u16(src + src_stride));
+    uint16x8x2_t t23 = vtrnq_u16(vld1q_u16(src + 2 * src_stride),
+                                 vld1q_u16(src + 3 * src_stride));
+    uint16x8x2_t t45 = vtrnq_u16(vld1q_u16(src + 4 * src_stride),
+                                 vld1q_u16(src + 5 * src_stride));
+    uint16x8x2_t t67 = vtrnq_u16(vld1q_u16(src + 6 * src_stride),
+                                 vld1q_u16(src + 7 * src_stride));
+
+    /* Low halves hold columns 0-3, high halves columns 4-7 */
+    uint32x4x2_t u02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]),
+                                 vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]),
+                                 vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u46 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]),
+                                 vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t u57 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]),
+                                 vreinterpretq_u32_u16(t67.val[1]));
+
+    vst1q_u16(dst, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(u02.val[0]),
+                                                       vget_low_u32(u46.val[0]))));
+    vst1q_u16(dst + dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(u13.val[0]),
+                                                                    vget_low_u32(u57.val[0]))));
+    vst1q_u16(dst + 2 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(u02.val[1]),
+                                                                        vget_low_u32(u46.val[1]))));
+    vst1q_u16(dst + 3 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(u13.val[1]),
+                                                                        vget_low_u32(u57.val[1]))));
+    vst1q_u16(dst + 4 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(u02.val[0]),
+                                                                        vget_high_u32(u46.val[0]))));
+    vst1q_u16(dst + 5 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(u13.val[0]),
+                                                                        vget_high_u32(u57.val[0]))));
+    vst1q_u16(dst + 6 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(u02.val[1]),
+                                                                        vget_high_u32(u46.val[1]))));
+    vst1q_u16(dst + 7 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(u13.val[1]),
+                                                                        vget_high_u32(u57.val[1]))));
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static void orient_tile_sse42(uint16_t *dst, ptrdiff_t dst_stride,
+                              const uint16_t *src, ptrdiff_t src_stride) {
+    __m128i a0 = _mm_loadu_si128((const __m128i *)src);
+    __m128i a1 = _mm_loadu_si128((const __m128i *)(src + src_stride));
+    __m128i a2 = _mm_loadu_si128((const __m128i *)(src + 2 * src_stride));
+    __m128i a3 = _mm_loadu_si128((const __m128i *)(src + 3 * src_stride));
+    __m128i a4 = _mm_loadu_si128((const __m128i *)(src + 4 * src_stride));
+    __m128i a5 = _mm_loadu_si128((const __m128i *)(src + 5 * src_stride));
+    __m128i a6 = _mm_loadu_si128((const __m128i *)(src + 6 * src_stride));
+    __m128i a7 = _mm_loadu_si128((const __m128i *)(src + 7 * src_stride));
+
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+    __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+    __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+    __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+
+    _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(c0, c4));
+    _mm_storeu_si128((__m128i *)(dst + dst_stride), _mm_unpackhi_epi64(c0, c4));
+    _mm_storeu_si128((__m128i *)(dst + 2 * dst_stride), _mm_unpacklo_epi64(c1, c5));
+    _mm_storeu_si128((__m128i *)(dst + 3 * dst_stride), _mm_unpackhi_epi64(c1, c5));
+    _mm_storeu_si128((__m128i *)(dst + 4 * dst_stride), _mm_unpacklo_epi64(c2, c6));
+    _mm_storeu_si128((__m128i *)(dst + 5 * dst_stride), _mm_unpackhi_epi64(c2, c6));
+    _mm_storeu_si128((__m128i *)(dst + 6 * dst_stride), _mm_unpacklo_epi64(c3, c7));
+    _mm_storeu_si128((__m128i *)(dst + 7 * dst_stride), _mm_unpackhi_epi64(c3, c7));
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define ORIENT_CHECK_STRIDE 13      /* Not a multiple of the tile */
+
+static bool orient_check_tile(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t src[ORIENT_TILE * ORIENT_CHECK_STRIDE];
+    uint16_t dst_a[ORIENT_TILE * ORIENT_CHECK_STRIDE];
+    uint16_t dst_b[ORIENT_TILE * ORIENT_CHECK_STRIDE];
+    const ptrdiff_t last = (ORIENT_TILE - 1) * ORIENT_CHECK_STRIDE;
+
+    for (size_t i = 0; i < sizeof(src) / sizeof(src[0]); i++) {
+        src[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+    memset(dst_a, 0, sizeof(dst_a));
+    memset(dst_b, 0, sizeof(dst_b));
+
+    /* Bit 0: source read bottom-up, bit 1: output written bottom-up */
+    bool rev_src = (seed & 1) != 0;
+    bool rev_dst = (seed & 2) != 0;
+    const uint16_t *s = src + (rev_src ? last : 0);
+    ptrdiff_t ss = rev_src ? -ORIENT_CHECK_STRIDE : ORIENT_CHECK_STRIDE;
+    ptrdiff_t ds = rev_dst ? -ORIENT_CHECK_STRIDE : ORIENT_CHECK_STRIDE;
+
+    ((orient_tile_fn_t)candidate)(dst_a + (rev_dst ? last : 0), ds, s, ss);
+    ((orient_tile_fn_t)reference)(dst_b + (rev_dst ? last : 0), ds, s, ss);
+
+    return memcmp(dst_a, dst_b, sizeof(dst_a)) == 0;
+}
+
+static const cpu_variant_t orient_tile_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)orient_tile_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)orient_tile_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)orient_tile_sse42 },
+#endif
+};
+
+const cpu_kernel_t orientation_kernel_tile = {
+    .name = "orientation.tile",
+    .variants = orient_tile_variants,
+    .variant_count = sizeof(orient_tile_variants) / sizeof(orient_tile_variants[0]),
+    .check = orient_check_tile
+};
+
+/* ==========================================================================
+ * Internal Helpers
+ * ========================================================================== */
+
+/**
+ * @brief Output position of input pixel (x, y)
+ */
+static inline void orient_map(orient_t t, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                              uint32_t *dx, uint32_t *dy) {
+    switch (t) {
+    case ORIENT_FLIP_H:     *dx = w - 1 - x; *dy = y; break;
+    case ORIENT_FLIP_V:     *dx = x; *dy = h - 1 - y; break;
+    case ORIENT_ROT90:      *dx = h - 1 - y; *dy = x; break;
+    case ORIENT_ROT180:     *dx = w - 1 - x; *dy = h - 1 - y; break;
+    case ORIENT_ROT270:     *dx = y; *dy = w - 1 - x; break;
+    case ORIENT_TRANSPOSE:  *dx = y; *dy = x; break;
+    case ORIENT_TRANSVERSE: *dx = h - 1 - y; *dy = w - 1 - x; break;
+    default:                *dx = x; *dy = y; break;
+    }
+}
+
+/* Axis-swapping transforms: source rows bottom-up, output rows bottom-up */
+static inline bool orient_rev_src(orient_t t) {
+    return t == ORIENT_ROT90 || t == ORIENT_TRANSVERSE;
+}
+
+static inline bool orient_rev_dst(orient_t t) {
+    return t == ORIENT_ROT270 || t == ORIENT_TRANSVERSE;
+}
+
+/**
+ * @brief Transform the 8x8 input tile at (x0, y0) into an 8x8 destination
+ *
+ * @param dst Top-left pixel of the destination tile
+ * @param dst_stride Destination row pitch
+ * @param src Input frame
+ * @param width Input width (= row pitch)
+ */
+static inline void orient_tile(orient_tile_fn_t tile_fn, orient_t t, uint16_t *dst,
+                               size_t dst_stride, const uint16_t *src, size_t width,
+                               uint32_t x0, uint32_t y0) {
+    ptrdiff_t ss = (ptrdiff_t)width;
+    ptrdiff_t ds = (ptrdiff_t)dst_stride;
+    const uint16_t *s = src + (size_t)y0 * width + x0;
+
+    if (orient_rev_src(t)) {
+        s += (ORIENT_TILE - 1) * ss;
+        ss = -ss;
+    }
+    if (orient_rev_dst(t)) {
+        dst += (ORIENT_TILE - 1) * ds;
+        ds = -ds;
+    }
+    tile_fn(dst, ds, s, ss);
+}
+
+/**
+ * @brief Axis-swapping transform, out of place, in 64x64 pixel blocks
+ */
+static void orient_swap_blocked(orient_tile_fn_t tile_fn, orient_t t, uint16_t *dst,
+                                const uint16_t *src, uint32_t w, uint32_t h) {
+    const uint32_t block = ORIENT_TILE * ORIENT_BLOCK_TILES;
+    const uint32_t w8 = w & ~(uint32_t)(ORIENT_TILE - 1);
+    const uint32_t h8 = h & ~(uint32_t)(ORIENT_TILE - 1);
+    const size_t out_w = h;
+    uint32_t dx, dy;
+
+    for (uint32_t by = 0; by < h8; by += block) {
+        uint32_t by_end = (by + block < h8) ? by + block : h8;
+        for (uint32_t bx = 0; bx < w8; bx += block) {
+            uint32_t bx_end = (bx + block < w8) ? bx + block : w8;
+            for (uint32_t y0 = by; y0 < by_end; y0 += ORIENT_TILE) {
+                for (uint32_t x0 = bx; x0 < bx_end; x0 += ORIENT_TILE) {
+                    /* Top-left of the output tile covering this input tile */
+                    orient_map(t, orient_rev_dst(t) ? x0 + ORIENT_TILE - 1 : x0,
+                               orient_rev_src(t) ? y0 + ORIENT_TILE - 1 : y0, w, h, &dx, &dy);
+                    orient_tile(tile_fn, t, dst + (size_t)dy * out_w + dx, out_w,
+                                src, w, x0, y0);
+                }
+            }
+        }
+    }
+
+    /* Right and bottom edges narrower than a tile */
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = (y < h8) ? w8 : 0; x < w; x++) {
+            orient_map(t, x, y, w, h, &dx, &dy);
+            dst[(size_t)dy * out_w + dx] = src[(size_t)y * w + x];
+        }
+    }
+}
+
+/**
+ * @brief Axis-swapping transform of a square frame in place
+ *
+ * Every tile moves to one position (transpose / transverse: pairs, rot90 /
+ * rot270: cycles of four). Cycles are followed from start tiles taken in
+ * 64x64 pixel blocks, so the partner tiles of a block also lie in a few
+ * blocks and their lines stay in cache.
+ */
+static void orient_swap_in_place(orientation_t *o, uint16_t *frame) {
+    const orient_t t = o->config.transform;
+    const uint32_t n = o->config.width;
+    const uint32_t tiles = n / ORIENT_TILE;
+    uint16_t carry[ORIENT_TILE * ORIENT_TILE];
+    uint16_t next[ORIENT_TILE * ORIENT_TILE];
+
+    memset(o->visited, 0, ((size_t)tiles * tiles + 7) / 8);
+
+    for (uint32_t br = 0; br < tiles; br += ORIENT_BLOCK_TILES) {
+        for (uint32_t bc = 0; bc < tiles; bc += ORIENT_BLOCK_TILES) {
+            for (uint32_t r = br; r < br + ORIENT_BLOCK_TILES && r < tiles; r++) {
+                for (uint32_t c = bc; c < bc + ORIENT_BLOCK_TILES && c < tiles; c++) {
+                    size_t start = (size_t)r * tiles + c;
+                    if (o->visited[start / 8] & (1U << (start % 8))) {
+                        continue;
+                    }
+
+                    uint32_t cur_r = r, cur_c = c;
+                    orient_tile(o->tile_fn, t, carry, ORIENT_TILE, frame, n,
+                                cur_c * ORIENT_TILE, cur_r * ORIENT_TILE);
+
+                    for (;;) {
+                        uint32_t nr = orient_rev_dst(t) ? tiles - 1 - cur_c : cur_c;
+                        uint32_t nc = orient_rev_src(t) ? tiles - 1 - cur_r : cur_r;
+                        size_t pos = (size_t)nr * tiles + nc;
+                        bool closes = (pos == start);
+
+                        /* Read the tile being overwritten before placing carry */
+                        if (!closes) {
+                            orient_tile(o->tile_fn, t, next, ORIENT_TILE, frame, n,
+                                        nc * ORIENT_TILE, nr * ORIENT_TILE);
+                        }
+                        uint16_t *out = frame + (size_t)nr * ORIENT_TILE * n + nc * ORIENT_TILE;
+                        for (int i = 0; i < ORIENT_TILE; i++) {
+                            memcpy(out + (size_t)i * n, carry + i * ORIENT_TILE,
+                                   ORIENT_TILE * sizeof(uint16_t));
+                        }
+                        o->visited[pos / 8] |= (uint8_t)(1U << (pos % 8));
+
+                        if (closes) {
+                            break;
+                        }
+                        memcpy(carry, next, sizeof(carry));
+                        cur_r = nr;
+                        cur_c = nc;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Flips and rot180 in place, one row pair at a time
+ */
+static void orient_flip_in_place(orientation_t *o, uint16_t *frame) {
+    const orient_t t = o->config.transform;
+    const uint32_t w = o->config.width;
+    const uint32_t h = o->config.height;
+    const size_t row_bytes = (size_t)w * sizeof(uint16_t);
+
+    if (t == ORIENT_FLIP_H) {
+        for (uint32_t y = 0; y < h; y++) {
+            uint16_t *row = frame + (size_t)y * w;
+            o->reverse_fn(o->row_a, row, w);
+            memcpy(row, o->row_a, row_bytes);
+        }
+        return;
+    }
+
+    /* flip_v / rot180: swap rows y and h-1-y, reversing them for rot180 */
+    for (uint32_t y = 0; y < (h + 1) / 2; y++) {
+        uint16_t *top = frame + (size_t)y * w;
+        uint16_t *bottom = frame + (size_t)(h - 1 - y) * w;
+
+        if (t == ORIENT_FLIP_V) {
+            if (top != bottom) {
+                memcpy(o->row_a, top, row_bytes);
+                memcpy(top, bottom, row_bytes);
+                memcpy(bottom, o->row_a, row_bytes);
+            }
+        } else {
+            o->reverse_fn(o->row_a, top, w);
+            o->reverse_fn(o->row_b, bottom, w);
+            memcpy(top, o->row_b, row_bytes);
+            memcpy(bottom, o->row_a, row_bytes);
+        }
+    }
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+const char *orientation_name(orient_t transform) {
+    if ((int)transform < 0 || transform >= ORIENT_COUNT) {
+        return "unknown";
+    }
+    return orient_names[transform];
+}
+
+bool orientation_swaps_axes(orient_t transform) {
+    return transform == ORIENT_ROT90 || transform == ORIENT_ROT270 ||
+           transform == ORIENT_TRANSPOSE || transform == ORIENT_TRANSVERSE;
+}
+
+orientation_t *orientation_create(const orient_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0 ||
+        (int)config->transform < 0 || config->transform >= ORIENT_COUNT) {
+        return NULL;
+    }
+
+    orientation_t *o = (orientation_t *)calloc(1, sizeof(orientation_t));
+    if (o == NULL) {
+        return NULL;
+    }
+
+    const orient_t t = config->transform;
+    const size_t pixels = (size_t)config->width * config->height;
+    const size_t row = (config->width > config->height) ? config->width : config->height;
+    bool swaps = orientation_swaps_axes(t);
+
+    o->config = *config;
+    o->out_width = swaps ? config->height : config->width;
+    o->out_height = swaps ? config->width : config->height;
+    o->in_place = !swaps ||
+                  (config->width == config->height && config->width % ORIENT_TILE == 0);
+    o->tile_fn = (orient_tile_fn_t)cpu_dispatch_select(&orientation_kernel_tile, NULL);
+    o->reverse_fn = (desc_reverse_fn_t)cpu_dispatch_select(&descramble_kernel_reverse, NULL);
+
+    o->row_a = (uint16_t *)malloc(row * sizeof(uint16_t));
+    o->row_b = (uint16_t *)malloc(row * sizeof(uint16_t));
+    bool ok = (o->row_a != NULL && o->row_b != NULL);
+
+    if (!o->in_place) {
+        o->scratch = (uint16_t *)malloc(pixels * sizeof(uint16_t));
+        ok = ok && (o->scratch != NULL);
+    } else if (swaps) {
+        size_t tiles = config->width / ORIENT_TILE;
+        o->visited = (uint8_t *)malloc((tiles * tiles + 7) / 8);
+        ok = ok && (o->visited != NULL);
+    }
+
+    if (!ok) {
+        orientation_destroy(o);
+        return NULL;
+    }
+
+    return o;
+}
+
+void orientation_destroy(orientation_t *o) {
+    if (o == NULL) {
+        return;
+    }
+
+    free(o->scratch);
+    free(o->row_a);
+    free(o->row_b);
+    free(o->visited);
+    free(o);
+}
+
+void orientation_get_output_size(const orientation_t *o, uint32_t *width, uint32_t *height) {
+    if (o == NULL) {
+        return;
+    }
+    if (width != NULL) {
+        *width = o->out_width;
+    }
+    if (height != NULL) {
+        *height = o->out_height;
+    }
+}
+
+bool orientation_in_place(const orientation_t *o) {
+    return o != NULL && o->in_place;
+}
+
+orient_status_t orientation_apply_frame(orientation_t *o, uint16_t *frame) {
+    if (o == NULL || frame == NULL) {
+        return ORIENT_ERROR_NULL;
+    }
+
+    const orient_t t = o->config.transform;
+    if (t == ORIENT_NONE) {
+        return ORIENT_OK;
+    }
+
+    if (!orientation_swaps_axes(t)) {
+        orient_flip_in_place(o, frame);
+    } else if (o->in_place) {
+        orient_swap_in_place(o, frame);
+    } else {
+        orient_swap_blocked(o->tile_fn, t, o->scratch, frame, o->config.width, o->config.height);
+        memcpy(frame, o->scratch, (size_t)o->config.width * o->config.height * sizeof(uint16_t));
+    }
+
+    return ORIENT_OK;
+}
+
+orient_status_t orientation_transform(orient_t transform, uint16_t *dst, const uint16_t *src,
+                                      uint32_t width, uint32_t height) {
+    if (dst == NULL || src == NULL) {
+        return ORIENT_ERROR_NULL;
+    }
+    if ((int)transform < 0 || transform >= ORIENT_COUNT || width == 0 || height == 0) {
+        return ORIENT_ERROR_PARAM;
+    }
+
+    if (orientation_swaps_axes(transform)) {
+        orient_swap_blocked((orient_tile_fn_t)cpu_dispatch_select(&orientation_kernel_tile, NULL),
+                            transform, dst, src, width, height);
+        return ORIENT_OK;
+    }
+
+    desc_reverse_fn_t reverse_fn =
+        (desc_reverse_fn_t)cpu_dispatch_select(&descramble_kernel_reverse, NULL);
+    bool mirror = (transform == ORIENT_FLIP_H || transform == ORIENT_ROT180);
+    bool flip = (transform == ORIENT_FLIP_V || transform == ORIENT_ROT180);
+
+    for (uint32_t y = 0; y < height; y++) {
+        const uint16_t *in = src + (size_t)y * width;
+        uint16_t *out = dst + (size_t)(flip ? height - 1 - y : y) * width;
+        if (mirror) {
+            reverse_fn(out, in, width);
+        } else {
+            memcpy(out, in, (size_t)width * sizeof(uint16_t));
+        }
+    }
+
+    return ORIENT_OK;
+}
+
+orient_status_t orientation_transform_naive(orient_t transform, uint16_t *dst,
+                                            const uint16_t *src, uint32_t width,
+                                            uint32_t height) {
+    if (dst == NULL || src == NULL) {
+        return ORIENT_ERROR_NULL;
+    }
+    if ((int)transform < 0 || transform >= ORIENT_COUNT || width == 0 || height == 0) {
+        return ORIENT_ERROR_PARAM;
+    }
+
+    const size_t out_w = orientation_swaps_axes(transform) ? height : width;
+    uint32_t dx, dy;
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            orient_map(transform, x, y, width, height, &dx, &dy);
+            dst[(size_t)dy * out_w + dx] = src[(size_t)y * width + x];
+        }
+    }
+
+    return ORIENT_OK;
+}
+
+const char *orientation_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&orientation_kernel_tile, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
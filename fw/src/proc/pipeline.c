@@ -0,0 +1,566 @@
+/**
+ * @file pipeline.c
+ * @brief Configurable frame processing pipeline
+ *
+ * Threading model:
+ * - the submitting thread pops a free descriptor, fills it and pushes it
+ *   into stage 0's queue
+ * - stage i pops from its queue, runs its function and pushes the frame
+ *   into stage i+1's queue
+ * - the last stage releases the frame and returns the descriptor to the
+ *   free list
+ *
+ * Every queue therefore has exactly one producer and one consumer. A
+ * frame that a stage consumed or rejected still travels to the end,
+ * skipping the remaining stage functions, so frames are released in
+ * submit order and always from the last stage thread.
+ *
+ * There are as many descriptors as the configured queue depth and every
+ * queue holds one more item, so a push between stages can never fail
+ * and the end-of-stream marker (NULL) always fits. Stage threads sleep
+ * on a counting semaphore per queue; the queues themselves are lock-free.
+ *
+ * A pipeline stage runs one or more registered stage types (members).
+ * Staged execution gives each type its own stage; fused execution puts
+ * consecutive band-capable types into one stage and interleaves their
+ * band operations.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "proc/pipeline.h"
+#include "util/spsc_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <sys/prctl.h>
+
+/**
+ * @brief Registered stage type
+ */
+typedef struct {
+    char name[PIPE_STAGE_NAME_LEN];
+    pipe_stage_fn_t fn;         /**< Whole-frame function (may be NULL) */
+    pipe_band_ops_t ops;        /**< Band operations (rows NULL if none) */
+    void *user_data;
+} pipe_stage_type_t;
+
+struct pipe_registry {
+    pipe_stage_type_t types[PIPE_MAX_STAGE_TYPES];
+    uint32_t count;
+};
+
+/**
+ * @brief Stage instance in a pipeline
+ *
+ * Metrics are written by the stage thread and read by anyone.
+ */
+typedef struct {
+    pipe_stage_type_t members[PIPE_MAX_STAGES];
+    uint32_t member_count;
+    uint32_t band_rows;
+    char name[PIPE_STATS_NAME_LEN];
+    struct pipeline *pipe;
+    uint32_t index;
+
+    spsc_queue_t *in;           /**< Frames waiting for this stage */
+    sem_t items;                /**< Counts frames in `in` */
+    pthread_t thread;
+    bool started;
+
+    atomic_uint_fast64_t frames;
+    atomic_uint_fast64_t errors;
+    atomic_uint_fast64_t consumed;
+    atomic_uint_fast64_t busy_ns;
+    atomic_uint last_us;
+    atomic_uint max_us;
+    atomic_uint queue_max;
+} pipe_stage_t;
+
+struct pipeline {
+    pipe_stage_t stages[PIPE_MAX_STAGES];
+    uint32_t stage_count;
+
+    pipe_frame_t *slots;        /**< Descriptor pool */
+    uint8_t *meta;              /**< meta_size bytes per slot */
+    size_t meta_size;
+    spsc_queue_t *free_slots;   /**< Last stage -> submitter */
+
+    pipe_release_fn_t release;
+    void *release_data;
+    uint64_t start_ns;
+
+    atomic_uint_fast64_t submitted;
+    atomic_uint_fast64_t dropped;
+    atomic_uint_fast64_t completed;
+    atomic_uint in_flight;
+    atomic_uint last_latency_us;
+    atomic_uint max_latency_us;
+};
+
+/* ==========================================================================
+ * Helpers
+ * ========================================================================== */
+
+static uint64_t pipe_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void pipe_update_max(atomic_uint *max, uint32_t value) {
+    uint32_t cur = atomic_load_explicit(max, memory_order_relaxed);
+    while (value > cur &&
+           !atomic_compare_exchange_weak_explicit(max, &cur, value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+static void pipe_wait(sem_t *sem) {
+    while (sem_wait(sem) != 0 && errno == EINTR) {
+    }
+}
+
+static const pipe_stage_type_t *pipe_find(const pipe_registry_t *reg, const char *name) {
+    for (uint32_t i = 0; i < reg->count; i++) {
+        if (strcmp(reg->types[i].name, name) == 0) {
+            return &reg->types[i];
+        }
+    }
+    return NULL;
+}
+
+/* ==========================================================================
+ * Stage Thread
+ * ========================================================================== */
+
+/**
+ * @brief Run the stage's members on one frame
+ *
+ * A single member with a whole-frame function is called directly.
+ * Otherwise the members' band operations are interleaved band by band.
+ */
+static int pipe_run(const pipe_stage_t *st, pipe_frame_t *frame) {
+    const pipe_stage_type_t *m = st->members;
+    uint32_t n = st->member_count;
+
+    if (n == 1 && m[0].fn != NULL) {
+        return m[0].fn(frame, m[0].user_data);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (m[i].ops.begin != NULL) {
+            m[i].ops.begin(frame, m[i].user_data);
+        }
+    }
+
+    /* Member i trails the band front by the lag of the members before it,
+     * so it only sees rows they have finished with */
+    uint32_t done[PIPE_MAX_STAGES] = { 0 };
+    uint32_t front = 0;
+    while (front < frame->height) {
+        front = (frame->height - front < st->band_rows) ? frame->height : front + st->band_rows;
+        uint32_t lag = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t end = (front == frame->height) ? front :
+                           (front > lag) ? front - lag : 0;
+            if (end > done[i]) {
+                m[i].ops.rows(frame, done[i], end - done[i], m[i].user_data);
+                done[i] = end;
+            }
+            lag += m[i].ops.lag_rows;
+        }
+    }
+
+    int result = PIPE_CONTINUE;
+    for (uint32_t i = 0; i < n; i++) {
+        int ret = (m[i].ops.end != NULL) ? m[i].ops.end(frame, m[i].user_data) : PIPE_CONTINUE;
+        if (result == PIPE_CONTINUE) {
+            result = ret;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Hand a frame on, or release it from the last stage
+ */
+static void pipe_forward(pipe_stage_t *st, pipe_frame_t *frame) {
+    struct pipeline *pipe = st->pipe;
+
+    if (st->index + 1 < pipe->stage_count) {
+        pipe_stage_t *next = &pipe->stages[st->index + 1];
+        spsc_queue_push(next->in, frame);
+        sem_post(&next->items);
+        return;
+    }
+
+    if (frame == NULL) {
+        return;
+    }
+
+    if (pipe->release != NULL) {
+        pipe->release(frame, pipe->release_data);
+    }
+
+    uint32_t latency_us = (uint32_t)((pipe_now_ns() - frame->submit_ns) / 1000);
+    atomic_store_explicit(&pipe->last_latency_us, latency_us, memory_order_relaxed);
+    pipe_update_max(&pipe->max_latency_us, latency_us);
+    atomic_fetch_add_explicit(&pipe->completed, 1, memory_order_relaxed);
+
+    spsc_queue_push(pipe->free_slots, frame);
+    atomic_fetch_sub_explicit(&pipe->in_flight, 1, memory_order_release);
+}
+
+static void *pipe_stage_main(void *arg) {
+    pipe_stage_t *st = (pipe_stage_t *)arg;
+    char name[16];  /* Kernel thread name limit, truncated silently */
+
+    memcpy(name, "pipe_", 5);
+    strncpy(name + 5, st->name, sizeof(name) - 6);
+    name[sizeof(name) - 1] = '\0';
+    prctl(PR_SET_NAME, name, 0, 0, 0);
+
+    for (;;) {
+        void *item = NULL;
+
+        pipe_wait(&st->items);
+        uint32_t depth = spsc_queue_depth(st->in);
+        if (!spsc_queue_pop(st->in, &item)) {
+            continue;
+        }
+        pipe_update_max(&st->queue_max, depth);
+
+        pipe_frame_t *frame = (pipe_frame_t *)item;
+        if (frame == NULL) {
+            /* End of stream: pass it on and stop */
+            pipe_forward(st, NULL);
+            break;
+        }
+
+        if (frame->status == PIPE_CONTINUE) {
+            uint64_t t0 = pipe_now_ns();
+            int ret = pipe_run(st, frame);
+            uint64_t dt = pipe_now_ns() - t0;
+            uint32_t us = (uint32_t)(dt / 1000);
+
+            frame->status = ret;
+            atomic_fetch_add_explicit(&st->frames, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&st->busy_ns, dt, memory_order_relaxed);
+            atomic_store_explicit(&st->last_us, us, memory_order_relaxed);
+            pipe_update_max(&st->max_us, us);
+
+            if (ret < 0) {
+                atomic_fetch_add_explicit(&st->errors, 1, memory_order_relaxed);
+            } else if (ret == PIPE_CONSUMED) {
+                atomic_fetch_add_explicit(&st->consumed, 1, memory_order_relaxed);
+            }
+        }
+
+        pipe_forward(st, frame);
+    }
+
+    return NULL;
+}
+
+/* ==========================================================================
+ * Registry API
+ * ========================================================================== */
+
+pipe_registry_t *pipeline_registry_create(void) {
+    return (pipe_registry_t *)calloc(1, sizeof(pipe_registry_t));
+}
+
+void pipeline_registry_destroy(pipe_registry_t *reg) {
+    free(reg);
+}
+
+/**
+ * @brief Add a stage type to the registry
+ */
+static pipe_status_t pipe_register(pipe_registry_t *reg, const char *name,
+                                   pipe_stage_fn_t fn, const pipe_band_ops_t *ops,
+                                   void *user_data) {
+    size_t len = strlen(name);
+    if (len == 0 || len >= PIPE_STAGE_NAME_LEN) {
+        return PIPE_ERROR_PARAM;
+    }
+
+    if (pipe_find(reg, name) != NULL) {
+        return PIPE_ERROR_EXISTS;
+    }
+
+    if (reg->count >= PIPE_MAX_STAGE_TYPES) {
+        return PIPE_ERROR_FULL;
+    }
+
+    pipe_stage_type_t *type = &reg->types[reg->count++];
+    memset(type, 0, sizeof(*type));
+    memcpy(type->name, name, len + 1);
+    type->fn = fn;
+    if (ops != NULL) {
+        type->ops = *ops;
+    }
+    type->user_data = user_data;
+
+    return PIPE_OK;
+}
+
+pipe_status_t pipeline_register_stage(pipe_registry_t *reg, const char *name,
+                                      pipe_stage_fn_t fn, void *user_data) {
+    if (reg == NULL || name == NULL || fn == NULL) {
+        return PIPE_ERROR_NULL;
+    }
+
+    return pipe_register(reg, name, fn, NULL, user_data);
+}
+
+pipe_status_t pipeline_register_band_stage(pipe_registry_t *reg, const char *name,
+                                           pipe_stage_fn_t fn, const pipe_band_ops_t *ops,
+                                           void *user_data) {
+    if (reg == NULL || name == NULL || ops == NULL || ops->rows == NULL) {
+        return PIPE_ERROR_NULL;
+    }
+
+    return pipe_register(reg, name, fn, ops, user_data);
+}
+
+bool pipeline_registry_has(const pipe_registry_t *reg, const char *name) {
+    return reg != NULL && name != NULL && pipe_find(reg, name) != NULL;
+}
+
+/* ==========================================================================
+ * Pipeline API
+ * ========================================================================== */
+
+pipeline_t *pipeline_create(const pipe_config_t *config) {
+    if (config == NULL || config->registry == NULL || config->stages == NULL ||
+        config->stage_count == 0 || config->stage_count > PIPE_MAX_STAGES ||
+        config->priority < 0 || config->exec > PIPE_EXEC_FUSED) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < config->stage_count; i++) {
+        if (config->stages[i] == NULL || pipe_find(config->registry, config->stages[i]) == NULL) {
+            return NULL;
+        }
+    }
+
+    uint32_t depth = (config->queue_depth != 0) ? config->queue_depth : PIPE_DEFAULT_QUEUE_DEPTH;
+    if (depth >= SPSC_MAX_CAPACITY) {
+        return NULL;
+    }
+
+    pipeline_t *pipe = (pipeline_t *)calloc(1, sizeof(pipeline_t));
+    if (pipe == NULL) {
+        return NULL;
+    }
+
+    pipe->release = config->release;
+    pipe->release_data = config->release_data;
+    pipe->slots = (pipe_frame_t *)calloc(depth, sizeof(pipe_frame_t));
+    pipe->free_slots = spsc_queue_create(depth);
+    pipe->meta_size = config->meta_size;
+    if (pipe->meta_size != 0) {
+        pipe->meta = (uint8_t *)calloc(depth, pipe->meta_size);
+    }
+    if (pipe->slots == NULL || pipe->free_slots == NULL ||
+        (pipe->meta_size != 0 && pipe->meta == NULL)) {
+        pipeline_destroy(pipe);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < depth; i++) {
+        if (pipe->meta != NULL) {
+            pipe->slots[i].meta = pipe->meta + (size_t)i * pipe->meta_size;
+        }
+        spsc_queue_push(pipe->free_slots, &pipe->slots[i]);
+    }
+
+    uint32_t band_rows = (config->band_rows != 0) ? config->band_rows : PIPE_DEFAULT_BAND_ROWS;
+
+    for (uint32_t i = 0; i < config->stage_count; i++) {
+        const pipe_stage_type_t *type = pipe_find(config->registry, config->stages[i]);
+        pipe_stage_t *prev = (pipe->stage_count > 0) ? &pipe->stages[pipe->stage_count - 1] : NULL;
+
+        /* Fused: append a band stage to a preceding band-only group */
+        if (config->exec == PIPE_EXEC_FUSED && prev != NULL && type->ops.rows != NULL &&
+            prev->members[0].ops.rows != NULL) {
+            prev->members[prev->member_count++] = *type;
+            size_t used = strlen(prev->name);
+            if (used + 1 < sizeof(prev->name)) {
+                prev->name[used] = '+';
+                strncpy(prev->name + used + 1, type->name, sizeof(prev->name) - used - 2);
+            }
+            continue;
+        }
+
+        pipe_stage_t *st = &pipe->stages[pipe->stage_count];
+        st->members[0] = *type;
+        st->member_count = 1;
+        st->band_rows = band_rows;
+        memcpy(st->name, type->name, sizeof(type->name));
+        st->pipe = pipe;
+        st->index = pipe->stage_count;
+        st->in = spsc_queue_create(depth + 1);
+        if (st->in == NULL) {
+            pipeline_destroy(pipe);
+            return NULL;
+        }
+        sem_init(&st->items, 0, 0);
+        pipe->stage_count++;
+    }
+
+    pipe->start_ns = pipe_now_ns();
+
+    for (uint32_t i = 0; i < pipe->stage_count; i++) {
+        pipe_stage_t *st = &pipe->stages[i];
+        if (pthread_create(&st->thread, NULL, pipe_stage_main, st) != 0) {
+            pipeline_destroy(pipe);
+            return NULL;
+        }
+        st->started = true;
+
+        if (config->priority > 0) {
+            struct sched_param param = { .sched_priority = config->priority };
+            pthread_setschedparam(st->thread, SCHED_FIFO, &param);
+        }
+    }
+
+    return pipe;
+}
+
+void pipeline_destroy(pipeline_t *pipe) {
+    if (pipe == NULL) {
+        return;
+    }
+
+    /* End of stream follows any queued frames, which are still released.
+     * After a failed create it stops at the first stage without a thread. */
+    if (pipe->stage_count > 0 && pipe->stages[0].started) {
+        spsc_queue_push(pipe->stages[0].in, NULL);
+        sem_post(&pipe->stages[0].items);
+    }
+
+    for (uint32_t i = 0; i < pipe->stage_count; i++) {
+        if (pipe->stages[i].started) {
+            pthread_join(pipe->stages[i].thread, NULL);
+        }
+    }
+
+    for (uint32_t i = 0; i < pipe->stage_count; i++) {
+        sem_destroy(&pipe->stages[i].items);
+        spsc_queue_destroy(pipe->stages[i].in);
+    }
+
+    spsc_queue_destroy(pipe->free_slots);
+    free(pipe->slots);
+    free(pipe->meta);
+    free(pipe);
+}
+
+pipe_status_t pipeline_submit(pipeline_t *pipe, const pipe_frame_t *frame) {
+    if (pipe == NULL || frame == NULL) {
+        return PIPE_ERROR_NULL;
+    }
+
+    void *slot = NULL;
+    if (!spsc_queue_pop(pipe->free_slots, &slot)) {
+        atomic_fetch_add_explicit(&pipe->dropped, 1, memory_order_relaxed);
+        return PIPE_ERROR_FULL;
+    }
+
+    pipe_frame_t *desc = (pipe_frame_t *)slot;
+    void *meta = desc->meta;
+    *desc = *frame;
+    desc->meta = meta;
+    if (meta != NULL) {
+        memset(meta, 0, pipe->meta_size);
+    }
+    desc->flags = 0;
+    desc->status = PIPE_CONTINUE;
+    desc->submit_ns = pipe_now_ns();
+
+    atomic_fetch_add_explicit(&pipe->in_flight, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pipe->submitted, 1, memory_order_relaxed);
+
+    spsc_queue_push(pipe->stages[0].in, desc);
+    sem_post(&pipe->stages[0].items);
+
+    return PIPE_OK;
+}
+
+bool pipeline_drain(pipeline_t *pipe, uint32_t timeout_ms) {
+    if (pipe == NULL) {
+        return true;
+    }
+
+    uint64_t deadline = pipe_now_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    while (atomic_load_explicit(&pipe->in_flight, memory_order_acquire) != 0) {
+        if (pipe_now_ns() >= deadline) {
+            return false;
+        }
+        struct timespec ts = { .tv_sec = 0, .tv_nsec = 200000 };
+        nanosleep(&ts, NULL);
+    }
+
+    return true;
+}
+
+void pipeline_get_stats(const pipeline_t *pipe, pipe_stats_t *stats) {
+    if (pipe == NULL || stats == NULL) {
+        return;
+    }
+
+    pipeline_t *p = (pipeline_t *)pipe;
+    memset(stats, 0, sizeof(*stats));
+    stats->stages = p->stage_count;
+    stats->submitted = atomic_load_explicit(&p->submitted, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&p->dropped, memory_order_relaxed);
+    stats->completed = atomic_load_explicit(&p->completed, memory_order_relaxed);
+    stats->in_flight = atomic_load_explicit(&p->in_flight, memory_order_relaxed);
+    stats->last_latency_us = atomic_load_explicit(&p->last_latency_us, memory_order_relaxed);
+    stats->max_latency_us = atomic_load_explicit(&p->max_latency_us, memory_order_relaxed);
+}
+
+pipe_status_t pipeline_get_stage_stats(const pipeline_t *pipe, uint32_t index,
+                                       pipe_stage_stats_t *stats) {
+    if (pipe == NULL || stats == NULL) {
+        return PIPE_ERROR_NULL;
+    }
+
+    if (index >= pipe->stage_count) {
+        return PIPE_ERROR_PARAM;
+    }
+
+    pipe_stage_t *st = (pipe_stage_t *)&pipe->stages[index];
+    memset(stats, 0, sizeof(*stats));
+    memcpy(stats->name, st->name, sizeof(stats->name));
+
+    uint64_t frames = atomic_load_explicit(&st->frames, memory_order_relaxed);
+    uint64_t busy_ns = atomic_load_explicit(&st->busy_ns, memory_order_relaxed);
+    double elapsed_s = (double)(pipe_now_ns() - pipe->start_ns) / 1.0e9;
+
+    stats->frames = frames;
+    stats->errors = atomic_load_explicit(&st->errors, memory_order_relaxed);
+    stats->consumed = atomic_load_explicit(&st->consumed, memory_order_relaxed);
+    stats->last_us = atomic_load_explicit(&st->last_us, memory_order_relaxed);
+    stats->max_us = atomic_load_explicit(&st->max_us, memory_order_relaxed);
+    stats->avg_us = (frames > 0) ? (uint32_t)(busy_ns / frames / 1000) : 0;
+    stats->queue_depth = spsc_queue_depth(st->in);
+    stats->queue_max = atomic_load_explicit(&st->queue_max, memory_order_relaxed);
+    if (elapsed_s > 0.0) {
+        stats->fps = (float)((double)frames / elapsed_s);
+        stats->busy = (float)((double)busy_ns / 1.0e9 / elapsed_s);
+    }
+
+    return PIPE_OK;
+}
@@ -0,0 +1,720 @@
+/**
+ * @file pixel_drift.c
+ * @brief Per-pixel dark statistics for defect drift tracking
+ *
+ * Update per pixel, x the new sample in Q4 and s = min(log2(n), shift):
+ *
+ *   delta = x - mean
+ *   mean += delta >> s
+ *   var  += ((delta * (x - mean)) - var) >> s
+ *
+ * With s = log2(n) this is Welford's recurrence for the population
+ * variance. Deviations are clamped to +-2047 counts before the multiply
+ * so the Q8 product fits a 32-bit lane; a pixel that far off is flagged
+ * on its offset anyway. The offset and noise comparison is fused into
+ * the same pass once a block has its baseline.
+ *
+ * Cost at the default 262144 pixels per frame (bench_pixel_drift, x86
+ * development host): 0.08 ms to copy the block on the pipeline thread;
+ * 0.35 ms (AVX2), 0.39 ms (SSE4.2) or 1.7 ms (scalar) of worker time.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* SCHED_IDLE */
+#endif
+
+#include "proc/pixel_drift.h"
+#include "util/spsc_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <time.h>
+#include <sys/prctl.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define DRIFT_MEAN_FRAC     4       /* Mean is Q4 */
+#define DRIFT_VAR_FRAC      8       /* Variance is Q8 */
+#define DRIFT_DEV_MAX       32767   /* Q4 deviation clamp (2047 counts) */
+#define DRIFT_FLUSH_POLL_NS 1000000L
+
+/**
+ * @brief Parameters of one block update
+ */
+typedef struct {
+    uint32_t shift;             /**< Weight 1 / 2^shift */
+    int32_t offset_limit;       /**< Offset threshold, Q4 */
+    int32_t var_limit;          /**< Noise threshold squared, Q8 */
+} drift_step_t;
+
+/*
+ * Update n pixels; with a baseline, also write flags and return how many
+ * pixels are flagged.
+ */
+typedef uint32_t (*drift_update_fn_t)(int32_t *mean, int32_t *var, uint8_t *flags,
+                                      const uint16_t *baseline, const uint16_t *x, size_t n,
+                                      const drift_step_t *step);
+
+/**
+ * @brief Staging slot for one block handed to the worker
+ */
+typedef struct {
+    uint32_t block;             /**< Block index */
+    uint16_t *data;             /**< Copy of the block's pixels */
+} drift_slot_t;
+
+/**
+ * @brief Drift tracker
+ */
+struct pixel_drift {
+    drift_config_t config;      /**< Configuration with defaults applied */
+    size_t pixels;              /**< width * height */
+    uint32_t block_count;       /**< Blocks per frame */
+    uint32_t next_block;        /**< Block the next submit feeds (producer) */
+    drift_step_t step;          /**< Thresholds in fixed point */
+    drift_update_fn_t update_fn; /**< Update kernel variant */
+
+    /* Statistics, guarded by lock */
+    pthread_mutex_t lock;
+    int32_t *mean;              /**< Per-pixel mean, Q4 */
+    int32_t *var;               /**< Per-pixel variance, Q8 */
+    uint16_t *baseline;         /**< Per-pixel baseline mean (counts) */
+    uint8_t *flags;             /**< Per-pixel DRIFT_FLAG_* */
+    uint32_t *samples;          /**< Per-block samples folded in */
+    uint32_t *flagged;          /**< Per-block flagged pixels */
+    uint32_t candidates;        /**< Sum of flagged */
+    uint64_t processed;
+    uint64_t skipped_bright;
+
+    /* Producer counters */
+    atomic_uint_fast64_t submitted;
+    atomic_uint_fast64_t skipped_busy;
+
+    /* Background worker */
+    bool worker_started;
+    pthread_t worker;
+    sem_t wake;                 /**< Posted per queued block and on stop */
+    spsc_queue_t *pending;      /**< Producer to worker (NULL = stop) */
+    spsc_queue_t *free_slots;   /**< Worker to producer */
+    drift_slot_t slots[DRIFT_STAGING_SLOTS];
+};
+
+/* ==========================================================================
+ * Update Kernels
+ * ========================================================================== */
+
+static inline int32_t drift_clamp_dev(int32_t v) {
+    return (v > DRIFT_DEV_MAX) ? DRIFT_DEV_MAX : ((v < -DRIFT_DEV_MAX) ? -DRIFT_DEV_MAX : v);
+}
+
+static uint32_t drift_update_scalar(int32_t *mean, int32_t *var, uint8_t *flags,
+                                    const uint16_t *baseline, const uint16_t *x, size_t n,
+                                    const drift_step_t *step) {
+    uint32_t shift = step->shift;
+    uint32_t flagged = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int32_t xi = (int32_t)x[i] << DRIFT_MEAN_FRAC;
+        int32_t delta = xi - mean[i];
+        int32_t m = mean[i] + (delta >> shift);
+        int32_t prod = drift_clamp_dev(delta) * drift_clamp_dev(xi - m);
+        int32_t v = var[i] + ((prod - var[i]) >> shift);
+
+        mean[i] = m;
+        var[i] = v;
+
+        if (baseline != NULL) {
+            int32_t off = m - ((int32_t)baseline[i] << DRIFT_MEAN_FRAC);
+            uint8_t f = (uint8_t)(((off < 0 ? -off : off) > step->offset_limit) ? DRIFT_FLAG_OFFSET : 0U);
+
+            f |= (uint8_t)((v > step->var_limit) ? DRIFT_FLAG_NOISE : 0U);
+            flags[i] = f;
+            flagged += (f != 0);
+        }
+    }
+
+    return flagged;
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static uint32_t drift_update_neon(int32_t *mean, int32_t *var, uint8_t *flags,
+                                  const uint16_t *baseline, const uint16_t *x, size_t n,
+                                  const drift_step_t *step) {
+    int32x4_t nshift = vdupq_n_s32(-(int32_t)step->shift);   /* vshl by -s: arithmetic >> s */
+    int32x4_t dev_max = vdupq_n_s32(DRIFT_DEV_MAX);
+    int32x4_t dev_min = vdupq_n_s32(-DRIFT_DEV_MAX);
+    int32x4_t offset_limit = vdupq_n_s32(step->offset_limit);
+    int32x4_t var_limit = vdupq_n_s32(step->var_limit);
+    uint32x4_t flag_offset = vdupq_n_u32(DRIFT_FLAG_OFFSET);
+    uint32x4_t flag_noise = vdupq_n_u32(DRIFT_FLAG_NOISE);
+    uint32x4_t count = vdupq_n_u32(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t xi = vreinterpretq_s32_u32(vshll_n_u16(vld1_u16(x + i), DRIFT_MEAN_FRAC));
+        int32x4_t m = vld1q_s32(mean + i);
+        int32x4_t v = vld1q_s32(var + i);
+        int32x4_t delta = vsubq_s32(xi, m);
+
+        m = vaddq_s32(m, vshlq_s32(delta, nshift));
+        int32x4_t d1 = vmaxq_s32(vminq_s32(delta, dev_max), dev_min);
+        int32x4_t d2 = vmaxq_s32(vminq_s32(vsubq_s32(xi, m), dev_max), dev_min);
+        v = vaddq_s32(v, vshlq_s32(vsubq_s32(vmulq_s32(d1, d2), v), nshift));
+        vst1q_s32(mean + i, m);
+        vst1q_s32(var + i, v);
+
+        if (baseline != NULL) {
+            int32x4_t b = vreinterpretq_s32_u32(vshll_n_u16(vld1_u16(baseline + i), DRIFT_MEAN_FRAC));
+            uint32x4_t f = vandq_u32(vcgtq_s32(vabsq_s32(vsubq_s32(m, b)), offset_limit), flag_offset);
+            f = vorrq_u32(f, vandq_u32(vcgtq_s32(v, var_limit), flag_noise));
+
+            uint16x4_t f16 = vmovn_u32(f);
+            uint8x8_t f8 = vmovn_u16(vcombine_u16(f16, f16));
+            uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(f8), 0);
+            memcpy(flags + i, &packed, sizeof(packed));
+            count = vaddq_u32(count, vminq_u32(f, vdupq_n_u32(1)));
+        }
+    }
+
+    uint32_t flagged = vaddvq_u32(count);
+    return flagged + drift_update_scalar(mean + i, var + i, flags ? flags + i : NULL,
+                                         baseline ? baseline + i : NULL, x + i, n - i, step);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static uint32_t drift_update_sse42(int32_t *mean, int32_t *var, uint8_t *flags,
+                                   const uint16_t *baseline, const uint16_t *x, size_t n,
+                                   const drift_step_t *step) {
+    __m128i shift = _mm_cvtsi32_si128((int)step->shift);
+    __m128i dev_max = _mm_set1_epi32(DRIFT_DEV_MAX);
+    __m128i dev_min = _mm_set1_epi32(-DRIFT_DEV_MAX);
+    __m128i offset_limit = _mm_set1_epi32(step->offset_limit);
+    __m128i var_limit = _mm_set1_epi32(step->var_limit);
+    __m128i flag_offset = _mm_set1_epi32(DRIFT_FLAG_OFFSET);
+    __m128i flag_noise = _mm_set1_epi32(DRIFT_FLAG_NOISE);
+    uint32_t flagged = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i xi = _mm_slli_epi32(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(x + i))),
+                                    DRIFT_MEAN_FRAC);
+        __m128i m = _mm_loadu_si128((const __m128i *)(mean + i));
+        __m128i v = _mm_loadu_si128((const __m128i *)(var + i));
+        __m128i delta = _mm_sub_epi32(xi, m);
+
+        m = _mm_add_epi32(m, _mm_sra_epi32(delta, shift));
+        __m128i d1 = _mm_max_epi32(_mm_min_epi32(delta, dev_max), dev_min);
+        __m128i d2 = _mm_max_epi32(_mm_min_epi32(_mm_sub_epi32(xi, m), dev_max), dev_min);
+        v = _mm_add_epi32(v, _mm_sra_epi32(_mm_sub_epi32(_mm_mullo_epi32(d1, d2), v), shift));
+        _mm_storeu_si128((__m128i *)(mean + i), m);
+        _mm_storeu_si128((__m128i *)(var + i), v);
+
+        if (baseline != NULL) {
+            __m128i b = _mm_slli_epi32(
+                _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(baseline + i))), DRIFT_MEAN_FRAC);
+            __m128i f = _mm_and_si128(_mm_cmpgt_epi32(_mm_abs_epi32(_mm_sub_epi32(m, b)), offset_limit),
+                                      flag_offset);
+            f = _mm_or_si128(f, _mm_and_si128(_mm_cmpgt_epi32(v, var_limit), flag_noise));
+
+            __m128i f8 = _mm_packus_epi16(_mm_packus_epi32(f, f), f);
+            uint32_t packed = (uint32_t)_mm_cvtsi128_si32(f8);
+            memcpy(flags + i, &packed, sizeof(packed));
+            flagged += (uint32_t)__builtin_popcount(
+                (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(f, _mm_setzero_si128()))));
+        }
+    }
+
+    return flagged + drift_update_scalar(mean + i, var + i, flags ? flags + i : NULL,
+                                         baseline ? baseline + i : NULL, x + i, n - i, step);
+}
+
+CPU_TARGET_AVX2
+static uint32_t drift_update_avx2(int32_t *mean, int32_t *var, uint8_t *flags,
+                                  const uint16_t *baseline, const uint16_t *x, size_t n,
+                                  const drift_step_t *step) {
+    __m128i shift = _mm_cvtsi32_si128((int)step->shift);
+    __m256i dev_max = _mm256_set1_epi32(DRIFT_DEV_MAX);
+    __m256i dev_min = _mm256_set1_epi32(-DRIFT_DEV_MAX);
+    __m256i offset_limit = _mm256_set1_epi32(step->offset_limit);
+    __m256i var_limit = _mm256_set1_epi32(step->var_limit);
+    __m256i flag_offset = _mm256_set1_epi32(DRIFT_FLAG_OFFSET);
+    __m256i flag_noise = _mm256_set1_epi32(DRIFT_FLAG_NOISE);
+    uint32_t flagged = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i xi = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(x + i))),
+                                       DRIFT_MEAN_FRAC);
+        __m256i m = _mm256_loadu_si256((const __m256i *)(mean + i));
+        __m256i v = _mm256_loadu_si256((const __m256i *)(var + i));
+        __m256i delta = _mm256_sub_epi32(xi, m);
+
+        m = _mm256_add_epi32(m, _mm256_sra_epi32(delta, shift));
+        __m256i d1 = _mm256_max_epi32(_mm256_min_epi32(delta, dev_max), dev_min);
+        __m256i d2 = _mm256_max_epi32(_mm256_min_epi32(_mm256_sub_epi32(xi, m), dev_max), dev_min);
+        v = _mm256_add_epi32(v, _mm256_sra_epi32(_mm256_sub_epi32(_mm256_mullo_epi32(d1, d2), v),
+                                                 shift));
+        _mm256_storeu_si256((__m256i *)(mean + i), m);
+        _mm256_storeu_si256((__m256i *)(var + i), v);
+
+        if (baseline != NULL) {
+            __m256i b = _mm256_slli_epi32(
+                _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(baseline + i))),
+                DRIFT_MEAN_FRAC);
+            __m256i f = _mm256_and_si256(
+                _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(m, b)), offset_limit), flag_offset);
+            f = _mm256_or_si256(f, _mm256_and_si256(_mm256_cmpgt_epi32(v, var_limit), flag_noise));
+
+            /* Lanes 0-3 and 4-7 to 8 bytes in pixel order */
+            __m128i f16 = _mm_packus_epi32(_mm256_castsi256_si128(f), _mm256_extracti128_si256(f, 1));
+            _mm_storel_epi64((__m128i *)(flags + i), _mm_packus_epi16(f16, f16));
+            flagged += (uint32_t)__builtin_popcount((unsigned)_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpgt_epi32(f, _mm256_setzero_si256()))));
+        }
+    }
+
+    return flagged + drift_update_scalar(mean + i, var + i, flags ? flags + i : NULL,
+                                         baseline ? baseline + i : NULL, x + i, n - i, step);
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define DRIFT_CHECK_PIXELS  517     /* Odd length exercises the tail */
+
+static bool drift_check_update(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t x[DRIFT_CHECK_PIXELS];
+    uint16_t baseline[DRIFT_CHECK_PIXELS];
+    int32_t mean[2][DRIFT_CHECK_PIXELS];
+    int32_t var[2][DRIFT_CHECK_PIXELS];
+    uint8_t flags[2][DRIFT_CHECK_PIXELS];
+    size_t n = DRIFT_CHECK_PIXELS - (seed % 16);
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = (uint16_t)cpu_dispatch_random(&seed);
+        baseline[i] = (uint16_t)cpu_dispatch_random(&seed);
+        mean[0][i] = (int32_t)(cpu_dispatch_random(&seed) >> 12);        /* Q4 of 0..65535 */
+        var[0][i] = (int32_t)(cpu_dispatch_random(&seed) & 0x3FFFFFFFU);
+    }
+    /* Extremes: full-scale jumps in both directions, and a settled pixel */
+    x[0] = 0;
+    mean[0][0] = 65535 << DRIFT_MEAN_FRAC;
+    x[1] = 65535;
+    mean[0][1] = 0;
+    x[2] = (uint16_t)(mean[0][2] >> DRIFT_MEAN_FRAC);
+    var[0][2] = 0;
+    memcpy(mean[1], mean[0], n * sizeof(int32_t));
+    memcpy(var[1], var[0], n * sizeof(int32_t));
+
+    uint32_t noise = cpu_dispatch_random(&seed) % (DRIFT_MAX_NOISE_THRESHOLD + 1);
+    drift_step_t step = {
+        .shift = seed % (DRIFT_MAX_WEIGHT_SHIFT + 1),
+        .offset_limit = (int32_t)((cpu_dispatch_random(&seed) % 4096) << DRIFT_MEAN_FRAC),
+        .var_limit = (int32_t)((noise * noise) << DRIFT_VAR_FRAC)
+    };
+
+    uint32_t got = ((drift_update_fn_t)candidate)(mean[0], var[0], flags[0], baseline, x, n, &step);
+    uint32_t want = ((drift_update_fn_t)reference)(mean[1], var[1], flags[1], baseline, x, n, &step);
+    return got == want &&
+           memcmp(mean[0], mean[1], n * sizeof(int32_t)) == 0 &&
+           memcmp(var[0], var[1], n * sizeof(int32_t)) == 0 &&
+           memcmp(flags[0], flags[1], n) == 0;
+}
+
+static const cpu_variant_t drift_update_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)drift_update_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)drift_update_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)drift_update_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)drift_update_avx2 },
+#endif
+};
+
+const cpu_kernel_t pixel_drift_kernel_update = {
+    .name = "pixel_drift.update",
+    .variants = drift_update_variants,
+    .variant_count = sizeof(drift_update_variants) / sizeof(drift_update_variants[0]),
+    .check = drift_check_update
+};
+
+/* ==========================================================================
+ * Block Processing
+ * ========================================================================== */
+
+static size_t drift_block_pixels(const pixel_drift_t *drift, uint32_t block, size_t *start) {
+    size_t first = (size_t)block * drift->config.pixels_per_frame;
+    size_t n = drift->pixels - first;
+
+    *start = first;
+    return (n < drift->config.pixels_per_frame) ? n : drift->config.pixels_per_frame;
+}
+
+static uint32_t drift_isqrt(uint32_t v) {
+    uint32_t root = 0;
+    uint32_t bit = 1U << 30;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * @brief Fold one block into the statistics
+ */
+static void drift_process_block(pixel_drift_t *drift, uint32_t block, const uint16_t *x) {
+    size_t start;
+    size_t n = drift_block_pixels(drift, block, &start);
+
+    if (drift->config.dark_level != 0) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum += x[i];
+        }
+        if (sum > (uint64_t)drift->config.dark_level * n) {
+            pthread_mutex_lock(&drift->lock);
+            drift->skipped_bright++;
+            pthread_mutex_unlock(&drift->lock);
+            return;
+        }
+    }
+
+    pthread_mutex_lock(&drift->lock);
+
+    uint32_t samples = ++drift->samples[block];
+    uint32_t converged = 1U << drift->config.weight_shift;
+    drift_step_t step = drift->step;
+    bool check = samples > converged;
+
+    step.shift = 0;
+    while (step.shift < drift->config.weight_shift && (2U << step.shift) <= samples) {
+        step.shift++;
+    }
+
+    uint32_t flagged = drift->update_fn(drift->mean + start, drift->var + start,
+                                        check ? drift->flags + start : NULL,
+                                        check ? drift->baseline + start : NULL, x, n, &step);
+
+    if (samples == converged) {
+        for (size_t i = 0; i < n; i++) {
+            int32_t m = (drift->mean[start + i] + (1 << (DRIFT_MEAN_FRAC - 1))) >> DRIFT_MEAN_FRAC;
+            drift->baseline[start + i] = (uint16_t)((m > UINT16_MAX) ? UINT16_MAX : m);
+        }
+    }
+
+    drift->candidates += flagged - drift->flagged[block];
+    drift->flagged[block] = flagged;
+    drift->processed++;
+
+    pthread_mutex_unlock(&drift->lock);
+}
+
+/* ==========================================================================
+ * Background Worker
+ * ========================================================================== */
+
+static void *drift_worker_main(void *arg) {
+    pixel_drift_t *drift = (pixel_drift_t *)arg;
+    struct sched_param param = { .sched_priority = 0 };
+
+    prctl(PR_SET_NAME, "drift", 0, 0, 0);
+    /* Best effort: without SCHED_IDLE the worker still only uses spare slots */
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+    for (;;) {
+        while (sem_wait(&drift->wake) != 0 && errno == EINTR) {
+        }
+
+        void *item;
+        while (spsc_queue_pop(drift->pending, &item)) {
+            if (item == NULL) {
+                return NULL;
+            }
+
+            drift_slot_t *slot = (drift_slot_t *)item;
+            drift_process_block(drift, slot->block, slot->data);
+            spsc_queue_push(drift->free_slots, slot);
+        }
+    }
+}
+
+static int drift_start_worker(pixel_drift_t *drift) {
+    drift->pending = spsc_queue_create(DRIFT_STAGING_SLOTS + 1);     /* + stop marker */
+    drift->free_slots = spsc_queue_create(DRIFT_STAGING_SLOTS);
+    if (drift->pending == NULL || drift->free_slots == NULL) {
+        return -ENOMEM;
+    }
+
+    for (uint32_t s = 0; s < DRIFT_STAGING_SLOTS; s++) {
+        drift->slots[s].data = (uint16_t *)malloc(drift->config.pixels_per_frame * sizeof(uint16_t));
+        if (drift->slots[s].data == NULL) {
+            return -ENOMEM;
+        }
+        spsc_queue_push(drift->free_slots, &drift->slots[s]);
+    }
+
+    if (sem_init(&drift->wake, 0, 0) != 0) {
+        return -errno;
+    }
+    if (pthread_create(&drift->worker, NULL, drift_worker_main, drift) != 0) {
+        sem_destroy(&drift->wake);
+        return -EAGAIN;
+    }
+
+    drift->worker_started = true;
+    return 0;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+pixel_drift_t *pixel_drift_create(const drift_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0) {
+        return NULL;
+    }
+
+    drift_config_t cfg = *config;
+    size_t pixels = (size_t)cfg.width * cfg.height;
+
+    if (cfg.pixels_per_frame == 0) {
+        cfg.pixels_per_frame = DRIFT_DEFAULT_PIXELS_PER_FRAME;
+    }
+    if (cfg.pixels_per_frame > pixels) {
+        cfg.pixels_per_frame = (uint32_t)pixels;
+    }
+    if (cfg.weight_shift == 0) {
+        cfg.weight_shift = DRIFT_DEFAULT_WEIGHT_SHIFT;
+    }
+    if (cfg.offset_threshold == 0) {
+        cfg.offset_threshold = DRIFT_DEFAULT_OFFSET_THRESHOLD;
+    }
+    if (cfg.noise_threshold == 0) {
+        cfg.noise_threshold = DRIFT_DEFAULT_NOISE_THRESHOLD;
+    }
+
+    if (cfg.weight_shift > DRIFT_MAX_WEIGHT_SHIFT ||
+        cfg.noise_threshold > DRIFT_MAX_NOISE_THRESHOLD) {
+        return NULL;
+    }
+
+    pixel_drift_t *drift = (pixel_drift_t *)calloc(1, sizeof(pixel_drift_t));
+    if (drift == NULL) {
+        return NULL;
+    }
+
+    drift->config = cfg;
+    drift->pixels = pixels;
+    drift->block_count = (uint32_t)((pixels + cfg.pixels_per_frame - 1) / cfg.pixels_per_frame);
+    drift->step.offset_limit = (int32_t)cfg.offset_threshold << DRIFT_MEAN_FRAC;
+    drift->step.var_limit = (int32_t)((uint32_t)cfg.noise_threshold * cfg.noise_threshold)
+                            << DRIFT_VAR_FRAC;
+    drift->update_fn = (drift_update_fn_t)cpu_dispatch_select(&pixel_drift_kernel_update, NULL);
+    pthread_mutex_init(&drift->lock, NULL);
+    atomic_init(&drift->submitted, 0);
+    atomic_init(&drift->skipped_busy, 0);
+
+    drift->mean = (int32_t *)calloc(pixels, sizeof(int32_t));
+    drift->var = (int32_t *)calloc(pixels, sizeof(int32_t));
+    drift->baseline = (uint16_t *)calloc(pixels, sizeof(uint16_t));
+    drift->flags = (uint8_t *)calloc(pixels, sizeof(uint8_t));
+    drift->samples = (uint32_t *)calloc(drift->block_count, sizeof(uint32_t));
+    drift->flagged = (uint32_t *)calloc(drift->block_count, sizeof(uint32_t));
+    if (drift->mean == NULL || drift->var == NULL || drift->baseline == NULL ||
+        drift->flags == NULL || drift->samples == NULL || drift->flagged == NULL ||
+        (cfg.background && drift_start_worker(drift) != 0)) {
+        pixel_drift_destroy(drift);
+        return NULL;
+    }
+
+    return drift;
+}
+
+void pixel_drift_destroy(pixel_drift_t *drift) {
+    if (drift == NULL) {
+        return;
+    }
+
+    if (drift->worker_started) {
+        spsc_queue_push(drift->pending, NULL);
+        sem_post(&drift->wake);
+        pthread_join(drift->worker, NULL);
+        sem_destroy(&drift->wake);
+    }
+
+    for (uint32_t s = 0; s < DRIFT_STAGING_SLOTS; s++) {
+        free(drift->slots[s].data);
+    }
+    spsc_queue_destroy(drift->pending);
+    spsc_queue_destroy(drift->free_slots);
+
+    pthread_mutex_destroy(&drift->lock);
+    free(drift->mean);
+    free(drift->var);
+    free(drift->baseline);
+    free(drift->flags);
+    free(drift->samples);
+    free(drift->flagged);
+    free(drift);
+}
+
+drift_status_t pixel_drift_submit(pixel_drift_t *drift, const uint16_t *frame) {
+    if (drift == NULL || frame == NULL) {
+        return DRIFT_ERROR_NULL;
+    }
+
+    uint32_t block = drift->next_block;
+    size_t start;
+    size_t n = drift_block_pixels(drift, block, &start);
+
+    atomic_fetch_add(&drift->submitted, 1);
+
+    if (drift->worker_started) {
+        void *item;
+        if (!spsc_queue_pop(drift->free_slots, &item)) {
+            atomic_fetch_add(&drift->skipped_busy, 1);
+            return DRIFT_BUSY;      /* Same block again next frame */
+        }
+
+        drift_slot_t *slot = (drift_slot_t *)item;
+        slot->block = block;
+        memcpy(slot->data, frame + start, n * sizeof(uint16_t));
+        spsc_queue_push(drift->pending, slot);
+        sem_post(&drift->wake);
+    } else {
+        drift_process_block(drift, block, frame + start);
+    }
+
+    drift->next_block = (block + 1 < drift->block_count) ? block + 1 : 0;
+    return DRIFT_OK;
+}
+
+void pixel_drift_flush(pixel_drift_t *drift) {
+    if (drift == NULL || !drift->worker_started) {
+        return;
+    }
+
+    struct timespec poll = { 0, DRIFT_FLUSH_POLL_NS };
+    while (spsc_queue_depth(drift->free_slots) < DRIFT_STAGING_SLOTS) {
+        nanosleep(&poll, NULL);
+    }
+}
+
+void pixel_drift_reset(pixel_drift_t *drift) {
+    if (drift == NULL) {
+        return;
+    }
+
+    pixel_drift_flush(drift);
+
+    pthread_mutex_lock(&drift->lock);
+    memset(drift->samples, 0, drift->block_count * sizeof(uint32_t));
+    memset(drift->flagged, 0, drift->block_count * sizeof(uint32_t));
+    memset(drift->flags, 0, drift->pixels);
+    drift->candidates = 0;
+    pthread_mutex_unlock(&drift->lock);
+
+    drift->next_block = 0;
+}
+
+size_t pixel_drift_get_candidates(pixel_drift_t *drift, uint32_t start,
+                                  drift_candidate_t *out, size_t max, uint32_t *next) {
+    size_t count = 0;
+    size_t i = start;
+
+    if (drift == NULL || (out == NULL && max > 0)) {
+        if (next != NULL) {
+            *next = start;
+        }
+        return 0;
+    }
+
+    pthread_mutex_lock(&drift->lock);
+
+    while (i < drift->pixels && count < max) {
+        uint32_t block = (uint32_t)(i / drift->config.pixels_per_frame);
+        size_t block_start;
+        size_t block_end = drift_block_pixels(drift, block, &block_start);
+        block_end += block_start;
+
+        if (drift->flagged[block] == 0) {
+            i = block_end;
+            continue;
+        }
+
+        for (; i < block_end && count < max; i++) {
+            if (drift->flags[i] == 0) {
+                continue;
+            }
+
+            drift_candidate_t *c = &out[count++];
+            int32_t m = (drift->mean[i] + (1 << (DRIFT_MEAN_FRAC - 1))) >> DRIFT_MEAN_FRAC;
+            c->x = (uint16_t)(i % drift->config.width);
+            c->y = (uint16_t)(i / drift->config.width);
+            c->mean = (uint16_t)((m > UINT16_MAX) ? UINT16_MAX : m);
+            c->baseline = drift->baseline[i];
+            c->noise = (uint16_t)((drift_isqrt((uint32_t)drift->var[i]) + 8) >> 4);
+            c->flags = drift->flags[i];
+            c->reserved = 0;
+        }
+    }
+
+    pthread_mutex_unlock(&drift->lock);
+
+    if (next != NULL) {
+        *next = (uint32_t)((i < drift->pixels) ? i : drift->pixels);
+    }
+    return count;
+}
+
+void pixel_drift_get_stats(pixel_drift_t *drift, drift_stats_t *stats) {
+    if (drift == NULL || stats == NULL) {
+        return;
+    }
+
+    stats->submitted = atomic_load(&drift->submitted);
+    stats->skipped_busy = atomic_load(&drift->skipped_busy);
+    stats->blocks = drift->block_count;
+
+    pthread_mutex_lock(&drift->lock);
+    stats->processed = drift->processed;
+    stats->skipped_bright = drift->skipped_bright;
+    stats->candidates = drift->candidates;
+    stats->sweeps = UINT32_MAX;
+    for (uint32_t b = 0; b < drift->block_count; b++) {
+        if (drift->samples[b] < stats->sweeps) {
+            stats->sweeps = drift->samples[b];
+        }
+    }
+    pthread_mutex_unlock(&drift->lock);
+}
+
+const char *pixel_drift_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&pixel_drift_kernel_update, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
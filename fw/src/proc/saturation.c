@@ -0,0 +1,417 @@
+/**
+ * @file saturation.c
+ * @brief Per-tile saturation counter for overexposure protection
+ *
+ * Per counted row, each tile-wide span goes through a compare-and-count
+ * kernel (NEON/AVX2/SSE4.2/scalar, chosen by util/cpu_dispatch): lanes at
+ * or above the threshold produce an all-ones mask that is subtracted from
+ * a 16-bit lane counter, which is reduced once per span. Rows are normally
+ * still in L1/L2 from the correction kernel, so the count adds no DRAM
+ * traffic. Where nothing runs between correction and the count, the
+ * correction kernel can count instead (correction_set_count_hook) and
+ * hand its tile counts to saturation_add_counts().
+ *
+ * Marked tiles are tracked incrementally (a tile is marked when its count
+ * crosses its limit), so the trip check is O(1) between bands.
+ */
+
+#include "proc/saturation.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+typedef uint32_t (*sat_count_fn_t)(const uint16_t *px, size_t n, uint16_t threshold);
+
+/**
+ * @brief Saturation counter context
+ */
+struct sat_counter {
+    sat_config_t config;        /**< Configuration with defaults applied */
+    uint32_t tiles_x;           /**< Tile columns */
+    uint32_t tiles_y;           /**< Tile rows */
+    uint32_t *tile_count;       /**< Saturated pixels per tile (current frame) */
+    uint32_t *tile_limit;       /**< Count that marks each tile */
+    uint32_t saturated;         /**< Saturated pixels (current frame) */
+    uint32_t tiles_over;        /**< Marked tiles (current frame) */
+    sat_count_fn_t count_fn;    /**< Count kernel variant */
+    sat_stats_t stats;          /**< Cumulative counters */
+};
+
+/* ==========================================================================
+ * Count Kernels
+ * ========================================================================== */
+
+static uint32_t sat_count_scalar(const uint16_t *px, size_t n, uint16_t threshold) {
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += (px[i] >= threshold);
+    }
+
+    return count;
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static uint32_t sat_count_neon(const uint16_t *px, size_t n, uint16_t threshold) {
+    uint16x8_t thr = vdupq_n_u16(threshold);
+    uint16x8_t acc0 = vdupq_n_u16(0);
+    uint16x8_t acc1 = vdupq_n_u16(0);
+    size_t i = 0;
+
+    /* Mask lanes are 0xFFFF (= -1): subtracting counts them */
+    for (; i + 16 <= n; i += 16) {
+        acc0 = vsubq_u16(acc0, vcgeq_u16(vld1q_u16(px + i), thr));
+        acc1 = vsubq_u16(acc1, vcgeq_u16(vld1q_u16(px + i + 8), thr));
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vsubq_u16(acc0, vcgeq_u16(vld1q_u16(px + i), thr));
+    }
+
+    return vaddlvq_u16(vaddq_u16(acc0, acc1)) + sat_count_scalar(px + i, n - i, threshold);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static uint32_t sat_count_sse42(const uint16_t *px, size_t n, uint16_t threshold) {
+    __m128i thr = _mm_set1_epi16((short)threshold);
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(px + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(px + i + 8));
+        acc0 = _mm_sub_epi16(acc0, _mm_cmpeq_epi16(_mm_max_epu16(v0, thr), v0));
+        acc1 = _mm_sub_epi16(acc1, _mm_cmpeq_epi16(_mm_max_epu16(v1, thr), v1));
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(px + i));
+        acc0 = _mm_sub_epi16(acc0, _mm_cmpeq_epi16(_mm_max_epu16(v, thr), v));
+    }
+
+    uint32_t count = sat_count_scalar(px + i, n - i, threshold);
+
+    __m128i acc = _mm_add_epi16(acc0, acc1);
+    if (_mm_testz_si128(acc, acc)) {
+        return count;
+    }
+
+    __m128i sum = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return count + (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+CPU_TARGET_AVX2
+static uint32_t sat_count_avx2(const uint16_t *px, size_t n, uint16_t threshold) {
+    __m256i thr = _mm256_set1_epi16((short)threshold);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)(px + i));
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)(px + i + 16));
+        /* Unsigned v >= thr  <=>  max(v, thr) == v */
+        acc0 = _mm256_sub_epi16(acc0, _mm256_cmpeq_epi16(_mm256_max_epu16(v0, thr), v0));
+        acc1 = _mm256_sub_epi16(acc1, _mm256_cmpeq_epi16(_mm256_max_epu16(v1, thr), v1));
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(px + i));
+        acc0 = _mm256_sub_epi16(acc0, _mm256_cmpeq_epi16(_mm256_max_epu16(v, thr), v));
+    }
+
+    uint32_t count = sat_count_scalar(px + i, n - i, threshold);
+
+    /* Saturation is rare: skip the horizontal reduction for clean spans */
+    __m256i acc = _mm256_add_epi16(acc0, acc1);
+    if (_mm256_testz_si256(acc, acc)) {
+        return count;
+    }
+
+    /* Lane counts are <= SAT_MAX_TILE_SIZE / 16, safe as signed for madd */
+    __m256i sum32 = _mm256_madd_epi16(acc, _mm256_set1_epi16(1));
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sum32),
+                                _mm256_extracti128_si256(sum32, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return count + (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define SAT_CHECK_PIXELS    1031    /* Odd length exercises the tail */
+
+static bool sat_check_count(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t px[SAT_CHECK_PIXELS];
+    size_t n = SAT_CHECK_PIXELS - (seed % 16);
+    uint16_t threshold = (uint16_t)cpu_dispatch_random(&seed);
+
+    for (size_t i = 0; i < n; i++) {
+        px[i] = (uint16_t)cpu_dispatch_random(&seed);
+    }
+    px[0] = threshold;              /* Equal counts as saturated */
+
+    return ((sat_count_fn_t)candidate)(px, n, threshold) ==
+           ((sat_count_fn_t)reference)(px, n, threshold);
+}
+
+static const cpu_variant_t sat_count_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)sat_count_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)sat_count_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)sat_count_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)sat_count_avx2 },
+#endif
+};
+
+const cpu_kernel_t saturation_kernel_count = {
+    .name = "saturation.count",
+    .variants = sat_count_variants,
+    .variant_count = sizeof(sat_count_variants) / sizeof(sat_count_variants[0]),
+    .check = sat_check_count
+};
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+sat_counter_t *saturation_create(const sat_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0 ||
+        config->tile_size > SAT_MAX_TILE_SIZE ||
+        config->tile_fraction < 0.0f || config->tile_fraction > 1.0f) {
+        return NULL;
+    }
+
+    sat_counter_t *sat = (sat_counter_t *)calloc(1, sizeof(sat_counter_t));
+    if (sat == NULL) {
+        return NULL;
+    }
+
+    sat->config = *config;
+    if (sat->config.threshold == 0) {
+        sat->config.threshold = SAT_DEFAULT_THRESHOLD;
+    }
+    if (sat->config.tile_size == 0) {
+        sat->config.tile_size = SAT_DEFAULT_TILE_SIZE;
+    }
+    if (sat->config.tile_fraction == 0.0f) {
+        sat->config.tile_fraction = SAT_DEFAULT_TILE_FRACTION;
+    }
+    if (sat->config.trip_tiles == 0) {
+        sat->config.trip_tiles = SAT_DEFAULT_TRIP_TILES;
+    }
+
+    sat->count_fn = (sat_count_fn_t)cpu_dispatch_select(&saturation_kernel_count, NULL);
+
+    uint32_t tile = sat->config.tile_size;
+    sat->tiles_x = (config->width + tile - 1) / tile;
+    sat->tiles_y = (config->height + tile - 1) / tile;
+
+    size_t tiles = (size_t)sat->tiles_x * sat->tiles_y;
+    sat->tile_count = (uint32_t *)calloc(tiles, sizeof(uint32_t));
+    sat->tile_limit = (uint32_t *)calloc(tiles, sizeof(uint32_t));
+    if (sat->tile_count == NULL || sat->tile_limit == NULL) {
+        saturation_destroy(sat);
+        return NULL;
+    }
+
+    /* Edge tiles are clipped: scale their limit to the pixels they cover */
+    for (uint32_t ty = 0; ty < sat->tiles_y; ty++) {
+        uint32_t th = config->height - ty * tile;
+        th = (th < tile) ? th : tile;
+
+        for (uint32_t tx = 0; tx < sat->tiles_x; tx++) {
+            uint32_t tw = config->width - tx * tile;
+            tw = (tw < tile) ? tw : tile;
+
+            float limit = sat->config.tile_fraction * (float)(tw * th);
+            uint32_t count = (uint32_t)limit;
+            count += ((float)count < limit) ? 1 : 0;
+            sat->tile_limit[ty * sat->tiles_x + tx] = (count > 0) ? count : 1;
+        }
+    }
+
+    return sat;
+}
+
+void saturation_destroy(sat_counter_t *sat) {
+    if (sat == NULL) {
+        return;
+    }
+
+    free(sat->tile_count);
+    free(sat->tile_limit);
+    free(sat);
+}
+
+void saturation_begin_frame(sat_counter_t *sat) {
+    if (sat == NULL) {
+        return;
+    }
+
+    memset(sat->tile_count, 0, (size_t)sat->tiles_x * sat->tiles_y * sizeof(uint32_t));
+    sat->saturated = 0;
+    sat->tiles_over = 0;
+}
+
+/**
+ * @brief Add saturated pixels to a tile, marking it when it crosses its limit
+ */
+static void sat_add_tile(sat_counter_t *sat, uint32_t idx, uint32_t count) {
+    uint32_t before = sat->tile_count[idx];
+    sat->tile_count[idx] = before + count;
+    sat->saturated += count;
+
+    if (before < sat->tile_limit[idx] && before + count >= sat->tile_limit[idx]) {
+        sat->tiles_over++;
+    }
+}
+
+sat_status_t saturation_count_rows(sat_counter_t *sat, const uint16_t *frame,
+                                   uint32_t row_start, uint32_t row_count) {
+    if (sat == NULL || frame == NULL) {
+        return SAT_ERROR_NULL;
+    }
+
+    uint32_t width = sat->config.width;
+    uint32_t height = sat->config.height;
+    if (row_start >= height || row_count > height - row_start) {
+        return SAT_ERROR_PARAM;
+    }
+
+    uint32_t tile = sat->config.tile_size;
+    uint16_t threshold = sat->config.threshold;
+
+    for (uint32_t y = row_start; y < row_start + row_count; y++) {
+        const uint16_t *row = frame + (size_t)y * width;
+        uint32_t base = (y / tile) * sat->tiles_x;
+
+        for (uint32_t tx = 0, x = 0; tx < sat->tiles_x; tx++, x += tile) {
+            uint32_t n = (width - x < tile) ? width - x : tile;
+            uint32_t count = sat->count_fn(row + x, n, threshold);
+            if (count == 0) {
+                continue;
+            }
+
+            sat_add_tile(sat, base + tx, count);
+        }
+    }
+
+    return SAT_OK;
+}
+
+sat_status_t saturation_add_counts(sat_counter_t *sat, uint32_t row_start, uint32_t row_count,
+                                   const uint32_t *counts) {
+    if (sat == NULL || counts == NULL) {
+        return SAT_ERROR_NULL;
+    }
+
+    uint32_t tile = sat->config.tile_size;
+    if (row_count == 0 || row_start >= sat->config.height ||
+        row_count > sat->config.height - row_start ||
+        row_start / tile != (row_start + row_count - 1) / tile) {
+        return SAT_ERROR_PARAM;
+    }
+
+    uint32_t base = (row_start / tile) * sat->tiles_x;
+    for (uint32_t tx = 0; tx < sat->tiles_x; tx++) {
+        if (counts[tx] != 0) {
+            sat_add_tile(sat, base + tx, counts[tx]);
+        }
+    }
+
+    return SAT_OK;
+}
+
+bool saturation_tripped(const sat_counter_t *sat) {
+    return sat != NULL && sat->tiles_over >= sat->config.trip_tiles;
+}
+
+sat_status_t saturation_get_frame(const sat_counter_t *sat, sat_frame_t *result) {
+    if (sat == NULL || result == NULL) {
+        return SAT_ERROR_NULL;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->saturated = sat->saturated;
+    result->tiles_over = sat->tiles_over;
+    result->tripped = saturation_tripped(sat);
+
+    if (sat->saturated > 0) {
+        size_t tiles = (size_t)sat->tiles_x * sat->tiles_y;
+        for (size_t i = 0; i < tiles; i++) {
+            if (sat->tile_count[i] > result->worst_count) {
+                result->worst_count = sat->tile_count[i];
+                result->worst_tile = (uint32_t)i;
+            }
+        }
+    }
+
+    return SAT_OK;
+}
+
+sat_status_t saturation_end_frame(sat_counter_t *sat, sat_frame_t *result) {
+    if (sat == NULL) {
+        return SAT_ERROR_NULL;
+    }
+
+    sat->stats.frames++;
+    sat->stats.saturated_pixels += sat->saturated;
+    sat->stats.last_tiles_over = sat->tiles_over;
+    if (sat->saturated > 0) {
+        sat->stats.frames_saturated++;
+    }
+    if (saturation_tripped(sat)) {
+        sat->stats.frames_tripped++;
+    }
+    if (sat->tiles_over > sat->stats.max_tiles_over) {
+        sat->stats.max_tiles_over = sat->tiles_over;
+    }
+
+    return (result != NULL) ? saturation_get_frame(sat, result) : SAT_OK;
+}
+
+const uint32_t *saturation_get_tiles(const sat_counter_t *sat,
+                                     uint32_t *tiles_x, uint32_t *tiles_y) {
+    if (sat == NULL) {
+        return NULL;
+    }
+
+    if (tiles_x != NULL) {
+        *tiles_x = sat->tiles_x;
+    }
+    if (tiles_y != NULL) {
+        *tiles_y = sat->tiles_y;
+    }
+
+    return sat->tile_count;
+}
+
+void saturation_get_stats(const sat_counter_t *sat, sat_stats_t *stats) {
+    if (sat == NULL || stats == NULL) {
+        return;
+    }
+
+    *stats = sat->stats;
+}
+
+const char *saturation_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&saturation_kernel_count, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
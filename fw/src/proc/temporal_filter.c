@@ -0,0 +1,446 @@
+/**
+ * @file temporal_filter.c
+ * @brief Motion-adaptive recursive temporal noise filter
+ *
+ * Per pixel, with s the Q(16.TF_STATE_FRAC_BITS) state and x the new value:
+ *
+ *   prev  = round(s)
+ *   a     = |x - prev| > motion_threshold ? motion_alpha : alpha
+ *   s    += round((x << F - s) * a / 256)
+ *   x     = round(s)
+ *
+ * Kernel variants (selected at create time, see util/cpu_dispatch.h):
+ * - AArch64 NEON: 8 pixels per step (vabdq for the motion test)
+ * - x86 AVX2: 16 pixels per step
+ * - x86 SSE4.2: 8 pixels per step
+ * - Scalar for other targets and row tails
+ *
+ * All kernels use the same integer arithmetic (arithmetic shift with
+ * round half up), so output and state are bit-identical across targets.
+ * The update moves s towards x << F without overshoot, so s stays within
+ * [0, 65535 << F] and the rounded output never exceeds 16 bits.
+ */
+
+#include "proc/temporal_filter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+#define TF_ALIGNMENT    64
+#define TF_STATE_HALF   (1 << (TF_STATE_FRAC_BITS - 1))
+#define TF_ALPHA_SHIFT  8
+
+typedef uint32_t (*tf_row_fn_t)(uint16_t *px, uint32_t *state, size_t n, int32_t alpha,
+                                int32_t motion_alpha, uint32_t threshold);
+
+/**
+ * @brief Temporal filter internal state
+ */
+struct tf_filter {
+    tf_config_t config;         /**< Geometry */
+    tf_params_t active;         /**< Parameters in use */
+    tf_params_t staged;         /**< Parameters for the next reset */
+    pthread_mutex_t lock;       /**< Guards staged */
+    uint32_t *state;            /**< Fixed-point filter state (width * height) */
+    tf_row_fn_t row_fn;         /**< Row kernel variant */
+    bool primed;                /**< State holds a previous frame */
+    bool seeding;               /**< Current frame seeds the state */
+    uint32_t frame_motion;      /**< Motion pixels in the current frame */
+    tf_stats_t stats;           /**< Statistics */
+};
+
+/* ==========================================================================
+ * Row Kernels
+ * ========================================================================== */
+
+static uint32_t tf_row_scalar(uint16_t *px, uint32_t *state, size_t n, int32_t alpha,
+                              int32_t motion_alpha, uint32_t threshold) {
+    uint32_t motion = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int32_t s = (int32_t)state[i];
+        uint32_t x = px[i];
+        uint32_t prev = (uint32_t)(s + TF_STATE_HALF) >> TF_STATE_FRAC_BITS;
+        uint32_t diff = (x > prev) ? x - prev : prev - x;
+
+        int32_t a = alpha;
+        if (diff > threshold) {
+            a = motion_alpha;
+            motion++;
+        }
+
+        int32_t d = (int32_t)(x << TF_STATE_FRAC_BITS) - s;
+        s += (d * a + (1 << (TF_ALPHA_SHIFT - 1))) >> TF_ALPHA_SHIFT;
+
+        state[i] = (uint32_t)s;
+        px[i] = (uint16_t)((uint32_t)(s + TF_STATE_HALF) >> TF_STATE_FRAC_BITS);
+    }
+
+    return motion;
+}
+
+#if defined(CPU_DISPATCH_NEON)
+
+static inline uint32x4_t tf_step_neon(uint32x4_t x, uint32_t *state, int32x4_t va,
+                                      int32x4_t vm, uint32x4_t vthr, uint32x4_t *motion) {
+    int32x4_t s = vreinterpretq_s32_u32(vld1q_u32(state));
+    uint32x4_t prev = vrshrq_n_u32(vreinterpretq_u32_s32(s), TF_STATE_FRAC_BITS);
+    uint32x4_t moving = vcgtq_u32(vabdq_u32(x, prev), vthr);
+    int32x4_t a = vbslq_s32(moving, vm, va);
+
+    int32x4_t d = vsubq_s32(vreinterpretq_s32_u32(vshlq_n_u32(x, TF_STATE_FRAC_BITS)), s);
+    s = vaddq_s32(s, vrshrq_n_s32(vmulq_s32(d, a), TF_ALPHA_SHIFT));
+    vst1q_u32(state, vreinterpretq_u32_s32(s));
+
+    *motion = vsubq_u32(*motion, moving);
+    return vrshrq_n_u32(vreinterpretq_u32_s32(s), TF_STATE_FRAC_BITS);
+}
+
+static uint32_t tf_row_neon(uint16_t *px, uint32_t *state, size_t n, int32_t alpha,
+                            int32_t motion_alpha, uint32_t threshold) {
+    int32x4_t va = vdupq_n_s32(alpha);
+    int32x4_t vm = vdupq_n_s32(motion_alpha);
+    uint32x4_t vthr = vdupq_n_u32(threshold);
+    uint32x4_t motion = vdupq_n_u32(0);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t x = vld1q_u16(px + i);
+        uint32x4_t lo = tf_step_neon(vmovl_u16(vget_low_u16(x)), state + i, va, vm, vthr, &motion);
+        uint32x4_t hi = tf_step_neon(vmovl_high_u16(x), state + i + 4, va, vm, vthr, &motion);
+        vst1q_u16(px + i, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+    }
+
+    return vaddvq_u32(motion) +
+           tf_row_scalar(px + i, state + i, n - i, alpha, motion_alpha, threshold);
+}
+
+#elif defined(CPU_DISPATCH_X86)
+
+CPU_TARGET_SSE42
+static inline __m128i tf_step_sse42(__m128i x, uint32_t *state, __m128i va, __m128i vm,
+                                    __m128i vthr, uint32_t *motion) {
+    const __m128i half = _mm_set1_epi32(TF_STATE_HALF);
+    const __m128i round = _mm_set1_epi32(1 << (TF_ALPHA_SHIFT - 1));
+
+    __m128i s = _mm_loadu_si128((const __m128i *)state);
+    __m128i prev = _mm_srli_epi32(_mm_add_epi32(s, half), TF_STATE_FRAC_BITS);
+    __m128i moving = _mm_cmpgt_epi32(_mm_abs_epi32(_mm_sub_epi32(x, prev)), vthr);
+    __m128i a = _mm_blendv_epi8(va, vm, moving);
+
+    __m128i d = _mm_sub_epi32(_mm_slli_epi32(x, TF_STATE_FRAC_BITS), s);
+    __m128i step = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(d, a), round),
+                                  TF_ALPHA_SHIFT);
+    s = _mm_add_epi32(s, step);
+    _mm_storeu_si128((__m128i *)state, s);
+
+    *motion += (uint32_t)__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(moving)));
+    return _mm_srli_epi32(_mm_add_epi32(s, half), TF_STATE_FRAC_BITS);
+}
+
+CPU_TARGET_SSE42
+static uint32_t tf_row_sse42(uint16_t *px, uint32_t *state, size_t n, int32_t alpha,
+                             int32_t motion_alpha, uint32_t threshold) {
+    __m128i va = _mm_set1_epi32(alpha);
+    __m128i vm = _mm_set1_epi32(motion_alpha);
+    __m128i vthr = _mm_set1_epi32((int32_t)threshold);
+    uint32_t motion = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(px + i));
+        __m128i lo = tf_step_sse42(_mm_cvtepu16_epi32(x), state + i, va, vm, vthr, &motion);
+        __m128i hi = tf_step_sse42(_mm_cvtepu16_epi32(_mm_srli_si128(x, 8)),
+                                   state + i + 4, va, vm, vthr, &motion);
+        _mm_storeu_si128((__m128i *)(px + i), _mm_packus_epi32(lo, hi));
+    }
+
+    return motion + tf_row_scalar(px + i, state + i, n - i, alpha, motion_alpha, threshold);
+}
+
+CPU_TARGET_AVX2
+static inline __m256i tf_step_avx2(__m256i x, uint32_t *state, __m256i va, __m256i vm,
+                                   __m256i vthr, uint32_t *motion) {
+    const __m256i half = _mm256_set1_epi32(TF_STATE_HALF);
+    const __m256i round = _mm256_set1_epi32(1 << (TF_ALPHA_SHIFT - 1));
+
+    __m256i s = _mm256_loadu_si256((const __m256i *)state);
+    __m256i prev = _mm256_srli_epi32(_mm256_add_epi32(s, half), TF_STATE_FRAC_BITS);
+    __m256i moving = _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(x, prev)), vthr);
+    __m256i a = _mm256_blendv_epi8(va, vm, moving);
+
+    __m256i d = _mm256_sub_epi32(_mm256_slli_epi32(x, TF_STATE_FRAC_BITS), s);
+    __m256i step = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(d, a), round),
+                                     TF_ALPHA_SHIFT);
+    s = _mm256_add_epi32(s, step);
+    _mm256_storeu_si256((__m256i *)state, s);
+
+    *motion += (uint32_t)__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(moving)));
+    return _mm256_srli_epi32(_mm256_add_epi32(s, half), TF_STATE_FRAC_BITS);
+}
+
+CPU_TARGET_AVX2
+static uint32_t tf_row_avx2(uint16_t *px, uint32_t *state, size_t n, int32_t alpha,
+                            int32_t motion_alpha, uint32_t threshold) {
+    __m256i va = _mm256_set1_epi32(alpha);
+    __m256i vm = _mm256_set1_epi32(motion_alpha);
+    __m256i vthr = _mm256_set1_epi32((int32_t)threshold);
+    uint32_t motion = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(px + i));
+        __m256i lo = tf_step_avx2(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(x)),
+                                  state + i, va, vm, vthr, &motion);
+        __m256i hi = tf_step_avx2(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(x, 1)),
+                                  state + i + 8, va, vm, vthr, &motion);
+        /* packus interleaves 128-bit lanes: restore pixel order */
+        __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256((__m256i *)(px + i), out);
+    }
+
+    return motion + tf_row_scalar(px + i, state + i, n - i, alpha, motion_alpha, threshold);
+}
+
+#endif
+
+/* ==========================================================================
+ * Kernel Dispatch
+ * ========================================================================== */
+
+#define TF_CHECK_PIXELS 1031        /* Odd length exercises the row tail */
+
+static bool tf_check_row(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    uint16_t px_a[TF_CHECK_PIXELS], px_b[TF_CHECK_PIXELS];
+    uint32_t state_a[TF_CHECK_PIXELS], state_b[TF_CHECK_PIXELS];
+    size_t n = TF_CHECK_PIXELS - (seed % 16);
+    int32_t alpha = 1 + (int32_t)(cpu_dispatch_random(&seed) % TF_ALPHA_ONE);
+    int32_t motion_alpha = alpha + (int32_t)(cpu_dispatch_random(&seed) % (TF_ALPHA_ONE - alpha + 1));
+    uint32_t threshold = cpu_dispatch_random(&seed) % 2048;
+
+    /* Half still (small noise), half moving; state within [0, 65535 << F] */
+    for (size_t i = 0; i < n; i++) {
+        uint32_t prev = cpu_dispatch_random(&seed) >> 16;
+        uint32_t r = cpu_dispatch_random(&seed);
+        uint32_t x = (i & 1) ? (r >> 16) : (prev + (r & 0xFF)) & 0xFFFF;
+        uint32_t frac = (prev < 0xFFFF) ? (r >> 8) & ((1U << TF_STATE_FRAC_BITS) - 1) : 0;
+
+        px_a[i] = px_b[i] = (uint16_t)x;
+        state_a[i] = state_b[i] = (prev << TF_STATE_FRAC_BITS) | frac;
+    }
+
+    uint32_t motion_a = ((tf_row_fn_t)candidate)(px_a, state_a, n, alpha, motion_alpha, threshold);
+    uint32_t motion_b = ((tf_row_fn_t)reference)(px_b, state_b, n, alpha, motion_alpha, threshold);
+
+    return motion_a == motion_b &&
+           memcmp(px_a, px_b, n * sizeof(uint16_t)) == 0 &&
+           memcmp(state_a, state_b, n * sizeof(uint32_t)) == 0;
+}
+
+static const cpu_variant_t tf_row_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)tf_row_scalar },
+#if defined(CPU_DISPATCH_NEON)
+    { CPU_ISA_NEON, (cpu_fn_t)tf_row_neon },
+#elif defined(CPU_DISPATCH_X86)
+    { CPU_ISA_SSE42, (cpu_fn_t)tf_row_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)tf_row_avx2 },
+#endif
+};
+
+const cpu_kernel_t temporal_filter_kernel_row = {
+    .name = "temporal_filter.row",
+    .variants = tf_row_variants,
+    .variant_count = sizeof(tf_row_variants) / sizeof(tf_row_variants[0]),
+    .check = tf_check_row
+};
+
+/* ==========================================================================
+ * Internal Helpers
+ * ========================================================================== */
+
+static bool tf_params_valid(const tf_params_t *params) {
+    return params->alpha >= 1 && params->alpha <= TF_ALPHA_ONE &&
+           params->motion_alpha >= params->alpha && params->motion_alpha <= TF_ALPHA_ONE;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+void temporal_filter_params_defaults(tf_params_t *params) {
+    if (params == NULL) {
+        return;
+    }
+
+    memset(params, 0, sizeof(*params));
+    params->enabled = 1;
+    params->alpha = TF_DEFAULT_ALPHA;
+    params->motion_alpha = TF_DEFAULT_MOTION_ALPHA;
+    params->motion_threshold = TF_DEFAULT_MOTION_THRESHOLD;
+}
+
+tf_filter_t *temporal_filter_create(const tf_config_t *config) {
+    if (config == NULL || config->width == 0 || config->height == 0 ||
+        !tf_params_valid(&config->params)) {
+        return NULL;
+    }
+
+    tf_filter_t *tf = (tf_filter_t *)calloc(1, sizeof(tf_filter_t));
+    if (tf == NULL) {
+        return NULL;
+    }
+
+    tf->config = *config;
+    tf->active = config->params;
+    tf->staged = config->params;
+    tf->row_fn = (tf_row_fn_t)cpu_dispatch_select(&temporal_filter_kernel_row, NULL);
+
+    /* aligned_alloc requires size to be a multiple of the alignment */
+    size_t bytes = (size_t)config->width * config->height * sizeof(uint32_t);
+    bytes = (bytes + TF_ALIGNMENT - 1) & ~(size_t)(TF_ALIGNMENT - 1);
+
+    tf->state = (uint32_t *)aligned_alloc(TF_ALIGNMENT, bytes);
+    if (tf->state == NULL) {
+        free(tf);
+        return NULL;
+    }
+
+    pthread_mutex_init(&tf->lock, NULL);
+
+    return tf;
+}
+
+void temporal_filter_destroy(tf_filter_t *tf) {
+    if (tf == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&tf->lock);
+    free(tf->state);
+    free(tf);
+}
+
+tf_status_t temporal_filter_set_params(tf_filter_t *tf, const tf_params_t *params) {
+    if (tf == NULL || params == NULL) {
+        return TF_ERROR_NULL;
+    }
+
+    if (!tf_params_valid(params)) {
+        return TF_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&tf->lock);
+    tf->staged = *params;
+    pthread_mutex_unlock(&tf->lock);
+
+    return TF_OK;
+}
+
+void temporal_filter_reset(tf_filter_t *tf) {
+    if (tf == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&tf->lock);
+    tf->active = tf->staged;
+    pthread_mutex_unlock(&tf->lock);
+
+    tf->primed = false;
+    tf->seeding = false;
+    tf->stats.resets++;
+}
+
+bool temporal_filter_enabled(const tf_filter_t *tf) {
+    return tf != NULL && tf->active.enabled != 0;
+}
+
+void temporal_filter_begin_frame(tf_filter_t *tf) {
+    if (tf == NULL) {
+        return;
+    }
+
+    tf->seeding = !tf->primed;
+    tf->frame_motion = 0;
+}
+
+tf_status_t temporal_filter_apply_rows(tf_filter_t *tf, uint16_t *frame,
+                                       uint32_t row_start, uint32_t row_count) {
+    if (tf == NULL || frame == NULL) {
+        return TF_ERROR_NULL;
+    }
+
+    uint32_t width = tf->config.width;
+    if (row_start >= tf->config.height || row_count > tf->config.height - row_start) {
+        return TF_ERROR_PARAM;
+    }
+
+    if (!tf->active.enabled) {
+        return TF_OK;
+    }
+
+    size_t offset = (size_t)row_start * width;
+    size_t n = (size_t)row_count * width;
+    uint16_t *px = frame + offset;
+    uint32_t *state = tf->state + offset;
+
+    if (tf->seeding) {
+        for (size_t i = 0; i < n; i++) {
+            state[i] = (uint32_t)px[i] << TF_STATE_FRAC_BITS;
+        }
+        return TF_OK;
+    }
+
+    /* Rows are contiguous, so a band is one long span */
+    tf->frame_motion += tf->row_fn(px, state, n, tf->active.alpha, tf->active.motion_alpha,
+                               tf->active.motion_threshold);
+
+    return TF_OK;
+}
+
+tf_status_t temporal_filter_apply_frame(tf_filter_t *tf, uint16_t *frame) {
+    if (tf == NULL) {
+        return TF_ERROR_NULL;
+    }
+
+    temporal_filter_begin_frame(tf);
+    tf_status_t rc = temporal_filter_apply_rows(tf, frame, 0, tf->config.height);
+    temporal_filter_end_frame(tf);
+
+    return rc;
+}
+
+void temporal_filter_end_frame(tf_filter_t *tf) {
+    if (tf == NULL || !tf->active.enabled) {
+        return;
+    }
+
+    if (tf->seeding) {
+        tf->primed = true;
+        tf->seeding = false;
+        return;
+    }
+
+    tf->stats.frames++;
+    tf->stats.last_motion = tf->frame_motion;
+    tf->stats.motion_pixels += tf->frame_motion;
+}
+
+void temporal_filter_get_stats(const tf_filter_t *tf, tf_stats_t *stats) {
+    if (tf == NULL || stats == NULL) {
+        return;
+    }
+
+    *stats = tf->stats;
+}
+
+const char *temporal_filter_get_kernel_name(void) {
+    cpu_isa_t isa;
+    cpu_dispatch_select(&temporal_filter_kernel_row, &isa);
+    return cpu_dispatch_isa_name(isa);
+}
@@ -15,6 +15,7 @@
 #include "protocol/command_protocol.h"
 #include "sequence_engine.h"
 #include "health_monitor.h"
+#include "util/trace.h"
 #include <errno.h>
 #include <string.h>
 #include <stdlib.h>
@@ -30,6 +31,22 @@ static cmd_protocol_ctx_t cmd_ctx = {
     .initialized = false
 };
 
+/* Extended config handler registry */
+static struct {
+    uint8_t config_id;
+    cmd_config_handler_t handler;
+    void *user_data;
+} config_handlers[CMD_CONFIG_MAX_HANDLERS];
+static size_t config_handler_count = 0;
+
+/* CMD_GET_DATA handler registry */
+static struct {
+    uint8_t data_id;
+    cmd_data_handler_t handler;
+    void *user_data;
+} data_handlers[CMD_DATA_MAX_HANDLERS];
+static size_t data_handler_count = 0;
+
 /* Minimum frame sizes */
 #define MIN_COMMAND_FRAME_SIZE  (sizeof(command_frame_t))
 #define MIN_RESPONSE_FRAME_SIZE (sizeof(response_frame_t))
@@ -91,6 +108,52 @@ static int validate_command_frame(const command_frame_t *cmd) {
     return 0;
 }
 
+/**
+ * @brief Dispatch extended CMD_SET_CONFIG payload
+ *
+ * @return 0 on success, -errno on failure
+ */
+static int dispatch_config_ext(const uint8_t *buf, size_t len) {
+    if (len < sizeof(cmd_config_ext_t)) {
+        return -EMSGSIZE;
+    }
+
+    const cmd_config_ext_t *ext = (const cmd_config_ext_t *)buf;
+    if (ext->data_len > len - sizeof(cmd_config_ext_t)) {
+        return -EMSGSIZE;
+    }
+
+    for (size_t i = 0; i < config_handler_count; i++) {
+        if (config_handlers[i].config_id == ext->config_id) {
+            return config_handlers[i].handler(ext->flags, ext->data, ext->data_len,
+                                              config_handlers[i].user_data);
+        }
+    }
+
+    return -ENOENT;
+}
+
+/**
+ * @brief Dispatch CMD_GET_DATA payload
+ *
+ * @return Bytes written to out, or -errno on failure
+ */
+static int dispatch_data(const uint8_t *buf, size_t len, uint8_t *out, size_t cap) {
+    if (len < 1) {
+        return -EMSGSIZE;
+    }
+
+    for (size_t i = 0; i < data_handler_count; i++) {
+        if (data_handlers[i].data_id == buf[0]) {
+            int rc = data_handlers[i].handler(buf + 1, len - 1, out, cap,
+                                              data_handlers[i].user_data);
+            return (rc > (int)cap) ? -EOVERFLOW : rc;
+        }
+    }
+
+    return -ENOENT;
+}
+
 /**
  * @brief Calculate HMAC-SHA256 for response frame
  *
@@ -395,9 +458,10 @@ int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *re
 
     /* Handle based on command ID */
     uint16_t status = STATUS_OK;
-    uint8_t payload[256];
+    uint8_t payload[CMD_MAX_RESPONSE_PAYLOAD];
     size_t payload_len = 0;
 
+    TRACE_BEGIN(TRACE_CMD, cmd->command_id, cmd->sequence);
     switch (cmd->command_id) {
         case CMD_START_SCAN: {
             /* Start scan sequence */
@@ -414,6 +478,24 @@ int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *re
                 }
             }
 
+            /* Calibration: payload[1] = phase (0=dark, 1=flood),
+             * payload[2..3] = frames to average (little-endian, optional) */
+            if (mode == SCAN_MODE_CALIBRATION) {
+                seq_calib_params_t calib = { SEQ_CALIB_DARK, 0 };
+                if (cmd->payload_len >= 2) {
+                    calib.phase = (seq_calib_phase_t)cmd->payload[1];
+                }
+                if (cmd->payload_len >= 4) {
+                    memcpy(&calib.frames, &cmd->payload[2], sizeof(uint16_t));
+                }
+
+                int rc = seq_set_calibration(&calib);
+                if (rc != 0) {
+                    status = (rc == -EBUSY) ? STATUS_BUSY : STATUS_ERROR;
+                    break;
+                }
+            }
+
             int rc = seq_start_scan(mode);
             if (rc != 0) {
                 status = (rc == -EBUSY) ? STATUS_BUSY : STATUS_ERROR;
@@ -431,32 +513,73 @@ int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *re
         }
 
         case CMD_GET_STATUS: {
-            /* Get status */
-            seq_stats_t seq_stats;
-            memset(payload, 0, sizeof(payload));
-
-            /* Get sequence engine state and statistics */
-            payload[0] = (uint8_t)seq_get_state();
-
-            if (seq_get_stats(&seq_stats) == 0) {
-                /* Pack statistics into payload (little-endian) */
-                memcpy(&payload[1], &seq_stats.frames_received, sizeof(uint32_t));
-                memcpy(&payload[5], &seq_stats.frames_sent, sizeof(uint32_t));
-                memcpy(&payload[9], &seq_stats.errors, sizeof(uint32_t));
-                memcpy(&payload[13], &seq_stats.retries, sizeof(uint32_t));
-                payload_len = 17;  /* 1 byte state + 4 * 4 bytes stats */
-            } else {
-                payload_len = 1;  /* State only */
+            /* Snapshot only: no seq_lock, SPI or I2C (REQ-FW-112) */
+            system_status_t sys;
+            int rc = health_monitor_get_status(&sys);
+            if (rc != 0) {
+                status = (rc == -EAGAIN) ? STATUS_BUSY : STATUS_ERROR;
+                break;
             }
 
+            const uint32_t counters[] = {
+                (uint32_t)sys.stats.frames_received,
+                (uint32_t)sys.stats.frames_sent,
+                (uint32_t)sys.stats.frames_dropped,
+                (uint32_t)sys.stats.spi_errors,
+                (uint32_t)sys.stats.csi2_errors,
+            };
+            _Static_assert(10 + sizeof(sys.age_ms) + sizeof(counters) == CMD_STATUS_PAYLOAD_LEN,
+                           "GET_STATUS layout matches CMD_STATUS_PAYLOAD_LEN");
+
+            payload[0] = sys.state;
+            payload[1] = sys.battery_soc;
+            memcpy(&payload[2], &sys.battery_mv, sizeof(uint16_t));
+            memcpy(&payload[4], &sys.fpga_temp, sizeof(uint16_t));
+            memcpy(&payload[6], &sys.uptime_sec, sizeof(uint32_t));
+            memcpy(&payload[10], sys.age_ms, sizeof(sys.age_ms));
+            memcpy(&payload[10 + sizeof(sys.age_ms)], counters, sizeof(counters));
+            payload_len = CMD_STATUS_PAYLOAD_LEN;
+
             status = STATUS_OK;
             break;
         }
 
+        case CMD_GET_DATA: {
+            /* Data set routed to registered handler */
+            int rc = dispatch_data(cmd->payload, cmd->payload_len, payload, sizeof(payload));
+            if (rc >= 0) {
+                status = STATUS_OK;
+                payload_len = (size_t)rc;
+            } else {
+                status = (rc == -ENOENT || rc == -EMSGSIZE) ? STATUS_INVALID_CMD : STATUS_ERROR;
+                payload_len = 4;
+                uint32_t error_code = (uint32_t)rc;
+                memcpy(payload, &error_code, 4);
+            }
+            break;
+        }
+
         case CMD_SET_CONFIG: {
             /* Set configuration */
-            /* Parse payload for configuration parameters */
-            if (cmd->payload_len >= 8) {
+            uint32_t config_magic = 0;
+            if (cmd->payload_len >= sizeof(config_magic)) {
+                memcpy(&config_magic, cmd->payload, sizeof(config_magic));
+            }
+
+            if (config_magic == CMD_CONFIG_EXT_MAGIC) {
+                /* Extended config block routed to registered handler */
+                int rc = dispatch_config_ext(cmd->payload, cmd->payload_len);
+                if (rc == 0) {
+                    status = STATUS_OK;
+                    payload_len = 1;
+                    payload[0] = 0x01;
+                } else {
+                    status = (rc == -ENOENT) ? STATUS_INVALID_CMD : STATUS_ERROR;
+                    payload_len = 4;
+                    uint32_t error_code = (uint32_t)rc;
+                    memcpy(payload, &error_code, 4);
+                }
+            } else if (cmd->payload_len >= 8) {
                 /* Parse configuration parameters from payload */
                 uint32_t exposure_ms;
                 uint16_t gain_db;
@@ -514,11 +637,84 @@ int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *re
             status = STATUS_INVALID_CMD;
             break;
     }
+    TRACE_END(TRACE_CMD, cmd->command_id, status);
 
     return build_response(cmd->sequence, status,
                          payload, payload_len, resp_buf, resp_len);
 }
 
+/**
+ * @brief Register handler for an extended CMD_SET_CONFIG ID
+ */
+int cmd_register_config_handler(uint8_t config_id, cmd_config_handler_t handler,
+                                void *user_data) {
+    for (size_t i = 0; i < config_handler_count; i++) {
+        if (config_handlers[i].config_id != config_id) {
+            continue;
+        }
+
+        if (handler == NULL) {
+            /* Unregister: move last entry into this slot */
+            config_handlers[i] = config_handlers[--config_handler_count];
+        } else {
+            config_handlers[i].handler = handler;
+            config_handlers[i].user_data = user_data;
+        }
+        return 0;
+    }
+
+    if (handler == NULL) {
+        return 0;
+    }
+
+    if (config_handler_count >= CMD_CONFIG_MAX_HANDLERS) {
+        return -ENOSPC;
+    }
+
+    config_handlers[config_handler_count].config_id = config_id;
+    config_handlers[config_handler_count].handler = handler;
+    config_handlers[config_handler_count].user_data = user_data;
+    config_handler_count++;
+
+    return 0;
+}
+
+/**
+ * @brief Register handler for a CMD_GET_DATA ID
+ */
+int cmd_register_data_handler(uint8_t data_id, cmd_data_handler_t handler,
+                              void *user_data) {
+    for (size_t i = 0; i < data_handler_count; i++) {
+        if (data_handlers[i].data_id != data_id) {
+            continue;
+        }
+
+        if (handler == NULL) {
+            /* Unregister: move last entry into this slot */
+            data_handlers[i] = data_handlers[--data_handler_count];
+        } else {
+            data_handlers[i].handler = handler;
+            data_handlers[i].user_data = user_data;
+        }
+        return 0;
+    }
+
+    if (handler == NULL) {
+        return 0;
+    }
+
+    if (data_handler_count >= CMD_DATA_MAX_HANDLERS) {
+        return -ENOSPC;
+    }
+
+    data_handlers[data_handler_count].data_id = data_id;
+    data_handlers[data_handler_count].handler = handler;
+    data_handlers[data_handler_count].user_data = user_data;
+    data_handler_count++;
+
+    return 0;
+}
+
 /**
  * @brief Get auth failure count
  */
@@ -8,38 +8,113 @@
  * - Error recovery with 3 retry limit
  * - 3 modes (Single, Continuous, Calibration)
  *
+ * Events arrive from several daemon threads (CSI-2 RX start-of-frame,
+ * the saturation and packetize stages, the command handler), and
+ * auto-exposure programs registers from the stats stage. Decisions are
+ * made under seq_lock; the register writes they need are queued in a
+ * seq_io_t and issued after it is dropped, in ticket order, so writes
+ * reach the FPGA in decision order while no lock is held across SPI. A
+ * failed write is undone under seq_lock if nothing has moved on since.
+ * State, mode and statistics are published with relaxed atomics, so
+ * their readers never wait.
+ *
  * Copyright (c) 2026 ABYZ Lab
  */
 
 #include "sequence_engine.h"
+#include "hal/spi_master.h"
+#include "health_monitor.h"
+#include "util/trace.h"
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <string.h>
 
-/**
- * @brief Sequence Engine context type for main.c compatibility
- */
-typedef struct {
-    bool initialized;  /**< Initialization flag */
-} sequence_engine_t;
-
 /* Maximum retry count for error recovery */
 #define MAX_RETRY_COUNT 3
 
+/* Most register writes one decision needs (CONFIGURE) */
+#define SEQ_IO_MAX_REGS 4
+
 /* Sequence Engine context */
 static struct {
     seq_state_t state;
     scan_mode_t mode;
     uint32_t retry_count;
-    seq_stats_t stats;
+    seq_frame_start_t frame_start;
+    bool frame_started;
+    seq_overexposure_t overexposure;
+    bool overexposed;
+    seq_calib_params_t calib;
+    seq_exposure_t exposure;
+    seq_hdr_t hdr;
     bool initialized;
 } seq_ctx = {
     .state = SEQ_STATE_IDLE,
     .mode = SCAN_MODE_SINGLE,
     .retry_count = 0,
-    .stats = {0},
+    .frame_start = {0},
+    .frame_started = false,
+    .overexposure = {0},
+    .overexposed = false,
+    .calib = { SEQ_CALIB_DARK, 0 },
+    .exposure = { SEQ_DEFAULT_TIMING, SEQ_DEFAULT_GAIN },
+    .hdr = { false, 0, 0 },
     .initialized = false
 };
 
+static pthread_mutex_t seq_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Published copies for lock-free readers; state and mode are stored under
+ * seq_lock, counters are added to from anywhere */
+static struct {
+    atomic_int state;
+    atomic_int mode;
+    atomic_bool initialized;
+    atomic_uint frames_received;
+    atomic_uint frames_sent;
+    atomic_uint errors;
+    atomic_uint retries;
+    atomic_uint overexposures;
+} seq_pub;
+
+#define SEQ_COUNT(counter) \
+    atomic_fetch_add_explicit(&seq_pub.counter, 1, memory_order_relaxed)
+
+/**
+ * @brief Register writes decided under seq_lock, issued after it is dropped
+ */
+typedef struct {
+    spi_master_t *spi;
+    struct {
+        uint8_t addr;
+        uint16_t value;
+    } regs[SEQ_IO_MAX_REGS];
+    uint32_t count;
+    bool verify;                    /* Read back (configuration writes) */
+    const char *what;               /* Failure log */
+    uint64_t ticket;
+
+    /* Undone on failure if still current */
+    bool undo_state;
+    seq_state_t state_before;
+    seq_state_t state_after;
+    bool undo_exposure;
+    seq_exposure_t exposure_before;
+    seq_exposure_t exposure_after;
+} seq_io_t;
+
+/* Tickets are taken under seq_lock and served in order */
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t turn;
+    uint64_t next;                  /* Guarded by seq_lock */
+    uint64_t serving;               /* Guarded by lock */
+} seq_io_order = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .turn = PTHREAD_COND_INITIALIZER,
+};
+
 /* State transition table */
 typedef struct {
     seq_state_t current_state;
@@ -49,12 +124,16 @@ typedef struct {
 
 /* Forward declarations */
 static int transition_to(seq_state_t new_state);
-static int handle_configure_state(void);
-static int handle_arm_state(void);
+static int handle_configure_state(seq_io_t *io);
+static int handle_arm_state(seq_io_t *io);
 static int handle_scanning_state(void);
 static int handle_streaming_state(void);
 static int handle_complete_state(void);
 static int handle_error_state(void);
+static int handle_overexposure(const seq_overexposure_t *event, seq_io_t *io);
+static bool hdr_active(void);
+static void hdr_program_next(uint32_t sequence, seq_io_t *io);
+static int handle_event(seq_event_t event, void *data, seq_io_t *io);
 
 /* ==========================================================================
  * State Transition Logic
@@ -68,39 +147,109 @@ static int transition_to(seq_state_t new_state) {
         return -EINVAL;
     }
 
+    TRACE_INSTANT(TRACE_SEQ_STATE, seq_ctx.state, new_state);
     seq_ctx.state = new_state;
+    atomic_store_explicit(&seq_pub.state, (int)new_state, memory_order_relaxed);
     return 0;
 }
 
+/* ==========================================================================
+ * Register Writes
+ * ========================================================================== */
+
+/**
+ * @brief Queue a register write (seq_lock held)
+ */
+static void io_add(seq_io_t *io, uint8_t addr, uint16_t value) {
+    io->regs[io->count].addr = addr;
+    io->regs[io->count].value = value;
+    io->count++;
+}
+
+/**
+ * @brief Take a place in the write order (seq_lock held)
+ */
+static void io_queue(seq_io_t *io) {
+    if (io->count > 0) {
+        io->ticket = seq_io_order.next++;
+    }
+}
+
+/**
+ * @brief Issue queued writes once earlier tickets are done (no seq_lock)
+ *
+ * @return 0 on success, -EIO if a write failed (then undone where possible)
+ */
+static int io_issue(seq_io_t *io) {
+    if (io->count == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&seq_io_order.lock);
+    while (seq_io_order.serving != io->ticket) {
+        pthread_cond_wait(&seq_io_order.turn, &seq_io_order.lock);
+    }
+    pthread_mutex_unlock(&seq_io_order.lock);
+
+    spi_status_t status = SPI_OK;
+    uint32_t i;
+    for (i = 0; i < io->count && status == SPI_OK; i++) {
+        status = io->verify ? spi_write_register(io->spi, io->regs[i].addr, io->regs[i].value)
+                            : spi_write_register_no_verify(io->spi, io->regs[i].addr,
+                                                           io->regs[i].value);
+    }
+
+    pthread_mutex_lock(&seq_io_order.lock);
+    seq_io_order.serving++;
+    pthread_cond_broadcast(&seq_io_order.turn);
+    pthread_mutex_unlock(&seq_io_order.lock);
+
+    if (status == SPI_OK) {
+        return 0;
+    }
+
+    health_monitor_log(LOG_ERROR, "seq", "%s: register 0x%02X failed: %d",
+                       io->what, io->regs[i - 1].addr, status);
+    SEQ_COUNT(errors);
+
+    pthread_mutex_lock(&seq_lock);
+    if (io->undo_state && seq_ctx.state == io->state_after) {
+        transition_to(io->state_before);
+    }
+    if (io->undo_exposure &&
+        seq_ctx.exposure.timing == io->exposure_after.timing &&
+        seq_ctx.exposure.gain == io->exposure_after.gain) {
+        seq_ctx.exposure = io->exposure_before;
+    }
+    pthread_mutex_unlock(&seq_lock);
+    return -EIO;
+}
+
 /**
  * @brief Handle CONFIGURE state
  *
  * Configure FPGA registers for current scan mode
  */
-static int handle_configure_state(void) {
+static int handle_configure_state(seq_io_t *io) {
     /* Write FPGA configuration registers via SPI */
-    uint8_t config_cmd[8] = {0};
-    uint8_t config_data[32] = {0};
-
-    /* Mock FPGA configuration */
-    config_cmd[0] = 0x01;      // CONFIG register
-    config_cmd[1] = 0x00;      // Clear existing config
-    config_cmd[2] = 0x02;      // MODE register
-    config_cmd[3] = seq_ctx.mode;  // Scan mode
-    config_cmd[4] = 0x03;      // TIMING register
-    config_cmd[5] = 0x10;      // Exposure time
-    config_cmd[6] = 0x04;      // GAIN register
-    config_cmd[7] = 0x80;      // Default gain
+    extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
 
-    /* Real implementation would use SPI:
-    spi_result_t result = spi_master_write(&spi_ctx, config_cmd, sizeof(config_cmd));
-    if (result.status != SPI_OK) {
-        health_monitor_log(LOG_ERROR, "seq", "FPGA config failed: %d", result.error_code);
-        return -EIO;
+    if (g_spi_master != NULL) {
+        io->spi = g_spi_master;
+        io->verify = true;
+        io->what = "FPGA config";
+        io_add(io, FPGA_REG_CONFIG, 0x0000);                /* Clear existing config */
+        io_add(io, FPGA_REG_MODE, (uint16_t)seq_ctx.mode);
+        io_add(io, FPGA_REG_TIMING, seq_ctx.exposure.timing);
+        io_add(io, FPGA_REG_GAIN, hdr_active() ? seq_ctx.hdr.low_gain : seq_ctx.exposure.gain);
+        io->undo_state = true;
+        io->state_before = SEQ_STATE_CONFIGURE;
+        io->state_after = SEQ_STATE_ARM;
+    } else {
+        health_monitor_log(LOG_WARNING, "seq", "SPI not available, skipping FPGA config");
     }
-    */
 
-    health_monitor_log(LOG_INFO, "seq", "FPGA configured for %s mode",
+    health_monitor_log(LOG_INFO, "seq", "Configuring FPGA for %s mode",
                       (seq_ctx.mode == SCAN_MODE_SINGLE) ? "SINGLE" :
                       (seq_ctx.mode == SCAN_MODE_CONTINUOUS) ? "CONTINUOUS" : "CALIBRATION");
 
@@ -112,23 +261,21 @@ static int handle_configure_state(void) {
  *
  * Arm FPGA for scanning
  */
-static int handle_arm_state(void) {
+static int handle_arm_state(seq_io_t *io) {
     /* Write FPGA ARM register via SPI */
     extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
 
     if (g_spi_master != NULL) {
         /* Set ARM bit in FPGA control register */
-        uint16_t ctrl_value = FPGA_CTRL_ARM;
-
-        spi_status_t spi_result = spi_write_register(g_spi_master, FPGA_REG_CTRL, ctrl_value);
-        if (spi_result != SPI_OK) {
-            health_monitor_log(LOG_ERROR, "seq",
-                             "Failed to write FPGA ARM register: %d",
-                             spi_result);
-            return -EIO;
-        }
-
-        health_monitor_log(LOG_INFO, "seq", "FPGA ARM register written (0x%04X)", ctrl_value);
+        io->spi = g_spi_master;
+        io->verify = true;
+        io->what = "FPGA ARM";
+        io_add(io, FPGA_REG_CTRL, FPGA_CTRL_ARM);
+        io->undo_state = true;
+        io->state_before = SEQ_STATE_ARM;
+        io->state_after = SEQ_STATE_SCANNING;
+
+        health_monitor_log(LOG_INFO, "seq", "Arming FPGA (CTRL 0x%04X)", FPGA_CTRL_ARM);
     } else {
         /* SPI not available, just log and continue */
         health_monitor_log(LOG_WARNING, "seq", "SPI not available, skipping FPGA ARM");
@@ -168,11 +315,11 @@ static int handle_complete_state(void) {
         return 0;
     } else if (seq_ctx.mode == SCAN_MODE_CONTINUOUS) {
         /* Continuous mode: return to SCANNING for next frame */
-        seq_ctx.stats.frames_sent++;
+        SEQ_COUNT(frames_sent);
         return transition_to(SEQ_STATE_SCANNING);
     } else {
         /* Calibration mode: return to ARM for next calibration cycle */
-        seq_ctx.stats.frames_sent++;
+        SEQ_COUNT(frames_sent);
         return transition_to(SEQ_STATE_ARM);
     }
 }
@@ -190,7 +337,7 @@ static int handle_error_state(void) {
 
     /* Attempt recovery */
     seq_ctx.retry_count++;
-    seq_ctx.stats.retries++;
+    SEQ_COUNT(retries);
 
     /* Reset FPGA and retry */
     uint8_t reset_cmd[4] = {0};
@@ -214,18 +361,237 @@ static int handle_error_state(void) {
     return transition_to(SEQ_STATE_SCANNING);
 }
 
+/**
+ * @brief Handle EVT_OVEREXPOSURE
+ *
+ * Raised from the frame path as soon as the saturation counter trips, so
+ * the response reaches the FPGA while the next frame is integrating.
+ * Registers are written without read-back to keep the feedback path short.
+ */
+static int handle_overexposure(const seq_overexposure_t *event, seq_io_t *io) {
+    extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
+
+    seq_ctx.overexposure = *event;
+    seq_ctx.overexposed = true;
+    SEQ_COUNT(overexposures);
+
+    io->spi = g_spi_master;
+
+    if (event->action == SEQ_OVEREXPOSURE_STOP) {
+        if (g_spi_master != NULL) {
+            io->what = "Overexposure stop";
+            io_add(io, FPGA_REG_CTRL, FPGA_CTRL_STOP);
+            io->undo_state = true;
+            io->state_before = seq_ctx.state;
+            io->state_after = SEQ_STATE_IDLE;
+        }
+
+        health_monitor_log(LOG_WARNING, "seq",
+                         "Overexposure: %u saturated pixels in %u tiles, scan stopped",
+                         event->saturated, event->tiles_over);
+        return transition_to(SEQ_STATE_IDLE);
+    }
+
+    if (event->action == SEQ_OVEREXPOSURE_BACKOFF) {
+        uint16_t timing = seq_ctx.exposure.timing / SEQ_BACKOFF_DIVISOR;
+        timing = (timing > 0) ? timing : 1;
+
+        if (timing == seq_ctx.exposure.timing) {
+            return 0;
+        }
+
+        if (g_spi_master != NULL) {
+            io->what = "Overexposure backoff";
+            io_add(io, FPGA_REG_TIMING, timing);
+            io->undo_exposure = true;
+            io->exposure_before = seq_ctx.exposure;
+            io->exposure_after = (seq_exposure_t){ timing, seq_ctx.exposure.gain };
+        }
+
+        health_monitor_log(LOG_WARNING, "seq",
+                         "Overexposure: %u saturated pixels in %u tiles, timing 0x%04X -> 0x%04X",
+                         event->saturated, event->tiles_over, seq_ctx.exposure.timing, timing);
+        seq_ctx.exposure.timing = timing;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Gains alternate in this scan (calibration runs at a single gain)
+ */
+static bool hdr_active(void) {
+    return seq_ctx.hdr.enabled && seq_ctx.mode != SCAN_MODE_CALIBRATION;
+}
+
+/**
+ * @brief Write the HDR gain of the frame after sequence
+ *
+ * Called at start-of-frame, so the write lands while the FPGA integrates
+ * this frame and takes effect at the next frame start. No read-back: it
+ * runs every frame.
+ */
+static void hdr_program_next(uint32_t sequence, seq_io_t *io) {
+    extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
+
+    if (g_spi_master == NULL) {
+        return;
+    }
+
+    io->spi = g_spi_master;
+    io->what = "HDR gain";
+    io_add(io, FPGA_REG_GAIN,
+           ((sequence + 1U) & 1U) ? seq_ctx.hdr.high_gain : seq_ctx.hdr.low_gain);
+}
+
+/**
+ * @brief Handle event (seq_lock held)
+ */
+static int handle_event(seq_event_t event, void *data, seq_io_t *io) {
+    if (!seq_ctx.initialized) {
+        return -EINVAL;
+    }
+
+    int result = 0;
+
+    /* Start-of-frame is informational: it never changes state and may
+     * arrive while the previous frame is still streaming. */
+    if (event == EVT_FRAME_START) {
+        if (data == NULL) {
+            return -EINVAL;
+        }
+        if (seq_ctx.state == SEQ_STATE_SCANNING ||
+            seq_ctx.state == SEQ_STATE_STREAMING) {
+            seq_ctx.frame_start = *(const seq_frame_start_t *)data;
+            seq_ctx.frame_started = true;
+            if (hdr_active()) {
+                hdr_program_next(seq_ctx.frame_start.sequence, io);
+            }
+        }
+        return 0;
+    }
+
+    /* Overexposure only matters while frames are being exposed; the
+     * response itself may end the scan. */
+    if (event == EVT_OVEREXPOSURE) {
+        if (data == NULL) {
+            return -EINVAL;
+        }
+        const seq_overexposure_t *overexposure = (const seq_overexposure_t *)data;
+        if (overexposure->action >= SEQ_OVEREXPOSURE_MAX) {
+            return -EINVAL;
+        }
+        if (seq_ctx.state != SEQ_STATE_SCANNING &&
+            seq_ctx.state != SEQ_STATE_STREAMING) {
+            return 0;
+        }
+        return handle_overexposure(overexposure, io);
+    }
+
+    switch (seq_ctx.state) {
+        case SEQ_STATE_IDLE:
+            if (event == EVT_START_SCAN) {
+                result = transition_to(SEQ_STATE_CONFIGURE);
+            }
+            break;
+
+        case SEQ_STATE_CONFIGURE:
+            if (event == EVT_CONFIG_DONE) {
+                result = handle_configure_state(io);
+            } else if (event == EVT_ERROR) {
+                result = transition_to(SEQ_STATE_ERROR);
+            } else if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        case SEQ_STATE_ARM:
+            if (event == EVT_ARM_DONE) {
+                result = handle_arm_state(io);
+            } else if (event == EVT_ERROR) {
+                result = transition_to(SEQ_STATE_ERROR);
+            } else if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        case SEQ_STATE_SCANNING:
+            if (event == EVT_FRAME_READY) {
+                SEQ_COUNT(frames_received);
+                result = transition_to(SEQ_STATE_STREAMING);
+            } else if (event == EVT_ERROR) {
+                result = transition_to(SEQ_STATE_ERROR);
+            } else if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        case SEQ_STATE_STREAMING:
+            if (event == EVT_COMPLETE) {
+                result = handle_streaming_state();
+                if (result == 0) {
+                    result = handle_complete_state();
+                }
+            } else if (event == EVT_ERROR) {
+                result = transition_to(SEQ_STATE_ERROR);
+            } else if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        case SEQ_STATE_COMPLETE:
+            if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        case SEQ_STATE_ERROR:
+            if (event == EVT_ERROR_CLEARED) {
+                result = handle_error_state();
+            } else if (event == EVT_STOP_SCAN) {
+                result = transition_to(SEQ_STATE_IDLE);
+            }
+            break;
+
+        default:
+            result = -EINVAL;
+            break;
+    }
+
+    return result;
+}
+
 /* ==========================================================================
  * Public API
  * ========================================================================== */
 
+/**
+ * @brief Reset the published copies (seq_lock held)
+ */
+static void seq_publish_reset(bool initialized) {
+    atomic_store_explicit(&seq_pub.state, SEQ_STATE_IDLE, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.mode, SCAN_MODE_SINGLE, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.frames_received, 0, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.frames_sent, 0, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.errors, 0, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.retries, 0, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.overexposures, 0, memory_order_relaxed);
+    atomic_store_explicit(&seq_pub.initialized, initialized, memory_order_relaxed);
+}
+
 /**
  * @brief Initialize Sequence Engine
  */
 int seq_init(void) {
+    pthread_mutex_lock(&seq_lock);
     memset(&seq_ctx, 0, sizeof(seq_ctx));
     seq_ctx.state = SEQ_STATE_IDLE;
     seq_ctx.mode = SCAN_MODE_SINGLE;
+    seq_ctx.exposure.timing = SEQ_DEFAULT_TIMING;
+    seq_ctx.exposure.gain = SEQ_DEFAULT_GAIN;
     seq_ctx.initialized = true;
+    seq_publish_reset(true);
+    pthread_mutex_unlock(&seq_lock);
     return 0;
 }
 
@@ -233,16 +599,19 @@ int seq_init(void) {
  * @brief Deinitialize Sequence Engine
  */
 void seq_deinit(void) {
+    pthread_mutex_lock(&seq_lock);
     memset(&seq_ctx, 0, sizeof(seq_ctx));
     seq_ctx.state = SEQ_STATE_IDLE;
     seq_ctx.initialized = false;
+    seq_publish_reset(false);
+    pthread_mutex_unlock(&seq_lock);
 }
 
 /**
  * @brief Get current state
  */
 seq_state_t seq_get_state(void) {
-    return seq_ctx.state;
+    return (seq_state_t)atomic_load_explicit(&seq_pub.state, memory_order_relaxed);
 }
 
 /**
@@ -265,31 +634,199 @@ const char *seq_state_to_string(seq_state_t state) {
  * @brief Start scan in specified mode
  */
 int seq_start_scan(scan_mode_t mode) {
+    if (mode >= SCAN_MODE_MAX) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&seq_lock);
+
+    int ret;
     if (!seq_ctx.initialized) {
+        ret = -EINVAL;
+    } else if (seq_ctx.state != SEQ_STATE_IDLE && seq_ctx.state != SEQ_STATE_COMPLETE) {
+        /* Already scanning or in error state */
+        ret = -EBUSY;
+    } else {
+        seq_ctx.mode = mode;
+        atomic_store_explicit(&seq_pub.mode, (int)mode, memory_order_relaxed);
+        seq_ctx.retry_count = 0;
+        seq_ctx.frame_started = false;
+        seq_ctx.overexposed = false;
+
+        /* Transition to CONFIGURE state */
+        ret = transition_to(SEQ_STATE_CONFIGURE);
+    }
+
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
+}
+
+/**
+ * @brief Get current scan mode
+ */
+scan_mode_t seq_get_mode(void) {
+    return (scan_mode_t)atomic_load_explicit(&seq_pub.mode, memory_order_relaxed);
+}
+
+/**
+ * @brief Set calibration parameters
+ */
+int seq_set_calibration(const seq_calib_params_t *params) {
+    if (params == NULL || params->phase >= SEQ_CALIB_MAX) {
         return -EINVAL;
     }
 
-    if (mode >= SCAN_MODE_MAX) {
+    pthread_mutex_lock(&seq_lock);
+
+    int ret = 0;
+    if (!seq_ctx.initialized) {
+        ret = -EINVAL;
+    } else if (seq_ctx.state != SEQ_STATE_IDLE && seq_ctx.state != SEQ_STATE_COMPLETE) {
+        ret = -EBUSY;
+    } else {
+        seq_ctx.calib = *params;
+    }
+
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
+}
+
+/**
+ * @brief Get calibration parameters
+ */
+int seq_get_calibration(seq_calib_params_t *params) {
+    if (params == NULL) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&seq_lock);
+    *params = seq_ctx.calib;
+    pthread_mutex_unlock(&seq_lock);
+    return 0;
+}
+
+/**
+ * @brief Set exposure registers
+ */
+int seq_set_exposure(const seq_exposure_t *exposure) {
+    if (exposure == NULL || exposure->timing == 0 || exposure->gain == 0) {
         return -EINVAL;
     }
 
+    pthread_mutex_lock(&seq_lock);
+    seq_ctx.exposure = *exposure;
+    pthread_mutex_unlock(&seq_lock);
+    return 0;
+}
+
+/**
+ * @brief Program exposure registers mid-scan
+ *
+ * Compares against the values the caller started from under seq_lock, so
+ * an overexposure backoff taken in between is never overwritten.
+ */
+int seq_program_exposure(const seq_exposure_t *expected, const seq_exposure_t *exposure) {
+    extern spi_master_t *g_spi_master;  /* Global SPI context from main.c */
+
+    if (expected == NULL || exposure == NULL || exposure->timing == 0 || exposure->gain == 0) {
+        return -EINVAL;
+    }
+
+    seq_io_t io = { 0 };
+
+    pthread_mutex_lock(&seq_lock);
+
+    int ret = 0;
+    if (!seq_ctx.initialized) {
+        ret = -EINVAL;
+    } else if ((seq_ctx.state != SEQ_STATE_SCANNING && seq_ctx.state != SEQ_STATE_STREAMING) ||
+               seq_ctx.exposure.timing != expected->timing ||
+               seq_ctx.exposure.gain != expected->gain) {
+        ret = -EAGAIN;
+    } else {
+        if (g_spi_master != NULL) {
+            io.spi = g_spi_master;
+            io.what = "Exposure";
+            if (exposure->timing != expected->timing) {
+                io_add(&io, FPGA_REG_TIMING, exposure->timing);
+            }
+            if (exposure->gain != expected->gain) {
+                io_add(&io, FPGA_REG_GAIN, exposure->gain);
+            }
+            io.undo_exposure = true;
+            io.exposure_before = seq_ctx.exposure;
+            io.exposure_after = *exposure;
+            io_queue(&io);
+        }
+        seq_ctx.exposure = *exposure;
+    }
+
+    pthread_mutex_unlock(&seq_lock);
+
+    if (ret == 0) {
+        ret = io_issue(&io);
+    }
+    return ret;
+}
+
+/**
+ * @brief Get exposure registers
+ */
+int seq_get_exposure(seq_exposure_t *exposure) {
+    if (exposure == NULL) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&seq_lock);
+    *exposure = seq_ctx.exposure;
+    pthread_mutex_unlock(&seq_lock);
+    return 0;
+}
+
+/**
+ * @brief Set dual-gain HDR mode
+ */
+int seq_set_hdr(const seq_hdr_t *hdr) {
+    if (hdr == NULL ||
+        (hdr->enabled && (hdr->low_gain == 0 || hdr->high_gain <= hdr->low_gain))) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&seq_lock);
+
+    int ret = 0;
     if (seq_ctx.state != SEQ_STATE_IDLE && seq_ctx.state != SEQ_STATE_COMPLETE) {
-        /* Already scanning or in error state */
-        return -EBUSY;
+        ret = -EBUSY;
+    } else {
+        seq_ctx.hdr = *hdr;
     }
 
-    seq_ctx.mode = mode;
-    seq_ctx.retry_count = 0;
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
+}
 
-    /* Transition to CONFIGURE state */
-    return transition_to(SEQ_STATE_CONFIGURE);
+/**
+ * @brief Get dual-gain HDR mode
+ */
+int seq_get_hdr(seq_hdr_t *hdr) {
+    if (hdr == NULL) {
+        return -EINVAL;
+    }
+
+    pthread_mutex_lock(&seq_lock);
+    *hdr = seq_ctx.hdr;
+    pthread_mutex_unlock(&seq_lock);
+    return 0;
 }
 
 /**
  * @brief Stop scan
  */
 int seq_stop_scan(void) {
+    pthread_mutex_lock(&seq_lock);
+
     if (!seq_ctx.initialized) {
+        pthread_mutex_unlock(&seq_lock);
         return -EINVAL;
     }
 
@@ -310,121 +847,110 @@ int seq_stop_scan(void) {
     */
 
     health_monitor_log(LOG_INFO, "seq", "Stop command sent to FPGA");
-    health_monitor_update_stat("frames_sent", 1);
+    health_monitor_add_stat(HEALTH_STAT_FRAMES_SENT, 1);
 
     /* Return to IDLE state */
-    return transition_to(SEQ_STATE_IDLE);
+    int ret = transition_to(SEQ_STATE_IDLE);
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
 }
 
 /**
  * @brief Handle event
  */
 int seq_handle_event(seq_event_t event, void *data) {
-    (void)data;  /* Unused in this implementation */
-
-    if (!seq_ctx.initialized) {
-        return -EINVAL;
-    }
+    seq_io_t io = { 0 };
 
-    int result = 0;
-
-    switch (seq_ctx.state) {
-        case SEQ_STATE_IDLE:
-            if (event == EVT_START_SCAN) {
-                result = transition_to(SEQ_STATE_CONFIGURE);
-            }
-            break;
+    pthread_mutex_lock(&seq_lock);
+    int ret = handle_event(event, data, &io);
+    io_queue(&io);
+    pthread_mutex_unlock(&seq_lock);
 
-        case SEQ_STATE_CONFIGURE:
-            if (event == EVT_CONFIG_DONE) {
-                result = handle_configure_state();
-            } else if (event == EVT_ERROR) {
-                result = transition_to(SEQ_STATE_ERROR);
-            } else if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
-
-        case SEQ_STATE_ARM:
-            if (event == EVT_ARM_DONE) {
-                result = handle_arm_state();
-            } else if (event == EVT_ERROR) {
-                result = transition_to(SEQ_STATE_ERROR);
-            } else if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
+    if (io_issue(&io) != 0 && ret == 0) {
+        ret = -EIO;
+    }
+    return ret;
+}
 
-        case SEQ_STATE_SCANNING:
-            if (event == EVT_FRAME_READY) {
-                seq_ctx.stats.frames_received++;
-                result = transition_to(SEQ_STATE_STREAMING);
-            } else if (event == EVT_ERROR) {
-                result = transition_to(SEQ_STATE_ERROR);
-            } else if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
+/**
+ * @brief Get statistics
+ */
+int seq_get_stats(seq_stats_t *stats) {
+    if (stats == NULL || !atomic_load_explicit(&seq_pub.initialized, memory_order_relaxed)) {
+        return -EINVAL;
+    }
 
-        case SEQ_STATE_STREAMING:
-            if (event == EVT_COMPLETE) {
-                result = handle_streaming_state();
-                if (result == 0) {
-                    result = handle_complete_state();
-                }
-            } else if (event == EVT_ERROR) {
-                result = transition_to(SEQ_STATE_ERROR);
-            } else if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
+    stats->frames_received = atomic_load_explicit(&seq_pub.frames_received, memory_order_relaxed);
+    stats->frames_sent = atomic_load_explicit(&seq_pub.frames_sent, memory_order_relaxed);
+    stats->errors = atomic_load_explicit(&seq_pub.errors, memory_order_relaxed);
+    stats->retries = atomic_load_explicit(&seq_pub.retries, memory_order_relaxed);
+    stats->overexposures = atomic_load_explicit(&seq_pub.overexposures, memory_order_relaxed);
+    return 0;
+}
 
-        case SEQ_STATE_COMPLETE:
-            if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
+/**
+ * @brief Get the most recent start-of-frame
+ */
+int seq_get_frame_start(seq_frame_start_t *frame_start) {
+    if (frame_start == NULL) {
+        return -EINVAL;
+    }
 
-        case SEQ_STATE_ERROR:
-            if (event == EVT_ERROR_CLEARED) {
-                result = handle_error_state();
-            } else if (event == EVT_STOP_SCAN) {
-                result = transition_to(SEQ_STATE_IDLE);
-            }
-            break;
+    pthread_mutex_lock(&seq_lock);
 
-        default:
-            result = -EINVAL;
-            break;
+    int ret = 0;
+    if (!seq_ctx.initialized) {
+        ret = -EINVAL;
+    } else if (!seq_ctx.frame_started) {
+        ret = -ENOENT;
+    } else {
+        *frame_start = seq_ctx.frame_start;
     }
 
-    return result;
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
 }
 
 /**
- * @brief Get statistics
+ * @brief Get the most recent overexposure event
  */
-int seq_get_stats(seq_stats_t *stats) {
-    if (!seq_ctx.initialized || stats == NULL) {
+int seq_get_overexposure(seq_overexposure_t *event) {
+    if (event == NULL) {
         return -EINVAL;
     }
 
-    memcpy(stats, &seq_ctx.stats, sizeof(seq_stats_t));
-    return 0;
+    pthread_mutex_lock(&seq_lock);
+
+    int ret = 0;
+    if (!seq_ctx.initialized) {
+        ret = -EINVAL;
+    } else if (!seq_ctx.overexposed) {
+        ret = -ENOENT;
+    } else {
+        *event = seq_ctx.overexposure;
+    }
+
+    pthread_mutex_unlock(&seq_lock);
+    return ret;
 }
 
 /**
  * @brief Get retry count
  */
 uint32_t seq_get_retry_count(void) {
-    return seq_ctx.retry_count;
+    pthread_mutex_lock(&seq_lock);
+    uint32_t retries = seq_ctx.retry_count;
+    pthread_mutex_unlock(&seq_lock);
+    return retries;
 }
 
 /**
  * @brief Reset retry count
  */
 void seq_reset_retry_count(void) {
+    pthread_mutex_lock(&seq_lock);
     seq_ctx.retry_count = 0;
+    pthread_mutex_unlock(&seq_lock);
 }
 
 /* ==========================================================================
@@ -0,0 +1,929 @@
+/**
+ * @file async_log.c
+ * @brief Asynchronous logger: capture on the caller, format on a drain thread
+ *
+ * Each ring is a single-producer/single-consumer array of fixed 256-byte
+ * records with free-running head and tail counters, as in spsc_queue.c.
+ * A record holds the format pointer, up to ALOG_MAX_ARGS arguments widened
+ * to 64 bits and the bytes of its %s arguments. The caller walks the
+ * format once to pull the arguments off the va_list; the drain walks it
+ * again and formats one conversion at a time with the original spec, so
+ * output matches a plain vsnprintf.
+ *
+ * Ring ownership: FREE -> OWNED (CAS by the first log call of a thread)
+ * -> RELEASED (thread exit, via a pthread key destructor) -> FREE (drain,
+ * once the ring is empty). The drain merges all rings by timestamp.
+ *
+ * Rate limiting and duplicate folding run on the drain, so the caller
+ * pays the same whatever happens to the message later.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "util/async_log.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+
+#define ALOG_CACHELINE      64
+#define ALOG_RECORD_SIZE    256
+#define ALOG_MAX_RING       (1U << 16)
+#define ALOG_RATE_SLOTS     128     /* Formats tracked by the rate limit */
+#define ALOG_SPEC_MAX       32      /* Longest single conversion spec */
+#define ALOG_REPEAT_NS      1000000000ULL   /* Report folded repeats at least every second */
+#define ALOG_NS_PER_SEC     1000000000ULL
+
+#define ALOG_REC_PREFORMATTED   0x01    /* strings holds the whole message */
+
+enum {
+    ALOG_RING_FREE = 0,
+    ALOG_RING_OWNED,
+    ALOG_RING_RELEASED
+};
+
+/**
+ * @brief Captured argument (integers widened, floating point as double)
+ */
+typedef union {
+    uint64_t u;
+    double d;
+} alog_arg_t;
+
+#define ALOG_HEADER_SIZE    32
+#define ALOG_STRING_BYTES   (ALOG_RECORD_SIZE - ALOG_HEADER_SIZE - ALOG_MAX_ARGS * sizeof(alog_arg_t))
+
+/**
+ * @brief One log call
+ */
+typedef struct {
+    uint64_t time_ns;           /**< CLOCK_REALTIME of the call */
+    const char *module;
+    const char *format;         /**< Format ID */
+    int32_t level;
+    uint8_t nargs;
+    uint8_t flags;              /**< ALOG_REC_* */
+    uint16_t str_used;          /**< Bytes of strings in use */
+    alog_arg_t args[ALOG_MAX_ARGS];
+    char strings[ALOG_STRING_BYTES];
+} alog_record_t;
+
+_Static_assert(offsetof(alog_record_t, args) == ALOG_HEADER_SIZE, "record header layout");
+_Static_assert(sizeof(alog_record_t) == ALOG_RECORD_SIZE, "records are 256 bytes");
+
+/**
+ * @brief Ring of one thread
+ */
+typedef struct {
+    _Alignas(ALOG_CACHELINE) atomic_uint head;          /**< Next record to drain (drain) */
+    uint64_t dropped_seen;                              /**< Drops already reported (drain) */
+
+    _Alignas(ALOG_CACHELINE) atomic_uint tail;          /**< Next record to fill (owner) */
+    uint32_t cached_head;                               /**< Owner's view of head */
+    atomic_uint_least64_t captured;                     /**< Written by the owner only */
+    atomic_uint_least64_t dropped;
+    atomic_uint_least64_t truncated;
+
+    _Alignas(ALOG_CACHELINE) atomic_int state;          /**< ALOG_RING_* */
+    alog_record_t *records;
+} alog_ring_t;
+
+/**
+ * @brief Rate limit state of one format
+ */
+typedef struct {
+    const char *format;         /**< NULL = unused slot */
+    const char *module;         /**< Module of the last message */
+    int32_t level;
+    uint64_t second;            /**< Second being counted */
+    uint32_t count;             /**< Messages in that second */
+    uint32_t suppressed;        /**< Held back in that second */
+} alog_rate_t;
+
+static struct {
+    atomic_bool active;
+    atomic_uint generation;     /**< Bumped by every start, invalidates old claims */
+    alog_config_t config;
+    uint32_t mask;
+    alog_record_t *storage;
+
+    pthread_t drain;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool stop;                  /**< Guarded by lock */
+    uint64_t flush_requested;   /**< Guarded by lock */
+    uint64_t flush_done;        /**< Guarded by lock */
+
+    /* Drain thread only */
+    alog_rate_t rate[ALOG_RATE_SLOTS];
+    char last[ALOG_MAX_MESSAGE];
+    const char *last_module;
+    int32_t last_level;
+    bool last_valid;
+    uint32_t repeats;
+    uint64_t repeat_ns;         /**< When repeats were last reported */
+
+    atomic_uint_least64_t fallback;
+    atomic_uint_least64_t emitted;
+    atomic_uint_least64_t rate_limited;
+    atomic_uint_least64_t duplicates;
+} g_alog = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER
+};
+
+static alog_ring_t g_rings[ALOG_MAX_THREADS];
+
+static _Thread_local alog_ring_t *t_ring;
+static _Thread_local unsigned int t_generation;
+
+static pthread_key_t g_ring_key;
+static pthread_once_t g_ring_key_once = PTHREAD_ONCE_INIT;
+
+/* ==========================================================================
+ * Format Walking
+ * ========================================================================== */
+
+/**
+ * @brief printf length modifier
+ */
+typedef enum {
+    ALOG_LEN_NONE = 0,
+    ALOG_LEN_HH,
+    ALOG_LEN_H,
+    ALOG_LEN_L,
+    ALOG_LEN_LL,
+    ALOG_LEN_Z,
+    ALOG_LEN_J,
+    ALOG_LEN_T,
+    ALOG_LEN_LD
+} alog_len_t;
+
+/**
+ * @brief One conversion spec, as found by alog_parse_spec()
+ */
+typedef struct {
+    const char *start;          /**< The '%' */
+    const char *end;            /**< One past the conversion character */
+    uint32_t stars;             /**< '*' width/precision arguments before the value */
+    alog_len_t len;
+    char conv;                  /**< Conversion character ('%' for a literal percent) */
+} alog_spec_t;
+
+static bool alog_is_flag(char c) {
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0' || c == '\'';
+}
+
+static bool alog_is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Parse the conversion spec at p (which points at '%')
+ */
+static void alog_parse_spec(const char *p, alog_spec_t *spec) {
+    spec->start = p++;
+    spec->stars = 0;
+    spec->len = ALOG_LEN_NONE;
+
+    while (alog_is_flag(*p)) p++;
+    if (*p == '*') {
+        spec->stars++;
+        p++;
+    } else {
+        while (alog_is_digit(*p)) p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->stars++;
+            p++;
+        } else {
+            while (alog_is_digit(*p)) p++;
+        }
+    }
+
+    switch (*p) {
+        case 'h':
+            p++;
+            spec->len = ALOG_LEN_H;
+            if (*p == 'h') {
+                p++;
+                spec->len = ALOG_LEN_HH;
+            }
+            break;
+        case 'l':
+            p++;
+            spec->len = ALOG_LEN_L;
+            if (*p == 'l') {
+                p++;
+                spec->len = ALOG_LEN_LL;
+            }
+            break;
+        case 'q': p++; spec->len = ALOG_LEN_LL; break;
+        case 'z': p++; spec->len = ALOG_LEN_Z; break;
+        case 'j': p++; spec->len = ALOG_LEN_J; break;
+        case 't': p++; spec->len = ALOG_LEN_T; break;
+        case 'L': p++; spec->len = ALOG_LEN_LD; break;
+        default: break;
+    }
+
+    spec->conv = *p;
+    spec->end = (*p != '\0') ? p + 1 : p;
+}
+
+static bool alog_is_signed(char conv) {
+    return conv == 'd' || conv == 'i';
+}
+
+static bool alog_is_unsigned(char conv) {
+    return conv == 'u' || conv == 'o' || conv == 'x' || conv == 'X';
+}
+
+static bool alog_is_float(char conv) {
+    return conv == 'f' || conv == 'F' || conv == 'e' || conv == 'E' ||
+           conv == 'g' || conv == 'G' || conv == 'a' || conv == 'A';
+}
+
+/* ==========================================================================
+ * Capture (caller side)
+ * ========================================================================== */
+
+static uint64_t alog_get_signed(alog_len_t len, va_list *ap) {
+    switch (len) {
+        case ALOG_LEN_L:  return (uint64_t)(int64_t)va_arg(*ap, long);
+        case ALOG_LEN_LL: return (uint64_t)(int64_t)va_arg(*ap, long long);
+        case ALOG_LEN_Z:  return (uint64_t)(int64_t)va_arg(*ap, ptrdiff_t);
+        case ALOG_LEN_J:  return (uint64_t)va_arg(*ap, intmax_t);
+        case ALOG_LEN_T:  return (uint64_t)(int64_t)va_arg(*ap, ptrdiff_t);
+        default:          return (uint64_t)(int64_t)va_arg(*ap, int);
+    }
+}
+
+static uint64_t alog_get_unsigned(alog_len_t len, va_list *ap) {
+    switch (len) {
+        case ALOG_LEN_L:  return (uint64_t)va_arg(*ap, unsigned long);
+        case ALOG_LEN_LL: return (uint64_t)va_arg(*ap, unsigned long long);
+        case ALOG_LEN_Z:  return (uint64_t)va_arg(*ap, size_t);
+        case ALOG_LEN_J:  return (uint64_t)va_arg(*ap, uintmax_t);
+        case ALOG_LEN_T:  return (uint64_t)va_arg(*ap, ptrdiff_t);
+        default:          return (uint64_t)va_arg(*ap, unsigned int);
+    }
+}
+
+/**
+ * @brief Copy a %s argument into the record
+ *
+ * @return Offset of the copy in strings
+ */
+static uint64_t alog_copy_string(alog_record_t *rec, const char *s, bool *truncated) {
+    uint32_t offset = rec->str_used;
+    uint32_t room = (uint32_t)ALOG_STRING_BYTES - offset;
+
+    if (s == NULL) {
+        s = "(null)";
+    }
+
+    /* Full: point at the terminator of the last copy, an empty string */
+    if (room == 0) {
+        *truncated = true;
+        return ALOG_STRING_BYTES - 1;
+    }
+
+    size_t len = strnlen(s, room);
+    if (len == room) {
+        len = room - 1;
+        *truncated = true;
+    }
+    memcpy(rec->strings + offset, s, len);
+    rec->strings[offset + len] = '\0';
+    rec->str_used = (uint16_t)(offset + len + 1);
+
+    return offset;
+}
+
+/**
+ * @brief Pull the arguments of format off ap into the record
+ *
+ * @return false if the format needs more arguments than a record holds or
+ *         has a conversion the drain cannot replay
+ */
+static bool alog_capture(alog_record_t *rec, const char *format, va_list *ap, bool *truncated) {
+    uint32_t n = 0;
+
+    for (const char *p = format; *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+
+        alog_spec_t spec;
+        alog_parse_spec(p, &spec);
+        p = spec.end - 1;
+        if (spec.conv == '%') {
+            continue;
+        }
+
+        if (n + spec.stars + 1 > ALOG_MAX_ARGS) {
+            return false;
+        }
+        for (uint32_t s = 0; s < spec.stars; s++) {
+            rec->args[n++].u = (uint64_t)(int64_t)va_arg(*ap, int);
+        }
+
+        if (alog_is_signed(spec.conv)) {
+            rec->args[n++].u = alog_get_signed(spec.len, ap);
+        } else if (alog_is_unsigned(spec.conv)) {
+            rec->args[n++].u = alog_get_unsigned(spec.len, ap);
+        } else if (spec.conv == 'c' && spec.len == ALOG_LEN_NONE) {
+            rec->args[n++].u = (uint64_t)va_arg(*ap, int);
+        } else if (alog_is_float(spec.conv)) {
+            rec->args[n++].d = (spec.len == ALOG_LEN_LD) ? (double)va_arg(*ap, long double)
+                                                         : va_arg(*ap, double);
+        } else if (spec.conv == 's' && spec.len == ALOG_LEN_NONE) {
+            rec->args[n++].u = alog_copy_string(rec, va_arg(*ap, const char *), truncated);
+        } else if (spec.conv == 'p') {
+            rec->args[n++].u = (uint64_t)(uintptr_t)va_arg(*ap, void *);
+        } else {
+            return false;       /* %n, %m, wide characters, malformed */
+        }
+    }
+
+    rec->nargs = (uint8_t)n;
+    return true;
+}
+
+/* ==========================================================================
+ * Ring Ownership
+ * ========================================================================== */
+
+static void alog_ring_release(void *ring) {
+    /* Only a claim of the current start; a stop has already reset the rest */
+    if (ring == t_ring && t_generation == atomic_load_explicit(&g_alog.generation,
+                                                                memory_order_relaxed)) {
+        atomic_store_explicit(&((alog_ring_t *)ring)->state, ALOG_RING_RELEASED,
+                              memory_order_release);
+    }
+    t_ring = NULL;
+}
+
+static void alog_make_key(void) {
+    pthread_key_create(&g_ring_key, alog_ring_release);
+}
+
+/**
+ * @brief Claim a free ring for the calling thread
+ */
+static alog_ring_t *alog_claim(unsigned int generation) {
+    for (uint32_t i = 0; i < ALOG_MAX_THREADS; i++) {
+        int expected = ALOG_RING_FREE;
+        if (atomic_compare_exchange_strong_explicit(&g_rings[i].state, &expected,
+                                                    ALOG_RING_OWNED, memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            alog_ring_t *ring = &g_rings[i];
+            ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+            t_ring = ring;
+            t_generation = generation;
+            pthread_setspecific(g_ring_key, ring);
+            return ring;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Add to a counter only the ring's owner writes
+ */
+static inline void alog_owner_add(atomic_uint_least64_t *counter, uint64_t delta) {
+    uint64_t value = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, value + delta, memory_order_relaxed);
+}
+
+bool alog_vlog(int level, const char *module, const char *format, va_list args) {
+    if (!atomic_load_explicit(&g_alog.active, memory_order_acquire) ||
+        module == NULL || format == NULL) {
+        return false;
+    }
+
+    unsigned int generation = atomic_load_explicit(&g_alog.generation, memory_order_relaxed);
+    alog_ring_t *ring = t_ring;
+    if (ring == NULL || t_generation != generation) {
+        ring = alog_claim(generation);
+        if (ring == NULL) {
+            atomic_fetch_add_explicit(&g_alog.fallback, 1, memory_order_relaxed);
+            return false;
+        }
+    }
+
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - ring->cached_head > g_alog.mask) {
+        ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - ring->cached_head > g_alog.mask) {
+            alog_owner_add(&ring->dropped, 1);
+            return true;
+        }
+    }
+
+    alog_record_t *rec = &ring->records[tail & g_alog.mask];
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    rec->time_ns = (uint64_t)ts.tv_sec * ALOG_NS_PER_SEC + (uint64_t)ts.tv_nsec;
+    rec->module = module;
+    rec->format = format;
+    rec->level = level;
+    rec->flags = 0;
+    rec->str_used = 0;
+
+    bool truncated = false;
+    va_list ap;
+    va_copy(ap, args);
+    bool captured = alog_capture(rec, format, &ap, &truncated);
+    va_end(ap);
+
+    if (!captured) {
+        /* Rare formats: format here, the drain copies the text */
+        va_copy(ap, args);
+        int len = vsnprintf(rec->strings, ALOG_STRING_BYTES, format, ap);
+        va_end(ap);
+        rec->flags = ALOG_REC_PREFORMATTED;
+        truncated = len >= (int)ALOG_STRING_BYTES;
+    }
+    if (truncated) {
+        alog_owner_add(&ring->truncated, 1);
+    }
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    alog_owner_add(&ring->captured, 1);
+    return true;
+}
+
+/* ==========================================================================
+ * Drain
+ * ========================================================================== */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+
+/**
+ * @brief snprintf one spec with its star arguments and value
+ */
+#define ALOG_PRINT(value)                                                           \
+    ((spec.stars == 0) ? snprintf(out + pos, size - pos, fmt, value) :             \
+     (spec.stars == 1) ? snprintf(out + pos, size - pos, fmt, star[0], value) :    \
+                         snprintf(out + pos, size - pos, fmt, star[0], star[1], value))
+
+/**
+ * @brief Format a record the way vsnprintf would have
+ */
+static void alog_format(const alog_record_t *rec, char *out, size_t size) {
+    if (rec->flags & ALOG_REC_PREFORMATTED) {
+        snprintf(out, size, "%.*s", (int)ALOG_STRING_BYTES, rec->strings);
+        return;
+    }
+
+    size_t pos = 0;
+    uint32_t n = 0;
+    out[0] = '\0';
+
+    for (const char *p = rec->format; *p != '\0' && pos + 1 < size; p++) {
+        if (*p != '%') {
+            out[pos++] = *p;
+            out[pos] = '\0';
+            continue;
+        }
+
+        alog_spec_t spec;
+        alog_parse_spec(p, &spec);
+        p = spec.end - 1;
+        if (spec.conv == '%') {
+            out[pos++] = '%';
+            out[pos] = '\0';
+            continue;
+        }
+
+        char fmt[ALOG_SPEC_MAX];
+        size_t spec_len = (size_t)(spec.end - spec.start);
+        if (spec_len >= sizeof(fmt) || n + spec.stars >= rec->nargs) {
+            break;
+        }
+        memcpy(fmt, spec.start, spec_len);
+        fmt[spec_len] = '\0';
+
+        int star[2] = { 0, 0 };
+        for (uint32_t s = 0; s < spec.stars; s++) {
+            star[s] = (int)(int64_t)rec->args[n++].u;
+        }
+        alog_arg_t arg = rec->args[n++];
+
+        int written;
+        if (alog_is_signed(spec.conv) || alog_is_unsigned(spec.conv)) {
+            switch (spec.len) {
+                case ALOG_LEN_L:  written = ALOG_PRINT((long)arg.u); break;
+                case ALOG_LEN_LL: written = ALOG_PRINT((long long)arg.u); break;
+                case ALOG_LEN_Z:  written = ALOG_PRINT((size_t)arg.u); break;
+                case ALOG_LEN_J:  written = ALOG_PRINT((intmax_t)arg.u); break;
+                case ALOG_LEN_T:  written = ALOG_PRINT((ptrdiff_t)arg.u); break;
+                default:          written = ALOG_PRINT((int)arg.u); break;
+            }
+        } else if (alog_is_float(spec.conv)) {
+            written = (spec.len == ALOG_LEN_LD) ? ALOG_PRINT((long double)arg.d)
+                                                : ALOG_PRINT(arg.d);
+        } else if (spec.conv == 's') {
+            written = ALOG_PRINT(rec->strings + arg.u);
+        } else if (spec.conv == 'p') {
+            written = ALOG_PRINT((void *)(uintptr_t)arg.u);
+        } else {
+            written = ALOG_PRINT((int)arg.u);
+        }
+
+        if (written < 0) {
+            break;
+        }
+        pos += ((size_t)written < size - pos) ? (size_t)written : size - pos - 1;
+    }
+}
+
+#undef ALOG_PRINT
+#pragma GCC diagnostic pop
+
+/**
+ * @brief Emit one of the logger's own lines
+ */
+static void alog_notice(int level, const char *module, uint64_t time_ns, const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void alog_notice(int level, const char *module, uint64_t time_ns, const char *format, ...) {
+    char message[ALOG_MAX_MESSAGE];
+    va_list ap;
+
+    va_start(ap, format);
+    vsnprintf(message, sizeof(message), format, ap);
+    va_end(ap);
+
+    g_alog.config.sink(level, module, time_ns, message, g_alog.config.sink_data);
+    atomic_fetch_add_explicit(&g_alog.emitted, 1, memory_order_relaxed);
+}
+
+static uint64_t alog_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * ALOG_NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Report repeats folded since the last report
+ */
+static void alog_flush_repeats(uint64_t time_ns) {
+    if (g_alog.repeats > 0) {
+        alog_notice(g_alog.last_level, g_alog.last_module, time_ns,
+                    "last message repeated %u times", g_alog.repeats);
+        g_alog.repeats = 0;
+    }
+    g_alog.repeat_ns = time_ns;
+}
+
+/**
+ * @brief Report rate-limited messages of seconds that are over
+ */
+static void alog_flush_rate(uint64_t now_ns, bool all) {
+    uint64_t second = now_ns / ALOG_NS_PER_SEC;
+
+    for (uint32_t i = 0; i < ALOG_RATE_SLOTS; i++) {
+        alog_rate_t *r = &g_alog.rate[i];
+        if (r->format != NULL && r->suppressed > 0 && (all || r->second < second)) {
+            alog_notice(r->level, r->module, now_ns, "%u messages suppressed (rate limit %u/s)",
+                        r->suppressed, g_alog.config.rate_limit);
+            r->suppressed = 0;
+        }
+    }
+}
+
+/**
+ * @brief Count a message against its format's rate limit
+ *
+ * @return true if it may be emitted
+ */
+static bool alog_rate_check(const alog_record_t *rec) {
+    if (g_alog.config.rate_limit == UINT32_MAX) {
+        return true;
+    }
+
+    uint32_t slot = (uint32_t)(((uintptr_t)rec->format >> 3) % ALOG_RATE_SLOTS);
+    for (uint32_t probe = 0; probe < ALOG_RATE_SLOTS; probe++) {
+        alog_rate_t *r = &g_alog.rate[(slot + probe) % ALOG_RATE_SLOTS];
+
+        if (r->format == NULL) {
+            *r = (alog_rate_t){ .format = rec->format };
+        } else if (r->format != rec->format) {
+            continue;
+        }
+
+        uint64_t second = rec->time_ns / ALOG_NS_PER_SEC;
+        if (r->second != second) {
+            if (r->suppressed > 0) {
+                alog_notice(r->level, r->module, rec->time_ns,
+                            "%u messages suppressed (rate limit %u/s)",
+                            r->suppressed, g_alog.config.rate_limit);
+            }
+            r->second = second;
+            r->count = 0;
+            r->suppressed = 0;
+        }
+        r->module = rec->module;
+        r->level = rec->level;
+
+        if (r->count >= g_alog.config.rate_limit) {
+            r->suppressed++;
+            atomic_fetch_add_explicit(&g_alog.rate_limited, 1, memory_order_relaxed);
+            return false;
+        }
+        r->count++;
+        return true;
+    }
+
+    return true;    /* Table full: not limited */
+}
+
+/**
+ * @brief Format and emit one record
+ */
+static void alog_emit(const alog_record_t *rec) {
+    char message[ALOG_MAX_MESSAGE];
+    alog_format(rec, message, sizeof(message));
+
+    if (!g_alog.config.keep_duplicates && g_alog.last_valid &&
+        rec->level == g_alog.last_level && rec->module == g_alog.last_module &&
+        strcmp(message, g_alog.last) == 0) {
+        g_alog.repeats++;
+        atomic_fetch_add_explicit(&g_alog.duplicates, 1, memory_order_relaxed);
+        if (rec->time_ns - g_alog.repeat_ns >= ALOG_REPEAT_NS) {
+            alog_flush_repeats(rec->time_ns);
+        }
+        return;
+    }
+
+    if (!alog_rate_check(rec)) {
+        return;
+    }
+
+    alog_flush_repeats(rec->time_ns);
+    g_alog.config.sink(rec->level, rec->module, rec->time_ns, message, g_alog.config.sink_data);
+    atomic_fetch_add_explicit(&g_alog.emitted, 1, memory_order_relaxed);
+
+    memcpy(g_alog.last, message, sizeof(message));
+    g_alog.last_module = rec->module;
+    g_alog.last_level = rec->level;
+    g_alog.last_valid = true;
+}
+
+/**
+ * @brief Emit everything queued, oldest first across all rings
+ */
+static void alog_drain_all(void) {
+    for (;;) {
+        alog_ring_t *oldest = NULL;
+        const alog_record_t *oldest_rec = NULL;
+
+        for (uint32_t i = 0; i < ALOG_MAX_THREADS; i++) {
+            alog_ring_t *ring = &g_rings[i];
+            int state = atomic_load_explicit(&ring->state, memory_order_acquire);
+            if (state == ALOG_RING_FREE) {
+                continue;
+            }
+
+            uint64_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+            if (dropped != ring->dropped_seen) {
+                alog_notice(g_alog.config.notice_level, "log", alog_now_ns(),
+                            "%llu messages dropped (log ring %u full)",
+                            (unsigned long long)(dropped - ring->dropped_seen), i);
+                ring->dropped_seen = dropped;
+            }
+
+            uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+            uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+            if (head == tail) {
+                if (state == ALOG_RING_RELEASED) {
+                    atomic_store_explicit(&ring->state, ALOG_RING_FREE, memory_order_release);
+                }
+                continue;
+            }
+
+            const alog_record_t *rec = &ring->records[head & g_alog.mask];
+            if (oldest == NULL || rec->time_ns < oldest_rec->time_ns) {
+                oldest = ring;
+                oldest_rec = rec;
+            }
+        }
+
+        if (oldest == NULL) {
+            return;
+        }
+
+        alog_emit(oldest_rec);
+        atomic_store_explicit(&oldest->head,
+                              atomic_load_explicit(&oldest->head, memory_order_relaxed) + 1,
+                              memory_order_release);
+    }
+}
+
+static void *alog_drain_thread(void *arg) {
+    (void)arg;
+
+    prctl(PR_SET_NAME, "log_drain", 0, 0, 0);
+    if (g_alog.config.nice != 0) {
+        /* Linux: who = 0 is the calling thread */
+        setpriority(PRIO_PROCESS, 0, g_alog.config.nice);
+    }
+
+    pthread_mutex_lock(&g_alog.lock);
+    for (;;) {
+        if (!g_alog.stop && g_alog.flush_done == g_alog.flush_requested) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += (long)g_alog.config.drain_ms * 1000000L;
+            deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+            pthread_cond_timedwait(&g_alog.cond, &g_alog.lock, &deadline);
+        }
+
+        bool stop = g_alog.stop;
+        uint64_t requested = g_alog.flush_requested;
+        pthread_mutex_unlock(&g_alog.lock);
+
+        alog_drain_all();
+
+        uint64_t now = alog_now_ns();
+        bool flushing = stop || requested != g_alog.flush_done;
+        if (flushing || now - g_alog.repeat_ns >= ALOG_REPEAT_NS) {
+            alog_flush_repeats(now);
+        }
+        alog_flush_rate(now, flushing);
+
+        pthread_mutex_lock(&g_alog.lock);
+        g_alog.flush_done = requested;
+        pthread_cond_broadcast(&g_alog.cond);
+        if (stop) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_alog.lock);
+
+    return NULL;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+alog_status_t alog_start(const alog_config_t *config) {
+    if (config == NULL || config->sink == NULL) {
+        return ALOG_ERROR_NULL;
+    }
+
+    if (config->ring_records > ALOG_MAX_RING) {
+        return ALOG_ERROR_PARAM;
+    }
+
+    if (atomic_load(&g_alog.active)) {
+        return ALOG_ERROR_STATE;
+    }
+
+    pthread_once(&g_ring_key_once, alog_make_key);
+
+    uint32_t records = 1;
+    while (records < ((config->ring_records != 0) ? config->ring_records
+                                                  : ALOG_DEFAULT_RING_RECORDS)) {
+        records <<= 1;
+    }
+
+    g_alog.storage = (alog_record_t *)aligned_alloc(
+        ALOG_CACHELINE, (size_t)ALOG_MAX_THREADS * records * sizeof(alog_record_t));
+    if (g_alog.storage == NULL) {
+        return ALOG_ERROR_MEMORY;
+    }
+
+    g_alog.config = *config;
+    if (g_alog.config.drain_ms == 0) {
+        g_alog.config.drain_ms = ALOG_DEFAULT_DRAIN_MS;
+    }
+    if (g_alog.config.rate_limit == 0) {
+        g_alog.config.rate_limit = ALOG_DEFAULT_RATE_LIMIT;
+    }
+    g_alog.mask = records - 1;
+
+    for (uint32_t i = 0; i < ALOG_MAX_THREADS; i++) {
+        alog_ring_t *ring = &g_rings[i];
+        atomic_store(&ring->head, 0);
+        atomic_store(&ring->tail, 0);
+        atomic_store(&ring->captured, 0);
+        atomic_store(&ring->dropped, 0);
+        atomic_store(&ring->truncated, 0);
+        atomic_store(&ring->state, ALOG_RING_FREE);
+        ring->cached_head = 0;
+        ring->dropped_seen = 0;
+        ring->records = g_alog.storage + (size_t)i * records;
+    }
+
+    memset(g_alog.rate, 0, sizeof(g_alog.rate));
+    g_alog.last_valid = false;
+    g_alog.repeats = 0;
+    g_alog.repeat_ns = 0;
+    g_alog.stop = false;
+    g_alog.flush_requested = 0;
+    g_alog.flush_done = 0;
+    atomic_store(&g_alog.fallback, 0);
+    atomic_store(&g_alog.emitted, 0);
+    atomic_store(&g_alog.rate_limited, 0);
+    atomic_store(&g_alog.duplicates, 0);
+
+    atomic_fetch_add(&g_alog.generation, 1);
+    if (pthread_create(&g_alog.drain, NULL, alog_drain_thread, NULL) != 0) {
+        free(g_alog.storage);
+        g_alog.storage = NULL;
+        return ALOG_ERROR_THREAD;
+    }
+
+    atomic_store_explicit(&g_alog.active, true, memory_order_release);
+    return ALOG_OK;
+}
+
+void alog_stop(void) {
+    if (!atomic_exchange(&g_alog.active, false)) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_alog.lock);
+    g_alog.stop = true;
+    pthread_cond_broadcast(&g_alog.cond);
+    pthread_mutex_unlock(&g_alog.lock);
+    pthread_join(g_alog.drain, NULL);
+
+    for (uint32_t i = 0; i < ALOG_MAX_THREADS; i++) {
+        atomic_store(&g_rings[i].state, ALOG_RING_FREE);
+        g_rings[i].records = NULL;
+    }
+    free(g_alog.storage);
+    g_alog.storage = NULL;
+}
+
+bool alog_active(void) {
+    return atomic_load_explicit(&g_alog.active, memory_order_acquire);
+}
+
+alog_status_t alog_flush(uint32_t timeout_ms) {
+    if (!alog_active()) {
+        return ALOG_ERROR_STATE;
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000U;
+    deadline.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+
+    pthread_mutex_lock(&g_alog.lock);
+    uint64_t ticket = ++g_alog.flush_requested;
+    pthread_cond_broadcast(&g_alog.cond);
+
+    int ret = 0;
+    while (g_alog.flush_done < ticket && !g_alog.stop && ret != ETIMEDOUT) {
+        ret = pthread_cond_timedwait(&g_alog.cond, &g_alog.lock, &deadline);
+    }
+    bool done = g_alog.flush_done >= ticket;
+    pthread_mutex_unlock(&g_alog.lock);
+
+    return done ? ALOG_OK : ALOG_ERROR_STATE;
+}
+
+alog_status_t alog_get_stats(alog_stats_t *stats) {
+    if (stats == NULL) {
+        return ALOG_ERROR_NULL;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    for (uint32_t i = 0; i < ALOG_MAX_THREADS; i++) {
+        const alog_ring_t *ring = &g_rings[i];
+        stats->captured += atomic_load_explicit(&ring->captured, memory_order_relaxed);
+        stats->dropped += atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+        stats->truncated += atomic_load_explicit(&ring->truncated, memory_order_relaxed);
+        if (atomic_load_explicit(&ring->state, memory_order_relaxed) == ALOG_RING_OWNED) {
+            stats->rings++;
+        }
+    }
+    stats->fallback = atomic_load_explicit(&g_alog.fallback, memory_order_relaxed);
+    stats->emitted = atomic_load_explicit(&g_alog.emitted, memory_order_relaxed);
+    stats->rate_limited = atomic_load_explicit(&g_alog.rate_limited, memory_order_relaxed);
+    stats->duplicates = atomic_load_explicit(&g_alog.duplicates, memory_order_relaxed);
+
+    return ALOG_OK;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file cpu_dispatch.c
+ * @brief Runtime CPU-feature dispatch for pixel kernels
+ *
+ * Detection runs once (pthread_once):
+ * - AArch64: getauxval(AT_HWCAP) & HWCAP_ASIMD
+ * - x86: cpuid leaf 1 (SSE4.2, F16C, OSXSAVE), xgetbv (OS saves YMM),
+ *   cpuid leaf 7 (AVX2)
+ *
+ * The active level starts at the highest supported level, capped by
+ * DETECTOR_ISA if set, and can be lowered again with cpu_dispatch_init().
+ */
+
+#include "util/cpu_dispatch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(CPU_DISPATCH_NEON)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#elif defined(CPU_DISPATCH_X86)
+#include <cpuid.h>
+#endif
+
+static const char *const cpu_isa_names[CPU_ISA_COUNT] = {
+    [CPU_ISA_SCALAR] = "scalar",
+    [CPU_ISA_NEON] = "neon",
+    [CPU_ISA_SSE42] = "sse4.2",
+    [CPU_ISA_AVX2] = "avx2"
+};
+
+static pthread_once_t cpu_detect_once = PTHREAD_ONCE_INIT;
+static uint32_t cpu_supported_mask;
+static atomic_int cpu_level = CPU_ISA_SCALAR;
+
+/* ==========================================================================
+ * Detection
+ * ========================================================================== */
+
+#if defined(CPU_DISPATCH_X86)
+
+/**
+ * @brief Check that the OS saves XMM and YMM state (XCR0 bits 1 and 2)
+ */
+static bool cpu_os_saves_ymm(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    (void)hi;
+    return (lo & 0x6U) == 0x6U;
+}
+
+#endif
+
+static uint32_t cpu_detect_features(void) {
+    uint32_t mask = 1U << CPU_ISA_SCALAR;
+
+#if defined(CPU_DISPATCH_NEON)
+    if (getauxval(AT_HWCAP) & HWCAP_ASIMD) {
+        mask |= 1U << CPU_ISA_NEON;
+    }
+#elif defined(CPU_DISPATCH_X86)
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return mask;
+    }
+    if (ecx & bit_SSE4_2) {
+        mask |= 1U << CPU_ISA_SSE42;
+    }
+
+    /* AVX2 variants also use F16C for half-float gain maps */
+    bool ymm = (ecx & bit_OSXSAVE) && (ecx & bit_AVX) && cpu_os_saves_ymm();
+    bool f16c = (ecx & bit_F16C) != 0;
+    if (ymm && f16c && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+        (ebx & bit_AVX2)) {
+        mask |= 1U << CPU_ISA_AVX2;
+    }
+#endif
+
+    return mask;
+}
+
+static cpu_isa_t cpu_highest(uint32_t mask, cpu_isa_t cap) {
+    for (int isa = (int)cap; isa > CPU_ISA_SCALAR; isa--) {
+        if (mask & (1U << isa)) {
+            return (cpu_isa_t)isa;
+        }
+    }
+    return CPU_ISA_SCALAR;
+}
+
+/**
+ * @brief Parse an ISA name ("auto" = CPU_ISA_COUNT)
+ *
+ * @return Level, or -1 if unknown
+ */
+static int cpu_parse_isa(const char *name) {
+    if (name == NULL || strcmp(name, "auto") == 0) {
+        return CPU_ISA_COUNT;
+    }
+    for (int isa = 0; isa < CPU_ISA_COUNT; isa++) {
+        if (strcmp(name, cpu_isa_names[isa]) == 0) {
+            return isa;
+        }
+    }
+    return -1;
+}
+
+static void cpu_detect(void) {
+    cpu_supported_mask = cpu_detect_features();
+
+    cpu_isa_t cap = CPU_ISA_COUNT - 1;
+    int env = cpu_parse_isa(getenv(CPU_DISPATCH_ENV));
+    if (env >= 0 && env < CPU_ISA_COUNT) {
+        cap = (cpu_isa_t)env;
+    }
+
+    atomic_store(&cpu_level, (int)cpu_highest(cpu_supported_mask, cap));
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+int cpu_dispatch_init(const char *name) {
+    pthread_once(&cpu_detect_once, cpu_detect);
+
+    int isa = cpu_parse_isa(name);
+    if (isa < 0) {
+        return -EINVAL;
+    }
+
+    if (isa == CPU_ISA_COUNT) {
+        atomic_store(&cpu_level, (int)cpu_highest(cpu_supported_mask, CPU_ISA_COUNT - 1));
+        return 0;
+    }
+
+    if (!(cpu_supported_mask & (1U << isa))) {
+        return -ENOTSUP;
+    }
+
+    atomic_store(&cpu_level, isa);
+    return 0;
+}
+
+uint32_t cpu_dispatch_supported(void) {
+    pthread_once(&cpu_detect_once, cpu_detect);
+    return cpu_supported_mask;
+}
+
+cpu_isa_t cpu_dispatch_level(void) {
+    pthread_once(&cpu_detect_once, cpu_detect);
+    return (cpu_isa_t)atomic_load(&cpu_level);
+}
+
+const char *cpu_dispatch_isa_name(cpu_isa_t isa) {
+    if ((int)isa < 0 || isa >= CPU_ISA_COUNT) {
+        return "unknown";
+    }
+    return cpu_isa_names[isa];
+}
+
+cpu_fn_t cpu_dispatch_select(const cpu_kernel_t *kernel, cpu_isa_t *isa) {
+    cpu_isa_t level = cpu_dispatch_level();
+    const cpu_variant_t *best = NULL;
+
+    for (uint32_t i = 0; i < kernel->variant_count; i++) {
+        const cpu_variant_t *v = &kernel->variants[i];
+        if (v->isa > level || !(cpu_supported_mask & (1U << v->isa))) {
+            continue;
+        }
+        if (best == NULL || v->isa > best->isa) {
+            best = v;
+        }
+    }
+
+    if (isa != NULL) {
+        *isa = (best != NULL) ? best->isa : CPU_ISA_SCALAR;
+    }
+    return (best != NULL) ? best->fn : NULL;
+}
+
+uint32_t cpu_dispatch_selftest(const cpu_kernel_t *const *kernels, size_t count,
+                               uint32_t rounds, cpu_report_fn_t report, void *user_data) {
+    uint32_t supported = cpu_dispatch_supported();
+    uint32_t failures = 0;
+
+    for (size_t k = 0; k < count; k++) {
+        const cpu_kernel_t *kernel = kernels[k];
+        cpu_fn_t reference = NULL;
+
+        for (uint32_t i = 0; i < kernel->variant_count; i++) {
+            if (kernel->variants[i].isa == CPU_ISA_SCALAR) {
+                reference = kernel->variants[i].fn;
+                break;
+            }
+        }
+
+        for (uint32_t i = 0; i < kernel->variant_count; i++) {
+            const cpu_variant_t *v = &kernel->variants[i];
+            if (v->isa == CPU_ISA_SCALAR || !(supported & (1U << v->isa))) {
+                continue;
+            }
+
+            bool passed = (reference != NULL);
+            for (uint32_t r = 0; passed && r < rounds; r++) {
+                passed = kernel->check(v->fn, reference, 0x9E3779B9U * (r + 1));
+            }
+
+            if (!passed) {
+                failures++;
+            }
+            if (report != NULL) {
+                report(kernel, v->isa, passed, user_data);
+            }
+        }
+    }
+
+    return failures;
+}
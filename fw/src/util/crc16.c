@@ -79,3 +79,23 @@ int crc16_verify(const uint8_t *data, size_t len, uint16_t expected_crc) {
     uint16_t computed = crc16_compute(data, len);
     return (computed == expected_crc) ? 1 : 0;
 }
+
+void crc16_shift_init(crc16_shift_t *shift, size_t zeros) {
+    if (shift == NULL) {
+        return;
+    }
+
+    /* Feeding zero bytes is linear in the register, so each half maps alone */
+    for (uint32_t b = 0; b < 256; b++) {
+        uint16_t hi = (uint16_t)(b << 8);
+        uint16_t lo = (uint16_t)b;
+
+        for (size_t i = 0; i < zeros; i++) {
+            hi = (uint16_t)((hi << 8) ^ crc16_table[hi >> 8]);
+            lo = (uint16_t)((lo << 8) ^ crc16_table[lo >> 8]);
+        }
+
+        shift->hi[b] = hi;
+        shift->lo[b] = lo;
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file spsc_queue.c
+ * @brief Bounded lock-free single-producer / single-consumer queue
+ *
+ * head and tail are free-running 32-bit counters masked into the ring.
+ * The producer publishes a slot with a release store of tail and the
+ * consumer frees it with a release store of head; each side reads the
+ * other's counter with acquire only when its cached copy runs out.
+ */
+
+#include "util/spsc_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define SPSC_CACHELINE 64
+
+/**
+ * @brief Queue internal state
+ */
+struct spsc_queue {
+    _Alignas(SPSC_CACHELINE) atomic_uint head;   /**< Next slot to pop (consumer) */
+    uint32_t cached_tail;                        /**< Consumer's view of tail */
+
+    _Alignas(SPSC_CACHELINE) atomic_uint tail;   /**< Next slot to push (producer) */
+    uint32_t cached_head;                        /**< Producer's view of head */
+
+    _Alignas(SPSC_CACHELINE) uint32_t mask;
+    void **slots;
+};
+
+spsc_queue_t *spsc_queue_create(uint32_t capacity) {
+    if (capacity == 0 || capacity > SPSC_MAX_CAPACITY) {
+        return NULL;
+    }
+
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    size_t bytes = (sizeof(spsc_queue_t) + SPSC_CACHELINE - 1) & ~(size_t)(SPSC_CACHELINE - 1);
+    spsc_queue_t *q = (spsc_queue_t *)aligned_alloc(SPSC_CACHELINE, bytes);
+    if (q == NULL) {
+        return NULL;
+    }
+    memset(q, 0, bytes);
+
+    q->slots = (void **)calloc(size, sizeof(void *));
+    if (q->slots == NULL) {
+        free(q);
+        return NULL;
+    }
+
+    q->mask = size - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+
+    return q;
+}
+
+void spsc_queue_destroy(spsc_queue_t *q) {
+    if (q == NULL) {
+        return;
+    }
+
+    free(q->slots);
+    free(q);
+}
+
+bool spsc_queue_push(spsc_queue_t *q, void *item) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (tail - q->cached_head > q->mask) {
+        q->cached_head = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->cached_head > q->mask) {
+            return false;
+        }
+    }
+
+    q->slots[tail & q->mask] = item;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, void **item) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if (head == q->cached_tail) {
+        q->cached_tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->cached_tail) {
+            return false;
+        }
+    }
+
+    *item = q->slots[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+uint32_t spsc_queue_depth(const spsc_queue_t *q) {
+    if (q == NULL) {
+        return 0;
+    }
+
+    uint32_t head = atomic_load_explicit((atomic_uint *)&q->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit((atomic_uint *)&q->tail, memory_order_acquire);
+    uint32_t depth = tail - head;
+
+    /* Transiently inconsistent reads from a third thread */
+    return (depth > q->mask + 1) ? 0 : depth;
+}
+
+uint32_t spsc_queue_capacity(const spsc_queue_t *q) {
+    return (q != NULL) ? q->mask + 1 : 0;
+}
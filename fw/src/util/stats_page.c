@@ -0,0 +1,352 @@
+/**
+ * @file stats_page.c
+ * @brief Shared-memory statistics page with a seqlock
+ *
+ * Values are stored and loaded as relaxed 64-bit atomics, ordered by
+ * fences around the sequence word, so a torn copy is always detected by
+ * the second load of seq and retried. One writer only: the publisher
+ * thread, or the owner calling stats_page_publish() by hand.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "util/stats_page.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#define STATS_PAGE_NAME_MAX     64      /* shm_open name bytes kept */
+#define STATS_PAGE_READ_TRIES   1000    /* Seqlock retries before STATS_PAGE_ERROR_BUSY */
+#define STATS_PAGE_MAX_PERIOD_MS 60000
+
+struct stats_page {
+    char name[STATS_PAGE_NAME_MAX];
+    stats_page_header_t *header;
+    atomic_uint_least64_t *values;
+    size_t size;
+
+    stats_page_fill_fn_t fill;
+    void *user_data;
+    uint32_t period_ms;
+    int nice;
+    uint64_t *scratch;          /**< Filled by the callback, then published */
+
+    pthread_t thread;
+    bool has_thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool stop;
+};
+
+static uint64_t stats_page_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static size_t stats_page_values_offset(uint32_t entry_count) {
+    /* Header and entries are 64 bytes each, so the values start aligned */
+    return sizeof(stats_page_header_t) + (size_t)entry_count * sizeof(stats_page_entry_t);
+}
+
+/* ==========================================================================
+ * Writer
+ * ========================================================================== */
+
+stats_page_status_t stats_page_publish(stats_page_t *page, const uint64_t *values) {
+    if (page == NULL || values == NULL) {
+        return STATS_PAGE_ERROR_NULL;
+    }
+
+    stats_page_header_t *header = page->header;
+    uint32_t seq = atomic_load_explicit(&header->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&header->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        atomic_store_explicit(&page->values[i], values[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&header->update_ns, stats_page_now_ns(), memory_order_relaxed);
+    atomic_store_explicit(&header->updates,
+                          atomic_load_explicit(&header->updates, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+
+    atomic_store_explicit(&header->seq, seq + 2, memory_order_release);
+    return STATS_PAGE_OK;
+}
+
+uint64_t stats_page_gauge(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static void *stats_page_thread(void *arg) {
+    stats_page_t *page = (stats_page_t *)arg;
+
+    prctl(PR_SET_NAME, "stats_page", 0, 0, 0);
+    if (page->nice != 0) {
+        /* Linux: who = 0 is the calling thread */
+        setpriority(PRIO_PROCESS, 0, page->nice);
+    }
+
+    pthread_mutex_lock(&page->lock);
+    while (!page->stop) {
+        pthread_mutex_unlock(&page->lock);
+
+        page->fill(page->scratch, page->user_data);
+        stats_page_publish(page, page->scratch);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += (long)page->period_ms * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+
+        pthread_mutex_lock(&page->lock);
+        if (!page->stop) {
+            pthread_cond_timedwait(&page->cond, &page->lock, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&page->lock);
+
+    return NULL;
+}
+
+static bool stats_page_entries_valid(const stats_page_entry_t *entries, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (memchr(entries[i].name, '\0', STATS_PAGE_NAME_LEN) == NULL ||
+            entries[i].name[0] == '\0' ||
+            entries[i].type > STATS_PAGE_GAUGE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+stats_page_t *stats_page_create(const stats_page_config_t *config) {
+    if (config == NULL || config->entries == NULL ||
+        config->entry_count == 0 || config->entry_count > STATS_PAGE_MAX_ENTRIES ||
+        config->period_ms > STATS_PAGE_MAX_PERIOD_MS ||
+        !stats_page_entries_valid(config->entries, config->entry_count)) {
+        return NULL;
+    }
+
+    const char *name = (config->name != NULL) ? config->name : STATS_PAGE_DEFAULT_NAME;
+    if (name[0] != '/' || strlen(name) >= STATS_PAGE_NAME_MAX) {
+        return NULL;
+    }
+
+    stats_page_t *page = calloc(1, sizeof(*page));
+    if (page == NULL) {
+        return NULL;
+    }
+
+    strcpy(page->name, name);
+    page->size = stats_page_values_offset(config->entry_count) +
+                 (size_t)config->entry_count * sizeof(uint64_t);
+    page->scratch = calloc(config->entry_count, sizeof(uint64_t));
+    if (page->scratch == NULL) {
+        free(page);
+        return NULL;
+    }
+
+    /* A page left by a run that did not stop cleanly is replaced, not reused */
+    shm_unlink(page->name);
+    int fd = shm_open(page->name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        free(page->scratch);
+        free(page);
+        return NULL;
+    }
+
+    void *map = MAP_FAILED;
+    if (ftruncate(fd, (off_t)page->size) == 0) {
+        map = mmap(NULL, page->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(page->name);
+        free(page->scratch);
+        free(page);
+        return NULL;
+    }
+
+    /* The object is zero-filled: values start at 0, seq even, not live */
+    page->header = (stats_page_header_t *)map;
+    page->values = (atomic_uint_least64_t *)((uint8_t *)map +
+                                             stats_page_values_offset(config->entry_count));
+    page->header->magic = STATS_PAGE_MAGIC;
+    page->header->version = STATS_PAGE_VERSION;
+    page->header->header_size = sizeof(stats_page_header_t);
+    page->header->entry_count = config->entry_count;
+    page->header->entry_size = sizeof(stats_page_entry_t);
+    page->header->values_offset = (uint32_t)stats_page_values_offset(config->entry_count);
+    page->header->pid = (uint32_t)getpid();
+    memcpy(page->header + 1, config->entries, config->entry_count * sizeof(stats_page_entry_t));
+    atomic_store_explicit(&page->header->live, 1, memory_order_release);
+
+    page->fill = config->fill;
+    page->user_data = config->user_data;
+    page->period_ms = (config->period_ms != 0) ? config->period_ms : STATS_PAGE_DEFAULT_PERIOD_MS;
+    page->nice = config->nice;
+    pthread_mutex_init(&page->lock, NULL);
+    pthread_cond_init(&page->cond, NULL);
+
+    if (page->fill != NULL) {
+        /* Explicit SCHED_OTHER: never inherit an RT policy from the caller */
+        pthread_attr_t attr;
+        struct sched_param param = { .sched_priority = 0 };
+        pthread_attr_init(&attr);
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+        pthread_attr_setschedparam(&attr, &param);
+        int rc = pthread_create(&page->thread, &attr, stats_page_thread, page);
+        pthread_attr_destroy(&attr);
+
+        if (rc != 0) {
+            stats_page_destroy(page);
+            return NULL;
+        }
+        page->has_thread = true;
+    }
+
+    return page;
+}
+
+void stats_page_destroy(stats_page_t *page) {
+    if (page == NULL) {
+        return;
+    }
+
+    if (page->has_thread) {
+        pthread_mutex_lock(&page->lock);
+        page->stop = true;
+        pthread_cond_signal(&page->cond);
+        pthread_mutex_unlock(&page->lock);
+        pthread_join(page->thread, NULL);
+    }
+
+    atomic_store_explicit(&page->header->live, 0, memory_order_release);
+    munmap(page->header, page->size);
+    shm_unlink(page->name);
+
+    pthread_cond_destroy(&page->cond);
+    pthread_mutex_destroy(&page->lock);
+    free(page->scratch);
+    free(page);
+}
+
+/* ==========================================================================
+ * Reader
+ * ========================================================================== */
+
+stats_page_status_t stats_page_open(const char *name, stats_page_view_t *view) {
+    if (view == NULL) {
+        return STATS_PAGE_ERROR_NULL;
+    }
+
+    memset(view, 0, sizeof(*view));
+    int fd = shm_open((name != NULL) ? name : STATS_PAGE_DEFAULT_NAME, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return STATS_PAGE_ERROR_SHM;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return STATS_PAGE_ERROR_SHM;
+    }
+
+    if ((size_t)st.st_size < sizeof(stats_page_header_t)) {
+        close(fd);
+        return STATS_PAGE_ERROR_FORMAT;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return STATS_PAGE_ERROR_SHM;
+    }
+
+    const stats_page_header_t *header = (const stats_page_header_t *)map;
+    uint32_t count = header->entry_count;
+    if (header->magic != STATS_PAGE_MAGIC ||
+        header->version != STATS_PAGE_VERSION ||
+        header->header_size != sizeof(stats_page_header_t) ||
+        header->entry_size != sizeof(stats_page_entry_t) ||
+        count == 0 || count > STATS_PAGE_MAX_ENTRIES ||
+        header->values_offset != stats_page_values_offset(count) ||
+        (size_t)st.st_size < header->values_offset + (size_t)count * sizeof(uint64_t)) {
+        munmap(map, (size_t)st.st_size);
+        return STATS_PAGE_ERROR_FORMAT;
+    }
+
+    view->header = header;
+    view->entries = (const stats_page_entry_t *)(header + 1);
+    view->values = (const atomic_uint_least64_t *)((const uint8_t *)map + header->values_offset);
+    view->size = (size_t)st.st_size;
+    return STATS_PAGE_OK;
+}
+
+void stats_page_close(stats_page_view_t *view) {
+    if (view == NULL || view->header == NULL) {
+        return;
+    }
+
+    munmap((void *)view->header, view->size);
+    memset(view, 0, sizeof(*view));
+}
+
+stats_page_status_t stats_page_read(const stats_page_view_t *view, uint64_t *values,
+                                    uint64_t *update_ns) {
+    if (view == NULL || view->header == NULL || values == NULL) {
+        return STATS_PAGE_ERROR_NULL;
+    }
+
+    const stats_page_header_t *header = view->header;
+
+    for (uint32_t tries = 0; tries < STATS_PAGE_READ_TRIES; tries++) {
+        uint32_t seq = atomic_load_explicit(&header->seq, memory_order_acquire);
+        if (seq & 1U) {
+            sched_yield();      /* Writer preempted mid-publish */
+            continue;
+        }
+
+        for (uint32_t i = 0; i < header->entry_count; i++) {
+            values[i] = atomic_load_explicit(&view->values[i], memory_order_relaxed);
+        }
+        uint64_t time_ns = atomic_load_explicit(&header->update_ns, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&header->seq, memory_order_relaxed) == seq) {
+            if (update_ns != NULL) {
+                *update_ns = time_ns;
+            }
+            return atomic_load_explicit(&header->live, memory_order_acquire) ?
+                   STATS_PAGE_OK : STATS_PAGE_ERROR_CLOSED;
+        }
+    }
+
+    return STATS_PAGE_ERROR_BUSY;
+}
+
+double stats_page_value(const stats_page_entry_t *entry, uint64_t value) {
+    if (entry != NULL && entry->type == STATS_PAGE_GAUGE) {
+        double gauge;
+        memcpy(&gauge, &value, sizeof(gauge));
+        return gauge;
+    }
+    return (double)value;
+}
@@ -0,0 +1,450 @@
+/**
+ * @file thread_pool.c
+ * @brief Work-stealing thread pool for per-frame image processing
+ *
+ * A job is the range of task indices [0, tasks). Before waking the
+ * workers the caller deals that range out as one contiguous slice per
+ * participant, so each deque is just [top, bottom) over task indices:
+ * - the owner pops from bottom (Chase-Lev pop, CAS only on the last task)
+ * - thieves CAS top forward
+ * Nothing is pushed while a job runs, so no task buffer is needed.
+ *
+ * Join: the caller counts outstanding workers. A worker leaves the job
+ * only after its own deque and every victim's deque were seen empty and
+ * its last task returned, so "no busy workers" means "all tasks done",
+ * and no worker can still touch the deques when the next job re-deals
+ * them.
+ *
+ * Idle workers poll the job generation for `spin` rounds before sleeping
+ * on a condition variable, which keeps wake-up latency low at 15-30 fps
+ * without burning a core between scans.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* pthread_setaffinity_np, CPU_SET */
+#endif
+
+#include "util/thread_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <sys/prctl.h>
+
+#define TP_CACHELINE 64
+
+/**
+ * @brief Per-participant deque over task indices
+ *
+ * top is written by thieves and bottom by the owner, so they live on
+ * separate cache lines. The counters are only written by the owner.
+ */
+typedef struct {
+    _Alignas(TP_CACHELINE) atomic_int top;
+    _Alignas(TP_CACHELINE) atomic_int bottom;
+    uint64_t tasks;             /**< Tasks run by this participant */
+    uint64_t steals;            /**< Of which stolen from others */
+} tp_deque_t;
+
+/**
+ * @brief Steal attempt result
+ */
+typedef enum {
+    TP_STEAL_OK = 0,
+    TP_STEAL_EMPTY,
+    TP_STEAL_RETRY
+} tp_steal_t;
+
+/**
+ * @brief Worker start argument
+ */
+typedef struct {
+    tp_pool_t *pool;
+    uint32_t id;
+} tp_worker_arg_t;
+
+/**
+ * @brief Thread pool internal state
+ */
+struct tp_pool {
+    tp_deque_t deques[TP_MAX_THREADS];
+
+    /* Current job, written by the caller before the generation bump */
+    tp_task_fn_t fn;
+    void *user_data;
+    uint32_t count;
+    uint32_t grain;
+
+    _Alignas(TP_CACHELINE) atomic_uint generation;
+    atomic_uint busy;           /**< Workers still inside the current job */
+    atomic_bool stop;
+
+    uint32_t threads;
+    uint32_t spin;
+    uint32_t started;           /**< Workers successfully created */
+    pthread_t workers[TP_MAX_THREADS];
+    tp_worker_arg_t args[TP_MAX_THREADS];
+
+    pthread_mutex_t lock;       /**< Protects sleeping on wake / done */
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_mutex_t job_lock;   /**< One job at a time */
+
+    atomic_uint pin_failures;
+    tp_stats_t stats;
+};
+
+/* ==========================================================================
+ * Deque (Chase-Lev over an implicit index buffer)
+ * ========================================================================== */
+
+static bool tp_deque_pop(tp_deque_t *d, int *task) {
+    int b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        /* Empty: undo */
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+
+    if (t == b) {
+        /* Last task: race thieves for it */
+        bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                           memory_order_seq_cst,
+                                                           memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        if (!won) {
+            return false;
+        }
+    }
+
+    *task = b;
+    return true;
+}
+
+static tp_steal_t tp_deque_steal(tp_deque_t *d, int *task) {
+    int t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (t >= b) {
+        return TP_STEAL_EMPTY;
+    }
+
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return TP_STEAL_RETRY;
+    }
+
+    *task = t;
+    return TP_STEAL_OK;
+}
+
+/* ==========================================================================
+ * Job Execution
+ * ========================================================================== */
+
+static void tp_run_task(tp_pool_t *pool, int task, uint32_t self) {
+    uint32_t begin = (uint32_t)task * pool->grain;
+    uint32_t end = (pool->count - begin < pool->grain) ? pool->count : begin + pool->grain;
+
+    pool->fn(begin, end, self, pool->user_data);
+    pool->deques[self].tasks++;
+}
+
+/**
+ * @brief Drain own deque, then steal until every deque is empty
+ */
+static void tp_run_job(tp_pool_t *pool, uint32_t self) {
+    tp_deque_t *own = &pool->deques[self];
+    int task;
+
+    while (tp_deque_pop(own, &task)) {
+        tp_run_task(pool, task, self);
+    }
+
+    for (;;) {
+        bool pending = false;
+
+        for (uint32_t k = 1; k < pool->threads; k++) {
+            uint32_t victim = (self + k) % pool->threads;
+            tp_steal_t r;
+
+            /* Keep taking from one victim while it has work */
+            while ((r = tp_deque_steal(&pool->deques[victim], &task)) != TP_STEAL_EMPTY) {
+                if (r == TP_STEAL_OK) {
+                    tp_run_task(pool, task, self);
+                    own->steals++;
+                } else {
+                    pending = true;
+                    break;
+                }
+            }
+        }
+
+        if (!pending) {
+            return;
+        }
+    }
+}
+
+/* ==========================================================================
+ * Workers
+ * ========================================================================== */
+
+/**
+ * @brief Best-effort core pinning and real-time priority for a worker
+ */
+static void tp_worker_setup(tp_pool_t *pool, uint32_t id, uint32_t cpu_mask, int priority) {
+    if (cpu_mask != 0) {
+        uint32_t bits = (uint32_t)__builtin_popcount(cpu_mask);
+        uint32_t nth = id % bits;
+        uint32_t cpu = 0;
+
+        for (uint32_t m = cpu_mask; ; m &= m - 1) {
+            cpu = (uint32_t)__builtin_ctz(m);
+            if (nth-- == 0) {
+                break;
+            }
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pool->workers[id], sizeof(set), &set) != 0) {
+            atomic_fetch_add(&pool->pin_failures, 1);
+        }
+    }
+
+    if (priority > 0) {
+        struct sched_param param = { .sched_priority = priority };
+        if (pthread_setschedparam(pool->workers[id], SCHED_FIFO, &param) != 0) {
+            atomic_fetch_add(&pool->pin_failures, 1);
+        }
+    }
+}
+
+static void *tp_worker_main(void *arg) {
+    tp_worker_arg_t *wa = (tp_worker_arg_t *)arg;
+    tp_pool_t *pool = wa->pool;
+    uint32_t self = wa->id;
+    unsigned seen = 0;
+    char name[16];
+
+    snprintf(name, sizeof(name), "proc_w%u", self);
+    prctl(PR_SET_NAME, name, 0, 0, 0);
+
+    for (;;) {
+        unsigned gen = atomic_load_explicit(&pool->generation, memory_order_acquire);
+
+        for (uint32_t i = 0; gen == seen && i < pool->spin; i++) {
+            if (atomic_load_explicit(&pool->stop, memory_order_relaxed)) {
+                break;
+            }
+            sched_yield();
+            gen = atomic_load_explicit(&pool->generation, memory_order_acquire);
+        }
+
+        if (gen == seen) {
+            pthread_mutex_lock(&pool->lock);
+            while ((gen = atomic_load_explicit(&pool->generation, memory_order_acquire)) == seen &&
+                   !atomic_load_explicit(&pool->stop, memory_order_relaxed)) {
+                pthread_cond_wait(&pool->wake, &pool->lock);
+            }
+            pthread_mutex_unlock(&pool->lock);
+        }
+
+        if (gen == seen) {
+            /* Woken for shutdown with no job pending */
+            break;
+        }
+        seen = gen;
+
+        tp_run_job(pool, self);
+
+        if (atomic_fetch_sub_explicit(&pool->busy, 1, memory_order_acq_rel) == 1) {
+            pthread_mutex_lock(&pool->lock);
+            pthread_cond_signal(&pool->done);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+tp_pool_t *thread_pool_create(const tp_config_t *config) {
+    if (config == NULL || config->threads > TP_MAX_THREADS || config->priority < 0) {
+        return NULL;
+    }
+
+    size_t size = (sizeof(tp_pool_t) + TP_CACHELINE - 1) & ~(size_t)(TP_CACHELINE - 1);
+    tp_pool_t *pool = (tp_pool_t *)aligned_alloc(TP_CACHELINE, size);
+    if (pool == NULL) {
+        return NULL;
+    }
+    memset(pool, 0, size);
+
+    pool->threads = config->threads;
+    if (pool->threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        pool->threads = (online < 1) ? 1 :
+                        (online > TP_MAX_THREADS) ? TP_MAX_THREADS : (uint32_t)online;
+    }
+    pool->spin = (config->spin != 0) ? config->spin : TP_DEFAULT_SPIN;
+
+    atomic_init(&pool->generation, 0);
+    atomic_init(&pool->busy, 0);
+    atomic_init(&pool->stop, false);
+    atomic_init(&pool->pin_failures, 0);
+    for (uint32_t i = 0; i < TP_MAX_THREADS; i++) {
+        atomic_init(&pool->deques[i].top, 0);
+        atomic_init(&pool->deques[i].bottom, 0);
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pthread_mutex_init(&pool->job_lock, NULL);
+
+    for (uint32_t id = 1; id < pool->threads; id++) {
+        pool->args[id].pool = pool;
+        pool->args[id].id = id;
+        if (pthread_create(&pool->workers[id], NULL, tp_worker_main, &pool->args[id]) != 0) {
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->started = id;
+        tp_worker_setup(pool, id, config->cpu_mask, config->priority);
+    }
+
+    pool->stats.threads = pool->threads;
+    return pool;
+}
+
+void thread_pool_destroy(tp_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stop, true);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint32_t id = 1; id <= pool->started; id++) {
+        pthread_join(pool->workers[id], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->job_lock);
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+uint32_t thread_pool_threads(const tp_pool_t *pool) {
+    return (pool != NULL) ? pool->threads : 0;
+}
+
+tp_status_t thread_pool_parallel_for(tp_pool_t *pool, uint32_t count, uint32_t grain,
+                                     tp_task_fn_t fn, void *user_data) {
+    if (pool == NULL || fn == NULL) {
+        return TP_ERROR_NULL;
+    }
+
+    if (count == 0) {
+        return TP_OK;
+    }
+
+    if (grain == 0) {
+        grain = count / (pool->threads * TP_TASKS_PER_THREAD);
+        grain = (grain > 0) ? grain : 1;
+    }
+
+    uint32_t tasks = count / grain + ((count % grain) ? 1 : 0);
+    if (tasks > (uint32_t)INT32_MAX) {
+        return TP_ERROR_PARAM;
+    }
+
+    pthread_mutex_lock(&pool->job_lock);
+
+    pool->stats.jobs++;
+
+    /* Nothing to share: run inline without waking anyone */
+    if (pool->threads == 1 || tasks == 1) {
+        for (uint32_t begin = 0; begin < count; begin += grain) {
+            uint32_t end = (count - begin < grain) ? count : begin + grain;
+            fn(begin, end, 0, user_data);
+        }
+        pool->stats.tasks += tasks;
+        pthread_mutex_unlock(&pool->job_lock);
+        return TP_OK;
+    }
+
+    pool->fn = fn;
+    pool->user_data = user_data;
+    pool->count = count;
+    pool->grain = grain;
+
+    /* Deal contiguous slices so neighbouring bands stay on one core */
+    for (uint32_t p = 0; p < pool->threads; p++) {
+        uint64_t lo = (uint64_t)tasks * p / pool->threads;
+        uint64_t hi = (uint64_t)tasks * (p + 1) / pool->threads;
+        atomic_store_explicit(&pool->deques[p].top, (int)lo, memory_order_relaxed);
+        atomic_store_explicit(&pool->deques[p].bottom, (int)hi, memory_order_relaxed);
+        pool->deques[p].tasks = 0;
+        pool->deques[p].steals = 0;
+    }
+    atomic_store_explicit(&pool->busy, pool->threads - 1, memory_order_relaxed);
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add_explicit(&pool->generation, 1, memory_order_release);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    tp_run_job(pool, 0);
+
+    /* Join: workers finish within one band of us, so poll briefly first */
+    for (uint32_t i = 0; i < pool->spin &&
+         atomic_load_explicit(&pool->busy, memory_order_acquire) != 0; i++) {
+        sched_yield();
+    }
+    if (atomic_load_explicit(&pool->busy, memory_order_acquire) != 0) {
+        pthread_mutex_lock(&pool->lock);
+        while (atomic_load_explicit(&pool->busy, memory_order_acquire) != 0) {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    for (uint32_t p = 0; p < pool->threads; p++) {
+        pool->stats.tasks += pool->deques[p].tasks;
+        pool->stats.steals += pool->deques[p].steals;
+    }
+
+    pthread_mutex_unlock(&pool->job_lock);
+    return TP_OK;
+}
+
+void thread_pool_get_stats(tp_pool_t *pool, tp_stats_t *stats) {
+    if (pool == NULL || stats == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->job_lock);
+    *stats = pool->stats;
+    stats->pin_failures = atomic_load(&pool->pin_failures);
+    pthread_mutex_unlock(&pool->job_lock);
+}
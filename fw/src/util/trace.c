@@ -0,0 +1,356 @@
+/**
+ * @file trace.c
+ * @brief Binary tracepoints in per-CPU flight-recorder rings
+ *
+ * A writer takes a slot with a fetch-add on its CPU's ring head (threads
+ * migrating between CPUs may share a ring, so the head is atomic; the
+ * line is only contended when they do). The slot's sequence word is set
+ * to "in progress" before the fields are written and to index + 1 after,
+ * so the dump can tell a finished record from one being written or
+ * overwritten while it reads, the same check as a seqlock reader.
+ *
+ * Threads are named on their first record (prctl(PR_GET_NAME)); a table
+ * entry is published by storing its tid last.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "util/trace.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+
+#define TRACE_CACHELINE     64
+
+/**
+ * @brief Ring slot: trace_record_t with an atomic sequence word
+ */
+typedef struct {
+    uint64_t time_ns;
+    uint64_t arg0;
+    atomic_uint seq;
+    uint32_t arg1;
+    uint32_t tid;
+    uint16_t event;
+    uint8_t phase;
+    uint8_t cpu;
+} trace_slot_t;
+
+_Static_assert(sizeof(trace_slot_t) == sizeof(trace_record_t), "slot matches record");
+_Static_assert(offsetof(trace_slot_t, seq) == offsetof(trace_record_t, seq), "slot matches record");
+_Static_assert(sizeof(trace_record_t) == 32, "records are 32 bytes");
+
+typedef struct {
+    _Alignas(TRACE_CACHELINE) atomic_uint_least64_t head;   /**< Records taken */
+    trace_slot_t *slots;
+} trace_ring_t;
+
+typedef struct {
+    atomic_uint tid;            /**< 0 until name is written */
+    char name[sizeof(((trace_file_thread_t *)0)->name)];
+} trace_thread_t;
+
+static const trace_file_event_t g_event_info[TRACE_EVENT_COUNT] = {
+    [TRACE_FRAME_GET]     = { "frame_get",     "frame",    "buffer" },
+    [TRACE_FRAME_COMMIT]  = { "frame_commit",  "frame",    "buffer" },
+    [TRACE_FRAME_READY]   = { "frame_ready",   "frame",    "buffer" },
+    [TRACE_FRAME_RELEASE] = { "frame_release", "frame",    "buffer" },
+    [TRACE_ETH_SEND]      = { "eth_send",      "frame",    "flags" },
+    [TRACE_SPI_XFER]      = { "spi_xfer",      "register", "write" },
+    [TRACE_SEQ_STATE]     = { "seq_state",     "from",     "to" },
+    [TRACE_CMD]           = { "command",       "command",  "sequence" },
+};
+
+atomic_bool g_trace_enabled;
+
+static trace_ring_t *g_rings;
+static uint32_t g_ring_count;
+static uint32_t g_ring_mask;            /* records_per_cpu - 1 */
+static trace_thread_t g_threads[TRACE_MAX_THREADS];
+static atomic_uint g_thread_count;
+static atomic_uint g_generation;        /* Bumped by trace_init(); stale thread IDs re-register */
+static pthread_mutex_t g_dump_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Thread_local uint32_t t_tid;
+static _Thread_local uint32_t t_generation;
+
+/* ==========================================================================
+ * Internal Helpers
+ * ========================================================================== */
+
+static uint32_t trace_round_pow2(uint32_t n) {
+    uint32_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief Thread ID of the caller, naming the thread on its first record
+ */
+static uint32_t trace_thread_id(void) {
+    uint32_t generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    if (t_tid != 0 && t_generation == generation) {
+        return t_tid;
+    }
+
+    t_tid = (uint32_t)syscall(SYS_gettid);
+    t_generation = generation;
+
+    uint32_t index = atomic_fetch_add_explicit(&g_thread_count, 1, memory_order_relaxed);
+    if (index < TRACE_MAX_THREADS) {
+        trace_thread_t *thread = &g_threads[index];
+        char name[17] = { 0 };
+        prctl(PR_GET_NAME, name, 0, 0, 0);
+        snprintf(thread->name, sizeof(thread->name), "%s", name);
+        atomic_store_explicit(&thread->tid, t_tid, memory_order_release);
+    }
+    return t_tid;
+}
+
+static void trace_reset_rings(void) {
+    for (uint32_t c = 0; c < g_ring_count; c++) {
+        for (uint32_t i = 0; i <= g_ring_mask; i++) {
+            atomic_store_explicit(&g_rings[c].slots[i].seq, 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&g_rings[c].head, 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Copy a finished record out of its slot
+ *
+ * @return false if the slot does not (or no longer) hold record index
+ */
+static bool trace_read_slot(const trace_ring_t *ring, uint64_t index, trace_record_t *out) {
+    trace_slot_t *slot = &ring->slots[index & g_ring_mask];
+    uint32_t want = (uint32_t)(index + 1);
+
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != want) {
+        return false;
+    }
+    out->time_ns = slot->time_ns;
+    out->arg0 = slot->arg0;
+    out->arg1 = slot->arg1;
+    out->tid = slot->tid;
+    out->event = slot->event;
+    out->phase = slot->phase;
+    out->cpu = slot->cpu;
+    out->seq = want;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->seq, memory_order_relaxed) == want;
+}
+
+/* ==========================================================================
+ * API Implementation
+ * ========================================================================== */
+
+trace_status_t trace_init(uint32_t records_per_cpu) {
+    if (g_rings != NULL) {
+        return TRACE_ERROR_STATE;
+    }
+    if (records_per_cpu == 0) {
+        records_per_cpu = TRACE_DEFAULT_RECORDS;
+    }
+    if (records_per_cpu > TRACE_MAX_RECORDS) {
+        return TRACE_ERROR_PARAM;
+    }
+    records_per_cpu = trace_round_pow2(records_per_cpu);
+
+    long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    if (cpus < 1) {
+        cpus = 1;
+    }
+    if (cpus > TRACE_MAX_CPUS) {
+        cpus = TRACE_MAX_CPUS;
+    }
+
+    trace_ring_t *rings = aligned_alloc(TRACE_CACHELINE, (size_t)cpus * sizeof(trace_ring_t));
+    if (rings == NULL) {
+        return TRACE_ERROR_MEMORY;
+    }
+    for (long c = 0; c < cpus; c++) {
+        rings[c].slots = aligned_alloc(TRACE_CACHELINE, (size_t)records_per_cpu * sizeof(trace_slot_t));
+        if (rings[c].slots == NULL) {
+            for (long f = 0; f < c; f++) {
+                free(rings[f].slots);
+            }
+            free(rings);
+            return TRACE_ERROR_MEMORY;
+        }
+    }
+
+    g_ring_count = (uint32_t)cpus;
+    g_ring_mask = records_per_cpu - 1;
+    g_rings = rings;
+    trace_reset_rings();
+
+    for (uint32_t t = 0; t < TRACE_MAX_THREADS; t++) {
+        atomic_store_explicit(&g_threads[t].tid, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&g_thread_count, 0, memory_order_relaxed);
+    atomic_fetch_add_explicit(&g_generation, 1, memory_order_relaxed);
+    return TRACE_OK;
+}
+
+void trace_deinit(void) {
+    trace_stop();
+    if (g_rings == NULL) {
+        return;
+    }
+    for (uint32_t c = 0; c < g_ring_count; c++) {
+        free(g_rings[c].slots);
+    }
+    free(g_rings);
+    g_rings = NULL;
+    g_ring_count = 0;
+}
+
+trace_status_t trace_start(void) {
+    if (g_rings == NULL) {
+        return TRACE_ERROR_STATE;
+    }
+    atomic_store(&g_trace_enabled, false);
+    trace_reset_rings();
+    atomic_store(&g_trace_enabled, true);
+    return TRACE_OK;
+}
+
+void trace_stop(void) {
+    atomic_store(&g_trace_enabled, false);
+}
+
+bool trace_active(void) {
+    return atomic_load(&g_trace_enabled);
+}
+
+void trace_record(trace_event_t event, trace_phase_t phase, uint64_t arg0, uint32_t arg1) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    int cpu = sched_getcpu();
+    uint32_t ring_index = (cpu < 0) ? 0 : (uint32_t)cpu % g_ring_count;
+    trace_ring_t *ring = &g_rings[ring_index];
+
+    uint64_t index = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    trace_slot_t *slot = &ring->slots[index & g_ring_mask];
+
+    /* "In progress": any value other than index + 1 */
+    atomic_store_explicit(&slot->seq, (uint32_t)index, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot->time_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    slot->arg0 = arg0;
+    slot->arg1 = arg1;
+    slot->tid = trace_thread_id();
+    slot->event = (uint16_t)event;
+    slot->phase = (uint8_t)phase;
+    slot->cpu = (uint8_t)ring_index;
+
+    atomic_store_explicit(&slot->seq, (uint32_t)(index + 1), memory_order_release);
+}
+
+trace_status_t trace_dump(const char *path) {
+    if (path == NULL) {
+        return TRACE_ERROR_NULL;
+    }
+    if (g_rings == NULL) {
+        return TRACE_ERROR_STATE;
+    }
+
+    pthread_mutex_lock(&g_dump_lock);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        pthread_mutex_unlock(&g_dump_lock);
+        return TRACE_ERROR_IO;
+    }
+
+    trace_file_header_t header = {
+        .magic = TRACE_FILE_MAGIC,
+        .version = TRACE_FILE_VERSION,
+        .record_size = sizeof(trace_record_t),
+        .event_count = TRACE_EVENT_COUNT
+    };
+
+    trace_file_thread_t threads[TRACE_MAX_THREADS];
+    uint32_t thread_total = atomic_load_explicit(&g_thread_count, memory_order_relaxed);
+    if (thread_total > TRACE_MAX_THREADS) {
+        thread_total = TRACE_MAX_THREADS;
+    }
+    for (uint32_t t = 0; t < thread_total; t++) {
+        uint32_t tid = atomic_load_explicit(&g_threads[t].tid, memory_order_acquire);
+        if (tid != 0) {
+            threads[header.thread_count].tid = tid;
+            memcpy(threads[header.thread_count].name, g_threads[t].name,
+                   sizeof(threads[0].name));
+            header.thread_count++;
+        }
+    }
+
+    /* Header is rewritten with the record count at the end */
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(g_event_info, sizeof(g_event_info), 1, file) == 1 &&
+              (header.thread_count == 0 ||
+               fwrite(threads, sizeof(threads[0]), header.thread_count, file) == header.thread_count);
+
+    for (uint32_t c = 0; ok && c < g_ring_count; c++) {
+        const trace_ring_t *ring = &g_rings[c];
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t capacity = (uint64_t)g_ring_mask + 1;
+        uint64_t first = (head > capacity) ? head - capacity : 0;
+
+        for (uint64_t i = first; ok && i < head; i++) {
+            trace_record_t record;
+            if (trace_read_slot(ring, i, &record)) {
+                ok = fwrite(&record, sizeof(record), 1, file) == 1;
+                header.record_count++;
+            } else {
+                header.overwritten++;
+            }
+        }
+        header.overwritten += first;
+    }
+
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 &&
+         fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (fclose(file) == 0) && ok;
+
+    pthread_mutex_unlock(&g_dump_lock);
+    return ok ? TRACE_OK : TRACE_ERROR_IO;
+}
+
+trace_status_t trace_get_stats(trace_stats_t *stats) {
+    if (stats == NULL) {
+        return TRACE_ERROR_NULL;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    uint64_t capacity = (uint64_t)g_ring_mask + 1;
+    for (uint32_t c = 0; g_rings != NULL && c < g_ring_count; c++) {
+        uint64_t head = atomic_load_explicit(&g_rings[c].head, memory_order_relaxed);
+        stats->recorded += head;
+        stats->overwritten += (head > capacity) ? head - capacity : 0;
+    }
+    stats->cpus = g_ring_count;
+    uint32_t threads = atomic_load_explicit(&g_thread_count, memory_order_relaxed);
+    stats->threads = (threads > TRACE_MAX_THREADS) ? TRACE_MAX_THREADS : threads;
+    return TRACE_OK;
+}
+
+const char *trace_event_name(trace_event_t event) {
+    if ((int)event < 0 || event >= TRACE_EVENT_COUNT) {
+        return "unknown";
+    }
+    return g_event_info[event].name;
+}
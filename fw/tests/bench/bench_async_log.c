@@ -0,0 +1,138 @@
+/**
+ * @file bench_async_log.c
+ * @brief Cost of one log call on the calling thread
+ *
+ * Times a synchronous log line (clock, localtime_r, strftime, vsnprintf
+ * and a write, as health_monitor_log() did) against alog_vlog(), which
+ * only captures the call. The drain thread writes the same lines to the
+ * same file; its time is not charged to the caller. The ring is flushed
+ * between batches outside the timed region so no record is dropped.
+ *
+ * Usage: bench_async_log [calls]
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "util/async_log.h"
+
+#define BENCH_DEFAULT_CALLS     200000U
+#define BENCH_RING_RECORDS      4096U
+#define BENCH_BATCH             (BENCH_RING_RECORDS / 2)
+
+static FILE *g_out;
+
+/* Thread CPU time: the drain thread's work is not the caller's */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static void write_line(int level, const char *module, uint64_t time_ns,
+                       const char *message, void *user_data) {
+    (void)user_data;
+
+    time_t seconds = (time_t)(time_ns / 1000000000ULL);
+    struct tm tm_info;
+    localtime_r(&seconds, &tm_info);
+
+    char timestamp[64];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm_info);
+    fprintf(g_out, "[%s.%03u] [%s] [%d] %s\n", timestamp,
+            (unsigned int)((time_ns / 1000000ULL) % 1000ULL), module, level, message);
+}
+
+static void log_sync(int level, const char *module, const char *format, ...) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    char message[ALOG_MAX_MESSAGE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    write_line(level, module, (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec,
+               message, NULL);
+}
+
+static void log_async(int level, const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    alog_vlog(level, module, format, args);
+    va_end(args);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t calls = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_CALLS;
+    if (calls == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    g_out = fopen("/dev/null", "w");
+    if (g_out == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Log call benchmark: %u calls, \"frame %%u: drop %%d at %%.2f ms (%%s)\"\n", calls);
+
+    double t0 = bench_now_ns();
+    for (uint32_t i = 0; i < calls; i++) {
+        log_sync(6, "bench", "frame %u: drop %d at %.2f ms (%s)", i, -3, 12.5, "csi2_rx");
+    }
+    double sync_ns = (bench_now_ns() - t0) / calls;
+    printf("synchronous format + write     %7.1f ns/call\n", sync_ns);
+
+    alog_config_t config = {
+        .sink = write_line,
+        .ring_records = BENCH_RING_RECORDS,
+        .rate_limit = UINT32_MAX,
+        .keep_duplicates = true
+    };
+    if (alog_start(&config) != ALOG_OK) {
+        fprintf(stderr, "Setup failed\n");
+        fclose(g_out);
+        return 2;
+    }
+
+    double async_total = 0.0;
+    for (uint32_t done = 0; done < calls; ) {
+        uint32_t batch = (calls - done < BENCH_BATCH) ? calls - done : BENCH_BATCH;
+
+        t0 = bench_now_ns();
+        for (uint32_t i = 0; i < batch; i++) {
+            log_async(6, "bench", "frame %u: drop %d at %.2f ms (%s)", done + i, -3, 12.5, "csi2_rx");
+        }
+        async_total += bench_now_ns() - t0;
+
+        done += batch;
+        alog_flush(5000);
+    }
+    double async_ns = async_total / calls;
+
+    alog_stats_t stats;
+    alog_get_stats(&stats);
+    alog_stop();
+    fclose(g_out);
+
+    int ok = (stats.captured == calls && stats.emitted == calls && stats.dropped == 0);
+    printf("async capture                  %7.1f ns/call  (%.1fx)\n",
+           async_ns, (async_ns > 0.0) ? sync_ns / async_ns : 0.0);
+    printf("captured %llu, emitted %llu, dropped %llu  %s\n",
+           (unsigned long long)stats.captured, (unsigned long long)stats.emitted,
+           (unsigned long long)stats.dropped, ok ? "PASS" : "FAIL");
+
+    return ok ? 0 : 1;
+}
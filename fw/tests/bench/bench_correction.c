@@ -0,0 +1,157 @@
+/**
+ * @file bench_correction.c
+ * @brief Offset/gain correction throughput benchmark
+ *
+ * Corrects 2048x2048 RAW16 frames with Q2.14 and half-float gain maps and
+ * checks the mean per-frame cost against the 15 fps frame period
+ * (66.7 ms). A float32 gain map scalar loop is timed alongside as the
+ * host-side baseline.
+ *
+ * Usage: bench_correction [frames] [width] [height]
+ * Exit status is non-zero if any kernel misses the frame budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/correction.h"
+
+#define BENCH_DEFAULT_FRAMES  50
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_FRAME_RATE      15
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Float32 gain baseline (what the host does today)
+ */
+static void baseline_float(uint16_t *px, const uint16_t *offset, const float *gain, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float v = ((float)px[i] - (float)offset[i]) * gain[i];
+        px[i] = (v <= 0.0f) ? 0 : (v >= 65535.0f) ? 65535 : (uint16_t)(v + 0.5f);
+    }
+}
+
+static void report(const char *name, double min_ms, double sum_ms, double max_ms,
+                   uint32_t frames, size_t bytes_per_pixel, size_t pixels, double budget_ms) {
+    double avg_ms = sum_ms / frames;
+    double gbps = (double)(pixels * bytes_per_pixel) / (avg_ms * 1.0e6);
+
+    printf("%-14s min %7.2f ms  avg %7.2f ms  max %7.2f ms  %6.2f GB/s  %5.1f%% of budget  %s\n",
+           name, min_ms, avg_ms, max_ms, gbps, 100.0 * avg_ms / budget_ms,
+           (avg_ms <= budget_ms) ? "PASS" : "FAIL");
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    size_t pixels = (size_t)width * height;
+    double budget_ms = 1000.0 / BENCH_FRAME_RATE;
+    int failed = 0;
+
+    if (frames == 0 || pixels == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    uint16_t *raw = malloc(pixels * sizeof(uint16_t));
+    uint16_t *offset = malloc(pixels * sizeof(uint16_t));
+    float *gain = malloc(pixels * sizeof(float));
+    if (frame == NULL || raw == NULL || offset == NULL || gain == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        raw[i] = (uint16_t)(1000 + ((seed >> 8) & 0x7FFF));
+        offset[i] = (uint16_t)(800 + ((seed >> 20) & 0xFF));
+        gain[i] = 0.8f + (float)((seed >> 4) & 0x3FF) / 2048.0f;
+    }
+
+    printf("Correction benchmark: %ux%u, %u frames, kernel=%s, budget %.1f ms (%d fps)\n",
+           width, height, frames, correction_get_kernel_name(), budget_ms, BENCH_FRAME_RATE);
+
+    /* Baseline: float32 gain map, 8 bytes of maps per pixel */
+    double min_ms = 1.0e9, max_ms = 0.0, sum_ms = 0.0;
+    for (uint32_t f = 0; f < frames; f++) {
+        memcpy(frame, raw, pixels * sizeof(uint16_t));
+        double t0 = bench_now_ms();
+        baseline_float(frame, offset, gain, pixels);
+        double dt = bench_now_ms() - t0;
+        min_ms = (dt < min_ms) ? dt : min_ms;
+        max_ms = (dt > max_ms) ? dt : max_ms;
+        sum_ms += dt;
+    }
+    report("float32-scalar", min_ms, sum_ms, max_ms, frames, 10, pixels, budget_ms);
+
+    const struct {
+        const char *name;
+        corr_gain_format_t format;
+    } cases[] = {
+        { "q2.14", CORR_GAIN_Q2_14 },
+        { "fp16",  CORR_GAIN_FP16 },
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        corr_config_t config = {
+            .width = width,
+            .height = height,
+            .gain_format = cases[c].format,
+            .band_rows = CORR_DEFAULT_BAND_ROWS
+        };
+
+        correction_t *corr = correction_create(&config);
+        if (corr == NULL) {
+            fprintf(stderr, "correction_create failed\n");
+            return 2;
+        }
+        correction_set_offset_map(corr, offset, pixels);
+        correction_set_gain_map(corr, gain, pixels);
+
+        min_ms = 1.0e9;
+        max_ms = 0.0;
+        sum_ms = 0.0;
+        for (uint32_t f = 0; f < frames; f++) {
+            memcpy(frame, raw, pixels * sizeof(uint16_t));
+            double t0 = bench_now_ms();
+            correction_apply_frame(corr, frame);
+            double dt = bench_now_ms() - t0;
+            min_ms = (dt < min_ms) ? dt : min_ms;
+            max_ms = (dt > max_ms) ? dt : max_ms;
+            sum_ms += dt;
+        }
+
+        /* raw read + write + offset + gain = 8 bytes per pixel */
+        report(cases[c].name, min_ms, sum_ms, max_ms, frames, 8, pixels, budget_ms);
+        if (sum_ms / frames > budget_ms) {
+            failed = 1;
+        }
+
+        correction_destroy(corr);
+    }
+
+    free(frame);
+    free(raw);
+    free(offset);
+    free(gain);
+
+    return failed;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file bench_defect.c
+ * @brief Defect pixel correction scaling benchmark
+ *
+ * Sweep 1: 2048x2048 frame, 0 .. 100k random defective pixels.
+ * Sweep 2: fixed defect count on 1024x1024, 2048x2048 and 4096x4096.
+ *
+ * Per-frame cost must follow the defect count: the 16x larger frame in
+ * sweep 2 may cost at most half of that ratio (cache misses on a larger
+ * frame are allowed, a full-frame scan is not).
+ *
+ * Usage: bench_defect [frames] [defects]
+ * Exit status is non-zero if frame size dominates the cost.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/defect_map.h"
+
+#define BENCH_DEFAULT_FRAMES   50
+#define BENCH_DEFAULT_DEFECTS  10000
+#define BENCH_BAND_ROWS        64
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Mean band-wise apply time for a map with `defects` random pixels
+ *
+ * @return Mean milliseconds per frame, negative on setup failure
+ */
+static double bench_case(uint32_t width, uint32_t height, uint32_t defects,
+                         uint32_t frames, size_t *pixels_out) {
+    defect_config_t config = {
+        .width = width,
+        .height = height,
+        .max_records = (defects > 0) ? defects : 1
+    };
+
+    defect_map_t *dm = defect_map_create(&config);
+    uint16_t *frame = malloc((size_t)width * height * sizeof(uint16_t));
+    if (dm == NULL || frame == NULL) {
+        defect_map_destroy(dm);
+        free(frame);
+        return -1.0;
+    }
+
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < defects; i++) {
+        defect_record_t r = { .type = DEFECT_TYPE_PIXEL };
+        seed = seed * 1664525U + 1013904223U;
+        r.x = (uint16_t)((seed >> 8) % width);
+        seed = seed * 1664525U + 1013904223U;
+        r.y = (uint16_t)((seed >> 8) % height);
+        defect_map_add(dm, &r);
+    }
+    defect_map_commit(dm);
+    *pixels_out = defect_map_count(dm);
+
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        frame[i] = (uint16_t)(i * 2654435761u >> 16);
+    }
+
+    double sum_ms = 0.0;
+    for (uint32_t f = 0; f < frames; f++) {
+        double t0 = bench_now_ms();
+        for (uint32_t row = 0; row < height; row += BENCH_BAND_ROWS) {
+            uint32_t rows = (height - row < BENCH_BAND_ROWS) ? height - row : BENCH_BAND_ROWS;
+            defect_map_apply_rows(dm, frame, row, rows);
+        }
+        sum_ms += bench_now_ms() - t0;
+    }
+
+    defect_map_destroy(dm);
+    free(frame);
+
+    return sum_ms / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t fixed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_DEFECTS;
+    size_t pixels;
+
+    if (frames == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    printf("Defect correction benchmark: %u frames, %u-row bands\n\n", frames, BENCH_BAND_ROWS);
+
+    printf("Sweep 1: 2048x2048, varying defect count\n");
+    const uint32_t counts[] = { 0, 100, 1000, 10000, 100000 };
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        double ms = bench_case(2048, 2048, counts[c], frames, &pixels);
+        if (ms < 0.0) {
+            fprintf(stderr, "Setup failed\n");
+            return 2;
+        }
+        printf("  %6u defects  %9.4f ms/frame  %7.1f ns/defect\n", (unsigned)pixels, ms,
+               (pixels > 0) ? ms * 1.0e6 / (double)pixels : 0.0);
+    }
+
+    printf("\nSweep 2: %u defects, varying frame size\n", fixed);
+    const uint32_t sizes[] = { 1024, 2048, 4096 };
+    double ms_small = 0.0, ms_large = 0.0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double ms = bench_case(sizes[s], sizes[s], fixed, frames, &pixels);
+        if (ms < 0.0) {
+            fprintf(stderr, "Setup failed\n");
+            return 2;
+        }
+        printf("  %4ux%-4u  %6u defects  %9.4f ms/frame  %7.1f ns/defect\n",
+               sizes[s], sizes[s], (unsigned)pixels, ms,
+               (pixels > 0) ? ms * 1.0e6 / (double)pixels : 0.0);
+
+        if (s == 0) {
+            ms_small = ms;
+        }
+        ms_large = ms;
+    }
+
+    /* 4096^2 has 16x the pixels of 1024^2 */
+    double ratio = (ms_small > 0.0) ? ms_large / ms_small : 0.0;
+    int failed = (ratio > 8.0);
+    printf("\n4096x4096 / 1024x1024 cost ratio %.2f (pixel ratio 16.00)  %s\n",
+           ratio, failed ? "FAIL" : "PASS");
+
+    return failed;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file bench_descramble.c
+ * @brief Readout descramble cost against a plain frame copy
+ *
+ * Descrambles 2048x2048 RAW16 frames with typical readout maps (8 ROICs of
+ * 256 columns, alternate ROICs mirrored, dual-side with the bottom half
+ * flipped and mirrored) and compares each with a memcpy of the frame, the
+ * copy the descramble replaces. Buffers rotate through 64 MiB, far more
+ * than the i.MX8M Plus caches hold.
+ *
+ * Usage: bench_descramble [frames] [width] [height]
+ * Exit status is non-zero if a map costs more than twice the plain copy:
+ * both read and write each pixel once, the margin covers the per-move
+ * calls against libc's single whole-frame copy.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/descramble.h"
+
+#define BENCH_DEFAULT_FRAMES  50
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_ROIC_COLS       256
+#define BENCH_BUFFERS         4
+#define BENCH_MAX_RATIO       2.0
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Average ms per frame (d == NULL: plain memcpy)
+ */
+static double bench_run(const descramble_t *d, uint16_t *const *src, uint16_t *const *dst,
+                        size_t bytes, uint32_t frames) {
+    double start = bench_now_ms();
+
+    for (uint32_t f = 0; f < frames; f++) {
+        uint32_t b = f % BENCH_BUFFERS;
+        if (d == NULL) {
+            memcpy(dst[b], src[b], bytes);
+        } else {
+            descramble_apply_frame(d, dst[b], src[b]);
+        }
+    }
+
+    return (bench_now_ms() - start) / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    size_t bytes = (size_t)width * height * sizeof(uint16_t);
+    int failed = 0;
+
+    if (frames == 0 || bytes == 0 || width % BENCH_ROIC_COLS != 0 || height % 2 != 0 ||
+        width / BENCH_ROIC_COLS > DESCRAMBLE_MAX_BLOCKS) {
+        fprintf(stderr, "Invalid arguments (width a multiple of %d, even height)\n",
+                BENCH_ROIC_COLS);
+        return 2;
+    }
+
+    uint16_t *src[BENCH_BUFFERS];
+    uint16_t *dst[BENCH_BUFFERS];
+    uint32_t seed = 1;
+    for (int b = 0; b < BENCH_BUFFERS; b++) {
+        src[b] = malloc(bytes);
+        dst[b] = malloc(bytes);
+        if (src[b] == NULL || dst[b] == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            return 2;
+        }
+        for (size_t i = 0; i < bytes / sizeof(uint16_t); i++) {
+            src[b][i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+        }
+        memset(dst[b], 0, bytes);
+    }
+
+    uint32_t blocks = width / BENCH_ROIC_COLS;
+    desc_config_t maps[3];
+    static const char *const names[3] = {
+        "roic order", "roic mirrored", "dual-side"
+    };
+
+    memset(maps, 0, sizeof(maps));
+    for (int m = 0; m < 3; m++) {
+        maps[m].width = width;
+        maps[m].height = height;
+        maps[m].block_cols = BENCH_ROIC_COLS;
+        maps[m].block_count = (uint8_t)blocks;
+        for (uint32_t b = 0; b < blocks; b++) {
+            maps[m].block_order[b] = (uint8_t)(b ^ 1);     /* ROIC pairs swapped */
+        }
+    }
+    for (uint32_t b = 0; b < blocks; b += 2) {
+        maps[1].mirrored_blocks |= 1U << b;
+        maps[2].mirrored_blocks |= 1U << b;
+    }
+    maps[2].dual_side = true;
+    maps[2].bottom_flipped = true;
+    maps[2].bottom_mirrored = true;
+
+    printf("Descramble benchmark: %ux%u, %u frames, kernel=%s\n",
+           width, height, frames, descramble_get_kernel_name());
+
+    bench_run(NULL, src, dst, bytes, BENCH_BUFFERS);    /* Warm up */
+    double copy_ms = bench_run(NULL, src, dst, bytes, frames);
+    printf("%-14s %7.2f ms/frame  %6.2f GB/s\n", "memcpy", copy_ms,
+           2.0 * (double)bytes / (copy_ms * 1.0e6));
+
+    for (int m = 0; m < 3; m++) {
+        descramble_t *d = descramble_create(&maps[m]);
+        if (d == NULL) {
+            fprintf(stderr, "Setup failed: %s\n", names[m]);
+            return 2;
+        }
+
+        bench_run(d, src, dst, bytes, BENCH_BUFFERS);
+        double ms = bench_run(d, src, dst, bytes, frames);
+        double ratio = ms / copy_ms;
+        bool pass = ratio <= BENCH_MAX_RATIO;
+
+        printf("%-14s %7.2f ms/frame  %6.2f GB/s  %2u/%-2u moves  %.2fx copy  %s\n",
+               names[m], ms, 2.0 * (double)bytes / (ms * 1.0e6),
+               descramble_op_count(d, false), descramble_op_count(d, true), ratio,
+               pass ? "PASS" : "FAIL");
+        failed |= !pass;
+
+        descramble_destroy(d);
+    }
+
+    for (int b = 0; b < BENCH_BUFFERS; b++) {
+        free(src[b]);
+        free(dst[b]);
+    }
+
+    return failed ? 1 : 0;
+}
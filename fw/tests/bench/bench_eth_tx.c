@@ -0,0 +1,188 @@
+/**
+ * @file bench_eth_tx.c
+ * @brief Packetization cost with and without the geometry packet plan
+ *
+ * Compares the two eth_tx_send_frame() paths on one frame geometry:
+ * - header CRC: full CRC-16 of every header vs. the per-frame base CRC
+ *   patched with packet_index (checked bit-exact for every packet)
+ * - packetization: whole frames sent to a loopback socket, generic path
+ *   (per-packet allocation, copy and CRC) vs. eth_tx_set_geometry() plan
+ *
+ * Loopback stands in for the 10 GbE link, so absolute times include the
+ * kernel's UDP send path but no wire time. The stream keeps up while the
+ * planned path stays under one frame period.
+ *
+ * Usage: bench_eth_tx [frames] [size] [fps] [bit_depth]
+ * Exit status is non-zero on a CRC mismatch or if the planned path cannot
+ * keep up.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal/eth_tx.h"
+#include "util/crc16.h"
+
+#define BENCH_DEFAULT_FRAMES  20
+#define BENCH_DEFAULT_SIZE    3072
+#define BENCH_DEFAULT_FPS     30
+#define BENCH_DEFAULT_DEPTH   16
+#define BENCH_DATA_PORT       18000
+#define BENCH_CMD_PORT        18001
+#define BENCH_CRC_ROUNDS      50
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Header CRC per packet, full vs. patched
+ *
+ * @return 0 if both agree on every packet, 1 otherwise
+ */
+static int bench_crc(uint32_t packets) {
+    const size_t crc_len = offsetof(eth_frame_header_t, header_crc);
+    const size_t tail = crc_len - offsetof(eth_frame_header_t, packet_index) - sizeof(uint32_t);
+    eth_frame_header_t header = {
+        .magic = ETH_FRAME_MAGIC, .frame_number = 1234, .width = 3072, .height = 3072,
+        .bit_depth = 16, .total_packets = packets, .payload_len = 8160, .timestamp = 99
+    };
+    crc16_shift_t shift;
+    crc16_shift_init(&shift, tail);
+
+    uint16_t *full = malloc(packets * sizeof(uint16_t));
+    uint16_t *patched = malloc(packets * sizeof(uint16_t));
+    if (full == NULL || patched == NULL) {
+        free(full);
+        free(patched);
+        return 1;
+    }
+
+    double t0 = bench_now_ms();
+    for (uint32_t r = 0; r < BENCH_CRC_ROUNDS; r++) {
+        for (uint32_t i = 0; i < packets; i++) {
+            header.packet_index = i;
+            full[i] = crc16_compute((const uint8_t *)&header, crc_len);
+        }
+    }
+    double t1 = bench_now_ms();
+    for (uint32_t r = 0; r < BENCH_CRC_ROUNDS; r++) {
+        header.packet_index = 0;
+        uint16_t base = crc16_compute((const uint8_t *)&header, crc_len);
+        for (uint32_t i = 0; i < packets; i++) {
+            uint8_t index[sizeof(uint32_t)];
+            memcpy(index, &i, sizeof(index));
+            patched[i] = (uint16_t)(base ^ crc16_shift_apply(&shift,
+                crc16_compute_with_init(index, sizeof(index), 0)));
+        }
+    }
+    double t2 = bench_now_ms();
+
+    int mismatch = memcmp(full, patched, packets * sizeof(uint16_t)) != 0;
+    double scale = 1.0e6 / ((double)BENCH_CRC_ROUNDS * packets);
+    printf("header CRC    generic %8.1f ns/packet  planned %8.1f ns/packet  %s\n",
+           (t1 - t0) * scale, (t2 - t1) * scale, mismatch ? "MISMATCH" : "match");
+
+    free(full);
+    free(patched);
+    return mismatch;
+}
+
+/**
+ * @brief Average send time per frame in ms
+ */
+static double bench_send(eth_tx_t *eth, const uint16_t *frame, size_t frame_size,
+                         uint32_t size, uint16_t bit_depth, uint32_t frames) {
+    double total = 0.0;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        double t0 = bench_now_ms();
+        eth_tx_status_t status = eth_tx_send_frame(eth, frame, frame_size, size, size,
+                                                   bit_depth, f);
+        total += bench_now_ms() - t0;
+        if (status != ETH_TX_OK) {
+            fprintf(stderr, "Send failed: %s\n", eth_get_error(eth));
+            return -1.0;
+        }
+    }
+
+    return total / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    uint32_t fps = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_FPS;
+    uint16_t bit_depth = (argc > 4) ? (uint16_t)strtoul(argv[4], NULL, 0) : BENCH_DEFAULT_DEPTH;
+    size_t frame_size = (size_t)size * size * sizeof(uint16_t);
+
+    if (frames == 0 || size == 0 || fps == 0 || bit_depth <= 8 || bit_depth > 16) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(frame_size);
+    if (frame == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+    for (size_t i = 0; i < frame_size / sizeof(uint16_t); i++) {
+        frame[i] = (uint16_t)(i & ((1U << bit_depth) - 1));
+    }
+
+    eth_tx_config_t config = {
+        .dest_ip = "127.0.0.1",
+        .data_port = BENCH_DATA_PORT,
+        .cmd_port = BENCH_CMD_PORT,
+        .mtu = ETH_DEFAULT_MTU,
+        .max_payload = ETH_DEFAULT_MAX_PAYLOAD,
+        .enable_crc = true,
+        .fps = (double)fps
+    };
+    eth_tx_t *eth = eth_tx_create(&config);
+    if (eth == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        free(frame);
+        return 2;
+    }
+
+    uint32_t packets = (uint32_t)eth_tx_calc_packet_count(eth, frame_size);
+    printf("Ethernet TX benchmark: %ux%ux%u, %u packets/frame, %u frames\n",
+           size, size, bit_depth, packets, frames);
+
+    int failed = bench_crc(packets);
+
+    double generic_ms = bench_send(eth, frame, frame_size, size, bit_depth, frames);
+    eth_tx_set_geometry(eth, size, size, bit_depth);
+    double planned_ms = bench_send(eth, frame, frame_size, size, bit_depth, frames);
+    if (generic_ms < 0.0 || planned_ms < 0.0) {
+        failed = 1;
+    }
+
+    double limit_ms = 1000.0 / fps;
+    double gbit = (double)frame_size * 8.0 / 1.0e6;
+    printf("packetize     generic %8.3f ms/frame (%5.2f Gbit/s)\n",
+           generic_ms, gbit / generic_ms);
+    printf("packetize     planned %8.3f ms/frame (%5.2f Gbit/s), limit %.3f ms at %u fps  %s\n",
+           planned_ms, gbit / planned_ms, limit_ms, fps,
+           (planned_ms <= limit_ms) ? "PASS" : "FAIL");
+    if (planned_ms > limit_ms) {
+        failed = 1;
+    }
+
+    eth_tx_destroy(eth);
+    free(frame);
+    return failed;
+}
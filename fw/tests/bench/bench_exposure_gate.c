@@ -0,0 +1,119 @@
+/**
+ * @file bench_exposure_gate.c
+ * @brief Exposure gate cost per frame and link bytes per empty frame
+ *
+ * Times exposure_gate_check() on a dark frame (the case that must stay
+ * cheap, since every frame pays for it) and exposure_gate_decimate() on
+ * the frames it would bin, and prints the bytes each action puts on the
+ * link for an empty frame.
+ *
+ * Usage: bench_exposure_gate [frames] [size] [fps]
+ * Exit status is non-zero if check plus decimation exceed a frame period.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/exposure_gate.h"
+
+#define BENCH_DEFAULT_FRAMES  50
+#define BENCH_DEFAULT_SIZE    3072
+#define BENCH_DEFAULT_FPS     30
+#define BENCH_HEADER_BYTES    32
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    uint32_t fps = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_FPS;
+    size_t pixels = (size_t)size * size;
+
+    if (frames == 0 || size == 0 || fps == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *dark = malloc(pixels * sizeof(uint16_t));
+    uint16_t *work = malloc(pixels * sizeof(uint16_t));
+    if (dark == NULL || work == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    /* Dark frame: offset 1000 with +-16 counts of noise */
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        dark[i] = (uint16_t)(1000 - 16 + (cpu_dispatch_random(&seed) >> 27));
+    }
+
+    egate_config_t config = {
+        .dark_level = 1000, .action = EGATE_ACTION_DECIMATE
+    };
+    exposure_gate_t *gate = exposure_gate_create(&config);
+    if (gate == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Exposure gate benchmark: %ux%u, %u frames, row step %d, kernel=%s\n",
+           size, size, frames, EGATE_DEFAULT_ROW_STEP, exposure_gate_get_kernel_name());
+
+    double check_ms = 0.0;
+    double decimate_ms = 0.0;
+    uint32_t out_width = 0;
+    uint32_t out_height = 0;
+    for (uint32_t f = 0; f < frames; f++) {
+        egate_result_t result;
+        memcpy(work, dark, pixels * sizeof(uint16_t));
+
+        double t0 = bench_now_ms();
+        exposure_gate_check(gate, work, size, size, &result);
+        double t1 = bench_now_ms();
+        if (result.verdict != EGATE_VERDICT_DECIMATE) {
+            fprintf(stderr, "Dark frame %u not gated (mean %u, max %u)\n",
+                    f, result.mean, result.max);
+            return 1;
+        }
+        out_width = size;
+        out_height = size;
+        exposure_gate_decimate(gate, work, &out_width, &out_height);
+        double t2 = bench_now_ms();
+
+        check_ms += t1 - t0;
+        decimate_ms += t2 - t1;
+    }
+    check_ms /= frames;
+    decimate_ms /= frames;
+
+    double total_ms = check_ms + decimate_ms;
+    double limit_ms = 1000.0 / fps;
+    printf("check                  %8.3f ms/frame (%.2f %% of the frame period)\n",
+           check_ms, 100.0 * check_ms / limit_ms);
+    printf("decimate x%-2d          %8.3f ms/frame\n", EGATE_DEFAULT_DECIMATE, decimate_ms);
+    printf("total                  %8.3f ms/frame, limit %.3f ms at %u fps  %s\n",
+           total_ms, limit_ms, fps, (total_ms <= limit_ms) ? "PASS" : "FAIL");
+
+    size_t full = pixels * sizeof(uint16_t);
+    size_t binned = (size_t)out_width * out_height * sizeof(uint16_t);
+    printf("empty frame on the link: tag %zu B, decimate %zu B (%.2f %%), drop %d B\n",
+           full, binned, 100.0 * (double)binned / (double)full, BENCH_HEADER_BYTES);
+
+    exposure_gate_destroy(gate);
+    free(work);
+    free(dark);
+    return (total_ms <= limit_ms) ? 0 : 1;
+}
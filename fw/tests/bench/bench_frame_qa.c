@@ -0,0 +1,124 @@
+/**
+ * @file bench_frame_qa.c
+ * @brief Image QA cost on top of the statistics stage
+ *
+ * Runs the statistics stage the way the daemon does, band by band, once
+ * with frame statistics alone and once with the QA metrics riding along,
+ * and reports the added time per frame. The QA share must stay under 5%
+ * of a 15 fps frame period.
+ *
+ * Usage: bench_frame_qa [frames] [size] [row_step]
+ * Exit status is non-zero if the QA cost exceeds that budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/frame_stats.h"
+#include "proc/frame_qa.h"
+
+#define BENCH_DEFAULT_FRAMES  50
+#define BENCH_DEFAULT_SIZE    3072
+#define BENCH_BAND_ROWS       32
+#define BENCH_FPS             15
+#define BENCH_QA_SHARE        0.05      /* Of the frame period */
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Average ms per frame of the band-wise stats stage (qa may be NULL)
+ */
+static double bench_run(const fstats_config_t *stats_config, frame_qa_t *qa,
+                        const uint16_t *frame, uint32_t size, uint32_t frames) {
+    static fstats_t stats;
+    fqa_result_t result;
+    double start = bench_now_ms();
+
+    for (uint32_t f = 0; f < frames; f++) {
+        frame_stats_begin(stats_config, &stats);
+        if (qa != NULL) {
+            frame_qa_begin(qa);
+        }
+        for (uint32_t row = 0; row < size; row += BENCH_BAND_ROWS) {
+            uint32_t rows = (size - row < BENCH_BAND_ROWS) ? size - row : BENCH_BAND_ROWS;
+            frame_stats_accumulate_rows(stats_config, frame, row, rows, &stats);
+            if (qa != NULL) {
+                frame_qa_accumulate_rows(qa, frame, row, rows);
+            }
+        }
+        frame_stats_finish(&stats);
+        if (qa != NULL) {
+            frame_qa_finish(qa, &result);
+        }
+    }
+
+    return (bench_now_ms() - start) / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    uint32_t row_step = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 0;
+    size_t pixels = (size_t)size * size;
+    double limit_ms = BENCH_QA_SHARE * 1000.0 / BENCH_FPS;
+
+    if (frames == 0 || size == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    if (frame == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        frame[i] = (uint16_t)(20000 + (cpu_dispatch_random(&seed) >> 20));
+    }
+
+    /* The daemon's statistics geometry: 8x8 grid, central ROI */
+    fstats_config_t stats_config = {
+        .width = size, .height = size,
+        .roi_x = size / 4, .roi_y = size / 4, .roi_width = size / 2, .roi_height = size / 2
+    };
+    fqa_config_t qa_config = { .width = size, .height = size, .row_step = row_step };
+    frame_qa_t *qa = frame_qa_create(&qa_config);
+    if (qa == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Image QA benchmark: %ux%u, row step %u, %u frames, kernel=%s\n",
+           size, size, (row_step != 0) ? row_step : FQA_DEFAULT_ROW_STEP, frames,
+           frame_qa_get_kernel_name());
+
+    bench_run(&stats_config, qa, frame, size, 2);   /* Warm up */
+    double stats_ms = bench_run(&stats_config, NULL, frame, size, frames);
+    double fused_ms = bench_run(&stats_config, qa, frame, size, frames);
+    double qa_ms = fused_ms - stats_ms;
+
+    printf("stats                  %8.3f ms/frame\n", stats_ms);
+    printf("stats + qa             %8.3f ms/frame\n", fused_ms);
+    printf("qa added               %8.3f ms/frame (%.1f%% of %d fps), limit %.3f ms  %s\n",
+           qa_ms, qa_ms * BENCH_FPS / 10.0, BENCH_FPS, limit_ms,
+           (qa_ms <= limit_ms) ? "PASS" : "FAIL");
+
+    frame_qa_destroy(qa);
+    free(frame);
+    return (qa_ms <= limit_ms) ? 0 : 1;
+}
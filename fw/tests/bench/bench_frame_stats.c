@@ -0,0 +1,131 @@
+/**
+ * @file bench_frame_stats.c
+ * @brief Auto-exposure statistics kernel latency benchmark
+ *
+ * Times frame_stats_compute plus one ae_update on 2048x2048 RAW16 frames
+ * for several sampling grids. The default grid must finish within
+ * BENCH_BUDGET_MS so the auto-exposure loop closes well inside one 30 fps
+ * frame period (33.3 ms) together with the register write.
+ *
+ * Usage: bench_frame_stats [frames] [width] [height]
+ * Exit status is non-zero if the default grid misses the budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/frame_stats.h"
+#include "proc/auto_exposure.h"
+
+#define BENCH_DEFAULT_FRAMES  200
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_FRAME_RATE      30
+#define BENCH_BUDGET_MS       0.5
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    size_t pixels = (size_t)width * height;
+    int failed = 0;
+
+    if (frames == 0 || pixels == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    /* Two frames alternated so every pass streams from DRAM, not cache */
+    uint16_t *frame[2] = { malloc(pixels * sizeof(uint16_t)), malloc(pixels * sizeof(uint16_t)) };
+    fstats_t *stats = malloc(sizeof(fstats_t));
+    if (frame[0] == NULL || frame[1] == NULL || stats == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        frame[0][i] = (uint16_t)(2000 + ((seed >> 8) & 0x3FFF));
+        frame[1][i] = (uint16_t)(frame[0][i] + 100);
+    }
+
+    ae_config_t ae_config;
+    ae_config_defaults(&ae_config);
+    ae_exposure_t initial = { 0x0010, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&ae_config, &initial);
+
+    printf("Frame statistics benchmark: %ux%u, %u frames, kernel=%s, budget %.2f ms "
+           "(%.1f%% of %d fps period)\n",
+           width, height, frames, frame_stats_get_kernel_name(), BENCH_BUDGET_MS,
+           100.0 * BENCH_BUDGET_MS * BENCH_FRAME_RATE / 1000.0, BENCH_FRAME_RATE);
+
+    const struct {
+        uint32_t row_step;
+        uint32_t col_step;
+        bool gated;
+    } grids[] = {
+        { 1, 1, false },
+        { 2, 2, false },
+        { 4, 4, false },
+        { FSTATS_DEFAULT_STEP, FSTATS_DEFAULT_STEP, true },
+    };
+
+    for (size_t g = 0; g < sizeof(grids) / sizeof(grids[0]); g++) {
+        fstats_config_t config = {
+            .width = width,
+            .height = height,
+            .row_step = grids[g].row_step,
+            .col_step = grids[g].col_step,
+            .roi_x = width / 4,
+            .roi_y = height / 4,
+            .roi_width = width / 2,
+            .roi_height = height / 2
+        };
+
+        double min_ms = 1.0e9, max_ms = 0.0, sum_ms = 0.0;
+        for (uint32_t f = 0; f < frames; f++) {
+            ae_exposure_t next;
+            double t0 = bench_now_ms();
+            frame_stats_compute(&config, frame[f & 1], stats);
+            ae_update(ae, stats, &next);
+            double dt = bench_now_ms() - t0;
+            min_ms = (dt < min_ms) ? dt : min_ms;
+            max_ms = (dt > max_ms) ? dt : max_ms;
+            sum_ms += dt;
+        }
+
+        double avg_ms = sum_ms / frames;
+        bool pass = avg_ms <= BENCH_BUDGET_MS;
+        printf("grid %ux%-2u  min %6.3f ms  avg %6.3f ms  max %6.3f ms  p99 %5u  %s\n",
+               grids[g].row_step, grids[g].col_step, min_ms, avg_ms, max_ms,
+               frame_stats_percentile(stats, 0.99f),
+               grids[g].gated ? (pass ? "PASS" : "FAIL") : "(info)");
+
+        if (grids[g].gated && !pass) {
+            failed = 1;
+        }
+    }
+
+    ae_destroy(ae);
+    free(frame[0]);
+    free(frame[1]);
+    free(stats);
+
+    return failed;
+}
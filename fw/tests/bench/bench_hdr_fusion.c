@@ -0,0 +1,112 @@
+/**
+ * @file bench_hdr_fusion.c
+ * @brief Dual-gain HDR fusion cost per output frame
+ *
+ * Feeds alternating low/high-gain frames through hdr_fusion_submit() the
+ * way the hdr stage does and reports the time per fused pair: the copy of
+ * the held low-gain frame plus the fusion pass. A pair arrives every two
+ * frame periods, so the stage keeps up while that stays under 2 / fps.
+ *
+ * Usage: bench_hdr_fusion [pairs] [size] [fps]
+ * Exit status is non-zero if fusion cannot keep up.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/hdr_fusion.h"
+
+#define BENCH_DEFAULT_PAIRS   20
+#define BENCH_DEFAULT_SIZE    3072
+#define BENCH_DEFAULT_FPS     30
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t pairs = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_PAIRS;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    uint32_t fps = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_FPS;
+    size_t pixels = (size_t)size * size;
+
+    if (pairs == 0 || size == 0 || fps == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *low = malloc(pixels * sizeof(uint16_t));
+    uint16_t *high = malloc(pixels * sizeof(uint16_t));
+    uint16_t *work = malloc(pixels * sizeof(uint16_t));
+    if (low == NULL || high == NULL || work == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    /* 14-bit scene, high gain 4x: a quarter of the pixels saturate */
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        uint16_t v = (uint16_t)(cpu_dispatch_random(&seed) >> 18);
+        low[i] = v;
+        high[i] = (uint16_t)((v < 4096) ? v * 4 : 16383);
+    }
+
+    hdr_config_t config = {
+        .width = size, .height = size,
+        .low_gain = 0x0080, .high_gain = 0x0200, .blend = 1024
+    };
+    hdr_fusion_t *hdr = hdr_fusion_create(&config);
+    if (hdr == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("HDR fusion benchmark: %ux%u, %u pairs, kernel=%s\n",
+           size, size, pairs, hdr_fusion_get_kernel_name());
+
+    double hold_ms = 0.0;
+    double fuse_ms = 0.0;
+    hdr_pair_t pair;
+    for (uint32_t p = 0; p < pairs; p++) {
+        double t0 = bench_now_ms();
+        hdr_fusion_submit(hdr, low, 2 * p, &pair);
+        double t1 = bench_now_ms();
+        memcpy(work, high, pixels * sizeof(uint16_t));
+        double t2 = bench_now_ms();
+        hdr_fusion_submit(hdr, work, 2 * p + 1, &pair);
+        double t3 = bench_now_ms();
+
+        hold_ms += t1 - t0;
+        fuse_ms += t3 - t2;
+        if (pair != HDR_PAIR_FUSED) {
+            fprintf(stderr, "Pair %u not fused\n", p);
+            return 1;
+        }
+    }
+    hold_ms /= pairs;
+    fuse_ms /= pairs;
+
+    double total_ms = hold_ms + fuse_ms;
+    double limit_ms = 2000.0 / fps;
+    printf("hold low-gain frame    %8.3f ms/pair\n", hold_ms);
+    printf("fuse                   %8.3f ms/pair\n", fuse_ms);
+    printf("total                  %8.3f ms/pair, limit %.3f ms at %u fps  %s\n",
+           total_ms, limit_ms, fps, (total_ms <= limit_ms) ? "PASS" : "FAIL");
+
+    hdr_fusion_destroy(hdr);
+    free(work);
+    free(high);
+    free(low);
+    return (total_ms <= limit_ms) ? 0 : 1;
+}
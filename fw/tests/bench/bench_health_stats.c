@@ -0,0 +1,115 @@
+/**
+ * @file bench_health_stats.c
+ * @brief Cost of one runtime counter update
+ *
+ * Times health_monitor_update_stat() by name against
+ * health_monitor_add_stat() by ID on one thread, then the ID update on
+ * 1-4 threads at once (each thread in its own counter block, so the cost
+ * should not grow with the thread count). Totals are checked afterwards:
+ * a lost update fails the run.
+ *
+ * Usage: bench_health_stats [updates_per_thread]
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "health_monitor.h"
+#include "sequence_engine.h"
+#include "hal/spi_master.h"
+#include "hal/bq40z50_driver.h"
+
+#define BENCH_DEFAULT_UPDATES   10000000U
+#define BENCH_MAX_THREADS       4
+
+/* health_monitor.c reads these for the status collector only; not used here */
+seq_state_t seq_get_state(void) { return SEQ_STATE_IDLE; }
+int bq40z50_read_metrics(bq40z50_context_t *ctx, battery_metrics_t *metrics) {
+    (void)ctx; (void)metrics;
+    return -1;
+}
+spi_status_t spi_read_register(spi_master_t *spi, uint8_t addr, uint16_t *data) {
+    (void)spi; (void)addr; (void)data;
+    return SPI_ERROR_CLOSED;
+}
+
+static uint32_t g_updates;
+
+/* Thread CPU time, so threads time-sliced on fewer cores are not charged */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static double bench_by_name(void) {
+    double t0 = bench_now_ns();
+    for (uint32_t i = 0; i < g_updates; i++) {
+        health_monitor_update_stat("frames_dropped", 1);
+    }
+    return (bench_now_ns() - t0) / g_updates;
+}
+
+static void *bench_by_id(void *arg) {
+    double *ns = (double *)arg;
+
+    double t0 = bench_now_ns();
+    for (uint32_t i = 0; i < g_updates; i++) {
+        health_monitor_add_stat(HEALTH_STAT_FRAMES_SENT, 1);
+    }
+    *ns = (bench_now_ns() - t0) / g_updates;
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    g_updates = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_UPDATES;
+    if (g_updates == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    if (health_monitor_init() != 0) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Counter update benchmark: %u updates per thread\n", g_updates);
+    printf("by name (\"frames_dropped\")      %6.2f ns/update\n", bench_by_name());
+
+    uint64_t expected = 0;
+    for (uint32_t n = 1; n <= BENCH_MAX_THREADS; n++) {
+        pthread_t threads[BENCH_MAX_THREADS];
+        double ns[BENCH_MAX_THREADS];
+        double worst = 0.0;
+
+        for (uint32_t t = 0; t < n; t++) {
+            pthread_create(&threads[t], NULL, bench_by_id, &ns[t]);
+        }
+        for (uint32_t t = 0; t < n; t++) {
+            pthread_join(threads[t], NULL);
+            worst = (ns[t] > worst) ? ns[t] : worst;
+        }
+        expected += (uint64_t)n * g_updates;
+
+        printf("by id, %u thread(s)              %6.2f ns/update (slowest thread)\n", n, worst);
+    }
+
+    uint64_t sent = health_monitor_read_stat(HEALTH_STAT_FRAMES_SENT);
+    uint64_t dropped = health_monitor_read_stat(HEALTH_STAT_FRAMES_DROPPED);
+    int ok = (sent == expected && dropped == g_updates);
+    printf("totals: frames_sent %llu of %llu, frames_dropped %llu of %u  %s\n",
+           (unsigned long long)sent, (unsigned long long)expected,
+           (unsigned long long)dropped, g_updates, ok ? "PASS" : "FAIL");
+
+    health_monitor_deinit();
+    return ok ? 0 : 1;
+}
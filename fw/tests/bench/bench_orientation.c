@@ -0,0 +1,125 @@
+/**
+ * @file bench_orientation.c
+ * @brief Orientation transform throughput: naive vs cache-blocked
+ *
+ * Rotates 4096x4096 RAW16 frames by 90 degrees with the pixel-by-pixel
+ * reference, the blocked out-of-place transform and the in-place stage
+ * the daemon runs, then times every transform of the in-place stage.
+ * The in-place rot90 must fit one 15 fps frame period (66.7 ms).
+ *
+ * Usage: bench_orientation [frames] [size]
+ * Exit status is non-zero if the in-place rot90 misses the budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/orientation.h"
+
+#define BENCH_DEFAULT_FRAMES  10
+#define BENCH_DEFAULT_SIZE    4096
+#define BENCH_FPS             15
+
+typedef enum {
+    BENCH_NAIVE,
+    BENCH_BLOCKED,
+    BENCH_IN_PLACE
+} bench_path_t;
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Average ms per frame of one transform path
+ */
+static double bench_run(bench_path_t path, orient_t t, uint16_t *frame, uint16_t *out,
+                        uint32_t size, uint32_t frames) {
+    orient_config_t config = { .width = size, .height = size, .transform = t };
+    orientation_t *o = (path == BENCH_IN_PLACE) ? orientation_create(&config) : NULL;
+    if (path == BENCH_IN_PLACE && o == NULL) {
+        return -1.0;
+    }
+
+    double start = bench_now_ms();
+    for (uint32_t f = 0; f < frames; f++) {
+        switch (path) {
+        case BENCH_NAIVE:
+            orientation_transform_naive(t, out, frame, size, size);
+            break;
+        case BENCH_BLOCKED:
+            orientation_transform(t, out, frame, size, size);
+            break;
+        case BENCH_IN_PLACE:
+            orientation_apply_frame(o, frame);
+            break;
+        }
+    }
+    double ms = (bench_now_ms() - start) / frames;
+
+    orientation_destroy(o);
+    return ms;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    size_t pixels = (size_t)size * size;
+    double budget_ms = 1000.0 / BENCH_FPS;
+
+    if (frames == 0 || size == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    uint16_t *out = malloc(pixels * sizeof(uint16_t));
+    if (frame == NULL || out == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        frame[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+    memset(out, 0, pixels * sizeof(uint16_t));
+
+    printf("Orientation benchmark: %ux%u, %u frames, kernel=%s, budget %.1f ms (%d fps)\n",
+           size, size, frames, orientation_get_kernel_name(), budget_ms, BENCH_FPS);
+
+    double naive_ms = bench_run(BENCH_NAIVE, ORIENT_ROT90, frame, out, size, frames);
+    double blocked_ms = bench_run(BENCH_BLOCKED, ORIENT_ROT90, frame, out, size, frames);
+    double in_place_ms = bench_run(BENCH_IN_PLACE, ORIENT_ROT90, frame, out, size, frames);
+    if (in_place_ms < 0.0) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("rot90 naive      %8.2f ms/frame\n", naive_ms);
+    printf("rot90 blocked    %8.2f ms/frame  %5.1fx naive\n", blocked_ms, naive_ms / blocked_ms);
+    printf("rot90 in place   %8.2f ms/frame  %5.1fx naive  %5.1f%% of budget  %s\n",
+           in_place_ms, naive_ms / in_place_ms, 100.0 * in_place_ms / budget_ms,
+           (in_place_ms <= budget_ms) ? "PASS" : "FAIL");
+
+    printf("In-place stage by transform:\n");
+    for (int t = ORIENT_FLIP_H; t < ORIENT_COUNT; t++) {
+        double ms = bench_run(BENCH_IN_PLACE, (orient_t)t, frame, out, size, frames);
+        printf("  %-12s %8.2f ms/frame\n", orientation_name((orient_t)t), ms);
+    }
+
+    free(frame);
+    free(out);
+    return (in_place_ms <= budget_ms) ? 0 : 1;
+}
@@ -0,0 +1,660 @@
+/**
+ * @file bench_pipeline.c
+ * @brief DRAM traffic of staged vs fused (band by band) pipeline execution
+ *
+ * Runs the continuous-scan chain correction -> defects -> saturation ->
+ * temporal -> stats -> pack over 2048x2048 RAW16 frames, once with one
+ * whole-frame pass per stage (PIPE_EXEC_STAGED) and once with the band
+ * stages fused into L2-sized bands (PIPE_EXEC_FUSED). "pack" stands in
+ * for the packetizer and reads the whole frame.
+ *
+ * DRAM traffic is read from hardware counters (perf_event_open), 64 bytes
+ * per count:
+ * - AArch64: L2D_CACHE_REFILL + L2D_CACHE_WB (user space, inherited by
+ *   the stage threads)
+ * - x86: memory controller CAS reads + writes (uncore_imc PMUs,
+ *   system-wide), else last-level cache misses (user space, inherited)
+ * and reported per frame and in frame-sized passes. Counters may be
+ * unavailable (perf_event_paranoid, VMs, containers); traffic is then
+ * reported as not measured, with the reason, and not gated.
+ *
+ * Usage: bench_pipeline [frames] [width] [height] [band_rows]
+ * Exit status is non-zero if fused output differs from staged output, or
+ * if measured fused traffic exceeds BENCH_TRAFFIC_BUDGET of staged.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* syscall */
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "proc/pipeline.h"
+#include "proc/correction.h"
+#include "proc/defect_map.h"
+#include "proc/saturation.h"
+#include "proc/temporal_filter.h"
+#include "proc/frame_stats.h"
+
+#define BENCH_DEFAULT_FRAMES  30
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_BUFFERS         4       /* Frame manager default */
+#define BENCH_LINE_BYTES      64
+#define BENCH_TRAFFIC_BUDGET  0.90    /* Fused bytes / staged bytes */
+
+/**
+ * @brief Stage modules shared by both variants
+ */
+typedef struct {
+    correction_t *corr;
+    defect_map_t *defects;
+    sat_counter_t *sat;
+    tf_filter_t *tf;
+    fstats_config_t stats_config;
+    fstats_t stats;
+    uint64_t checksum;
+} bench_ctx_t;
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/* ==========================================================================
+ * Hardware Counters
+ * ========================================================================== */
+
+#define BENCH_PERF_MAX      16
+#define BENCH_UNCORE_IMC_MAX 32
+#define BENCH_PMU_DIR       "/sys/bus/event_source/devices"
+
+typedef struct {
+    int fd[BENCH_PERF_MAX];
+    int count;
+    const char *source;         /* What is counted, for the report */
+    int error;                  /* errno of the last failed open */
+} bench_perf_t;
+
+static int perf_open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.inherit = 1;           /* Stage threads created after open */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* Uncore PMUs count per socket, not per task: no inherit, no exclude bits */
+static int perf_open_uncore(uint32_t type, uint64_t config, int cpu) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+
+    return (int)syscall(SYS_perf_event_open, &attr, -1, cpu, -1, 0);
+}
+
+static void perf_close(bench_perf_t *perf) {
+    for (int i = 0; i < perf->count; i++) {
+        close(perf->fd[i]);
+    }
+    perf->count = 0;
+}
+
+static bool perf_add(bench_perf_t *perf, int fd) {
+    if (fd < 0) {
+        perf->error = errno;
+        return false;
+    }
+    if (perf->count >= BENCH_PERF_MAX) {
+        close(fd);
+        perf->error = EMFILE;
+        return false;
+    }
+    perf->fd[perf->count++] = fd;
+    return true;
+}
+
+static bool sysfs_read(const char *path, char *buf, size_t size) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return false;
+    }
+    bool ok = fgets(buf, (int)size, f) != NULL;
+    fclose(f);
+    if (ok) {
+        buf[strcspn(buf, "\n")] = '\0';
+    }
+    return ok;
+}
+
+/**
+ * @brief Encode a sysfs PMU event ("event=0x04,umask=0x03") as attr.config
+ *
+ * Each term's bit position comes from the PMU's format/<term> file
+ * ("config:8-15"); terms in config1/config2 are not supported.
+ */
+static bool uncore_event_config(const char *pmu, const char *event, uint64_t *config) {
+    char path[256];
+    char terms[128];
+
+    snprintf(path, sizeof(path), "%s/%s/events/%s", BENCH_PMU_DIR, pmu, event);
+    if (!sysfs_read(path, terms, sizeof(terms))) {
+        return false;
+    }
+
+    *config = 0;
+    char *save = NULL;
+    for (char *term = strtok_r(terms, ",", &save); term != NULL;
+         term = strtok_r(NULL, ",", &save)) {
+        char *eq = strchr(term, '=');
+        uint64_t value = 1;
+        if (eq != NULL) {
+            *eq = '\0';
+            value = strtoull(eq + 1, NULL, 0);
+        }
+
+        char format[64];
+        unsigned int lo = 0;
+        snprintf(path, sizeof(path), "%s/%s/format/%s", BENCH_PMU_DIR, pmu, term);
+        if (!sysfs_read(path, format, sizeof(format)) ||
+            sscanf(format, "config:%u", &lo) != 1 || lo > 63) {
+            return false;
+        }
+        *config |= value << lo;
+    }
+    return true;
+}
+
+/**
+ * @brief Count memory controller CAS reads and writes on every socket
+ *
+ * x86 uncore_imc_<n> PMUs: one CAS moves one 64-byte line to or from
+ * DRAM. The count is system-wide, so other load on the machine adds to it.
+ * Needs perf_event_paranoid <= 0 or CAP_PERFMON.
+ */
+static bool perf_start_uncore(bench_perf_t *perf) {
+    static const char *const events[] = { "cas_count_read", "cas_count_write" };
+
+    for (int n = 0; n < BENCH_UNCORE_IMC_MAX; n++) {
+        char pmu[32];
+        char path[256];
+        char value[128];
+
+        snprintf(pmu, sizeof(pmu), "uncore_imc_%d", n);
+        snprintf(path, sizeof(path), "%s/%s/type", BENCH_PMU_DIR, pmu);
+        if (!sysfs_read(path, value, sizeof(value))) {
+            continue;
+        }
+        uint32_t type = (uint32_t)strtoul(value, NULL, 10);
+
+        /* One CPU per socket, e.g. "0,28" */
+        snprintf(path, sizeof(path), "%s/%s/cpumask", BENCH_PMU_DIR, pmu);
+        if (!sysfs_read(path, value, sizeof(value))) {
+            continue;
+        }
+
+        for (int e = 0; e < 2; e++) {
+            uint64_t config;
+            if (!uncore_event_config(pmu, events[e], &config)) {
+                continue;
+            }
+            for (char *cpu = value; *cpu != '\0';) {
+                char *next = NULL;
+                int id = (int)strtol(cpu, &next, 10);
+                if (next == cpu) {
+                    break;
+                }
+                if (!perf_add(perf, perf_open_uncore(type, config, id))) {
+                    /* Partial coverage would under-count: all or nothing */
+                    perf_close(perf);
+                    return false;
+                }
+                cpu = (*next == ',') ? next + 1 : next;
+            }
+        }
+    }
+
+    return perf->count > 0;
+}
+
+/**
+ * @brief Open DRAM traffic counters for this thread and its future children
+ *
+ * @return true if counting; otherwise perf->error says why not
+ */
+static bool perf_start(bench_perf_t *perf) {
+    perf->count = 0;
+    perf->source = NULL;
+    perf->error = ENOENT;
+
+#if defined(__aarch64__)
+    /* ARMv8 PMU: L2D_CACHE_REFILL (0x17), L2D_CACHE_WB (0x18) */
+    static const uint64_t events[] = { 0x17, 0x18 };
+    for (int i = 0; i < 2; i++) {
+        if (!perf_add(perf, perf_open_event(PERF_TYPE_RAW, events[i]))) {
+            break;
+        }
+    }
+    perf->source = "L2 refills + write-backs";
+#else
+    if (perf_start_uncore(perf)) {
+        perf->source = "memory controller CAS, system-wide";
+        return true;
+    }
+    perf_add(perf, perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES));
+    perf->source = "last-level cache misses";
+#endif
+
+    return perf->count > 0;
+}
+
+/**
+ * @brief Stop counting and return bytes moved (0 if not counting)
+ */
+static uint64_t perf_stop(bench_perf_t *perf) {
+    uint64_t lines = 0;
+
+    for (int i = 0; i < perf->count; i++) {
+        uint64_t value = 0;
+        if (read(perf->fd[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+            lines += value;
+        }
+    }
+    perf_close(perf);
+
+    return lines * BENCH_LINE_BYTES;
+}
+
+/**
+ * @brief Current perf_event_paranoid level (-100 if unreadable)
+ */
+static int perf_paranoid(void) {
+    char value[16];
+    if (!sysfs_read("/proc/sys/kernel/perf_event_paranoid", value, sizeof(value))) {
+        return -100;
+    }
+    return atoi(value);
+}
+
+/* ==========================================================================
+ * Stages
+ * ========================================================================== */
+
+static int corr_frame(pipe_frame_t *frame, void *user_data) {
+    correction_apply_frame(((bench_ctx_t *)user_data)->corr, frame->data);
+    return PIPE_CONTINUE;
+}
+
+static void corr_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                      void *user_data) {
+    correction_apply_rows(((bench_ctx_t *)user_data)->corr, frame->data, row_start, row_count);
+}
+
+static int defect_frame(pipe_frame_t *frame, void *user_data) {
+    defect_map_apply_frame(((bench_ctx_t *)user_data)->defects, frame->data);
+    return PIPE_CONTINUE;
+}
+
+static void defect_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                        void *user_data) {
+    defect_map_apply_rows(((bench_ctx_t *)user_data)->defects, frame->data, row_start, row_count);
+}
+
+static void sat_begin(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    saturation_begin_frame(((bench_ctx_t *)user_data)->sat);
+}
+
+static void sat_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                     void *user_data) {
+    saturation_count_rows(((bench_ctx_t *)user_data)->sat, frame->data, row_start, row_count);
+}
+
+static int sat_end(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    saturation_end_frame(((bench_ctx_t *)user_data)->sat, NULL);
+    return PIPE_CONTINUE;
+}
+
+static void tf_begin(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    temporal_filter_begin_frame(((bench_ctx_t *)user_data)->tf);
+}
+
+static void tf_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                    void *user_data) {
+    temporal_filter_apply_rows(((bench_ctx_t *)user_data)->tf, frame->data, row_start, row_count);
+}
+
+static int tf_end(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    temporal_filter_end_frame(((bench_ctx_t *)user_data)->tf);
+    return PIPE_CONTINUE;
+}
+
+static int stats_frame(pipe_frame_t *frame, void *user_data) {
+    bench_ctx_t *ctx = (bench_ctx_t *)user_data;
+    frame_stats_compute(&ctx->stats_config, frame->data, &ctx->stats);
+    return PIPE_CONTINUE;
+}
+
+static void stats_begin(pipe_frame_t *frame, void *user_data) {
+    bench_ctx_t *ctx = (bench_ctx_t *)user_data;
+    (void)frame;
+    frame_stats_begin(&ctx->stats_config, &ctx->stats);
+}
+
+static void stats_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                       void *user_data) {
+    bench_ctx_t *ctx = (bench_ctx_t *)user_data;
+    frame_stats_accumulate_rows(&ctx->stats_config, frame->data, row_start, row_count,
+                                &ctx->stats);
+}
+
+static int stats_end(pipe_frame_t *frame, void *user_data) {
+    (void)frame;
+    frame_stats_finish(&((bench_ctx_t *)user_data)->stats);
+    return PIPE_CONTINUE;
+}
+
+/* Packetizer stand-in: reads every pixel once */
+static int pack_frame(pipe_frame_t *frame, void *user_data) {
+    bench_ctx_t *ctx = (bench_ctx_t *)user_data;
+    const uint64_t *words = (const uint64_t *)frame->data;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < frame->size / sizeof(uint64_t); i++) {
+        sum += words[i];
+    }
+    ctx->checksum += sum;
+    return PIPE_CONTINUE;
+}
+
+static pipe_registry_t *bench_registry(bench_ctx_t *ctx) {
+    static const pipe_band_ops_t corr_ops = { .rows = corr_rows };
+    static const pipe_band_ops_t defect_ops = {
+        .rows = defect_rows, .lag_rows = DEFECT_BAND_LAG_ROWS
+    };
+    static const pipe_band_ops_t sat_ops = { .begin = sat_begin, .rows = sat_rows, .end = sat_end };
+    static const pipe_band_ops_t tf_ops = { .begin = tf_begin, .rows = tf_rows, .end = tf_end };
+    static const pipe_band_ops_t stats_ops = { .begin = stats_begin, .rows = stats_rows, .end = stats_end };
+
+    pipe_registry_t *reg = pipeline_registry_create();
+    if (reg == NULL ||
+        pipeline_register_band_stage(reg, "correction", corr_frame, &corr_ops, ctx) != PIPE_OK ||
+        pipeline_register_band_stage(reg, "defects", defect_frame, &defect_ops, ctx) != PIPE_OK ||
+        pipeline_register_band_stage(reg, "saturation", NULL, &sat_ops, ctx) != PIPE_OK ||
+        pipeline_register_band_stage(reg, "temporal", NULL, &tf_ops, ctx) != PIPE_OK ||
+        pipeline_register_band_stage(reg, "stats", stats_frame, &stats_ops, ctx) != PIPE_OK ||
+        pipeline_register_stage(reg, "pack", pack_frame, ctx) != PIPE_OK) {
+        pipeline_registry_destroy(reg);
+        return NULL;
+    }
+
+    return reg;
+}
+
+/* ==========================================================================
+ * Variants
+ * ========================================================================== */
+
+/**
+ * @brief Push frames through a pipeline, cycling over the buffers
+ *
+ * @return Wall time in ms, or a negative value if the pipeline failed
+ */
+static double run(const pipe_registry_t *reg, pipe_exec_t exec, uint32_t band_rows,
+                  uint16_t *const *buffers, uint32_t width, uint32_t height,
+                  uint32_t frames) {
+    static const char *const chain[] = {
+        "correction", "defects", "saturation", "temporal", "stats", "pack"
+    };
+    pipe_config_t config = {
+        .registry = reg,
+        .stages = chain,
+        .stage_count = sizeof(chain) / sizeof(chain[0]),
+        .queue_depth = BENCH_BUFFERS,
+        .exec = exec,
+        .band_rows = band_rows
+    };
+
+    double t0 = bench_now_ms();
+    pipeline_t *pipe = pipeline_create(&config);
+    if (pipe == NULL) {
+        return -1.0;
+    }
+
+    /* Frames complete in order, so buffer f % BENCH_BUFFERS is free once
+     * frame f gets a descriptor */
+    for (uint32_t f = 0; f < frames; f++) {
+        pipe_frame_t frame = {
+            .data = buffers[f % BENCH_BUFFERS],
+            .size = (size_t)width * height * sizeof(uint16_t),
+            .frame_number = f,
+            .width = width,
+            .height = height
+        };
+        while (pipeline_submit(pipe, &frame) == PIPE_ERROR_FULL) {
+            struct timespec ts = { .tv_sec = 0, .tv_nsec = 50000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    pipeline_drain(pipe, 60000);
+    pipeline_destroy(pipe);
+    return bench_now_ms() - t0;
+}
+
+/**
+ * @brief Process the same two raw frames with fresh filter history
+ *
+ * @param out Output of the second frame
+ * @param stats Statistics of the second frame
+ */
+static bool run_reference(bench_ctx_t *ctx, const pipe_registry_t *reg, pipe_exec_t exec,
+                          uint32_t band_rows, const uint16_t *raw, uint16_t *const *buffers,
+                          uint32_t width, uint32_t height, uint16_t *out, fstats_t *stats) {
+    size_t bytes = (size_t)width * height * sizeof(uint16_t);
+
+    temporal_filter_reset(ctx->tf);
+    memcpy(buffers[0], raw, bytes);
+    memcpy(buffers[1], raw + (size_t)width, bytes - width * sizeof(uint16_t));
+    memcpy((uint8_t *)buffers[1] + bytes - width * sizeof(uint16_t), raw, width * sizeof(uint16_t));
+
+    if (run(reg, exec, band_rows, buffers, width, height, 2) < 0.0) {
+        return false;
+    }
+
+    memcpy(out, buffers[1], bytes);
+    *stats = ctx->stats;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    uint32_t band_rows = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : PIPE_DEFAULT_BAND_ROWS;
+    size_t pixels = (size_t)width * height;
+    size_t bytes = pixels * sizeof(uint16_t);
+
+    if (frames == 0 || pixels == 0 || band_rows == 0 || width % 4 != 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *raw = malloc(bytes);
+    uint16_t *offset = malloc(bytes);
+    float *gain = malloc(pixels * sizeof(float));
+    uint16_t *ref_staged = malloc(bytes);
+    uint16_t *ref_fused = malloc(bytes);
+    uint16_t *buffers[BENCH_BUFFERS];
+    for (int i = 0; i < BENCH_BUFFERS; i++) {
+        buffers[i] = malloc(bytes);
+        if (buffers[i] == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            return 2;
+        }
+    }
+    if (raw == NULL || offset == NULL || gain == NULL || ref_staged == NULL || ref_fused == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    /* Mid-range signal with a bright 1/16 of the frame near saturation */
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        raw[i] = (uint16_t)(((i / width) % 16 == 0 ? 59000 : 8000) + ((seed >> 8) & 0x7FF));
+        offset[i] = (uint16_t)(800 + ((seed >> 20) & 0xFF));
+        gain[i] = 0.9f + (float)((seed >> 4) & 0x3FF) / 4096.0f;
+    }
+
+    bench_ctx_t ctx = {
+        .stats_config = {
+            .width = width, .height = height,
+            .roi_x = width / 4, .roi_y = height / 4,
+            .roi_width = width / 2, .roi_height = height / 2
+        }
+    };
+
+    corr_config_t corr_config = {
+        .width = width, .height = height, .gain_format = CORR_GAIN_Q2_14
+    };
+    defect_config_t defect_config = {
+        .width = width, .height = height, .max_records = DEFECT_DEFAULT_MAX_RECORDS
+    };
+    sat_config_t sat_config = { .width = width, .height = height };
+    tf_config_t tf_config = { .width = width, .height = height };
+    temporal_filter_params_defaults(&tf_config.params);
+    tf_config.params.enabled = 1;
+
+    ctx.corr = correction_create(&corr_config);
+    ctx.defects = defect_map_create(&defect_config);
+    ctx.sat = saturation_create(&sat_config);
+    ctx.tf = temporal_filter_create(&tf_config);
+    if (ctx.corr == NULL || ctx.defects == NULL || ctx.sat == NULL || ctx.tf == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+    correction_set_offset_map(ctx.corr, offset, pixels);
+    correction_set_gain_map(ctx.corr, gain, pixels);
+
+    /* A few hundred defects, including lines that cross band boundaries */
+    for (uint32_t i = 0; i < 256; i++) {
+        defect_record_t rec = {
+            .type = DEFECT_TYPE_PIXEL,
+            .x = (uint16_t)((i * 7919U) % width),
+            .y = (uint16_t)((i * 104729U) % height)
+        };
+        defect_map_add(ctx.defects, &rec);
+    }
+    defect_record_t row_line = { .type = DEFECT_TYPE_ROW, .y = (uint16_t)(band_rows - 1) };
+    defect_record_t col_line = { .type = DEFECT_TYPE_COLUMN, .x = (uint16_t)(width / 3) };
+    defect_map_add(ctx.defects, &row_line);
+    defect_map_add(ctx.defects, &col_line);
+    defect_map_commit(ctx.defects);
+
+    pipe_registry_t *reg = bench_registry(&ctx);
+    if (reg == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Pipeline benchmark: %ux%u, %u frames, band %u rows (%zu KiB of pixels)\n",
+           width, height, frames, band_rows, (size_t)band_rows * width * sizeof(uint16_t) / 1024);
+
+    /* Fused must be bit-identical to staged */
+    fstats_t stats_staged, stats_fused;
+    if (!run_reference(&ctx, reg, PIPE_EXEC_STAGED, band_rows, raw, buffers, width, height,
+                       ref_staged, &stats_staged) ||
+        !run_reference(&ctx, reg, PIPE_EXEC_FUSED, band_rows, raw, buffers, width, height,
+                       ref_fused, &stats_fused)) {
+        fprintf(stderr, "Pipeline build failed\n");
+        return 2;
+    }
+
+    bool same = memcmp(ref_staged, ref_fused, bytes) == 0 &&
+                memcmp(stats_staged.hist, stats_fused.hist, sizeof(stats_staged.hist)) == 0 &&
+                stats_staged.min == stats_fused.min && stats_staged.max == stats_fused.max &&
+                stats_staged.roi_sum == stats_fused.roi_sum;
+    printf("output fused vs staged: %s\n", same ? "identical" : "MISMATCH");
+
+    /* Timed runs keep processing the same buffers; values drift but the
+     * work per frame does not */
+    static const struct {
+        const char *name;
+        pipe_exec_t exec;
+    } variants[] = {
+        { "staged", PIPE_EXEC_STAGED },
+        { "fused", PIPE_EXEC_FUSED }
+    };
+    uint64_t traffic[2] = { 0, 0 };
+    bool counted = true;
+
+    for (int v = 0; v < 2; v++) {
+        bench_perf_t perf;
+        bool counting = perf_start(&perf);
+        double ms = run(reg, variants[v].exec, band_rows, buffers, width, height, frames);
+        traffic[v] = perf_stop(&perf);
+        counted = counted && counting;
+
+        if (counting) {
+            double per_frame = (double)traffic[v] / frames;
+            printf("%-6s avg %7.2f ms/frame  DRAM %7.1f MiB/frame  (%.2f frame passes, %s)\n",
+                   variants[v].name, ms / frames, per_frame / (1024.0 * 1024.0),
+                   per_frame / (double)bytes, perf.source);
+        } else {
+            printf("%-6s avg %7.2f ms/frame  DRAM not measured (perf_event_open: %s, "
+                   "perf_event_paranoid %d)\n",
+                   variants[v].name, ms / frames, strerror(perf.error), perf_paranoid());
+        }
+    }
+
+    bool pass = same;
+    if (counted && traffic[0] > 0) {
+        double ratio = (double)traffic[1] / (double)traffic[0];
+        bool ok = ratio <= BENCH_TRAFFIC_BUDGET;
+        printf("fused / staged DRAM traffic %.2f (budget %.2f)  %s\n", ratio,
+               BENCH_TRAFFIC_BUDGET, ok ? "PASS" : "FAIL");
+        pass = pass && ok;
+    } else {
+        printf("perf counters unavailable; DRAM traffic not gated\n");
+    }
+
+    pipeline_registry_destroy(reg);
+    temporal_filter_destroy(ctx.tf);
+    saturation_destroy(ctx.sat);
+    defect_map_destroy(ctx.defects);
+    correction_destroy(ctx.corr);
+    for (int i = 0; i < BENCH_BUFFERS; i++) {
+        free(buffers[i]);
+    }
+    free(ref_fused);
+    free(ref_staged);
+    free(gain);
+    free(offset);
+    free(raw);
+
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file bench_pixel_drift.c
+ * @brief Drift tracking cost: pipeline-side submit and worker update
+ *
+ * Feeds 4096x4096 dark frames at the configured pixel budget and reports
+ * what the pipeline thread pays per frame (pixel_drift_submit: one block
+ * copy) and what the worker spends per block (inline update with the
+ * threshold check, baselines taken after two sweeps), plus the frames
+ * needed for one sweep.
+ * The submit must stay under 1% of a 15 fps frame period.
+ *
+ * Usage: bench_pixel_drift [frames] [size] [pixels_per_frame]
+ * Exit status is non-zero if the submit exceeds that budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/pixel_drift.h"
+
+#define BENCH_DEFAULT_FRAMES  200
+#define BENCH_DEFAULT_SIZE    4096
+#define BENCH_FPS             15
+#define BENCH_SUBMIT_SHARE    0.01      /* Of the frame period */
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Average ms per submit
+ *
+ * The worker is drained between frames (outside the timing), as it is
+ * when the real frame period is longer than one block update.
+ */
+static double bench_run(pixel_drift_t *drift, const uint16_t *frame, uint32_t frames,
+                        double *max_ms) {
+    double total = 0.0;
+
+    *max_ms = 0.0;
+    for (uint32_t f = 0; f < frames; f++) {
+        double start = bench_now_ms();
+        pixel_drift_submit(drift, frame);
+        double ms = bench_now_ms() - start;
+
+        pixel_drift_flush(drift);
+        total += ms;
+        if (ms > *max_ms) {
+            *max_ms = ms;
+        }
+    }
+    return total / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    uint32_t budget = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 0;
+    size_t pixels = (size_t)size * size;
+    double limit_ms = BENCH_SUBMIT_SHARE * 1000.0 / BENCH_FPS;
+
+    if (frames == 0 || size == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    if (frame == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        frame[i] = (uint16_t)(1000 + cpu_dispatch_random(&seed) % 16);
+    }
+
+    drift_config_t config = { .width = size, .height = size, .pixels_per_frame = budget,
+                              .weight_shift = 1 };
+    pixel_drift_t *inline_drift = pixel_drift_create(&config);
+    config.background = true;
+    pixel_drift_t *bg_drift = pixel_drift_create(&config);
+    if (inline_drift == NULL || bg_drift == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(inline_drift, &stats);
+    uint32_t block = (uint32_t)((pixels + stats.blocks - 1) / stats.blocks);
+
+    printf("Drift tracking benchmark: %ux%u, %u pixels per frame, %u frames, kernel=%s\n",
+           size, size, block, frames, pixel_drift_get_kernel_name());
+    printf("Sweep: %u frames (%.1f s at %d fps)\n", stats.blocks,
+           (double)stats.blocks / BENCH_FPS, BENCH_FPS);
+
+    /* Two sweeps take the baselines; after that every update also checks */
+    double max_ms;
+    double warm_ms = bench_run(inline_drift, frame, 2 * stats.blocks, &max_ms);
+    double check_ms = bench_run(inline_drift, frame, frames, &max_ms);
+    bench_run(bg_drift, frame, stats.blocks, &max_ms);     /* Fault in the staging slots */
+    double submit_ms = bench_run(bg_drift, frame, frames, &max_ms);
+
+    printf("worker update          %8.3f ms/block (first sweeps, page faults)\n", warm_ms);
+    printf("worker update + check  %8.3f ms/block\n", check_ms);
+    printf("pipeline submit        %8.3f ms/frame (max %.3f ms), limit %.3f ms  %s\n",
+           submit_ms, max_ms, limit_ms, (submit_ms <= limit_ms) ? "PASS" : "FAIL");
+
+    pixel_drift_destroy(inline_drift);
+    pixel_drift_destroy(bg_drift);
+    free(frame);
+    return (submit_ms <= limit_ms) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file bench_saturation.c
+ * @brief Saturation counter cost: fused into correction vs extra passes
+ *
+ * Times offset/gain correction of 2048x2048 RAW16 frames four ways:
+ * - correction only
+ * - correction counting in its kernel (count hook, no second read)
+ * - correction with the saturation counter in the band hook, which
+ *   re-reads each band while it is cache-resident
+ * - correction followed by a separate whole-frame saturation pass
+ *
+ * The fused count only adds a compare per output vector, so its overhead
+ * must stay below BENCH_FUSED_BUDGET of the correction time.
+ *
+ * Usage: bench_saturation [frames] [width] [height]
+ * Exit status is non-zero if the fused overhead misses the budget.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/correction.h"
+#include "proc/saturation.h"
+
+#define BENCH_DEFAULT_FRAMES  50
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_FUSED_BUDGET    0.25    /* Fused overhead / correction time */
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static void saturation_band_hook(uint16_t *frame, uint32_t row_start,
+                                 uint32_t row_count, void *user_data) {
+    saturation_count_rows((sat_counter_t *)user_data, frame, row_start, row_count);
+}
+
+static void saturation_count_hook(uint32_t row_start, uint32_t row_count,
+                                  const uint32_t *counts, void *user_data) {
+    saturation_add_counts((sat_counter_t *)user_data, row_start, row_count, counts);
+}
+
+/**
+ * @brief Mean per-frame time of one variant
+ *
+ * @param separate Saturation pass after correction instead of in the hook
+ */
+static double run(correction_t *corr, sat_counter_t *sat, bool separate, uint16_t *frame,
+                  const uint16_t *raw, size_t pixels, uint32_t height, uint32_t frames) {
+    double sum_ms = 0.0;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        memcpy(frame, raw, pixels * sizeof(uint16_t));
+        double t0 = bench_now_ms();
+        saturation_begin_frame(sat);
+        correction_apply_frame(corr, frame);
+        if (separate) {
+            saturation_count_rows(sat, frame, 0, height);
+        }
+        saturation_end_frame(sat, NULL);
+        sum_ms += bench_now_ms() - t0;
+    }
+
+    return sum_ms / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    size_t pixels = (size_t)width * height;
+
+    if (frames == 0 || pixels == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    uint16_t *raw = malloc(pixels * sizeof(uint16_t));
+    uint16_t *offset = malloc(pixels * sizeof(uint16_t));
+    float *gain = malloc(pixels * sizeof(float));
+    if (frame == NULL || raw == NULL || offset == NULL || gain == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    /* Mid-range signal with a bright 1/16 of the frame near saturation */
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        raw[i] = (uint16_t)(((i / width) % 16 == 0 ? 59000 : 8000) + ((seed >> 8) & 0x7FF));
+        offset[i] = (uint16_t)(800 + ((seed >> 20) & 0xFF));
+        gain[i] = 0.9f + (float)((seed >> 4) & 0x3FF) / 4096.0f;
+    }
+
+    corr_config_t corr_config = {
+        .width = width,
+        .height = height,
+        .gain_format = CORR_GAIN_Q2_14,
+        .band_rows = CORR_DEFAULT_BAND_ROWS
+    };
+    sat_config_t sat_config = { .width = width, .height = height };
+
+    correction_t *corr = correction_create(&corr_config);
+    sat_counter_t *sat = saturation_create(&sat_config);
+    if (corr == NULL || sat == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+    correction_set_offset_map(corr, offset, pixels);
+    correction_set_gain_map(corr, gain, pixels);
+
+    printf("Saturation benchmark: %ux%u, %u frames, kernel=%s, band %u rows\n",
+           width, height, frames, saturation_get_kernel_name(), CORR_DEFAULT_BAND_ROWS);
+
+    double base_ms = run(corr, sat, false, frame, raw, pixels, height, frames);
+
+    correction_set_count_hook(corr, SAT_DEFAULT_THRESHOLD, SAT_DEFAULT_TILE_SIZE,
+                              saturation_count_hook, sat);
+    double fused_ms = run(corr, sat, false, frame, raw, pixels, height, frames);
+
+    correction_set_count_hook(corr, 0, 0, NULL, NULL);
+    correction_set_band_hook(corr, saturation_band_hook, sat);
+    double hook_ms = run(corr, sat, false, frame, raw, pixels, height, frames);
+
+    correction_set_band_hook(corr, NULL, NULL);
+    double separate_ms = run(corr, sat, true, frame, raw, pixels, height, frames);
+
+    sat_stats_t stats;
+    saturation_get_stats(sat, &stats);
+
+    double fused_over = (fused_ms - base_ms) / base_ms;
+    double hook_over = (hook_ms - base_ms) / base_ms;
+    double separate_over = (separate_ms - base_ms) / base_ms;
+    bool pass = fused_over <= BENCH_FUSED_BUDGET;
+
+    printf("correction only   avg %7.3f ms\n", base_ms);
+    printf("fused (in kernel) avg %7.3f ms  +%5.1f%%  %s\n", fused_ms, 100.0 * fused_over,
+           pass ? "PASS" : "FAIL");
+    printf("band hook         avg %7.3f ms  +%5.1f%%  (info)\n", hook_ms, 100.0 * hook_over);
+    printf("separate pass     avg %7.3f ms  +%5.1f%%  (info)\n", separate_ms, 100.0 * separate_over);
+    printf("saturated pixels/frame %llu, tiles over %u\n",
+           (unsigned long long)(stats.saturated_pixels / stats.frames), stats.last_tiles_over);
+
+    saturation_destroy(sat);
+    correction_destroy(corr);
+    free(frame);
+    free(raw);
+    free(offset);
+    free(gain);
+
+    return pass ? 0 : 1;
+}
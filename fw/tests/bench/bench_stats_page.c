@@ -0,0 +1,118 @@
+/**
+ * @file bench_stats_page.c
+ * @brief Cost of publishing and reading the shared-memory stats page
+ *
+ * Times stats_page_publish() and stats_page_read() for a page the size of
+ * the daemon's, first with the page idle, then with a writer publishing
+ * continuously on another thread so reads contend with it.
+ *
+ * Usage: bench_stats_page [iterations]
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "util/stats_page.h"
+
+#define BENCH_DEFAULT_ITERATIONS    1000000U
+#define BENCH_ENTRIES               40
+#define BENCH_NAME                  "/bench_stats_page"
+
+static stats_page_t *g_page;
+static atomic_bool g_stop;
+
+/* Thread CPU time, so a writer time-sliced on the same core is not charged */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static void *bench_writer(void *arg) {
+    uint64_t values[BENCH_ENTRIES];
+    uint64_t n = 0;
+
+    (void)arg;
+    while (!atomic_load_explicit(&g_stop, memory_order_relaxed)) {
+        n++;
+        for (uint32_t i = 0; i < BENCH_ENTRIES; i++) {
+            values[i] = n;
+        }
+        stats_page_publish(g_page, values);
+    }
+    return NULL;
+}
+
+static double bench_reads(const stats_page_view_t *view, uint32_t iterations, uint32_t *torn) {
+    uint64_t values[BENCH_ENTRIES];
+
+    double t0 = bench_now_ns();
+    for (uint32_t n = 0; n < iterations; n++) {
+        if (stats_page_read(view, values, NULL) == STATS_PAGE_OK &&
+            values[BENCH_ENTRIES - 1] != values[0]) {
+            (*torn)++;
+        }
+    }
+    return (bench_now_ns() - t0) / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_ITERATIONS;
+    if (iterations == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    stats_page_entry_t entries[BENCH_ENTRIES];
+    memset(entries, 0, sizeof(entries));
+    for (uint32_t i = 0; i < BENCH_ENTRIES; i++) {
+        snprintf(entries[i].name, sizeof(entries[i].name), "counter_%u", i);
+    }
+
+    stats_page_config_t config = { .name = BENCH_NAME, .entries = entries,
+                                   .entry_count = BENCH_ENTRIES };
+    g_page = stats_page_create(&config);
+    stats_page_view_t view;
+    if (g_page == NULL || stats_page_open(BENCH_NAME, &view) != STATS_PAGE_OK) {
+        fprintf(stderr, "Setup failed\n");
+        stats_page_destroy(g_page);
+        return 2;
+    }
+
+    printf("Stats page benchmark: %u entries, %u iterations\n", BENCH_ENTRIES, iterations);
+
+    uint64_t values[BENCH_ENTRIES] = { 0 };
+    double t0 = bench_now_ns();
+    for (uint32_t n = 0; n < iterations; n++) {
+        values[0] = n;
+        values[BENCH_ENTRIES - 1] = n;
+        stats_page_publish(g_page, values);
+    }
+    printf("publish                     %8.1f ns\n", (bench_now_ns() - t0) / iterations);
+
+    uint32_t torn = 0;
+    printf("read, idle page             %8.1f ns\n", bench_reads(&view, iterations, &torn));
+
+    pthread_t writer;
+    pthread_create(&writer, NULL, bench_writer, NULL);
+    printf("read, writer publishing     %8.1f ns\n", bench_reads(&view, iterations, &torn));
+    atomic_store(&g_stop, true);
+    pthread_join(writer, NULL);
+
+    printf("torn reads %u: %s\n", torn, (torn == 0) ? "PASS" : "FAIL");
+
+    stats_page_close(&view);
+    stats_page_destroy(g_page);
+    return (torn == 0) ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file bench_thread_pool.c
+ * @brief Thread pool scaling: row-band correction on 1-4 threads
+ *
+ * Runs two per-frame workloads through the work-stealing pool at 1, 2, 3
+ * and 4 threads:
+ * - offset/gain correction of 2048x2048 RAW16 frames, one task per
+ *   64-row band (memory bound, the daemon's use)
+ * - a compute-bound row filter, which shows the pool's own scaling
+ *
+ * Every configuration must produce output identical to the single-thread
+ * run. On a host with at least N online CPUs, N threads must also not be
+ * slower than one thread by more than BENCH_SLOWDOWN_LIMIT (pool overhead
+ * regression); speedup and efficiency are reported for information.
+ *
+ * Usage: bench_thread_pool [frames] [width] [height]
+ * Exit status is non-zero on a mismatch or an overhead regression.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "proc/correction.h"
+#include "util/thread_pool.h"
+
+#define BENCH_DEFAULT_FRAMES  30
+#define BENCH_DEFAULT_WIDTH   2048
+#define BENCH_DEFAULT_HEIGHT  2048
+#define BENCH_MAX_THREADS     4
+#define BENCH_SLOWDOWN_LIMIT  1.10
+#define BENCH_FILTER_TAPS     4
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Compute-bound job: 4-tap running filter along each row
+ */
+typedef struct {
+    const uint16_t *src;
+    uint16_t *dst;
+    uint32_t width;
+} filter_job_t;
+
+static void filter_rows(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+    const filter_job_t *job = (const filter_job_t *)user_data;
+    (void)worker;
+
+    for (uint32_t y = begin; y < end; y++) {
+        const uint16_t *in = job->src + (size_t)y * job->width;
+        uint16_t *out = job->dst + (size_t)y * job->width;
+
+        for (uint32_t x = 0; x < job->width; x++) {
+            uint32_t acc = 0;
+            for (uint32_t k = 0; k < BENCH_FILTER_TAPS; k++) {
+                uint32_t v = in[(x + k) % job->width];
+                acc += v * (k + 1) ^ (acc >> 7);
+            }
+            out[x] = (uint16_t)acc;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_WIDTH;
+    uint32_t height = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : BENCH_DEFAULT_HEIGHT;
+    size_t pixels = (size_t)width * height;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int failed = 0;
+
+    if (frames == 0 || pixels == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *raw = malloc(pixels * sizeof(uint16_t));
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    uint16_t *ref_corr = malloc(pixels * sizeof(uint16_t));
+    uint16_t *ref_filter = malloc(pixels * sizeof(uint16_t));
+    uint16_t *offset = malloc(pixels * sizeof(uint16_t));
+    float *gain = malloc(pixels * sizeof(float));
+    if (raw == NULL || frame == NULL || ref_corr == NULL || ref_filter == NULL ||
+        offset == NULL || gain == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        raw[i] = (uint16_t)(8000 + ((seed >> 8) & 0xFFF));
+        offset[i] = (uint16_t)(800 + ((seed >> 20) & 0xFF));
+        gain[i] = 0.9f + (float)((seed >> 4) & 0x3FF) / 4096.0f;
+    }
+
+    corr_config_t corr_config = {
+        .width = width,
+        .height = height,
+        .gain_format = CORR_GAIN_Q2_14,
+        .band_rows = CORR_DEFAULT_BAND_ROWS
+    };
+    correction_t *corr = correction_create(&corr_config);
+    if (corr == NULL) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+    correction_set_offset_map(corr, offset, pixels);
+    correction_set_gain_map(corr, gain, pixels);
+
+    printf("Thread pool benchmark: %ux%u, %u frames, %ld online CPUs, kernel=%s\n",
+           width, height, frames, online, correction_get_kernel_name());
+    printf("%-10s %7s %10s %8s %6s %8s\n", "workload", "threads", "avg ms", "speedup", "eff", "steals");
+
+    double corr_base = 0.0, filter_base = 0.0;
+
+    for (uint32_t threads = 1; threads <= BENCH_MAX_THREADS; threads++) {
+        tp_config_t pool_config = { .threads = threads };
+        tp_pool_t *pool = thread_pool_create(&pool_config);
+        if (pool == NULL) {
+            fprintf(stderr, "Pool creation failed (%u threads)\n", threads);
+            return 2;
+        }
+        correction_set_thread_pool(corr, pool);
+        bool gated = online >= (long)threads;
+
+        /* Correction, one task per band */
+        double sum_ms = 0.0;
+        for (uint32_t f = 0; f < frames; f++) {
+            memcpy(frame, raw, pixels * sizeof(uint16_t));
+            double t0 = bench_now_ms();
+            correction_apply_frame(corr, frame);
+            sum_ms += bench_now_ms() - t0;
+        }
+        if (threads == 1) {
+            memcpy(ref_corr, frame, pixels * sizeof(uint16_t));
+        } else if (memcmp(ref_corr, frame, pixels * sizeof(uint16_t)) != 0) {
+            printf("correction output differs at %u threads\n", threads);
+            failed = 1;
+        }
+
+        double avg = sum_ms / frames;
+        corr_base = (threads == 1) ? avg : corr_base;
+        tp_stats_t stats;
+        thread_pool_get_stats(pool, &stats);
+        printf("%-10s %7u %10.2f %7.2fx %5.0f%% %8llu  %s\n", "correction", threads, avg,
+               corr_base / avg, 100.0 * corr_base / avg / threads,
+               (unsigned long long)stats.steals,
+               !gated ? "(info)" : (avg <= corr_base * BENCH_SLOWDOWN_LIMIT) ? "PASS" : "FAIL");
+        if (gated && avg > corr_base * BENCH_SLOWDOWN_LIMIT) {
+            failed = 1;
+        }
+
+        /* Compute-bound rows, default batching */
+        filter_job_t job = { .src = raw, .dst = frame, .width = width };
+        uint64_t steals_before = stats.steals;
+        sum_ms = 0.0;
+        for (uint32_t f = 0; f < frames; f++) {
+            double t0 = bench_now_ms();
+            thread_pool_parallel_for(pool, height, 0, filter_rows, &job);
+            sum_ms += bench_now_ms() - t0;
+        }
+        if (threads == 1) {
+            memcpy(ref_filter, frame, pixels * sizeof(uint16_t));
+        } else if (memcmp(ref_filter, frame, pixels * sizeof(uint16_t)) != 0) {
+            printf("filter output differs at %u threads\n", threads);
+            failed = 1;
+        }
+
+        avg = sum_ms / frames;
+        filter_base = (threads == 1) ? avg : filter_base;
+        thread_pool_get_stats(pool, &stats);
+        printf("%-10s %7u %10.2f %7.2fx %5.0f%% %8llu  %s\n", "compute", threads, avg,
+               filter_base / avg, 100.0 * filter_base / avg / threads,
+               (unsigned long long)(stats.steals - steals_before),
+               !gated ? "(info)" : (avg <= filter_base * BENCH_SLOWDOWN_LIMIT) ? "PASS" : "FAIL");
+        if (gated && avg > filter_base * BENCH_SLOWDOWN_LIMIT) {
+            failed = 1;
+        }
+
+        correction_set_thread_pool(corr, NULL);
+        thread_pool_destroy(pool);
+    }
+
+    correction_destroy(corr);
+    free(raw);
+    free(frame);
+    free(ref_corr);
+    free(ref_filter);
+    free(offset);
+    free(gain);
+
+    return failed;
+}
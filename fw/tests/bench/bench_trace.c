@@ -0,0 +1,101 @@
+/**
+ * @file bench_trace.c
+ * @brief Cost of one tracepoint, recording off and on
+ *
+ * Times TRACE_INSTANT() with recording stopped (the load and branch every
+ * tracepoint pays in production) and started, on 1-4 threads at once,
+ * then dumps the rings to check that the newest records are complete.
+ *
+ * Usage: bench_trace [events_per_thread]
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "util/trace.h"
+
+#define BENCH_DEFAULT_EVENTS    10000000U
+#define BENCH_MAX_THREADS       4
+#define BENCH_RING_RECORDS      65536U
+#define BENCH_DUMP_PATH         "/tmp/bench_trace.dtrc"
+
+static uint32_t g_events;
+
+/* Thread CPU time, so threads time-sliced on fewer cores are not charged */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static void *bench_tracepoint(void *arg) {
+    double *ns = (double *)arg;
+
+    double t0 = bench_now_ns();
+    for (uint32_t i = 0; i < g_events; i++) {
+        TRACE_INSTANT(TRACE_FRAME_GET, i, 0);
+    }
+    *ns = (bench_now_ns() - t0) / g_events;
+    return NULL;
+}
+
+static double bench_threads(uint32_t n) {
+    pthread_t threads[BENCH_MAX_THREADS];
+    double ns[BENCH_MAX_THREADS];
+    double worst = 0.0;
+
+    for (uint32_t t = 0; t < n; t++) {
+        pthread_create(&threads[t], NULL, bench_tracepoint, &ns[t]);
+    }
+    for (uint32_t t = 0; t < n; t++) {
+        pthread_join(threads[t], NULL);
+        worst = (ns[t] > worst) ? ns[t] : worst;
+    }
+    return worst;
+}
+
+int main(int argc, char *argv[]) {
+    g_events = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_EVENTS;
+    if (g_events == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    if (trace_init(BENCH_RING_RECORDS) != TRACE_OK) {
+        fprintf(stderr, "Setup failed\n");
+        return 2;
+    }
+
+    printf("Tracepoint benchmark: %u events per thread, %u records per CPU\n",
+           g_events, BENCH_RING_RECORDS);
+    printf("recording off, 1 thread          %6.2f ns/event\n", bench_threads(1));
+
+    trace_start();
+    for (uint32_t n = 1; n <= BENCH_MAX_THREADS; n++) {
+        printf("recording on, %u thread(s)        %6.2f ns/event (slowest thread)\n",
+               n, bench_threads(n));
+    }
+    trace_stop();
+
+    trace_stats_t stats;
+    trace_get_stats(&stats);
+    uint64_t expected = (uint64_t)g_events * (BENCH_MAX_THREADS * (BENCH_MAX_THREADS + 1) / 2);
+    int ok = (stats.recorded == expected) && (trace_dump(BENCH_DUMP_PATH) == TRACE_OK);
+    remove(BENCH_DUMP_PATH);
+
+    printf("recorded %llu of %llu on %u CPU ring(s), dump %s\n",
+           (unsigned long long)stats.recorded, (unsigned long long)expected, stats.cpus,
+           ok ? "PASS" : "FAIL");
+
+    trace_deinit();
+    return ok ? 0 : 1;
+}
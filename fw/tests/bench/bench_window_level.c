@@ -0,0 +1,139 @@
+/**
+ * @file bench_window_level.c
+ * @brief Display conversion throughput: 64 KiB LUT vs SIMD arithmetic
+ *
+ * Converts 4096x4096 RAW16 frames to 8 bits with both window/level
+ * methods, linear and with gamma 2.2, and reports what WL_METHOD_AUTO
+ * picks. Also times a LUT rebuild (paid on every auto-window change) and
+ * the subsampled histogram the auto window needs. Every pair of outputs is
+ * compared: the methods must agree bit for bit.
+ *
+ * Usage: bench_window_level [frames] [size]
+ * Exit status is non-zero if the methods disagree or AUTO does not pick
+ * the faster method (with a 10% margin for noise).
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/window_level.h"
+
+#define BENCH_DEFAULT_FRAMES  10
+#define BENCH_DEFAULT_SIZE    4096
+#define BENCH_LUT_REBUILDS    200
+#define BENCH_AUTO_MARGIN     1.10
+
+static double bench_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/**
+ * @brief Average ms per frame of one method
+ */
+static double bench_run(window_level_t *wl, wl_method_t method, uint8_t *out,
+                        const uint16_t *frame, size_t pixels, uint32_t frames) {
+    window_level_convert_method(wl, method, out, frame, pixels);   /* Warm-up, builds LUT */
+
+    double start = bench_now_ms();
+    for (uint32_t f = 0; f < frames; f++) {
+        window_level_convert_method(wl, method, out, frame, pixels);
+    }
+    return (bench_now_ms() - start) / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+    uint32_t size = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_DEFAULT_SIZE;
+    size_t pixels = (size_t)size * size;
+    int status = 0;
+
+    if (frames == 0 || size == 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 2;
+    }
+
+    uint16_t *frame = malloc(pixels * sizeof(uint16_t));
+    uint8_t *out_lut = malloc(pixels);
+    uint8_t *out_arith = malloc(pixels);
+    fstats_t *stats = malloc(sizeof(fstats_t));
+    if (frame == NULL || out_lut == NULL || out_arith == NULL || stats == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    /* Soft-tissue-like spread around mid-range with bright and dark tails */
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        uint32_t r = cpu_dispatch_random(&seed);
+        frame[i] = (uint16_t)(8000 + (r & 0x7FFF) + ((r >> 16) & 0x3FFF));
+    }
+
+    fstats_config_t stats_config = { .width = size, .height = size };
+    double start = bench_now_ms();
+    for (uint32_t f = 0; f < frames; f++) {
+        frame_stats_compute(&stats_config, frame, stats);
+    }
+    double hist_ms = (bench_now_ms() - start) / frames;
+
+    printf("Window/level benchmark: %ux%u, %u frames, kernel=%s\n",
+           size, size, frames, window_level_get_kernel_name());
+    printf("auto-window histogram  %8.2f ms/frame\n", hist_ms);
+
+    static const float gammas[] = { 1.0f, 2.2f };
+    for (size_t g = 0; g < sizeof(gammas) / sizeof(gammas[0]); g++) {
+        wl_config_t config = { .gamma = gammas[g], .method = WL_METHOD_AUTO };
+        window_level_t *wl = window_level_create(&config);
+        if (wl == NULL || window_level_auto_window(wl, stats) != WL_OK) {
+            fprintf(stderr, "Setup failed\n");
+            return 2;
+        }
+
+        double lut_ms = bench_run(wl, WL_METHOD_LUT, out_lut, frame, pixels, frames);
+        double arith_ms = bench_run(wl, WL_METHOD_ARITH, out_arith, frame, pixels, frames);
+        bool same = memcmp(out_lut, out_arith, pixels) == 0;
+
+        /* Alternate two windows so every set rebuilds the table */
+        uint16_t low, high;
+        window_level_get_window(wl, &low, &high);
+        start = bench_now_ms();
+        for (uint32_t r = 0; r < BENCH_LUT_REBUILDS; r++) {
+            window_level_set_window(wl, (uint16_t)(low + (r & 1)), high);
+            window_level_convert_method(wl, WL_METHOD_LUT, out_lut, frame, 1);
+        }
+        double rebuild_ms = (bench_now_ms() - start) / BENCH_LUT_REBUILDS;
+
+        wl_method_t picked = window_level_method(wl);
+        double picked_ms = (picked == WL_METHOD_LUT) ? lut_ms : arith_ms;
+        double best_ms = (lut_ms < arith_ms) ? lut_ms : arith_ms;
+        bool auto_ok = picked_ms <= best_ms * BENCH_AUTO_MARGIN;
+
+        printf("gamma %.1f  window %u-%u\n", gammas[g], low, high);
+        printf("  lut           %8.2f ms/frame  (rebuild %.3f ms)\n", lut_ms, rebuild_ms);
+        printf("  arith         %8.2f ms/frame  %5.2fx lut\n", arith_ms, lut_ms / arith_ms);
+        printf("  auto picks    %s  %s, outputs %s\n",
+               (picked == WL_METHOD_LUT) ? "lut" : "arith",
+               auto_ok ? "OK" : "SLOWER", same ? "identical" : "DIFFER");
+
+        if (!same || !auto_ok) {
+            status = 1;
+        }
+        window_level_destroy(wl);
+    }
+
+    free(frame);
+    free(out_lut);
+    free(out_arith);
+    free(stats);
+    return status;
+}
@@ -5,11 +5,18 @@
  * Copyright (c) 2026 ABYZ Lab
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "mock_v4l2.h"
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
 
 /* Global mock instance */
 static mock_v4l2_t g_mock_v4l2 = {0};
@@ -96,7 +103,16 @@ void mock_v4l2_set_frame_ready(mock_v4l2_t *mock, uint32_t buffer_index, size_t
 
     mock->frame_ready = true;
     mock->filled_buffer_index = buffer_index;
-    mock->current_format.fmt.pix.bytesused = bytesused;
+    mock->filled_bytesused = bytesused;
+}
+
+void mock_v4l2_queue_frame_sync(mock_v4l2_t *mock, uint32_t sequence) {
+    if (mock == NULL) {
+        mock = &g_mock_v4l2;
+    }
+
+    mock->event_pending = true;
+    mock->event_sequence = sequence;
 }
 
 mock_v4l2_t *mock_v4l2_get_instance(void) {
@@ -110,6 +126,8 @@ mock_v4l2_t *mock_v4l2_get_instance(void) {
 
 int mock_v4l2_open(const char *pathname, int flags) {
     mock_v4l2_t *mock = &g_mock_v4l2;
+    (void)pathname;
+    (void)flags;
 
     mock->open_count++;
 
@@ -154,7 +172,15 @@ int mock_v4l2_ioctl(int fd, unsigned long request, void *arg) {
         case VIDIOC_S_FMT: {
             struct v4l2_format *fmt = (struct v4l2_format *)arg;
             if (fmt->type == V4L2_BUF_TYPE_VIDEO_CAPTURE) {
-                /* Accept requested format */
+                /* Accept requested format; the driver fills in the sizes
+                 * (16-bit container per pixel) */
+                struct v4l2_pix_format *pix = &fmt->fmt.pix;
+                if (pix->bytesperline == 0) {
+                    pix->bytesperline = pix->width * 2;
+                }
+                if (pix->sizeimage == 0) {
+                    pix->sizeimage = pix->bytesperline * pix->height;
+                }
                 mock->current_format = *fmt;
                 return 0;
             }
@@ -229,7 +255,7 @@ int mock_v4l2_ioctl(int fd, unsigned long request, void *arg) {
             }
 
             buf->index = mock->filled_buffer_index;
-            buf->bytesused = mock->current_format.fmt.pix.bytesused;
+            buf->bytesused = mock->filled_bytesused;
             buf->sequence = mock->frame_sequence++;
             buf->flags = 0;
             buf->field = V4L2_FIELD_NONE;
@@ -268,6 +294,45 @@ int mock_v4l2_ioctl(int fd, unsigned long request, void *arg) {
             return -1;
         }
 
+        case VIDIOC_SUBSCRIBE_EVENT: {
+            struct v4l2_event_subscription *sub = (struct v4l2_event_subscription *)arg;
+            if (sub->type >= 32 || (mock->unsupported_events & (1U << sub->type))) {
+                errno = EINVAL;
+                return -1;
+            }
+
+            mock->subscribed_events |= (1U << sub->type);
+            return 0;
+        }
+
+        case VIDIOC_UNSUBSCRIBE_EVENT: {
+            struct v4l2_event_subscription *sub = (struct v4l2_event_subscription *)arg;
+            if (sub->type == V4L2_EVENT_ALL) {
+                mock->subscribed_events = 0;
+            } else if (sub->type < 32) {
+                mock->subscribed_events &= ~(1U << sub->type);
+            }
+            return 0;
+        }
+
+        case VIDIOC_DQEVENT: {
+            struct v4l2_event *ev = (struct v4l2_event *)arg;
+
+            if (!mock->event_pending ||
+                !(mock->subscribed_events & (1U << V4L2_EVENT_FRAME_SYNC))) {
+                errno = ENOENT;
+                return -1;
+            }
+
+            memset(ev, 0, sizeof(*ev));
+            ev->type = V4L2_EVENT_FRAME_SYNC;
+            ev->u.frame_sync.frame_sequence = mock->event_sequence;
+            clock_gettime(CLOCK_MONOTONIC, &ev->timestamp);
+
+            mock->event_pending = false;
+            return 0;
+        }
+
         default:
             errno = ENOTTY;
             return -1;
@@ -277,6 +342,10 @@ int mock_v4l2_ioctl(int fd, unsigned long request, void *arg) {
 void *mock_v4l2_mmap(void *addr, size_t length, int prot, int flags,
                      int fd, off_t offset) {
     mock_v4l2_t *mock = &g_mock_v4l2;
+    (void)addr;
+    (void)length;
+    (void)prot;
+    (void)flags;
 
     if (fd != 42) {
         return MAP_FAILED;
@@ -298,6 +367,7 @@ void *mock_v4l2_mmap(void *addr, size_t length, int prot, int flags,
 
 int mock_v4l2_munmap(void *addr, size_t length) {
     mock_v4l2_t *mock = &g_mock_v4l2;
+    (void)length;
 
     /* Find and free buffer */
     for (uint32_t i = 0; i < mock->buffer_count; i++) {
@@ -309,3 +379,38 @@ int mock_v4l2_munmap(void *addr, size_t length) {
 
     return -1;
 }
+
+/* ==========================================================================
+ * Linker Wraps (-Wl,--wrap=<function>)
+ * ========================================================================== */
+
+int __wrap_open(const char *pathname, int flags, ...);
+int __wrap_close(int fd);
+int __wrap_ioctl(int fd, unsigned long request, ...);
+void *__wrap_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+int __wrap_munmap(void *addr, size_t length);
+
+int __wrap_open(const char *pathname, int flags, ...) {
+    return mock_v4l2_open(pathname, flags);
+}
+
+int __wrap_close(int fd) {
+    return mock_v4l2_close(fd);
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    va_list args;
+    va_start(args, request);
+    void *arg = va_arg(args, void *);
+    va_end(args);
+
+    return mock_v4l2_ioctl(fd, request, arg);
+}
+
+void *__wrap_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    return mock_v4l2_mmap(addr, length, prot, flags, fd, offset);
+}
+
+int __wrap_munmap(void *addr, size_t length) {
+    return mock_v4l2_munmap(addr, length);
+}
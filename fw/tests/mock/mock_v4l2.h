@@ -8,8 +8,11 @@
 #ifndef DETECTOR_TEST_MOCK_MOCK_V4L2_H
 #define DETECTOR_TEST_MOCK_MOCK_V4L2_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <sys/types.h>
+#include <sys/time.h>
 #include <linux/videodev2.h>
 
 #ifdef __cplusplus
@@ -41,6 +44,13 @@ typedef struct {
     uint32_t frame_sequence;     /**< Current frame sequence */
     bool frame_ready;            /**< Frame ready flag */
     uint32_t filled_buffer_index; /**< Index of filled buffer */
+    size_t filled_bytesused;     /**< Bytes used in filled buffer */
+
+    /* Event state */
+    uint32_t subscribed_events;  /**< Bitmask of (1 << V4L2 event type) */
+    uint32_t unsupported_events; /**< Event types rejected by SUBSCRIBE_EVENT */
+    bool event_pending;          /**< FRAME_SYNC event queued */
+    uint32_t event_sequence;     /**< Sequence of queued FRAME_SYNC */
 
     /* Error injection */
     int fail_next_ioctl;         /**< Fail next ioctl with this error */
@@ -74,11 +84,29 @@ void mock_v4l2_reset(mock_v4l2_t *mock);
  */
 void mock_v4l2_set_frame_ready(mock_v4l2_t *mock, uint32_t buffer_index, size_t bytesused);
 
+/**
+ * @brief Queue a FRAME_SYNC event for the next VIDIOC_DQEVENT
+ */
+void mock_v4l2_queue_frame_sync(mock_v4l2_t *mock, uint32_t sequence);
+
 /**
  * @brief Get global mock instance
  */
 mock_v4l2_t *mock_v4l2_get_instance(void);
 
+/**
+ * @brief Mock V4L2 system calls (device fd is 42)
+ *
+ * Code under test reaches these through the linker: link with
+ * -Wl,--wrap=open,--wrap=close,--wrap=ioctl,--wrap=mmap,--wrap=munmap
+ * and its calls resolve to the __wrap_ entry points in mock_v4l2.c.
+ */
+int mock_v4l2_open(const char *pathname, int flags);
+int mock_v4l2_close(int fd);
+int mock_v4l2_ioctl(int fd, unsigned long request, void *arg);
+void *mock_v4l2_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+int mock_v4l2_munmap(void *addr, size_t length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,453 @@
+/**
+ * @file test_async_log.c
+ * @brief Unit tests for the asynchronous logger (FW-UT-29)
+ *
+ * Test ID: FW-UT-29
+ * Coverage: Deferred formatting, timestamp order across threads, ring
+ *           reuse after thread exit, drops, rate limit, repeat folding
+ *
+ * Tests:
+ * - Deferred formatting matches vsnprintf, %s copied at the call
+ * - Oversized %s arguments are cut, never copied past the record
+ * - Records of several threads reach the sink in timestamp order
+ * - Rings of exited threads are reused; no ring left means fallback
+ * - Full ring drops and reports; rate limit and repeats summarised
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "util/async_log.h"
+
+#define SINK_MAX        4096
+#define SINK_LEN        160
+#define FLUSH_MS        2000
+#define NOTICE_LEVEL    9
+
+typedef struct {
+    int level;
+    const char *module;
+    uint64_t time_ns;
+    char message[SINK_LEN];
+} sink_line_t;
+
+static sink_line_t g_lines[SINK_MAX];
+static uint32_t g_line_count;
+
+static void capture_sink(int level, const char *module, uint64_t time_ns,
+                         const char *message, void *user_data) {
+    (void)user_data;
+
+    if (g_line_count < SINK_MAX) {
+        sink_line_t *line = &g_lines[g_line_count++];
+        line->level = level;
+        line->module = module;
+        line->time_ns = time_ns;
+        snprintf(line->message, sizeof(line->message), "%s", message);
+    }
+}
+
+static void start_logger(uint32_t ring_records, uint32_t rate_limit, bool keep_duplicates) {
+    alog_config_t config = {
+        .sink = capture_sink,
+        .ring_records = ring_records,
+        .drain_ms = 1,
+        .rate_limit = rate_limit,
+        .keep_duplicates = keep_duplicates,
+        .notice_level = NOTICE_LEVEL
+    };
+
+    g_line_count = 0;
+    assert_int_equal(alog_start(&config), ALOG_OK);
+}
+
+static bool log_line(int level, const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    bool queued = alog_vlog(level, module, format, args);
+    va_end(args);
+    return queued;
+}
+
+/* ==========================================================================
+ * Formatting Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_29_001: Deferred formatting
+ * @pre Formats with integer lengths, floats, * width, %%, %p and %s whose
+ *      buffer is changed after the call; nine-argument format
+ * @post Sink text equals vsnprintf of the same call; the string is the one
+ *       at call time; the nine-argument message formatted on the caller
+ */
+static void test_alog_format(void **state) {
+    (void)state;
+
+    char name[16] = "spi";
+    char expected[SINK_LEN];
+    int marker = 0;
+
+    start_logger(0, UINT32_MAX, true);
+
+    assert_true(log_line(1, "fmt", "frame %u of %d: %s %5.2f%% [%*d] %lld %zu %hhx %c",
+                         7U, -3, name, 12.345, 6, 42, -9000000000LL, (size_t)123, 0x1ff, 'k'));
+    strcpy(name, "overwritten");
+    assert_true(log_line(2, "fmt", "%p %-4s| %#o %lu %.3e", (void *)&marker, "ab",
+                         8U, 4000000000UL, 1.5e-7));
+    assert_true(log_line(3, "fmt", "%d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+    assert_int_equal(g_line_count, 3);
+
+    snprintf(expected, sizeof(expected), "frame %u of %d: %s %5.2f%% [%*d] %lld %zu %hhx %c",
+             7U, -3, "spi", 12.345, 6, 42, -9000000000LL, (size_t)123, 0x1ff, 'k');
+    assert_string_equal(g_lines[0].message, expected);
+    assert_int_equal(g_lines[0].level, 1);
+    assert_string_equal(g_lines[0].module, "fmt");
+
+    snprintf(expected, sizeof(expected), "%p %-4s| %#o %lu %.3e", (void *)&marker, "ab",
+             8U, 4000000000UL, 1.5e-7);
+    assert_string_equal(g_lines[1].message, expected);
+    assert_string_equal(g_lines[2].message, "1 2 3 4 5 6 7 8 9");
+    assert_true(g_lines[0].time_ns <= g_lines[1].time_ns);
+
+    alog_stats_t stats;
+    assert_int_equal(alog_get_stats(&stats), ALOG_OK);
+    assert_int_equal(stats.captured, 3);
+    assert_int_equal(stats.emitted, 3);
+    assert_int_equal(stats.dropped, 0);
+    assert_int_equal(stats.rings, 1);
+
+    alog_stop();
+    assert_false(alog_active());
+    assert_false(log_line(1, "fmt", "after stop"));
+}
+
+static char g_long_line[ALOG_MAX_MESSAGE];
+
+static void long_sink(int level, const char *module, uint64_t time_ns,
+                      const char *message, void *user_data) {
+    (void)level;
+    (void)module;
+    (void)time_ns;
+    (void)user_data;
+    snprintf(g_long_line, sizeof(g_long_line), "%s", message);
+}
+
+/**
+ * @test FW_UT_29_006: Oversized string arguments
+ * @pre Two %s arguments of 400 characters each, then "second" after a
+ *      string that filled the record, then an integer
+ * @post Lines are queued and formatted: the first string is cut, the
+ *       strings after it are empty, the integer is intact; the records
+ *       are counted as truncated
+ */
+static void test_alog_long_strings(void **state) {
+    (void)state;
+
+    char big_a[401];
+    char big_b[401];
+    memset(big_a, 'a', sizeof(big_a) - 1);
+    big_a[sizeof(big_a) - 1] = '\0';
+    memset(big_b, 'b', sizeof(big_b) - 1);
+    big_b[sizeof(big_b) - 1] = '\0';
+
+    alog_config_t config = { .sink = long_sink, .drain_ms = 1, .keep_duplicates = true };
+    assert_int_equal(alog_start(&config), ALOG_OK);
+
+    assert_true(log_line(1, "long", "%s %s", big_a, big_b));
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+    assert_true(strlen(g_long_line) > 100);
+    assert_int_equal(g_long_line[0], 'a');
+    assert_null(strchr(g_long_line, 'b'));
+
+    assert_true(log_line(1, "long", "%s %s %d", big_a, "second", 7));
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+    assert_null(strstr(g_long_line, "second"));
+    size_t len = strlen(g_long_line);
+    assert_true(len > 3);
+    assert_string_equal(g_long_line + len - 3, "  7");
+
+    alog_stats_t stats;
+    assert_int_equal(alog_get_stats(&stats), ALOG_OK);
+    assert_int_equal(stats.truncated, 2);
+    assert_int_equal(stats.emitted, 2);
+    alog_stop();
+}
+
+/* ==========================================================================
+ * Thread Tests
+ * ========================================================================== */
+
+#define ORDER_THREADS   4
+#define ORDER_LINES     200
+
+static void *order_worker(void *arg) {
+    uintptr_t id = (uintptr_t)arg;
+
+    for (uint32_t i = 0; i < ORDER_LINES; i++) {
+        log_line(1, "order", "thread %lu line %u", (unsigned long)id, i);
+    }
+    return NULL;
+}
+
+static void *single_line_worker(void *arg) {
+    (void)arg;
+    log_line(1, "exit", "short-lived thread");
+    return NULL;
+}
+
+/**
+ * @test FW_UT_29_002: Timestamp order across threads, ring reuse
+ * @pre Four threads log 200 lines each; then more short-lived threads
+ *      than rings, one after another; then every ring held at once
+ * @post All lines arrive, in timestamp order, each thread's in sequence;
+ *       rings of exited threads are reused; a thread finding no free ring
+ *       is told to log synchronously
+ */
+static void test_alog_threads(void **state) {
+    (void)state;
+
+    pthread_t threads[ALOG_MAX_THREADS + 1];
+
+    /* Drain only on flush, so no record is still being written during a pass */
+    alog_config_t config = {
+        .sink = capture_sink, .ring_records = 1024, .drain_ms = 60000,
+        .rate_limit = UINT32_MAX, .keep_duplicates = true, .notice_level = NOTICE_LEVEL
+    };
+    g_line_count = 0;
+    assert_int_equal(alog_start(&config), ALOG_OK);
+
+    for (uintptr_t t = 0; t < ORDER_THREADS; t++) {
+        assert_int_equal(pthread_create(&threads[t], NULL, order_worker, (void *)t), 0);
+    }
+    for (uint32_t t = 0; t < ORDER_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+    assert_int_equal(g_line_count, ORDER_THREADS * ORDER_LINES);
+
+    uint32_t next[ORDER_THREADS] = { 0 };
+    for (uint32_t i = 0; i < g_line_count; i++) {
+        unsigned long id;
+        unsigned int line;
+        assert_int_equal(sscanf(g_lines[i].message, "thread %lu line %u", &id, &line), 2);
+        assert_int_equal(line, next[id]++);
+        if (i > 0) {
+            assert_true(g_lines[i - 1].time_ns <= g_lines[i].time_ns);
+        }
+    }
+
+    /* Exited threads hand their rings back once drained */
+    g_line_count = 0;
+    for (uint32_t t = 0; t < ALOG_MAX_THREADS * 2; t++) {
+        pthread_create(&threads[0], NULL, single_line_worker, NULL);
+        pthread_join(threads[0], NULL);
+        assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+    }
+
+    alog_stats_t stats;
+    alog_get_stats(&stats);
+    assert_int_equal(stats.fallback, 0);
+    assert_int_equal(stats.rings, 0);
+
+    alog_stop();
+}
+
+static pthread_barrier_t g_hold_barrier;
+static pthread_barrier_t g_release_barrier;
+static atomic_int g_fallbacks;
+
+static void *hold_worker(void *arg) {
+    (void)arg;
+
+    if (!log_line(1, "hold", "holding a ring")) {
+        atomic_fetch_add(&g_fallbacks, 1);
+    }
+    pthread_barrier_wait(&g_hold_barrier);
+    pthread_barrier_wait(&g_release_barrier);
+    return NULL;
+}
+
+/**
+ * @test FW_UT_29_003: No ring free
+ * @pre ALOG_MAX_THREADS + 1 threads log once and stay alive
+ * @post Exactly one is told to log synchronously and counted as fallback
+ */
+static void test_alog_no_ring(void **state) {
+    (void)state;
+
+    pthread_t threads[ALOG_MAX_THREADS + 1];
+
+    start_logger(0, UINT32_MAX, true);
+    atomic_store(&g_fallbacks, 0);
+    pthread_barrier_init(&g_hold_barrier, NULL, ALOG_MAX_THREADS + 2);
+    pthread_barrier_init(&g_release_barrier, NULL, ALOG_MAX_THREADS + 2);
+
+    for (uint32_t t = 0; t < ALOG_MAX_THREADS + 1; t++) {
+        assert_int_equal(pthread_create(&threads[t], NULL, hold_worker, NULL), 0);
+    }
+    pthread_barrier_wait(&g_hold_barrier);
+
+    alog_stats_t stats;
+    alog_get_stats(&stats);
+    assert_int_equal(atomic_load(&g_fallbacks), 1);
+    assert_int_equal(stats.fallback, 1);
+    assert_int_equal(stats.rings, ALOG_MAX_THREADS);
+
+    pthread_barrier_wait(&g_release_barrier);
+    for (uint32_t t = 0; t < ALOG_MAX_THREADS + 1; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&g_hold_barrier);
+    pthread_barrier_destroy(&g_release_barrier);
+
+    alog_stop();
+}
+
+/* ==========================================================================
+ * Overload Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_29_004: Drops, rate limit and repeat folding
+ * @pre Ring of 4 records filled with 10 calls before the drain runs;
+ *      then 25 distinct lines of one format with a limit of 10/s; then
+ *      the same message 5 times between two others
+ * @post 6 drops counted and reported; 10 of 25 lines emitted and the
+ *       other 15 summarised; the repeats folded into one line
+ */
+static void test_alog_overload(void **state) {
+    (void)state;
+
+    /* Drain interval far longer than the burst */
+    alog_config_t config = {
+        .sink = capture_sink, .ring_records = 4, .drain_ms = 60000,
+        .rate_limit = UINT32_MAX, .keep_duplicates = true, .notice_level = NOTICE_LEVEL
+    };
+    g_line_count = 0;
+    assert_int_equal(alog_start(&config), ALOG_OK);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        assert_true(log_line(1, "burst", "burst %u", i));
+    }
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+
+    alog_stats_t stats;
+    alog_get_stats(&stats);
+    assert_int_equal(stats.captured, 4);
+    assert_int_equal(stats.dropped, 6);
+    assert_int_equal(g_line_count, 5);
+    assert_int_equal(g_lines[0].level, NOTICE_LEVEL);
+    assert_non_null(strstr(g_lines[0].message, "6 messages dropped"));
+    assert_string_equal(g_lines[4].message, "burst 3");
+    alog_stop();
+
+    /* Rate limit: at most 10 lines of a format per second */
+    start_logger(64, 10, false);
+    for (uint32_t i = 0; i < 25; i++) {
+        log_line(2, "rate", "rate %u", i);
+        if (i % 8 == 7) {
+            alog_flush(FLUSH_MS);
+        }
+    }
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+
+    uint32_t rate_lines = 0;
+    bool summarised = false;
+    for (uint32_t i = 0; i < g_line_count; i++) {
+        if (strncmp(g_lines[i].message, "rate ", 5) == 0) {
+            rate_lines++;
+        } else if (strstr(g_lines[i].message, "suppressed (rate limit 10/s)") != NULL) {
+            summarised = true;
+            assert_int_equal(g_lines[i].level, 2);
+        }
+    }
+    alog_get_stats(&stats);
+    assert_int_equal(rate_lines + stats.rate_limited, 25);
+    assert_true(rate_lines >= 10);
+    assert_true(stats.rate_limited == 0 || summarised);
+    alog_stop();
+
+    /* Repeats of one message fold into a single line */
+    start_logger(64, UINT32_MAX, false);
+    log_line(1, "dup", "first");
+    for (uint32_t i = 0; i < 5; i++) {
+        log_line(1, "dup", "same %d", 1);
+    }
+    log_line(1, "dup", "last");
+    assert_int_equal(alog_flush(FLUSH_MS), ALOG_OK);
+
+    assert_int_equal(g_line_count, 4);
+    assert_string_equal(g_lines[0].message, "first");
+    assert_string_equal(g_lines[1].message, "same 1");
+    assert_string_equal(g_lines[2].message, "last message repeated 4 times");
+    assert_string_equal(g_lines[3].message, "last");
+    alog_get_stats(&stats);
+    assert_int_equal(stats.duplicates, 4);
+    alog_stop();
+}
+
+/**
+ * @test FW_UT_29_005: Invalid parameters and state
+ * @pre NULL config, no sink, oversize ring, second start, flush when stopped
+ * @post Each refused with its error code
+ */
+static void test_alog_invalid(void **state) {
+    (void)state;
+
+    alog_config_t config = { .sink = capture_sink };
+    alog_stats_t stats;
+
+    assert_int_equal(alog_start(NULL), ALOG_ERROR_NULL);
+    assert_int_equal(alog_start(&(alog_config_t){ .sink = NULL }), ALOG_ERROR_NULL);
+    config.ring_records = (1U << 16) + 1;
+    assert_int_equal(alog_start(&config), ALOG_ERROR_PARAM);
+    assert_int_equal(alog_flush(10), ALOG_ERROR_STATE);
+    assert_int_equal(alog_get_stats(NULL), ALOG_ERROR_NULL);
+
+    config.ring_records = 0;
+    assert_int_equal(alog_start(&config), ALOG_OK);
+    assert_int_equal(alog_start(&config), ALOG_ERROR_STATE);
+    assert_false(log_line(1, NULL, "no module"));
+    assert_int_equal(alog_get_stats(&stats), ALOG_OK);
+    alog_stop();
+    alog_stop();
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Formatting tests */
+        cmocka_unit_test(test_alog_format),
+        cmocka_unit_test(test_alog_long_strings),
+
+        /* Thread tests */
+        cmocka_unit_test(test_alog_threads),
+        cmocka_unit_test(test_alog_no_ring),
+
+        /* Overload tests */
+        cmocka_unit_test(test_alog_overload),
+        cmocka_unit_test(test_alog_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-29: Async Logger Tests",
+                                       tests, NULL, NULL);
+}
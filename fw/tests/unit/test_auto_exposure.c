@@ -0,0 +1,321 @@
+/**
+ * @file test_auto_exposure.c
+ * @brief Unit tests for auto-exposure controller (FW-UT-15)
+ *
+ * Test ID: FW-UT-15
+ * Coverage: Closed-loop exposure/gain control
+ *
+ * Tests:
+ * - Configuration validation
+ * - Deadband, step limit and settle frames
+ * - Timing-first, then gain, allocation
+ * - Write failure rollback
+ * - Convergence against a linear detector model
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/auto_exposure.h"
+
+static fstats_t test_stats;
+
+/* Stats with only the ROI mean set */
+static const fstats_t *stats_with_mean(float mean) {
+    memset(&test_stats, 0, sizeof(test_stats));
+    test_stats.roi_mean = mean;
+    return &test_stats;
+}
+
+static ae_config_t test_config(void) {
+    ae_config_t config;
+    ae_config_defaults(&config);
+    config.target = 10000;
+    config.damping = 1.0f;
+    config.settle_frames = 0;
+    config.timing_min = 4;
+    config.timing_max = 1000;
+    config.gain_min = AE_GAIN_UNITY / 2;
+    config.gain_max = 4 * AE_GAIN_UNITY;
+    return config;
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_15_001: Reject invalid configuration
+ * @pre NULL, zero target, bad damping/step/limits
+ * @post ae_create returns NULL
+ */
+static void test_ae_invalid(void **state) {
+    (void)state;
+
+    ae_exposure_t initial = { 100, AE_GAIN_UNITY };
+    ae_config_t config = test_config();
+
+    assert_null(ae_create(NULL, &initial));
+    assert_null(ae_create(&config, NULL));
+
+    config.target = 0;
+    assert_null(ae_create(&config, &initial));
+
+    config = test_config();
+    config.damping = 0.0f;
+    assert_null(ae_create(&config, &initial));
+
+    config = test_config();
+    config.max_step = 1.0f;
+    assert_null(ae_create(&config, &initial));
+
+    config = test_config();
+    config.timing_min = 2000;
+    assert_null(ae_create(&config, &initial));
+
+    config = test_config();
+    ae_controller_t *ae = ae_create(&config, &initial);
+    assert_non_null(ae);
+    ae_destroy(ae);
+}
+
+/* ==========================================================================
+ * Control Law Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_15_002: Deadband and step limit
+ * @pre Target 10000, timing 100 at unity gain
+ * @post 9700 -> no change; 2000 -> timing doubles (max_step 2); 40000 -> halves
+ */
+static void test_ae_deadband_step(void **state) {
+    (void)state;
+
+    ae_config_t config = test_config();
+    ae_exposure_t initial = { 100, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &initial);
+    ae_exposure_t next;
+
+    assert_false(ae_update(ae, stats_with_mean(9700.0f), &next));
+
+    assert_true(ae_update(ae, stats_with_mean(2000.0f), &next));
+    assert_int_equal(next.timing, 200);
+    assert_int_equal(next.gain, AE_GAIN_UNITY);
+
+    assert_true(ae_update(ae, stats_with_mean(40000.0f), &next));
+    assert_int_equal(next.timing, 100);
+
+    /* Proportional step within the limit */
+    assert_true(ae_update(ae, stats_with_mean(8000.0f), &next));
+    assert_int_equal(next.timing, 125);
+
+    ae_stats_t stats;
+    ae_get_stats(ae, &stats);
+    assert_int_equal(stats.frames, 4);
+    assert_int_equal(stats.adjustments, 3);
+
+    ae_destroy(ae);
+}
+
+/**
+ * @test FW_UT_15_003: Gain only used beyond timing limits
+ * @pre Timing 800 of max 1000, dark frame
+ * @post Timing clamps to 1000, gain rises; bright frame lowers gain first
+ */
+static void test_ae_gain_allocation(void **state) {
+    (void)state;
+
+    ae_config_t config = test_config();
+    ae_exposure_t initial = { 800, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &initial);
+    ae_exposure_t next;
+
+    assert_true(ae_update(ae, stats_with_mean(5000.0f), &next));
+    assert_int_equal(next.timing, 1000);
+    assert_int_equal(next.gain, 205);   /* 1600 * 128 / 1000 = 204.8 */
+
+    assert_true(ae_update(ae, stats_with_mean(12000.0f), &next));
+    assert_int_equal(next.timing, 1000);
+    assert_int_equal(next.gain, 171);   /* 205 * 10000 / 12000 = 170.8 */
+
+    /* Saturate at both limits */
+    for (int i = 0; i < 4; i++) {
+        ae_update(ae, stats_with_mean(10.0f), &next);
+    }
+    ae_get_exposure(ae, &next);
+    assert_int_equal(next.timing, 1000);
+    assert_int_equal(next.gain, 4 * AE_GAIN_UNITY);
+    assert_false(ae_update(ae, stats_with_mean(10.0f), &next));
+
+    ae_stats_t stats;
+    ae_get_stats(ae, &stats);
+    assert_true(stats.at_limit > 0);
+
+    ae_destroy(ae);
+}
+
+/**
+ * @test FW_UT_15_004: Settle frames after a change
+ * @pre settle_frames = 2
+ * @post Two frames skipped after each adjustment
+ */
+static void test_ae_settle(void **state) {
+    (void)state;
+
+    ae_config_t config = test_config();
+    config.settle_frames = 2;
+    ae_exposure_t initial = { 100, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &initial);
+    ae_exposure_t next;
+
+    assert_true(ae_update(ae, stats_with_mean(5000.0f), &next));
+    assert_false(ae_update(ae, stats_with_mean(5000.0f), &next));
+    assert_false(ae_update(ae, stats_with_mean(5000.0f), &next));
+    assert_true(ae_update(ae, stats_with_mean(5000.0f), &next));
+
+    ae_stats_t stats;
+    ae_get_stats(ae, &stats);
+    assert_int_equal(stats.settle_skips, 2);
+
+    ae_destroy(ae);
+}
+
+/**
+ * @test FW_UT_15_005: Percentile metric
+ * @pre Histogram with 99th percentile near 40000, target 20000
+ * @post Timing halves
+ */
+static void test_ae_percentile(void **state) {
+    (void)state;
+
+    ae_config_t config = test_config();
+    config.metric = AE_METRIC_PERCENTILE;
+    config.percentile = 0.99f;
+    config.target = 20000;
+    ae_exposure_t initial = { 100, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &initial);
+
+    memset(&test_stats, 0, sizeof(test_stats));
+    test_stats.hist[1000 >> FSTATS_HIST_SHIFT] = 900;
+    test_stats.hist[40000 >> FSTATS_HIST_SHIFT] = 100;
+    test_stats.samples = 1000;
+
+    ae_exposure_t next;
+    assert_true(ae_update(ae, &test_stats, &next));
+    assert_int_equal(next.timing, 50);
+
+    ae_destroy(ae);
+}
+
+/* ==========================================================================
+ * Write / Loop Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_15_006: Failed write rolls back
+ * @pre Adjustment requested, write reported failed
+ * @post Exposure reverts, error and latency counters updated
+ */
+static void test_ae_write_failure(void **state) {
+    (void)state;
+
+    ae_config_t config = test_config();
+    config.settle_frames = 3;
+    ae_exposure_t initial = { 100, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &initial);
+    ae_exposure_t next;
+
+    assert_true(ae_update(ae, stats_with_mean(5000.0f), &next));
+    ae_record_write(ae, AE_WRITE_BUDGET_US + 1, false);
+
+    ae_exposure_t current;
+    ae_get_exposure(ae, &current);
+    assert_int_equal(current.timing, 100);
+
+    /* No settle wait after a failed write: retried on the next frame */
+    assert_true(ae_update(ae, stats_with_mean(5000.0f), &next));
+    ae_record_write(ae, 10, true);
+
+    ae_stats_t stats;
+    ae_get_stats(ae, &stats);
+    assert_int_equal(stats.writes, 2);
+    assert_int_equal(stats.write_errors, 1);
+    assert_int_equal(stats.late_writes, 1);
+    assert_int_equal(stats.max_write_us, AE_WRITE_BUDGET_US + 1);
+    assert_int_equal(stats.last_write_us, 10);
+
+    ae_destroy(ae);
+}
+
+/**
+ * @test FW_UT_15_007: Loop converges on a linear detector
+ * @pre Signal = 3 counts per timing unit at unity gain, one frame latency,
+ *      starting 300x under target
+ * @post Within deadband in < 1 s at 30 fps, no further adjustments
+ */
+static void test_ae_converges(void **state) {
+    (void)state;
+
+    ae_config_t config;
+    ae_config_defaults(&config);
+    config.target = 10000;
+
+    ae_exposure_t programmed = { 10, AE_GAIN_UNITY };
+    ae_controller_t *ae = ae_create(&config, &programmed);
+
+    /* Frame n is exposed with the registers programmed before frame n-1 */
+    ae_exposure_t exposing = programmed;
+    int converged_at = -1;
+
+    for (int frame = 0; frame < 40; frame++) {
+        float signal = 3.0f * exposing.timing * exposing.gain / AE_GAIN_UNITY;
+        exposing = programmed;
+
+        ae_exposure_t next;
+        if (ae_update(ae, stats_with_mean(signal), &next)) {
+            ae_record_write(ae, 5, true);
+            programmed = next;
+            converged_at = -1;
+        } else if (converged_at < 0 && signal > 9500.0f && signal < 10500.0f) {
+            converged_at = frame;
+        }
+    }
+
+    assert_true(converged_at >= 0 && converged_at < 30);
+    assert_int_equal(programmed.gain, AE_GAIN_UNITY);
+    assert_true(programmed.timing >= 3167 && programmed.timing <= 3500);
+
+    ae_destroy(ae);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_ae_invalid),
+
+        /* Control law tests */
+        cmocka_unit_test(test_ae_deadband_step),
+        cmocka_unit_test(test_ae_gain_allocation),
+        cmocka_unit_test(test_ae_settle),
+        cmocka_unit_test(test_ae_percentile),
+
+        /* Write / loop tests */
+        cmocka_unit_test(test_ae_write_failure),
+        cmocka_unit_test(test_ae_converges),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-15: Auto-Exposure Controller Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,324 @@
+/**
+ * @file test_calibration.c
+ * @brief Unit tests for calibration accumulator (FW-UT-12)
+ *
+ * Test ID: FW-UT-12
+ * Coverage: On-device dark/flood calibration
+ *
+ * Tests:
+ * - Phase sequencing (flood requires dark)
+ * - Offset map = rounded dark mean
+ * - Gain map normalises flood response, dead pixels get gain 0
+ * - Atomic persistence and CRC-checked reload
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "proc/calibration.h"
+
+#define TEST_WIDTH   19
+#define TEST_HEIGHT  5
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+static const calib_config_t test_config = {
+    .width = TEST_WIDTH,
+    .height = TEST_HEIGHT
+};
+
+static void fill_frame(uint16_t *frame, uint16_t value) {
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = value;
+    }
+}
+
+/* Run a complete dark (offset 100 +/- 1) and flood phase on calib */
+static void run_dark_and_flood(calib_t *calib) {
+    uint16_t frame[TEST_PIXELS];
+
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_DARK, 2), CALIB_OK);
+    fill_frame(frame, 99);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_OK);
+    fill_frame(frame, 101);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+
+    /* Flood: first half of pixels respond 1000 above dark, second half 2000 */
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_FLOOD, 1), CALIB_OK);
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = (i < TEST_PIXELS / 2) ? 1100 : 2100;
+    }
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+}
+
+/* ==========================================================================
+ * Phase Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_12_001: Reject invalid configuration and phase requests
+ * @pre NULL/zero config, zero frames, flood before dark
+ * @post Errors returned, accumulate while idle rejected
+ */
+static void test_calib_invalid(void **state) {
+    (void)state;
+
+    assert_null(calib_create(NULL));
+    calib_config_t bad = { .width = 0, .height = 4 };
+    assert_null(calib_create(&bad));
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    uint16_t frame[TEST_PIXELS] = {0};
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_ERROR_STATE);
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_DARK, 0), CALIB_ERROR_PARAM);
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_DARK, CALIB_MAX_FRAMES + 1), CALIB_ERROR_PARAM);
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_IDLE, 4), CALIB_ERROR_PARAM);
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_FLOOD, 4), CALIB_ERROR_STATE);
+
+    assert_false(calib_maps_ready(calib));
+    assert_null(calib_get_offset_map(calib));
+    assert_null(calib_get_gain_map(calib));
+
+    calib_destroy(calib);
+}
+
+/**
+ * @test FW_UT_12_002: Dark phase produces rounded mean offset
+ * @pre 3 frames with values 10, 11, 11 (mean 10.67)
+ * @post offset = 11 everywhere, phase returns to IDLE
+ */
+static void test_calib_dark_offset(void **state) {
+    (void)state;
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    uint16_t frame[TEST_PIXELS];
+    assert_int_equal(calib_begin(calib, CALIB_PHASE_DARK, 3), CALIB_OK);
+    assert_int_equal(calib_get_phase(calib), CALIB_PHASE_DARK);
+
+    fill_frame(frame, 10);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_OK);
+    fill_frame(frame, 11);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_OK);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+
+    assert_int_equal(calib_get_phase(calib), CALIB_PHASE_IDLE);
+
+    const uint16_t *offset = calib_get_offset_map(calib);
+    assert_non_null(offset);
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        assert_int_equal(offset[i], 11);
+    }
+
+    calib_stats_t stats;
+    calib_get_stats(calib, &stats);
+    assert_int_equal(stats.dark_frames, 3);
+    assert_int_equal(stats.flood_frames, 0);
+    assert_false(calib_maps_ready(calib));
+
+    calib_destroy(calib);
+}
+
+/**
+ * @test FW_UT_12_003: Flood phase normalises gain to mean response
+ * @pre Half the pixels respond 1000, half 2000 above dark
+ * @post Gains ~1.5 and ~0.75 (mean 1500 for even split)
+ */
+static void test_calib_flood_gain(void **state) {
+    (void)state;
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    run_dark_and_flood(calib);
+    assert_true(calib_maps_ready(calib));
+
+    calib_stats_t stats;
+    calib_get_stats(calib, &stats);
+    assert_int_equal(stats.dead_pixels, 0);
+
+    const float *gain = calib_get_gain_map(calib);
+    assert_non_null(gain);
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        float signal = (i < TEST_PIXELS / 2) ? 1000.0f : 2000.0f;
+        assert_float_equal(gain[i] * signal, stats.flood_mean, 0.01);
+    }
+
+    calib_destroy(calib);
+}
+
+/**
+ * @test FW_UT_12_004: Dead pixels get zero gain
+ * @pre Pixel 0 has no flood response
+ * @post gain[0] = 0, dead_pixels = 1, others unaffected
+ */
+static void test_calib_dead_pixel(void **state) {
+    (void)state;
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    uint16_t frame[TEST_PIXELS];
+    fill_frame(frame, 100);
+    calib_begin(calib, CALIB_PHASE_DARK, 1);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+
+    fill_frame(frame, 1100);
+    frame[0] = 105;
+    calib_begin(calib, CALIB_PHASE_FLOOD, 1);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+
+    const float *gain = calib_get_gain_map(calib);
+    assert_true(gain[0] == 0.0f);
+    assert_float_equal(gain[1], 1.0, 1e-6);
+
+    calib_stats_t stats;
+    calib_get_stats(calib, &stats);
+    assert_int_equal(stats.dead_pixels, 1);
+
+    calib_destroy(calib);
+}
+
+/**
+ * @test FW_UT_12_005: New dark phase invalidates old gain
+ * @pre Completed dark + flood, then a new dark phase
+ * @post Maps not ready until a new flood completes
+ */
+static void test_calib_redo_dark(void **state) {
+    (void)state;
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    run_dark_and_flood(calib);
+    assert_true(calib_maps_ready(calib));
+
+    uint16_t frame[TEST_PIXELS];
+    fill_frame(frame, 50);
+    calib_begin(calib, CALIB_PHASE_DARK, 1);
+    assert_int_equal(calib_accumulate(calib, frame), CALIB_PHASE_COMPLETE);
+
+    assert_false(calib_maps_ready(calib));
+    assert_null(calib_get_gain_map(calib));
+
+    calib_destroy(calib);
+}
+
+/* ==========================================================================
+ * Persistence Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_12_006: Save and reload maps
+ * @pre Completed calibration
+ * @post Reloaded maps identical, no temp file left behind
+ */
+static void test_calib_save_load(void **state) {
+    (void)state;
+
+    char path[] = "/tmp/test_calib_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+
+    assert_int_equal(calib_save_maps(calib, path), CALIB_ERROR_STATE);
+
+    run_dark_and_flood(calib);
+    assert_int_equal(calib_save_maps(calib, path), CALIB_OK);
+
+    char tmp_path[64];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    assert_int_not_equal(access(tmp_path, F_OK), 0);
+
+    uint16_t offset[TEST_PIXELS];
+    float gain[TEST_PIXELS];
+    assert_int_equal(calib_load_maps(path, TEST_WIDTH, TEST_HEIGHT, offset, gain), CALIB_OK);
+    assert_memory_equal(offset, calib_get_offset_map(calib), sizeof(offset));
+    assert_memory_equal(gain, calib_get_gain_map(calib), sizeof(gain));
+
+    /* Geometry mismatch */
+    assert_int_equal(calib_load_maps(path, TEST_WIDTH + 1, TEST_HEIGHT, offset, gain),
+                     CALIB_ERROR_FORMAT);
+
+    calib_destroy(calib);
+    unlink(path);
+}
+
+/**
+ * @test FW_UT_12_007: Corrupted map file rejected
+ * @pre Saved map with one payload byte flipped
+ * @post calib_load_maps returns CALIB_ERROR_FORMAT, missing file CALIB_ERROR_FILE
+ */
+static void test_calib_load_corrupt(void **state) {
+    (void)state;
+
+    char path[] = "/tmp/test_calib_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+
+    calib_t *calib = calib_create(&test_config);
+    assert_non_null(calib);
+    run_dark_and_flood(calib);
+    assert_int_equal(calib_save_maps(calib, path), CALIB_OK);
+
+    FILE *f = fopen(path, "r+b");
+    assert_non_null(f);
+    fseek(f, (long)sizeof(calib_file_header_t) + 3, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, (long)sizeof(calib_file_header_t) + 3, SEEK_SET);
+    fputc(c ^ 0x01, f);
+    fclose(f);
+
+    uint16_t offset[TEST_PIXELS];
+    float gain[TEST_PIXELS];
+    assert_int_equal(calib_load_maps(path, TEST_WIDTH, TEST_HEIGHT, offset, gain),
+                     CALIB_ERROR_FORMAT);
+
+    unlink(path);
+    assert_int_equal(calib_load_maps(path, TEST_WIDTH, TEST_HEIGHT, offset, gain),
+                     CALIB_ERROR_FILE);
+
+    calib_destroy(calib);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Phase tests */
+        cmocka_unit_test(test_calib_invalid),
+        cmocka_unit_test(test_calib_dark_offset),
+        cmocka_unit_test(test_calib_flood_gain),
+        cmocka_unit_test(test_calib_dead_pixel),
+        cmocka_unit_test(test_calib_redo_dark),
+
+        /* Persistence tests */
+        cmocka_unit_test(test_calib_save_load),
+        cmocka_unit_test(test_calib_load_corrupt),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-12: Calibration Accumulator Tests",
+                                       tests, NULL, NULL);
+}
@@ -20,6 +20,9 @@
 #include <cmocka.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
 
 /* Configuration structure */
 typedef struct {
@@ -52,6 +55,91 @@ typedef struct {
 
     /* Logging */
     uint8_t log_level;
+
+    /* Protection */
+    uint16_t overexposure_threshold;
+    uint8_t overflow_action;  /* 0=Stop, 1=Backoff, 2=None */
+
+    /* Processing pipeline per scan mode */
+    char pipeline[3][8][16];
+    uint8_t pipeline_stages[3];
+    bool pipeline_fused;
+    uint16_t pipeline_band_rows;
+
+    /* Panel readout map */
+    uint16_t readout_block_cols;
+    uint8_t readout_block_count;
+    uint8_t readout_block_order[32];
+    uint32_t readout_mirrored_blocks;
+    bool readout_dual_side;
+    bool readout_bottom_flipped;
+    bool readout_bottom_mirrored;
+
+    /* Panel orientation */
+    uint8_t orientation;
+
+    /* Additional outputs */
+    struct {
+        char host_ip[16];
+        uint16_t port;
+        uint8_t format;  /* 0=raw16, 1=display8 */
+    } outputs[4];
+    uint8_t output_count;
+
+    /* Display conversion */
+    bool display_auto_window;
+    uint16_t display_window_low;
+    uint16_t display_window_high;
+    float display_low_percentile;
+    float display_high_percentile;
+    float display_gamma;
+    uint8_t display_method;  /* 0=auto, 1=lut, 2=arith */
+
+    /* Drift tracking */
+    bool drift_enabled;
+    uint32_t drift_pixels_per_frame;
+    uint8_t drift_weight_shift;
+    uint16_t drift_offset_threshold;
+    uint16_t drift_noise_threshold;
+    uint16_t drift_dark_level;
+
+    /* Image QA */
+    bool qa_enabled;
+    uint8_t qa_row_step;
+    uint8_t qa_roi_count;
+    struct {
+        uint16_t x;
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+    } qa_rois[5];
+
+    /* HDR fusion */
+    bool hdr_enabled;
+    uint16_t hdr_low_gain;
+    uint16_t hdr_high_gain;
+    uint16_t hdr_threshold;
+    uint16_t hdr_blend;
+    uint8_t hdr_output_shift;
+
+    /* Exposure gate */
+    uint8_t gate_action;
+    uint16_t gate_dark_level;
+    uint16_t gate_mean_margin;
+    uint16_t gate_max_margin;
+    uint8_t gate_row_step;
+    uint16_t gate_hold_frames;
+    uint8_t gate_decimate;
+
+    /* Metrics endpoint */
+    uint16_t metrics_port;
+    char metrics_listen[16];
+    uint16_t metrics_page_ms;
+
+    /* GET_STATUS collector */
+    uint16_t status_state_ms;
+    uint16_t status_battery_ms;
+    uint16_t status_temp_ms;
 } detector_config_t;
 
 /* Function under test */
@@ -70,6 +158,7 @@ static const char *valid_yaml_config =
     "  rows: 2048\n"
     "  cols: 2048\n"
     "  bit_depth: 16\n"
+    "  orientation: rot90\n"
     "\n"
     "timing:\n"
     "  frame_rate: 15\n"
@@ -88,12 +177,84 @@ static const char *valid_yaml_config =
     "  data_port: 8000\n"
     "  control_port: 8001\n"
     "  send_buffer_size: 16777216\n"
+    "  outputs:\n"
+    "    - { host_ip: \"192.168.1.101\", port: 8010, format: display8 }\n"
+    "    - host_ip: \"192.168.1.102\"\n"
+    "      port: 8020\n"
+    "      format: raw16\n"
+    "\n"
+    "display:\n"
+    "  window: auto\n"
+    "  low_percentile: 0.5\n"
+    "  high_percentile: 99.5\n"
+    "  gamma: 2.2\n"
+    "  method: lut\n"
+    "\n"
+    "drift:\n"
+    "  enabled: true\n"
+    "  pixels_per_frame: 131072\n"
+    "  weight_shift: 7\n"
+    "  offset_threshold: 150\n"
+    "  noise_threshold: 40\n"
+    "  dark_level: 1200\n"
+    "\n"
+    "qa:\n"
+    "  enabled: true\n"
+    "  row_step: 8\n"
+    "  rois:\n"
+    "    - { x: 924, y: 924, width: 200, height: 200 }\n"
+    "    - { x: 0, y: 1848, width: 2048, height: 200 }\n"
+    "\n"
+    "hdr:\n"
+    "  enabled: true\n"
+    "  low_gain: 128\n"
+    "  high_gain: 512\n"
+    "  threshold: 58000\n"
+    "  blend: 4000\n"
+    "  output_shift: 2\n"
+    "\n"
+    "gate:\n"
+    "  action: decimate\n"
+    "  dark_level: 1000\n"
+    "  mean_margin: 40\n"
+    "  max_margin: 3000\n"
+    "  row_step: 8\n"
+    "  hold_frames: 3\n"
+    "  decimate: 4\n"
+    "\n"
+    "metrics:\n"
+    "  port: 9464\n"
+    "  listen: 0.0.0.0\n"
+    "  page_ms: 20\n"
+    "\n"
+    "status:\n"
+    "  state_ms: 5\n"
+    "  battery_ms: 2000\n"
+    "  temp_ms: 250\n"
     "\n"
     "scan:\n"
     "  mode: continuous\n"
     "\n"
     "logging:\n"
-    "  level: INFO\n";
+    "  level: INFO\n"
+    "\n"
+    "protection:\n"
+    "  overexposure_threshold: 60000\n"
+    "  overflow_action: backoff\n"
+    "\n"
+    "readout:\n"
+    "  block_cols: 256\n"
+    "  block_order: [1, 0, 3, 2, 5, 4, 7, 6]\n"
+    "  mirrored_blocks: [0, 2]\n"
+    "  dual_side: true\n"
+    "  bottom_flipped: yes\n"
+    "\n"
+    "pipeline:\n"
+    "  execution: fused\n"
+    "  band_rows: 16\n"
+    "  continuous: [correction, defects, stats, packetize]\n"
+    "  calibration:\n"
+    "    - calibrate\n";
 
 /* ==========================================================================
  * Valid Configuration Tests
@@ -116,10 +277,73 @@ static void test_config_load_valid(void **state) {
     assert_int_equal(config.rows, 2048);
     assert_int_equal(config.cols, 2048);
     assert_int_equal(config.bit_depth, 16);
+    assert_int_equal(config.orientation, 3);
+    assert_int_equal(config.output_count, 2);
+    assert_string_equal(config.outputs[0].host_ip, "192.168.1.101");
+    assert_int_equal(config.outputs[0].port, 8010);
+    assert_int_equal(config.outputs[0].format, 1);
+    assert_string_equal(config.outputs[1].host_ip, "192.168.1.102");
+    assert_int_equal(config.outputs[1].port, 8020);
+    assert_int_equal(config.outputs[1].format, 0);
+    assert_true(config.display_auto_window);
+    assert_true(config.display_low_percentile > 0.49f && config.display_low_percentile < 0.51f);
+    assert_true(config.display_high_percentile > 99.4f && config.display_high_percentile < 99.6f);
+    assert_true(config.display_gamma > 2.19f && config.display_gamma < 2.21f);
+    assert_int_equal(config.display_method, 1);
+    assert_true(config.drift_enabled);
+    assert_int_equal(config.drift_pixels_per_frame, 131072);
+    assert_int_equal(config.drift_weight_shift, 7);
+    assert_int_equal(config.drift_offset_threshold, 150);
+    assert_int_equal(config.drift_noise_threshold, 40);
+    assert_int_equal(config.drift_dark_level, 1200);
+    assert_true(config.qa_enabled);
+    assert_int_equal(config.qa_row_step, 8);
+    assert_int_equal(config.qa_roi_count, 2);
+    assert_int_equal(config.qa_rois[0].x, 924);
+    assert_int_equal(config.qa_rois[0].height, 200);
+    assert_int_equal(config.qa_rois[1].y, 1848);
+    assert_int_equal(config.qa_rois[1].width, 2048);
+    assert_true(config.hdr_enabled);
+    assert_int_equal(config.hdr_low_gain, 128);
+    assert_int_equal(config.hdr_high_gain, 512);
+    assert_int_equal(config.hdr_threshold, 58000);
+    assert_int_equal(config.hdr_blend, 4000);
+    assert_int_equal(config.hdr_output_shift, 2);
+    assert_int_equal(config.gate_action, 2);
+    assert_int_equal(config.gate_dark_level, 1000);
+    assert_int_equal(config.gate_mean_margin, 40);
+    assert_int_equal(config.gate_max_margin, 3000);
+    assert_int_equal(config.gate_row_step, 8);
+    assert_int_equal(config.gate_hold_frames, 3);
+    assert_int_equal(config.gate_decimate, 4);
+    assert_int_equal(config.metrics_port, 9464);
+    assert_string_equal(config.metrics_listen, "0.0.0.0");
+    assert_int_equal(config.metrics_page_ms, 20);
+    assert_int_equal(config.status_state_ms, 5);
+    assert_int_equal(config.status_battery_ms, 2000);
+    assert_int_equal(config.status_temp_ms, 250);
     assert_int_equal(config.frame_rate, 15);
     assert_int_equal(config.spi_speed_hz, 50000000);
     assert_int_equal(config.data_port, 8000);
     assert_int_equal(config.control_port, 8001);
+    assert_int_equal(config.overexposure_threshold, 60000);
+    assert_int_equal(config.overflow_action, 1);
+    assert_int_equal(config.pipeline_stages[0], 0);
+    assert_int_equal(config.pipeline_stages[1], 4);
+    assert_string_equal(config.pipeline[1][0], "correction");
+    assert_string_equal(config.pipeline[1][3], "packetize");
+    assert_int_equal(config.pipeline_stages[2], 1);
+    assert_string_equal(config.pipeline[2][0], "calibrate");
+    assert_true(config.pipeline_fused);
+    assert_int_equal(config.pipeline_band_rows, 16);
+    assert_int_equal(config.readout_block_cols, 256);
+    assert_int_equal(config.readout_block_count, 8);
+    assert_int_equal(config.readout_block_order[0], 1);
+    assert_int_equal(config.readout_block_order[7], 6);
+    assert_int_equal(config.readout_mirrored_blocks, 0x5);
+    assert_true(config.readout_dual_side);
+    assert_true(config.readout_bottom_flipped);
+    assert_false(config.readout_bottom_mirrored);
 }
 
 /**
@@ -430,6 +654,269 @@ static void test_config_load_null_config(void **state) {
     assert_int_equal(result, -EINVAL);
 }
 
+/**
+ * @test FW_UT_04_018: Pipeline with too many stages
+ * @pre Continuous chain lists 9 stages (max 8)
+ * @post Load fails validation
+ */
+static void test_config_load_pipeline_too_long(void **state) {
+    (void)state;
+
+    static char yaml[2048];
+    snprintf(yaml, sizeof(yaml), "%s  single: [a, b, c, d, e, f, g, h, i]\n",
+             valid_yaml_config);
+    mock_yaml_set_content(yaml);
+
+    detector_config_t config;
+    int result = config_load("detector_config.yaml", &config);
+    assert_int_not_equal(result, 0);
+}
+
+/**
+ * @test FW_UT_04_019: Inconsistent readout map
+ * @pre block_order repeats a block / names too few blocks, block_cols does
+ *      not divide the columns
+ * @post Load fails validation for each
+ */
+static void test_config_load_readout_invalid(void **state) {
+    (void)state;
+
+    static const char *const readouts[] = {
+        "  block_order: [0, 0, 1, 2, 3, 4, 5, 6]\n",
+        "  block_order: [1, 0]\n",
+        "  block_cols: 300\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(readouts) / sizeof(readouts[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%sreadout:\n%s", valid_yaml_config, readouts[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_020: Unknown panel orientation
+ * @pre panel.orientation names no transform
+ * @post Load fails validation
+ */
+static void test_config_load_orientation_invalid(void **state) {
+    (void)state;
+
+    static char yaml[2048];
+    snprintf(yaml, sizeof(yaml), "%s", valid_yaml_config);
+    char *name = strstr(yaml, "rot90");
+    assert_non_null(name);
+    memcpy(name, "rot45", 5);
+    mock_yaml_set_content(yaml);
+
+    detector_config_t config;
+    int result = config_load("detector_config.yaml", &config);
+    assert_int_not_equal(result, 0);
+}
+
+/**
+ * @test FW_UT_04_021: Invalid outputs and display settings
+ * @pre Unknown output format, port below 1024, missing host, unknown
+ *      display method, gamma out of range, inverted manual window
+ * @post Load fails validation for each
+ */
+static void test_config_load_outputs_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "network:\n  outputs:\n    - { host_ip: \"10.0.0.2\", port: 9000, format: jpeg }\n",
+        "network:\n  outputs:\n    - { host_ip: \"10.0.0.2\", port: 80 }\n",
+        "network:\n  outputs:\n    - { port: 9000 }\n",
+        "display:\n  method: fastest\n",
+        "display:\n  gamma: 20\n",
+        "display:\n  window: manual\n  window_low: 3000\n  window_high: 2000\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_022: Invalid drift settings
+ * @pre Statistics memory beyond 2^12 frames, non-numeric memory, noise
+ *      threshold above the 2047-count clamp
+ * @post Load fails validation for each
+ */
+static void test_config_load_drift_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "drift:\n  weight_shift: 13\n",
+        "drift:\n  weight_shift: long\n",
+        "drift:\n  noise_threshold: 3000\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_023: Invalid QA settings
+ * @pre Row step above 64, ROI past the panel edge, empty ROI, ROI missing
+ *      a field, more than five ROIs, rois not a list
+ * @post Load fails validation for each
+ */
+static void test_config_load_qa_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "qa:\n  row_step: 65\n",
+        "qa:\n  rois:\n    - { x: 2000, y: 0, width: 49, height: 10 }\n",
+        "qa:\n  rois:\n    - { x: 0, y: 0, width: 0, height: 10 }\n",
+        "qa:\n  rois:\n    - { x: 0, y: 0, width: 10 }\n",
+        "qa:\n  rois: [{ x: 0, y: 0, width: 1, height: 1 }, { x: 0, y: 0, width: 1, height: 1 },"
+        " { x: 0, y: 0, width: 1, height: 1 }, { x: 0, y: 0, width: 1, height: 1 },"
+        " { x: 0, y: 0, width: 1, height: 1 }, { x: 0, y: 0, width: 1, height: 1 }]\n",
+        "qa:\n  rois: centre\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_024: Invalid HDR settings
+ * @pre High gain not above the low gain, ratio above 64x, default low gain
+ *      with a lower high gain, blend not below the threshold, blend above
+ *      the default threshold, output shift above 8
+ * @post Load fails validation for each
+ */
+static void test_config_load_hdr_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "hdr:\n  enabled: true\n  low_gain: 256\n  high_gain: 256\n",
+        "hdr:\n  enabled: true\n  low_gain: 100\n  high_gain: 6401\n",
+        "hdr:\n  enabled: true\n  low_gain: 0\n  high_gain: 100\n",
+        "hdr:\n  enabled: true\n  threshold: 1000\n  blend: 1000\n",
+        "hdr:\n  enabled: true\n  threshold: 0\n  blend: 60000\n",
+        "hdr:\n  output_shift: 9\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_025: Invalid exposure gate settings
+ * @pre Unknown action, row step above 64, decimate 1 or above 16, dark
+ *      level plus margin at full scale
+ * @post Load fails validation for each
+ */
+static void test_config_load_gate_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "gate:\n  action: skip\n",
+        "gate:\n  row_step: 65\n",
+        "gate:\n  decimate: 1\n",
+        "gate:\n  decimate: 17\n",
+        "gate:\n  action: drop\n  dark_level: 65000\n  max_margin: 535\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_026: Invalid metrics endpoint settings
+ * @pre Privileged, negative and non-numeric port; listen address that is
+ *      not IPv4 or is too long; stats page period above 1000 ms or negative
+ * @post Load fails validation for each
+ */
+static void test_config_load_metrics_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "metrics:\n  port: 80\n",
+        "metrics:\n  port: -1\n",
+        "metrics:\n  port: http\n",
+        "metrics:\n  listen: localhost\n",
+        "metrics:\n  listen: 192.168.100.1000\n",
+        "metrics:\n  page_ms: 1001\n",
+        "metrics:\n  page_ms: -5\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
+/**
+ * @test FW_UT_04_027: Invalid status collector periods
+ * @pre Period above 60000 ms, negative or non-numeric
+ * @post Load fails validation for each
+ */
+static void test_config_load_status_invalid(void **state) {
+    (void)state;
+
+    static const char *const sections[] = {
+        "status:\n  state_ms: 60001\n",
+        "status:\n  battery_ms: -1\n",
+        "status:\n  temp_ms: fast\n",
+    };
+    static char yaml[2048];
+
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        snprintf(yaml, sizeof(yaml), "%s%s", valid_yaml_config, sections[i]);
+        mock_yaml_set_content(yaml);
+
+        detector_config_t config;
+        int result = config_load("detector_config.yaml", &config);
+        assert_int_not_equal(result, 0);
+    }
+}
+
 /* ==========================================================================
  * Test Runner
  * ========================================================================== */
@@ -462,6 +949,16 @@ int main(void) {
         cmocka_unit_test(test_config_load_file_not_found),
         cmocka_unit_test(test_config_load_malformed_yaml),
         cmocka_unit_test(test_config_load_null_config),
+        cmocka_unit_test(test_config_load_pipeline_too_long),
+        cmocka_unit_test(test_config_load_readout_invalid),
+        cmocka_unit_test(test_config_load_orientation_invalid),
+        cmocka_unit_test(test_config_load_outputs_invalid),
+        cmocka_unit_test(test_config_load_drift_invalid),
+        cmocka_unit_test(test_config_load_qa_invalid),
+        cmocka_unit_test(test_config_load_hdr_invalid),
+        cmocka_unit_test(test_config_load_gate_invalid),
+        cmocka_unit_test(test_config_load_metrics_invalid),
+        cmocka_unit_test(test_config_load_status_invalid),
     };
 
     return cmocka_run_group_tests_name("FW-UT-04: Configuration Loader Tests",
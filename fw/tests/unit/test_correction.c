@@ -0,0 +1,539 @@
+/**
+ * @file test_correction.c
+ * @brief Unit tests for offset/gain correction stage (FW-UT-11)
+ *
+ * Test ID: FW-UT-11
+ * Coverage: On-device flat-field correction
+ *
+ * Tests:
+ * - Configuration validation and map loading
+ * - Q2.14 and half-float gain arithmetic (rounding, saturation)
+ * - SIMD kernel output matches scalar reference (including row tails)
+ * - Row band bounds and full-frame statistics
+ * - Thread pool band split matches the serial result
+ * - Per-tile counts from the counting kernels match the corrected output
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/correction.h"
+
+/* Small frame with a width that is not a multiple of any SIMD step */
+#define TEST_WIDTH   37
+#define TEST_HEIGHT  9
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+static correction_t *create_stage(corr_gain_format_t format, uint32_t band_rows) {
+    corr_config_t config = {
+        .width = TEST_WIDTH,
+        .height = TEST_HEIGHT,
+        .gain_format = format,
+        .band_rows = band_rows
+    };
+    return correction_create(&config);
+}
+
+/* Simple deterministic PRNG so failures are reproducible */
+static uint32_t test_rand(uint32_t *seed) {
+    *seed = *seed * 1664525U + 1013904223U;
+    return *seed >> 8;
+}
+
+/* Reference arithmetic, written independently of the library kernels */
+static uint16_t ref_q14(uint16_t raw, uint16_t offset, uint16_t gain) {
+    uint64_t d = (raw > offset) ? (uint64_t)(raw - offset) : 0;
+    uint64_t v = (d * gain + 8192) >> 14;
+    return (v > 65535) ? 65535 : (uint16_t)v;
+}
+
+/* ==========================================================================
+ * Configuration Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_11_001: Reject invalid configuration
+ * @pre NULL config, zero dimensions, unknown gain format
+ * @post correction_create returns NULL
+ */
+static void test_correction_create_invalid(void **state) {
+    (void)state;
+
+    assert_null(correction_create(NULL));
+
+    corr_config_t config = { .width = 0, .height = 16, .gain_format = CORR_GAIN_Q2_14 };
+    assert_null(correction_create(&config));
+
+    config.width = 16;
+    config.gain_format = (corr_gain_format_t)7;
+    assert_null(correction_create(&config));
+}
+
+/**
+ * @test FW_UT_11_002: Stage not ready until both maps loaded
+ * @pre Stage created without maps
+ * @post apply returns CORR_ERROR_NOT_READY, wrong map size rejected
+ */
+static void test_correction_not_ready(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_Q2_14, 0);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS] = {0};
+    uint16_t offset[TEST_PIXELS] = {0};
+
+    assert_false(correction_is_ready(corr));
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_ERROR_NOT_READY);
+
+    assert_int_equal(correction_set_offset_map(corr, offset, TEST_PIXELS - 1), CORR_ERROR_PARAM);
+    assert_int_equal(correction_set_offset_map(corr, offset, TEST_PIXELS), CORR_OK);
+    assert_false(correction_is_ready(corr));
+    assert_int_equal(correction_apply_rows(corr, frame, 0, 1), CORR_ERROR_NOT_READY);
+
+    correction_destroy(corr);
+}
+
+/* ==========================================================================
+ * Arithmetic Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_11_003: Q2.14 offset subtraction and unity gain
+ * @pre offset = 100, gain = 1.0
+ * @post out = raw - 100, clamped at 0
+ */
+static void test_correction_q14_unity(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_Q2_14, 0);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS];
+    uint16_t offset[TEST_PIXELS];
+    float gain[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = (uint16_t)(i * 3);
+        offset[i] = 100;
+        gain[i] = 1.0f;
+    }
+
+    assert_int_equal(correction_set_offset_map(corr, offset, TEST_PIXELS), CORR_OK);
+    assert_int_equal(correction_set_gain_map(corr, gain, TEST_PIXELS), CORR_OK);
+    assert_true(correction_is_ready(corr));
+
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        uint16_t expected = (i * 3 > 100) ? (uint16_t)(i * 3 - 100) : 0;
+        assert_int_equal(frame[i], expected);
+    }
+
+    correction_destroy(corr);
+}
+
+/**
+ * @test FW_UT_11_004: Gain conversion saturates and rounds
+ * @pre Gains outside Q2.14 range, negative and NaN
+ * @post Saturated to 0xFFFF, 0 for negative/NaN, 1.0 == 16384
+ */
+static void test_correction_gain_conversion(void **state) {
+    (void)state;
+
+    assert_int_equal(correction_gain_to_q14(1.0f), CORR_GAIN_Q_ONE);
+    assert_int_equal(correction_gain_to_q14(0.5f), CORR_GAIN_Q_ONE / 2);
+    assert_int_equal(correction_gain_to_q14(8.0f), 0xFFFF);
+    assert_int_equal(correction_gain_to_q14(-1.0f), 0);
+    assert_int_equal(correction_gain_to_q14(__builtin_nanf("")), 0);
+
+    /* Half-float round trip for representative gains */
+    assert_int_equal(correction_float_to_fp16(1.0f), 0x3C00);
+    assert_int_equal(correction_float_to_fp16(-2.0f), 0xC000);
+    assert_int_equal(correction_float_to_fp16(65504.0f), 0x7BFF);
+    assert_int_equal(correction_float_to_fp16(1.0e6f), 0x7C00);
+    assert_true(correction_fp16_to_float(0x3C00) == 1.0f);
+    assert_true(correction_fp16_to_float(0x0001) == 5.9604644775390625e-8f);
+
+    /* Every finite half value survives half -> float -> half */
+    for (uint32_t h = 0; h < 0x7C00; h++) {
+        assert_int_equal(correction_float_to_fp16(correction_fp16_to_float((uint16_t)h)), h);
+    }
+}
+
+/**
+ * @test FW_UT_11_005: Output saturates at 65535
+ * @pre raw = 60000, offset = 0, gain = 3.9
+ * @post All outputs 65535 for Q2.14 and half-float
+ */
+static void test_correction_saturation(void **state) {
+    (void)state;
+
+    corr_gain_format_t formats[] = { CORR_GAIN_Q2_14, CORR_GAIN_FP16 };
+
+    for (size_t f = 0; f < 2; f++) {
+        correction_t *corr = create_stage(formats[f], 0);
+        assert_non_null(corr);
+
+        uint16_t frame[TEST_PIXELS];
+        uint16_t offset[TEST_PIXELS] = {0};
+        float gain[TEST_PIXELS];
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = 60000;
+            gain[i] = 3.9f;
+        }
+
+        correction_set_offset_map(corr, offset, TEST_PIXELS);
+        correction_set_gain_map(corr, gain, TEST_PIXELS);
+        assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            assert_int_equal(frame[i], 65535);
+        }
+
+        correction_destroy(corr);
+    }
+}
+
+/**
+ * @test FW_UT_11_006: Q2.14 kernel matches reference on random data
+ * @pre Random raw, offset and gain over full uint16 range
+ * @post Bit-identical to reference, including row tails
+ */
+static void test_correction_q14_matches_reference(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_Q2_14, 4);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS];
+    uint16_t offset[TEST_PIXELS];
+    uint16_t gain[TEST_PIXELS];
+    uint16_t expected[TEST_PIXELS];
+    uint32_t seed = 0x1234;
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = (uint16_t)test_rand(&seed);
+        offset[i] = (uint16_t)(test_rand(&seed) & 0x0FFF);
+        gain[i] = (uint16_t)test_rand(&seed);
+        expected[i] = ref_q14(frame[i], offset[i], gain[i]);
+    }
+
+    correction_set_offset_map(corr, offset, TEST_PIXELS);
+    assert_int_equal(correction_set_gain_map_raw(corr, gain, TEST_PIXELS), CORR_OK);
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+
+    assert_memory_equal(frame, expected, sizeof(frame));
+
+    correction_destroy(corr);
+}
+
+/**
+ * @test FW_UT_11_007: Half-float kernel matches reference on random data
+ * @pre Random raw/offset, gains in [0.25, 2.25)
+ * @post Bit-identical to float reference with round half up
+ */
+static void test_correction_fp16_matches_reference(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_FP16, 0);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS];
+    uint16_t offset[TEST_PIXELS];
+    float gain[TEST_PIXELS];
+    uint16_t expected[TEST_PIXELS];
+    uint32_t seed = 0xBEEF;
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = (uint16_t)test_rand(&seed);
+        offset[i] = (uint16_t)(test_rand(&seed) & 0x0FFF);
+        gain[i] = 0.25f + (float)(test_rand(&seed) & 0xFFFF) / 32768.0f;
+
+        float g = correction_fp16_to_float(correction_float_to_fp16(gain[i]));
+        float d = (frame[i] > offset[i]) ? (float)(frame[i] - offset[i]) : 0.0f;
+        float v = d * g + 0.5f;
+        expected[i] = (v >= 65535.0f) ? 65535 : (uint16_t)v;
+    }
+
+    correction_set_offset_map(corr, offset, TEST_PIXELS);
+    correction_set_gain_map(corr, gain, TEST_PIXELS);
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+
+    assert_memory_equal(frame, expected, sizeof(frame));
+
+    correction_destroy(corr);
+}
+
+/* ==========================================================================
+ * Band Processing Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_11_008: Row band only touches its rows
+ * @pre Rows 2..4 corrected with gain 2.0
+ * @post Other rows unchanged, out-of-range band rejected
+ */
+static void test_correction_apply_rows(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_Q2_14, 0);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS];
+    uint16_t offset[TEST_PIXELS] = {0};
+    float gain[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 1000;
+        gain[i] = 2.0f;
+    }
+
+    correction_set_offset_map(corr, offset, TEST_PIXELS);
+    correction_set_gain_map(corr, gain, TEST_PIXELS);
+
+    assert_int_equal(correction_apply_rows(corr, frame, 2, 3), CORR_OK);
+
+    for (int row = 0; row < TEST_HEIGHT; row++) {
+        uint16_t expected = (row >= 2 && row < 5) ? 2000 : 1000;
+        for (int col = 0; col < TEST_WIDTH; col++) {
+            assert_int_equal(frame[row * TEST_WIDTH + col], expected);
+        }
+    }
+
+    assert_int_equal(correction_apply_rows(corr, frame, TEST_HEIGHT, 1), CORR_ERROR_PARAM);
+    assert_int_equal(correction_apply_rows(corr, frame, 5, TEST_HEIGHT), CORR_ERROR_PARAM);
+    assert_int_equal(correction_apply_rows(NULL, frame, 0, 1), CORR_ERROR_NULL);
+
+    correction_destroy(corr);
+}
+
+/**
+ * @test FW_UT_11_009: Full frame statistics
+ * @pre band_rows = 4, height = 9
+ * @post 3 bands per frame, frame counter incremented
+ */
+static void test_correction_stats(void **state) {
+    (void)state;
+
+    correction_t *corr = create_stage(CORR_GAIN_Q2_14, 4);
+    assert_non_null(corr);
+
+    uint16_t frame[TEST_PIXELS] = {0};
+    uint16_t offset[TEST_PIXELS] = {0};
+    uint16_t gain[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        gain[i] = CORR_GAIN_Q_ONE;
+    }
+
+    correction_set_offset_map(corr, offset, TEST_PIXELS);
+    correction_set_gain_map_raw(corr, gain, TEST_PIXELS);
+
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+    assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+
+    corr_stats_t stats;
+    correction_get_stats(corr, &stats);
+    assert_int_equal(stats.frames_corrected, 2);
+    assert_int_equal(stats.bands_corrected, 6);
+    assert_true(stats.max_frame_us >= stats.last_frame_us);
+
+    assert_non_null(correction_get_kernel_name());
+
+    correction_destroy(corr);
+}
+
+/* Counts hook calls per band from whichever thread runs them */
+static void count_band_hook(uint16_t *frame, uint32_t row_start,
+                            uint32_t row_count, void *user_data) {
+    uint32_t *rows_seen = (uint32_t *)user_data;
+    (void)frame;
+
+    for (uint32_t r = row_start; r < row_start + row_count; r++) {
+        __atomic_fetch_add(&rows_seen[r], 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @test FW_UT_11_010: Thread pool band split matches serial correction
+ * @pre band_rows = 2 (5 bands), 4-thread pool, random maps and frame
+ * @post Output identical to a serial stage, hook saw every row once,
+ *       band statistics unchanged
+ */
+static void test_correction_thread_pool(void **state) {
+    (void)state;
+
+    tp_config_t pool_config = { .threads = 4 };
+    tp_pool_t *pool = thread_pool_create(&pool_config);
+    assert_non_null(pool);
+
+    correction_t *serial = create_stage(CORR_GAIN_Q2_14, 2);
+    correction_t *parallel = create_stage(CORR_GAIN_Q2_14, 2);
+    correction_set_thread_pool(parallel, pool);
+
+    static uint16_t frame[TEST_PIXELS];
+    static uint16_t expect[TEST_PIXELS];
+    static uint16_t offset[TEST_PIXELS];
+    static uint16_t gain[TEST_PIXELS];
+    uint32_t rows_seen[TEST_HEIGHT] = {0};
+    uint32_t seed = 11;
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = (uint16_t)test_rand(&seed);
+        offset[i] = (uint16_t)(test_rand(&seed) & 0x3FF);
+        gain[i] = (uint16_t)(test_rand(&seed) & 0x7FFF);
+    }
+    memcpy(expect, frame, sizeof(frame));
+
+    correction_set_offset_map(serial, offset, TEST_PIXELS);
+    correction_set_gain_map_raw(serial, gain, TEST_PIXELS);
+    correction_set_offset_map(parallel, offset, TEST_PIXELS);
+    correction_set_gain_map_raw(parallel, gain, TEST_PIXELS);
+    correction_set_band_hook(parallel, count_band_hook, rows_seen);
+
+    assert_int_equal(correction_apply_frame(serial, expect), CORR_OK);
+    assert_int_equal(correction_apply_frame(parallel, frame), CORR_OK);
+    assert_memory_equal(frame, expect, sizeof(frame));
+
+    for (int r = 0; r < TEST_HEIGHT; r++) {
+        assert_int_equal(rows_seen[r], 1);
+    }
+
+    corr_stats_t stats;
+    correction_get_stats(parallel, &stats);
+    assert_int_equal(stats.bands_corrected, 5);
+
+    correction_destroy(parallel);
+    correction_destroy(serial);
+    thread_pool_destroy(pool);
+}
+
+#define TEST_COUNT_TILE       4
+#define TEST_COUNT_TILES_X    ((TEST_WIDTH + TEST_COUNT_TILE - 1) / TEST_COUNT_TILE)
+#define TEST_COUNT_TILES_Y    ((TEST_HEIGHT + TEST_COUNT_TILE - 1) / TEST_COUNT_TILE)
+
+typedef struct {
+    uint32_t tiles[TEST_COUNT_TILES_Y][TEST_COUNT_TILES_X];
+    uint32_t rows_seen[TEST_HEIGHT];
+} count_result_t;
+
+static void count_tile_hook(uint32_t row_start, uint32_t row_count,
+                            const uint32_t *counts, void *user_data) {
+    count_result_t *result = (count_result_t *)user_data;
+    uint32_t ty = row_start / TEST_COUNT_TILE;
+
+    /* Each call stays within one tile row */
+    assert_int_equal((row_start + row_count - 1) / TEST_COUNT_TILE, ty);
+    for (uint32_t r = row_start; r < row_start + row_count; r++) {
+        result->rows_seen[r]++;
+    }
+    for (uint32_t tx = 0; tx < TEST_COUNT_TILES_X; tx++) {
+        result->tiles[ty][tx] += counts[tx];
+    }
+}
+
+/**
+ * @test FW_UT_11_011: Count hook reports per-tile counts of the output
+ * @pre Random frame and Q2.14 maps, 4x4 tiles (clipped), band_rows = 3 so
+ *      bands straddle tile rows; half-float stage for the second kernel
+ * @post Output matches the reference; tile counts equal a count of output
+ *       pixels >= threshold; every row reported once; invalid tile sizes
+ *       rejected
+ */
+static void test_correction_count_hook(void **state) {
+    (void)state;
+
+    const uint16_t threshold = 30000;
+
+    for (int format = 0; format < 2; format++) {
+        bool fp16 = (format == 1);
+        correction_t *corr = create_stage(fp16 ? CORR_GAIN_FP16 : CORR_GAIN_Q2_14, 3);
+        assert_non_null(corr);
+
+        uint16_t frame[TEST_PIXELS];
+        uint16_t expect[TEST_PIXELS];
+        uint16_t offset[TEST_PIXELS];
+        float gain[TEST_PIXELS];
+        uint32_t seed = 23;
+
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = (uint16_t)test_rand(&seed);
+            offset[i] = (uint16_t)(test_rand(&seed) & 0x3FF);
+            gain[i] = 0.5f + (float)(test_rand(&seed) & 0xFFF) / 4096.0f;
+        }
+        memcpy(expect, frame, sizeof(frame));
+
+        correction_set_offset_map(corr, offset, TEST_PIXELS);
+        correction_set_gain_map(corr, gain, TEST_PIXELS);
+
+        /* Plain kernel output is the reference for the counting kernel */
+        assert_int_equal(correction_apply_frame(corr, expect), CORR_OK);
+
+        assert_int_equal(correction_set_count_hook(NULL, threshold, TEST_COUNT_TILE,
+                                                   count_tile_hook, NULL), CORR_ERROR_NULL);
+        assert_int_equal(correction_set_count_hook(corr, threshold, 0, count_tile_hook, NULL),
+                         CORR_ERROR_PARAM);
+        assert_int_equal(correction_set_count_hook(corr, threshold, CORR_COUNT_MAX_TILE + 1,
+                                                   count_tile_hook, NULL), CORR_ERROR_PARAM);
+
+        count_result_t result;
+        memset(&result, 0, sizeof(result));
+        assert_int_equal(correction_set_count_hook(corr, threshold, TEST_COUNT_TILE,
+                                                   count_tile_hook, &result), CORR_OK);
+        assert_int_equal(correction_apply_frame(corr, frame), CORR_OK);
+        assert_memory_equal(frame, expect, sizeof(frame));
+
+        uint32_t ref[TEST_COUNT_TILES_Y][TEST_COUNT_TILES_X];
+        memset(ref, 0, sizeof(ref));
+        for (int y = 0; y < TEST_HEIGHT; y++) {
+            assert_int_equal(result.rows_seen[y], 1);
+            for (int x = 0; x < TEST_WIDTH; x++) {
+                ref[y / TEST_COUNT_TILE][x / TEST_COUNT_TILE] +=
+                    (expect[y * TEST_WIDTH + x] >= threshold);
+            }
+        }
+        assert_memory_equal(result.tiles, ref, sizeof(ref));
+
+        /* Hook removed: bands go back to the plain kernel */
+        assert_int_equal(correction_set_count_hook(corr, 0, 0, NULL, NULL), CORR_OK);
+        memset(&result, 0, sizeof(result));
+        assert_int_equal(correction_apply_rows(corr, frame, 0, 1), CORR_OK);
+        assert_int_equal(result.rows_seen[0], 0);
+
+        correction_destroy(corr);
+    }
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Configuration tests */
+        cmocka_unit_test(test_correction_create_invalid),
+        cmocka_unit_test(test_correction_not_ready),
+
+        /* Arithmetic tests */
+        cmocka_unit_test(test_correction_q14_unity),
+        cmocka_unit_test(test_correction_gain_conversion),
+        cmocka_unit_test(test_correction_saturation),
+        cmocka_unit_test(test_correction_q14_matches_reference),
+        cmocka_unit_test(test_correction_fp16_matches_reference),
+
+        /* Band processing tests */
+        cmocka_unit_test(test_correction_apply_rows),
+        cmocka_unit_test(test_correction_stats),
+        cmocka_unit_test(test_correction_thread_pool),
+        cmocka_unit_test(test_correction_count_hook),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-11: Offset/Gain Correction Tests",
+                                       tests, NULL, NULL);
+}
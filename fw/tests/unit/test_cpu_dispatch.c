@@ -0,0 +1,259 @@
+/**
+ * @file test_cpu_dispatch.c
+ * @brief Unit tests for runtime CPU-feature dispatch (FW-UT-21)
+ *
+ * Test ID: FW-UT-21
+ * Coverage: ISA names and overrides, variant selection, self-test
+ *
+ * Tests:
+ * - Override parsing, unsupported levels refused
+ * - Best variant at or below the active level, unsupported ISAs skipped
+ * - Self-test reports a variant that differs from scalar
+ * - Every compiled-in pixel kernel variant matches scalar
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "util/cpu_dispatch.h"
+#include "proc/correction.h"
+#include "proc/descramble.h"
+#include "proc/orientation.h"
+#include "proc/pixel_drift.h"
+#include "proc/window_level.h"
+#include "proc/frame_stats.h"
+#include "proc/frame_qa.h"
+#include "proc/hdr_fusion.h"
+#include "proc/exposure_gate.h"
+#include "proc/saturation.h"
+#include "proc/temporal_filter.h"
+#include "proc/calibration.h"
+
+/* ==========================================================================
+ * Fake Kernel
+ * ========================================================================== */
+
+typedef int (*fake_fn_t)(int x);
+
+static int fake_scalar(int x) { return x + 1; }
+static int fake_neon(int x) { return x + 1; }
+static int fake_sse42(int x) { return x + 1; }
+static int fake_avx2(int x) { return x + 1; }
+static int fake_broken(int x) { return x + 2; }
+
+static bool fake_check(cpu_fn_t candidate, cpu_fn_t reference, uint32_t seed) {
+    int x = (int)(seed & 0xFFFF);
+    return ((fake_fn_t)candidate)(x) == ((fake_fn_t)reference)(x);
+}
+
+static const cpu_variant_t fake_variants[] = {
+    { CPU_ISA_SCALAR, (cpu_fn_t)fake_scalar },
+    { CPU_ISA_NEON, (cpu_fn_t)fake_neon },
+    { CPU_ISA_SSE42, (cpu_fn_t)fake_sse42 },
+    { CPU_ISA_AVX2, (cpu_fn_t)fake_avx2 },
+};
+
+static const cpu_kernel_t fake_kernel = {
+    .name = "fake",
+    .variants = fake_variants,
+    .variant_count = 4,
+    .check = fake_check
+};
+
+static cpu_isa_t highest_supported(void) {
+    uint32_t mask = cpu_dispatch_supported();
+    for (int isa = CPU_ISA_COUNT - 1; isa > CPU_ISA_SCALAR; isa--) {
+        if (mask & (1U << isa)) {
+            return (cpu_isa_t)isa;
+        }
+    }
+    return CPU_ISA_SCALAR;
+}
+
+/* ==========================================================================
+ * Level Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_21_001: ISA names and overrides
+ * @pre None
+ * @post Unknown names refused, scalar always accepted, "auto" restores the
+ *       highest supported level, levels the CPU lacks are refused
+ */
+static void test_dispatch_levels(void **state) {
+    (void)state;
+
+    assert_string_equal(cpu_dispatch_isa_name(CPU_ISA_SCALAR), "scalar");
+    assert_string_equal(cpu_dispatch_isa_name(CPU_ISA_NEON), "neon");
+    assert_string_equal(cpu_dispatch_isa_name(CPU_ISA_SSE42), "sse4.2");
+    assert_string_equal(cpu_dispatch_isa_name(CPU_ISA_AVX2), "avx2");
+    assert_string_equal(cpu_dispatch_isa_name(CPU_ISA_COUNT), "unknown");
+
+    uint32_t mask = cpu_dispatch_supported();
+    assert_true(mask & (1U << CPU_ISA_SCALAR));
+    /* NEON and x86 variants never coexist */
+    assert_false((mask & (1U << CPU_ISA_NEON)) &&
+                 (mask & ((1U << CPU_ISA_SSE42) | (1U << CPU_ISA_AVX2))));
+
+    assert_int_equal(cpu_dispatch_init("sse5"), -EINVAL);
+
+    assert_int_equal(cpu_dispatch_init("scalar"), 0);
+    assert_int_equal(cpu_dispatch_level(), CPU_ISA_SCALAR);
+
+    for (int isa = CPU_ISA_NEON; isa < CPU_ISA_COUNT; isa++) {
+        int expected = (mask & (1U << isa)) ? 0 : -ENOTSUP;
+        assert_int_equal(cpu_dispatch_init(cpu_dispatch_isa_name((cpu_isa_t)isa)), expected);
+    }
+
+    assert_int_equal(cpu_dispatch_init("auto"), 0);
+    assert_int_equal(cpu_dispatch_level(), highest_supported());
+}
+
+/**
+ * @test FW_UT_21_002: Variant selection
+ * @pre Fake kernel with all four variants
+ * @post Auto picks the highest supported variant; scalar override picks
+ *       scalar; a kernel with only scalar always gets scalar
+ */
+static void test_dispatch_select(void **state) {
+    (void)state;
+
+    static const cpu_fn_t expected_fn[CPU_ISA_COUNT] = {
+        (cpu_fn_t)fake_scalar, (cpu_fn_t)fake_neon,
+        (cpu_fn_t)fake_sse42, (cpu_fn_t)fake_avx2
+    };
+    cpu_isa_t isa;
+
+    assert_int_equal(cpu_dispatch_init(NULL), 0);
+    cpu_fn_t fn = cpu_dispatch_select(&fake_kernel, &isa);
+    assert_int_equal(isa, highest_supported());
+    assert_ptr_equal(fn, expected_fn[isa]);
+
+    assert_int_equal(cpu_dispatch_init("scalar"), 0);
+    assert_ptr_equal(cpu_dispatch_select(&fake_kernel, &isa), (cpu_fn_t)fake_scalar);
+    assert_int_equal(isa, CPU_ISA_SCALAR);
+    assert_string_equal(correction_get_kernel_name(), "scalar");
+
+    assert_int_equal(cpu_dispatch_init(NULL), 0);
+    const cpu_kernel_t scalar_only = {
+        .name = "scalar_only", .variants = fake_variants, .variant_count = 1,
+        .check = fake_check
+    };
+    assert_ptr_equal(cpu_dispatch_select(&scalar_only, &isa), (cpu_fn_t)fake_scalar);
+    assert_int_equal(isa, CPU_ISA_SCALAR);
+}
+
+/* ==========================================================================
+ * Self-Test Tests
+ * ========================================================================== */
+
+typedef struct {
+    uint32_t tested;
+    uint32_t failed;
+} report_count_t;
+
+static void count_report(const cpu_kernel_t *kernel, cpu_isa_t isa, bool passed,
+                         void *user_data) {
+    report_count_t *count = (report_count_t *)user_data;
+    (void)kernel;
+    (void)isa;
+
+    count->tested++;
+    count->failed += passed ? 0 : 1;
+}
+
+/**
+ * @test FW_UT_21_003: Self-test catches a wrong variant
+ * @pre Fake kernel whose best supported variant differs from scalar
+ * @post One failure reported when the CPU has a SIMD level; a scalar
+ *       override does not stop the faster variants being tested
+ */
+static void test_dispatch_selftest_broken(void **state) {
+    (void)state;
+
+    cpu_isa_t best = highest_supported();
+    if (best == CPU_ISA_SCALAR) {
+        skip();
+    }
+
+    const cpu_variant_t variants[] = {
+        { CPU_ISA_SCALAR, (cpu_fn_t)fake_scalar },
+        { best, (cpu_fn_t)fake_broken },
+    };
+    const cpu_kernel_t broken = {
+        .name = "broken", .variants = variants, .variant_count = 2, .check = fake_check
+    };
+    const cpu_kernel_t *const kernels[] = { &fake_kernel, &broken };
+
+    assert_int_equal(cpu_dispatch_init("scalar"), 0);
+
+    report_count_t count = { 0, 0 };
+    assert_int_equal(cpu_dispatch_selftest(kernels, 2, 4, count_report, &count), 1);
+    assert_int_equal(count.failed, 1);
+    assert_true(count.tested >= 2);
+
+    assert_int_equal(cpu_dispatch_init(NULL), 0);
+}
+
+/**
+ * @test FW_UT_21_004: Pixel kernels match scalar
+ * @pre Correction, descramble, orientation, statistics, QA, HDR fusion,
+ *      exposure gate, saturation, temporal, window/level, drift and
+ *      calibration kernels
+ * @post Every supported variant is bit-identical to scalar on 32 data sets
+ */
+static void test_dispatch_selftest_kernels(void **state) {
+    (void)state;
+
+    const cpu_kernel_t *const kernels[] = {
+        &correction_kernel_q14,
+        &correction_kernel_fp16,
+        &correction_kernel_q14_count,
+        &correction_kernel_fp16_count,
+        &descramble_kernel_reverse,
+        &frame_stats_kernel_span,
+        &frame_qa_kernel_span,
+        &hdr_fusion_kernel_fuse,
+        &exposure_gate_kernel_row,
+        &orientation_kernel_tile,
+        &saturation_kernel_count,
+        &temporal_filter_kernel_row,
+        &window_level_kernel_linear,
+        &pixel_drift_kernel_update,
+        &calib_kernel_accumulate,
+    };
+    size_t n = sizeof(kernels) / sizeof(kernels[0]);
+
+    report_count_t count = { 0, 0 };
+    assert_int_equal(cpu_dispatch_selftest(kernels, n, 32, count_report, &count), 0);
+    assert_int_equal(count.failed, 0);
+    if (highest_supported() != CPU_ISA_SCALAR) {
+        assert_true(count.tested > 0);
+    }
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Level tests */
+        cmocka_unit_test(test_dispatch_levels),
+        cmocka_unit_test(test_dispatch_select),
+
+        /* Self-test tests */
+        cmocka_unit_test(test_dispatch_selftest_broken),
+        cmocka_unit_test(test_dispatch_selftest_kernels),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-21: CPU Dispatch Tests",
+                                       tests, NULL, NULL);
+}
@@ -7,6 +7,7 @@
  */
 
 #include "util/crc16.h"
+#include <string.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
@@ -130,6 +131,44 @@ static void test_crc16_all_ones(void **state) {
     assert_int_equal(crc, 0x1685);
 }
 
+static void test_crc16_shift_identity(void **state) {
+    (void)state;
+    crc16_shift_t shift;
+
+    /* An empty zero run leaves the register unchanged */
+    crc16_shift_init(&shift, 0);
+    assert_int_equal(crc16_shift_apply(&shift, 0x0000), 0x0000);
+    assert_int_equal(crc16_shift_apply(&shift, 0x1234), 0x1234);
+    assert_int_equal(crc16_shift_apply(&shift, 0xFFFF), 0xFFFF);
+}
+
+static void test_crc16_shift_patch(void **state) {
+    (void)state;
+    /* 36-byte frame header with a 4-byte field at offset 20 patched */
+    uint8_t base[36];
+    uint8_t patched[36];
+    crc16_shift_t shift;
+
+    for (int i = 0; i < 36; i++) {
+        base[i] = (uint8_t)(i * 37 + 11);
+    }
+    memset(base + 20, 0, 4);
+    uint16_t base_crc = crc16_compute(base, sizeof(base));
+
+    crc16_shift_init(&shift, sizeof(base) - 24);
+    for (uint32_t index = 0; index < 5000; index += 7) {
+        uint8_t field[4] = {
+            (uint8_t)index, (uint8_t)(index >> 8), (uint8_t)(index >> 16), (uint8_t)(index >> 24)
+        };
+        memcpy(patched, base, sizeof(base));
+        memcpy(patched + 20, field, sizeof(field));
+
+        uint16_t crc = (uint16_t)(base_crc ^
+            crc16_shift_apply(&shift, crc16_compute_with_init(field, sizeof(field), 0)));
+        assert_int_equal(crc, crc16_compute(patched, sizeof(patched)));
+    }
+}
+
 /* Test runner */
 int main(void) {
     const struct CMUnitTest tests[] = {
@@ -144,6 +183,8 @@ int main(void) {
         cmocka_unit_test(test_crc16_verify_invalid),
         cmocka_unit_test(test_crc16_large_buffer),
         cmocka_unit_test(test_crc16_all_ones),
+        cmocka_unit_test(test_crc16_shift_identity),
+        cmocka_unit_test(test_crc16_shift_patch),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -20,6 +20,10 @@
  * Copyright (c) 2026 ABYZ Lab
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
@@ -29,12 +33,7 @@
 #include <string.h>
 #include <errno.h>
 
-/* Mock V4L2 functions */
-#define open mock_v4l2_open
-#define close mock_v4l2_close
-#define ioctl mock_v4l2_ioctl
-#define mmap mock_v4l2_mmap
-#define munmap mock_v4l2_munmap
+/* V4L2 calls in csi2_rx.c reach mock_v4l2 through -Wl,--wrap (CMakeLists.txt) */
 
 #include "hal/csi2_rx.h"
 #include "mock_v4l2.h"
@@ -608,6 +607,158 @@ static void test_csi2_rx_get_error_message(void **state) {
     mock->fail_open = false;
 }
 
+/* ==========================================================================
+ * Frame-Sync Event Tests
+ * ========================================================================== */
+
+static uint32_t g_sof_calls = 0;
+static uint32_t g_sof_sequence = 0;
+
+static void sof_callback(const csi2_event_t *event, void *user_data) {
+    (void)user_data;
+    g_sof_calls++;
+    g_sof_sequence = event->sequence;
+}
+
+/**
+ * @test FW_UT_02_019: Subscribe to frame-sync events on create
+ * @pre Driver supports V4L2_EVENT_FRAME_SYNC
+ * @post FRAME_SYNC reported as subscribed
+ */
+static void test_csi2_rx_subscribe_frame_sync(void **state) {
+    mock_v4l2_t *mock = (mock_v4l2_t *)*state;
+
+    csi2_config_t config = {
+        .device = "/dev/video0",
+        .width = 2048,
+        .height = 2048,
+        .format = CSI2_PIX_FMT_RAW16,
+        .buffer_count = 4,
+        .enable_events = true
+    };
+
+    csi2_rx_t *csi2 = csi2_rx_create(&config);
+    assert_non_null(csi2);
+
+    assert_true(csi2_rx_get_subscribed_events(csi2) & CSI2_EVENT_FRAME_SYNC);
+    assert_true(mock->subscribed_events & (1U << V4L2_EVENT_FRAME_SYNC));
+
+    assert_int_equal(csi2_rx_unsubscribe_events(csi2), CSI2_OK);
+    assert_int_equal(csi2_rx_get_subscribed_events(csi2), 0);
+
+    csi2_rx_destroy(csi2);
+}
+
+/**
+ * @test FW_UT_02_020: Driver without frame-sync support
+ * @pre Driver rejects V4L2_EVENT_FRAME_SYNC
+ * @post Subscription fails, create still succeeds
+ */
+static void test_csi2_rx_frame_sync_unsupported(void **state) {
+    mock_v4l2_t *mock = (mock_v4l2_t *)*state;
+    mock->unsupported_events = (1U << V4L2_EVENT_FRAME_SYNC);
+
+    csi2_config_t config = {
+        .device = "/dev/video0",
+        .width = 2048,
+        .height = 2048,
+        .format = CSI2_PIX_FMT_RAW16,
+        .buffer_count = 4
+    };
+
+    csi2_rx_t *csi2 = csi2_rx_create(&config);
+    assert_non_null(csi2);
+
+    csi2_status_t status = csi2_rx_subscribe_events(csi2, CSI2_EVENT_FRAME_SYNC);
+    assert_int_equal(status, CSI2_ERROR_IOCTL);
+    assert_int_equal(csi2_rx_get_subscribed_events(csi2), 0);
+
+    csi2_rx_destroy(csi2);
+}
+
+/**
+ * @test FW_UT_02_021: Start-of-frame event invokes callback
+ * @pre FRAME_SYNC subscribed, event queued
+ * @post Callback called with frame sequence, no event when queue empty
+ */
+static void test_csi2_rx_sof_callback(void **state) {
+    mock_v4l2_t *mock = (mock_v4l2_t *)*state;
+
+    csi2_config_t config = {
+        .device = "/dev/video0",
+        .width = 2048,
+        .height = 2048,
+        .format = CSI2_PIX_FMT_RAW16,
+        .buffer_count = 4,
+        .enable_events = true
+    };
+
+    csi2_rx_t *csi2 = csi2_rx_create(&config);
+    assert_non_null(csi2);
+
+    g_sof_calls = 0;
+    csi2_rx_set_sof_callback(csi2, sof_callback, NULL);
+
+    mock_v4l2_queue_frame_sync(mock, 7);
+
+    csi2_event_t event;
+    csi2_status_t status = csi2_rx_wait_event(csi2, &event, -1);
+    assert_int_equal(status, CSI2_OK);
+    assert_int_equal(event.type, CSI2_EVENT_FRAME_SYNC);
+    assert_int_equal(event.sequence, 7);
+    assert_true(event.timestamp > 0);
+    assert_int_equal(g_sof_calls, 1);
+    assert_int_equal(g_sof_sequence, 7);
+
+    /* Queue drained */
+    status = csi2_rx_wait_event(csi2, &event, -1);
+    assert_int_equal(status, CSI2_ERROR_TIMEOUT);
+    assert_int_equal(g_sof_calls, 1);
+
+    csi2_rx_destroy(csi2);
+}
+
+/**
+ * @test FW_UT_02_022: Captured frame carries start-of-frame timestamp
+ * @pre FRAME_SYNC for sequence 0 dequeued before DQBUF
+ * @post frame.sof_timestamp equals event timestamp and precedes DQBUF
+ */
+static void test_csi2_rx_capture_sof_timestamp(void **state) {
+    mock_v4l2_t *mock = (mock_v4l2_t *)*state;
+
+    csi2_config_t config = {
+        .device = "/dev/video0",
+        .width = 2048,
+        .height = 2048,
+        .format = CSI2_PIX_FMT_RAW16,
+        .buffer_count = 4,
+        .enable_events = true
+    };
+
+    csi2_rx_t *csi2 = csi2_rx_create(&config);
+    assert_non_null(csi2);
+    csi2_rx_start(csi2);
+
+    mock_v4l2_queue_frame_sync(mock, 0);
+    csi2_event_t event;
+    assert_int_equal(csi2_rx_wait_event(csi2, &event, -1), CSI2_OK);
+
+    mock_v4l2_set_frame_ready(mock, 0, 2048 * 2048 * 2);
+    csi2_frame_buffer_t frame;
+    assert_int_equal(csi2_rx_capture(csi2, &frame, 1000), CSI2_OK);
+    assert_int_equal(frame.sequence, 0);
+    assert_true(frame.sof_timestamp == event.timestamp);
+
+    /* Next frame had no frame-sync: falls back to 0 */
+    mock_v4l2_set_frame_ready(mock, 1, 2048 * 2048 * 2);
+    assert_int_equal(csi2_rx_capture(csi2, &frame, 1000), CSI2_OK);
+    assert_int_equal(frame.sequence, 1);
+    assert_true(frame.sof_timestamp == 0);
+
+    csi2_rx_stop(csi2);
+    csi2_rx_destroy(csi2);
+}
+
 /* ==========================================================================
  * Test Runner
  * ========================================================================== */
@@ -618,7 +769,7 @@ int main(void) {
         cmocka_unit_test(test_csi2_rx_create_valid_config),
         cmocka_unit_test(test_csi2_rx_create_null_config),
         cmocka_unit_test(test_csi2_rx_create_null_device),
-        cmocka_unit_test_setup(test_csi2_rx_create_unsupported_format, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_create_unsupported_format, setup_v4l2_mock, teardown_v4l2_mock),
 
         /* Streaming tests */
         cmocka_unit_test(test_csi2_rx_start_streaming),
@@ -627,24 +778,30 @@ int main(void) {
         cmocka_unit_test(test_csi2_rx_stop_twice),
 
         /* Frame capture tests */
-        cmocka_unit_test_setup(test_csi2_rx_capture_frame, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_capture_frame, setup_v4l2_mock, teardown_v4l2_mock),
         cmocka_unit_test(test_csi2_rx_capture_timeout),
-        cmocka_unit_test_setup(test_csi2_rx_capture_multiple_frames, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_capture_multiple_frames, setup_v4l2_mock, teardown_v4l2_mock),
 
         /* Buffer management tests */
-        cmocka_unit_test_setup(test_csi2_rx_release_frame, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_release_frame, setup_v4l2_mock, teardown_v4l2_mock),
 
         /* Pipeline restart tests */
         cmocka_unit_test(test_csi2_rx_restart_pipeline),
         cmocka_unit_test(test_csi2_rx_restart_preserves_config),
 
         /* Statistics tests */
-        cmocka_unit_test_setup(test_csi2_rx_get_stats, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_get_stats, setup_v4l2_mock, teardown_v4l2_mock),
 
         /* Error handling tests */
         cmocka_unit_test(test_csi2_rx_capture_null_frame),
         cmocka_unit_test(test_csi2_rx_release_null_frame),
-        cmocka_unit_test_setup(test_csi2_rx_get_error_message, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_get_error_message, setup_v4l2_mock, teardown_v4l2_mock),
+
+        /* Frame-sync event tests */
+        cmocka_unit_test_setup_teardown(test_csi2_rx_subscribe_frame_sync, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_frame_sync_unsupported, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_sof_callback, setup_v4l2_mock, teardown_v4l2_mock),
+        cmocka_unit_test_setup_teardown(test_csi2_rx_capture_sof_timestamp, setup_v4l2_mock, teardown_v4l2_mock),
     };
 
     return cmocka_run_group_tests_name("FW-UT-02: CSI-2 RX HAL Tests",
@@ -0,0 +1,330 @@
+/**
+ * @file test_defect_map.c
+ * @brief Unit tests for defect pixel correction (FW-UT-13)
+ *
+ * Test ID: FW-UT-13
+ * Coverage: Sparse row-indexed defect map
+ *
+ * Tests:
+ * - Record validation
+ * - Pixel, row, column and cluster interpolation
+ * - Band-by-band apply matches whole-frame apply
+ * - Commit replaces the active index
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/defect_map.h"
+
+#define TEST_WIDTH   16
+#define TEST_HEIGHT  12
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+#define PX(f, x, y)  ((f)[(y) * TEST_WIDTH + (x)])
+
+static const defect_config_t test_config = {
+    .width = TEST_WIDTH,
+    .height = TEST_HEIGHT,
+    .max_records = 8
+};
+
+/* Frame where each pixel encodes its position: 1000 + 10*y + x */
+static void fill_gradient(uint16_t *frame) {
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            PX(frame, x, y) = (uint16_t)(1000 + 10 * y + x);
+        }
+    }
+}
+
+static defect_map_t *create_with(const defect_record_t *records, size_t count) {
+    defect_map_t *dm = defect_map_create(&test_config);
+    assert_non_null(dm);
+
+    for (size_t i = 0; i < count; i++) {
+        assert_int_equal(defect_map_add(dm, &records[i]), DEFECT_OK);
+    }
+    assert_int_equal(defect_map_commit(dm), DEFECT_OK);
+
+    return dm;
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_13_001: Reject invalid configuration and records
+ * @pre Zero geometry, records outside frame, bad type, full staging
+ * @post Errors returned, active map stays empty
+ */
+static void test_defect_invalid(void **state) {
+    (void)state;
+
+    assert_null(defect_map_create(NULL));
+    defect_config_t bad = { .width = 0, .height = 4 };
+    assert_null(defect_map_create(&bad));
+
+    defect_map_t *dm = defect_map_create(&test_config);
+    assert_non_null(dm);
+
+    defect_record_t r = { DEFECT_TYPE_PIXEL, 0, TEST_WIDTH, 0, 0, 0 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_PARAM);
+
+    r = (defect_record_t){ DEFECT_TYPE_ROW, 0, 0, TEST_HEIGHT, 0, 0 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_PARAM);
+
+    r = (defect_record_t){ DEFECT_TYPE_CLUSTER, 0, 14, 0, 3, 1 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_PARAM);
+
+    r = (defect_record_t){ DEFECT_TYPE_CLUSTER, 0, 0, 0, 0, 1 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_PARAM);
+
+    r = (defect_record_t){ DEFECT_TYPE_MAX, 0, 0, 0, 0, 0 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_PARAM);
+
+    r = (defect_record_t){ DEFECT_TYPE_PIXEL, 0, 1, 1, 0, 0 };
+    for (uint32_t i = 0; i < test_config.max_records; i++) {
+        assert_int_equal(defect_map_add(dm, &r), DEFECT_OK);
+    }
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_ERROR_FULL);
+
+    assert_int_equal(defect_map_count(dm), 0);
+
+    uint16_t frame[TEST_PIXELS];
+    assert_int_equal(defect_map_apply_rows(dm, frame, TEST_HEIGHT, 1), DEFECT_ERROR_PARAM);
+    assert_int_equal(defect_map_apply_rows(dm, frame, 4, TEST_HEIGHT), DEFECT_ERROR_PARAM);
+
+    defect_map_destroy(dm);
+}
+
+/* ==========================================================================
+ * Interpolation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_13_002: Single pixel replaced by 4-neighbour average
+ * @pre Defect at (5, 5), neighbours 10/20/30/40
+ * @post Pixel = 25, everything else untouched
+ */
+static void test_defect_pixel(void **state) {
+    (void)state;
+
+    defect_record_t r = { DEFECT_TYPE_PIXEL, 0, 5, 5, 0, 0 };
+    defect_map_t *dm = create_with(&r, 1);
+    assert_int_equal(defect_map_count(dm), 1);
+
+    uint16_t frame[TEST_PIXELS];
+    uint16_t expected[TEST_PIXELS];
+    memset(frame, 0, sizeof(frame));
+    PX(frame, 4, 5) = 10;
+    PX(frame, 6, 5) = 20;
+    PX(frame, 5, 4) = 30;
+    PX(frame, 5, 6) = 40;
+    PX(frame, 5, 5) = 0xFFFF;
+    memcpy(expected, frame, sizeof(frame));
+    PX(expected, 5, 5) = 25;
+
+    assert_int_equal(defect_map_apply_frame(dm, frame), DEFECT_OK);
+    assert_memory_equal(frame, expected, sizeof(frame));
+
+    defect_map_destroy(dm);
+}
+
+/**
+ * @test FW_UT_13_003: Row and column lines use perpendicular neighbours
+ * @pre Row 3 and column 7 defective on a gradient frame
+ * @post Row pixels = mean of rows 2/4, column pixels = mean of columns 6/8
+ */
+static void test_defect_lines(void **state) {
+    (void)state;
+
+    defect_record_t r[] = {
+        { DEFECT_TYPE_ROW, 0, 0, 3, 0, 0 },
+        { DEFECT_TYPE_COLUMN, 0, 7, 0, 0, 0 },
+    };
+    defect_map_t *dm = create_with(r, 2);
+    assert_int_equal(defect_map_count(dm), TEST_WIDTH + TEST_HEIGHT - 1);
+
+    uint16_t frame[TEST_PIXELS];
+    fill_gradient(frame);
+    PX(frame, 2, 3) = 0;
+    PX(frame, 7, 9) = 0xFFFF;
+
+    assert_int_equal(defect_map_apply_frame(dm, frame), DEFECT_OK);
+
+    /* Gradient is linear, so the perpendicular average restores it */
+    for (int x = 0; x < TEST_WIDTH; x++) {
+        if (x != 7) {
+            assert_int_equal(PX(frame, x, 3), 1000 + 30 + x);
+        }
+    }
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        assert_int_equal(PX(frame, 7, y), 1000 + 10 * y + 7);
+    }
+
+    defect_map_destroy(dm);
+}
+
+/**
+ * @test FW_UT_13_004: Cluster pixels use nearest good pixels outside
+ * @pre 3x3 cluster at (4, 4) on a gradient frame
+ * @post Centre restored from (3,5), (7,5), (5,3), (5,7); corner (4,4)
+ *       averages (3,4), (7,4), (4,3), (4,7)
+ */
+static void test_defect_cluster(void **state) {
+    (void)state;
+
+    defect_record_t r = { DEFECT_TYPE_CLUSTER, 0, 4, 4, 3, 3 };
+    defect_map_t *dm = create_with(&r, 1);
+    assert_int_equal(defect_map_count(dm), 9);
+
+    uint16_t frame[TEST_PIXELS];
+    fill_gradient(frame);
+    for (int y = 4; y < 7; y++) {
+        for (int x = 4; x < 7; x++) {
+            PX(frame, x, y) = 0;
+        }
+    }
+
+    assert_int_equal(defect_map_apply_frame(dm, frame), DEFECT_OK);
+
+    assert_int_equal(PX(frame, 5, 5), 1055);
+    assert_int_equal(PX(frame, 4, 4), (1043 + 1047 + 1034 + 1074 + 2) / 4);
+
+    defect_map_destroy(dm);
+}
+
+/**
+ * @test FW_UT_13_005: Frame corner defect uses available neighbours only
+ * @pre Defect at (0, 0)
+ * @post Pixel = mean of (1, 0) and (0, 1)
+ */
+static void test_defect_edge(void **state) {
+    (void)state;
+
+    defect_record_t r = { DEFECT_TYPE_PIXEL, 0, 0, 0, 0, 0 };
+    defect_map_t *dm = create_with(&r, 1);
+
+    uint16_t frame[TEST_PIXELS];
+    fill_gradient(frame);
+    PX(frame, 0, 0) = 0xFFFF;
+
+    assert_int_equal(defect_map_apply_frame(dm, frame), DEFECT_OK);
+    assert_int_equal(PX(frame, 0, 0), (1001 + 1010 + 1) / 2);
+
+    defect_map_destroy(dm);
+}
+
+/* ==========================================================================
+ * Band / Lifecycle Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_13_006: Band-wise apply equals whole-frame apply
+ * @pre Defects straddling band edges, bands of 1, 3 and 5 rows
+ * @post Output identical to single apply_frame call
+ */
+static void test_defect_bands(void **state) {
+    (void)state;
+
+    defect_record_t r[] = {
+        { DEFECT_TYPE_PIXEL, 0, 3, 2, 0, 0 },
+        { DEFECT_TYPE_PIXEL, 0, 9, 5, 0, 0 },
+        { DEFECT_TYPE_ROW, 0, 0, 6, 0, 0 },
+        { DEFECT_TYPE_CLUSTER, 0, 10, 8, 2, 3 },
+        { DEFECT_TYPE_PIXEL, 0, 15, 11, 0, 0 },
+    };
+    defect_map_t *dm = create_with(r, sizeof(r) / sizeof(r[0]));
+
+    uint16_t reference[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        reference[i] = (uint16_t)((i * 2654435761u) >> 20);
+    }
+    uint16_t input[TEST_PIXELS];
+    memcpy(input, reference, sizeof(input));
+    defect_map_apply_frame(dm, reference);
+
+    const uint32_t bands[] = { 1, 3, 5 };
+    for (size_t b = 0; b < sizeof(bands) / sizeof(bands[0]); b++) {
+        uint16_t frame[TEST_PIXELS];
+        memcpy(frame, input, sizeof(frame));
+
+        for (uint32_t row = 0; row < TEST_HEIGHT; row += bands[b]) {
+            uint32_t rows = (TEST_HEIGHT - row < bands[b]) ? TEST_HEIGHT - row : bands[b];
+            assert_int_equal(defect_map_apply_rows(dm, frame, row, rows), DEFECT_OK);
+        }
+
+        assert_memory_equal(frame, reference, sizeof(frame));
+    }
+
+    defect_map_destroy(dm);
+}
+
+/**
+ * @test FW_UT_13_007: Commit replaces the active index
+ * @pre Map with one pixel, then clear + different pixel + commit
+ * @post Old defect untouched, new defect corrected; empty commit disables
+ */
+static void test_defect_recommit(void **state) {
+    (void)state;
+
+    defect_record_t r = { DEFECT_TYPE_PIXEL, 0, 2, 2, 0, 0 };
+    defect_map_t *dm = create_with(&r, 1);
+
+    /* Staged changes do not affect the active map until commit */
+    defect_map_clear(dm);
+    r = (defect_record_t){ DEFECT_TYPE_PIXEL, 0, 8, 8, 0, 0 };
+    assert_int_equal(defect_map_add(dm, &r), DEFECT_OK);
+    assert_int_equal(defect_map_count(dm), 1);
+
+    assert_int_equal(defect_map_commit(dm), DEFECT_OK);
+
+    uint16_t frame[TEST_PIXELS];
+    fill_gradient(frame);
+    PX(frame, 2, 2) = 0;
+    PX(frame, 8, 8) = 0;
+
+    defect_map_apply_frame(dm, frame);
+    assert_int_equal(PX(frame, 2, 2), 0);
+    assert_int_equal(PX(frame, 8, 8), 1088);
+
+    defect_map_clear(dm);
+    assert_int_equal(defect_map_commit(dm), DEFECT_OK);
+    assert_int_equal(defect_map_count(dm), 0);
+
+    defect_map_destroy(dm);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_defect_invalid),
+
+        /* Interpolation tests */
+        cmocka_unit_test(test_defect_pixel),
+        cmocka_unit_test(test_defect_lines),
+        cmocka_unit_test(test_defect_cluster),
+        cmocka_unit_test(test_defect_edge),
+
+        /* Band / lifecycle tests */
+        cmocka_unit_test(test_defect_bands),
+        cmocka_unit_test(test_defect_recommit),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-13: Defect Map Tests",
+                                       tests, NULL, NULL);
+}
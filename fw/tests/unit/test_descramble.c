@@ -0,0 +1,313 @@
+/**
+ * @file test_descramble.c
+ * @brief Unit tests for panel readout descrambling (FW-UT-22)
+ *
+ * Test ID: FW-UT-22
+ * Coverage: Plan compilation, block order and mirroring, dual-side lines
+ *
+ * Tests:
+ * - Identity map is a single move and a plain copy
+ * - Block order and mirrored blocks match a per-pixel reference
+ * - Dual-side readout (flipped, mirrored bottom) matches the reference
+ * - Line ranges in any split give the same frame
+ * - Inconsistent maps rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/descramble.h"
+
+#define TEST_WIDTH      96
+#define TEST_HEIGHT     10
+#define TEST_PIXELS     (TEST_WIDTH * TEST_HEIGHT)
+
+static uint16_t g_raw[TEST_PIXELS];
+static uint16_t g_out[TEST_PIXELS];
+static uint16_t g_expected[TEST_PIXELS];
+
+/* ==========================================================================
+ * Reference Model
+ * ========================================================================== */
+
+static void fill_raw(uint32_t seed) {
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_raw[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+}
+
+/**
+ * @brief Place each raw pixel individually, straight from the map definition
+ */
+static void reference_descramble(const desc_config_t *c) {
+    uint32_t block_cols = (c->block_cols != 0) ? c->block_cols : c->width;
+
+    for (uint32_t r = 0; r < c->height; r++) {
+        bool bottom = c->dual_side && (r & 1);
+        uint32_t row = r;
+        if (c->dual_side) {
+            row = !bottom ? r / 2 :
+                  c->bottom_flipped ? c->height - 1 - r / 2 : c->height / 2 + r / 2;
+        }
+
+        for (uint32_t x = 0; x < c->width; x++) {
+            uint32_t b = x / block_cols;
+            uint32_t off = x % block_cols;
+            uint32_t image_block = (c->block_count != 0) ? c->block_order[b] : b;
+            uint32_t col = image_block * block_cols +
+                           ((c->mirrored_blocks & (1U << b)) ? block_cols - 1 - off : off);
+            if (bottom && c->bottom_mirrored) {
+                col = c->width - 1 - col;
+            }
+            g_expected[row * c->width + col] = g_raw[r * c->width + x];
+        }
+    }
+}
+
+static desc_config_t base_config(void) {
+    desc_config_t c;
+    memset(&c, 0, sizeof(c));
+    c.width = TEST_WIDTH;
+    c.height = TEST_HEIGHT;
+    return c;
+}
+
+static void check_against_reference(const desc_config_t *c, uint32_t seed) {
+    descramble_t *d = descramble_create(c);
+    assert_non_null(d);
+
+    fill_raw(seed);
+    reference_descramble(c);
+    memset(g_out, 0, sizeof(g_out));
+
+    assert_int_equal(descramble_apply_frame(d, g_out, g_raw), DESC_OK);
+    assert_memory_equal(g_out, g_expected, sizeof(g_out));
+
+    descramble_destroy(d);
+}
+
+/* ==========================================================================
+ * Plan Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_22_001: Identity map
+ * @pre No block layout, single-side readout
+ * @post One move per line, flagged identity, output equals input
+ */
+static void test_descramble_identity(void **state) {
+    (void)state;
+
+    desc_config_t c = base_config();
+    descramble_t *d = descramble_create(&c);
+    assert_non_null(d);
+    assert_true(descramble_is_identity(d));
+    assert_int_equal(descramble_op_count(d, false), 1);
+
+    fill_raw(1);
+    assert_int_equal(descramble_apply_frame(d, g_out, g_raw), DESC_OK);
+    assert_memory_equal(g_out, g_raw, sizeof(g_out));
+    descramble_destroy(d);
+
+    /* Blocks listed in order merge back into one move */
+    c.block_cols = 16;
+    c.block_count = 6;
+    for (uint8_t b = 0; b < 6; b++) {
+        c.block_order[b] = b;
+    }
+    d = descramble_create(&c);
+    assert_non_null(d);
+    assert_true(descramble_is_identity(d));
+    assert_int_equal(descramble_op_count(d, false), 1);
+    descramble_destroy(d);
+}
+
+/**
+ * @test FW_UT_22_002: Block order and mirrored blocks
+ * @pre 6 ROIC blocks of 16 columns in several layouts
+ * @post Output matches the per-pixel reference; a fully mirrored line
+ *       compiles to a single reversed move
+ */
+static void test_descramble_blocks(void **state) {
+    (void)state;
+
+    desc_config_t c = base_config();
+    c.block_cols = 16;
+    c.block_count = 6;
+    static const uint8_t order[6] = { 1, 0, 3, 2, 5, 4 };
+    memcpy(c.block_order, order, sizeof(order));
+    check_against_reference(&c, 2);
+
+    c.mirrored_blocks = 0x15;
+    check_against_reference(&c, 3);
+
+    /* Blocks in reverse order, each read right to left: whole line mirrored */
+    for (uint8_t b = 0; b < 6; b++) {
+        c.block_order[b] = (uint8_t)(5 - b);
+    }
+    c.mirrored_blocks = 0x3F;
+    check_against_reference(&c, 4);
+
+    descramble_t *d = descramble_create(&c);
+    assert_non_null(d);
+    assert_false(descramble_is_identity(d));
+    assert_int_equal(descramble_op_count(d, false), 1);
+    descramble_destroy(d);
+
+    /* Odd block width exercises the kernel tail */
+    c = base_config();
+    c.block_cols = 24;
+    c.mirrored_blocks = 0x5;
+    check_against_reference(&c, 5);
+}
+
+/**
+ * @test FW_UT_22_003: Dual-side readout
+ * @pre Raw lines alternate top and bottom halves
+ * @post Output matches the reference with and without bottom_flipped and
+ *       bottom_mirrored; image rows follow the line layout
+ */
+static void test_descramble_dual_side(void **state) {
+    (void)state;
+
+    desc_config_t c = base_config();
+    c.dual_side = true;
+    check_against_reference(&c, 6);
+
+    descramble_t *d = descramble_create(&c);
+    assert_non_null(d);
+    assert_false(descramble_is_identity(d));
+    assert_int_equal(descramble_image_row(d, 0), 0);
+    assert_int_equal(descramble_image_row(d, 1), TEST_HEIGHT / 2);
+    assert_int_equal(descramble_image_row(d, 2), 1);
+    assert_int_equal(descramble_image_row(d, TEST_HEIGHT), UINT32_MAX);
+    descramble_destroy(d);
+
+    c.bottom_flipped = true;
+    check_against_reference(&c, 7);
+
+    c.bottom_mirrored = true;
+    c.block_cols = 32;
+    c.block_count = 3;
+    c.block_order[0] = 2;
+    c.block_order[1] = 0;
+    c.block_order[2] = 1;
+    c.mirrored_blocks = 0x2;
+    check_against_reference(&c, 8);
+
+    d = descramble_create(&c);
+    assert_non_null(d);
+    assert_int_equal(descramble_image_row(d, 1), TEST_HEIGHT - 1);
+    assert_int_equal(descramble_op_count(d, false), 3);
+    assert_int_equal(descramble_op_count(d, true), 3);
+    descramble_destroy(d);
+}
+
+/**
+ * @test FW_UT_22_004: Line ranges
+ * @pre Dual-side map with mirrored blocks
+ * @post Descrambling in ranges of 1, 3 and 7 lines gives the whole-frame
+ *       result; ranges past the frame are refused
+ */
+static void test_descramble_rows(void **state) {
+    (void)state;
+
+    desc_config_t c = base_config();
+    c.block_cols = 32;
+    c.mirrored_blocks = 0x4;
+    c.dual_side = true;
+    c.bottom_flipped = true;
+    descramble_t *d = descramble_create(&c);
+    assert_non_null(d);
+
+    fill_raw(9);
+    reference_descramble(&c);
+
+    static const uint32_t steps[] = { 1, 3, 7 };
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        memset(g_out, 0, sizeof(g_out));
+        for (uint32_t r = 0; r < TEST_HEIGHT; r += steps[s]) {
+            uint32_t n = (r + steps[s] <= TEST_HEIGHT) ? steps[s] : TEST_HEIGHT - r;
+            assert_int_equal(descramble_apply_rows(d, g_out, g_raw, r, n), DESC_OK);
+        }
+        assert_memory_equal(g_out, g_expected, sizeof(g_out));
+    }
+
+    assert_int_equal(descramble_apply_rows(d, g_out, g_raw, TEST_HEIGHT - 1, 2),
+                     DESC_ERROR_PARAM);
+    assert_int_equal(descramble_apply_rows(d, NULL, g_raw, 0, 1), DESC_ERROR_NULL);
+    assert_int_equal(descramble_apply_frame(NULL, g_out, g_raw), DESC_ERROR_NULL);
+
+    descramble_destroy(d);
+}
+
+/**
+ * @test FW_UT_22_005: Inconsistent maps
+ * @pre Maps that cannot describe the frame
+ * @post descramble_create() returns NULL for each
+ */
+static void test_descramble_invalid(void **state) {
+    (void)state;
+
+    assert_null(descramble_create(NULL));
+
+    desc_config_t c = base_config();
+    c.block_cols = 20;                      /* Does not divide 96 */
+    assert_null(descramble_create(&c));
+
+    c = base_config();
+    c.block_cols = 16;
+    c.block_count = 5;                      /* 6 blocks per line */
+    assert_null(descramble_create(&c));
+
+    c.block_count = 6;
+    static const uint8_t dup[6] = { 0, 1, 2, 2, 4, 5 };
+    memcpy(c.block_order, dup, sizeof(dup));
+    assert_null(descramble_create(&c));     /* Not a permutation */
+
+    c = base_config();
+    c.block_cols = 16;
+    c.mirrored_blocks = 1U << 6;            /* No block 6 */
+    assert_null(descramble_create(&c));
+
+    c = base_config();
+    c.block_cols = 1;                       /* 96 blocks */
+    assert_null(descramble_create(&c));
+
+    c = base_config();
+    c.bottom_flipped = true;                /* Needs dual_side */
+    assert_null(descramble_create(&c));
+
+    c = base_config();
+    c.height = TEST_HEIGHT - 1;
+    c.dual_side = true;                     /* Odd height */
+    assert_null(descramble_create(&c));
+
+    descramble_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Plan tests */
+        cmocka_unit_test(test_descramble_identity),
+        cmocka_unit_test(test_descramble_blocks),
+        cmocka_unit_test(test_descramble_dual_side),
+        cmocka_unit_test(test_descramble_rows),
+        cmocka_unit_test(test_descramble_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-22: Readout Descramble Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,282 @@
+/**
+ * @file test_eth_tx.c
+ * @brief Unit tests for Ethernet TX header templates and statistics (FW-UT-33)
+ *
+ * Test ID: FW-UT-33
+ * Coverage: Start-of-frame header templates per REQ-FW-040, statistics
+ *           per REQ-FW-111
+ *
+ * Tests:
+ * - A frame prepared at start-of-frame is sent with the SOF timestamp,
+ *   including non-square panels
+ * - A template with swapped width/height is not used
+ * - A template for a later frame is kept until that frame is sent
+ * - Statistics read from another thread while frames are sent
+ *
+ * Frames go to a loopback socket; the header of the first packet of each
+ * frame is checked.
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "hal/eth_tx.h"
+
+/* Non-square panel: 96 columns x 64 rows */
+#define TEST_WIDTH      96
+#define TEST_HEIGHT     64
+#define TEST_BIT_DEPTH  16
+#define TEST_SOF_NS     0x123456789ABCULL
+
+typedef struct {
+    eth_tx_t *eth;
+    int rx;
+    uint16_t frame[TEST_WIDTH * TEST_HEIGHT];
+} eth_fixture_t;
+
+static eth_fixture_t g_fixture;
+
+/* Loopback sender and receiver on a per-process port */
+static eth_fixture_t *eth_open(void) {
+    eth_fixture_t *fixture = &g_fixture;
+    uint16_t port = (uint16_t)(20000 + getpid() % 20000);
+
+    memset(fixture, 0, sizeof(*fixture));
+
+    eth_tx_config_t config = {
+        .dest_ip = "127.0.0.1",
+        .data_port = port,
+        .cmd_port = (uint16_t)(port + 1),
+        .fps = 1000.0
+    };
+    fixture->eth = eth_tx_create(&config);
+    assert_non_null(fixture->eth);
+
+    /* Bound after eth_tx, so loopback datagrams to the data port land here */
+    fixture->rx = socket(AF_INET, SOCK_DGRAM, 0);
+    assert_true(fixture->rx >= 0);
+    int one = 1;
+    setsockopt(fixture->rx, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct timeval timeout = { .tv_sec = 1 };
+    setsockopt(fixture->rx, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(fixture->rx, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK)
+    };
+    assert_int_equal(bind(fixture->rx, (struct sockaddr *)&addr, sizeof(addr)), 0);
+
+    return fixture;
+}
+
+static void eth_close(eth_fixture_t *fixture) {
+    close(fixture->rx);
+    eth_tx_destroy(fixture->eth);
+}
+
+/* Send one frame and return the header of its first packet */
+static eth_frame_header_t send_and_receive(eth_fixture_t *fixture, uint32_t frame_number,
+                                           uint32_t width, uint32_t height) {
+    static uint8_t packet[65536];
+    eth_frame_header_t first;
+    memset(&first, 0, sizeof(first));
+
+    assert_int_equal(eth_tx_send_frame(fixture->eth, fixture->frame, sizeof(fixture->frame),
+                                       width, height, TEST_BIT_DEPTH, frame_number),
+                     ETH_TX_OK);
+
+    uint32_t received = 0;
+    uint32_t total = 1;
+    while (received < total) {
+        ssize_t len = recv(fixture->rx, packet, sizeof(packet), 0);
+        assert_true(len >= (ssize_t)sizeof(eth_frame_header_t));
+
+        eth_frame_header_t header;
+        memcpy(&header, packet, sizeof(header));
+        if (header.frame_number != frame_number) {
+            continue;
+        }
+        if (header.packet_index == 0) {
+            first = header;
+        }
+        total = header.total_packets;
+        received++;
+    }
+
+    assert_int_equal(first.magic, ETH_FRAME_MAGIC);
+    return first;
+}
+
+/* ==========================================================================
+ * Header Template Tests (REQ-FW-040)
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_33_001: Prepared non-square frame keeps its SOF timestamp
+ * @pre Frame 7 prepared at start-of-frame as 96 wide x 64 high
+ * @post Frame 7 sent as 96 x 64 carries width 96, height 64 and the SOF
+ *       timestamp; the template is used once, frame 7 sent again is
+ *       stamped at send time
+ */
+static void test_eth_prepared_non_square(void **state) {
+    (void)state;
+
+    eth_fixture_t *fixture = eth_open();
+
+    assert_int_equal(eth_tx_prepare_frame(fixture->eth, 7, TEST_WIDTH, TEST_HEIGHT,
+                                          TEST_BIT_DEPTH, TEST_SOF_NS),
+                     ETH_TX_OK);
+
+    eth_frame_header_t header = send_and_receive(fixture, 7, TEST_WIDTH, TEST_HEIGHT);
+    assert_int_equal(header.width, TEST_WIDTH);
+    assert_int_equal(header.height, TEST_HEIGHT);
+    assert_int_equal(header.timestamp, (uint32_t)TEST_SOF_NS);
+
+    header = send_and_receive(fixture, 7, TEST_WIDTH, TEST_HEIGHT);
+    assert_int_not_equal(header.timestamp, (uint32_t)TEST_SOF_NS);
+
+    eth_close(fixture);
+}
+
+/**
+ * @test FW_UT_33_002: Template with swapped dimensions is not used
+ * @pre Frame 8 prepared as 64 wide x 96 high (rows and columns swapped)
+ * @post Frame 8 sent as 96 x 64 is stamped at send time, not at SOF
+ */
+static void test_eth_prepared_swapped(void **state) {
+    (void)state;
+
+    eth_fixture_t *fixture = eth_open();
+
+    assert_int_equal(eth_tx_prepare_frame(fixture->eth, 8, TEST_HEIGHT, TEST_WIDTH,
+                                          TEST_BIT_DEPTH, TEST_SOF_NS),
+                     ETH_TX_OK);
+
+    eth_frame_header_t header = send_and_receive(fixture, 8, TEST_WIDTH, TEST_HEIGHT);
+    assert_int_equal(header.width, TEST_WIDTH);
+    assert_int_equal(header.height, TEST_HEIGHT);
+    assert_int_not_equal(header.timestamp, (uint32_t)TEST_SOF_NS);
+
+    eth_close(fixture);
+}
+
+/**
+ * @test FW_UT_33_003: Template for the next frame survives this one
+ * @pre Frame 10 prepared (its SOF arrived while frame 9 is in the pipeline)
+ * @post Frame 9 is stamped at send time; frame 10 then carries the SOF
+ *       timestamp
+ */
+static void test_eth_prepared_next_frame(void **state) {
+    (void)state;
+
+    eth_fixture_t *fixture = eth_open();
+
+    assert_int_equal(eth_tx_prepare_frame(fixture->eth, 10, TEST_WIDTH, TEST_HEIGHT,
+                                          TEST_BIT_DEPTH, TEST_SOF_NS),
+                     ETH_TX_OK);
+
+    eth_frame_header_t header = send_and_receive(fixture, 9, TEST_WIDTH, TEST_HEIGHT);
+    assert_int_not_equal(header.timestamp, (uint32_t)TEST_SOF_NS);
+
+    header = send_and_receive(fixture, 10, TEST_WIDTH, TEST_HEIGHT);
+    assert_int_equal(header.timestamp, (uint32_t)TEST_SOF_NS);
+
+    eth_close(fixture);
+}
+
+/* ==========================================================================
+ * Statistics Tests (REQ-FW-111)
+ * ========================================================================== */
+
+#define STATS_TEST_FRAMES 200
+
+typedef struct {
+    eth_fixture_t *fixture;
+    atomic_bool done;
+} stats_sender_t;
+
+static void *stats_sender(void *arg) {
+    stats_sender_t *sender = (stats_sender_t *)arg;
+
+    for (uint32_t f = 0; f < STATS_TEST_FRAMES; f++) {
+        eth_tx_send_frame(sender->fixture->eth, sender->fixture->frame,
+                          sizeof(sender->fixture->frame), TEST_WIDTH, TEST_HEIGHT,
+                          TEST_BIT_DEPTH, f);
+    }
+    atomic_store(&sender->done, true);
+    return NULL;
+}
+
+/**
+ * @test FW_UT_33_004: Statistics read while frames are sent
+ * @pre A second thread sends 200 frames
+ * @post Counters read during the sends never go backwards; afterwards
+ *       frames_sent is 200 and every packet is counted once
+ */
+static void test_eth_stats_concurrent(void **state) {
+    (void)state;
+
+    eth_fixture_t *fixture = eth_open();
+    stats_sender_t sender = { .fixture = fixture };
+    atomic_init(&sender.done, false);
+
+    pthread_t thread;
+    assert_int_equal(pthread_create(&thread, NULL, stats_sender, &sender), 0);
+
+    eth_tx_stats_t last = { 0 };
+    while (!atomic_load(&sender.done)) {
+        eth_tx_stats_t stats;
+        assert_int_equal(eth_tx_get_stats(fixture->eth, &stats), ETH_TX_OK);
+        assert_true(stats.frames_sent >= last.frames_sent);
+        assert_true(stats.packets_sent >= last.packets_sent);
+        assert_true(stats.bytes_sent >= last.bytes_sent);
+        last = stats;
+    }
+    assert_int_equal(pthread_join(thread, NULL), 0);
+
+    eth_tx_stats_t stats;
+    assert_int_equal(eth_tx_get_stats(fixture->eth, &stats), ETH_TX_OK);
+    assert_int_equal(stats.frames_sent, STATS_TEST_FRAMES);
+    assert_int_equal(stats.send_errors, 0);
+    assert_int_equal(stats.packets_sent % STATS_TEST_FRAMES, 0);
+    assert_true(stats.bytes_sent > sizeof(fixture->frame) * STATS_TEST_FRAMES);
+
+    eth_close(fixture);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_eth_prepared_non_square),
+        cmocka_unit_test(test_eth_prepared_swapped),
+        cmocka_unit_test(test_eth_prepared_next_frame),
+        cmocka_unit_test(test_eth_stats_concurrent),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-33: Ethernet TX Tests",
+                                       tests, NULL, NULL);
+}
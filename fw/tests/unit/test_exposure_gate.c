@@ -0,0 +1,278 @@
+/**
+ * @file test_exposure_gate.c
+ * @brief Unit tests for the exposure gate (FW-UT-28)
+ *
+ * Test ID: FW-UT-28
+ * Coverage: Subsampled mean/max signal detection, hold after signal,
+ *           empty-frame actions, in-place binning, parameter validation
+ *
+ * Tests:
+ * - Mean and max thresholds against the dark level, unsampled rows ignored
+ * - Hold frames after signal, reset, tag/decimate/drop verdicts and counters
+ * - Binning by the configured factor, partial blocks dropped
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/exposure_gate.h"
+
+#define TEST_WIDTH   67
+#define TEST_HEIGHT  32
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_DARK    1000
+
+static uint16_t g_frame[TEST_PIXELS];
+
+static void fill(uint16_t value) {
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_frame[i] = value;
+    }
+}
+
+static egate_verdict_t check(exposure_gate_t *gate) {
+    egate_result_t result;
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    return result.verdict;
+}
+
+/* ==========================================================================
+ * Detection Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_28_001: Signal detection
+ * @pre Dark level 1000, mean margin 50, row step 4; frames at the dark
+ *      level, at and above the mean limit, with a spike on a sampled and on
+ *      an unsampled row; then max margin 2000
+ * @post Empty up to mean 1050, signal above; a spike counts only with a
+ *       max margin and only on a sampled row; mean and max reported
+ */
+static void test_gate_detect(void **state) {
+    (void)state;
+
+    egate_config_t config = {
+        .dark_level = TEST_DARK, .mean_margin = 50, .row_step = 4
+    };
+    exposure_gate_t *gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+
+    egate_result_t result;
+    fill(TEST_DARK);
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_false(result.signal);
+    assert_int_equal(result.verdict, EGATE_VERDICT_TAG);
+    assert_int_equal(result.mean, TEST_DARK);
+    assert_int_equal(result.max, TEST_DARK);
+
+    fill(TEST_DARK + 50);
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_false(result.signal);
+    fill(TEST_DARK + 51);
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_true(result.signal);
+    assert_int_equal(result.verdict, EGATE_VERDICT_PASS);
+
+    /* Spike on sampled row 8: max only, the mean stays below the limit */
+    fill(TEST_DARK);
+    g_frame[8 * TEST_WIDTH + 33] = 20000;
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_false(result.signal);
+    assert_int_equal(result.max, 20000);
+    exposure_gate_destroy(gate);
+
+    config.max_margin = 2000;
+    gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_true(result.signal);
+
+    /* Same spike on row 9 is not sampled */
+    fill(TEST_DARK);
+    g_frame[9 * TEST_WIDTH + 33] = 20000;
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_OK);
+    assert_false(result.signal);
+    exposure_gate_destroy(gate);
+}
+
+/**
+ * @test FW_UT_28_002: Hold and actions
+ * @pre Hold 2 frames, action drop; empty frames before, signal, four
+ *      empty frames, reset, one empty frame; then decimate and tag actions
+ * @post Empty frames before any signal dropped, two held after signal,
+ *       later ones dropped; nothing held after reset; verdict follows the
+ *       action; counters add up
+ */
+static void test_gate_hold(void **state) {
+    (void)state;
+
+    egate_config_t config = {
+        .dark_level = TEST_DARK, .hold_frames = 2, .action = EGATE_ACTION_DROP
+    };
+    exposure_gate_t *gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+
+    fill(TEST_DARK);
+    assert_int_equal(check(gate), EGATE_VERDICT_DROP);
+    fill(TEST_DARK + 500);
+    assert_int_equal(check(gate), EGATE_VERDICT_PASS);
+    fill(TEST_DARK);
+    assert_int_equal(check(gate), EGATE_VERDICT_PASS);
+    assert_int_equal(check(gate), EGATE_VERDICT_PASS);
+    assert_int_equal(check(gate), EGATE_VERDICT_DROP);
+    assert_int_equal(check(gate), EGATE_VERDICT_DROP);
+
+    fill(TEST_DARK + 500);
+    assert_int_equal(check(gate), EGATE_VERDICT_PASS);
+    exposure_gate_reset(gate);
+    fill(TEST_DARK);
+    assert_int_equal(check(gate), EGATE_VERDICT_DROP);
+
+    egate_stats_t stats;
+    assert_int_equal(exposure_gate_get_stats(gate, &stats), EGATE_OK);
+    assert_int_equal(stats.frames, 8);
+    assert_int_equal(stats.signal, 2);
+    assert_int_equal(stats.held, 2);
+    assert_int_equal(stats.dropped, 4);
+    assert_int_equal(stats.tagged, 0);
+    exposure_gate_destroy(gate);
+
+    config.action = EGATE_ACTION_DECIMATE;
+    gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+    assert_int_equal(check(gate), EGATE_VERDICT_DECIMATE);
+    exposure_gate_destroy(gate);
+
+    config.action = EGATE_ACTION_TAG;
+    gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+    assert_int_equal(check(gate), EGATE_VERDICT_TAG);
+    assert_int_equal(exposure_gate_get_stats(gate, &stats), EGATE_OK);
+    assert_int_equal(stats.tagged, 1);
+    exposure_gate_destroy(gate);
+}
+
+/**
+ * @test FW_UT_28_003: Binning
+ * @pre Factor 4 on a 67x32 frame holding x + 100 * y; then a frame
+ *      narrower than one block
+ * @post 16x8 output, each pixel the rounded block mean, written from the
+ *       start of the buffer; too small a frame rejected unchanged
+ */
+static void test_gate_decimate(void **state) {
+    (void)state;
+
+    egate_config_t config = { .dark_level = TEST_DARK, .decimate = 4 };
+    exposure_gate_t *gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+
+    for (uint32_t y = 0; y < TEST_HEIGHT; y++) {
+        for (uint32_t x = 0; x < TEST_WIDTH; x++) {
+            g_frame[y * TEST_WIDTH + x] = (uint16_t)(x + 100 * y);
+        }
+    }
+
+    uint32_t width = TEST_WIDTH;
+    uint32_t height = TEST_HEIGHT;
+    assert_int_equal(exposure_gate_decimate(gate, g_frame, &width, &height), EGATE_OK);
+    assert_int_equal(width, 16);
+    assert_int_equal(height, 8);
+
+    /* Block mean: 4 * ox + 1.5 + 100 * (4 * oy + 1.5), rounded half up */
+    for (uint32_t oy = 0; oy < height; oy++) {
+        for (uint32_t ox = 0; ox < width; ox++) {
+            assert_int_equal(g_frame[oy * width + ox], 4 * ox + 400 * oy + 152);
+        }
+    }
+
+    width = 3;
+    height = TEST_HEIGHT;
+    assert_int_equal(exposure_gate_decimate(gate, g_frame, &width, &height), EGATE_ERROR_PARAM);
+    assert_int_equal(width, 3);
+    exposure_gate_destroy(gate);
+}
+
+/**
+ * @test FW_UT_28_004: Invalid parameters
+ * @pre Row step above the limit, factor 1 or above the limit, unknown
+ *      action, zero or oversized geometry, NULL pointers
+ * @post Create fails or the call returns an error
+ */
+static void test_gate_invalid(void **state) {
+    (void)state;
+
+    egate_config_t config = { .dark_level = TEST_DARK };
+
+    egate_config_t bad = config;
+    bad.row_step = EGATE_MAX_ROW_STEP + 1;
+    assert_null(exposure_gate_create(&bad));
+    bad = config;
+    bad.decimate = 1;
+    assert_null(exposure_gate_create(&bad));
+    bad = config;
+    bad.decimate = EGATE_MAX_DECIMATE + 1;
+    assert_null(exposure_gate_create(&bad));
+    bad = config;
+    bad.action = (egate_action_t)(EGATE_ACTION_DROP + 1);
+    assert_null(exposure_gate_create(&bad));
+    assert_null(exposure_gate_create(NULL));
+
+    exposure_gate_t *gate = exposure_gate_create(&config);
+    assert_non_null(gate);
+
+    egate_result_t result;
+    egate_stats_t stats;
+    uint32_t width = TEST_WIDTH;
+    uint32_t height = TEST_HEIGHT;
+    assert_int_equal(exposure_gate_check(gate, g_frame, 0, TEST_HEIGHT, &result),
+                     EGATE_ERROR_PARAM);
+    assert_int_equal(exposure_gate_check(gate, g_frame, 70000, 1, &result),
+                     EGATE_ERROR_PARAM);
+    assert_int_equal(exposure_gate_check(NULL, g_frame, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_check(gate, NULL, TEST_WIDTH, TEST_HEIGHT, &result),
+                     EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_check(gate, g_frame, TEST_WIDTH, TEST_HEIGHT, NULL),
+                     EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_decimate(gate, g_frame, NULL, &height), EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_decimate(NULL, g_frame, &width, &height), EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_get_stats(gate, NULL), EGATE_ERROR_NULL);
+    assert_int_equal(exposure_gate_get_stats(NULL, &stats), EGATE_ERROR_NULL);
+
+    exposure_gate_destroy(gate);
+    exposure_gate_destroy(NULL);
+    exposure_gate_reset(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Gate tests */
+        cmocka_unit_test(test_gate_detect),
+        cmocka_unit_test(test_gate_hold),
+        cmocka_unit_test(test_gate_decimate),
+        cmocka_unit_test(test_gate_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-28: Exposure Gate Tests",
+                                       tests, NULL, NULL);
+}
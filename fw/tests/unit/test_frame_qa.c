@@ -0,0 +1,258 @@
+/**
+ * @file test_frame_qa.c
+ * @brief Unit tests for per-frame image quality metrics (FW-UT-26)
+ *
+ * Test ID: FW-UT-26
+ * Coverage: ROI noise and SNR, row/column banding, ROI non-uniformity,
+ *           band-wise accumulation, parameter validation
+ *
+ * Tests:
+ * - ROI mean, noise and SNR of a known pattern
+ * - Column and row banding detected, smooth gradients ignored
+ * - Non-uniformity of the default five-point ROIs
+ * - Band-wise metrics equal whole-frame metrics
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/frame_qa.h"
+
+#define TEST_SIZE   256
+
+static uint16_t g_frame[TEST_SIZE * TEST_SIZE];
+
+static void fill_flat(uint16_t value) {
+    for (size_t i = 0; i < TEST_SIZE * TEST_SIZE; i++) {
+        g_frame[i] = value;
+    }
+}
+
+/* ==========================================================================
+ * Metric Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_26_001: ROI noise and SNR
+ * @pre 1000-count frame; ROI 0 checkerboard 1000 +/- 20, ROI 1 flat,
+ *      every row sampled
+ * @post ROI 0 mean 1000, noise 20, SNR 50; ROI 1 noise 0 and SNR 0;
+ *       frame aggregates average the ROIs
+ */
+static void test_frame_qa_noise(void **state) {
+    (void)state;
+
+    fqa_config_t config = {
+        .width = TEST_SIZE, .height = TEST_SIZE, .row_step = 1, .roi_count = 2,
+        .rois = { { 16, 16, 64, 64 }, { 160, 160, 64, 64 } }
+    };
+    frame_qa_t *qa = frame_qa_create(&config);
+    assert_non_null(qa);
+
+    fill_flat(1000);
+    for (uint32_t y = 16; y < 80; y++) {
+        for (uint32_t x = 16; x < 80; x++) {
+            g_frame[y * TEST_SIZE + x] = ((x + y) & 1) ? 1020 : 980;
+        }
+    }
+
+    fqa_result_t result;
+    assert_int_equal(frame_qa_compute(qa, g_frame, &result), FQA_OK);
+    assert_int_equal(result.roi_count, 2);
+    assert_float_equal(result.roi[0].mean, 1000.0f, 0.01f);
+    assert_float_equal(result.roi[0].noise, 20.0f, 0.01f);
+    assert_float_equal(result.roi[0].snr, 50.0f, 0.01f);
+    assert_float_equal(result.roi[1].mean, 1000.0f, 0.01f);
+    assert_float_equal(result.roi[1].noise, 0.0f, 0.01f);
+    assert_float_equal(result.roi[1].snr, 0.0f, 0.01f);
+
+    assert_float_equal(result.mean, 1000.0f, 0.01f);
+    assert_float_equal(result.noise, 10.0f, 0.01f);
+    assert_float_equal(result.snr, 100.0f, 0.01f);
+    assert_float_equal(result.nonuniformity, 0.0f, 0.0001f);
+
+    frame_qa_destroy(qa);
+}
+
+/**
+ * @test FW_UT_26_002: Banding
+ * @pre Horizontal gradient plus odd columns +10; then a vertical gradient
+ *      plus odd rows +10 (row step 1)
+ * @post Column stripes give col_banding 10 * sqrt(2/3) and no row banding,
+ *       row stripes the reverse; the gradients alone contribute nothing
+ */
+static void test_frame_qa_banding(void **state) {
+    (void)state;
+
+    fqa_config_t config = { .width = TEST_SIZE, .height = TEST_SIZE, .row_step = 1 };
+    frame_qa_t *qa = frame_qa_create(&config);
+    assert_non_null(qa);
+
+    for (uint32_t y = 0; y < TEST_SIZE; y++) {
+        for (uint32_t x = 0; x < TEST_SIZE; x++) {
+            g_frame[y * TEST_SIZE + x] = (uint16_t)(1000 + 4 * x + ((x & 1) ? 10 : 0));
+        }
+    }
+
+    fqa_result_t result;
+    assert_int_equal(frame_qa_compute(qa, g_frame, &result), FQA_OK);
+    assert_float_equal(result.col_banding, 8.165f, 0.01f);
+    assert_float_equal(result.row_banding, 0.0f, 0.001f);
+
+    for (uint32_t y = 0; y < TEST_SIZE; y++) {
+        for (uint32_t x = 0; x < TEST_SIZE; x++) {
+            g_frame[y * TEST_SIZE + x] = (uint16_t)(1000 + 4 * y + ((y & 1) ? 10 : 0));
+        }
+    }
+
+    assert_int_equal(frame_qa_compute(qa, g_frame, &result), FQA_OK);
+    assert_float_equal(result.row_banding, 8.165f, 0.01f);
+    assert_float_equal(result.col_banding, 0.0f, 0.001f);
+
+    frame_qa_destroy(qa);
+}
+
+/**
+ * @test FW_UT_26_003: Non-uniformity
+ * @pre Default five-point ROIs, 100x100 top-left block 1200, rest 1000
+ * @post Five ROIs, inside the frame; non-uniformity (1200 - 1000) / 2200
+ */
+static void test_frame_qa_uniformity(void **state) {
+    (void)state;
+
+    fqa_config_t config = { .width = TEST_SIZE, .height = TEST_SIZE };
+    frame_qa_t *qa = frame_qa_create(&config);
+    assert_non_null(qa);
+
+    fill_flat(1000);
+    for (uint32_t y = 0; y < 100; y++) {
+        for (uint32_t x = 0; x < 100; x++) {
+            g_frame[y * TEST_SIZE + x] = 1200;
+        }
+    }
+
+    fqa_result_t result;
+    assert_int_equal(frame_qa_compute(qa, g_frame, &result), FQA_OK);
+    assert_int_equal(result.roi_count, FQA_MAX_ROIS);
+    assert_float_equal(result.roi[0].mean, 1000.0f, 0.01f);    /* Centre */
+    assert_float_equal(result.roi[1].mean, 1200.0f, 0.01f);    /* Top left */
+    assert_float_equal(result.nonuniformity, 200.0f / 2200.0f, 0.0001f);
+
+    frame_qa_destroy(qa);
+}
+
+/**
+ * @test FW_UT_26_004: Band-wise accumulation
+ * @pre Random frame, overlapping ROIs, row step 3; 7-row bands added in
+ *      reverse order, then a frame with one band missing
+ * @post Band-wise result identical to frame_qa_compute(); a missing band
+ *       zeroes the banding figures only
+ */
+static void test_frame_qa_bands(void **state) {
+    (void)state;
+
+    fqa_config_t config = {
+        .width = TEST_SIZE, .height = TEST_SIZE, .row_step = 3, .roi_count = 3,
+        .rois = { { 0, 0, TEST_SIZE, TEST_SIZE }, { 10, 20, 100, 50 }, { 50, 30, 7, 200 } }
+    };
+    frame_qa_t *qa = frame_qa_create(&config);
+    assert_non_null(qa);
+
+    uint32_t seed = 11;
+    for (size_t i = 0; i < TEST_SIZE * TEST_SIZE; i++) {
+        g_frame[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+
+    fqa_result_t whole, banded;
+    assert_int_equal(frame_qa_compute(qa, g_frame, &whole), FQA_OK);
+    assert_true(whole.row_banding > 0.0f);
+
+    assert_int_equal(frame_qa_begin(qa), FQA_OK);
+    uint32_t top = TEST_SIZE;
+    while (top > 0) {
+        uint32_t rows = (top >= 7) ? 7 : top;
+        top -= rows;
+        assert_int_equal(frame_qa_accumulate_rows(qa, g_frame, top, rows), FQA_OK);
+    }
+    assert_int_equal(frame_qa_finish(qa, &banded), FQA_OK);
+    assert_memory_equal(&whole, &banded, sizeof(whole));
+
+    /* Rows 0-6 missing */
+    assert_int_equal(frame_qa_begin(qa), FQA_OK);
+    assert_int_equal(frame_qa_accumulate_rows(qa, g_frame, 7, TEST_SIZE - 7), FQA_OK);
+    assert_int_equal(frame_qa_finish(qa, &banded), FQA_OK);
+    assert_float_equal(banded.row_banding, 0.0f, 0.0f);
+    assert_float_equal(banded.col_banding, 0.0f, 0.0f);
+    assert_true(banded.roi[1].noise > 0.0f);
+
+    frame_qa_destroy(qa);
+}
+
+/**
+ * @test FW_UT_26_005: Invalid parameters
+ * @pre ROI outside the frame, empty ROI, too many ROIs, row step above the
+ *      limit, zero geometry, NULL pointers, band past the last row
+ * @post Create fails or the call returns an error
+ */
+static void test_frame_qa_invalid(void **state) {
+    (void)state;
+
+    fqa_config_t config = { .width = 128, .height = 128, .roi_count = 1,
+                            .rois = { { 100, 0, 29, 10 } } };
+    assert_null(frame_qa_create(&config));
+    config.rois[0] = (fqa_roi_t){ 0, 0, 0, 10 };
+    assert_null(frame_qa_create(&config));
+    config.rois[0] = (fqa_roi_t){ 0, 0, 10, 10 };
+    config.roi_count = FQA_MAX_ROIS + 1;
+    assert_null(frame_qa_create(&config));
+    config.roi_count = 1;
+    config.row_step = FQA_MAX_ROW_STEP + 1;
+    assert_null(frame_qa_create(&config));
+    config.row_step = 0;
+    config.height = 0;
+    assert_null(frame_qa_create(&config));
+    assert_null(frame_qa_create(NULL));
+
+    config.height = 128;
+    frame_qa_t *qa = frame_qa_create(&config);
+    assert_non_null(qa);
+
+    fqa_result_t result;
+    assert_int_equal(frame_qa_compute(qa, NULL, &result), FQA_ERROR_NULL);
+    assert_int_equal(frame_qa_compute(NULL, g_frame, &result), FQA_ERROR_NULL);
+    assert_int_equal(frame_qa_begin(NULL), FQA_ERROR_NULL);
+    assert_int_equal(frame_qa_begin(qa), FQA_OK);
+    assert_int_equal(frame_qa_accumulate_rows(qa, g_frame, 120, 9), FQA_ERROR_PARAM);
+    assert_int_equal(frame_qa_accumulate_rows(qa, g_frame, 128, 0), FQA_ERROR_PARAM);
+    assert_int_equal(frame_qa_finish(qa, NULL), FQA_ERROR_NULL);
+
+    frame_qa_destroy(qa);
+    frame_qa_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Metric tests */
+        cmocka_unit_test(test_frame_qa_noise),
+        cmocka_unit_test(test_frame_qa_banding),
+        cmocka_unit_test(test_frame_qa_uniformity),
+        cmocka_unit_test(test_frame_qa_bands),
+        cmocka_unit_test(test_frame_qa_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-26: Frame QA Tests",
+                                       tests, NULL, NULL);
+}
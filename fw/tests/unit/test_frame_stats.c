@@ -0,0 +1,247 @@
+/**
+ * @file test_frame_stats.c
+ * @brief Unit tests for fused frame statistics kernel (FW-UT-14)
+ *
+ * Test ID: FW-UT-14
+ * Coverage: Histogram, percentiles, min/max and ROI mean
+ *
+ * Tests:
+ * - Configuration validation
+ * - Full-sample statistics against a reference
+ * - Subsampling grid and ROI selection
+ * - Percentile lookup
+ * - Band-wise accumulation matches the whole-frame pass
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/frame_stats.h"
+
+/* Odd width exercises SIMD tails */
+#define TEST_WIDTH   67
+#define TEST_HEIGHT  9
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+static void fill_random(uint16_t *frame, size_t n, uint32_t seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        frame[i] = (uint16_t)(seed >> 16);
+    }
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_14_001: Reject invalid arguments
+ * @pre NULL pointers, zero geometry, ROI outside frame
+ * @post FSTATS_ERROR_NULL / FSTATS_ERROR_PARAM
+ */
+static void test_fstats_invalid(void **state) {
+    (void)state;
+
+    static fstats_t stats;
+    uint16_t frame[TEST_PIXELS] = {0};
+    fstats_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT };
+
+    assert_int_equal(frame_stats_compute(NULL, frame, &stats), FSTATS_ERROR_NULL);
+    assert_int_equal(frame_stats_compute(&config, NULL, &stats), FSTATS_ERROR_NULL);
+    assert_int_equal(frame_stats_compute(&config, frame, NULL), FSTATS_ERROR_NULL);
+
+    config.width = 0;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_ERROR_PARAM);
+
+    config.width = TEST_WIDTH;
+    config.roi_x = 60;
+    config.roi_width = 8;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_ERROR_PARAM);
+
+    config.roi_x = 0;
+    config.roi_width = 0;
+    config.roi_y = TEST_HEIGHT;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_ERROR_PARAM);
+}
+
+/* ==========================================================================
+ * Statistics Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_14_002: Full sampling matches scalar reference
+ * @pre Random frame, row/col step 1, no ROI
+ * @post Histogram, min, max and mean identical to reference
+ */
+static void test_fstats_full(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    fill_random(frame, TEST_PIXELS, 7);
+
+    fstats_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT, .row_step = 1, .col_step = 1
+    };
+    static fstats_t stats;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_OK);
+
+    static uint32_t hist[FSTATS_HIST_BINS];
+    memset(hist, 0, sizeof(hist));
+    uint16_t mn = 0xFFFF, mx = 0;
+    uint64_t sum = 0;
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        hist[frame[i] >> FSTATS_HIST_SHIFT]++;
+        mn = (frame[i] < mn) ? frame[i] : mn;
+        mx = (frame[i] > mx) ? frame[i] : mx;
+        sum += frame[i];
+    }
+
+    assert_memory_equal(stats.hist, hist, sizeof(hist));
+    assert_int_equal(stats.samples, TEST_PIXELS);
+    assert_int_equal(stats.min, mn);
+    assert_int_equal(stats.max, mx);
+    assert_int_equal(stats.roi_sum, sum);
+    assert_int_equal(stats.roi_count, TEST_PIXELS);
+    assert_float_equal(stats.roi_mean, (double)sum / TEST_PIXELS, 0.01);
+}
+
+/**
+ * @test FW_UT_14_003: Subsampling and ROI
+ * @pre Background 100, ROI rectangle 1000, one bright pixel outside the grid
+ * @post ROI mean 1000, sampled rows only, bright pixel ignored
+ */
+static void test_fstats_roi_subsample(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 100;
+    }
+    for (int y = 4; y < 8; y++) {
+        for (int x = 20; x < 60; x++) {
+            frame[y * TEST_WIDTH + x] = 1000;
+        }
+    }
+    frame[1 * TEST_WIDTH + 1] = 65535;  /* Row 1 is not sampled with step 2 */
+
+    fstats_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .row_step = 2, .col_step = 3,
+        .roi_x = 20, .roi_y = 4, .roi_width = 40, .roi_height = 4
+    };
+    static fstats_t stats;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_OK);
+
+    /* Rows 0,2,4,6,8 sampled; ROI rows 4,6 */
+    assert_int_equal(stats.roi_count, 2 * 40);
+    assert_float_equal(stats.roi_mean, 1000.0, 0.001);
+    assert_int_equal(stats.max, 1000);
+    assert_int_equal(stats.min, 100);
+
+    /* 23 histogram samples per row (x = 0, 3, ..., 66) */
+    assert_int_equal(stats.samples, 5 * 23);
+
+    /* ROI columns 21..57 in steps of 3 -> 13 per ROI row */
+    assert_int_equal(stats.hist[1000 >> FSTATS_HIST_SHIFT], 2 * 13);
+    assert_int_equal(stats.hist[100 >> FSTATS_HIST_SHIFT], 5 * 23 - 2 * 13);
+}
+
+/**
+ * @test FW_UT_14_004: Percentiles from histogram
+ * @pre 90% of samples at 1000, 10% at 40000
+ * @post p50 in 1000's bin, p95 in 40000's bin, empty stats -> 0
+ */
+static void test_fstats_percentile(void **state) {
+    (void)state;
+
+    uint16_t frame[100];
+    for (int i = 0; i < 100; i++) {
+        frame[i] = (i < 90) ? 1000 : 40000;
+    }
+
+    fstats_config_t config = { .width = 100, .height = 1, .row_step = 1, .col_step = 1 };
+    static fstats_t stats;
+    assert_int_equal(frame_stats_compute(&config, frame, &stats), FSTATS_OK);
+
+    uint16_t p50 = frame_stats_percentile(&stats, 0.5f);
+    uint16_t p90 = frame_stats_percentile(&stats, 0.9f);
+    uint16_t p95 = frame_stats_percentile(&stats, 0.95f);
+
+    assert_int_equal(p50 >> FSTATS_HIST_SHIFT, 1000 >> FSTATS_HIST_SHIFT);
+    assert_int_equal(p90 >> FSTATS_HIST_SHIFT, 1000 >> FSTATS_HIST_SHIFT);
+    assert_int_equal(p95 >> FSTATS_HIST_SHIFT, 40000 >> FSTATS_HIST_SHIFT);
+    assert_int_equal(frame_stats_percentile(&stats, 1.0f) >> FSTATS_HIST_SHIFT,
+                     40000 >> FSTATS_HIST_SHIFT);
+
+    memset(&stats, 0, sizeof(stats));
+    assert_int_equal(frame_stats_percentile(&stats, 0.5f), 0);
+}
+
+/**
+ * @test FW_UT_14_005: Band-wise accumulation matches whole frame
+ * @pre Random frame, step 2/3, ROI; bands of 4 rows (not a multiple of
+ *      the row step) out of order; band past the frame
+ * @post Identical statistics to frame_stats_compute; PARAM for bad band
+ */
+static void test_fstats_bands(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    fill_random(frame, TEST_PIXELS, 11);
+
+    fstats_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .row_step = 2, .col_step = 3,
+        .roi_x = 5, .roi_y = 3, .roi_width = 50, .roi_height = 5
+    };
+    static fstats_t whole, bands;
+    assert_int_equal(frame_stats_compute(&config, frame, &whole), FSTATS_OK);
+
+    assert_int_equal(frame_stats_begin(&config, &bands), FSTATS_OK);
+    assert_int_equal(frame_stats_accumulate_rows(&config, frame, 4, 4, &bands), FSTATS_OK);
+    assert_int_equal(frame_stats_accumulate_rows(&config, frame, 0, 3, &bands), FSTATS_OK);
+    assert_int_equal(frame_stats_accumulate_rows(&config, frame, 3, 1, &bands), FSTATS_OK);
+    assert_int_equal(frame_stats_accumulate_rows(&config, frame, 8, 1, &bands), FSTATS_OK);
+    frame_stats_finish(&bands);
+
+    assert_memory_equal(bands.hist, whole.hist, sizeof(whole.hist));
+    assert_int_equal(bands.samples, whole.samples);
+    assert_int_equal(bands.min, whole.min);
+    assert_int_equal(bands.max, whole.max);
+    assert_int_equal(bands.roi_sum, whole.roi_sum);
+    assert_int_equal(bands.roi_count, whole.roi_count);
+    assert_float_equal(bands.roi_mean, whole.roi_mean, 0.001);
+
+    assert_int_equal(frame_stats_accumulate_rows(&config, frame, 8, 2, &bands), FSTATS_ERROR_PARAM);
+    assert_int_equal(frame_stats_accumulate_rows(&config, NULL, 0, 1, &bands), FSTATS_ERROR_NULL);
+    config.width = 0;
+    assert_int_equal(frame_stats_begin(&config, &bands), FSTATS_ERROR_PARAM);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_fstats_invalid),
+
+        /* Statistics tests */
+        cmocka_unit_test(test_fstats_full),
+        cmocka_unit_test(test_fstats_roi_subsample),
+        cmocka_unit_test(test_fstats_percentile),
+        cmocka_unit_test(test_fstats_bands),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-14: Frame Statistics Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file test_hdr_fusion.c
+ * @brief Unit tests for dual-gain HDR fusion (FW-UT-27)
+ *
+ * Test ID: FW-UT-27
+ * Coverage: Per-pixel gain selection, cross-fade, output scaling,
+ *           frame pairing by sequence number, parameter validation
+ *
+ * Tests:
+ * - Hard selection at the threshold, saturation and output shift
+ * - Linear cross-fade below the threshold
+ * - Pairs fused, broken pairs dropped by frame number
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/hdr_fusion.h"
+
+#define TEST_WIDTH   64
+#define TEST_HEIGHT  16
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+static uint16_t g_high[TEST_PIXELS];
+static uint16_t g_low[TEST_PIXELS];
+
+static void fill(uint16_t *frame, uint16_t value) {
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = value;
+    }
+}
+
+/* ==========================================================================
+ * Fusion Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_27_001: Hard selection
+ * @pre Gains 1.0x / 4.0x, threshold 10000, no blend; pixels below, at and
+ *      far above the threshold; then output shift 2
+ * @post High-gain sample below the threshold, 4 x low-gain sample from it
+ *       on, 65535 on overflow; the shift divides by 4 without saturating
+ */
+static void test_hdr_select(void **state) {
+    (void)state;
+
+    hdr_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .low_gain = 0x0080, .high_gain = 0x0200, .threshold = 10000
+    };
+    hdr_fusion_t *hdr = hdr_fusion_create(&config);
+    assert_non_null(hdr);
+
+    const uint16_t high[] = { 5000, 9999, 10000, 16383, 65535 };
+    const uint16_t low[] = { 1250, 2500, 2600, 4100, 20000 };
+    const uint16_t fused[] = { 5000, 9999, 10400, 16400, 65535 };
+    const uint16_t shifted[] = { 1250, 2500, 2600, 4100, 20000 };
+
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_high[i] = high[i % 5];
+        g_low[i] = low[i % 5];
+    }
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, g_low), HDR_OK);
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        assert_int_equal(g_high[i], fused[i % 5]);
+    }
+    hdr_fusion_destroy(hdr);
+
+    config.output_shift = 2;
+    hdr = hdr_fusion_create(&config);
+    assert_non_null(hdr);
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_high[i] = high[i % 5];
+    }
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, g_low), HDR_OK);
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        assert_int_equal(g_high[i], shifted[i % 5]);
+    }
+    hdr_fusion_destroy(hdr);
+}
+
+/**
+ * @test FW_UT_27_002: Cross-fade
+ * @pre Gains 1.0x / 4.0x, threshold 10000, blend 1000; low-gain sample
+ *      2000 (8000 in high-gain units)
+ * @post High-gain value up to 9000, midpoint at 9500, low gain from 10000
+ */
+static void test_hdr_blend(void **state) {
+    (void)state;
+
+    hdr_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .low_gain = 0x0080, .high_gain = 0x0200, .threshold = 10000, .blend = 1000
+    };
+    hdr_fusion_t *hdr = hdr_fusion_create(&config);
+    assert_non_null(hdr);
+
+    fill(g_low, 2000);
+
+    fill(g_high, 9000);
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, g_low), HDR_OK);
+    assert_int_equal(g_high[0], 9000);
+    assert_int_equal(g_high[TEST_PIXELS - 1], 9000);
+
+    fill(g_high, 9500);
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, g_low), HDR_OK);
+    assert_int_equal(g_high[0], 8750);
+    assert_int_equal(g_high[TEST_PIXELS - 1], 8750);
+
+    fill(g_high, 10000);
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, g_low), HDR_OK);
+    assert_int_equal(g_high[0], 8000);
+    assert_int_equal(g_high[TEST_PIXELS - 1], 8000);
+
+    hdr_fusion_destroy(hdr);
+}
+
+/**
+ * @test FW_UT_27_003: Pairing
+ * @pre Frames 10/11, 12/14/15 (14 replaces 12), 16/19 (17 and 18 lost),
+ *      21 alone, then a pair across the 32-bit wrap
+ * @post Only (10,11), (14,15) and (0xFFFFFFFE,0xFFFFFFFF) fused, each
+ *       from the right low-gain frame; orphans counted on both sides;
+ *       reset forgets the held frame without counting it
+ */
+static void test_hdr_pairing(void **state) {
+    (void)state;
+
+    hdr_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .low_gain = 0x0080, .high_gain = 0x0200, .threshold = 10000
+    };
+    hdr_fusion_t *hdr = hdr_fusion_create(&config);
+    assert_non_null(hdr);
+
+    hdr_pair_t pair;
+    hdr_stats_t stats;
+
+    /* Low-gain frames carry their frame number; high gain is saturated */
+    fill(g_low, 100);
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 10, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_HELD);
+    fill(g_high, 60000);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 11, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_FUSED);
+    assert_int_equal(g_high[0], 400);
+
+    fill(g_low, 120);
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 12, &pair), HDR_OK);
+    fill(g_low, 140);
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 14, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_HELD);
+    fill(g_low, 0);
+    fill(g_high, 60000);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 15, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_FUSED);
+    assert_int_equal(g_high[TEST_PIXELS - 1], 560);
+
+    fill(g_low, 160);
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 16, &pair), HDR_OK);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 19, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_DROPPED);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 21, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_DROPPED);
+
+    assert_int_equal(hdr_fusion_get_stats(hdr, &stats), HDR_OK);
+    assert_int_equal(stats.fused, 2);
+    assert_int_equal(stats.dropped_low, 2);
+    assert_int_equal(stats.dropped_high, 2);
+
+    fill(g_low, 50);
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 0xFFFFFFFEU, &pair), HDR_OK);
+    fill(g_high, 60000);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 0xFFFFFFFFU, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_FUSED);
+    assert_int_equal(g_high[0], 200);
+
+    /* A frame held before the reset has no partner after it */
+    assert_int_equal(hdr_fusion_submit(hdr, g_low, 0, &pair), HDR_OK);
+    hdr_fusion_reset(hdr);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 1, &pair), HDR_OK);
+    assert_int_equal(pair, HDR_PAIR_DROPPED);
+    assert_int_equal(hdr_fusion_get_stats(hdr, &stats), HDR_OK);
+    assert_int_equal(stats.fused, 3);
+    assert_int_equal(stats.dropped_low, 2);
+    assert_int_equal(stats.dropped_high, 3);
+
+    hdr_fusion_destroy(hdr);
+}
+
+/**
+ * @test FW_UT_27_004: Invalid parameters
+ * @pre Zero geometry, zero or inverted gains, ratio above HDR_MAX_RATIO,
+ *      blend not below the threshold, output shift above the limit, NULL
+ *      pointers
+ * @post Create fails or the call returns HDR_ERROR_NULL
+ */
+static void test_hdr_invalid(void **state) {
+    (void)state;
+
+    hdr_config_t config = {
+        .width = TEST_WIDTH, .height = TEST_HEIGHT,
+        .low_gain = 0x0080, .high_gain = 0x0200, .threshold = 10000
+    };
+
+    hdr_config_t bad = config;
+    bad.width = 0;
+    assert_null(hdr_fusion_create(&bad));
+    bad = config;
+    bad.low_gain = 0;
+    assert_null(hdr_fusion_create(&bad));
+    bad = config;
+    bad.high_gain = bad.low_gain;
+    assert_null(hdr_fusion_create(&bad));
+    bad = config;
+    bad.high_gain = (uint16_t)(bad.low_gain * HDR_MAX_RATIO + 1);
+    assert_null(hdr_fusion_create(&bad));
+    bad = config;
+    bad.blend = bad.threshold;
+    assert_null(hdr_fusion_create(&bad));
+    bad = config;
+    bad.output_shift = HDR_MAX_OUTPUT_SHIFT + 1;
+    assert_null(hdr_fusion_create(&bad));
+    assert_null(hdr_fusion_create(NULL));
+
+    hdr_fusion_t *hdr = hdr_fusion_create(&config);
+    assert_non_null(hdr);
+
+    hdr_pair_t pair;
+    hdr_stats_t stats;
+    assert_int_equal(hdr_fusion_submit(NULL, g_high, 0, &pair), HDR_ERROR_NULL);
+    assert_int_equal(hdr_fusion_submit(hdr, NULL, 0, &pair), HDR_ERROR_NULL);
+    assert_int_equal(hdr_fusion_submit(hdr, g_high, 0, NULL), HDR_ERROR_NULL);
+    assert_int_equal(hdr_fusion_fuse(hdr, g_high, NULL), HDR_ERROR_NULL);
+    assert_int_equal(hdr_fusion_get_stats(hdr, NULL), HDR_ERROR_NULL);
+    assert_int_equal(hdr_fusion_get_stats(NULL, &stats), HDR_ERROR_NULL);
+
+    hdr_fusion_destroy(hdr);
+    hdr_fusion_destroy(NULL);
+    hdr_fusion_reset(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Fusion tests */
+        cmocka_unit_test(test_hdr_select),
+        cmocka_unit_test(test_hdr_blend),
+        cmocka_unit_test(test_hdr_pairing),
+        cmocka_unit_test(test_hdr_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-27: HDR Fusion Tests",
+                                       tests, NULL, NULL);
+}
@@ -10,10 +10,18 @@
  * - Runtime statistics aggregation per REQ-FW-111
  * - Structured syslog logging per REQ-FW-110
  * - GET_STATUS response assembly per REQ-FW-112
+ * - Per-frame metric time series
+ * - Enum-indexed per-thread counters under concurrent updates
+ * - Status collector snapshot and per-field freshness
+ * - CMD_GET_STATUS served from the snapshot while the sequence engine is busy
  *
  * Copyright (c) 2026 ABYZ Lab
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
@@ -21,7 +29,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <errno.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <openssl/hmac.h>
+#include <openssl/evp.h>
 
 /* Log levels */
 typedef enum {
@@ -32,6 +46,22 @@ typedef enum {
     LOG_CRITICAL,
 } log_level_t;
 
+/* Runtime statistics counter IDs */
+typedef enum {
+    HEALTH_STAT_FRAMES_RECEIVED = 0,
+    HEALTH_STAT_FRAMES_SENT,
+    HEALTH_STAT_FRAMES_DROPPED,
+    HEALTH_STAT_SPI_ERRORS,
+    HEALTH_STAT_CSI2_ERRORS,
+    HEALTH_STAT_PACKETS_SENT,
+    HEALTH_STAT_BYTES_SENT,
+    HEALTH_STAT_AUTH_FAILURES,
+    HEALTH_STAT_WATCHDOG_RESETS,
+    HEALTH_STAT_COUNT
+} health_stat_t;
+
+#define HEALTH_STAT_THREADS 16
+
 /* Runtime statistics counters */
 typedef struct {
     uint64_t frames_received;
@@ -45,6 +75,16 @@ typedef struct {
     uint64_t watchdog_resets;
 } runtime_stats_t;
 
+/* Collected status fields */
+typedef enum {
+    HEALTH_STATUS_STATE = 0,
+    HEALTH_STATUS_BATTERY,
+    HEALTH_STATUS_FPGA_TEMP,
+    HEALTH_STATUS_FIELD_COUNT
+} health_status_field_t;
+
+#define HEALTH_STATUS_AGE_NONE UINT32_MAX
+
 /* System status for GET_STATUS */
 typedef struct {
     uint8_t state;           /* Current sequence engine state */
@@ -53,8 +93,78 @@ typedef struct {
     uint16_t battery_mv;     /* Battery voltage (mV) */
     uint32_t uptime_sec;     /* Daemon uptime (seconds) */
     uint16_t fpga_temp;      /* FPGA temperature (0.1 C) */
+    uint32_t age_ms[HEALTH_STATUS_FIELD_COUNT]; /* Since each field was read */
 } system_status_t;
 
+/* Status collector configuration (device handles opaque here) */
+typedef struct {
+    void *spi;
+    void *battery;
+    uint32_t state_ms;
+    uint32_t battery_ms;
+    uint32_t temp_ms;
+    int nice;
+} health_status_config_t;
+
+/* Battery gauge metrics (hal/bq40z50_driver.h) */
+typedef struct {
+    uint8_t state_of_charge;
+    uint16_t voltage;
+    int16_t current;
+    uint16_t temperature;
+    uint16_t remaining_capacity;
+    uint16_t full_charge_capacity;
+} battery_metrics_t;
+
+/* Time series metrics */
+typedef enum {
+    HEALTH_METRIC_QA_MEAN = 0,
+    HEALTH_METRIC_QA_NOISE,
+    HEALTH_METRIC_QA_SNR,
+    HEALTH_METRIC_QA_ROW_BANDING,
+    HEALTH_METRIC_QA_COL_BANDING,
+    HEALTH_METRIC_QA_NONUNIFORMITY,
+    HEALTH_METRIC_COUNT
+} health_metric_t;
+
+/* One time series point */
+typedef struct {
+    uint64_t time_ms;
+    float mean;
+    float min;
+    float max;
+    uint32_t samples;
+} health_point_t;
+
+/* Command protocol (protocol/command_protocol.h) */
+#define MAGIC_COMMAND           0xBEEFCAFEu
+#define CMD_GET_STATUS          0x10
+#define STATUS_OK               0x0000
+#define HMAC_SIZE               32
+#define CMD_STATUS_PAYLOAD_LEN  42
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t command_id;
+    uint16_t payload_len;
+    uint8_t hmac[HMAC_SIZE];
+    uint8_t payload[];
+} __attribute__((packed)) command_frame_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t status;
+    uint16_t payload_len;
+    uint8_t hmac[HMAC_SIZE];
+    uint8_t payload[];
+} __attribute__((packed)) response_frame_t;
+
+extern int cmd_protocol_init(const char *hmac_key);
+extern void cmd_protocol_deinit(void);
+extern int cmd_handle_command(const command_frame_t *cmd, uint8_t *resp_buf, size_t *resp_len);
+
 /* Function under test */
 extern int health_monitor_init(void);
 extern void health_monitor_deinit(void);
@@ -62,19 +172,83 @@ extern void health_monitor_pet_watchdog(void);
 extern bool health_monitor_is_alive(void);
 extern void health_monitor_get_stats(runtime_stats_t *stats);
 extern void health_monitor_update_stat(const char *name, int64_t delta);
+extern void health_monitor_add_stat(health_stat_t stat, int64_t delta);
+extern uint64_t health_monitor_read_stat(health_stat_t stat);
+extern const char *health_monitor_stat_name(health_stat_t stat);
 extern void health_monitor_log(log_level_t level, const char *module, const char *format, ...);
 extern int health_monitor_get_status(system_status_t *status);
+extern int health_monitor_start_status(const health_status_config_t *config);
+extern void health_monitor_stop_status(void);
 extern int health_monitor_set_log_level(log_level_t level);
 extern log_level_t health_monitor_get_log_level(void);
+extern int health_monitor_record_metric(health_metric_t metric, float value);
+extern int health_monitor_get_series(health_metric_t metric, health_point_t *points, uint32_t max);
+extern const char *health_monitor_metric_name(health_metric_t metric);
 
 /* Mock functions */
 extern uint64_t mock_get_time_ms(void);
 extern void mock_set_time_ms(uint64_t time_ms);
 extern void mock_syslog_capture(const char *msg);
+extern uint32_t health_stat_blocks_owned(void);
+
+/* Devices read by the status collector */
+#define MOCK_SEQ_STATE_STREAMING 4
+#define MOCK_SPI_ERROR_TRANSFER  (-4)
+
+static atomic_int g_mock_seq_state;
+static atomic_uint g_mock_fpga_temp;
+static atomic_bool g_mock_spi_fail;
+static atomic_int g_mock_spi_reads;
+
+/* Stands in for seq_lock, which the engine may hold across SPI writes */
+static pthread_mutex_t g_mock_seq_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int seq_get_state(void) {
+    pthread_mutex_lock(&g_mock_seq_lock);
+    int state = atomic_load(&g_mock_seq_state);
+    pthread_mutex_unlock(&g_mock_seq_lock);
+    return state;
+}
+
+/* Rest of the sequence engine as the command handler links it */
+static int mock_seq_call(void) {
+    pthread_mutex_lock(&g_mock_seq_lock);
+    pthread_mutex_unlock(&g_mock_seq_lock);
+    return 0;
+}
+
+int seq_init(void) { return mock_seq_call(); }
+void seq_deinit(void) { mock_seq_call(); }
+int seq_start_scan(int mode) { (void)mode; return mock_seq_call(); }
+int seq_stop_scan(void) { return mock_seq_call(); }
+int seq_set_calibration(const void *params) { (void)params; return mock_seq_call(); }
+void health_monitor_reset_stats(void) {}
+
+int spi_read_register(void *spi, uint8_t addr, uint16_t *data) {
+    (void)spi;
+    (void)addr;
+    atomic_fetch_add(&g_mock_spi_reads, 1);
+    if (atomic_load(&g_mock_spi_fail)) {
+        return MOCK_SPI_ERROR_TRANSFER;
+    }
+    *data = (uint16_t)atomic_load(&g_mock_fpga_temp);
+    return 0;
+}
+
+int bq40z50_read_metrics(void *ctx, battery_metrics_t *metrics) {
+    (void)ctx;
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->state_of_charge = 64;
+    metrics->voltage = 3912;
+    return 0;
+}
 
 /* Test configuration */
 #define WATCHDOG_PET_INTERVAL_MS 1000   /* 1 second */
 #define WATCHDOG_TIMEOUT_MS      5000   /* 5 seconds */
+#define HEALTH_SERIES_INTERVAL_MS 1000  /* One point per second */
+#define HEALTH_SERIES_LEN        600    /* Points per metric */
+#define STATUS_RESPONSE_MAX_MS   50     /* REQ-FW-112 */
 
 /* ==========================================================================
  * Watchdog Tests (REQ-FW-060)
@@ -466,10 +640,10 @@ static void test_health_null_parameters(void **state) {
 
     health_monitor_init();
 
-    int result = health_monitor_get_stats(NULL);
-    assert_int_equal(result, -EINVAL);
+    /* No return value: must only not crash */
+    health_monitor_get_stats(NULL);
 
-    result = health_monitor_get_status(NULL);
+    int result = health_monitor_get_status(NULL);
     assert_int_equal(result, -EINVAL);
 
     health_monitor_deinit();
@@ -505,8 +679,8 @@ static void test_health_deinit_without_init(void **state) {
 
 /**
  * @test FW_UT_08_020: Invalid statistic name
- * @pre Unknown statistic name
- * @post Ignores update or returns error
+ * @pre Unknown statistic name; names from health_monitor_stat_name()
+ * @post Ignores the unknown update; returned names update their counter
  */
 static void test_health_invalid_stat_name(void **state) {
     (void)state;
@@ -522,6 +696,12 @@ static void test_health_invalid_stat_name(void **state) {
     /* No valid counter should have changed */
     assert_true(stats_after.frames_received == stats_before.frames_received);
 
+    /* Names map back to their counters; out of range is "unknown" */
+    assert_string_equal(health_monitor_stat_name(HEALTH_STAT_AUTH_FAILURES), "auth_failures");
+    assert_string_equal(health_monitor_stat_name(HEALTH_STAT_COUNT), "unknown");
+    health_monitor_update_stat(health_monitor_stat_name(HEALTH_STAT_CSI2_ERRORS), 4);
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_CSI2_ERRORS), 4);
+
     health_monitor_deinit();
 }
 
@@ -577,6 +757,352 @@ static void test_health_log_filter_debug(void **state) {
     health_monitor_deinit();
 }
 
+/* ==========================================================================
+ * Time Series Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_08_023: Metric time series
+ * @pre Samples 10, 20, 30 within one second, 5 in the next second, then
+ *      one sample per second past the ring length
+ * @post Samples of a second fold into one point (mean/min/max/count);
+ *       the ring keeps the newest HEALTH_SERIES_LEN points oldest first;
+ *       metrics are independent; invalid metrics rejected
+ */
+static void test_health_metric_series(void **state) {
+    (void)state;
+
+    static health_point_t points[HEALTH_SERIES_LEN];
+
+    health_monitor_init();
+
+    mock_set_time_ms(100000);
+    assert_int_equal(health_monitor_record_metric(HEALTH_METRIC_QA_NOISE, 10.0f), 0);
+    mock_set_time_ms(100400);
+    assert_int_equal(health_monitor_record_metric(HEALTH_METRIC_QA_NOISE, 20.0f), 0);
+    mock_set_time_ms(100999);
+    assert_int_equal(health_monitor_record_metric(HEALTH_METRIC_QA_NOISE, 30.0f), 0);
+    mock_set_time_ms(101000);
+    assert_int_equal(health_monitor_record_metric(HEALTH_METRIC_QA_NOISE, 5.0f), 0);
+
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_QA_NOISE, points, 8), 2);
+    assert_int_equal(points[0].time_ms, 100000);
+    assert_int_equal(points[0].samples, 3);
+    assert_float_equal(points[0].mean, 20.0f, 0.001f);
+    assert_float_equal(points[0].min, 10.0f, 0.0f);
+    assert_float_equal(points[0].max, 30.0f, 0.0f);
+    assert_int_equal(points[1].time_ms, 101000);
+    assert_int_equal(points[1].samples, 1);
+
+    /* Only the newest point */
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_QA_NOISE, points, 1), 1);
+    assert_int_equal(points[0].time_ms, 101000);
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_QA_SNR, points, 8), 0);
+
+    /* Wrap the ring */
+    for (uint32_t i = 0; i < HEALTH_SERIES_LEN + 10; i++) {
+        mock_set_time_ms(200000 + (uint64_t)i * HEALTH_SERIES_INTERVAL_MS);
+        health_monitor_record_metric(HEALTH_METRIC_QA_SNR, (float)i);
+    }
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_QA_SNR, points, HEALTH_SERIES_LEN),
+                     HEALTH_SERIES_LEN);
+    assert_float_equal(points[0].mean, 10.0f, 0.0f);
+    assert_float_equal(points[HEALTH_SERIES_LEN - 1].mean, HEALTH_SERIES_LEN + 9.0f, 0.0f);
+
+    assert_int_equal(health_monitor_record_metric(HEALTH_METRIC_COUNT, 1.0f), -EINVAL);
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_COUNT, points, 8), -EINVAL);
+    assert_int_equal(health_monitor_get_series(HEALTH_METRIC_QA_SNR, NULL, 8), -EINVAL);
+    assert_string_equal(health_monitor_metric_name(HEALTH_METRIC_QA_SNR), "qa_snr");
+    assert_string_equal(health_monitor_metric_name(HEALTH_METRIC_COUNT), "unknown");
+
+    mock_set_time_ms(0);
+    health_monitor_deinit();
+}
+
+/* ==========================================================================
+ * Counter Block Tests
+ * ========================================================================== */
+
+#define TEST_STAT_UPDATES   100000
+#define TEST_STAT_WORKERS   (HEALTH_STAT_THREADS + 4)   /* Some share the overflow block */
+
+static void *stat_worker(void *arg) {
+    (void)arg;
+
+    for (uint32_t i = 0; i < TEST_STAT_UPDATES; i++) {
+        health_monitor_add_stat(HEALTH_STAT_FRAMES_SENT, 1);
+        health_monitor_add_stat(HEALTH_STAT_BYTES_SENT, 3);
+    }
+    return NULL;
+}
+
+/**
+ * @test FW_UT_08_024: Per-thread counter blocks
+ * @pre More updating threads than HEALTH_STAT_THREADS, each adding 1 and 3
+ *      to two counters 100000 times; then name and enum updates mixed
+ * @post Totals are exact; name and enum API update the same counter; a
+ *       negative total reads 0; invalid IDs are ignored
+ */
+static void test_health_stat_blocks(void **state) {
+    (void)state;
+
+    pthread_t threads[TEST_STAT_WORKERS];
+
+    health_monitor_init();
+
+    for (uint32_t i = 0; i < TEST_STAT_WORKERS; i++) {
+        assert_int_equal(pthread_create(&threads[i], NULL, stat_worker, NULL), 0);
+    }
+    for (uint32_t i = 0; i < TEST_STAT_WORKERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    runtime_stats_t stats;
+    health_monitor_get_stats(&stats);
+    assert_int_equal(stats.frames_sent, (uint64_t)TEST_STAT_WORKERS * TEST_STAT_UPDATES);
+    assert_int_equal(stats.bytes_sent, (uint64_t)TEST_STAT_WORKERS * TEST_STAT_UPDATES * 3);
+    assert_int_equal(stats.packets_sent, 0);
+
+    health_monitor_update_stat("csi2_errors", 4);
+    health_monitor_add_stat(HEALTH_STAT_CSI2_ERRORS, 2);
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_CSI2_ERRORS), 6);
+
+    health_monitor_add_stat(HEALTH_STAT_AUTH_FAILURES, -5);
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_AUTH_FAILURES), 0);
+
+    health_monitor_add_stat(HEALTH_STAT_COUNT, 1);
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_COUNT), 0);
+
+    /* Re-initialization starts from zero */
+    health_monitor_deinit();
+    health_monitor_init();
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_FRAMES_SENT), 0);
+
+    health_monitor_deinit();
+}
+
+#define TEST_STAT_ROUNDS    3
+
+static pthread_barrier_t g_stat_barrier;
+
+static void *stat_round_worker(void *arg) {
+    (void)arg;
+
+    health_monitor_add_stat(HEALTH_STAT_FRAMES_DROPPED, 1);
+    pthread_barrier_wait(&g_stat_barrier);     /* Every worker holds its block */
+    pthread_barrier_wait(&g_stat_barrier);     /* Checked; exit */
+    return NULL;
+}
+
+/**
+ * @test FW_UT_08_026: Counter blocks return on thread exit
+ * @pre Three rounds of threads, as many as there are free blocks, each
+ *      updating once and staying alive until all have updated
+ * @post Every round owns all HEALTH_STAT_THREADS blocks, so blocks of
+ *       exited threads were handed back; after each join the owned count
+ *       is back where it started; no update is lost across owners
+ */
+static void test_health_stat_block_release(void **state) {
+    (void)state;
+
+    health_monitor_init();
+
+    uint32_t base = health_stat_blocks_owned();
+    uint32_t workers = HEALTH_STAT_THREADS - base;
+    pthread_t threads[HEALTH_STAT_THREADS];
+
+    for (uint32_t round = 0; round < TEST_STAT_ROUNDS; round++) {
+        assert_int_equal(pthread_barrier_init(&g_stat_barrier, NULL, workers + 1), 0);
+        for (uint32_t i = 0; i < workers; i++) {
+            assert_int_equal(pthread_create(&threads[i], NULL, stat_round_worker, NULL), 0);
+        }
+
+        pthread_barrier_wait(&g_stat_barrier);
+        assert_int_equal(health_stat_blocks_owned(), HEALTH_STAT_THREADS);
+        pthread_barrier_wait(&g_stat_barrier);
+
+        for (uint32_t i = 0; i < workers; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        pthread_barrier_destroy(&g_stat_barrier);
+        assert_int_equal(health_stat_blocks_owned(), base);
+    }
+
+    assert_int_equal(health_monitor_read_stat(HEALTH_STAT_FRAMES_DROPPED),
+                     (uint64_t)TEST_STAT_ROUNDS * workers);
+
+    health_monitor_deinit();
+}
+
+/* ==========================================================================
+ * Status Collector Tests (REQ-FW-112)
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_08_025: Status snapshot and freshness
+ * @pre Collector not started, then started with a battery gauge and an
+ *      FPGA temperature of 41.2 C; later the temperature read fails
+ * @post Defaults with no age before the collector; collected values with
+ *       age 0 right after start; a failing read keeps the last value and
+ *       its age grows while the state stays fresh; double start rejected
+ */
+static void test_health_status_collector(void **state) {
+    (void)state;
+
+    int dummy_spi = 0;
+    int dummy_battery = 0;
+    system_status_t status;
+
+    health_monitor_init();
+
+    assert_int_equal(health_monitor_get_status(&status), 0);
+    assert_int_equal(status.battery_soc, 100);
+    assert_int_equal(status.fpga_temp, 350);
+    for (uint32_t i = 0; i < HEALTH_STATUS_FIELD_COUNT; i++) {
+        assert_int_equal(status.age_ms[i], HEALTH_STATUS_AGE_NONE);
+    }
+
+    g_mock_seq_state = MOCK_SEQ_STATE_STREAMING;
+    g_mock_fpga_temp = 412;
+    g_mock_spi_fail = false;
+    mock_set_time_ms(50000);
+
+    health_status_config_t config = {
+        .spi = &dummy_spi, .battery = &dummy_battery,
+        .state_ms = 1, .battery_ms = 1000, .temp_ms = 1
+    };
+    assert_int_equal(health_monitor_start_status(NULL), -EINVAL);
+    assert_int_equal(health_monitor_start_status(&config), 0);
+    assert_int_equal(health_monitor_start_status(&config), -EBUSY);
+
+    /* Read once by start, no device access on the request path */
+    int reads = g_mock_spi_reads;
+    assert_int_equal(health_monitor_get_status(&status), 0);
+    assert_int_equal(status.state, MOCK_SEQ_STATE_STREAMING);
+    assert_int_equal(status.battery_soc, 64);
+    assert_int_equal(status.battery_mv, 3912);
+    assert_int_equal(status.fpga_temp, 412);
+    assert_int_equal(status.age_ms[HEALTH_STATUS_FPGA_TEMP], 0);
+    assert_int_equal(status.age_ms[HEALTH_STATUS_BATTERY], 0);
+
+    /* Temperature read starts failing; state keeps being refreshed */
+    g_mock_spi_fail = true;
+    usleep(20000);
+    mock_set_time_ms(50300);
+    usleep(20000);
+    assert_true(g_mock_spi_reads > reads);
+
+    assert_int_equal(health_monitor_get_status(&status), 0);
+    assert_int_equal(status.fpga_temp, 412);
+    assert_int_equal(status.age_ms[HEALTH_STATUS_FPGA_TEMP], 300);
+    assert_int_equal(status.age_ms[HEALTH_STATUS_STATE], 0);
+
+    health_monitor_stop_status();
+    mock_set_time_ms(0);
+    health_monitor_deinit();
+}
+
+/* GET_STATUS request run off the test thread */
+static atomic_bool g_status_cmd_done;
+static uint8_t g_status_resp[256];
+static int g_status_cmd_result;
+
+static void *status_cmd_worker(void *arg) {
+    const command_frame_t *cmd = (const command_frame_t *)arg;
+    size_t resp_len = sizeof(g_status_resp);
+
+    g_status_cmd_result = cmd_handle_command(cmd, g_status_resp, &resp_len);
+    atomic_store(&g_status_cmd_done, true);
+    return NULL;
+}
+
+/**
+ * @test FW_UT_08_027: GET_STATUS while the sequence engine is locked
+ * @pre Collector running on a STREAMING engine, then seq_lock held (as
+ *      during an FPGA register write) and the clock moved on 40 ms
+ * @post CMD_GET_STATUS answers within STATUS_RESPONSE_MAX_MS without the
+ *       lock, with the snapshot's state, battery, temperature, field ages
+ *       and counters in the documented payload layout
+ */
+static void test_health_get_status_command_unlocked(void **state) {
+    (void)state;
+
+    static const char key[] = "test_key_123456789";
+    int dummy_spi = 0;
+    int dummy_battery = 0;
+
+    health_monitor_init();
+    assert_int_equal(cmd_protocol_init(key), 0);
+
+    g_mock_seq_state = MOCK_SEQ_STATE_STREAMING;
+    g_mock_fpga_temp = 398;
+    g_mock_spi_fail = false;
+    mock_set_time_ms(70000);
+    health_monitor_add_stat(HEALTH_STAT_FRAMES_RECEIVED, 12);
+    health_monitor_add_stat(HEALTH_STAT_CSI2_ERRORS, 2);
+
+    health_status_config_t config = {
+        .spi = &dummy_spi, .battery = &dummy_battery,
+        .state_ms = 1, .battery_ms = 1000, .temp_ms = 1000
+    };
+    assert_int_equal(health_monitor_start_status(&config), 0);
+
+    uint8_t cmd_buf[sizeof(command_frame_t)];
+    command_frame_t *cmd = (command_frame_t *)cmd_buf;
+    memset(cmd_buf, 0, sizeof(cmd_buf));
+    cmd->magic = MAGIC_COMMAND;
+    cmd->sequence = 1;
+    cmd->command_id = CMD_GET_STATUS;
+    unsigned int hmac_len = HMAC_SIZE;
+    HMAC(EVP_sha256(), key, (int)strlen(key), cmd_buf, 12, cmd->hmac, &hmac_len);
+
+    /* Collector parks on the lock before the clock moves */
+    pthread_mutex_lock(&g_mock_seq_lock);
+    usleep(5000);
+    mock_set_time_ms(70040);
+
+    atomic_store(&g_status_cmd_done, false);
+    pthread_t worker;
+    assert_int_equal(pthread_create(&worker, NULL, status_cmd_worker, cmd), 0);
+    for (int i = 0; i < STATUS_RESPONSE_MAX_MS && !atomic_load(&g_status_cmd_done); i++) {
+        usleep(1000);
+    }
+    bool answered = atomic_load(&g_status_cmd_done);
+
+    pthread_mutex_unlock(&g_mock_seq_lock);
+    pthread_join(worker, NULL);
+    assert_true(answered);
+
+    assert_int_equal(g_status_cmd_result, 0);
+    const response_frame_t *resp = (const response_frame_t *)g_status_resp;
+    assert_int_equal(resp->status, STATUS_OK);
+    assert_int_equal(resp->payload_len, CMD_STATUS_PAYLOAD_LEN);
+
+    uint16_t battery_mv;
+    uint16_t fpga_temp;
+    uint32_t age_ms[HEALTH_STATUS_FIELD_COUNT];
+    uint32_t counters[5];
+    memcpy(&battery_mv, &resp->payload[2], sizeof(battery_mv));
+    memcpy(&fpga_temp, &resp->payload[4], sizeof(fpga_temp));
+    memcpy(age_ms, &resp->payload[10], sizeof(age_ms));
+    memcpy(counters, &resp->payload[10 + sizeof(age_ms)], sizeof(counters));
+
+    assert_int_equal(resp->payload[0], MOCK_SEQ_STATE_STREAMING);
+    assert_int_equal(resp->payload[1], 64);
+    assert_int_equal(battery_mv, 3912);
+    assert_int_equal(fpga_temp, 398);
+    assert_int_equal(age_ms[HEALTH_STATUS_STATE], 40);
+    assert_int_equal(age_ms[HEALTH_STATUS_BATTERY], 40);
+    assert_int_equal(age_ms[HEALTH_STATUS_FPGA_TEMP], 40);
+    assert_int_equal(counters[0], 12);      /* Frames received */
+    assert_int_equal(counters[4], 2);       /* CSI-2 errors */
+
+    health_monitor_stop_status();
+    cmd_protocol_deinit();
+    mock_set_time_ms(0);
+    health_monitor_deinit();
+}
+
 /* ==========================================================================
  * Test Runner
  * ========================================================================== */
@@ -616,6 +1142,15 @@ int main(void) {
         /* Log filtering tests */
         cmocka_unit_test(test_health_log_filter_error),
         cmocka_unit_test(test_health_log_filter_debug),
+
+        /* Time series tests */
+        cmocka_unit_test(test_health_metric_series),
+        cmocka_unit_test(test_health_stat_blocks),
+        cmocka_unit_test(test_health_stat_block_release),
+
+        /* Status collector tests */
+        cmocka_unit_test(test_health_status_collector),
+        cmocka_unit_test(test_health_get_status_command_unlocked),
     };
 
     return cmocka_run_group_tests_name("FW-UT-08: Health Monitor Tests",
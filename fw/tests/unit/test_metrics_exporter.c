@@ -0,0 +1,268 @@
+/**
+ * @file test_metrics_exporter.c
+ * @brief Unit tests for the OpenMetrics endpoint (FW-UT-31)
+ *
+ * Test ID: FW-UT-31
+ * Coverage: Text format, histograms, HTTP request handling
+ *
+ * Tests:
+ * - Counters, gauges and labelled samples in OpenMetrics text
+ * - Cumulative histogram buckets in seconds
+ * - GET /metrics over TCP; other paths and methods rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "metrics_exporter.h"
+
+#define RESPONSE_MAX    8192
+
+static metrics_histogram_t g_hist;
+static uint64_t g_frames;
+
+static void collect_basic(metrics_writer_t *writer, void *user_data) {
+    (void)user_data;
+
+    metrics_write_counter(writer, "detector_frames", "Frames received", g_frames);
+    metrics_write_gauge(writer, "detector_temperature_celsius", NULL, 41.5);
+    metrics_write_family(writer, "detector_state", "gauge", "Sequence state");
+    metrics_write_sample(writer, "detector_state", "state", "IDLE", 1);
+    metrics_write_sample(writer, "detector_state", "state", "SCANNING", 0);
+}
+
+static void collect_hist(metrics_writer_t *writer, void *user_data) {
+    (void)user_data;
+    metrics_write_histogram(writer, "detector_latency_seconds", "Latency", &g_hist);
+}
+
+/* Send one request to the running server and read the whole response */
+static size_t http_request(const char *request, char *response) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(metrics_server_port());
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    assert_true(fd >= 0);
+    assert_int_equal(connect(fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    assert_int_equal(send(fd, request, strlen(request), 0), (ssize_t)strlen(request));
+
+    size_t used = 0;
+    ssize_t n;
+    while ((n = recv(fd, response + used, RESPONSE_MAX - 1 - used, 0)) > 0) {
+        used += (size_t)n;
+    }
+    response[used] = '\0';
+    close(fd);
+    return used;
+}
+
+/* ==========================================================================
+ * Format Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_31_001: Counters, gauges and labelled samples
+ * @pre Collect callback writes a counter, a gauge and a two-sample family
+ * @post Text has TYPE/HELP lines, the _total suffix, labels and # EOF;
+ *       a buffer one byte short is rejected
+ */
+static void test_metrics_format(void **state) {
+    (void)state;
+
+    char buf[1024];
+    g_frames = 18446744073709551615ULL;
+
+    int len = metrics_render(collect_basic, NULL, buf, sizeof(buf));
+    assert_true(len > 0);
+    assert_int_equal(len, strlen(buf));
+    assert_string_equal(buf,
+        "# TYPE detector_frames counter\n"
+        "# HELP detector_frames Frames received\n"
+        "detector_frames_total 18446744073709551615\n"
+        "# TYPE detector_temperature_celsius gauge\n"
+        "detector_temperature_celsius 41.5\n"
+        "# TYPE detector_state gauge\n"
+        "# HELP detector_state Sequence state\n"
+        "detector_state{state=\"IDLE\"} 1\n"
+        "detector_state{state=\"SCANNING\"} 0\n"
+        "# EOF\n");
+
+    assert_int_equal(metrics_render(collect_basic, NULL, buf, (size_t)len),
+                     METRICS_ERROR_PARAM);
+    assert_int_equal(metrics_render(collect_basic, NULL, buf, (size_t)len + 1), len);
+}
+
+/**
+ * @test FW_UT_31_002: Histogram
+ * @pre Bounds 1 ms, 10 ms, 100 ms; observations 0.5, 1, 5, 50 and 500 ms
+ * @post Cumulative buckets 2, 3, 4, +Inf 5; count 5; sum 0.5565 s
+ */
+static void test_metrics_histogram(void **state) {
+    (void)state;
+
+    static const uint64_t bounds[] = { 1000000, 10000000, 100000000 };
+    char buf[1024];
+
+    assert_int_equal(metrics_histogram_init(&g_hist, bounds, 3), METRICS_OK);
+    metrics_histogram_observe(&g_hist, 500000);
+    metrics_histogram_observe(&g_hist, 1000000);     /* On the bound: le is inclusive */
+    metrics_histogram_observe(&g_hist, 5000000);
+    metrics_histogram_observe(&g_hist, 50000000);
+    metrics_histogram_observe(&g_hist, 500000000);
+
+    assert_true(metrics_render(collect_hist, NULL, buf, sizeof(buf)) > 0);
+    assert_string_equal(buf,
+        "# TYPE detector_latency_seconds histogram\n"
+        "# HELP detector_latency_seconds Latency\n"
+        "detector_latency_seconds_bucket{le=\"0.001\"} 2\n"
+        "detector_latency_seconds_bucket{le=\"0.01\"} 3\n"
+        "detector_latency_seconds_bucket{le=\"0.1\"} 4\n"
+        "detector_latency_seconds_bucket{le=\"+Inf\"} 5\n"
+        "detector_latency_seconds_count 5\n"
+        "detector_latency_seconds_sum 0.5565\n"
+        "# EOF\n");
+
+    /* Re-init clears the counts */
+    assert_int_equal(metrics_histogram_init(&g_hist, bounds, 1), METRICS_OK);
+    assert_true(metrics_render(collect_hist, NULL, buf, sizeof(buf)) > 0);
+    assert_non_null(strstr(buf, "detector_latency_seconds_bucket{le=\"+Inf\"} 0\n"));
+}
+
+/* ==========================================================================
+ * Server Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_31_003: HTTP endpoint
+ * @pre Server on an ephemeral loopback port
+ * @post GET /metrics returns 200 with the OpenMetrics content type and
+ *       the current values; other paths get 404, other methods 405;
+ *       stop releases the port
+ */
+static void test_metrics_server(void **state) {
+    (void)state;
+
+    static char response[RESPONSE_MAX];
+    metrics_config_t config = {
+        .listen_addr = "127.0.0.1",
+        .port = 0,
+        .collect = collect_basic,
+        .user_data = NULL,
+        .nice = 5
+    };
+
+    g_frames = 42;
+    assert_int_equal(metrics_server_start(&config), METRICS_OK);
+    assert_int_not_equal(metrics_server_port(), 0);
+    assert_int_equal(metrics_server_start(&config), METRICS_ERROR_STATE);
+
+    http_request("GET /metrics HTTP/1.1\r\nHost: localhost\r\nAccept: */*\r\n\r\n", response);
+    assert_true(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0);
+    assert_non_null(strstr(response,
+        "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"));
+    assert_non_null(strstr(response, "\r\n\r\n# TYPE detector_frames counter\n"));
+    assert_non_null(strstr(response, "detector_frames_total 42\n"));
+
+    const char *body = strstr(response, "\r\n\r\n") + 4;
+    unsigned int length = 0;
+    assert_int_equal(sscanf(strstr(response, "Content-Length:"), "Content-Length: %u", &length), 1);
+    assert_int_equal(length, strlen(body));
+    assert_string_equal(body + length - 6, "# EOF\n");
+
+    http_request("GET /metrics?format=x HTTP/1.0\r\n\r\n", response);
+    assert_true(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0);
+    http_request("GET /metricsx HTTP/1.1\r\n\r\n", response);
+    assert_true(strncmp(response, "HTTP/1.1 404 ", 13) == 0);
+    http_request("POST /metrics HTTP/1.1\r\n\r\n", response);
+    assert_true(strncmp(response, "HTTP/1.1 405 ", 13) == 0);
+
+    metrics_server_stats_t stats;
+    assert_int_equal(metrics_server_get_stats(&stats), METRICS_OK);
+    assert_int_equal(stats.scrapes, 2);
+    assert_int_equal(stats.bad_requests, 2);
+    assert_int_equal(stats.last_bytes, length);
+
+    uint16_t port = metrics_server_port();
+    metrics_server_stop();
+    assert_int_equal(metrics_server_port(), 0);
+    metrics_server_stop();
+
+    /* The port is free again */
+    config.port = port;
+    assert_int_equal(metrics_server_start(&config), METRICS_OK);
+    assert_int_equal(metrics_server_port(), port);
+    metrics_server_stop();
+}
+
+/**
+ * @test FW_UT_31_004: Invalid use
+ * @pre NULL arguments, bad listen address, unsorted or too many bounds
+ * @post Each reports its error; no server is left running
+ */
+static void test_metrics_invalid(void **state) {
+    (void)state;
+
+    static const uint64_t unsorted[] = { 10, 10 };
+    uint64_t many[METRICS_HIST_MAX_BUCKETS + 1];
+    char buf[16];
+    metrics_config_t config = { .listen_addr = "localhost", .collect = collect_basic };
+
+    for (uint32_t i = 0; i <= METRICS_HIST_MAX_BUCKETS; i++) {
+        many[i] = i + 1;
+    }
+
+    assert_int_equal(metrics_server_start(NULL), METRICS_ERROR_NULL);
+    assert_int_equal(metrics_server_start(&config), METRICS_ERROR_PARAM);
+    config.collect = NULL;
+    assert_int_equal(metrics_server_start(&config), METRICS_ERROR_NULL);
+    assert_int_equal(metrics_server_port(), 0);
+    assert_int_equal(metrics_server_get_stats(NULL), METRICS_ERROR_NULL);
+
+    assert_int_equal(metrics_histogram_init(NULL, many, 1), METRICS_ERROR_NULL);
+    assert_int_equal(metrics_histogram_init(&g_hist, many, 0), METRICS_ERROR_PARAM);
+    assert_int_equal(metrics_histogram_init(&g_hist, many, METRICS_HIST_MAX_BUCKETS + 1),
+                     METRICS_ERROR_PARAM);
+    assert_int_equal(metrics_histogram_init(&g_hist, many, METRICS_HIST_MAX_BUCKETS), METRICS_OK);
+    assert_int_equal(metrics_histogram_init(&g_hist, unsorted, 2), METRICS_ERROR_PARAM);
+
+    assert_int_equal(metrics_render(NULL, NULL, buf, sizeof(buf)), METRICS_ERROR_NULL);
+    assert_int_equal(metrics_render(collect_basic, NULL, buf, 0), METRICS_ERROR_PARAM);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Format tests */
+        cmocka_unit_test(test_metrics_format),
+        cmocka_unit_test(test_metrics_histogram),
+
+        /* Server tests */
+        cmocka_unit_test(test_metrics_server),
+        cmocka_unit_test(test_metrics_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-31: Metrics Exporter Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,218 @@
+/**
+ * @file test_orientation.c
+ * @brief Unit tests for frame orientation transforms (FW-UT-23)
+ *
+ * Test ID: FW-UT-23
+ * Coverage: Names, output geometry, blocked and in-place transforms
+ *
+ * Tests:
+ * - Names and axis swapping
+ * - Known 3x2 results for every transform
+ * - Blocked transform matches the naive reference (edges, odd sizes)
+ * - In-place frame transform (square tile cycles, flips, scratch path)
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/orientation.h"
+
+#define TEST_MAX_PIXELS (136 * 136)
+
+static uint16_t g_src[TEST_MAX_PIXELS];
+static uint16_t g_out[TEST_MAX_PIXELS];
+static uint16_t g_ref[TEST_MAX_PIXELS];
+
+static void fill_src(size_t pixels, uint32_t seed) {
+    for (size_t i = 0; i < pixels; i++) {
+        g_src[i] = (uint16_t)(cpu_dispatch_random(&seed) >> 16);
+    }
+}
+
+/* ==========================================================================
+ * Transform Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_23_001: Names and geometry
+ * @pre All transforms
+ * @post Names round-trip, the four diagonal transforms swap axes, output
+ *       size follows
+ */
+static void test_orientation_names(void **state) {
+    (void)state;
+
+    assert_string_equal(orientation_name(ORIENT_NONE), "none");
+    assert_string_equal(orientation_name(ORIENT_ROT90), "rot90");
+    assert_string_equal(orientation_name(ORIENT_TRANSVERSE), "transverse");
+    assert_string_equal(orientation_name(ORIENT_COUNT), "unknown");
+
+    assert_false(orientation_swaps_axes(ORIENT_FLIP_H));
+    assert_false(orientation_swaps_axes(ORIENT_ROT180));
+    assert_true(orientation_swaps_axes(ORIENT_ROT90));
+    assert_true(orientation_swaps_axes(ORIENT_ROT270));
+    assert_true(orientation_swaps_axes(ORIENT_TRANSPOSE));
+    assert_true(orientation_swaps_axes(ORIENT_TRANSVERSE));
+
+    orient_config_t config = { .width = 64, .height = 32, .transform = ORIENT_ROT90 };
+    orientation_t *o = orientation_create(&config);
+    assert_non_null(o);
+    uint32_t w = 0, h = 0;
+    orientation_get_output_size(o, &w, &h);
+    assert_int_equal(w, 32);
+    assert_int_equal(h, 64);
+    assert_false(orientation_in_place(o));
+    orientation_destroy(o);
+}
+
+/**
+ * @test FW_UT_23_002: Known results
+ * @pre 3x2 input  1 2 3 / 4 5 6
+ * @post Each transform gives the expected image
+ */
+static void test_orientation_known(void **state) {
+    (void)state;
+
+    static const uint16_t in[6] = { 1, 2, 3, 4, 5, 6 };
+    static const uint16_t expected[ORIENT_COUNT][6] = {
+        [ORIENT_NONE] = { 1, 2, 3, 4, 5, 6 },
+        [ORIENT_FLIP_H] = { 3, 2, 1, 6, 5, 4 },
+        [ORIENT_FLIP_V] = { 4, 5, 6, 1, 2, 3 },
+        [ORIENT_ROT90] = { 4, 1, 5, 2, 6, 3 },
+        [ORIENT_ROT180] = { 6, 5, 4, 3, 2, 1 },
+        [ORIENT_ROT270] = { 3, 6, 2, 5, 1, 4 },
+        [ORIENT_TRANSPOSE] = { 1, 4, 2, 5, 3, 6 },
+        [ORIENT_TRANSVERSE] = { 6, 3, 5, 2, 4, 1 },
+    };
+    uint16_t out[6];
+
+    for (int t = 0; t < ORIENT_COUNT; t++) {
+        assert_int_equal(orientation_transform_naive((orient_t)t, out, in, 3, 2), ORIENT_OK);
+        assert_memory_equal(out, expected[t], sizeof(out));
+        assert_int_equal(orientation_transform((orient_t)t, out, in, 3, 2), ORIENT_OK);
+        assert_memory_equal(out, expected[t], sizeof(out));
+    }
+}
+
+/**
+ * @test FW_UT_23_003: Blocked transform matches reference
+ * @pre Sizes with and without whole tiles and blocks
+ * @post orientation_transform() equals the naive transform for all
+ */
+static void test_orientation_blocked(void **state) {
+    (void)state;
+
+    static const uint32_t sizes[][2] = {
+        { 64, 64 }, { 136, 72 }, { 72, 136 }, { 131, 67 }, { 7, 5 }, { 1, 9 }
+    };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint32_t w = sizes[s][0], h = sizes[s][1];
+        size_t bytes = (size_t)w * h * sizeof(uint16_t);
+        fill_src((size_t)w * h, (uint32_t)s + 1);
+
+        for (int t = 0; t < ORIENT_COUNT; t++) {
+            memset(g_out, 0, bytes);
+            assert_int_equal(orientation_transform_naive((orient_t)t, g_ref, g_src, w, h),
+                             ORIENT_OK);
+            assert_int_equal(orientation_transform((orient_t)t, g_out, g_src, w, h), ORIENT_OK);
+            assert_memory_equal(g_out, g_ref, bytes);
+        }
+    }
+}
+
+/**
+ * @test FW_UT_23_004: In-place frame transform
+ * @pre Square multiple-of-8 frame (tile cycles), odd square and
+ *      rectangular frames (scratch), flips with odd heights
+ * @post orientation_apply_frame() equals the naive transform
+ */
+static void test_orientation_in_place(void **state) {
+    (void)state;
+
+    static const struct {
+        uint32_t w, h;
+        bool square_in_place;
+    } cases[] = {
+        { 136, 136, true }, { 8, 8, true }, { 131, 131, false }, { 136, 72, false }, { 40, 33, false }
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint32_t w = cases[c].w, h = cases[c].h;
+        size_t bytes = (size_t)w * h * sizeof(uint16_t);
+
+        for (int t = 0; t < ORIENT_COUNT; t++) {
+            orient_config_t config = { .width = w, .height = h, .transform = (orient_t)t };
+            orientation_t *o = orientation_create(&config);
+            assert_non_null(o);
+
+            bool expect_in_place = !orientation_swaps_axes((orient_t)t) ||
+                                   cases[c].square_in_place;
+            assert_int_equal(orientation_in_place(o), expect_in_place);
+
+            fill_src((size_t)w * h, (uint32_t)(c * 16 + t));
+            memcpy(g_out, g_src, bytes);
+            assert_int_equal(orientation_transform_naive((orient_t)t, g_ref, g_src, w, h),
+                             ORIENT_OK);
+
+            /* Twice, so reused scratch and tile bitmap state is covered */
+            assert_int_equal(orientation_apply_frame(o, g_out), ORIENT_OK);
+            assert_memory_equal(g_out, g_ref, bytes);
+            memcpy(g_out, g_src, bytes);
+            assert_int_equal(orientation_apply_frame(o, g_out), ORIENT_OK);
+            assert_memory_equal(g_out, g_ref, bytes);
+
+            orientation_destroy(o);
+        }
+    }
+}
+
+/**
+ * @test FW_UT_23_005: Invalid parameters
+ * @pre NULL pointers, zero sizes, unknown transform
+ * @post Errors returned, create fails
+ */
+static void test_orientation_invalid(void **state) {
+    (void)state;
+
+    orient_config_t config = { .width = 0, .height = 8, .transform = ORIENT_ROT90 };
+    assert_null(orientation_create(&config));
+    config.width = 8;
+    config.transform = ORIENT_COUNT;
+    assert_null(orientation_create(&config));
+    assert_null(orientation_create(NULL));
+
+    assert_int_equal(orientation_apply_frame(NULL, g_out), ORIENT_ERROR_NULL);
+    assert_int_equal(orientation_transform(ORIENT_ROT90, NULL, g_src, 8, 8), ORIENT_ERROR_NULL);
+    assert_int_equal(orientation_transform(ORIENT_COUNT, g_out, g_src, 8, 8), ORIENT_ERROR_PARAM);
+    assert_int_equal(orientation_transform(ORIENT_ROT90, g_out, g_src, 0, 8), ORIENT_ERROR_PARAM);
+
+    orientation_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Transform tests */
+        cmocka_unit_test(test_orientation_names),
+        cmocka_unit_test(test_orientation_known),
+        cmocka_unit_test(test_orientation_blocked),
+        cmocka_unit_test(test_orientation_in_place),
+        cmocka_unit_test(test_orientation_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-23: Orientation Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,645 @@
+/**
+ * @file test_pipeline.c
+ * @brief Unit tests for frame processing pipeline (FW-UT-19)
+ *
+ * Test ID: FW-UT-19
+ * Coverage: Stage registry, per-mode pipeline build, queues and metrics
+ *
+ * Tests:
+ * - Registry validation (names, duplicates, capacity)
+ * - Pipeline build validation (unknown stage, stage count)
+ * - Stage order and in-order release across stage threads
+ * - Consumed and rejected frames skip later stages
+ * - Back-pressure, metrics and drain on destroy
+ * - Band stages: staged band walk, fused grouping and interleaving
+ * - Per-frame metadata zeroed at submit, visible until release
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "proc/pipeline.h"
+
+#define TEST_FRAMES     50
+
+/**
+ * @brief Shared record of what the stages and release callback saw
+ */
+typedef struct {
+    uint32_t seen[3][TEST_FRAMES];      /* Stage -> frame numbers in order */
+    uint32_t seen_count[3];
+    uint32_t released[TEST_FRAMES];
+    int released_status[TEST_FRAMES];
+    uint32_t released_count;
+    uint32_t sleep_us;                  /* Stage 0 processing time */
+} test_log_t;
+
+static test_log_t test_log;
+
+static void test_sleep_us(uint32_t us) {
+    struct timespec ts = { .tv_sec = 0, .tv_nsec = (long)us * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+static int record_stage(uint32_t id, pipe_frame_t *frame) {
+    test_log.seen[id][test_log.seen_count[id]++] = frame->frame_number;
+    return PIPE_CONTINUE;
+}
+
+static int stage_a(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    if (test_log.sleep_us > 0) {
+        test_sleep_us(test_log.sleep_us);
+    }
+    frame->flags |= 1U;
+    return record_stage(0, frame);
+}
+
+static int stage_b(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    /* Flags set by stage a are visible here */
+    if ((frame->flags & 1U) == 0) {
+        return -1;
+    }
+    return record_stage(1, frame);
+}
+
+static int stage_c(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    return record_stage(2, frame);
+}
+
+/* Even frames consumed, frames divisible by 3 (odd) rejected */
+static int stage_filter(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    record_stage(0, frame);
+    if (frame->frame_number % 2 == 0) {
+        return PIPE_CONSUMED;
+    }
+    if (frame->frame_number % 3 == 0) {
+        return -5;
+    }
+    return PIPE_CONTINUE;
+}
+
+static void record_release(const pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    test_log.released_status[test_log.released_count] = frame->status;
+    test_log.released[test_log.released_count++] = frame->frame_number;
+}
+
+static pipe_registry_t *test_registry(void) {
+    pipe_registry_t *reg = pipeline_registry_create();
+    assert_non_null(reg);
+    assert_int_equal(pipeline_register_stage(reg, "a", stage_a, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_stage(reg, "b", stage_b, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_stage(reg, "c", stage_c, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_stage(reg, "filter", stage_filter, NULL), PIPE_OK);
+    return reg;
+}
+
+/**
+ * @brief Submit frames 0..count-1, retrying while the pipeline is full
+ */
+static void submit_all(pipeline_t *pipe, uint32_t count) {
+    static uint16_t pixels[16];
+
+    for (uint32_t n = 0; n < count; n++) {
+        pipe_frame_t frame = {
+            .data = pixels,
+            .size = sizeof(pixels),
+            .frame_number = n,
+            .width = 4,
+            .height = 4
+        };
+        while (pipeline_submit(pipe, &frame) == PIPE_ERROR_FULL) {
+            test_sleep_us(100);
+        }
+    }
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_19_001: Registry validation
+ * @pre Empty, over-long and duplicate names; 16 + 1 registrations
+ * @post Errors reported; registered names found, others not
+ */
+static void test_pipe_registry(void **state) {
+    (void)state;
+
+    pipe_registry_t *reg = pipeline_registry_create();
+    assert_non_null(reg);
+
+    assert_int_equal(pipeline_register_stage(NULL, "a", stage_a, NULL), PIPE_ERROR_NULL);
+    assert_int_equal(pipeline_register_stage(reg, "a", NULL, NULL), PIPE_ERROR_NULL);
+    assert_int_equal(pipeline_register_stage(reg, "", stage_a, NULL), PIPE_ERROR_PARAM);
+    assert_int_equal(pipeline_register_stage(reg, "sixteen_chars_xx", stage_a, NULL),
+                     PIPE_ERROR_PARAM);
+
+    char name[8];
+    for (int i = 0; i < PIPE_MAX_STAGE_TYPES; i++) {
+        snprintf(name, sizeof(name), "s%d", i);
+        assert_int_equal(pipeline_register_stage(reg, name, stage_a, NULL), PIPE_OK);
+    }
+    assert_int_equal(pipeline_register_stage(reg, "s3", stage_b, NULL), PIPE_ERROR_EXISTS);
+    assert_int_equal(pipeline_register_stage(reg, "extra", stage_a, NULL), PIPE_ERROR_FULL);
+
+    assert_true(pipeline_registry_has(reg, "s15"));
+    assert_false(pipeline_registry_has(reg, "extra"));
+    assert_false(pipeline_registry_has(NULL, "s0"));
+
+    pipeline_registry_destroy(reg);
+    pipeline_registry_destroy(NULL);
+}
+
+/**
+ * @test FW_UT_19_002: Pipeline build validation
+ * @pre Unknown stage, no stages, more than PIPE_MAX_STAGES stages
+ * @post pipeline_create returns NULL
+ */
+static void test_pipe_create_invalid(void **state) {
+    (void)state;
+
+    pipe_registry_t *reg = test_registry();
+    const char *unknown[] = { "a", "binning" };
+    const char *many[PIPE_MAX_STAGES + 1];
+    for (int i = 0; i <= PIPE_MAX_STAGES; i++) {
+        many[i] = "a";
+    }
+
+    pipe_config_t config = { .registry = reg, .stages = unknown, .stage_count = 2 };
+    assert_null(pipeline_create(&config));
+
+    config.stages = many;
+    config.stage_count = 0;
+    assert_null(pipeline_create(&config));
+
+    config.stage_count = PIPE_MAX_STAGES + 1;
+    assert_null(pipeline_create(&config));
+
+    config.registry = NULL;
+    config.stage_count = 1;
+    assert_null(pipeline_create(&config));
+    assert_null(pipeline_create(NULL));
+
+    pipeline_registry_destroy(reg);
+}
+
+/* ==========================================================================
+ * Execution Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_19_003: Stages run in order, frames released in order
+ * @pre Pipeline a -> b -> c, queue depth 4, 50 frames
+ * @post Every stage saw frames 0..49 in order, flags travelled with the
+ *       frame, releases in submit order, metrics count 50 per stage
+ */
+static void test_pipe_order(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    pipe_registry_t *reg = test_registry();
+    const char *chain[] = { "a", "b", "c" };
+    pipe_config_t config = {
+        .registry = reg,
+        .stages = chain,
+        .stage_count = 3,
+        .queue_depth = 4,
+        .release = record_release
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+
+    submit_all(pipe, TEST_FRAMES);
+    assert_true(pipeline_drain(pipe, 2000));
+
+    for (int s = 0; s < 3; s++) {
+        assert_int_equal(test_log.seen_count[s], TEST_FRAMES);
+        for (uint32_t n = 0; n < TEST_FRAMES; n++) {
+            assert_int_equal(test_log.seen[s][n], n);
+        }
+    }
+    assert_int_equal(test_log.released_count, TEST_FRAMES);
+    for (uint32_t n = 0; n < TEST_FRAMES; n++) {
+        assert_int_equal(test_log.released[n], n);
+        assert_int_equal(test_log.released_status[n], PIPE_CONTINUE);
+    }
+
+    pipe_stage_stats_t st;
+    assert_int_equal(pipeline_get_stage_stats(pipe, 1, &st), PIPE_OK);
+    assert_string_equal(st.name, "b");
+    assert_int_equal(st.frames, TEST_FRAMES);
+    assert_int_equal(st.errors, 0);
+    assert_true(st.max_us >= st.last_us);
+    assert_int_equal(pipeline_get_stage_stats(pipe, 3, &st), PIPE_ERROR_PARAM);
+
+    pipe_stats_t stats;
+    pipeline_get_stats(pipe, &stats);
+    assert_int_equal(stats.stages, 3);
+    assert_int_equal(stats.completed, TEST_FRAMES);
+    assert_int_equal(stats.in_flight, 0);
+
+    pipeline_destroy(pipe);
+    pipeline_registry_destroy(reg);
+}
+
+/**
+ * @test FW_UT_19_004: Consumed and rejected frames skip later stages
+ * @pre Pipeline filter -> c; even frames consumed, odd multiples of 3 rejected
+ * @post Stage c only sees the remaining frames; all frames released in
+ *       order with their final status; counters match
+ */
+static void test_pipe_consume_reject(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    pipe_registry_t *reg = test_registry();
+    const char *chain[] = { "filter", "c" };
+    pipe_config_t config = {
+        .registry = reg,
+        .stages = chain,
+        .stage_count = 2,
+        .release = record_release
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+
+    submit_all(pipe, 12);
+    assert_true(pipeline_drain(pipe, 2000));
+
+    /* 1, 5, 7, 11 pass; 3, 9 rejected; evens consumed */
+    assert_int_equal(test_log.seen_count[2], 4);
+    assert_int_equal(test_log.seen[2][0], 1);
+    assert_int_equal(test_log.seen[2][3], 11);
+
+    assert_int_equal(test_log.released_count, 12);
+    assert_int_equal(test_log.released_status[2], PIPE_CONSUMED);
+    assert_int_equal(test_log.released_status[3], -5);
+    assert_int_equal(test_log.released_status[5], PIPE_CONTINUE);
+
+    pipe_stage_stats_t st;
+    pipeline_get_stage_stats(pipe, 0, &st);
+    assert_int_equal(st.frames, 12);
+    assert_int_equal(st.consumed, 6);
+    assert_int_equal(st.errors, 2);
+
+    pipeline_destroy(pipe);
+    pipeline_registry_destroy(reg);
+}
+
+/**
+ * @test FW_UT_19_005: Back-pressure and drain on destroy
+ * @pre a -> b, queue depth 2, stage a takes 20 ms per frame
+ * @post Third immediate submit is refused and counted as dropped;
+ *       destroy without drain still releases both accepted frames
+ */
+static void test_pipe_backpressure(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    test_log.sleep_us = 20000;
+
+    pipe_registry_t *reg = test_registry();
+    const char *chain[] = { "a", "b" };
+    pipe_config_t config = {
+        .registry = reg,
+        .stages = chain,
+        .stage_count = 2,
+        .queue_depth = 2,
+        .release = record_release
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+
+    static uint16_t pixels[16];
+    pipe_frame_t frame = { .data = pixels, .size = sizeof(pixels), .width = 4, .height = 4 };
+    assert_int_equal(pipeline_submit(pipe, &frame), PIPE_OK);
+    frame.frame_number = 1;
+    assert_int_equal(pipeline_submit(pipe, &frame), PIPE_OK);
+    frame.frame_number = 2;
+    assert_int_equal(pipeline_submit(pipe, &frame), PIPE_ERROR_FULL);
+
+    pipe_stats_t stats;
+    pipeline_get_stats(pipe, &stats);
+    assert_int_equal(stats.submitted, 2);
+    assert_int_equal(stats.dropped, 1);
+
+    pipeline_destroy(pipe);
+    assert_int_equal(test_log.released_count, 2);
+    assert_int_equal(test_log.released[1], 1);
+
+    pipeline_registry_destroy(reg);
+}
+
+/* ==========================================================================
+ * Band Execution Tests
+ * ========================================================================== */
+
+#define BAND_FRAMES     3
+#define BAND_LOG_LEN    64
+
+/**
+ * @brief Event log of the band stages, one string per frame
+ */
+static char band_log[BAND_FRAMES][BAND_LOG_LEN];
+
+static void band_event(const pipe_frame_t *frame, const char *tag, uint32_t row) {
+    char *log = band_log[frame->frame_number];
+    size_t len = strlen(log);
+    snprintf(log + len, BAND_LOG_LEN - len, "%s%u ", tag, row);
+}
+
+static void band_x_begin(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    band_event(frame, "Bx", 0);
+}
+
+static void band_x_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                        void *user_data) {
+    (void)user_data;
+    (void)row_count;
+    band_event(frame, "x", row_start);
+}
+
+static void band_y_rows(pipe_frame_t *frame, uint32_t row_start, uint32_t row_count,
+                        void *user_data) {
+    (void)user_data;
+    band_event(frame, "y", row_start + row_count);
+}
+
+/* Frame 1 rejected at the end of y */
+static int band_y_end(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    band_event(frame, "Ey", 0);
+    return (frame->frame_number == 1) ? -3 : PIPE_CONTINUE;
+}
+
+static pipe_registry_t *band_registry(void) {
+    static const pipe_band_ops_t x_ops = {
+        .begin = band_x_begin, .rows = band_x_rows, .lag_rows = 3
+    };
+    static const pipe_band_ops_t y_ops = { .rows = band_y_rows, .end = band_y_end };
+    static const pipe_band_ops_t no_rows = { .begin = band_x_begin };
+
+    pipe_registry_t *reg = test_registry();
+    assert_int_equal(pipeline_register_band_stage(reg, "x", NULL, &x_ops, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_band_stage(reg, "y", stage_c, &y_ops, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_band_stage(reg, "z", stage_c, &no_rows, NULL),
+                     PIPE_ERROR_NULL);
+    assert_int_equal(pipeline_register_band_stage(reg, "z", stage_c, NULL, NULL),
+                     PIPE_ERROR_NULL);
+    return reg;
+}
+
+static void submit_band_frames(pipeline_t *pipe) {
+    static uint16_t pixels[8 * 8];
+
+    for (uint32_t n = 0; n < BAND_FRAMES; n++) {
+        pipe_frame_t frame = {
+            .data = pixels, .size = sizeof(pixels),
+            .frame_number = n, .width = 8, .height = 8
+        };
+        while (pipeline_submit(pipe, &frame) == PIPE_ERROR_FULL) {
+            test_sleep_us(100);
+        }
+    }
+    assert_true(pipeline_drain(pipe, 2000));
+}
+
+/**
+ * @test FW_UT_19_006: Staged execution of band stages
+ * @pre Chain x -> c, x has band operations only, 8-row frames, 3-row bands
+ * @post x walks bands 0, 3, 6 after its begin; c runs as its own stage
+ */
+static void test_pipe_band_staged(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    memset(band_log, 0, sizeof(band_log));
+    pipe_registry_t *reg = band_registry();
+    const char *chain[] = { "x", "c" };
+    pipe_config_t config = {
+        .registry = reg, .stages = chain, .stage_count = 2, .band_rows = 3
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+    submit_band_frames(pipe);
+
+    assert_string_equal(band_log[0], "Bx0 x0 x3 x6 ");
+    assert_string_equal(band_log[2], "Bx0 x0 x3 x6 ");
+    assert_int_equal(test_log.seen_count[2], BAND_FRAMES);
+
+    pipe_stats_t stats;
+    pipeline_get_stats(pipe, &stats);
+    assert_int_equal(stats.stages, 2);
+
+    pipeline_destroy(pipe);
+    pipeline_registry_destroy(reg);
+}
+
+/**
+ * @test FW_UT_19_007: Fused execution of consecutive band stages
+ * @pre Chain x -> y -> c fused, 8-row frames, 4-row bands, x lags 3 rows;
+ *      y rejects frame 1
+ * @post x and y share one stage named "x+y" and alternate per band with y
+ *       3 rows behind x until the last band, then end in order; c is
+ *       separate and skips the rejected frame
+ */
+static void test_pipe_band_fused(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    memset(band_log, 0, sizeof(band_log));
+    pipe_registry_t *reg = band_registry();
+    const char *chain[] = { "x", "y", "c" };
+    pipe_config_t config = {
+        .registry = reg, .stages = chain, .stage_count = 3,
+        .exec = PIPE_EXEC_FUSED, .band_rows = 4,
+        .release = record_release
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+    submit_band_frames(pipe);
+
+    assert_string_equal(band_log[0], "Bx0 x0 y1 x4 y8 Ey0 ");
+    assert_string_equal(band_log[1], "Bx0 x0 y1 x4 y8 Ey0 ");
+
+    pipe_stats_t stats;
+    pipeline_get_stats(pipe, &stats);
+    assert_int_equal(stats.stages, 2);
+
+    pipe_stage_stats_t st;
+    assert_int_equal(pipeline_get_stage_stats(pipe, 0, &st), PIPE_OK);
+    assert_string_equal(st.name, "x+y");
+    assert_int_equal(st.frames, BAND_FRAMES);
+    assert_int_equal(st.errors, 1);
+    assert_int_equal(pipeline_get_stage_stats(pipe, 1, &st), PIPE_OK);
+    assert_string_equal(st.name, "c");
+
+    assert_int_equal(test_log.seen_count[2], BAND_FRAMES - 1);
+    assert_int_equal(test_log.released_count, BAND_FRAMES);
+    assert_int_equal(test_log.released_status[1], -3);
+
+    pipeline_destroy(pipe);
+
+    /* Invalid execution mode */
+    config.exec = (pipe_exec_t)(PIPE_EXEC_FUSED + 1);
+    assert_null(pipeline_create(&config));
+
+    pipeline_registry_destroy(reg);
+}
+
+/* ==========================================================================
+ * Metadata Tests
+ * ========================================================================== */
+
+/* Metadata written by the first stage, checked by the second and release */
+typedef struct {
+    uint32_t tag;
+    uint32_t stages;
+} test_meta_t;
+
+static uint32_t meta_dirty;     /* Frames whose metadata was not zeroed */
+static uint32_t meta_mismatch;  /* Frames whose metadata did not travel */
+
+static int stage_meta_write(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    test_meta_t *meta = (test_meta_t *)frame->meta;
+    if (meta->tag != 0 || meta->stages != 0) {
+        meta_dirty++;
+    }
+    meta->tag = frame->frame_number + 1;
+    meta->stages = 1;
+    return PIPE_CONTINUE;
+}
+
+static int stage_meta_read(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    ((test_meta_t *)frame->meta)->stages++;
+    return PIPE_CONTINUE;
+}
+
+static int stage_meta_none(pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    if (frame->meta != NULL) {
+        meta_mismatch++;
+    }
+    return PIPE_CONTINUE;
+}
+
+static void release_meta(const pipe_frame_t *frame, void *user_data) {
+    (void)user_data;
+    const test_meta_t *meta = (const test_meta_t *)frame->meta;
+    if (meta->tag != frame->frame_number + 1 || meta->stages != 2) {
+        meta_mismatch++;
+    }
+    record_release(frame, NULL);
+}
+
+/**
+ * @test FW_UT_19_008: Per-frame metadata
+ * @pre Chain w -> r with meta_size = sizeof(test_meta_t), queue depth 2,
+ *      50 frames; then the same chain without metadata
+ * @post Every frame starts with zeroed metadata although slots are reused,
+ *       stage writes reach later stages and the release callback; with
+ *       meta_size 0 frame->meta is NULL
+ */
+static void test_pipe_meta(void **state) {
+    (void)state;
+
+    memset(&test_log, 0, sizeof(test_log));
+    meta_dirty = 0;
+    meta_mismatch = 0;
+
+    pipe_registry_t *reg = pipeline_registry_create();
+    assert_non_null(reg);
+    assert_int_equal(pipeline_register_stage(reg, "w", stage_meta_write, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_stage(reg, "r", stage_meta_read, NULL), PIPE_OK);
+    assert_int_equal(pipeline_register_stage(reg, "n", stage_meta_none, NULL), PIPE_OK);
+
+    const char *chain[] = { "w", "r" };
+    pipe_config_t config = {
+        .registry = reg, .stages = chain, .stage_count = 2, .queue_depth = 2,
+        .release = release_meta, .meta_size = sizeof(test_meta_t)
+    };
+
+    pipeline_t *pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+    submit_all(pipe, TEST_FRAMES);
+    assert_true(pipeline_drain(pipe, 2000));
+    pipeline_destroy(pipe);
+
+    assert_int_equal(test_log.released_count, TEST_FRAMES);
+    assert_int_equal(meta_dirty, 0);
+    assert_int_equal(meta_mismatch, 0);
+
+    /* No metadata requested: the submitter's pointer is not passed on */
+    static test_meta_t foreign;
+    const char *plain[] = { "n" };
+    config = (pipe_config_t){ .registry = reg, .stages = plain, .stage_count = 1,
+                              .queue_depth = 2, .release = record_release };
+    memset(&test_log, 0, sizeof(test_log));
+    pipe = pipeline_create(&config);
+    assert_non_null(pipe);
+
+    static uint16_t pixels[16];
+    pipe_frame_t frame = { .data = pixels, .size = sizeof(pixels), .width = 4, .height = 4,
+                           .meta = &foreign };
+    assert_int_equal(pipeline_submit(pipe, &frame), PIPE_OK);
+    assert_true(pipeline_drain(pipe, 2000));
+    assert_int_equal(test_log.released_count, 1);
+    assert_int_equal(meta_mismatch, 0);
+    pipeline_destroy(pipe);
+
+    pipeline_registry_destroy(reg);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_pipe_registry),
+        cmocka_unit_test(test_pipe_create_invalid),
+
+        /* Execution tests */
+        cmocka_unit_test(test_pipe_order),
+        cmocka_unit_test(test_pipe_consume_reject),
+        cmocka_unit_test(test_pipe_backpressure),
+
+        /* Band execution tests */
+        cmocka_unit_test(test_pipe_band_staged),
+        cmocka_unit_test(test_pipe_band_fused),
+
+        /* Metadata tests */
+        cmocka_unit_test(test_pipe_meta),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-19: Processing Pipeline Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,327 @@
+/**
+ * @file test_pixel_drift.c
+ * @brief Unit tests for per-pixel drift tracking (FW-UT-25)
+ *
+ * Test ID: FW-UT-25
+ * Coverage: Fixed-point Welford statistics, baseline and thresholds,
+ *           per-frame pixel budget, background worker, dark gating,
+ *           candidate paging
+ *
+ * Tests:
+ * - Noisy and drifting pixels flagged, quiet pixels not
+ * - One block per frame, sweeps counted
+ * - Worker and inline updates give the same candidates
+ * - Blocks above the dark level skipped
+ * - Candidate list paged in pixel order
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/pixel_drift.h"
+
+#define TEST_WIDTH          64
+#define TEST_HEIGHT         64
+#define TEST_PIXELS         (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_DARK           1000
+#define TEST_NOISY_X        5
+#define TEST_NOISY_Y        7
+#define TEST_DRIFT_X        40
+#define TEST_DRIFT_Y        20
+
+static uint16_t g_frame[TEST_PIXELS];
+static drift_candidate_t g_cands[2][TEST_PIXELS];
+
+/**
+ * @brief Dark frame with +-2 counts of noise, one pixel alternating
+ *        +-10 counts and one pixel offset by drift counts
+ */
+static void fill_dark(uint32_t frame, uint16_t drift, uint32_t *seed) {
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_frame[i] = (uint16_t)(TEST_DARK - 2 + cpu_dispatch_random(seed) % 5);
+    }
+    g_frame[TEST_NOISY_Y * TEST_WIDTH + TEST_NOISY_X] = (frame & 1) ? TEST_DARK + 10 : TEST_DARK - 10;
+    g_frame[TEST_DRIFT_Y * TEST_WIDTH + TEST_DRIFT_X] = (uint16_t)(TEST_DARK + drift);
+}
+
+/* ==========================================================================
+ * Statistics Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_25_001: Noise and offset drift
+ * @pre 16-frame memory, noise limit 5, offset limit 20; one pixel with 10
+ *      counts RMS noise, one pixel stepping up by 100 counts after the
+ *      baseline
+ * @post Noisy pixel flagged with noise ~10 before the step, drifting pixel
+ *       flagged with its baseline and new mean once the step has left the
+ *       noise estimate, nothing else
+ */
+static void test_drift_noise_and_offset(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                              .pixels_per_frame = TEST_PIXELS, .weight_shift = 4,
+                              .offset_threshold = 20, .noise_threshold = 5 };
+    pixel_drift_t *drift = pixel_drift_create(&config);
+    assert_non_null(drift);
+
+    uint32_t seed = 3;
+    uint32_t frame = 0;
+    for (; frame < 40; frame++) {
+        fill_dark(frame, 0, &seed);
+        assert_int_equal(pixel_drift_submit(drift, g_frame), DRIFT_OK);
+    }
+
+    uint32_t next;
+    size_t n = pixel_drift_get_candidates(drift, 0, g_cands[0], TEST_PIXELS, &next);
+    assert_int_equal(n, 1);
+    assert_int_equal(next, TEST_PIXELS);
+    assert_int_equal(g_cands[0][0].x, TEST_NOISY_X);
+    assert_int_equal(g_cands[0][0].y, TEST_NOISY_Y);
+    assert_int_equal(g_cands[0][0].flags, DRIFT_FLAG_NOISE);
+    assert_in_range(g_cands[0][0].noise, 9, 11);
+    assert_in_range(g_cands[0][0].mean, TEST_DARK - 5, TEST_DARK + 5);
+
+    for (; frame < 240; frame++) {
+        fill_dark(frame, 100, &seed);
+        assert_int_equal(pixel_drift_submit(drift, g_frame), DRIFT_OK);
+    }
+
+    n = pixel_drift_get_candidates(drift, 0, g_cands[0], TEST_PIXELS, NULL);
+    assert_int_equal(n, 2);
+    assert_int_equal(g_cands[0][1].x, TEST_DRIFT_X);
+    assert_int_equal(g_cands[0][1].y, TEST_DRIFT_Y);
+    assert_int_equal(g_cands[0][1].flags, DRIFT_FLAG_OFFSET);
+    assert_in_range(g_cands[0][1].baseline, TEST_DARK - 2, TEST_DARK + 2);
+    assert_in_range(g_cands[0][1].mean, TEST_DARK + 98, TEST_DARK + 100);
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(drift, &stats);
+    assert_int_equal(stats.candidates, 2);
+
+    /* Reset relearns the baseline: the offset is the new normal */
+    pixel_drift_reset(drift);
+    for (frame = 0; frame < 40; frame++) {
+        fill_dark(frame, 100, &seed);
+        pixel_drift_submit(drift, g_frame);
+    }
+    n = pixel_drift_get_candidates(drift, 0, g_cands[0], TEST_PIXELS, NULL);
+    assert_int_equal(n, 1);
+    assert_int_equal(g_cands[0][0].flags, DRIFT_FLAG_NOISE);
+
+    pixel_drift_destroy(drift);
+}
+
+/**
+ * @test FW_UT_25_002: Pixel budget
+ * @pre 1000 pixels per frame on a 4096-pixel frame
+ * @post 5 blocks; a sweep completes every 5 frames
+ */
+static void test_drift_pixel_budget(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                              .pixels_per_frame = 1000 };
+    pixel_drift_t *drift = pixel_drift_create(&config);
+    assert_non_null(drift);
+
+    uint32_t seed = 5;
+    drift_stats_t stats;
+    for (uint32_t frame = 0; frame < 14; frame++) {
+        fill_dark(frame, 0, &seed);
+        assert_int_equal(pixel_drift_submit(drift, g_frame), DRIFT_OK);
+
+        pixel_drift_get_stats(drift, &stats);
+        assert_int_equal(stats.processed, frame + 1);
+        assert_int_equal(stats.sweeps, (frame + 1) / 5);
+    }
+    assert_int_equal(stats.blocks, 5);
+    assert_int_equal(stats.submitted, 14);
+
+    pixel_drift_destroy(drift);
+}
+
+/**
+ * @test FW_UT_25_003: Background worker
+ * @pre Same frames to an inline and a background tracker, flushing after
+ *      each submit; then a burst without flushing
+ * @post Identical candidates; the burst never blocks and every frame is
+ *       either processed or counted as skipped
+ */
+static void test_drift_background(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                              .pixels_per_frame = 1000, .weight_shift = 3,
+                              .noise_threshold = 5 };
+    pixel_drift_t *inline_drift = pixel_drift_create(&config);
+    config.background = true;
+    pixel_drift_t *bg_drift = pixel_drift_create(&config);
+    assert_non_null(inline_drift);
+    assert_non_null(bg_drift);
+
+    uint32_t seed = 9;
+    for (uint32_t frame = 0; frame < 60; frame++) {
+        fill_dark(frame, 0, &seed);
+        assert_int_equal(pixel_drift_submit(inline_drift, g_frame), DRIFT_OK);
+        assert_int_equal(pixel_drift_submit(bg_drift, g_frame), DRIFT_OK);
+        pixel_drift_flush(bg_drift);
+    }
+
+    size_t n0 = pixel_drift_get_candidates(inline_drift, 0, g_cands[0], TEST_PIXELS, NULL);
+    size_t n1 = pixel_drift_get_candidates(bg_drift, 0, g_cands[1], TEST_PIXELS, NULL);
+    assert_int_equal(n0, 1);
+    assert_int_equal(n1, n0);
+    assert_memory_equal(g_cands[0], g_cands[1], n0 * sizeof(drift_candidate_t));
+
+    for (uint32_t frame = 0; frame < 200; frame++) {
+        drift_status_t rc = pixel_drift_submit(bg_drift, g_frame);
+        assert_true(rc == DRIFT_OK || rc == DRIFT_BUSY);
+    }
+    pixel_drift_flush(bg_drift);
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(bg_drift, &stats);
+    assert_int_equal(stats.submitted, 260);
+    assert_int_equal(stats.processed + stats.skipped_busy, 260);
+
+    pixel_drift_destroy(inline_drift);
+    pixel_drift_destroy(bg_drift);
+}
+
+/**
+ * @test FW_UT_25_004: Dark gating
+ * @pre Dark level 1500; exposed frames at 3000, then dark frames
+ * @post Exposed blocks counted as skipped, dark blocks processed
+ */
+static void test_drift_dark_gating(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                              .pixels_per_frame = 2048, .dark_level = 1500 };
+    pixel_drift_t *drift = pixel_drift_create(&config);
+    assert_non_null(drift);
+
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        g_frame[i] = 3000;
+    }
+    for (uint32_t frame = 0; frame < 4; frame++) {
+        assert_int_equal(pixel_drift_submit(drift, g_frame), DRIFT_OK);
+    }
+
+    uint32_t seed = 11;
+    fill_dark(0, 0, &seed);
+    assert_int_equal(pixel_drift_submit(drift, g_frame), DRIFT_OK);
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(drift, &stats);
+    assert_int_equal(stats.skipped_bright, 4);
+    assert_int_equal(stats.processed, 1);
+    assert_int_equal(stats.sweeps, 0);
+
+    pixel_drift_destroy(drift);
+}
+
+/**
+ * @test FW_UT_25_005: Candidate paging
+ * @pre Every 7th pixel noisy, pages of 3 records
+ * @post Pages join into the full list in ascending pixel order
+ */
+static void test_drift_paging(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                              .pixels_per_frame = 1000, .weight_shift = 1,
+                              .noise_threshold = 5 };
+    pixel_drift_t *drift = pixel_drift_create(&config);
+    assert_non_null(drift);
+
+    for (uint32_t frame = 0; frame < 5 * 4; frame++) {
+        for (size_t i = 0; i < TEST_PIXELS; i++) {
+            g_frame[i] = (i % 7 == 0 && ((frame / 5) & 1)) ? TEST_DARK + 50 : TEST_DARK;
+        }
+        pixel_drift_submit(drift, g_frame);
+    }
+
+    drift_stats_t stats;
+    pixel_drift_get_stats(drift, &stats);
+    assert_int_equal(stats.candidates, (TEST_PIXELS + 6) / 7);
+
+    uint32_t start = 0;
+    size_t total = 0;
+    while (start < TEST_PIXELS) {
+        uint32_t next;
+        size_t n = pixel_drift_get_candidates(drift, start, &g_cands[0][total], 3, &next);
+        assert_true(n <= 3);
+        assert_true(next > start);
+        total += n;
+        start = next;
+    }
+    assert_int_equal(total, stats.candidates);
+    for (size_t c = 0; c < total; c++) {
+        uint32_t index = (uint32_t)g_cands[0][c].y * TEST_WIDTH + g_cands[0][c].x;
+        assert_int_equal(index, c * 7);
+        assert_true(g_cands[0][c].flags & DRIFT_FLAG_NOISE);
+    }
+
+    pixel_drift_destroy(drift);
+}
+
+/**
+ * @test FW_UT_25_006: Invalid parameters
+ * @pre NULL config, zero size, memory and noise limit out of range, NULL
+ *      frame
+ * @post Create fails or the call returns an error
+ */
+static void test_drift_invalid(void **state) {
+    (void)state;
+
+    drift_config_t config = { .width = 0, .height = TEST_HEIGHT };
+    assert_null(pixel_drift_create(&config));
+    config = (drift_config_t){ .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                               .weight_shift = DRIFT_MAX_WEIGHT_SHIFT + 1 };
+    assert_null(pixel_drift_create(&config));
+    config = (drift_config_t){ .width = TEST_WIDTH, .height = TEST_HEIGHT,
+                               .noise_threshold = DRIFT_MAX_NOISE_THRESHOLD + 1 };
+    assert_null(pixel_drift_create(&config));
+    assert_null(pixel_drift_create(NULL));
+
+    config = (drift_config_t){ .width = TEST_WIDTH, .height = TEST_HEIGHT };
+    pixel_drift_t *drift = pixel_drift_create(&config);
+    assert_non_null(drift);
+    assert_int_equal(pixel_drift_submit(drift, NULL), DRIFT_ERROR_NULL);
+    assert_int_equal(pixel_drift_submit(NULL, g_frame), DRIFT_ERROR_NULL);
+    assert_int_equal(pixel_drift_get_candidates(drift, 0, NULL, 4, NULL), 0);
+
+    pixel_drift_destroy(drift);
+    pixel_drift_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Statistics tests */
+        cmocka_unit_test(test_drift_noise_and_offset),
+        cmocka_unit_test(test_drift_pixel_budget),
+        cmocka_unit_test(test_drift_background),
+        cmocka_unit_test(test_drift_dark_gating),
+        cmocka_unit_test(test_drift_paging),
+        cmocka_unit_test(test_drift_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-25: Pixel Drift Tests",
+                                       tests, NULL, NULL);
+}
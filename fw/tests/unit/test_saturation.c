@@ -0,0 +1,392 @@
+/**
+ * @file test_saturation.c
+ * @brief Unit tests for per-tile saturation counter (FW-UT-16)
+ *
+ * Test ID: FW-UT-16
+ * Coverage: Overexposure detection for protection feedback
+ *
+ * Tests:
+ * - Configuration validation and defaults
+ * - Count against a scalar reference, SIMD tails, edge tiles
+ * - Band-wise counting equals whole-frame counting
+ * - Tile counts added from outside (correction count hook) equal counting
+ * - Tile marking and early trip
+ * - Cumulative counters
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/saturation.h"
+
+/* Odd width exercises SIMD tails and clipped edge tiles */
+#define TEST_WIDTH   83
+#define TEST_HEIGHT  37
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_TILE    16
+
+static void fill_random(uint16_t *frame, size_t n, uint32_t seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        frame[i] = (uint16_t)(seed >> 16);
+    }
+}
+
+static sat_config_t test_config(void) {
+    sat_config_t config = {
+        .width = TEST_WIDTH,
+        .height = TEST_HEIGHT,
+        .threshold = 60000,
+        .tile_size = TEST_TILE,
+        .tile_fraction = 0.25f,
+        .trip_tiles = 2
+    };
+    return config;
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_16_001: Reject invalid configuration, apply defaults
+ * @pre NULL, zero geometry, oversized tile, fraction > 1
+ * @post saturation_create returns NULL; zero fields take defaults
+ */
+static void test_sat_invalid(void **state) {
+    (void)state;
+
+    sat_config_t config = test_config();
+    assert_null(saturation_create(NULL));
+
+    config.width = 0;
+    assert_null(saturation_create(&config));
+
+    config = test_config();
+    config.tile_size = SAT_MAX_TILE_SIZE + 1;
+    assert_null(saturation_create(&config));
+
+    config = test_config();
+    config.tile_fraction = 1.5f;
+    assert_null(saturation_create(&config));
+
+    sat_config_t defaults = { .width = 2048, .height = 2048 };
+    sat_counter_t *sat = saturation_create(&defaults);
+    assert_non_null(sat);
+
+    uint32_t tiles_x = 0, tiles_y = 0;
+    assert_non_null(saturation_get_tiles(sat, &tiles_x, &tiles_y));
+    assert_int_equal(tiles_x, 2048 / SAT_DEFAULT_TILE_SIZE);
+    assert_int_equal(tiles_y, 2048 / SAT_DEFAULT_TILE_SIZE);
+
+    uint16_t row[2048];
+    for (int i = 0; i < 2048; i++) {
+        row[i] = (i & 1) ? SAT_DEFAULT_THRESHOLD : SAT_DEFAULT_THRESHOLD - 1;
+    }
+    saturation_begin_frame(sat);
+    assert_int_equal(saturation_count_rows(sat, row, 0, 1), SAT_OK);
+
+    sat_frame_t result;
+    assert_int_equal(saturation_get_frame(sat, &result), SAT_OK);
+    assert_int_equal(result.saturated, 1024);
+
+    assert_int_equal(saturation_count_rows(NULL, row, 0, 1), SAT_ERROR_NULL);
+    assert_int_equal(saturation_count_rows(sat, row, 2048, 1), SAT_ERROR_PARAM);
+    assert_int_equal(saturation_count_rows(sat, row, 2000, 49), SAT_ERROR_PARAM);
+    assert_false(saturation_tripped(NULL));
+
+    saturation_destroy(sat);
+    saturation_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Counting Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_16_002: Per-tile counts match scalar reference
+ * @pre Random frame, threshold 60000, 16x16 tiles, clipped edges
+ * @post Tile counts and total identical to reference; worst tile found
+ */
+static void test_sat_reference(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    fill_random(frame, TEST_PIXELS, 11);
+
+    sat_config_t config = test_config();
+    sat_counter_t *sat = saturation_create(&config);
+    assert_non_null(sat);
+
+    saturation_begin_frame(sat);
+    assert_int_equal(saturation_count_rows(sat, frame, 0, TEST_HEIGHT), SAT_OK);
+
+    uint32_t tiles_x, tiles_y;
+    const uint32_t *tiles = saturation_get_tiles(sat, &tiles_x, &tiles_y);
+    assert_int_equal(tiles_x, (TEST_WIDTH + TEST_TILE - 1) / TEST_TILE);
+    assert_int_equal(tiles_y, (TEST_HEIGHT + TEST_TILE - 1) / TEST_TILE);
+
+    uint32_t ref[6 * 3];
+    memset(ref, 0, sizeof(ref));
+    uint32_t total = 0;
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            if (frame[y * TEST_WIDTH + x] >= 60000) {
+                ref[(y / TEST_TILE) * tiles_x + x / TEST_TILE]++;
+                total++;
+            }
+        }
+    }
+    assert_true(total > 0);
+    assert_memory_equal(tiles, ref, tiles_x * tiles_y * sizeof(uint32_t));
+
+    uint32_t worst = 0;
+    for (uint32_t i = 1; i < tiles_x * tiles_y; i++) {
+        worst = (ref[i] > ref[worst]) ? i : worst;
+    }
+
+    sat_frame_t result;
+    assert_int_equal(saturation_get_frame(sat, &result), SAT_OK);
+    assert_int_equal(result.saturated, total);
+    assert_int_equal(result.worst_tile, worst);
+    assert_int_equal(result.worst_count, ref[worst]);
+
+    saturation_destroy(sat);
+}
+
+/**
+ * @test FW_UT_16_003: Band-wise counting equals whole-frame counting
+ * @pre Same frame counted in uneven bands (5, 16, 3, 13 rows)
+ * @post Identical tile counts
+ */
+static void test_sat_bands(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    fill_random(frame, TEST_PIXELS, 23);
+
+    sat_config_t config = test_config();
+    sat_counter_t *whole = saturation_create(&config);
+    sat_counter_t *banded = saturation_create(&config);
+
+    saturation_begin_frame(whole);
+    saturation_count_rows(whole, frame, 0, TEST_HEIGHT);
+
+    const uint32_t bands[] = { 5, 16, 3, 13 };
+    uint32_t row = 0;
+    saturation_begin_frame(banded);
+    for (size_t b = 0; b < sizeof(bands) / sizeof(bands[0]); b++) {
+        assert_int_equal(saturation_count_rows(banded, frame, row, bands[b]), SAT_OK);
+        row += bands[b];
+    }
+    assert_int_equal(row, TEST_HEIGHT);
+
+    uint32_t tiles_x, tiles_y;
+    const uint32_t *a = saturation_get_tiles(whole, &tiles_x, &tiles_y);
+    const uint32_t *b = saturation_get_tiles(banded, NULL, NULL);
+    assert_memory_equal(a, b, tiles_x * tiles_y * sizeof(uint32_t));
+
+    saturation_destroy(whole);
+    saturation_destroy(banded);
+}
+
+/**
+ * @test FW_UT_16_006: Added tile counts equal counting the frame
+ * @pre Per-tile counts of row segments within a tile row (5, 11, 16, 5
+ *      rows), as the correction count hook reports them
+ * @post Tile counts, total and marked tiles identical to counting the
+ *       frame; segments crossing a tile row or out of range rejected
+ */
+static void test_sat_add_counts(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    fill_random(frame, TEST_PIXELS, 31);
+
+    sat_config_t config = test_config();
+    config.tile_fraction = 0.01f;
+    sat_counter_t *counted = saturation_create(&config);
+    sat_counter_t *added = saturation_create(&config);
+
+    saturation_begin_frame(counted);
+    saturation_count_rows(counted, frame, 0, TEST_HEIGHT);
+
+    uint32_t tiles_x, tiles_y;
+    saturation_get_tiles(added, &tiles_x, &tiles_y);
+
+    const uint32_t segments[] = { 5, 11, 16, 5 };
+    uint32_t row = 0;
+    saturation_begin_frame(added);
+    for (size_t s = 0; s < sizeof(segments) / sizeof(segments[0]); s++) {
+        uint32_t counts[(TEST_WIDTH + TEST_TILE - 1) / TEST_TILE] = {0};
+        for (uint32_t y = row; y < row + segments[s]; y++) {
+            for (uint32_t x = 0; x < TEST_WIDTH; x++) {
+                counts[x / TEST_TILE] += (frame[y * TEST_WIDTH + x] >= config.threshold);
+            }
+        }
+        assert_int_equal(saturation_add_counts(added, row, segments[s], counts), SAT_OK);
+        row += segments[s];
+    }
+    assert_int_equal(row, TEST_HEIGHT);
+
+    const uint32_t *a = saturation_get_tiles(counted, NULL, NULL);
+    const uint32_t *b = saturation_get_tiles(added, NULL, NULL);
+    assert_memory_equal(a, b, tiles_x * tiles_y * sizeof(uint32_t));
+
+    sat_frame_t ra, rb;
+    saturation_get_frame(counted, &ra);
+    saturation_get_frame(added, &rb);
+    assert_true(ra.saturated > 0);
+    assert_int_equal(rb.saturated, ra.saturated);
+    assert_int_equal(rb.tiles_over, ra.tiles_over);
+    assert_int_equal(rb.tripped, ra.tripped);
+
+    uint32_t zero[(TEST_WIDTH + TEST_TILE - 1) / TEST_TILE] = {0};
+    assert_int_equal(saturation_add_counts(NULL, 0, 1, zero), SAT_ERROR_NULL);
+    assert_int_equal(saturation_add_counts(added, 0, 1, NULL), SAT_ERROR_NULL);
+    assert_int_equal(saturation_add_counts(added, 10, 10, zero), SAT_ERROR_PARAM);
+    assert_int_equal(saturation_add_counts(added, 0, 0, zero), SAT_ERROR_PARAM);
+    assert_int_equal(saturation_add_counts(added, TEST_HEIGHT, 1, zero), SAT_ERROR_PARAM);
+    assert_int_equal(saturation_add_counts(added, 32, 6, zero), SAT_ERROR_PARAM);
+
+    saturation_destroy(counted);
+    saturation_destroy(added);
+}
+
+/* ==========================================================================
+ * Trip Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_16_004: Frame trips on the band that marks the second tile
+ * @pre Dark frame; tile (0,0) 25% saturated, tile (1,2) clipped edge tile
+ *      (16x5) 25% saturated
+ * @post Not tripped after the first band, tripped after the last band;
+ *       a fresh frame starts clear
+ */
+static void test_sat_trip(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 1000;
+    }
+
+    /* Tile (0,0): 64 of 256 pixels (first four rows) */
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < TEST_TILE; x++) {
+            frame[y * TEST_WIDTH + x] = 65535;
+        }
+    }
+    /* Tile (1,2) covers rows 32..36: limit ceil(0.25 * 80) = 20 */
+    for (int i = 0; i < 20; i++) {
+        frame[(32 + i / 16) * TEST_WIDTH + TEST_TILE + i % 16] = 60000;
+    }
+
+    sat_config_t config = test_config();
+    sat_counter_t *sat = saturation_create(&config);
+    sat_frame_t result;
+
+    saturation_begin_frame(sat);
+    saturation_count_rows(sat, frame, 0, 16);
+    assert_false(saturation_tripped(sat));
+    saturation_get_frame(sat, &result);
+    assert_int_equal(result.tiles_over, 1);
+
+    saturation_count_rows(sat, frame, 16, 16);
+    assert_false(saturation_tripped(sat));
+
+    saturation_count_rows(sat, frame, 32, 5);
+    assert_true(saturation_tripped(sat));
+
+    assert_int_equal(saturation_end_frame(sat, &result), SAT_OK);
+    assert_true(result.tripped);
+    assert_int_equal(result.tiles_over, 2);
+    assert_int_equal(result.saturated, 64 + 20);
+    assert_int_equal(result.worst_tile, 0);
+
+    /* One pixel short of the edge-tile limit does not mark it */
+    frame[(32 + 19 / 16) * TEST_WIDTH + TEST_TILE + 19 % 16] = 59999;
+    saturation_begin_frame(sat);
+    assert_false(saturation_tripped(sat));
+    saturation_count_rows(sat, frame, 0, TEST_HEIGHT);
+    assert_false(saturation_tripped(sat));
+    saturation_end_frame(sat, NULL);
+
+    saturation_destroy(sat);
+}
+
+/**
+ * @test FW_UT_16_005: Cumulative counters
+ * @pre Three frames: dark, saturated below trip, tripped
+ * @post frames, frames_saturated, frames_tripped, pixels, max tiles
+ */
+static void test_sat_stats(void **state) {
+    (void)state;
+
+    uint16_t frame[TEST_PIXELS];
+    sat_config_t config = test_config();
+    config.trip_tiles = 1;
+    sat_counter_t *sat = saturation_create(&config);
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 100;
+    }
+    saturation_begin_frame(sat);
+    saturation_count_rows(sat, frame, 0, TEST_HEIGHT);
+    saturation_end_frame(sat, NULL);
+
+    frame[0] = 65535;
+    saturation_begin_frame(sat);
+    saturation_count_rows(sat, frame, 0, TEST_HEIGHT);
+    saturation_end_frame(sat, NULL);
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 65535;
+    }
+    saturation_begin_frame(sat);
+    saturation_count_rows(sat, frame, 0, TEST_HEIGHT);
+    saturation_end_frame(sat, NULL);
+
+    sat_stats_t stats;
+    saturation_get_stats(sat, &stats);
+    assert_int_equal(stats.frames, 3);
+    assert_int_equal(stats.frames_saturated, 2);
+    assert_int_equal(stats.frames_tripped, 1);
+    assert_int_equal(stats.saturated_pixels, 1 + TEST_PIXELS);
+    assert_int_equal(stats.max_tiles_over, 6 * 3);
+    assert_int_equal(stats.last_tiles_over, 6 * 3);
+
+    saturation_destroy(sat);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_sat_invalid),
+
+        /* Counting tests */
+        cmocka_unit_test(test_sat_reference),
+        cmocka_unit_test(test_sat_bands),
+        cmocka_unit_test(test_sat_add_counts),
+
+        /* Trip tests */
+        cmocka_unit_test(test_sat_trip),
+        cmocka_unit_test(test_sat_stats),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-16: Saturation Counter Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_spsc_queue.c
+ * @brief Unit tests for lock-free SPSC queue (FW-UT-20)
+ *
+ * Test ID: FW-UT-20
+ * Coverage: Capacity rounding, full/empty, wrap-around, two-thread transfer
+ *
+ * Tests:
+ * - Create validation and power-of-two rounding
+ * - Full and empty detection, NULL items
+ * - FIFO order across many wrap-arounds
+ * - Producer/consumer threads transfer every item exactly once, in order
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "util/spsc_queue.h"
+
+#define STRESS_ITEMS    200000U
+
+/* ==========================================================================
+ * Single-Thread Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_20_001: Create validation and capacity rounding
+ * @pre Capacities 0, 1, 5, SPSC_MAX_CAPACITY + 1
+ * @post 0 and oversize refused; 5 rounded up to 8
+ */
+static void test_spsc_create(void **state) {
+    (void)state;
+
+    assert_null(spsc_queue_create(0));
+    assert_null(spsc_queue_create(SPSC_MAX_CAPACITY + 1));
+
+    spsc_queue_t *q = spsc_queue_create(1);
+    assert_non_null(q);
+    assert_int_equal(spsc_queue_capacity(q), 1);
+    spsc_queue_destroy(q);
+
+    q = spsc_queue_create(5);
+    assert_non_null(q);
+    assert_int_equal(spsc_queue_capacity(q), 8);
+    assert_int_equal(spsc_queue_depth(q), 0);
+    spsc_queue_destroy(q);
+
+    assert_int_equal(spsc_queue_capacity(NULL), 0);
+    spsc_queue_destroy(NULL);
+}
+
+/**
+ * @test FW_UT_20_002: Full and empty detection
+ * @pre Capacity 4 queue
+ * @post Fifth push fails, pops return items in order including NULL,
+ *       pop on empty fails
+ */
+static void test_spsc_full_empty(void **state) {
+    (void)state;
+
+    int items[3];
+    void *out = NULL;
+    spsc_queue_t *q = spsc_queue_create(4);
+    assert_non_null(q);
+
+    assert_false(spsc_queue_pop(q, &out));
+    assert_true(spsc_queue_push(q, &items[0]));
+    assert_true(spsc_queue_push(q, NULL));
+    assert_true(spsc_queue_push(q, &items[1]));
+    assert_true(spsc_queue_push(q, &items[2]));
+    assert_false(spsc_queue_push(q, &items[0]));
+    assert_int_equal(spsc_queue_depth(q), 4);
+
+    assert_true(spsc_queue_pop(q, &out));
+    assert_ptr_equal(out, &items[0]);
+    assert_true(spsc_queue_pop(q, &out));
+    assert_null(out);
+    assert_true(spsc_queue_push(q, &items[0]));
+    assert_true(spsc_queue_pop(q, &out));
+    assert_ptr_equal(out, &items[1]);
+    assert_true(spsc_queue_pop(q, &out));
+    assert_ptr_equal(out, &items[2]);
+    assert_true(spsc_queue_pop(q, &out));
+    assert_ptr_equal(out, &items[0]);
+    assert_false(spsc_queue_pop(q, &out));
+    assert_int_equal(spsc_queue_depth(q), 0);
+
+    spsc_queue_destroy(q);
+}
+
+/**
+ * @test FW_UT_20_003: FIFO order across wrap-around
+ * @pre Capacity 8 queue, 1000 rounds of 3 pushes and 3 pops
+ * @post Items come out in push order every round
+ */
+static void test_spsc_wrap(void **state) {
+    (void)state;
+
+    spsc_queue_t *q = spsc_queue_create(8);
+    assert_non_null(q);
+
+    uintptr_t next_in = 1;
+    uintptr_t next_out = 1;
+    void *out;
+
+    for (int round = 0; round < 1000; round++) {
+        for (int i = 0; i < 3; i++) {
+            assert_true(spsc_queue_push(q, (void *)next_in++));
+        }
+        for (int i = 0; i < 3; i++) {
+            assert_true(spsc_queue_pop(q, &out));
+            assert_int_equal((uintptr_t)out, next_out++);
+        }
+    }
+
+    spsc_queue_destroy(q);
+}
+
+/* ==========================================================================
+ * Concurrency Tests
+ * ========================================================================== */
+
+static void *stress_producer(void *arg) {
+    spsc_queue_t *q = (spsc_queue_t *)arg;
+
+    for (uintptr_t i = 1; i <= STRESS_ITEMS; i++) {
+        while (!spsc_queue_push(q, (void *)i)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @test FW_UT_20_004: Two-thread transfer
+ * @pre Capacity 16 queue, producer thread pushes 1..200000
+ * @post Consumer receives every value exactly once, in order
+ */
+static void test_spsc_threads(void **state) {
+    (void)state;
+
+    spsc_queue_t *q = spsc_queue_create(16);
+    assert_non_null(q);
+
+    pthread_t producer;
+    assert_int_equal(pthread_create(&producer, NULL, stress_producer, q), 0);
+
+    uintptr_t expected = 1;
+    bool in_order = true;
+    void *out;
+    while (expected <= STRESS_ITEMS) {
+        if (!spsc_queue_pop(q, &out)) {
+            sched_yield();
+            continue;
+        }
+        if ((uintptr_t)out != expected) {
+            in_order = false;
+        }
+        expected++;
+    }
+
+    pthread_join(producer, NULL);
+    assert_true(in_order);
+    assert_false(spsc_queue_pop(q, &out));
+
+    spsc_queue_destroy(q);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Single-thread tests */
+        cmocka_unit_test(test_spsc_create),
+        cmocka_unit_test(test_spsc_full_empty),
+        cmocka_unit_test(test_spsc_wrap),
+
+        /* Concurrency tests */
+        cmocka_unit_test(test_spsc_threads),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-20: SPSC Queue Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,293 @@
+/**
+ * @file test_stats_page.c
+ * @brief Unit tests for the shared-memory statistics page (FW-UT-32)
+ *
+ * Test ID: FW-UT-32
+ * Coverage: Page layout, seqlock consistency, publisher thread, reader checks
+ *
+ * Tests:
+ * - Published values, names and types read back through a second mapping
+ * - A reader never sees a torn set while the writer publishes
+ * - The publisher thread calls the fill callback every period
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "util/stats_page.h"
+
+#define SEQLOCK_ENTRIES     64
+#define SEQLOCK_PUBLISHES   200000
+
+static char g_name[64];
+
+/* Per-process object name so parallel test runs do not collide */
+static const char *page_name(void) {
+    snprintf(g_name, sizeof(g_name), "/test_stats_page_%d", (int)getpid());
+    return g_name;
+}
+
+static void make_entry(stats_page_entry_t *entry, const char *name, stats_page_type_t type) {
+    memset(entry, 0, sizeof(*entry));
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->type = type;
+}
+
+/* ==========================================================================
+ * Layout Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_32_001: Publish and read back
+ * @pre Page of two counters and a gauge, one manual publish
+ * @post Reader sees the v1 header, names, types and values; after destroy
+ *       the mapping reports closed and the object is gone
+ */
+static void test_stats_page_roundtrip(void **state) {
+    (void)state;
+
+    stats_page_entry_t entries[3];
+    make_entry(&entries[0], "frames_received", STATS_PAGE_COUNTER);
+    make_entry(&entries[1], "bytes_sent", STATS_PAGE_COUNTER);
+    make_entry(&entries[2], "fpga_temp_celsius", STATS_PAGE_GAUGE);
+
+    stats_page_config_t config = { .name = page_name(), .entries = entries, .entry_count = 3 };
+    stats_page_t *page = stats_page_create(&config);
+    assert_non_null(page);
+
+    uint64_t published[3] = { 1234, UINT64_MAX, stats_page_gauge(-12.5) };
+    assert_int_equal(stats_page_publish(page, published), STATS_PAGE_OK);
+
+    stats_page_view_t view;
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_OK);
+    assert_int_equal(view.header->magic, STATS_PAGE_MAGIC);
+    assert_int_equal(view.header->version, STATS_PAGE_VERSION);
+    assert_int_equal(view.header->entry_count, 3);
+    assert_int_equal(view.header->values_offset, 64 + 3 * 64);
+    assert_int_equal(view.header->pid, getpid());
+    assert_int_equal(view.size, 64 + 3 * 64 + 3 * 8);
+    assert_int_equal(atomic_load(&view.header->updates), 1);
+    assert_string_equal(view.entries[2].name, "fpga_temp_celsius");
+    assert_int_equal(view.entries[2].type, STATS_PAGE_GAUGE);
+
+    uint64_t values[3];
+    uint64_t update_ns = 0;
+    assert_int_equal(stats_page_read(&view, values, &update_ns), STATS_PAGE_OK);
+    assert_true(update_ns != 0);
+    assert_memory_equal(values, published, sizeof(values));
+    assert_true(stats_page_value(&view.entries[0], values[0]) == 1234.0);
+    assert_true(stats_page_value(&view.entries[2], values[2]) == -12.5);
+
+    stats_page_destroy(page);
+    assert_int_equal(stats_page_read(&view, values, NULL), STATS_PAGE_ERROR_CLOSED);
+    assert_memory_equal(values, published, sizeof(values));
+    stats_page_close(&view);
+    assert_null(view.header);
+
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_ERROR_SHM);
+}
+
+typedef struct {
+    const stats_page_view_t *view;
+    atomic_bool done;
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t backwards;
+} reader_t;
+
+static void *seqlock_reader(void *arg) {
+    reader_t *reader = (reader_t *)arg;
+    uint64_t values[SEQLOCK_ENTRIES];
+    uint64_t last = 0;
+
+    while (!atomic_load(&reader->done)) {
+        if (stats_page_read(reader->view, values, NULL) != STATS_PAGE_OK) {
+            continue;
+        }
+        reader->reads++;
+        for (uint32_t i = 1; i < SEQLOCK_ENTRIES; i++) {
+            if (values[i] != values[0] + i) {
+                reader->torn++;
+                break;
+            }
+        }
+        if (values[0] < last) {
+            reader->backwards++;
+        }
+        last = values[0];
+    }
+    return NULL;
+}
+
+/**
+ * @test FW_UT_32_002: Seqlock consistency
+ * @pre Writer publishes 200000 sets of 64 related values while a reader
+ *      thread reads through its own mapping
+ * @post Every set read is complete (no mix of two publishes) and sets
+ *       never go back in time
+ */
+static void test_stats_page_seqlock(void **state) {
+    (void)state;
+
+    stats_page_entry_t entries[SEQLOCK_ENTRIES];
+    for (uint32_t i = 0; i < SEQLOCK_ENTRIES; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "value_%u", i);
+        make_entry(&entries[i], name, STATS_PAGE_COUNTER);
+    }
+
+    stats_page_config_t config = {
+        .name = page_name(), .entries = entries, .entry_count = SEQLOCK_ENTRIES
+    };
+    stats_page_t *page = stats_page_create(&config);
+    assert_non_null(page);
+
+    uint64_t values[SEQLOCK_ENTRIES];
+    for (uint32_t i = 0; i < SEQLOCK_ENTRIES; i++) {
+        values[i] = i;
+    }
+    assert_int_equal(stats_page_publish(page, values), STATS_PAGE_OK);
+
+    stats_page_view_t view;
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_OK);
+
+    reader_t reader = { .view = &view };
+    pthread_t thread;
+    assert_int_equal(pthread_create(&thread, NULL, seqlock_reader, &reader), 0);
+
+    for (uint64_t n = 1; n <= SEQLOCK_PUBLISHES; n++) {
+        for (uint32_t i = 0; i < SEQLOCK_ENTRIES; i++) {
+            values[i] = n * 1000 + i;
+        }
+        stats_page_publish(page, values);
+    }
+    atomic_store(&reader.done, true);
+    pthread_join(thread, NULL);
+
+    assert_true(reader.reads > 0);
+    assert_int_equal(reader.torn, 0);
+    assert_int_equal(reader.backwards, 0);
+    assert_int_equal(atomic_load(&view.header->updates), SEQLOCK_PUBLISHES + 1);
+
+    stats_page_close(&view);
+    stats_page_destroy(page);
+}
+
+static void fill_calls(uint64_t *values, void *user_data) {
+    atomic_uint *calls = (atomic_uint *)user_data;
+    values[0] = atomic_fetch_add(calls, 1) + 1;
+    values[1] = stats_page_gauge(0.5);
+}
+
+/**
+ * @test FW_UT_32_003: Publisher thread
+ * @pre Fill callback numbers its calls; 1 ms period
+ * @post Page updates on its own and holds the latest call's values
+ */
+static void test_stats_page_publisher(void **state) {
+    (void)state;
+
+    atomic_uint calls = 0;
+    stats_page_entry_t entries[2];
+    make_entry(&entries[0], "fill_calls", STATS_PAGE_COUNTER);
+    make_entry(&entries[1], "half", STATS_PAGE_GAUGE);
+
+    stats_page_config_t config = {
+        .name = page_name(), .entries = entries, .entry_count = 2,
+        .fill = fill_calls, .user_data = &calls, .period_ms = 1, .nice = 5
+    };
+    stats_page_t *page = stats_page_create(&config);
+    assert_non_null(page);
+
+    stats_page_view_t view;
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_OK);
+    for (int i = 0; i < 2000 && atomic_load(&view.header->updates) < 5; i++) {
+        usleep(1000);
+    }
+    assert_true(atomic_load(&view.header->updates) >= 5);
+
+    stats_page_destroy(page);
+
+    uint64_t values[2];
+    assert_int_equal(stats_page_read(&view, values, NULL), STATS_PAGE_ERROR_CLOSED);
+    assert_int_equal(values[0], atomic_load(&calls));
+    assert_int_equal(atomic_load(&view.header->updates), atomic_load(&calls));
+    assert_true(stats_page_value(&view.entries[1], values[1]) == 0.5);
+    stats_page_close(&view);
+}
+
+/**
+ * @test FW_UT_32_004: Invalid use
+ * @pre Bad configurations; missing object; object that is not a page
+ * @post Create fails; open reports SHM or FORMAT
+ */
+static void test_stats_page_invalid(void **state) {
+    (void)state;
+
+    stats_page_entry_t entry;
+    make_entry(&entry, "ok", STATS_PAGE_COUNTER);
+    stats_page_config_t config = { .name = page_name(), .entries = &entry, .entry_count = 1 };
+
+    assert_null(stats_page_create(NULL));
+    config.entry_count = 0;
+    assert_null(stats_page_create(&config));
+    config.entry_count = STATS_PAGE_MAX_ENTRIES + 1;
+    assert_null(stats_page_create(&config));
+    config.entry_count = 1;
+    config.name = "no_slash";
+    assert_null(stats_page_create(&config));
+    config.name = page_name();
+    entry.type = 2;
+    assert_null(stats_page_create(&config));
+    entry.type = STATS_PAGE_COUNTER;
+    memset(entry.name, 'x', sizeof(entry.name));
+    assert_null(stats_page_create(&config));
+
+    stats_page_view_t view;
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_ERROR_SHM);
+    assert_int_equal(stats_page_open(NULL, NULL), STATS_PAGE_ERROR_NULL);
+    assert_int_equal(stats_page_publish(NULL, NULL), STATS_PAGE_ERROR_NULL);
+    stats_page_destroy(NULL);
+    stats_page_close(NULL);
+
+    /* Something else under the name */
+    int fd = shm_open(page_name(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    assert_true(fd >= 0);
+    assert_int_equal(ftruncate(fd, 4096), 0);
+    close(fd);
+    assert_int_equal(stats_page_open(page_name(), &view), STATS_PAGE_ERROR_FORMAT);
+    shm_unlink(page_name());
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Layout tests */
+        cmocka_unit_test(test_stats_page_roundtrip),
+        cmocka_unit_test(test_stats_page_seqlock),
+        cmocka_unit_test(test_stats_page_publisher),
+        cmocka_unit_test(test_stats_page_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-32: Stats Page Tests",
+                                       tests, NULL, NULL);
+}
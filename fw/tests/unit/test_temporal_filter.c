@@ -0,0 +1,343 @@
+/**
+ * @file test_temporal_filter.c
+ * @brief Unit tests for recursive temporal filter (FW-UT-17)
+ *
+ * Test ID: FW-UT-17
+ * Coverage: Motion-adaptive recursive noise filter for continuous scans
+ *
+ * Tests:
+ * - Configuration and parameter validation
+ * - Seed frame, bit-exact match with a reference model
+ * - Noise reduction on a static scene
+ * - Motion detection (no lag on large changes)
+ * - Staged parameters, reset and band-wise application
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "proc/temporal_filter.h"
+
+/* Odd width exercises SIMD tails */
+#define TEST_WIDTH   53
+#define TEST_HEIGHT  11
+#define TEST_PIXELS  (TEST_WIDTH * TEST_HEIGHT)
+
+static uint32_t test_seed = 1;
+
+static uint16_t next_random(void) {
+    test_seed = test_seed * 1664525U + 1013904223U;
+    return (uint16_t)(test_seed >> 16);
+}
+
+static tf_config_t test_config(void) {
+    tf_config_t config = { .width = TEST_WIDTH, .height = TEST_HEIGHT };
+    temporal_filter_params_defaults(&config.params);
+    return config;
+}
+
+/**
+ * @brief Reference model: same fixed-point arithmetic, plain C
+ */
+static uint32_t reference_step(uint16_t *px, int64_t *state, size_t n, const tf_params_t *p) {
+    uint32_t motion = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int64_t prev = (state[i] + (1 << (TF_STATE_FRAC_BITS - 1))) >> TF_STATE_FRAC_BITS;
+        int64_t diff = llabs((int64_t)px[i] - prev);
+        int64_t a = (diff > p->motion_threshold) ? p->motion_alpha : p->alpha;
+        motion += (diff > p->motion_threshold);
+
+        int64_t d = ((int64_t)px[i] << TF_STATE_FRAC_BITS) - state[i];
+        int64_t num = d * a + 128;
+        /* Floor division (arithmetic shift) */
+        state[i] += (num >= 0) ? num / 256 : -((-num + 255) / 256);
+        px[i] = (uint16_t)((state[i] + (1 << (TF_STATE_FRAC_BITS - 1))) >> TF_STATE_FRAC_BITS);
+    }
+
+    return motion;
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_17_001: Reject invalid configuration and parameters
+ * @pre NULL, zero geometry, alpha 0, motion_alpha < alpha, alpha > 1.0
+ * @post create returns NULL / set_params returns TF_ERROR_PARAM
+ */
+static void test_tf_invalid(void **state) {
+    (void)state;
+
+    tf_config_t config = test_config();
+    assert_null(temporal_filter_create(NULL));
+
+    config.height = 0;
+    assert_null(temporal_filter_create(&config));
+
+    config = test_config();
+    config.params.alpha = 0;
+    assert_null(temporal_filter_create(&config));
+
+    config = test_config();
+    tf_filter_t *tf = temporal_filter_create(&config);
+    assert_non_null(tf);
+    assert_true(temporal_filter_enabled(tf));
+
+    tf_params_t params = config.params;
+    params.motion_alpha = params.alpha - 1;
+    assert_int_equal(temporal_filter_set_params(tf, &params), TF_ERROR_PARAM);
+
+    params = config.params;
+    params.alpha = TF_ALPHA_ONE + 1;
+    assert_int_equal(temporal_filter_set_params(tf, &params), TF_ERROR_PARAM);
+    assert_int_equal(temporal_filter_set_params(NULL, &params), TF_ERROR_NULL);
+
+    uint16_t frame[TEST_PIXELS] = {0};
+    assert_int_equal(temporal_filter_apply_rows(tf, frame, TEST_HEIGHT, 1), TF_ERROR_PARAM);
+    assert_int_equal(temporal_filter_apply_rows(tf, NULL, 0, 1), TF_ERROR_NULL);
+
+    temporal_filter_destroy(tf);
+    temporal_filter_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Filter Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_17_002: Seed frame and bit-exact reference match
+ * @pre Random frames, alpha 0.25, motion threshold 20000
+ * @post First frame unchanged; next frames match the reference model
+ *       pixel for pixel, motion counts equal
+ */
+static void test_tf_reference(void **state) {
+    (void)state;
+
+    tf_config_t config = test_config();
+    config.params.motion_threshold = 20000;
+    tf_filter_t *tf = temporal_filter_create(&config);
+
+    static uint16_t frame[TEST_PIXELS];
+    static uint16_t expect[TEST_PIXELS];
+    static int64_t ref_state[TEST_PIXELS];
+
+    test_seed = 5;
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = next_random();
+        ref_state[i] = (int64_t)frame[i] << TF_STATE_FRAC_BITS;
+    }
+    memcpy(expect, frame, sizeof(frame));
+
+    assert_int_equal(temporal_filter_apply_frame(tf, frame), TF_OK);
+    assert_memory_equal(frame, expect, sizeof(frame));
+
+    for (int f = 0; f < 4; f++) {
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = next_random();
+        }
+        memcpy(expect, frame, sizeof(frame));
+
+        uint32_t motion = reference_step(expect, ref_state, TEST_PIXELS, &config.params);
+        assert_int_equal(temporal_filter_apply_frame(tf, frame), TF_OK);
+        assert_memory_equal(frame, expect, sizeof(frame));
+
+        tf_stats_t stats;
+        temporal_filter_get_stats(tf, &stats);
+        assert_int_equal(stats.last_motion, motion);
+        assert_int_equal(stats.frames, f + 1);
+    }
+
+    temporal_filter_destroy(tf);
+}
+
+/**
+ * @test FW_UT_17_003: Noise reduction on a static scene
+ * @pre Level 10000 with +/-200 uniform noise, alpha 0.25, 30 frames
+ * @post Output noise std below 45% of input (theory: sqrt(1/7) = 38%),
+ *       mean preserved within 2 counts, no motion flagged
+ */
+static void test_tf_noise(void **state) {
+    (void)state;
+
+    tf_config_t config = test_config();
+    tf_filter_t *tf = temporal_filter_create(&config);
+
+    static uint16_t frame[TEST_PIXELS];
+    double in_var = 0.0, out_var = 0.0, out_sum = 0.0;
+    int samples = 0;
+
+    test_seed = 9;
+    for (int f = 0; f < 30; f++) {
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = (uint16_t)(9800 + next_random() % 401);
+        }
+        if (f >= 20) {
+            for (int i = 0; i < TEST_PIXELS; i++) {
+                in_var += (frame[i] - 10000.0) * (frame[i] - 10000.0);
+            }
+        }
+
+        temporal_filter_apply_frame(tf, frame);
+
+        if (f >= 20) {
+            for (int i = 0; i < TEST_PIXELS; i++) {
+                out_var += (frame[i] - 10000.0) * (frame[i] - 10000.0);
+                out_sum += frame[i];
+            }
+            samples += TEST_PIXELS;
+        }
+    }
+
+    assert_true(sqrt(out_var / samples) < 0.45 * sqrt(in_var / samples));
+    assert_float_equal(out_sum / samples, 10000.0, 2.0);
+
+    tf_stats_t stats;
+    temporal_filter_get_stats(tf, &stats);
+    assert_int_equal(stats.motion_pixels, 0);
+
+    temporal_filter_destroy(tf);
+}
+
+/**
+ * @test FW_UT_17_004: Motion bypasses the filter
+ * @pre Static 1000 scene; left half steps to 30000, right half to 1200
+ * @post Left half follows immediately (motion_alpha 1.0), right half lags
+ *       (1000 + 0.25 * 200 = 1050)
+ */
+static void test_tf_motion(void **state) {
+    (void)state;
+
+    tf_config_t config = test_config();
+    tf_filter_t *tf = temporal_filter_create(&config);
+
+    static uint16_t frame[TEST_PIXELS];
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = 1000;
+        }
+        temporal_filter_apply_frame(tf, frame);
+    }
+
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            frame[y * TEST_WIDTH + x] = (x < TEST_WIDTH / 2) ? 30000 : 1200;
+        }
+    }
+    temporal_filter_apply_frame(tf, frame);
+
+    assert_int_equal(frame[0], 30000);
+    assert_int_equal(frame[TEST_PIXELS - 1], 1050);
+
+    tf_stats_t stats;
+    temporal_filter_get_stats(tf, &stats);
+    assert_int_equal(stats.last_motion, (TEST_WIDTH / 2) * TEST_HEIGHT);
+
+    temporal_filter_destroy(tf);
+}
+
+/* ==========================================================================
+ * Lifecycle Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_17_005: Staged parameters, reset and bands
+ * @pre Filter primed; parameters staged with enabled = 0
+ * @post Old parameters apply until reset; after reset frames pass through;
+ *       re-enabled filter re-seeds; bands equal a whole-frame pass
+ */
+static void test_tf_lifecycle(void **state) {
+    (void)state;
+
+    tf_config_t config = test_config();
+    tf_filter_t *tf = temporal_filter_create(&config);
+    tf_filter_t *whole = temporal_filter_create(&config);
+
+    static uint16_t frame[TEST_PIXELS];
+    static uint16_t copy[TEST_PIXELS];
+
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 1000;
+    }
+    temporal_filter_apply_frame(tf, frame);
+
+    tf_params_t off = config.params;
+    off.enabled = 0;
+    assert_int_equal(temporal_filter_set_params(tf, &off), TF_OK);
+
+    /* Still filtering until reset */
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 1400;
+    }
+    temporal_filter_apply_frame(tf, frame);
+    assert_int_equal(frame[0], 1100);
+
+    temporal_filter_reset(tf);
+    assert_false(temporal_filter_enabled(tf));
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        frame[i] = 1400;
+    }
+    temporal_filter_apply_frame(tf, frame);
+    assert_int_equal(frame[0], 1400);
+
+    /* Re-enable: first frame after reset seeds */
+    assert_int_equal(temporal_filter_set_params(tf, &config.params), TF_OK);
+    temporal_filter_reset(tf);
+
+    test_seed = 17;
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; i < TEST_PIXELS; i++) {
+            frame[i] = next_random();
+        }
+        memcpy(copy, frame, sizeof(frame));
+
+        temporal_filter_begin_frame(tf);
+        assert_int_equal(temporal_filter_apply_rows(tf, frame, 0, 4), TF_OK);
+        assert_int_equal(temporal_filter_apply_rows(tf, frame, 4, 6), TF_OK);
+        assert_int_equal(temporal_filter_apply_rows(tf, frame, 10, 1), TF_OK);
+        temporal_filter_end_frame(tf);
+
+        temporal_filter_apply_frame(whole, copy);
+        assert_memory_equal(frame, copy, sizeof(frame));
+    }
+
+    tf_stats_t stats;
+    temporal_filter_get_stats(tf, &stats);
+    assert_int_equal(stats.resets, 2);
+    assert_int_equal(stats.frames, 1 + 2);
+
+    temporal_filter_destroy(tf);
+    temporal_filter_destroy(whole);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_tf_invalid),
+
+        /* Filter tests */
+        cmocka_unit_test(test_tf_reference),
+        cmocka_unit_test(test_tf_noise),
+        cmocka_unit_test(test_tf_motion),
+
+        /* Lifecycle tests */
+        cmocka_unit_test(test_tf_lifecycle),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-17: Temporal Filter Tests",
+                                       tests, NULL, NULL);
+}
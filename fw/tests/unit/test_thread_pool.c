@@ -0,0 +1,270 @@
+/**
+ * @file test_thread_pool.c
+ * @brief Unit tests for work-stealing thread pool (FW-UT-18)
+ *
+ * Test ID: FW-UT-18
+ * Coverage: Fork/join pool for parallel per-frame processing
+ *
+ * Tests:
+ * - Configuration and argument validation
+ * - Every item runs exactly once for any count / grain / thread count
+ * - Idle participants steal from a slow one
+ * - Back-to-back jobs and statistics
+ * - Single-thread pool runs inline on the caller
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "util/thread_pool.h"
+
+#define TEST_MAX_ITEMS  1000
+
+/**
+ * @brief Shared job record: per-item hit counts and task shape checks
+ */
+typedef struct {
+    uint32_t hits[TEST_MAX_ITEMS];
+    uint32_t grain;
+    uint32_t threads;
+    uint32_t bad_tasks;         /* Tasks longer than grain or bad worker id */
+    uint32_t slow_end;          /* Items below this sleep (steal test) */
+    uint32_t worker_tasks[TP_MAX_THREADS];
+    pthread_t caller;
+    uint32_t off_caller;        /* Tasks run on another thread */
+} test_job_t;
+
+static void record_task(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+    test_job_t *job = (test_job_t *)user_data;
+
+    if (end <= begin || end - begin > job->grain || worker >= job->threads) {
+        __atomic_fetch_add(&job->bad_tasks, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if (!pthread_equal(pthread_self(), job->caller)) {
+        __atomic_fetch_add(&job->off_caller, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&job->worker_tasks[worker], 1, __ATOMIC_RELAXED);
+
+    for (uint32_t i = begin; i < end; i++) {
+        __atomic_fetch_add(&job->hits[i], 1, __ATOMIC_RELAXED);
+        if (i < job->slow_end) {
+            struct timespec ts = { .tv_sec = 0, .tv_nsec = 2000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+static void reset_job(test_job_t *job, uint32_t grain, uint32_t threads) {
+    memset(job, 0, sizeof(*job));
+    job->grain = grain;
+    job->threads = threads;
+    job->caller = pthread_self();
+}
+
+/* ==========================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_18_001: Reject invalid configuration and arguments
+ * @pre NULL config, too many threads, negative priority, NULL fn
+ * @post create returns NULL / parallel_for returns error; count 0 is a no-op
+ */
+static void test_tp_invalid(void **state) {
+    (void)state;
+
+    assert_null(thread_pool_create(NULL));
+
+    tp_config_t config = { .threads = TP_MAX_THREADS + 1 };
+    assert_null(thread_pool_create(&config));
+
+    config.threads = 2;
+    config.priority = -1;
+    assert_null(thread_pool_create(&config));
+
+    config.priority = 0;
+    tp_pool_t *pool = thread_pool_create(&config);
+    assert_non_null(pool);
+    assert_int_equal(thread_pool_threads(pool), 2);
+
+    assert_int_equal(thread_pool_parallel_for(pool, 10, 1, NULL, NULL), TP_ERROR_NULL);
+    assert_int_equal(thread_pool_parallel_for(NULL, 10, 1, record_task, NULL), TP_ERROR_NULL);
+    assert_int_equal(thread_pool_parallel_for(pool, 0, 1, record_task, NULL), TP_OK);
+
+    thread_pool_destroy(pool);
+    thread_pool_destroy(NULL);
+
+    /* Default thread count follows the online CPUs */
+    config.threads = 0;
+    pool = thread_pool_create(&config);
+    assert_non_null(pool);
+    assert_in_range(thread_pool_threads(pool), 1, TP_MAX_THREADS);
+    thread_pool_destroy(pool);
+}
+
+/* ==========================================================================
+ * Execution Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_18_002: Every item runs exactly once
+ * @pre 1..4 threads; counts 1, 7, 32, 1000; grains 1, 3, 64 and default
+ * @post Each item hit once, no task exceeds its grain, worker ids in range
+ */
+static void test_tp_coverage(void **state) {
+    (void)state;
+
+    static test_job_t job;
+    static const uint32_t counts[] = { 1, 7, 32, TEST_MAX_ITEMS };
+    static const uint32_t grains[] = { 1, 3, 64, 0 };
+
+    for (uint32_t threads = 1; threads <= 4; threads++) {
+        tp_config_t config = { .threads = threads };
+        tp_pool_t *pool = thread_pool_create(&config);
+        assert_non_null(pool);
+
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+                uint32_t grain = grains[g];
+                uint32_t limit = grain;
+                if (limit == 0) {
+                    limit = counts[c] / (threads * TP_TASKS_PER_THREAD);
+                    limit = (limit > 0) ? limit : 1;
+                }
+
+                reset_job(&job, limit, threads);
+                assert_int_equal(thread_pool_parallel_for(pool, counts[c], grain,
+                                                          record_task, &job), TP_OK);
+                assert_int_equal(job.bad_tasks, 0);
+                for (uint32_t i = 0; i < counts[c]; i++) {
+                    assert_int_equal(job.hits[i], 1);
+                }
+            }
+        }
+
+        thread_pool_destroy(pool);
+    }
+}
+
+/**
+ * @test FW_UT_18_003: Idle participants steal from a slow one
+ * @pre 4 threads, 64 single-item tasks; the caller's slice (items 0-15)
+ *      sleeps 2 ms per item
+ * @post All items run once; other participants stole caller tasks
+ */
+static void test_tp_steal(void **state) {
+    (void)state;
+
+    static test_job_t job;
+    tp_config_t config = { .threads = 4 };
+    tp_pool_t *pool = thread_pool_create(&config);
+    assert_non_null(pool);
+
+    reset_job(&job, 1, 4);
+    job.slow_end = 16;
+    assert_int_equal(thread_pool_parallel_for(pool, 64, 1, record_task, &job), TP_OK);
+
+    for (uint32_t i = 0; i < 64; i++) {
+        assert_int_equal(job.hits[i], 1);
+    }
+    assert_true(job.worker_tasks[0] < 16);
+
+    tp_stats_t stats;
+    thread_pool_get_stats(pool, &stats);
+    assert_true(stats.steals > 0);
+    assert_int_equal(stats.tasks, 64);
+
+    thread_pool_destroy(pool);
+}
+
+/**
+ * @test FW_UT_18_004: Back-to-back jobs
+ * @pre 3 threads, 500 jobs of 17 items, grain 2
+ * @post Every item hit 500 times; jobs and tasks counted
+ */
+static void test_tp_repeat(void **state) {
+    (void)state;
+
+    static test_job_t job;
+    tp_config_t config = { .threads = 3, .spin = 16 };
+    tp_pool_t *pool = thread_pool_create(&config);
+    assert_non_null(pool);
+
+    reset_job(&job, 2, 3);
+    for (int j = 0; j < 500; j++) {
+        assert_int_equal(thread_pool_parallel_for(pool, 17, 2, record_task, &job), TP_OK);
+    }
+
+    for (uint32_t i = 0; i < 17; i++) {
+        assert_int_equal(job.hits[i], 500);
+    }
+
+    tp_stats_t stats;
+    thread_pool_get_stats(pool, &stats);
+    assert_int_equal(stats.threads, 3);
+    assert_int_equal(stats.jobs, 500);
+    assert_int_equal(stats.tasks, 500 * 9);
+
+    thread_pool_destroy(pool);
+}
+
+/**
+ * @test FW_UT_18_005: Single-thread pool runs inline
+ * @pre threads = 1, 100 items, grain 10
+ * @post All tasks on the calling thread as participant 0
+ */
+static void test_tp_inline(void **state) {
+    (void)state;
+
+    static test_job_t job;
+    tp_config_t config = { .threads = 1 };
+    tp_pool_t *pool = thread_pool_create(&config);
+    assert_non_null(pool);
+
+    reset_job(&job, 10, 1);
+    assert_int_equal(thread_pool_parallel_for(pool, 100, 10, record_task, &job), TP_OK);
+    assert_int_equal(job.off_caller, 0);
+    assert_int_equal(job.worker_tasks[0], 10);
+
+    tp_stats_t stats;
+    thread_pool_get_stats(pool, &stats);
+    assert_int_equal(stats.steals, 0);
+
+    thread_pool_destroy(pool);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Validation tests */
+        cmocka_unit_test(test_tp_invalid),
+
+        /* Execution tests */
+        cmocka_unit_test(test_tp_coverage),
+        cmocka_unit_test(test_tp_steal),
+        cmocka_unit_test(test_tp_repeat),
+        cmocka_unit_test(test_tp_inline),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-18: Thread Pool Tests",
+                                       tests, NULL, NULL);
+}
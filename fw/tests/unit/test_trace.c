@@ -0,0 +1,297 @@
+/**
+ * @file test_trace.c
+ * @brief Unit tests for binary tracepoints (FW-UT-30)
+ *
+ * Test ID: FW-UT-30
+ * Coverage: Recording switch, per-CPU rings, dump file format, ring wrap
+ *
+ * Tests:
+ * - Tracepoints record nothing while stopped
+ * - A dump holds every record with event and thread name tables
+ * - A wrapped ring keeps its newest records and counts the rest
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+
+#include "util/trace.h"
+
+#define DUMP_THREADS    4
+#define DUMP_SPANS      100
+
+typedef struct {
+    trace_file_header_t header;
+    trace_file_event_t events[TRACE_EVENT_COUNT];
+    trace_file_thread_t threads[TRACE_MAX_THREADS];
+    trace_record_t *records;
+} dump_t;
+
+/* Dump to a temporary file and read it back */
+static void dump_and_read(dump_t *dump) {
+    char path[] = "/tmp/test_trace_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+
+    assert_int_equal(trace_dump(path), TRACE_OK);
+
+    FILE *file = fopen(path, "rb");
+    assert_non_null(file);
+    assert_int_equal(fread(&dump->header, sizeof(dump->header), 1, file), 1);
+    assert_int_equal(dump->header.magic, TRACE_FILE_MAGIC);
+    assert_int_equal(dump->header.version, TRACE_FILE_VERSION);
+    assert_int_equal(dump->header.record_size, sizeof(trace_record_t));
+    assert_int_equal(dump->header.event_count, TRACE_EVENT_COUNT);
+    assert_true(dump->header.thread_count <= TRACE_MAX_THREADS);
+
+    assert_int_equal(fread(dump->events, sizeof(dump->events[0]), TRACE_EVENT_COUNT, file),
+                     TRACE_EVENT_COUNT);
+    assert_int_equal(fread(dump->threads, sizeof(dump->threads[0]), dump->header.thread_count, file),
+                     dump->header.thread_count);
+
+    dump->records = calloc(dump->header.record_count + 1, sizeof(trace_record_t));
+    assert_non_null(dump->records);
+    assert_int_equal(fread(dump->records, sizeof(trace_record_t), dump->header.record_count, file),
+                     dump->header.record_count);
+    assert_int_equal(fgetc(file), EOF);
+
+    fclose(file);
+    unlink(path);
+}
+
+static int compare_time(const void *a, const void *b) {
+    const trace_record_t *ra = a;
+    const trace_record_t *rb = b;
+    if (ra->time_ns != rb->time_ns) {
+        return (ra->time_ns < rb->time_ns) ? -1 : 1;
+    }
+    return (ra->seq < rb->seq) ? -1 : (ra->seq > rb->seq);
+}
+
+/* ==========================================================================
+ * Recording Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_30_001: Recording switch
+ * @pre Tracepoints hit before trace_start(), while started and after trace_stop()
+ * @post Only the three hits while started are recorded
+ */
+static void test_trace_switch(void **state) {
+    (void)state;
+
+    trace_stats_t stats;
+
+    assert_int_equal(trace_init(64), TRACE_OK);
+    assert_false(trace_active());
+
+    TRACE_INSTANT(TRACE_SEQ_STATE, 0, 1);
+    trace_get_stats(&stats);
+    assert_int_equal(stats.recorded, 0);
+    assert_true(stats.cpus >= 1);
+
+    assert_int_equal(trace_start(), TRACE_OK);
+    assert_true(trace_active());
+    TRACE_BEGIN(TRACE_CMD, 0x10, 7);
+    TRACE_INSTANT(TRACE_SEQ_STATE, 0, 1);
+    TRACE_END(TRACE_CMD, 0x10, 0);
+    trace_stop();
+    TRACE_INSTANT(TRACE_SEQ_STATE, 1, 2);
+
+    trace_get_stats(&stats);
+    assert_int_equal(stats.recorded, 3);
+    assert_int_equal(stats.overwritten, 0);
+    assert_int_equal(stats.threads, 1);
+
+    /* Restart empties the rings */
+    assert_int_equal(trace_start(), TRACE_OK);
+    trace_stop();
+    trace_get_stats(&stats);
+    assert_int_equal(stats.recorded, 0);
+
+    trace_deinit();
+}
+
+static void *span_worker(void *arg) {
+    uintptr_t id = (uintptr_t)arg;
+    char name[16];
+
+    snprintf(name, sizeof(name), "trace_w%lu", (unsigned long)id);
+    prctl(PR_SET_NAME, name, 0, 0, 0);
+
+    for (uint32_t i = 0; i < DUMP_SPANS; i++) {
+        TRACE_BEGIN(TRACE_ETH_SEND, i, id);
+        TRACE_END(TRACE_ETH_SEND, i, 0);
+    }
+    return NULL;
+}
+
+/**
+ * @test FW_UT_30_002: Dump file
+ * @pre Four named threads record 100 begin/end pairs each
+ * @post Dump has the event table, the four thread names and all 800
+ *       records; per thread, spans are complete and in order
+ */
+static void test_trace_dump(void **state) {
+    (void)state;
+
+    pthread_t threads[DUMP_THREADS];
+    dump_t dump;
+
+    assert_int_equal(trace_init(4096), TRACE_OK);
+    assert_int_equal(trace_start(), TRACE_OK);
+    for (uintptr_t t = 0; t < DUMP_THREADS; t++) {
+        assert_int_equal(pthread_create(&threads[t], NULL, span_worker, (void *)t), 0);
+    }
+    for (uint32_t t = 0; t < DUMP_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    trace_stop();
+
+    dump_and_read(&dump);
+    assert_int_equal(dump.header.record_count, DUMP_THREADS * DUMP_SPANS * 2);
+    assert_int_equal(dump.header.overwritten, 0);
+    assert_int_equal(dump.header.thread_count, DUMP_THREADS);
+
+    for (uint32_t e = 0; e < TRACE_EVENT_COUNT; e++) {
+        assert_string_equal(dump.events[e].name, trace_event_name((trace_event_t)e));
+    }
+    assert_string_equal(dump.events[TRACE_ETH_SEND].arg0, "frame");
+
+    /* Map each thread to its worker ID through the name table */
+    uint32_t tids[DUMP_THREADS] = { 0 };
+    for (uint32_t t = 0; t < dump.header.thread_count; t++) {
+        unsigned long id;
+        assert_int_equal(sscanf(dump.threads[t].name, "trace_w%lu", &id), 1);
+        assert_true(id < DUMP_THREADS);
+        tids[id] = dump.threads[t].tid;
+    }
+
+    qsort(dump.records, dump.header.record_count, sizeof(trace_record_t), compare_time);
+
+    uint32_t next[DUMP_THREADS] = { 0 };
+    for (uint64_t i = 0; i < dump.header.record_count; i++) {
+        const trace_record_t *rec = &dump.records[i];
+        uint32_t id = DUMP_THREADS;
+        for (uint32_t t = 0; t < DUMP_THREADS; t++) {
+            if (tids[t] == rec->tid) {
+                id = t;
+            }
+        }
+        assert_true(id < DUMP_THREADS);
+        assert_int_equal(rec->event, TRACE_ETH_SEND);
+        assert_true(rec->cpu < TRACE_MAX_CPUS);
+
+        /* Records alternate B, E per span */
+        uint32_t n = next[id]++;
+        assert_int_equal(rec->phase, (n % 2 == 0) ? TRACE_PHASE_BEGIN : TRACE_PHASE_END);
+        assert_int_equal(rec->arg0, n / 2);
+        assert_int_equal(rec->arg1, (n % 2 == 0) ? id : 0);
+    }
+
+    free(dump.records);
+    trace_deinit();
+}
+
+/**
+ * @test FW_UT_30_003: Ring wrap
+ * @pre Thread pinned to one CPU records 40 events into 16-record rings
+ * @post Dump holds the newest 16; the other 24 count as overwritten
+ */
+static void test_trace_wrap(void **state) {
+    (void)state;
+
+    cpu_set_t saved;
+    cpu_set_t one;
+    int cpu = sched_getcpu();
+    assert_true(cpu >= 0);
+    pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved);
+    CPU_ZERO(&one);
+    CPU_SET(cpu, &one);
+    assert_int_equal(pthread_setaffinity_np(pthread_self(), sizeof(one), &one), 0);
+
+    assert_int_equal(trace_init(10), TRACE_OK);     /* Rounded up to 16 */
+    assert_int_equal(trace_start(), TRACE_OK);
+    for (uint32_t i = 0; i < 40; i++) {
+        TRACE_INSTANT(TRACE_FRAME_GET, i, i % 4);
+    }
+    trace_stop();
+    pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+
+    trace_stats_t stats;
+    trace_get_stats(&stats);
+    assert_int_equal(stats.recorded, 40);
+    assert_int_equal(stats.overwritten, 24);
+
+    dump_t dump;
+    dump_and_read(&dump);
+    assert_int_equal(dump.header.record_count, 16);
+    assert_int_equal(dump.header.overwritten, 24);
+    for (uint32_t i = 0; i < 16; i++) {
+        assert_int_equal(dump.records[i].arg0, 24 + i);
+        assert_int_equal(dump.records[i].cpu, (uint32_t)cpu % stats.cpus);
+    }
+
+    free(dump.records);
+    trace_deinit();
+}
+
+/**
+ * @test FW_UT_30_004: Invalid use
+ * @pre Start and dump without rings; double init; oversized rings;
+ *      unwritable path; unknown event
+ * @post Each reports its error; nothing is recorded
+ */
+static void test_trace_invalid(void **state) {
+    (void)state;
+
+    assert_int_equal(trace_start(), TRACE_ERROR_STATE);
+    assert_false(trace_active());
+    assert_int_equal(trace_dump("/tmp/test_trace_none"), TRACE_ERROR_STATE);
+    assert_int_equal(trace_init(TRACE_MAX_RECORDS + 1), TRACE_ERROR_PARAM);
+
+    assert_int_equal(trace_init(0), TRACE_OK);
+    assert_int_equal(trace_init(0), TRACE_ERROR_STATE);
+    assert_int_equal(trace_dump(NULL), TRACE_ERROR_NULL);
+    assert_int_equal(trace_dump("/nonexistent/dir/trace.dtrc"), TRACE_ERROR_IO);
+    assert_int_equal(trace_get_stats(NULL), TRACE_ERROR_NULL);
+    assert_string_equal(trace_event_name(TRACE_EVENT_COUNT), "unknown");
+    assert_string_equal(trace_event_name(TRACE_FRAME_COMMIT), "frame_commit");
+
+    trace_deinit();
+    trace_deinit();
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Recording tests */
+        cmocka_unit_test(test_trace_switch),
+        cmocka_unit_test(test_trace_dump),
+        cmocka_unit_test(test_trace_wrap),
+        cmocka_unit_test(test_trace_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-30: Tracepoint Tests",
+                                       tests, NULL, NULL);
+}
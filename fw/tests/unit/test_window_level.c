@@ -0,0 +1,238 @@
+/**
+ * @file test_window_level.c
+ * @brief Unit tests for 16-to-8-bit window/level conversion (FW-UT-24)
+ *
+ * Test ID: FW-UT-24
+ * Coverage: Fixed-point window mapping, gamma curve, LUT and arithmetic
+ *           methods, auto window from histogram percentiles
+ *
+ * Tests:
+ * - Linear window endpoints and midpoint
+ * - LUT and arithmetic methods bit-identical, monotonic
+ * - Gamma curve endpoints and brightening
+ * - Auto window follows histogram percentiles
+ * - Invalid parameters rejected
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proc/window_level.h"
+
+#define TEST_RAMP_PIXELS    65536
+#define TEST_FRAME_SIZE     256
+
+static uint16_t g_ramp[TEST_RAMP_PIXELS];
+static uint8_t g_lut_out[TEST_RAMP_PIXELS];
+static uint8_t g_arith_out[TEST_RAMP_PIXELS];
+static uint16_t g_frame[TEST_FRAME_SIZE * TEST_FRAME_SIZE];
+static fstats_t g_stats;
+
+static void fill_ramp(void) {
+    for (uint32_t i = 0; i < TEST_RAMP_PIXELS; i++) {
+        g_ramp[i] = (uint16_t)i;
+    }
+}
+
+/* ==========================================================================
+ * Conversion Tests
+ * ========================================================================== */
+
+/**
+ * @test FW_UT_24_001: Linear window
+ * @pre Window 1000-2000, gamma 1
+ * @post Black at and below low, white at and above high, midpoint grey
+ */
+static void test_window_level_linear(void **state) {
+    (void)state;
+
+    wl_config_t config = { .window_low = 1000, .window_high = 2000 };
+    window_level_t *wl = window_level_create(&config);
+    assert_non_null(wl);
+    assert_int_not_equal(window_level_method(wl), WL_METHOD_AUTO);
+
+    static const uint16_t in[6] = { 0, 1000, 1500, 2000, 2001, 65535 };
+    uint8_t out[6];
+    assert_int_equal(window_level_convert(wl, out, in, 6), WL_OK);
+    assert_int_equal(out[0], 0);
+    assert_int_equal(out[1], 0);
+    assert_in_range(out[2], 127, 128);
+    assert_int_equal(out[3], 255);
+    assert_int_equal(out[4], 255);
+    assert_int_equal(out[5], 255);
+
+    /* One-count window: a step at the white point */
+    assert_int_equal(window_level_set_window(wl, 1000, 1001), WL_OK);
+    assert_int_equal(window_level_convert(wl, out, in, 6), WL_OK);
+    assert_int_equal(out[1], 0);
+    assert_int_equal(out[4], 255);
+
+    window_level_destroy(wl);
+}
+
+/**
+ * @test FW_UT_24_002: Methods agree
+ * @pre Every 16-bit value, windows from one count to full range, linear,
+ *      gamma 2.2 and 0.5
+ * @post LUT and arithmetic outputs are identical and non-decreasing
+ */
+static void test_window_level_methods_agree(void **state) {
+    (void)state;
+
+    static const uint16_t windows[][2] = {
+        { 0, 65535 }, { 1000, 2000 }, { 30000, 30001 }, { 12345, 54321 }, { 0, 1 }, { 65534, 65535 }
+    };
+    static const float gammas[] = { 1.0f, 2.2f, 0.5f };
+
+    fill_ramp();
+
+    for (size_t g = 0; g < sizeof(gammas) / sizeof(gammas[0]); g++) {
+        wl_config_t config = { .gamma = gammas[g] };
+        window_level_t *wl = window_level_create(&config);
+        assert_non_null(wl);
+
+        for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+            assert_int_equal(window_level_set_window(wl, windows[w][0], windows[w][1]), WL_OK);
+            assert_int_equal(window_level_convert_method(wl, WL_METHOD_LUT, g_lut_out, g_ramp,
+                                                         TEST_RAMP_PIXELS), WL_OK);
+            /* Odd count exercises the SIMD tail */
+            assert_int_equal(window_level_convert_method(wl, WL_METHOD_ARITH, g_arith_out, g_ramp,
+                                                         TEST_RAMP_PIXELS - 3), WL_OK);
+            assert_memory_equal(g_lut_out, g_arith_out, TEST_RAMP_PIXELS - 3);
+
+            assert_int_equal(g_lut_out[windows[w][0]], 0);
+            assert_int_equal(g_lut_out[windows[w][1]], 255);
+            for (uint32_t i = 1; i < TEST_RAMP_PIXELS; i++) {
+                assert_true(g_lut_out[i] >= g_lut_out[i - 1]);
+            }
+        }
+
+        window_level_destroy(wl);
+    }
+}
+
+/**
+ * @test FW_UT_24_003: Gamma curve
+ * @pre Full window, gamma 2.2 and linear
+ * @post Same endpoints, gamma lifts the midtones to about 255 * 0.5^(1/2.2)
+ */
+static void test_window_level_gamma(void **state) {
+    (void)state;
+
+    wl_config_t config = { .gamma = 2.2f };
+    window_level_t *gamma = window_level_create(&config);
+    config.gamma = 0.0f;
+    window_level_t *linear = window_level_create(&config);
+    assert_non_null(gamma);
+    assert_non_null(linear);
+
+    static const uint16_t in[3] = { 0, 32768, 65535 };
+    uint8_t out_gamma[3], out_linear[3];
+    assert_int_equal(window_level_convert(gamma, out_gamma, in, 3), WL_OK);
+    assert_int_equal(window_level_convert(linear, out_linear, in, 3), WL_OK);
+
+    assert_int_equal(out_gamma[0], 0);
+    assert_int_equal(out_gamma[2], 255);
+    assert_in_range(out_linear[1], 127, 128);
+    assert_in_range(out_gamma[1], 184, 188);
+
+    window_level_destroy(gamma);
+    window_level_destroy(linear);
+}
+
+/**
+ * @test FW_UT_24_004: Auto window
+ * @pre Frame uniform over 10000-20000; flat frame
+ * @post Window brackets the populated range; flat frame gives a one-count
+ *       window
+ */
+static void test_window_level_auto(void **state) {
+    (void)state;
+
+    fstats_config_t stats_config = { .width = TEST_FRAME_SIZE, .height = TEST_FRAME_SIZE,
+                                     .row_step = 1, .col_step = 1 };
+    wl_config_t config = { .low_percentile = 0.01f, .high_percentile = 0.99f };
+    window_level_t *wl = window_level_create(&config);
+    assert_non_null(wl);
+
+    uint32_t seed = 7;
+    for (size_t i = 0; i < TEST_FRAME_SIZE * TEST_FRAME_SIZE; i++) {
+        g_frame[i] = (uint16_t)(10000 + cpu_dispatch_random(&seed) % 10001);
+    }
+    assert_int_equal(frame_stats_compute(&stats_config, g_frame, &g_stats), FSTATS_OK);
+    assert_int_equal(window_level_auto_window(wl, &g_stats), WL_OK);
+
+    uint16_t low, high;
+    window_level_get_window(wl, &low, &high);
+    assert_in_range(low, 10000, 10300);
+    assert_in_range(high, 19700, 20000);
+
+    for (size_t i = 0; i < TEST_FRAME_SIZE * TEST_FRAME_SIZE; i++) {
+        g_frame[i] = 4000;
+    }
+    assert_int_equal(frame_stats_compute(&stats_config, g_frame, &g_stats), FSTATS_OK);
+    assert_int_equal(window_level_auto_window(wl, &g_stats), WL_OK);
+    window_level_get_window(wl, &low, &high);
+    assert_int_equal(high, low + 1);
+
+    window_level_destroy(wl);
+}
+
+/**
+ * @test FW_UT_24_005: Invalid parameters
+ * @pre Inverted window, out-of-range gamma and percentiles, NULL pointers
+ * @post Create fails or the call returns an error
+ */
+static void test_window_level_invalid(void **state) {
+    (void)state;
+
+    wl_config_t config = { .window_low = 2000, .window_high = 1000 };
+    assert_null(window_level_create(&config));
+    config = (wl_config_t){ .gamma = 20.0f };
+    assert_null(window_level_create(&config));
+    config = (wl_config_t){ .low_percentile = 0.9f, .high_percentile = 0.1f };
+    assert_null(window_level_create(&config));
+    assert_null(window_level_create(NULL));
+
+    config = (wl_config_t){ .method = WL_METHOD_LUT };
+    window_level_t *wl = window_level_create(&config);
+    assert_non_null(wl);
+    assert_int_equal(window_level_method(wl), WL_METHOD_LUT);
+    assert_int_equal(window_level_set_window(wl, 5, 5), WL_ERROR_PARAM);
+    assert_int_equal(window_level_convert(wl, NULL, g_ramp, 4), WL_ERROR_NULL);
+    assert_int_equal(window_level_convert_method(wl, WL_METHOD_AUTO, g_lut_out, g_ramp, 4),
+                     WL_ERROR_PARAM);
+
+    memset(&g_stats, 0, sizeof(g_stats));
+    assert_int_equal(window_level_auto_window(wl, &g_stats), WL_ERROR_PARAM);
+    assert_int_equal(window_level_auto_window(wl, NULL), WL_ERROR_NULL);
+
+    window_level_destroy(wl);
+    window_level_destroy(NULL);
+}
+
+/* ==========================================================================
+ * Test Runner
+ * ========================================================================== */
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* Conversion tests */
+        cmocka_unit_test(test_window_level_linear),
+        cmocka_unit_test(test_window_level_methods_agree),
+        cmocka_unit_test(test_window_level_gamma),
+        cmocka_unit_test(test_window_level_auto),
+        cmocka_unit_test(test_window_level_invalid),
+    };
+
+    return cmocka_run_group_tests_name("FW-UT-24: Window/Level Tests",
+                                       tests, NULL, NULL);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file detector_stat.c
+ * @brief Print the daemon's shared-memory statistics page
+ *
+ * Maps the page (util/stats_page.h) read-only and prints every entry; the
+ * daemon is not involved, so this can run as often as wanted. With -w it
+ * repeats, adding per-second rates for counters, and follows the page
+ * across daemon restarts.
+ *
+ * Usage: detector-stat [-p name] [-w interval_ms] [filter]
+ *   -p name         shm object (default /detector_stats)
+ *   -w interval_ms  repeat every interval
+ *   filter          only entries whose name contains this text
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "util/stats_page.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void print_page(const stats_page_view_t *view, const uint64_t *values,
+                       const uint64_t *previous, double interval_s,
+                       uint64_t update_ns, stats_page_status_t status, const char *filter) {
+    const stats_page_header_t *header = view->header;
+    uint64_t now = now_ns();
+    double age_ms = (now > update_ns) ? (double)(now - update_ns) / 1.0e6 : 0.0;
+
+    printf("pid %u, %u entries, %llu updates, last %.1f ms ago%s\n",
+           header->pid, header->entry_count,
+           (unsigned long long)atomic_load_explicit(&header->updates, memory_order_relaxed),
+           age_ms, (status == STATS_PAGE_ERROR_CLOSED) ? " (daemon stopped)" : "");
+
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        const stats_page_entry_t *entry = &view->entries[i];
+        if (filter != NULL && strstr(entry->name, filter) == NULL) {
+            continue;
+        }
+
+        if (entry->type == STATS_PAGE_GAUGE) {
+            printf("  %-40s %20.6g\n", entry->name, stats_page_value(entry, values[i]));
+        } else if (previous != NULL && interval_s > 0.0) {
+            printf("  %-40s %20llu %12.1f/s\n", entry->name, (unsigned long long)values[i],
+                   (double)(values[i] - previous[i]) / interval_s);
+        } else {
+            printf("  %-40s %20llu\n", entry->name, (unsigned long long)values[i]);
+        }
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = STATS_PAGE_DEFAULT_NAME;
+    long interval_ms = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:w:")) != -1) {
+        switch (opt) {
+            case 'p':
+                name = optarg;
+                break;
+            case 'w':
+                interval_ms = strtol(optarg, NULL, 0);
+                break;
+            default:
+                interval_ms = -1;
+                break;
+        }
+    }
+    if (interval_ms < 0 || argc - optind > 1) {
+        fprintf(stderr, "Usage: %s [-p name] [-w interval_ms] [filter]\n", argv[0]);
+        return 2;
+    }
+    const char *filter = (optind < argc) ? argv[optind] : NULL;
+
+    stats_page_view_t view;
+    stats_page_status_t status = stats_page_open(name, &view);
+    if (status != STATS_PAGE_OK) {
+        fprintf(stderr, "%s: %s\n", name, (status == STATS_PAGE_ERROR_FORMAT) ?
+                "not a stats page of this version" : "not available (daemon not running?)");
+        return 1;
+    }
+
+    uint64_t *values = calloc(STATS_PAGE_MAX_ENTRIES, sizeof(uint64_t));
+    uint64_t *previous = calloc(STATS_PAGE_MAX_ENTRIES, sizeof(uint64_t));
+    if (values == NULL || previous == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        free(values);
+        free(previous);
+        stats_page_close(&view);
+        return 1;
+    }
+
+    bool have_previous = false;
+    uint64_t previous_ns = 0;
+    int rc = 0;
+
+    for (;;) {
+        uint64_t update_ns = 0;
+        status = stats_page_read(&view, values, &update_ns);
+        if (status == STATS_PAGE_ERROR_BUSY) {
+            fprintf(stderr, "%s: page kept changing, try again\n", name);
+            rc = 1;
+            break;
+        }
+
+        double interval_s = have_previous ? (double)(update_ns - previous_ns) / 1.0e9 : 0.0;
+        print_page(&view, values, have_previous ? previous : NULL, interval_s,
+                   update_ns, status, filter);
+        if (interval_ms == 0) {
+            break;
+        }
+
+        memcpy(previous, values, view.header->entry_count * sizeof(uint64_t));
+        previous_ns = update_ns;
+        have_previous = true;
+        usleep((useconds_t)interval_ms * 1000U);
+
+        /* Daemon restarted or stopped: follow the new page when there is one */
+        if (!atomic_load_explicit(&view.header->live, memory_order_acquire)) {
+            stats_page_view_t next;
+            if (stats_page_open(name, &next) == STATS_PAGE_OK) {
+                stats_page_close(&view);
+                view = next;
+                have_previous = false;
+            }
+        }
+        printf("\n");
+    }
+
+    free(values);
+    free(previous);
+    stats_page_close(&view);
+    return rc;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file trace_export.c
+ * @brief Convert a tracepoint dump to Chrome trace JSON
+ *
+ * Reads a trace_dump() file (util/trace.h) and writes the Chrome trace
+ * event format, which chrome://tracing and ui.perfetto.dev open as is.
+ * Records are sorted by time, timestamps start at 0, threads get their
+ * names, and span ends whose begin was overwritten are left out.
+ *
+ * Usage: trace_export <dump> [output.json]   (default output: stdout)
+ *
+ * Copyright (c) 2026 ABYZ Lab
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "util/trace.h"
+
+#define EXPORT_MAX_DEPTH_TIDS   256     /* Threads tracked for span nesting */
+
+typedef struct {
+    uint32_t tid;
+    uint32_t depth;
+} export_depth_t;
+
+static int compare_time(const void *a, const void *b) {
+    const trace_record_t *ra = a;
+    const trace_record_t *rb = b;
+    if (ra->time_ns != rb->time_ns) {
+        return (ra->time_ns < rb->time_ns) ? -1 : 1;
+    }
+    return (ra->seq < rb->seq) ? -1 : (ra->seq > rb->seq);
+}
+
+/**
+ * @brief Open spans of a thread (NULL if the table is full)
+ */
+static uint32_t *span_depth(export_depth_t *table, uint32_t *used, uint32_t tid) {
+    for (uint32_t i = 0; i < *used; i++) {
+        if (table[i].tid == tid) {
+            return &table[i].depth;
+        }
+    }
+    if (*used == EXPORT_MAX_DEPTH_TIDS) {
+        return NULL;
+    }
+    table[*used].tid = tid;
+    table[*used].depth = 0;
+    return &table[(*used)++].depth;
+}
+
+/**
+ * @brief Write a dump's name string as JSON (names are plain identifiers)
+ */
+static void write_name(FILE *out, const char *name, size_t size) {
+    fputc('"', out);
+    for (size_t i = 0; i < size && name[i] != '\0'; i++) {
+        char c = name[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(((unsigned char)c < 0x20) ? '?' : c, out);
+    }
+    fputc('"', out);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <dump> [output.json]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    trace_file_header_t header;
+    if (fread(&header, sizeof(header), 1, in) != 1 ||
+        header.magic != TRACE_FILE_MAGIC ||
+        header.version != TRACE_FILE_VERSION ||
+        header.record_size != sizeof(trace_record_t) ||
+        header.event_count == 0 || header.event_count > UINT16_MAX ||
+        header.thread_count > TRACE_MAX_THREADS) {
+        fprintf(stderr, "%s: not a trace dump (version %u)\n", argv[1], TRACE_FILE_VERSION);
+        fclose(in);
+        return 1;
+    }
+
+    trace_file_event_t *events = calloc(header.event_count, sizeof(*events));
+    trace_file_thread_t threads[TRACE_MAX_THREADS];
+    trace_record_t *records = calloc(header.record_count + 1, sizeof(*records));
+    if (events == NULL || records == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        free(events);
+        free(records);
+        fclose(in);
+        return 1;
+    }
+
+    int ok = fread(events, sizeof(*events), header.event_count, in) == header.event_count &&
+             fread(threads, sizeof(threads[0]), header.thread_count, in) == header.thread_count &&
+             fread(records, sizeof(*records), header.record_count, in) == header.record_count;
+    fclose(in);
+    if (!ok) {
+        fprintf(stderr, "%s: truncated\n", argv[1]);
+        free(events);
+        free(records);
+        return 1;
+    }
+
+    FILE *out = (argc == 3) ? fopen(argv[2], "w") : stdout;
+    if (out == NULL) {
+        perror(argv[2]);
+        free(events);
+        free(records);
+        return 1;
+    }
+
+    qsort(records, header.record_count, sizeof(*records), compare_time);
+    uint64_t base_ns = (header.record_count > 0) ? records[0].time_ns : 0;
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"overwritten\":%llu},\"traceEvents\":[\n",
+            (unsigned long long)header.overwritten);
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"detector_daemon\"}}");
+    for (uint32_t t = 0; t < header.thread_count; t++) {
+        fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                threads[t].tid);
+        write_name(out, threads[t].name, sizeof(threads[t].name));
+        fprintf(out, "}}");
+    }
+
+    export_depth_t depths[EXPORT_MAX_DEPTH_TIDS];
+    uint32_t depth_used = 0;
+    uint64_t skipped = 0;
+
+    for (uint64_t i = 0; i < header.record_count; i++) {
+        const trace_record_t *rec = &records[i];
+        if (rec->event >= header.event_count ||
+            (rec->phase != TRACE_PHASE_BEGIN && rec->phase != TRACE_PHASE_END &&
+             rec->phase != TRACE_PHASE_INSTANT)) {
+            skipped++;
+            continue;
+        }
+
+        uint32_t *depth = span_depth(depths, &depth_used, rec->tid);
+        if (depth != NULL && rec->phase == TRACE_PHASE_BEGIN) {
+            (*depth)++;
+        } else if (depth != NULL && rec->phase == TRACE_PHASE_END) {
+            if (*depth == 0) {
+                skipped++;          /* Begin overwritten before the dump */
+                continue;
+            }
+            (*depth)--;
+        }
+
+        const trace_file_event_t *info = &events[rec->event];
+        uint64_t rel_ns = rec->time_ns - base_ns;
+
+        fprintf(out, ",\n{\"name\":");
+        write_name(out, info->name, sizeof(info->name));
+        fprintf(out, ",\"cat\":\"detector\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u,",
+                rec->phase, (unsigned long long)(rel_ns / 1000), (unsigned int)(rel_ns % 1000),
+                rec->tid);
+        if (rec->phase == TRACE_PHASE_INSTANT) {
+            fprintf(out, "\"s\":\"t\",");
+        }
+        fprintf(out, "\"args\":{");
+        write_name(out, info->arg0, sizeof(info->arg0));
+        fprintf(out, ":%llu,", (unsigned long long)rec->arg0);
+        if (rec->phase == TRACE_PHASE_END) {
+            fprintf(out, "\"status\":%d", (int)(int32_t)rec->arg1);   /* Result codes are signed */
+        } else {
+            write_name(out, info->arg1, sizeof(info->arg1));
+            fprintf(out, ":%u", rec->arg1);
+        }
+        fprintf(out, ",\"cpu\":%u}}", rec->cpu);
+    }
+    fprintf(out, "\n]}\n");
+
+    ok = !ferror(out);
+    if (out != stdout) {
+        ok = (fclose(out) == 0) && ok;
+    }
+
+    fprintf(stderr, "%llu records, %u threads, %llu overwritten, %llu skipped\n",
+            (unsigned long long)header.record_count, header.thread_count,
+            (unsigned long long)header.overwritten, (unsigned long long)skipped);
+
+    free(events);
+    free(records);
+    return ok ? 0 : 1;
+}